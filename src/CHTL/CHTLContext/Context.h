@@ -8,6 +8,7 @@
 #include <vector>
 #include "../CHTLState/State.h"
 #include "../CHTLLexer/GlobalMap.h"
+#include "../../Util/ScopedInstance.h"
 
 namespace CHTL {
 
@@ -133,6 +134,9 @@ private:
 class ContextManager {
 public:
     static ContextManager& getInstance() {
+        if (auto* scoped = ScopedInstance<ContextManager>::current()) {
+            return *scoped;
+        }
         static ContextManager instance;
         return instance;
     }
@@ -156,6 +160,7 @@ public:
     void clearAll();
 
 private:
+    friend class ScopedInstance<ContextManager>;
     ContextManager() = default;
     ContextManager(const ContextManager&) = delete;
     ContextManager& operator=(const ContextManager&) = delete;
@@ -0,0 +1,64 @@
+#include "ExpansionCache.h"
+#include <functional>
+
+namespace CHTL {
+
+namespace {
+
+uint64_t mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDULL;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+} // namespace
+
+uint64_t ExpansionCache::fingerprint(const std::unordered_map<std::string, std::string>& specializations) {
+    // 每一项单独混合后相加，结果与遍历顺序无关
+    std::hash<std::string> hasher;
+    uint64_t result = 0;
+    for (const auto& [key, value] : specializations) {
+        uint64_t item = mix(hasher(key)) ^ (mix(hasher(value)) * 31);
+        result += mix(item);
+    }
+    return result == 0 && !specializations.empty() ? 1 : result;
+}
+
+ExpandedStyle* ExpansionCache::findStyle(const ExpansionKey& key) {
+    auto it = styles_.find(key);
+    if (it == styles_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    return &it->second;
+}
+
+ExpandedStyle& ExpansionCache::storeStyle(const ExpansionKey& key, ExpandedStyle style) {
+    return styles_[key] = std::move(style);
+}
+
+ExpandedElement* ExpansionCache::findElement(const ExpansionKey& key) {
+    auto it = elements_.find(key);
+    if (it == elements_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    return &it->second;
+}
+
+ExpandedElement& ExpansionCache::storeElement(const ExpansionKey& key, ExpandedElement element) {
+    return elements_[key] = std::move(element);
+}
+
+void ExpansionCache::clear() {
+    styles_.clear();
+    elements_.clear();
+    ++generation_;
+}
+
+} // namespace CHTL
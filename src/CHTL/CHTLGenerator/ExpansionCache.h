@@ -0,0 +1,87 @@
+#ifndef CHTL_EXPANSION_CACHE_H
+#define CHTL_EXPANSION_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "../CHTLNode/BaseNode.h"
+#include "../../Util/SymbolInterner/SymbolInterner.h"
+
+namespace CHTL {
+
+// 展开缓存的键：模板/自定义名 + 特例化参数指纹
+struct ExpansionKey {
+    SymbolId name = INVALID_SYMBOL_ID;
+    uint64_t fingerprint = 0;
+
+    bool operator==(const ExpansionKey& other) const {
+        return name == other.name && fingerprint == other.fingerprint;
+    }
+};
+
+struct ExpansionKeyHash {
+    size_t operator()(const ExpansionKey& key) const {
+        return static_cast<size_t>(key.fingerprint * 0x9E3779B97F4A7C15ULL ^ key.name);
+    }
+};
+
+// 样式组展开结果：继承链、delete和特例化都已处理完的属性表
+struct ExpandedStyle {
+    std::vector<std::pair<std::string, std::string>> properties;
+    std::string inlineText;     // "name: value;" 以空格连接，直接追加到内联样式
+};
+
+// 元素展开结果
+// nodes为要输出的元素子树（引用定义中的节点，不复制）。输出不产生全局
+// 样式/脚本时，按缩进层级保存渲染好的HTML，之后的使用直接写出。
+struct ExpandedElement {
+    std::vector<ASTNode*> nodes;
+    std::vector<std::pair<int, std::string>> html;
+    bool emittable = true;
+
+    const std::string* findHtml(int indentLevel) const {
+        for (const auto& [level, text] : html) {
+            if (level == indentLevel) {
+                return &text;
+            }
+        }
+        return nullptr;
+    }
+};
+
+// 模板/自定义展开缓存（每次编译一个，随Generator存在）
+// 任何模板或自定义的定义（包括命名空间合并时的重定义和变量组）都会使
+// 已有的展开失效：定义通常都在使用之前，此时缓存为空，清空没有代价。
+class ExpansionCache {
+public:
+    // 特例化参数的指纹，与参数顺序无关；没有特例化时为0
+    static uint64_t fingerprint(const std::unordered_map<std::string, std::string>& specializations);
+
+    ExpandedStyle* findStyle(const ExpansionKey& key);
+    ExpandedStyle& storeStyle(const ExpansionKey& key, ExpandedStyle style);
+
+    ExpandedElement* findElement(const ExpansionKey& key);
+    ExpandedElement& storeElement(const ExpansionKey& key, ExpandedElement element);
+
+    void clear();
+
+    // 每次clear()加一；之前取得的指针只在同一代内有效
+    uint64_t generation() const { return generation_; }
+
+    size_t size() const { return styles_.size() + elements_.size(); }
+    size_t hits() const { return hits_; }
+    size_t misses() const { return misses_; }
+
+private:
+    std::unordered_map<ExpansionKey, ExpandedStyle, ExpansionKeyHash> styles_;
+    std::unordered_map<ExpansionKey, ExpandedElement, ExpansionKeyHash> elements_;
+    uint64_t generation_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+};
+
+} // namespace CHTL
+
+#endif // CHTL_EXPANSION_CACHE_H
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <unordered_set>
 #include "../../Error/ErrorReport.h"
+#include "../../CSS/CSSMinifier.h"
 
 namespace CHTL {
 
@@ -16,11 +17,38 @@ Generator::Generator(std::shared_ptr<CompileContext> context,
     : context_(context), config_(config) {}
 
 std::string Generator::generate(std::shared_ptr<ProgramNode> program) {
-    output_.str("");
-    globalStyles_.str("");
-    globalScripts_.str("");
+    generateDocument(program.get());
+    
+    std::string result;
+    result.reserve(output_.totalSize());
+    StringOutputSink sink(result);
+    output_.writeTo(sink);
+    output_.clear();
+    
+    return result;
+}
+
+void Generator::generate(std::shared_ptr<ProgramNode> program, OutputSink& sink) {
+    generateDocument(program.get());
+    output_.writeTo(sink);
+    sink.flush();
+    output_.clear();
+}
+
+void Generator::generateDocument(ProgramNode* program) {
+    output_.clear();
+    capture_ = nullptr;
+    undefinedVariables_.clear();
+    globalStyles_.clear();
+    globalScripts_.clear();
     indentLevel_ = 0;
     
+    // 全局样式插入第一个</head>之前，全局脚本插入第一个</body>之前
+    headStylesSlot_ = output_.addSlot();
+    bodyScriptsSlot_ = output_.addSlot();
+    output_.placeSlotBefore(headStylesSlot_, "</head>");
+    output_.placeSlotBefore(bodyScriptsSlot_, "</body>");
+    
     // 遍历所有顶层节点
     for (const auto& node : program->getTopLevelNodes()) {
         if (node) {
@@ -70,9 +98,6 @@ std::string Generator::generate(std::shared_ptr<ProgramNode> program) {
         }
     }
     
-    // 构建最终输出
-    std::stringstream finalOutput;
-    
     // 检查是否需要HTML5声明
     auto useStmt = program->getUseStatement();
     if (useStmt && useStmt->getType() == NodeType::USE_OP) {
@@ -82,37 +107,32 @@ std::string Generator::generate(std::shared_ptr<ProgramNode> program) {
         }
     }
     
-    // 输出主内容
-    finalOutput << output_.str();
-    
-    // 插入全局样式（如果有）
-    if (!globalStyles_.str().empty()) {
-        std::string styleBlock = "<style>\n" + globalStyles_.str() + "</style>\n";
-        std::string content = finalOutput.str();
-        size_t headPos = content.find("</head>");
-        if (headPos != std::string::npos) {
-            content.insert(headPos, styleBlock);
+    // 填充全局样式插槽（没有head标签时放在开头）
+    if (!globalStyles_.empty()) {
+        if (output_.slotOffset(headStylesSlot_) == OutputRope::npos) {
+            output_.placeSlotAt(headStylesSlot_, 0);
+        }
+        std::string& styleBlock = output_.slotContent(headStylesSlot_);
+        styleBlock.reserve(globalStyles_.size() + 16);
+        styleBlock += "<style>\n";
+        if (config_.minify) {
+            CSSMinifier().minify(globalStyles_, styleBlock);
+            styleBlock += "\n";
         } else {
-            // 如果没有head标签，在开头插入
-            content = styleBlock + content;
+            styleBlock += globalStyles_;
         }
-        finalOutput.str(content);
+        styleBlock += "</style>\n";
     }
     
-    // 插入全局脚本（如果有）
-    if (!globalScripts_.str().empty()) {
-        std::string content = finalOutput.str();
-        size_t bodyPos = content.find("</body>");
-        if (bodyPos != std::string::npos) {
-            content.insert(bodyPos, globalScripts_.str());
-        } else {
-            // 如果没有body标签，在末尾插入
-            content += globalScripts_.str();
+    // 填充全局脚本插槽（没有body标签时放在末尾）
+    if (!globalScripts_.empty()) {
+        if (output_.slotOffset(bodyScriptsSlot_) == OutputRope::npos) {
+            output_.placeSlot(bodyScriptsSlot_);
         }
-        finalOutput.str(content);
+        output_.slotContent(bodyScriptsSlot_).swap(globalScripts_);
     }
     
-    return finalOutput.str();
+    reportUndefinedVariables();
 }
 
 void Generator::visitProgramNode(ProgramNode* node) {
@@ -157,11 +177,13 @@ void Generator::generateHtmlElement(ElementNode* node) {
                         if (!currentState_.pendingInlineStyles.empty()) {
                             currentState_.pendingInlineStyles += " ";
                         }
-                        currentState_.pendingInlineStyles += prop->getName() + ": " + processTemplateVariables(prop->getValue()) + ";";
+                        currentState_.pendingInlineStyles += prop->getName();
+                        currentState_.pendingInlineStyles += ": ";
+                        appendValue(*prop, currentState_.pendingInlineStyles);
+                        currentState_.pendingInlineStyles += ";";
                     } else if (rule->getType() == NodeType::FUNCTION_CALL) {
                         // 处理样式模板使用
-                        auto templateUse = static_cast<TemplateUseNode*>(rule.get());
-                        templateUse->accept(this);
+                        visitTemplateUseNode(static_cast<TemplateUseNode*>(rule.get()));
                     }
                 }
             }
@@ -317,13 +339,12 @@ void Generator::visitStyleNode(StyleNode* node) {
             if (rule->getType() == NodeType::SELECTOR) {
                 auto selector = static_cast<SelectorNode*>(rule.get());
                 // 将选择器样式添加到全局样式
-                std::stringstream temp;
-                std::swap(output_, temp);
+                std::string* savedCapture = capture_;
+                capture_ = &globalStyles_;
                 
                 generateCSSRule(selector);
-                globalStyles_ << output_.str();
                 
-                std::swap(output_, temp);
+                capture_ = savedCapture;
             }
         }
     } else {
@@ -360,16 +381,12 @@ void Generator::generateLocalStyles(StyleNode* node) {
         } else if (rule->getType() == NodeType::SELECTOR) {
             // 选择器样式（添加到全局样式块）
             auto selector = static_cast<SelectorNode*>(rule.get());
-            std::stringstream selectorStyles;
-            std::stringstream temp;
-            std::swap(output_, temp);
-            output_.swap(selectorStyles);
+            std::string* savedCapture = capture_;
+            capture_ = &globalStyles_;
             
             generateSelector(selector);
             
-            output_.swap(selectorStyles);
-            std::swap(output_, temp);
-            globalStyles_ << selectorStyles.str();
+            capture_ = savedCapture;
         }
     }
     
@@ -387,7 +404,8 @@ void Generator::visitScriptNode(ScriptNode* node) {
     
     if (node->getBlockType() == ScriptBlockType::LOCAL) {
         // 局部脚本添加到全局脚本
-        globalScripts_ << node->getContent() << "\n";
+        globalScripts_ += node->getContent();
+        globalScripts_ += "\n";
     } else {
         // 全局脚本
         writeLine("<script>");
@@ -418,14 +436,7 @@ void Generator::visitSelectorNode(SelectorNode* node) {
 }
 
 void Generator::visitPropertyNode(PropertyNode* node) {
-    std::string value = node->getValue();
-    
-    // 处理变量组替换
-    if (node->getVariableGroup().has_value()) {
-        value = replaceVariables(value);
-    }
-    
-    writeLine(node->getName() + ": " + value + ";");
+    writeLine(node->getName() + ": " + renderValue(*node) + ";");
 }
 
 void Generator::generateHtml5Doctype() {
@@ -493,53 +504,91 @@ void Generator::applyAutoIds(ElementNode* element) {
     }
 }
 
-std::string Generator::replaceVariables(const std::string& value) {
-    // 实现变量替换逻辑
-    std::string result = value;
-    size_t pos = 0;
+void Generator::appendValue(const PropertyNode& property, std::string& out) {
+    const ValueProgram& program = property.getValueProgram();
+    const std::string& value = property.getValue();
+    if (program.empty()) {
+        out += value;
+        return;
+    }
     
-    while ((pos = result.find("@", pos)) != std::string::npos) {
-        // 查找变量名的结束位置
-        size_t endPos = pos + 1;
-        while (endPos < result.length() && 
-               (std::isalnum(result[endPos]) || result[endPos] == '_')) {
-            endPos++;
+    // @name只在声明了变量组的属性中替换
+    bool resolveVariables = property.getVariableGroup().has_value();
+    program.render(value, out, [&](const ValueReference& reference, std::string& target) {
+        const std::string* found = nullptr;
+        if (reference.kind == ValueReference::Kind::GROUP_VARIABLE) {
+            const SymbolMap<std::string>* group = varTemplateStorage_.find(reference.group);
+            if (!group) {
+                // 不是变量组（如普通CSS函数），原样输出
+                return false;
+            }
+            found = group->find(reference.variable);
+        } else {
+            if (!resolveVariables) {
+                return false;
+            }
+            found = templateVars_.find(reference.variable);
         }
         
-        if (endPos > pos + 1) {
-            std::string varName = result.substr(pos + 1, endPos - pos - 1);
-            
-            // 在当前上下文中查找变量
-            auto it = templateVars_.find(varName);
-            if (it != templateVars_.end()) {
-                result.replace(pos, endPos - pos, it->second);
-                pos += it->second.length();
-            } else {
-                // 变量未定义
-                ErrorBuilder(ErrorLevel::WARNING, ErrorType::REFERENCE_ERROR)
-                    .withMessage("Undefined variable: @" + varName)
-                    .report();
-                pos = endPos;
+        if (!found) {
+            std::pair<SymbolId, SymbolId> key(reference.group, reference.variable);
+            if (std::find(undefinedVariables_.begin(), undefinedVariables_.end(), key) == undefinedVariables_.end()) {
+                undefinedVariables_.push_back(key);
             }
-        } else {
-            pos++;
+            return false;
         }
+        target += *found;
+        return true;
+    });
+}
+
+const std::string& Generator::renderValue(const PropertyNode& property) {
+    valueBuffer_.clear();
+    appendValue(property, valueBuffer_);
+    return valueBuffer_;
+}
+
+void Generator::registerVarGroup(SymbolId name, ASTNode* content) {
+    // 变量组内容为容器元素，变量存为它的属性
+    if (!content || content->getType() != NodeType::ELEMENT) {
+        return;
+    }
+    auto& interner = SymbolInterner::getInstance();
+    auto& vars = varTemplateStorage_[name];
+    for (const auto& [key, value] : static_cast<ElementNode*>(content)->getAttributes()) {
+        vars.assign(interner.intern(key), value);
     }
-    
-    return result;
 }
 
-void Generator::write(const std::string& text) {
-    output_ << text;
+void Generator::reportUndefinedVariables() {
+    // 每个未定义的变量只报告一次
+    auto& interner = SymbolInterner::getInstance();
+    for (const auto& [group, variable] : undefinedVariables_) {
+        std::string name = group == INVALID_SYMBOL_ID
+            ? "@" + std::string(interner.name(variable))
+            : std::string(interner.name(group)) + "(" + std::string(interner.name(variable)) + ")";
+        ErrorBuilder(ErrorLevel::WARNING, ErrorType::REFERENCE_ERROR)
+            .withMessage("Undefined variable: " + name)
+            .report();
+    }
+    undefinedVariables_.clear();
+}
+
+void Generator::write(std::string_view text) {
+    if (capture_) {
+        capture_->append(text.data(), text.size());
+    } else {
+        output_.append(text);
+    }
 }
 
 void Generator::writeLine(const std::string& text) {
     if (!config_.minify) {
-        output_ << getIndent();
+        write(getIndent());
     }
-    output_ << text;
+    write(text);
     if (!config_.minify) {
-        output_ << config_.lineEnding;
+        write(config_.lineEnding);
     }
 }
 
@@ -601,110 +650,41 @@ std::string Generator::escapeJs(const std::string& text) {
     return text;
 }
 
-std::string Generator::processTemplateVariables(const std::string& input) {
-    std::string result = input;
-    
-    // 处理变量组模板调用 TemplateName(varName)
-    size_t pos = 0;
-    while ((pos = result.find('(', pos)) != std::string::npos) {
-        // 查找模板名
-        size_t start = pos;
-        while (start > 0 && (std::isalnum(result[start-1]) || result[start-1] == '_')) {
-            start--;
-        }
-        
-        if (start < pos) {
-            std::string templateName = result.substr(start, pos - start);
-            size_t endParen = result.find(')', pos);
-            
-            if (endParen != std::string::npos) {
-                std::string varName = result.substr(pos + 1, endParen - pos - 1);
-                
-                // 查找变量值
-                auto templateVars = varTemplateStorage_.find(templateName);
-                if (templateVars != varTemplateStorage_.end()) {
-                    auto varValue = templateVars->second.find(varName);
-                    if (varValue != templateVars->second.end()) {
-                        // 替换变量
-                        result = result.substr(0, start) + varValue->second + result.substr(endParen + 1);
-                        pos = start + varValue->second.length();
-                        continue;
-                    }
-                }
-            }
-        }
-        pos++;
-    }
-    
-    return result;
-}
-
 // 其他访问者方法的空实现
 void Generator::visitTemplateNode(TemplateNode* node) { 
     // 存储模板定义供后续使用
     if (node) {
-        templateStorage_[node->getName()] = node;
+        templateStorage_.assign(node->getNameId(), node);
+        invalidateExpansions();
         
         // 如果是变量组模板，提取变量
-        if (node->getTemplateType() == TemplateType::VAR && node->getContent()) {
-            auto content = node->getContent();
-            if (content->getType() == NodeType::ELEMENT) {
-                auto element = static_cast<ElementNode*>(content.get());
-                // 从属性中提取变量
-                for (const auto& [key, value] : element->getAttributes()) {
-                    varTemplateStorage_[node->getName()][key] = value;
-                }
-            }
+        if (node->getTemplateType() == TemplateType::VAR) {
+            registerVarGroup(node->getNameId(), node->getContent().get());
         }
     }
 }
 void Generator::visitTemplateUseNode(TemplateUseNode* node) {
     if (!node) return;
     
-    // 获取模板信息
-    const std::string& templateName = node->getName();
-    TemplateType templateType = node->getTemplateType();
-    
-    // 从模板存储中查找模板定义
-    auto templateDef = templateStorage_.find(templateName);
-    if (templateDef == templateStorage_.end()) {
-        ErrorBuilder(ErrorLevel::ERROR, ErrorType::REFERENCE_ERROR)
-            .withMessage("Undefined template: " + templateName)
-            .report();
-        return;
-    }
-    
-    switch (templateType) {
+    switch (node->getTemplateType()) {
         case TemplateType::STYLE: {
-            // 样式组模板使用 - 将模板中的属性添加到当前元素的样式中
+            // 样式组模板使用 - 将展开后的属性添加到当前元素的样式中
             if (currentState_.currentElementNode) {
-                // 获取模板内容
-                auto content = templateDef->second->getContent();
-                if (content && content->getType() == NodeType::STYLE_BLOCK) {
-                    auto styleNode = static_cast<StyleNode*>(content.get());
-                    for (const auto& rule : styleNode->getRules()) {
-                        if (rule->getType() == NodeType::PROPERTY) {
-                            auto prop = static_cast<PropertyNode*>(rule.get());
-                            if (!currentState_.pendingInlineStyles.empty()) {
-                                currentState_.pendingInlineStyles += " ";
-                            }
-                            currentState_.pendingInlineStyles += prop->getName() + ": " + processTemplateVariables(prop->getValue()) + ";";
-                        }
+                const ExpandedStyle* style = expandStyle(node);
+                if (style && !style->inlineText.empty()) {
+                    if (!currentState_.pendingInlineStyles.empty()) {
+                        currentState_.pendingInlineStyles += " ";
                     }
+                    currentState_.pendingInlineStyles += style->inlineText;
                 }
             }
             break;
         }
         
-        case TemplateType::ELEMENT: {
+        case TemplateType::ELEMENT:
             // 元素模板使用 - 将模板内容展开到当前位置
-            auto content = templateDef->second->getContent();
-            if (content) {
-                // 直接访问模板内容
-                content->accept(this);
-            }
+            expandElement(node);
             break;
-        }
         
         case TemplateType::VAR: {
             // 变量组模板在CSS值解析时处理
@@ -713,7 +693,233 @@ void Generator::visitTemplateUseNode(TemplateUseNode* node) {
         }
     }
 }
-void Generator::visitCustomNode(CustomNode* node) { (void)node; }
+
+void Generator::invalidateExpansions() {
+    // 定义可能改变任何已缓存的展开（继承链、变量组取值），整体清空
+    expansionCache_.clear();
+}
+
+const ExpandedStyle* Generator::expandStyle(TemplateUseNode* node) {
+    ExpansionKey key{node->getNameId(), ExpansionCache::fingerprint(node->getSpecializations())};
+    if (const ExpandedStyle* cached = expansionCache_.findStyle(key)) {
+        return cached;
+    }
+    
+    ExpandedStyle style;
+    if (!flattenStyle(node->getNameId(), node->getName(), style.properties)) {
+        return nullptr;
+    }
+    
+    // 使用处的特例化参数覆盖同名属性，空值删除该属性；
+    // "@Style 样式组" 删除该样式组展开后的全部属性
+    for (const auto& [name, value] : node->getSpecializations()) {
+        if (value.empty() && name.rfind("@Style ", 0) == 0) {
+            std::string group = name.substr(7);
+            std::vector<std::pair<std::string, std::string>> removed;
+            if (flattenStyle(SymbolInterner::getInstance().intern(group), group, removed)) {
+                for (const auto& entry : removed) {
+                    style.properties.erase(
+                        std::remove_if(style.properties.begin(), style.properties.end(),
+                                       [&](const auto& property) { return property.first == entry.first; }),
+                        style.properties.end());
+                }
+            }
+            continue;
+        }
+        auto it = std::find_if(style.properties.begin(), style.properties.end(),
+                               [&](const auto& property) { return property.first == name; });
+        if (value.empty()) {
+            if (it != style.properties.end()) {
+                style.properties.erase(it);
+            }
+        } else if (it != style.properties.end()) {
+            it->second = value;
+        } else {
+            style.properties.emplace_back(name, value);
+        }
+    }
+    
+    for (const auto& [name, value] : style.properties) {
+        if (!style.inlineText.empty()) {
+            style.inlineText += " ";
+        }
+        style.inlineText += name + ": " + value + ";";
+    }
+    return &expansionCache_.storeStyle(key, std::move(style));
+}
+
+bool Generator::flattenStyle(SymbolId name, const std::string& displayName,
+                             std::vector<std::pair<std::string, std::string>>& properties) {
+    if (std::find(expanding_.begin(), expanding_.end(), name) != expanding_.end()) {
+        ErrorBuilder(ErrorLevel::ERROR, ErrorType::REFERENCE_ERROR)
+            .withMessage("Circular style group inheritance: " + displayName)
+            .report();
+        return false;
+    }
+    
+    // 先查模板，再查自定义
+    std::shared_ptr<ASTNode> content;
+    TemplateNode* const* templateDef = templateStorage_.find(name);
+    CustomNode* const* customDef = customStorage_.find(name);
+    if (templateDef && (*templateDef)->getTemplateType() == TemplateType::STYLE) {
+        content = (*templateDef)->getContent();
+    } else if (customDef && (*customDef)->getCustomType() == CustomType::STYLE) {
+        content = (*customDef)->getContent();
+    } else {
+        ErrorBuilder(ErrorLevel::ERROR, ErrorType::REFERENCE_ERROR)
+            .withMessage("Undefined template: " + displayName)
+            .report();
+        return false;
+    }
+    if (!content || content->getType() != NodeType::STYLE_BLOCK) {
+        return true;
+    }
+    
+    // 同名属性后者覆盖前者，保留第一次出现的位置
+    auto setProperty = [&properties](const std::string& property, std::string value) {
+        for (auto& existing : properties) {
+            if (existing.first == property) {
+                existing.second = std::move(value);
+                return;
+            }
+        }
+        properties.emplace_back(property, std::move(value));
+    };
+    auto removeProperty = [&properties](const std::string& property) {
+        properties.erase(std::remove_if(properties.begin(), properties.end(),
+                                        [&](const auto& existing) { return existing.first == property; }),
+                         properties.end());
+    };
+    
+    expanding_.push_back(name);
+    for (const auto& rule : static_cast<StyleNode*>(content.get())->getRules()) {
+        if (!rule) continue;
+        switch (rule->getType()) {
+            case NodeType::PROPERTY: {
+                auto prop = static_cast<PropertyNode*>(rule.get());
+                setProperty(prop->getName(), renderValue(*prop));
+                break;
+            }
+            case NodeType::FUNCTION_CALL: {
+                // 组合/继承其他样式组
+                auto use = static_cast<TemplateUseNode*>(rule.get());
+                std::vector<std::pair<std::string, std::string>> inherited;
+                if (flattenStyle(use->getNameId(), use->getName(), inherited)) {
+                    for (auto& [property, value] : inherited) {
+                        setProperty(property, std::move(value));
+                    }
+                }
+                break;
+            }
+            case NodeType::DELETE_OP: {
+                // delete 属性; 或 delete @Style 样式组;
+                for (const auto& item : static_cast<DeleteNode*>(rule.get())->getDeleteItems()) {
+                    if (item.rfind("@Style ", 0) == 0) {
+                        std::string group = item.substr(7);
+                        std::vector<std::pair<std::string, std::string>> removed;
+                        if (flattenStyle(SymbolInterner::getInstance().intern(group), group, removed)) {
+                            for (const auto& entry : removed) {
+                                removeProperty(entry.first);
+                            }
+                        }
+                    } else {
+                        removeProperty(item);
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    expanding_.pop_back();
+    return true;
+}
+
+ASTNode* Generator::resolveElement(SymbolId name) {
+    TemplateNode* const* templateDef = templateStorage_.find(name);
+    if (templateDef && (*templateDef)->getTemplateType() == TemplateType::ELEMENT) {
+        return (*templateDef)->getContent().get();
+    }
+    CustomNode* const* customDef = customStorage_.find(name);
+    if (customDef && (*customDef)->getCustomType() == CustomType::ELEMENT) {
+        return (*customDef)->getContent().get();
+    }
+    return nullptr;
+}
+
+void Generator::expandElement(TemplateUseNode* node) {
+    SymbolId name = node->getNameId();
+    if (std::find(expanding_.begin(), expanding_.end(), name) != expanding_.end()) {
+        ErrorBuilder(ErrorLevel::ERROR, ErrorType::REFERENCE_ERROR)
+            .withMessage("Circular element template reference: " + node->getName())
+            .report();
+        return;
+    }
+    
+    ExpansionKey key{name, ExpansionCache::fingerprint(node->getSpecializations())};
+    ExpandedElement* expanded = expansionCache_.findElement(key);
+    if (!expanded) {
+        bool defined = templateStorage_.contains(name) || customStorage_.contains(name);
+        ASTNode* content = resolveElement(name);
+        if (!defined) {
+            ErrorBuilder(ErrorLevel::ERROR, ErrorType::REFERENCE_ERROR)
+                .withMessage("Undefined template: " + node->getName())
+                .report();
+            return;
+        }
+        ExpandedElement element;
+        if (content) {
+            element.nodes.push_back(content);
+        }
+        expanded = &expansionCache_.storeElement(key, std::move(element));
+    }
+    
+    if (expanded->emittable) {
+        if (const std::string* html = expanded->findHtml(indentLevel_)) {
+            write(*html);
+            return;
+        }
+    }
+    
+    // 渲染到临时字符串；没有产生全局样式/脚本时缓存结果
+    std::string rendered;
+    std::string* savedCapture = capture_;
+    capture_ = &rendered;
+    uint64_t generation = expansionCache_.generation();
+    size_t stylesBefore = globalStyles_.size();
+    size_t scriptsBefore = globalScripts_.size();
+    
+    expanding_.push_back(name);
+    for (ASTNode* content : expanded->nodes) {
+        content->accept(this);
+    }
+    expanding_.pop_back();
+    
+    capture_ = savedCapture;
+    write(rendered);
+    
+    // 渲染期间缓存被清空时expanded已失效，不再记录
+    if (expansionCache_.generation() == generation) {
+        if (globalStyles_.size() != stylesBefore || globalScripts_.size() != scriptsBefore) {
+            expanded->emittable = false;
+        } else if (expanded->emittable) {
+            expanded->html.emplace_back(indentLevel_, std::move(rendered));
+        }
+    }
+}
+
+void Generator::visitCustomNode(CustomNode* node) {
+    // 存储自定义定义，@Style/@Element使用时在模板之后查找
+    if (node) {
+        SymbolId name = SymbolInterner::getInstance().intern(node->getName());
+        customStorage_.assign(name, node);
+        invalidateExpansions();
+        if (node->getCustomType() == CustomType::VAR) {
+            registerVarGroup(name, node->getContent().get());
+        }
+    }
+}
 void Generator::visitCustomUseNode(CustomUseNode* node) { (void)node; }
 void Generator::visitOriginNode(OriginNode* node) { (void)node; }
 void Generator::visitOriginUseNode(OriginUseNode* node) { (void)node; }
@@ -757,8 +963,20 @@ void Generator::visitNamespaceNode(NamespaceNode* node) {
     // 但需要处理命名空间内的内容
     if (node) {
         for (const auto& child : node->getContent()) {
-            if (child) {
-                child->accept(this);
+            if (!child) continue;
+            switch (child->getType()) {
+                case NodeType::TEMPLATE:
+                    visitTemplateNode(static_cast<TemplateNode*>(child.get()));
+                    break;
+                case NodeType::CUSTOM:
+                    visitCustomNode(static_cast<CustomNode*>(child.get()));
+                    break;
+                case NodeType::NAMESPACE:
+                    visitNamespaceNode(static_cast<NamespaceNode*>(child.get()));
+                    break;
+                default:
+                    child->accept(this);
+                    break;
             }
         }
     }
@@ -797,8 +1015,7 @@ void Generator::generateCSSRule(SelectorNode* node) {
         for (const auto& rule : styleContent->getRules()) {
             if (rule && rule->getType() == NodeType::PROPERTY) {
                 auto prop = static_cast<PropertyNode*>(rule.get());
-                std::string value = processTemplateVariables(prop->getValue());
-                writeLine(prop->getName() + ": " + value + ";");
+                writeLine(prop->getName() + ": " + renderValue(*prop) + ";");
             }
         }
     }
@@ -812,32 +1029,36 @@ void Generator::generateSelector(SelectorNode* node) {
     
     switch (node->getSelectorType()) {
         case SelectorNode::SelectorType::CLASS:
-            output_ << "." << node->getSelector();
+            write(".");
+            write(node->getSelector());
             break;
         case SelectorNode::SelectorType::ID:
-            output_ << "#" << node->getSelector();
+            write("#");
+            write(node->getSelector());
             break;
         case SelectorNode::SelectorType::TAG:
-            output_ << node->getSelector();
+            write(node->getSelector());
             break;
         case SelectorNode::SelectorType::PSEUDO_CLASS: {
             std::string sel = node->getSelector();
             // 处理&:hover格式
             if (sel.find("&:") == 0) {
                 // TODO: 替换&为父选择器
-                output_ << sel.substr(1); // 暂时去掉&
+                write(std::string_view(sel).substr(1)); // 暂时去掉&
             } else {
-                output_ << ":" << sel;
+                write(":");
+                write(sel);
             }
             break;
         }
         case SelectorNode::SelectorType::PSEUDO_ELEMENT:
-            output_ << "::" << node->getSelector();
+            write("::");
+            write(node->getSelector());
             break;
         case SelectorNode::SelectorType::REFERENCE:
-            output_ << "&";
+            write("&");
             if (!node->getSelector().empty()) {
-                output_ << node->getSelector();
+                write(node->getSelector());
             }
             break;
         case SelectorNode::SelectorType::COMPOUND:
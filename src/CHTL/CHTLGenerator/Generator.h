@@ -18,6 +18,9 @@
 #include "../CHTLNode/NamespaceNode.h"
 #include "../CHTLNode/OperatorNode.h"
 #include "../CHTLContext/Context.h"
+#include "OutputRope.h"
+#include "ExpansionCache.h"
+#include "../../Util/SymbolInterner/SymbolMap.h"
 
 namespace CHTL {
 
@@ -33,8 +36,8 @@ struct GeneratorConfig {
 // HTML生成器
 class Generator : public Visitor {
 private:
-    // 模板变量存储
-    std::unordered_map<std::string, std::string> templateVars_;
+    // 模板变量存储（@name引用，键为驻留后的变量名ID）
+    SymbolMap<std::string> templateVars_;
     
 public:
     Generator(std::shared_ptr<CompileContext> context,
@@ -44,6 +47,9 @@ public:
     // 生成HTML
     std::string generate(std::shared_ptr<ProgramNode> program);
     
+    // 生成HTML并按顺序直接写入sink（文件描述符、流或内存），不拼接完整页面
+    void generate(std::shared_ptr<ProgramNode> program, OutputSink& sink);
+    
     // 访问者方法实现
     void visitProgramNode(ProgramNode* node);
     void visitElementNode(ElementNode* node);
@@ -71,13 +77,19 @@ public:
     void visitInheritNode(InheritNode* node);
     void visitExceptNode(ExceptNode* node);
     void visitUseNode(UseNode* node);
+    
+    // 模板/自定义展开缓存（用于统计）
+    const ExpansionCache& getExpansionCache() const { return expansionCache_; }
 
 private:
     std::shared_ptr<CompileContext> context_;
     GeneratorConfig config_;
-    std::stringstream output_;
-    std::stringstream globalStyles_;
-    std::stringstream globalScripts_;
+    OutputRope output_;                 // 页面正文（含全局样式/脚本插槽）
+    std::string* capture_ = nullptr;    // 非空时输出写入该字符串而不是正文
+    std::string globalStyles_;
+    std::string globalScripts_;
+    size_t headStylesSlot_ = 0;         // 第一个</head>之前：全局样式
+    size_t bodyScriptsSlot_ = 0;        // 第一个</body>之前：全局脚本
     int indentLevel_ = 0;
     
     // 生成状态
@@ -96,12 +108,24 @@ private:
     std::stack<GeneratorState> stateStack_;
     GeneratorState currentState_;
     
-    // 模板存储
-    std::unordered_map<std::string, TemplateNode*> templateStorage_;
-    std::unordered_map<std::string, std::unordered_map<std::string, std::string>> varTemplateStorage_;
+    // 模板存储（键为驻留后的模板名/变量名ID）
+    SymbolMap<TemplateNode*> templateStorage_;
+    SymbolMap<SymbolMap<std::string>> varTemplateStorage_;
+    SymbolMap<CustomNode*> customStorage_;
+    
+    // 展开结果按(名字, 特例化指纹)缓存，重复使用时直接复制或写出
+    ExpansionCache expansionCache_;
+    std::vector<SymbolId> expanding_;   // 正在展开的名字，用于检测循环引用
+    
+    // 生成期间遇到的未定义变量（变量组ID, 变量ID），生成结束后统一报告
+    std::vector<std::pair<SymbolId, SymbolId>> undefinedVariables_;
+    std::string valueBuffer_;           // 属性值渲染缓冲区，重复使用
+    
+    // 遍历程序并确定插槽内容，结果留在output_中
+    void generateDocument(ProgramNode* program);
     
     // 输出辅助方法
-    void write(const std::string& text);
+    void write(std::string_view text);
     void writeLine(const std::string& text = "");
     void indent();
     void dedent();
@@ -130,11 +154,18 @@ private:
     void applyAutoIds(ElementNode* element);
     
     // 模板展开
-    void expandTemplate(TemplateUseNode* node);
-    void expandCustom(CustomUseNode* node);
-    
-    // 变量替换
-    std::string replaceVariables(const std::string& value);
+    const ExpandedStyle* expandStyle(TemplateUseNode* node);
+    void expandElement(TemplateUseNode* node);
+    bool flattenStyle(SymbolId name, const std::string& displayName,
+                      std::vector<std::pair<std::string, std::string>>& properties);
+    ASTNode* resolveElement(SymbolId name);
+    void invalidateExpansions();
+    
+    // 变量替换：按属性值预编译的替换程序追加到out
+    void appendValue(const PropertyNode& property, std::string& out);
+    const std::string& renderValue(const PropertyNode& property);
+    void registerVarGroup(SymbolId name, ASTNode* content);
+    void reportUndefinedVariables();
     
     // 注释生成
     void generateHtmlComment(const std::string& comment);
@@ -150,7 +181,6 @@ private:
     std::string escapeHtml(const std::string& text);
     std::string escapeCss(const std::string& text);
     std::string escapeJs(const std::string& text);
-    std::string processTemplateVariables(const std::string& input);
 };
 
 // 生成器异常
@@ -0,0 +1,216 @@
+#include "OutputRope.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace CHTL {
+
+// FdOutputSink 实现
+
+FdOutputSink::FdOutputSink(int fd, size_t bufferSize)
+    : fd_(fd), buffer_(bufferSize == 0 ? 1 : bufferSize) {
+}
+
+FdOutputSink::~FdOutputSink() {
+    flush();
+}
+
+void FdOutputSink::write(const char* data, size_t length) {
+    if (used_ + length > buffer_.size()) {
+        flush();
+        // 大块数据直接写出，不经过缓冲
+        if (length >= buffer_.size()) {
+            writeAll(data, length);
+            return;
+        }
+    }
+    std::memcpy(buffer_.data() + used_, data, length);
+    used_ += length;
+}
+
+void FdOutputSink::flush() {
+    if (used_ > 0) {
+        writeAll(buffer_.data(), used_);
+        used_ = 0;
+    }
+}
+
+void FdOutputSink::writeAll(const char* data, size_t length) {
+    while (length > 0 && !failed_) {
+#ifdef _WIN32
+        int written = ::_write(fd_, data, static_cast<unsigned int>(length));
+#else
+        ssize_t written = ::write(fd_, data, length);
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            failed_ = true;
+            return;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+}
+
+// OutputRope 实现
+
+OutputRope::OutputRope(size_t chunkSize)
+    : chunkSize_(chunkSize == 0 ? 1 : chunkSize) {
+}
+
+void OutputRope::append(std::string_view text) {
+    if (text.empty()) {
+        return;
+    }
+    if (!pendingMarkers_.empty()) {
+        scanMarkers(text);
+    }
+
+    size_ += text.size();
+    while (!text.empty()) {
+        if (chunks_.empty() || chunks_.back().size() == chunks_.back().capacity()) {
+            chunks_.emplace_back();
+            chunks_.back().reserve(chunkSize_);
+        }
+        std::string& chunk = chunks_.back();
+        size_t count = std::min(text.size(), chunk.capacity() - chunk.size());
+        chunk.append(text.data(), count);
+        text.remove_prefix(count);
+    }
+}
+
+size_t OutputRope::addSlot() {
+    slots_.emplace_back();
+    return slots_.size() - 1;
+}
+
+void OutputRope::placeSlotAt(size_t slot, size_t offset) {
+    slots_[slot].offset = std::min(offset, size_);
+}
+
+void OutputRope::placeSlotBefore(size_t slot, std::string marker) {
+    if (marker.empty()) {
+        placeSlot(slot);
+        return;
+    }
+    maxMarkerLength_ = std::max(maxMarkerLength_, marker.size());
+    pendingMarkers_.push_back({slot, std::move(marker), size_});
+}
+
+void OutputRope::scanMarkers(std::string_view text) {
+    // tail_保存之前写入的最后maxMarkerLength_-1个字节，其起始偏移为size_ - tail_.size()
+    size_t tailStart = size_ - tail_.size();
+
+    for (auto it = pendingMarkers_.begin(); it != pendingMarkers_.end();) {
+        const std::string& marker = it->marker;
+        size_t found = npos;
+
+        // 跨越边界的匹配：只需检查text开头marker.size()-1个字节
+        if (!tail_.empty()) {
+            std::string window = tail_ + std::string(text.substr(0, marker.size() - 1));
+            size_t pos = window.find(marker);
+            if (pos != std::string::npos && pos < tail_.size() && tailStart + pos >= it->fromOffset) {
+                found = tailStart + pos;
+            }
+        }
+        if (found == npos) {
+            size_t pos = text.find(marker);
+            if (pos != std::string_view::npos) {
+                found = size_ + pos;
+            }
+        }
+
+        if (found != npos) {
+            slots_[it->slot].offset = found;
+            it = pendingMarkers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (pendingMarkers_.empty()) {
+        tail_.clear();
+        return;
+    }
+
+    size_t keep = maxMarkerLength_ - 1;
+    if (text.size() >= keep) {
+        tail_.assign(text.substr(text.size() - keep));
+    } else {
+        tail_.append(text.data(), text.size());
+        if (tail_.size() > keep) {
+            tail_.erase(0, tail_.size() - keep);
+        }
+    }
+}
+
+size_t OutputRope::totalSize() const {
+    size_t total = size_;
+    for (const auto& slot : slots_) {
+        if (slot.offset != npos) {
+            total += slot.content.size();
+        }
+    }
+    return total;
+}
+
+void OutputRope::writeTo(OutputSink& sink) const {
+    // 按位置排序已放置的插槽，位置相同时保持注册顺序
+    std::vector<size_t> order;
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        if (slots_[i].offset != npos) {
+            order.push_back(i);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return slots_[a].offset < slots_[b].offset;
+    });
+
+    auto nextSlot = order.begin();
+    size_t offset = 0;
+    for (const auto& chunk : chunks_) {
+        size_t chunkStart = offset;
+        size_t written = 0;
+        while (nextSlot != order.end() && slots_[*nextSlot].offset <= chunkStart + chunk.size()) {
+            size_t cut = slots_[*nextSlot].offset - chunkStart;
+            // 位于块末尾的插槽留给下一个块之前写出，使其排在下一块内容之前
+            if (cut == chunk.size() && &chunk != &chunks_.back()) {
+                break;
+            }
+            if (cut > written) {
+                sink.write(chunk.data() + written, cut - written);
+                written = cut;
+            }
+            sink.write(slots_[*nextSlot].content);
+            ++nextSlot;
+        }
+        if (written < chunk.size()) {
+            sink.write(chunk.data() + written, chunk.size() - written);
+        }
+        offset += chunk.size();
+    }
+
+    // 空正文或位于末尾的插槽
+    for (; nextSlot != order.end(); ++nextSlot) {
+        sink.write(slots_[*nextSlot].content);
+    }
+}
+
+void OutputRope::clear() {
+    chunks_.clear();
+    slots_.clear();
+    pendingMarkers_.clear();
+    tail_.clear();
+    maxMarkerLength_ = 0;
+    size_ = 0;
+}
+
+} // namespace CHTL
@@ -0,0 +1,142 @@
+#ifndef CHTL_OUTPUT_ROPE_H
+#define CHTL_OUTPUT_ROPE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ostream>
+
+namespace CHTL {
+
+// 输出目标
+class OutputSink {
+public:
+    virtual ~OutputSink() = default;
+    virtual void write(const char* data, size_t length) = 0;
+    virtual void flush() {}
+
+    void write(std::string_view text) { write(text.data(), text.size()); }
+};
+
+// 写入内存字符串
+class StringOutputSink : public OutputSink {
+public:
+    explicit StringOutputSink(std::string& target) : target_(target) {}
+    void write(const char* data, size_t length) override { target_.append(data, length); }
+
+    using OutputSink::write;
+
+private:
+    std::string& target_;
+};
+
+// 写入std::ostream
+class StreamOutputSink : public OutputSink {
+public:
+    explicit StreamOutputSink(std::ostream& stream) : stream_(stream) {}
+    void write(const char* data, size_t length) override {
+        stream_.write(data, static_cast<std::streamsize>(length));
+    }
+    void flush() override { stream_.flush(); }
+
+    using OutputSink::write;
+
+private:
+    std::ostream& stream_;
+};
+
+// 写入文件描述符（带缓冲，析构时自动flush，不关闭描述符）
+class FdOutputSink : public OutputSink {
+public:
+    explicit FdOutputSink(int fd, size_t bufferSize = 64 * 1024);
+    ~FdOutputSink() override;
+
+    void write(const char* data, size_t length) override;
+    void flush() override;
+
+    // 是否发生过写入错误
+    bool failed() const { return failed_; }
+
+    using OutputSink::write;
+
+private:
+    int fd_;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    bool failed_ = false;
+
+    void writeAll(const char* data, size_t length);
+};
+
+// 分段输出缓冲
+// 内容按固定大小的块追加，增长时从不搬移已写入的数据；
+// 命名插槽在生成过程中确定位置、随时填充内容，最终由writeTo()一次按顺序写出，
+// 不需要在完整文档上做查找和插入。
+class OutputRope {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    explicit OutputRope(size_t chunkSize = 64 * 1024);
+
+    // 追加文本
+    void append(std::string_view text);
+
+    // 注册插槽，返回插槽编号（位置未确定）
+    size_t addSlot();
+
+    // 将插槽放在当前末尾
+    void placeSlot(size_t slot) { placeSlotAt(slot, size_); }
+
+    // 将插槽放在指定偏移处（不晚于当前末尾）
+    void placeSlotAt(size_t slot, size_t offset);
+
+    // 插槽位置（未确定时为npos）
+    size_t slotOffset(size_t slot) const { return slots_[slot].offset; }
+
+    // 插槽内容
+    std::string& slotContent(size_t slot) { return slots_[slot].content; }
+
+    // 在之后追加的文本中查找marker第一次出现的位置（可跨越append边界），
+    // 找到时将插槽放在该位置之前
+    void placeSlotBefore(size_t slot, std::string marker);
+
+    // 正文长度（不含插槽）
+    size_t size() const { return size_; }
+
+    // 写出后的总长度（含已放置插槽的内容）
+    size_t totalSize() const;
+
+    // 按顺序写出正文和插槽内容，未放置的插槽被忽略
+    void writeTo(OutputSink& sink) const;
+
+    // 清空正文与插槽
+    void clear();
+
+private:
+    struct Slot {
+        size_t offset = npos;
+        std::string content;
+    };
+
+    struct PendingMarker {
+        size_t slot;
+        std::string marker;
+        size_t fromOffset;      // 只匹配注册之后写入的文本
+    };
+
+    size_t chunkSize_;
+    size_t size_ = 0;
+    std::vector<std::string> chunks_;
+    std::vector<Slot> slots_;
+    std::vector<PendingMarker> pendingMarkers_;
+
+    // 最近写入的若干字节，用于查找跨越append边界的marker
+    std::string tail_;
+    size_t maxMarkerLength_ = 0;
+
+    void scanMarkers(std::string_view text);
+};
+
+} // namespace CHTL
+
+#endif // CHTL_OUTPUT_ROPE_H
@@ -8,6 +8,20 @@
 #include <cstring>
 #include <thread>
 #include <regex>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#endif
 
 namespace CHTL {
 
@@ -554,12 +568,331 @@ size_t FileStream::size() {
     return fileSize;
 }
 
-// FileWatcher::Impl (简化实现)
+// FileWatcher::Impl
+// 文件路径通过监视其父目录实现，编辑器"写临时文件再rename"的保存方式同样能被捕获。
 class FileWatcher::Impl {
 public:
-    std::vector<std::string> paths;
+    using Clock = std::chrono::steady_clock;
+
+    struct WatchedPath {
+        std::string path;
+        bool recursive;
+    };
+
+    struct PendingChange {
+        std::string path;
+        FileType type;
+    };
+
+    // 持续有事件时，最迟在去抖窗口的该倍数后强制触发
+    static constexpr int MAX_DEBOUNCE_FACTOR = 10;
+
+    std::vector<WatchedPath> paths;
     ChangeCallback callback;
-    bool watching = false;
+    BatchCallback batchCallback;
+    std::chrono::milliseconds debounce{100};
+    std::atomic<bool> watching{false};
+    bool closeOnExit = false;  // 在回调中停止时由监视线程退出后自行释放资源
+    std::thread worker;
+    std::mutex mutex;
+
+    // 去抖状态（仅监视线程访问）
+    std::vector<PendingChange> pending;
+    std::unordered_set<std::string> pendingSet;
+    Clock::time_point firstEvent;
+    Clock::time_point lastEvent;
+
+    void recordChange(const std::string& path, FileType type) {
+        auto now = Clock::now();
+        if (pending.empty()) {
+            firstEvent = now;
+        }
+        lastEvent = now;
+        if (pendingSet.insert(path).second) {
+            pending.push_back({path, type});
+        }
+    }
+
+    // 距离下一次触发的毫秒数，无待处理事件时返回-1
+    int msUntilFlush() const {
+        if (pending.empty()) {
+            return -1;
+        }
+        auto deadline = std::min(lastEvent + debounce, firstEvent + debounce * MAX_DEBOUNCE_FACTOR);
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+        return std::max<int>(0, static_cast<int>(remaining.count()));
+    }
+
+    void flush() {
+        std::vector<PendingChange> changes;
+        changes.swap(pending);
+        pendingSet.clear();
+
+        std::vector<std::string> changedPaths;
+        changedPaths.reserve(changes.size());
+        for (const auto& change : changes) {
+            if (callback) {
+                callback(change.path, change.type);
+            }
+            changedPaths.push_back(change.path);
+        }
+        if (batchCallback && !changedPaths.empty()) {
+            batchCallback(changedPaths);
+        }
+    }
+
+    void flushIfDue() {
+        if (!pending.empty() && msUntilFlush() == 0) {
+            flush();
+        }
+    }
+
+#ifdef __linux__
+    struct DirWatch {
+        std::string dir;
+        bool wholeDir = false;                  // 目录本身被监视（否则只关心files中的文件）
+        bool recursive = false;
+        std::unordered_set<std::string> files;
+    };
+
+    int inotifyFd = -1;
+    int wakeFd = -1;  // eventfd，stop()时唤醒poll
+    std::unordered_map<int, DirWatch> watches;
+    std::unordered_map<std::string, int> dirToWatch;
+
+    static constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_DELETE |
+                                           IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF;
+
+    DirWatch* addDirWatch(const std::string& dir) {
+        int wd = inotify_add_watch(inotifyFd, dir.c_str(), WATCH_MASK);
+        if (wd < 0) {
+            return nullptr;
+        }
+        auto& watch = watches[wd];
+        watch.dir = dir;
+        dirToWatch[dir] = wd;
+        return &watch;
+    }
+
+    void addDirectoryTree(const std::string& dir, bool recursive) {
+        DirWatch* watch = addDirWatch(dir);
+        if (!watch) {
+            return;
+        }
+        watch->wholeDir = true;
+        watch->recursive = watch->recursive || recursive;
+        if (!recursive) {
+            return;
+        }
+
+        std::error_code ec;
+        for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+            if (it->is_directory(ec) && !it->is_symlink(ec)) {
+                addDirectoryTree(it->path().string(), true);
+            }
+        }
+    }
+
+    bool addWatches(const WatchedPath& watched) {
+        if (FileSystem::isDirectory(watched.path)) {
+            addDirectoryTree(watched.path, watched.recursive);
+            return dirToWatch.count(watched.path) > 0;
+        }
+
+        DirWatch* watch = addDirWatch(PathUtil::parent(watched.path));
+        if (!watch) {
+            return false;
+        }
+        watch->files.insert(PathUtil::filename(watched.path));
+        return true;
+    }
+
+    void removeAllWatches() {
+        for (const auto& entry : watches) {
+            inotify_rm_watch(inotifyFd, entry.first);
+        }
+        watches.clear();
+        dirToWatch.clear();
+    }
+
+    void handleEvent(const struct inotify_event& event) {
+        if (event.mask & IN_IGNORED) {
+            auto it = watches.find(event.wd);
+            if (it != watches.end()) {
+                dirToWatch.erase(it->second.dir);
+                watches.erase(it);
+            }
+            return;
+        }
+
+        auto it = watches.find(event.wd);
+        if (it == watches.end() || event.len == 0) {
+            return;
+        }
+
+        const DirWatch& watch = it->second;
+        std::string name = event.name;
+        if (!watch.wholeDir && watch.files.count(name) == 0) {
+            return;
+        }
+
+        std::string path = PathUtil::join(watch.dir, name);
+        bool isDir = (event.mask & IN_ISDIR) != 0;
+        if (isDir && watch.recursive && (event.mask & (IN_CREATE | IN_MOVED_TO))) {
+            addDirectoryTree(path, true);
+        }
+        recordChange(path, isDir ? FileType::Directory : FileType::Regular);
+    }
+
+    void run() {
+        alignas(struct inotify_event) char buffer[16 * 1024];
+
+        while (watching) {
+            struct pollfd fds[2] = {{inotifyFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+            int ready = poll(fds, 2, msUntilFlush());
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            if (fds[1].revents & POLLIN) {
+                break;
+            }
+
+            if (fds[0].revents & POLLIN) {
+                ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+                std::lock_guard<std::mutex> lock(mutex);
+                for (ssize_t offset = 0; offset < length;) {
+                    auto* event = reinterpret_cast<struct inotify_event*>(buffer + offset);
+                    handleEvent(*event);
+                    offset += sizeof(struct inotify_event) + event->len;
+                }
+            }
+
+            flushIfDue();
+        }
+    }
+
+    bool open() {
+        inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+        wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (inotifyFd < 0 || wakeFd < 0) {
+            close();
+            return false;
+        }
+
+        bool any = false;
+        for (const auto& watched : paths) {
+            any = addWatches(watched) || any;
+        }
+        if (!any) {
+            close();
+        }
+        return any;
+    }
+
+    void wake() {
+        if (wakeFd >= 0) {
+            uint64_t one = 1;
+            ssize_t written = write(wakeFd, &one, sizeof(one));
+            (void)written;
+        }
+    }
+
+    void close() {
+        watches.clear();
+        dirToWatch.clear();
+        if (inotifyFd >= 0) {
+            ::close(inotifyFd);
+            inotifyFd = -1;
+        }
+        if (wakeFd >= 0) {
+            ::close(wakeFd);
+            wakeFd = -1;
+        }
+    }
+
+    void refreshWatches() {
+        removeAllWatches();
+        for (const auto& watched : paths) {
+            addWatches(watched);
+        }
+    }
+#else
+    // 无inotify的平台：按去抖窗口周期比较修改时间
+    std::unordered_map<std::string, fs::file_time_type> snapshot;
+    std::condition_variable wakeup;
+
+    void collect(std::unordered_map<std::string, fs::file_time_type>& out) {
+        std::error_code ec;
+        for (const auto& watched : paths) {
+            if (!fs::is_directory(watched.path, ec)) {
+                out[watched.path] = fs::last_write_time(watched.path, ec);
+                continue;
+            }
+            if (watched.recursive) {
+                for (fs::recursive_directory_iterator it(watched.path, ec), end; !ec && it != end; it.increment(ec)) {
+                    out[it->path().string()] = it->last_write_time(ec);
+                }
+            } else {
+                for (fs::directory_iterator it(watched.path, ec), end; !ec && it != end; it.increment(ec)) {
+                    out[it->path().string()] = it->last_write_time(ec);
+                }
+            }
+        }
+    }
+
+    void scan() {
+        std::unordered_map<std::string, fs::file_time_type> current;
+        collect(current);
+        for (const auto& entry : current) {
+            auto it = snapshot.find(entry.first);
+            if (it == snapshot.end() || it->second != entry.second) {
+                recordChange(entry.first, FileSystem::isDirectory(entry.first) ? FileType::Directory : FileType::Regular);
+            }
+        }
+        for (const auto& entry : snapshot) {
+            if (current.count(entry.first) == 0) {
+                recordChange(entry.first, FileType::Regular);
+            }
+        }
+        snapshot.swap(current);
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (watching) {
+            wakeup.wait_for(lock, debounce, [this]() { return !watching; });
+            if (!watching) {
+                break;
+            }
+            scan();
+            lock.unlock();
+            flushIfDue();
+            lock.lock();
+        }
+    }
+
+    bool open() {
+        snapshot.clear();
+        collect(snapshot);
+        return true;
+    }
+
+    void wake() {
+        wakeup.notify_all();
+    }
+
+    void close() {
+        snapshot.clear();
+    }
+
+    void refreshWatches() {
+        snapshot.clear();
+        collect(snapshot);
+    }
+#endif
 };
 
 FileWatcher::FileWatcher() : pImpl(std::make_unique<Impl>()) {}
@@ -569,19 +902,36 @@ FileWatcher::~FileWatcher() {
 }
 
 bool FileWatcher::addPath(const std::string& path, bool recursive) {
-    (void)recursive; // TODO: 实现递归监视
     if (!FileSystem::exists(path)) {
         return false;
     }
     
-    pImpl->paths.push_back(path);
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    std::string normalized = PathUtil::normalize(PathUtil::absolute(path));
+    for (auto& watched : pImpl->paths) {
+        if (watched.path == normalized) {
+            watched.recursive = watched.recursive || recursive;
+            return true;
+        }
+    }
+    
+    pImpl->paths.push_back({normalized, recursive});
+    if (pImpl->watching) {
+        pImpl->refreshWatches();
+    }
     return true;
 }
 
 void FileWatcher::removePath(const std::string& path) {
-    auto it = std::find(pImpl->paths.begin(), pImpl->paths.end(), path);
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    std::string normalized = PathUtil::normalize(PathUtil::absolute(path));
+    auto it = std::find_if(pImpl->paths.begin(), pImpl->paths.end(),
+                           [&](const Impl::WatchedPath& watched) { return watched.path == normalized; });
     if (it != pImpl->paths.end()) {
         pImpl->paths.erase(it);
+        if (pImpl->watching) {
+            pImpl->refreshWatches();
+        }
     }
 }
 
@@ -589,18 +939,68 @@ void FileWatcher::setCallback(ChangeCallback callback) {
     pImpl->callback = callback;
 }
 
+void FileWatcher::setBatchCallback(BatchCallback callback) {
+    pImpl->batchCallback = callback;
+}
+
+void FileWatcher::setDebounceInterval(std::chrono::milliseconds interval) {
+    pImpl->debounce = std::max(interval, std::chrono::milliseconds(1));
+}
+
 bool FileWatcher::start() {
-    if (pImpl->watching || pImpl->paths.empty() || !pImpl->callback) {
+    if (pImpl->watching || pImpl->paths.empty() ||
+        (!pImpl->callback && !pImpl->batchCallback)) {
+        return false;
+    }
+    
+    // 上一次在回调中停止的线程可能尚未回收
+    if (pImpl->worker.joinable()) {
+        if (pImpl->worker.get_id() == std::this_thread::get_id()) {
+            return false;
+        }
+        pImpl->worker.join();
+    }
+    
+    if (!pImpl->open()) {
         return false;
     }
     
     pImpl->watching = true;
-    // 实际实现需要使用平台特定的文件监视API
+    pImpl->closeOnExit = false;
+    pImpl->worker = std::thread([this]() {
+        pImpl->run();
+        if (pImpl->closeOnExit) {
+            pImpl->close();
+            pImpl->pending.clear();
+            pImpl->pendingSet.clear();
+        }
+    });
     return true;
 }
 
 void FileWatcher::stop() {
-    pImpl->watching = false;
+    bool onWorker = pImpl->worker.joinable() && pImpl->worker.get_id() == std::this_thread::get_id();
+    if (!pImpl->watching.exchange(false)) {
+        // 回调中已停止的监视线程在此回收
+        if (!onWorker && pImpl->worker.joinable()) {
+            pImpl->worker.join();
+        }
+        return;
+    }
+    
+    if (onWorker) {
+        // 在回调中调用stop()时不能join自身，资源由监视线程在run()返回后释放
+        pImpl->closeOnExit = true;
+        return;
+    }
+    
+    pImpl->wake();
+    if (pImpl->worker.joinable()) {
+        pImpl->worker.join();
+    }
+    pImpl->close();
+    pImpl->pending.clear();
+    pImpl->pendingSet.clear();
 }
 
 bool FileWatcher::isWatching() const {
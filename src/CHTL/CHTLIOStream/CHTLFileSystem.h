@@ -7,6 +7,7 @@
 #include <functional>
 #include <fstream>
 #include <ctime>
+#include <chrono>
 #include <memory>
 
 namespace CHTL {
@@ -222,14 +223,18 @@ private:
 };
 
 // 文件监视器
+// Linux下基于inotify，其他平台退化为定时比较修改时间。
+// 去抖窗口内的事件会被合并：窗口结束后每个变化路径回调一次，随后批量回调一次。
+// 回调在监视线程中执行，路径均为规范化的绝对路径。
 class FileWatcher {
 public:
     using ChangeCallback = std::function<void(const std::string& path, FileType type)>;
+    using BatchCallback = std::function<void(const std::vector<std::string>& paths)>;
     
     FileWatcher();
     ~FileWatcher();
     
-    // 添加监视路径
+    // 添加监视路径（recursive仅对目录有效，包括之后新建的子目录）
     bool addPath(const std::string& path, bool recursive = false);
     
     // 移除监视路径
@@ -238,6 +243,12 @@ public:
     // 设置回调
     void setCallback(ChangeCallback callback);
     
+    // 设置批量回调（每个去抖窗口触发一次）
+    void setBatchCallback(BatchCallback callback);
+    
+    // 设置去抖窗口（默认100ms）
+    void setDebounceInterval(std::chrono::milliseconds interval);
+    
     // 开始监视
     bool start();
     
@@ -8,35 +8,32 @@ namespace CHTL {
 void GlobalMap::registerTemplate(const std::string& name, TemplateInfo::TemplateKind kind, 
                                 const std::string& file) {
     auto info = std::make_shared<TemplateInfo>(name, kind, file);
-    symbols_[name] = info;
+    symbols_.assign(SymbolInterner::getInstance().intern(name), info);
 }
 
 void GlobalMap::registerCustom(const std::string& name, CustomInfo::CustomKind kind,
                               const std::string& file) {
     auto info = std::make_shared<CustomInfo>(name, kind, file);
-    symbols_[name] = info;
+    symbols_.assign(SymbolInterner::getInstance().intern(name), info);
 }
 
 void GlobalMap::registerOrigin(const std::string& name, const std::string& type,
                               const std::string& file) {
     auto info = std::make_shared<OriginInfo>(name, type, file);
     std::string fullName = type + "_" + name;  // 使用类型前缀避免命名冲突
-    symbols_[fullName] = info;
+    symbols_.assign(SymbolInterner::getInstance().intern(fullName), info);
 }
 
 void GlobalMap::registerNamespace(const std::string& name, const std::string& file) {
-    auto info = std::make_shared<NamespaceInfo>(name, file);
-    namespaces_[name] = info;
+    auto& interner = SymbolInterner::getInstance();
+    auto info = std::make_shared<GlobalNamespaceInfo>(name, file);
+    SymbolPath path = interner.internPath(name);
+    namespaces_.assign(path.full, info);
     
     // 如果包含嵌套命名空间，处理父子关系
-    size_t dotPos = name.find_last_of('.');
-    if (dotPos != std::string::npos) {
-        std::string parentNs = name.substr(0, dotPos);
-        std::string childName = name.substr(dotPos + 1);
-        
-        auto parentIt = namespaces_.find(parentNs);
-        if (parentIt != namespaces_.end()) {
-            parentIt->second->addChildNamespace(childName);
+    if (path.scope != INVALID_SYMBOL_ID) {
+        if (auto* parent = namespaces_.find(path.scope)) {
+            (*parent)->addChildNamespace(std::string(interner.name(path.leaf)));
         }
     }
 }
@@ -44,31 +41,42 @@ void GlobalMap::registerNamespace(const std::string& name, const std::string& fi
 void GlobalMap::registerConfiguration(const std::string& name, const std::string& file) {
     auto info = std::make_shared<ConfigurationInfo>(name, file);
     std::string configName = name.empty() ? "__default_config__" : name;
-    symbols_[configName] = info;
+    symbols_.assign(SymbolInterner::getInstance().intern(configName), info);
 }
 
 std::shared_ptr<SymbolInfo> GlobalMap::lookupSymbol(const std::string& name) const {
+    // 未驻留的名字不可能被登记过
+    return lookupSymbol(SymbolInterner::getInstance().find(name));
+}
+
+std::shared_ptr<SymbolInfo> GlobalMap::lookupSymbol(const std::string& name, 
+                                                    const std::string& namespacePath) const {
+    auto& interner = SymbolInterner::getInstance();
+    return lookupSymbol(interner.find(name), interner.find(namespacePath));
+}
+
+std::shared_ptr<SymbolInfo> GlobalMap::lookupSymbol(SymbolId name) const {
+    if (name == INVALID_SYMBOL_ID) {
+        return nullptr;
+    }
+    
     // 首先检查别名
-    auto aliasIt = aliasMap_.find(name);
-    std::string lookupName = (aliasIt != aliasMap_.end()) ? aliasIt->second : name;
+    if (const SymbolId* target = aliasMap_.find(name)) {
+        name = *target;
+    }
     
-    auto it = symbols_.find(lookupName);
-    if (it != symbols_.end()) {
-        return it->second;
+    if (const auto* info = symbols_.find(name)) {
+        return *info;
     }
     return nullptr;
 }
 
-std::shared_ptr<SymbolInfo> GlobalMap::lookupSymbol(const std::string& name, 
-                                                    const std::string& namespacePath) const {
+std::shared_ptr<SymbolInfo> GlobalMap::lookupSymbol(SymbolId name, SymbolId namespacePath) const {
     // 在指定命名空间中查找符号
-    auto nsIt = namespaces_.find(namespacePath);
-    if (nsIt != namespaces_.end()) {
-        auto symbolType = nsIt->second->getSymbol(name);
-        if (symbolType.has_value()) {
-            // 构造完整名称并查找
-            std::string fullName = namespacePath + "." + name;
-            return lookupSymbol(fullName);
+    if (const auto* ns = namespaces_.find(namespacePath)) {
+        if ((*ns)->getSymbol(name).has_value()) {
+            // 完整名称的ID由驻留表缓存，不再拼接字符串
+            return lookupSymbol(SymbolInterner::getInstance().qualify(namespacePath, name));
         }
     }
     
@@ -107,7 +115,8 @@ void GlobalMap::addImportedSymbol(const std::string& symbol, const std::string&
     
     // 如果有别名，添加到别名映射
     if (!alias.empty()) {
-        aliasMap_[alias] = symbol;
+        auto& interner = SymbolInterner::getInstance();
+        aliasMap_.assign(interner.intern(alias), interner.intern(symbol));
     }
 }
 
@@ -155,9 +164,10 @@ void GlobalMap::clear() {
 std::vector<std::string> GlobalMap::getAllSymbols() const {
     std::vector<std::string> result;
     
-    for (const auto& [name, info] : symbols_) {
+    auto& interner = SymbolInterner::getInstance();
+    for (const auto& [id, info] : symbols_) {
         std::stringstream ss;
-        ss << name << " (" << static_cast<int>(info->getType()) << ") from " << info->getSourceFile();
+        ss << interner.name(id) << " (" << static_cast<int>(info->getType()) << ") from " << info->getSourceFile();
         result.push_back(ss.str());
     }
     
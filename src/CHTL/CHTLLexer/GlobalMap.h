@@ -7,6 +7,8 @@
 #include <memory>
 #include <vector>
 #include <optional>
+#include "../../Util/ScopedInstance.h"
+#include "../../Util/SymbolInterner/SymbolMap.h"
 
 namespace CHTL {
 
@@ -14,7 +16,7 @@ namespace CHTL {
 class TemplateInfo;
 class CustomInfo;
 class OriginInfo;
-class NamespaceInfo;
+class GlobalNamespaceInfo;
 class ConfigurationInfo;
 
 // 全局符号类型
@@ -127,9 +129,9 @@ private:
 };
 
 // 命名空间信息
-class NamespaceInfo : public SymbolInfo {
+class GlobalNamespaceInfo : public SymbolInfo {
 public:
-    NamespaceInfo(const std::string& name, const std::string& file)
+    GlobalNamespaceInfo(const std::string& name, const std::string& file)
         : SymbolInfo(name, SymbolType::NAMESPACE, file) {}
     
     // 添加子命名空间
@@ -139,21 +141,24 @@ public:
     
     // 添加符号到命名空间
     void addSymbol(const std::string& symbol, SymbolType type) {
-        symbols_[symbol] = type;
+        symbols_.assign(SymbolInterner::getInstance().intern(symbol), type);
     }
     
     // 获取符号
     std::optional<SymbolType> getSymbol(const std::string& symbol) const {
-        auto it = symbols_.find(symbol);
-        if (it != symbols_.end()) {
-            return it->second;
+        return getSymbol(SymbolInterner::getInstance().find(symbol));
+    }
+    
+    std::optional<SymbolType> getSymbol(SymbolId symbol) const {
+        if (const SymbolType* type = symbols_.find(symbol)) {
+            return *type;
         }
         return std::nullopt;
     }
     
 private:
     std::unordered_set<std::string> childNamespaces_;
-    std::unordered_map<std::string, SymbolType> symbols_;
+    SymbolMap<SymbolType> symbols_;
 };
 
 // 配置信息
@@ -186,6 +191,9 @@ private:
 class GlobalMap {
 public:
     static GlobalMap& getInstance() {
+        if (auto* scoped = ScopedInstance<GlobalMap>::current()) {
+            return *scoped;
+        }
         static GlobalMap instance;
         return instance;
     }
@@ -215,6 +223,10 @@ public:
     std::shared_ptr<SymbolInfo> lookupSymbol(const std::string& name, 
                                             const std::string& namespacePath) const;
     
+    // 按符号ID查找（名字已驻留时使用，不再对字符串求哈希）
+    std::shared_ptr<SymbolInfo> lookupSymbol(SymbolId name) const;
+    std::shared_ptr<SymbolInfo> lookupSymbol(SymbolId name, SymbolId namespacePath) const;
+    
     // 获取当前文件的默认命名空间
     std::string getDefaultNamespace(const std::string& file) const;
     
@@ -235,15 +247,16 @@ public:
     std::vector<std::string> getAllSymbols() const;
 
 private:
+    friend class ScopedInstance<GlobalMap>;
     GlobalMap() = default;
     GlobalMap(const GlobalMap&) = delete;
     GlobalMap& operator=(const GlobalMap&) = delete;
     
-    // 符号表
-    std::unordered_map<std::string, std::shared_ptr<SymbolInfo>> symbols_;
+    // 符号表（键为驻留后的符号ID）
+    SymbolMap<std::shared_ptr<SymbolInfo>> symbols_;
     
     // 命名空间映射
-    std::unordered_map<std::string, std::shared_ptr<NamespaceInfo>> namespaces_;
+    SymbolMap<std::shared_ptr<GlobalNamespaceInfo>> namespaces_;
     
     // 文件默认命名空间映射
     std::unordered_map<std::string, std::string> fileNamespaces_;
@@ -252,7 +265,7 @@ private:
     std::unordered_map<std::string, std::unordered_set<std::string>> importGraph_;
     
     // 别名映射
-    std::unordered_map<std::string, std::string> aliasMap_;
+    SymbolMap<SymbolId> aliasMap_;
 };
 
 } // namespace CHTL
@@ -7,25 +7,28 @@ namespace CHTL {
 
 Lexer::Lexer(const std::string& source, std::shared_ptr<CompileContext> context,
              const LexerConfig& config)
-    : source_(source), context_(context), config_(config) {
+    : ownedSource_(source), source_(ownedSource_), context_(context), config_(config) {
+    context_->setPosition(line_, column_);
+}
+
+Lexer::Lexer(std::string_view source, TokenArena& arena, std::shared_ptr<CompileContext> context,
+             const LexerConfig& config)
+    : source_(source), context_(context), config_(config), arena_(&arena) {
     context_->setPosition(line_, column_);
 }
 
 std::shared_ptr<Token> Lexer::nextToken() {
     // 如果缓冲区有Token，先返回缓冲区的
     if (!tokenBuffer_.empty()) {
-        auto token = tokenBuffer_.front();
-        tokenBuffer_.pop();
-        return token;
+        return tokenBuffer_.pop();
     }
     
-    return scanToken();
+    return materialize(scanToken());
 }
 
 std::shared_ptr<Token> Lexer::peekToken() {
     if (tokenBuffer_.empty()) {
-        auto token = scanToken();
-        tokenBuffer_.push(token);
+        tokenBuffer_.push(materialize(scanToken()));
     }
     return tokenBuffer_.front();
 }
@@ -33,28 +36,112 @@ std::shared_ptr<Token> Lexer::peekToken() {
 std::vector<std::shared_ptr<Token>> Lexer::peekTokens(size_t count) {
     // 确保缓冲区有足够的Token
     while (tokenBuffer_.size() < count && !isAtEnd()) {
-        tokenBuffer_.push(scanToken());
+        tokenBuffer_.push(materialize(scanToken()));
     }
     
-    // 返回缓冲区中的Token
+    // 直接读取环形缓冲区中的Token
     std::vector<std::shared_ptr<Token>> result;
-    std::queue<std::shared_ptr<Token>> temp = tokenBuffer_;
+    size_t available = std::min(count, tokenBuffer_.size());
+    result.reserve(available);
+    for (size_t i = 0; i < available; ++i) {
+        result.push_back(tokenBuffer_[i]);
+    }
+    
+    return result;
+}
+
+const TokenView* Lexer::nextTokenView() {
+    if (!viewBuffer_.empty()) {
+        return viewBuffer_.pop();
+    }
+    
+    return materializeView(scanToken());
+}
+
+const TokenView* Lexer::peekTokenView(size_t offset) {
+    while (viewBuffer_.size() <= offset) {
+        viewBuffer_.push(materializeView(scanToken()));
+    }
+    return viewBuffer_[offset];
+}
+
+std::vector<const TokenView*> Lexer::peekTokenViews(size_t count) {
+    while (viewBuffer_.size() < count && !isAtEnd()) {
+        viewBuffer_.push(materializeView(scanToken()));
+    }
     
-    while (!temp.empty() && result.size() < count) {
-        result.push_back(temp.front());
-        temp.pop();
+    std::vector<const TokenView*> result;
+    size_t available = std::min(count, viewBuffer_.size());
+    result.reserve(available);
+    for (size_t i = 0; i < available; ++i) {
+        result.push_back(viewBuffer_[i]);
     }
     
     return result;
 }
 
+std::vector<const TokenView*> Lexer::tokenizeAllViews() {
+    std::vector<const TokenView*> tokens;
+    reset();
+    
+    while (true) {
+        const TokenView* token = nextTokenView();
+        tokens.push_back(token);
+        if (token->type == TokenType::EOF_TOKEN) {
+            break;
+        }
+    }
+    
+    return tokens;
+}
+
 void Lexer::reset() {
     current_ = 0;
     line_ = 1;
     column_ = 1;
-    while (!tokenBuffer_.empty()) {
-        tokenBuffer_.pop();
+    tokenBuffer_.clear();
+    viewBuffer_.clear();
+}
+
+void Lexer::seek(size_t offset, size_t line, size_t column) {
+    current_ = std::min(offset, source_.size());
+    line_ = line;
+    column_ = column;
+    tokenBuffer_.clear();
+    viewBuffer_.clear();
+    context_->setPosition(line_, column_);
+}
+
+TokenArena& Lexer::arena() {
+    if (!arena_) {
+        ownedArena_ = std::make_unique<TokenArena>();
+        arena_ = ownedArena_.get();
+    }
+    return *arena_;
+}
+
+std::shared_ptr<Token> Lexer::materialize(const ScannedToken& scanned) const {
+    std::string lexeme = scanned.lexemeDecoded
+        ? decoded_
+        : std::string(source_.substr(scanned.lexemeStart, scanned.lexemeLength));
+    return std::make_shared<Token>(scanned.type, lexeme, scanned.location, scanned.value);
+}
+
+const TokenView* Lexer::materializeView(const ScannedToken& scanned) {
+    TokenView view;
+    view.type = scanned.type;
+    view.location = scanned.location;
+    view.lexeme = scanned.lexemeDecoded
+        ? arena().storeText(decoded_)
+        : source_.substr(scanned.lexemeStart, scanned.lexemeLength);
+    
+    if (auto integer = std::get_if<int64_t>(&scanned.value)) {
+        view.value = *integer;
+    } else if (auto real = std::get_if<double>(&scanned.value)) {
+        view.value = *real;
     }
+    
+    return arena().allocate(view);
 }
 
 std::vector<std::shared_ptr<Token>> Lexer::tokenizeAll() {
@@ -72,7 +159,7 @@ std::vector<std::shared_ptr<Token>> Lexer::tokenizeAll() {
     return tokens;
 }
 
-std::shared_ptr<Token> Lexer::scanToken() {
+Lexer::ScannedToken Lexer::scanToken() {
     // 跳过空白字符
     if (config_.skipWhitespace) {
         skipWhitespace();
@@ -226,7 +313,7 @@ bool Lexer::isAtEnd(size_t offset) const {
 
 // Provide the no-argument version
 bool Lexer::isAtEnd() const {
-    return current_ >= source_.length() && tokenBuffer_.empty();
+    return current_ >= source_.length() && tokenBuffer_.empty() && viewBuffer_.empty();
 }
 
 void Lexer::skipWhitespace() {
@@ -259,7 +346,7 @@ void Lexer::skipMultiLineComment() {
     }
 }
 
-std::shared_ptr<Token> Lexer::scanGeneratorComment() {
+Lexer::ScannedToken Lexer::scanGeneratorComment() {
     size_t start = current_;
     
     // 读取到行尾
@@ -267,31 +354,39 @@ std::shared_ptr<Token> Lexer::scanGeneratorComment() {
         advance();
     }
     
-    std::string comment = source_.substr(start, current_ - start);
-    return makeToken(TokenType::GENERATOR_COMMENT, comment);
+    return makeToken(TokenType::GENERATOR_COMMENT, start, current_ - start);
 }
 
-std::shared_ptr<Token> Lexer::scanString(char quote) {
-    std::string value;
+Lexer::ScannedToken Lexer::scanString(char quote) {
+    size_t contentStart = current_;
+    bool hasEscape = false;
     
     while (!isAtEnd() && peek() != quote) {
         if (peek() == '\\') {
+            // 首次遇到转义时才开始构建解码文本，之前的内容直接从源码复制
+            if (!hasEscape) {
+                hasEscape = true;
+                decoded_.assign(source_.data() + contentStart, current_ - contentStart);
+            }
             advance();  // 跳过反斜杠
             if (!isAtEnd()) {
                 char escaped = advance();
                 // 处理转义字符
                 switch (escaped) {
-                    case 'n': value += '\n'; break;
-                    case 't': value += '\t'; break;
-                    case 'r': value += '\r'; break;
-                    case '\\': value += '\\'; break;
-                    case '"': value += '"'; break;
-                    case '\'': value += '\''; break;
-                    default: value += escaped; break;
+                    case 'n': decoded_ += '\n'; break;
+                    case 't': decoded_ += '\t'; break;
+                    case 'r': decoded_ += '\r'; break;
+                    case '\\': decoded_ += '\\'; break;
+                    case '"': decoded_ += '"'; break;
+                    case '\'': decoded_ += '\''; break;
+                    default: decoded_ += escaped; break;
                 }
             }
         } else {
-            value += advance();
+            char c = advance();
+            if (hasEscape) {
+                decoded_ += c;
+            }
         }
     }
     
@@ -299,13 +394,17 @@ std::shared_ptr<Token> Lexer::scanString(char quote) {
         return errorToken("Unterminated string");
     }
     
+    size_t contentLength = current_ - contentStart;
+    
     // 跳过结束引号
     advance();
     
-    return makeToken(TokenType::STRING_LITERAL, value);
+    ScannedToken token = makeToken(TokenType::STRING_LITERAL, contentStart, contentLength);
+    token.lexemeDecoded = hasEscape;
+    return token;
 }
 
-std::shared_ptr<Token> Lexer::scanNumber() {
+Lexer::ScannedToken Lexer::scanNumber() {
     while (isDigit(peek())) {
         advance();
     }
@@ -318,7 +417,7 @@ std::shared_ptr<Token> Lexer::scanNumber() {
         }
     }
     
-    std::string numberStr = source_.substr(tokenStart_, current_ - tokenStart_);
+    std::string numberStr(source_.substr(tokenStart_, current_ - tokenStart_));
     
     // 尝试解析为整数或浮点数
     if (numberStr.find('.') != std::string::npos) {
@@ -330,12 +429,12 @@ std::shared_ptr<Token> Lexer::scanNumber() {
     }
 }
 
-std::shared_ptr<Token> Lexer::scanIdentifier() {
+Lexer::ScannedToken Lexer::scanIdentifier() {
     while (isIdentifierPart(peek())) {
         advance();
     }
     
-    std::string identifier = source_.substr(tokenStart_, current_ - tokenStart_);
+    std::string identifier(source_.substr(tokenStart_, current_ - tokenStart_));
     
     // 检查是否为 "at top" 或 "at bottom"
     if (identifier == "at" && checkAtTopBottom()) {
@@ -348,16 +447,15 @@ std::shared_ptr<Token> Lexer::scanIdentifier() {
     return makeToken(type);
 }
 
-std::shared_ptr<Token> Lexer::scanUnquotedLiteral() {
+Lexer::ScannedToken Lexer::scanUnquotedLiteral() {
     while (!isAtEnd() && isUnquotedLiteralChar(peek())) {
         advance();
     }
     
-    std::string literal = source_.substr(tokenStart_, current_ - tokenStart_);
-    return makeToken(TokenType::UNQUOTED_LITERAL, literal);
+    return makeToken(TokenType::UNQUOTED_LITERAL);
 }
 
-std::shared_ptr<Token> Lexer::scanBracketKeyword() {
+Lexer::ScannedToken Lexer::scanBracketKeyword() {
     // 已经消费了 [，现在扫描到 ]
     while (!isAtEnd() && peek() != ']') {
         advance();
@@ -370,22 +468,22 @@ std::shared_ptr<Token> Lexer::scanBracketKeyword() {
     // 消费 ]
     advance();
     
-    std::string keyword = source_.substr(tokenStart_, current_ - tokenStart_);
+    std::string keyword(source_.substr(tokenStart_, current_ - tokenStart_));
     TokenType type = getKeywordType(keyword);
     
-    return makeToken(type, keyword);
+    return makeToken(type);
 }
 
-std::shared_ptr<Token> Lexer::scanTypeIdentifier() {
+Lexer::ScannedToken Lexer::scanTypeIdentifier() {
     // 已经消费了 @，现在扫描标识符部分
     while (isAlphaNumeric(peek())) {
         advance();
     }
     
-    std::string typeId = source_.substr(tokenStart_, current_ - tokenStart_);
+    std::string typeId(source_.substr(tokenStart_, current_ - tokenStart_));
     TokenType type = getTypeIdentifierType(typeId);
     
-    return makeToken(type, typeId);
+    return makeToken(type);
 }
 
 bool Lexer::checkAtTopBottom() {
@@ -444,27 +542,27 @@ bool Lexer::isUnquotedLiteralChar(char c) const {
            c == ' ' || c == '\t';  // 允许空格和制表符
 }
 
-std::shared_ptr<Token> Lexer::makeToken(TokenType type) const {
-    std::string lexeme = source_.substr(tokenStart_, current_ - tokenStart_);
-    TokenLocation loc(tokenStartLine_, tokenStartColumn_, tokenStart_, 
-                      current_ - tokenStart_);
-    return std::make_shared<Token>(type, lexeme, loc);
+Lexer::ScannedToken Lexer::makeToken(TokenType type) const {
+    return makeToken(type, tokenStart_, current_ - tokenStart_);
 }
 
-std::shared_ptr<Token> Lexer::makeToken(TokenType type, const std::string& lexeme) const {
-    TokenLocation loc(tokenStartLine_, tokenStartColumn_, tokenStart_, 
-                      current_ - tokenStart_);
-    return std::make_shared<Token>(type, lexeme, loc);
+Lexer::ScannedToken Lexer::makeToken(TokenType type, size_t lexemeStart, size_t lexemeLength) const {
+    ScannedToken token;
+    token.type = type;
+    token.lexemeStart = lexemeStart;
+    token.lexemeLength = lexemeLength;
+    token.location = TokenLocation(tokenStartLine_, tokenStartColumn_, tokenStart_,
+                                   current_ - tokenStart_);
+    return token;
 }
 
-std::shared_ptr<Token> Lexer::makeToken(TokenType type, const TokenValue& value) const {
-    std::string lexeme = source_.substr(tokenStart_, current_ - tokenStart_);
-    TokenLocation loc(tokenStartLine_, tokenStartColumn_, tokenStart_, 
-                      current_ - tokenStart_);
-    return std::make_shared<Token>(type, lexeme, loc, value);
+Lexer::ScannedToken Lexer::makeToken(TokenType type, const TokenValue& value) const {
+    ScannedToken token = makeToken(type);
+    token.value = value;
+    return token;
 }
 
-std::shared_ptr<Token> Lexer::errorToken(const std::string& message) const {
+Lexer::ScannedToken Lexer::errorToken(const std::string& message) const {
     context_->addError(message, tokenStartLine_, tokenStartColumn_);
     return makeToken(TokenType::UNKNOWN);
 }
@@ -2,11 +2,13 @@
 #define CHTL_LEXER_H
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
-#include <queue>
 #include "Token.h"
+#include "TokenArena.h"
 #include "../CHTLContext/Context.h"
+#include "../../Util/RingBuffer.h"
 
 namespace CHTL {
 
@@ -23,8 +25,20 @@ class Lexer {
 public:
     Lexer(const std::string& source, std::shared_ptr<CompileContext> context,
           const LexerConfig& config = LexerConfig());
+    
+    // 零拷贝模式：借用源码缓冲区（不复制，调用方保证其生命周期长于Lexer及所有Token），
+    // Token以值的形式分配在arena中，词素为源码切片
+    Lexer(std::string_view source, TokenArena& arena, std::shared_ptr<CompileContext> context,
+          const LexerConfig& config = LexerConfig());
     ~Lexer() = default;
     
+    // 禁止拷贝和移动：source_可能指向ownedSource_的内联缓冲区（短字符串优化），
+    // 已交出的TokenView也切片自该缓冲区，移动后都会悬空
+    Lexer(const Lexer&) = delete;
+    Lexer& operator=(const Lexer&) = delete;
+    Lexer(Lexer&&) = delete;
+    Lexer& operator=(Lexer&&) = delete;
+    
     // 获取下一个Token
     std::shared_ptr<Token> nextToken();
     
@@ -44,14 +58,42 @@ public:
     // 重置词法分析器
     void reset();
     
+    // 从源码的offset处继续扫描，line/column为该处的位置；预读的Token被丢弃
+    // 增量解析从受影响块的起点重新扫描，调用方保证offset位于Token边界
+    void seek(size_t offset, size_t line, size_t column);
+    
     // 获取所有Token（用于调试）
     std::vector<std::shared_ptr<Token>> tokenizeAll();
+    
+    // 零拷贝接口：返回的Token属于arena，在arena清空前有效
+    const TokenView* nextTokenView();
+    const TokenView* peekTokenView(size_t offset = 0);
+    std::vector<const TokenView*> peekTokenViews(size_t count);
+    std::vector<const TokenView*> tokenizeAllViews();
 
 private:
-    std::string source_;
+    // 扫描结果（尚未物化为Token）
+    struct ScannedToken {
+        TokenType type = TokenType::UNKNOWN;
+        size_t lexemeStart = 0;      // 词素在源码中的切片
+        size_t lexemeLength = 0;
+        bool lexemeDecoded = false;  // 词素为转义处理后的文本，位于decoded_
+        TokenLocation location;
+        TokenValue value;
+    };
+    
+    std::string ownedSource_;        // 传统模式下持有的源码副本
+    std::string_view source_;
     std::shared_ptr<CompileContext> context_;
     LexerConfig config_;
     
+    // 零拷贝模式的Token存储（未提供外部arena时按需创建）
+    TokenArena* arena_ = nullptr;
+    std::unique_ptr<TokenArena> ownedArena_;
+    
+    // 转义字符串的解码缓冲区（复用，避免逐Token分配）
+    std::string decoded_;
+    
     // 位置追踪
     size_t current_ = 0;
     size_t line_ = 1;
@@ -60,11 +102,15 @@ private:
     size_t tokenStartLine_ = 1;
     size_t tokenStartColumn_ = 1;
     
-    // Token缓冲区（用于peek功能）
-    std::queue<std::shared_ptr<Token>> tokenBuffer_;
+    // Token预读缓冲区（环形缓冲，用于peek功能）
+    RingBuffer<std::shared_ptr<Token>> tokenBuffer_;
+    RingBuffer<const TokenView*> viewBuffer_;
     
     // 内部方法
-    std::shared_ptr<Token> scanToken();
+    ScannedToken scanToken();
+    std::shared_ptr<Token> materialize(const ScannedToken& scanned) const;
+    const TokenView* materializeView(const ScannedToken& scanned);
+    TokenArena& arena();
     
     // 字符操作
     char advance();
@@ -77,15 +123,15 @@ private:
     void skipWhitespace();
     void skipSingleLineComment();
     void skipMultiLineComment();
-    std::shared_ptr<Token> scanGeneratorComment();
+    ScannedToken scanGeneratorComment();
     
     // 扫描不同类型的Token
-    std::shared_ptr<Token> scanString(char quote);
-    std::shared_ptr<Token> scanNumber();
-    std::shared_ptr<Token> scanIdentifier();
-    std::shared_ptr<Token> scanUnquotedLiteral();
-    std::shared_ptr<Token> scanBracketKeyword();  // 扫描[...]形式的关键字
-    std::shared_ptr<Token> scanTypeIdentifier();  // 扫描@开头的类型标识符
+    ScannedToken scanString(char quote);
+    ScannedToken scanNumber();
+    ScannedToken scanIdentifier();
+    ScannedToken scanUnquotedLiteral();
+    ScannedToken scanBracketKeyword();  // 扫描[...]形式的关键字
+    ScannedToken scanTypeIdentifier();  // 扫描@开头的类型标识符
     
     // 辅助方法
     bool isDigit(char c) const;
@@ -96,12 +142,12 @@ private:
     bool isUnquotedLiteralChar(char c) const;
     
     // 创建Token
-    std::shared_ptr<Token> makeToken(TokenType type) const;
-    std::shared_ptr<Token> makeToken(TokenType type, const std::string& lexeme) const;
-    std::shared_ptr<Token> makeToken(TokenType type, const TokenValue& value) const;
+    ScannedToken makeToken(TokenType type) const;
+    ScannedToken makeToken(TokenType type, size_t lexemeStart, size_t lexemeLength) const;
+    ScannedToken makeToken(TokenType type, const TokenValue& value) const;
     
     // 错误处理
-    std::shared_ptr<Token> errorToken(const std::string& message) const;
+    ScannedToken errorToken(const std::string& message) const;
     
     // 更新位置信息
     void updatePosition(char c);
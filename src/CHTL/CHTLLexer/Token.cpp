@@ -129,6 +129,18 @@ std::string Token::toString() const {
     return ss.str();
 }
 
+std::shared_ptr<Token> TokenView::toToken() const {
+    TokenValue converted;
+    if (auto text = std::get_if<std::string_view>(&value)) {
+        converted = std::string(*text);
+    } else if (auto integer = std::get_if<int64_t>(&value)) {
+        converted = *integer;
+    } else if (auto real = std::get_if<double>(&value)) {
+        converted = *real;
+    }
+    return std::make_shared<Token>(type, std::string(lexeme), location, converted);
+}
+
 const char* getTokenTypeName(TokenType type) {
     auto it = tokenTypeNames.find(type);
     if (it != tokenTypeNames.end()) {
@@ -2,8 +2,10 @@
 #define CHTL_TOKEN_H
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <variant>
+#include <cstdint>
 
 namespace CHTL {
 
@@ -126,6 +128,9 @@ public:
     // 获取Token位置
     const TokenLocation& getLocation() const { return location_; }
     
+    // 增量解析在编辑点之后平移位置
+    void setLocation(const TokenLocation& location) { location_ = location; }
+    
     // 获取Token值
     const TokenValue& getValue() const { return value_; }
     
@@ -175,6 +180,39 @@ private:
     TokenValue value_;
 };
 
+// 零拷贝Token值类型（字符串值为源码或Token arena中的切片）
+using TokenViewValue = std::variant<
+    std::monostate,
+    std::string_view,
+    int64_t,
+    double
+>;
+
+// 零拷贝Token
+// 普通值类型，存放在每次编译独立的TokenArena中；lexeme指向词法分析器
+// 所借用的源码缓冲区（或arena中保存的转义后文本），不持有任何堆内存。
+struct TokenView {
+    TokenType type = TokenType::UNKNOWN;
+    std::string_view lexeme;
+    TokenLocation location;
+    TokenViewValue value;
+    
+    TokenType getType() const { return type; }
+    std::string_view getLexeme() const { return lexeme; }
+    const TokenLocation& getLocation() const { return location; }
+    
+    bool isKeyword() const {
+        return type >= TokenType::KEYWORD_TEXT && type <= TokenType::KEYWORD_HTML5;
+    }
+    
+    bool isTypeIdentifier() const {
+        return type >= TokenType::TYPE_STYLE && type <= TokenType::TYPE_CUSTOM_ORIGIN;
+    }
+    
+    // 转换为传统的共享Token（会复制词素）
+    std::shared_ptr<Token> toToken() const;
+};
+
 // Token类型名称映射
 const char* getTokenTypeName(TokenType type);
 
@@ -0,0 +1,53 @@
+#include "TokenArena.h"
+#include <algorithm>
+
+namespace CHTL {
+
+TokenArena::TokenArena(size_t tokensPerBlock)
+    : tokensPerBlock_(tokensPerBlock == 0 ? 1 : tokensPerBlock) {
+}
+
+TokenView* TokenArena::allocate(const TokenView& token) {
+    size_t slot = count_ % tokensPerBlock_;
+    if (slot == 0 && count_ / tokensPerBlock_ == blocks_.size()) {
+        blocks_.push_back(std::make_unique<TokenView[]>(tokensPerBlock_));
+    }
+
+    TokenView* result = &blocks_[count_ / tokensPerBlock_][slot];
+    *result = token;
+    ++count_;
+    return result;
+}
+
+std::string_view TokenArena::storeText(std::string_view text) {
+    if (textBlocks_.empty() ||
+        textBlocks_.back()->capacity() - textBlocks_.back()->size() < text.size()) {
+        auto block = std::make_unique<std::string>();
+        block->reserve(std::max(TEXT_BLOCK_SIZE, text.size()));
+        textBlocks_.push_back(std::move(block));
+    }
+
+    std::string& block = *textBlocks_.back();
+    size_t offset = block.size();
+    block.append(text.data(), text.size());
+    return std::string_view(block.data() + offset, text.size());
+}
+
+size_t TokenArena::getMemoryUsage() const {
+    size_t bytes = blocks_.size() * tokensPerBlock_ * sizeof(TokenView);
+    for (const auto& block : textBlocks_) {
+        bytes += block->capacity();
+    }
+    return bytes;
+}
+
+void TokenArena::clear() {
+    // 保留第一个块以便复用
+    if (blocks_.size() > 1) {
+        blocks_.resize(1);
+    }
+    textBlocks_.clear();
+    count_ = 0;
+}
+
+} // namespace CHTL
@@ -0,0 +1,57 @@
+#ifndef CHTL_TOKEN_ARENA_H
+#define CHTL_TOKEN_ARENA_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Token.h"
+
+namespace CHTL {
+
+// Token arena（每次编译一个）
+// 以固定大小的块分配TokenView，块一旦分配地址不变，返回的指针在arena
+// 生命周期内始终有效；整次编译结束时一次性释放。
+// 仅在词素无法直接引用源码时（如带转义的字符串）才在arena内保存文本。
+class TokenArena {
+public:
+    explicit TokenArena(size_t tokensPerBlock = 4096);
+    ~TokenArena() = default;
+
+    // 分配一个Token
+    TokenView* allocate(const TokenView& token);
+
+    // 保存无法直接引用源码的文本，返回指向arena内部的视图
+    std::string_view storeText(std::string_view text);
+
+    // 已分配的Token数量
+    size_t size() const { return count_; }
+
+    // 第index个已分配的Token（按分配顺序）
+    const TokenView& operator[](size_t index) const {
+        return blocks_[index / tokensPerBlock_][index % tokensPerBlock_];
+    }
+
+    // 占用的字节数（用于统计）
+    size_t getMemoryUsage() const;
+
+    // 释放所有Token（之前返回的指针和视图全部失效）
+    void clear();
+
+    // 禁止拷贝
+    TokenArena(const TokenArena&) = delete;
+    TokenArena& operator=(const TokenArena&) = delete;
+
+private:
+    size_t tokensPerBlock_;
+    size_t count_ = 0;
+    std::vector<std::unique_ptr<TokenView[]>> blocks_;
+
+    // 文本块：每块预留容量后只追加不重新分配，保证视图稳定
+    std::vector<std::unique_ptr<std::string>> textBlocks_;
+    static constexpr size_t TEXT_BLOCK_SIZE = 16 * 1024;
+};
+
+} // namespace CHTL
+
+#endif // CHTL_TOKEN_ARENA_H
@@ -1,6 +1,9 @@
 #include "ImportResolver.h"
+#include "ModuleIndex.h"
 #include <filesystem>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
 #include <queue>
 
 namespace fs = std::filesystem;
@@ -21,16 +24,16 @@ std::optional<ResolvedImport> ImportResolver::resolve(ImportNode* importNode) {
     const std::string& fromPath = importNode->getFromPath();
     
     // 根据导入类型确定期望的文件类型
-    FileType expectedType = FileType::UNKNOWN;
+    ImportFileType expectedType = ImportFileType::UNKNOWN;
     switch (importNode->getImportType()) {
         case ImportType::HTML:
-            expectedType = FileType::HTML;
+            expectedType = ImportFileType::HTML;
             break;
         case ImportType::STYLE:
-            expectedType = FileType::CSS;
+            expectedType = ImportFileType::CSS;
             break;
         case ImportType::JAVASCRIPT:
-            expectedType = FileType::JAVASCRIPT;
+            expectedType = ImportFileType::JAVASCRIPT;
             break;
         case ImportType::CHTL:
         case ImportType::TEMPLATE_STYLE:
@@ -43,13 +46,13 @@ std::optional<ResolvedImport> ImportResolver::resolve(ImportNode* importNode) {
         case ImportType::ALL_TEMPLATE:
         case ImportType::ALL_CUSTOM:
         case ImportType::ALL_ORIGIN:
-            expectedType = FileType::CHTL;
+            expectedType = ImportFileType::CHTL;
             break;
         case ImportType::CJMOD:
-            expectedType = FileType::CJMOD;
+            expectedType = ImportFileType::CJMOD;
             break;
         case ImportType::CONFIG:
-            expectedType = FileType::CHTL;
+            expectedType = ImportFileType::CHTL;
             break;
     }
     
@@ -63,7 +66,7 @@ std::optional<ResolvedImport> ImportResolver::resolve(ImportNode* importNode) {
     result.fileType = detectFileType(result.filePath);
     
     // 设置命名空间
-    if (config_.enableDefaultNamespace && result.fileType == FileType::CHTL) {
+    if (config_.enableDefaultNamespace && result.fileType == ImportFileType::CHTL) {
         result.namespaceName = getDefaultNamespace(result.filePath);
     }
     
@@ -75,7 +78,7 @@ std::optional<ResolvedImport> ImportResolver::resolve(ImportNode* importNode) {
     return result;
 }
 
-std::optional<std::string> ImportResolver::resolvePath(const std::string& path, FileType expectedType) {
+std::optional<std::string> ImportResolver::resolvePath(const std::string& path, ImportFileType expectedType) {
     // 处理官方模块前缀
     if (hasOfficialModulePrefix(path)) {
         std::string moduleName = removeOfficialModulePrefix(path);
@@ -90,7 +93,7 @@ std::optional<std::string> ImportResolver::resolvePath(const std::string& path,
     // 检查是否包含路径分隔符（相对路径）
     if (path.find('/') != std::string::npos || path.find('\\') != std::string::npos) {
         std::string fullPath = joinPath(config_.currentDir, path);
-        if (fs::exists(fullPath)) {
+        if (ModuleIndex::getInstance().exists(fullPath)) {
             return normalizePath(fullPath);
         }
         return std::nullopt;
@@ -114,17 +117,18 @@ std::optional<std::string> ImportResolver::resolvePath(const std::string& path,
     return std::nullopt;
 }
 
-std::optional<std::string> ImportResolver::resolveInOfficialModules(const std::string& name, FileType type) {
-    if (config_.officialModuleDir.empty() || !fs::exists(config_.officialModuleDir)) {
+std::optional<std::string> ImportResolver::resolveInOfficialModules(const std::string& name, ImportFileType type) {
+    if (config_.officialModuleDir.empty() ||
+        !ModuleIndex::getInstance().exists(config_.officialModuleDir)) {
         return std::nullopt;
     }
     
     // 检查是否有模块结构（CMOD/CJMOD子目录）
     if (hasModuleStructure(config_.officialModuleDir)) {
-        if (type == FileType::CJMOD) {
+        if (type == ImportFileType::CJMOD) {
             std::string cjmodDir = getCJMODSubdir(config_.officialModuleDir);
             return searchFile(cjmodDir, name, type);
-        } else if (type == FileType::CHTL || type == FileType::CMOD) {
+        } else if (type == ImportFileType::CHTL || type == ImportFileType::CMOD) {
             std::string cmodDir = getCMODSubdir(config_.officialModuleDir);
             return searchFile(cmodDir, name, type);
         }
@@ -134,18 +138,18 @@ std::optional<std::string> ImportResolver::resolveInOfficialModules(const std::s
     return searchFile(config_.officialModuleDir, name, type);
 }
 
-std::optional<std::string> ImportResolver::resolveInCurrentModules(const std::string& name, FileType type) {
+std::optional<std::string> ImportResolver::resolveInCurrentModules(const std::string& name, ImportFileType type) {
     std::string moduleDir = joinPath(config_.currentDir, "module");
-    if (!fs::exists(moduleDir)) {
+    if (!ModuleIndex::getInstance().exists(moduleDir)) {
         return std::nullopt;
     }
     
     // 检查是否有模块结构
     if (hasModuleStructure(moduleDir)) {
-        if (type == FileType::CJMOD) {
+        if (type == ImportFileType::CJMOD) {
             std::string cjmodDir = getCJMODSubdir(moduleDir);
             return searchFile(cjmodDir, name, type);
-        } else if (type == FileType::CHTL || type == FileType::CMOD) {
+        } else if (type == ImportFileType::CHTL || type == ImportFileType::CMOD) {
             std::string cmodDir = getCMODSubdir(moduleDir);
             return searchFile(cmodDir, name, type);
         }
@@ -154,13 +158,21 @@ std::optional<std::string> ImportResolver::resolveInCurrentModules(const std::st
     return searchFile(moduleDir, name, type);
 }
 
-std::optional<std::string> ImportResolver::resolveInCurrentDir(const std::string& name, FileType type) {
+std::optional<std::string> ImportResolver::resolveInCurrentDir(const std::string& name, ImportFileType type) {
     return searchFile(config_.currentDir, name, type);
 }
 
+std::optional<std::string> ImportResolver::resolveAbsolutePath(const std::string& path) {
+    if (ModuleIndex::getInstance().exists(path)) {
+        return normalizePath(path);
+    }
+    return std::nullopt;
+}
+
 std::optional<std::string> ImportResolver::searchFile(const std::string& dir, const std::string& name, 
-                                                     FileType type, bool checkSubdirs) {
-    if (!fs::exists(dir) || !fs::is_directory(dir)) {
+                                                     ImportFileType type, bool checkSubdirs) {
+    auto& index = ModuleIndex::getInstance();
+    if (!index.isDirectory(dir)) {
         return std::nullopt;
     }
     
@@ -170,7 +182,7 @@ std::optional<std::string> ImportResolver::searchFile(const std::string& dir, co
     // 如果名称已包含扩展名
     if (name.find('.') != std::string::npos) {
         std::string fullPath = joinPath(dir, name);
-        if (fs::exists(fullPath) && matchesFileType(fullPath, type)) {
+        if (index.exists(fullPath) && matchesFileType(fullPath, type)) {
             return normalizePath(fullPath);
         }
     } else {
@@ -178,7 +190,7 @@ std::optional<std::string> ImportResolver::searchFile(const std::string& dir, co
         for (const auto& ext : extensions) {
             std::string filename = name + ext;
             std::string fullPath = joinPath(dir, filename);
-            if (fs::exists(fullPath)) {
+            if (index.exists(fullPath)) {
                 return normalizePath(fullPath);
             }
         }
@@ -186,12 +198,10 @@ std::optional<std::string> ImportResolver::searchFile(const std::string& dir, co
     
     // 如果需要检查子目录（用于子模块）
     if (checkSubdirs) {
-        for (const auto& entry : fs::directory_iterator(dir)) {
-            if (entry.is_directory()) {
-                auto result = searchFile(entry.path().string(), name, type, false);
-                if (result.has_value()) {
-                    return result;
-                }
+        for (const auto& subdir : index.listDirectories(dir)) {
+            auto result = searchFile(subdir, name, type, false);
+            if (result.has_value()) {
+                return result;
             }
         }
     }
@@ -199,33 +209,33 @@ std::optional<std::string> ImportResolver::searchFile(const std::string& dir, co
     return std::nullopt;
 }
 
-FileType ImportResolver::detectFileType(const std::string& path) {
+ImportFileType ImportResolver::detectFileType(const std::string& path) {
     std::string ext = fs::path(path).extension().string();
     std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
     
-    if (ext == ".html" || ext == ".htm") return FileType::HTML;
-    if (ext == ".css") return FileType::CSS;
-    if (ext == ".js" || ext == ".cjjs") return FileType::JAVASCRIPT;
-    if (ext == ".chtl") return FileType::CHTL;
-    if (ext == ".cmod") return FileType::CMOD;
-    if (ext == ".cjmod") return FileType::CJMOD;
+    if (ext == ".html" || ext == ".htm") return ImportFileType::HTML;
+    if (ext == ".css") return ImportFileType::CSS;
+    if (ext == ".js" || ext == ".cjjs") return ImportFileType::JAVASCRIPT;
+    if (ext == ".chtl") return ImportFileType::CHTL;
+    if (ext == ".cmod") return ImportFileType::CMOD;
+    if (ext == ".cjmod") return ImportFileType::CJMOD;
     
-    return FileType::UNKNOWN;
+    return ImportFileType::UNKNOWN;
 }
 
-std::vector<std::string> ImportResolver::getFileExtensions(FileType type) {
+std::vector<std::string> ImportResolver::getFileExtensions(ImportFileType type) {
     switch (type) {
-        case FileType::HTML:
+        case ImportFileType::HTML:
             return {".html", ".htm"};
-        case FileType::CSS:
+        case ImportFileType::CSS:
             return {".css"};
-        case FileType::JAVASCRIPT:
+        case ImportFileType::JAVASCRIPT:
             return {".js", ".cjjs"};
-        case FileType::CHTL:
+        case ImportFileType::CHTL:
             return {".cmod", ".chtl"};  // CMOD优先
-        case FileType::CMOD:
+        case ImportFileType::CMOD:
             return {".cmod"};
-        case FileType::CJMOD:
+        case ImportFileType::CJMOD:
             return {".cjmod"};
         default:
             return {};
@@ -277,6 +287,142 @@ std::string ImportResolver::getDefaultNamespace(const std::string& filePath) {
     return getBasename(filePath);
 }
 
+void ImportResolver::scanImports(const std::string& filePath) {
+    std::unordered_set<std::string> visited;
+    scanImportsRecursive(graphKey(filePath), visited);
+}
+
+void ImportResolver::scanImportsRecursive(const std::string& filePath,
+                                          std::unordered_set<std::string>& visited) {
+    if (!visited.insert(filePath).second) {
+        return;
+    }
+    
+    // 文件内容可能已变化，先移除旧的出边
+    importGraph_.erase(filePath);
+    
+    std::ifstream file(filePath);
+    if (!file) {
+        return;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string content = buffer.str();
+    
+    // 导入路径相对于导入者所在目录解析
+    std::string savedDir = config_.currentDir;
+    config_.currentDir = getDirectory(filePath);
+    
+    std::vector<std::string> imported;
+    const std::string marker = "[Import]";
+    for (size_t pos = content.find(marker); pos != std::string::npos;
+         pos = content.find(marker, pos + marker.size())) {
+        // 跳过行注释中的导入
+        size_t lineStart = content.rfind('\n', pos);
+        lineStart = (lineStart == std::string::npos) ? 0 : lineStart + 1;
+        if (content.substr(lineStart, pos - lineStart).find("//") != std::string::npos) {
+            continue;
+        }
+        
+        // [Import] <类型> from <路径> [as <名称>];
+        size_t end = content.find_first_of(";\n", pos);
+        std::string statement = content.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        std::istringstream words(statement);
+        std::string word;
+        std::string typeSpec;
+        std::string importPath;
+        while (words >> word) {
+            if (word == "from") {
+                words >> importPath;
+                break;
+            }
+            typeSpec += word;
+        }
+        if (importPath.size() >= 2 && (importPath.front() == '"' || importPath.front() == '\'')) {
+            importPath = importPath.substr(1, importPath.size() - 2);
+        }
+        if (importPath.empty()) {
+            continue;
+        }
+        
+        ImportFileType expectedType = ImportFileType::CHTL;
+        if (typeSpec.find("@Html") != std::string::npos) {
+            expectedType = ImportFileType::HTML;
+        } else if (typeSpec.find("@JavaScript") != std::string::npos) {
+            expectedType = ImportFileType::JAVASCRIPT;
+        } else if (typeSpec.find("@CJmod") != std::string::npos) {
+            expectedType = ImportFileType::CJMOD;
+        } else if (typeSpec == "[Import]@Style") {
+            expectedType = ImportFileType::CSS;
+        }
+        
+        if (importPath.find('*') != std::string::npos) {
+            std::string pattern = fs::path(importPath).is_absolute()
+                ? importPath : joinPath(config_.currentDir, importPath);
+            for (const auto& match : resolveWildcard(pattern, expectedType)) {
+                imported.push_back(graphKey(match));
+            }
+        } else if (auto resolved = resolvePath(importPath, expectedType)) {
+            imported.push_back(graphKey(resolved.value()));
+        }
+    }
+    
+    config_.currentDir = savedDir;
+    
+    for (const auto& target : imported) {
+        addImportedFile(filePath, target);
+        if (detectFileType(target) == ImportFileType::CHTL) {
+            scanImportsRecursive(target, visited);
+        }
+    }
+}
+
+std::vector<std::string> ImportResolver::getImportedFiles(const std::string& filePath) const {
+    auto it = importGraph_.find(graphKey(filePath));
+    if (it == importGraph_.end()) {
+        return {};
+    }
+    return std::vector<std::string>(it->second.begin(), it->second.end());
+}
+
+std::unordered_set<std::string> ImportResolver::getDependents(const std::vector<std::string>& changedFiles) const {
+    // 反向导入图：被导入者 -> 导入者
+    std::unordered_map<std::string, std::vector<std::string>> importers;
+    for (const auto& entry : importGraph_) {
+        for (const auto& target : entry.second) {
+            importers[target].push_back(entry.first);
+        }
+    }
+    
+    std::unordered_set<std::string> result;
+    std::queue<std::string> toVisit;
+    for (const auto& file : changedFiles) {
+        toVisit.push(graphKey(file));
+    }
+    
+    while (!toVisit.empty()) {
+        std::string current = toVisit.front();
+        toVisit.pop();
+        
+        if (!result.insert(current).second) {
+            continue;
+        }
+        
+        auto it = importers.find(current);
+        if (it != importers.end()) {
+            for (const auto& importer : it->second) {
+                toVisit.push(importer);
+            }
+        }
+    }
+    
+    return result;
+}
+
+std::string ImportResolver::graphKey(const std::string& path) {
+    return fs::absolute(path).lexically_normal().string();
+}
+
 std::string ImportResolver::normalizePath(const std::string& path) {
     return fs::path(path).lexically_normal().string();
 }
@@ -305,7 +451,7 @@ bool ImportResolver::hasModuleStructure(const std::string& dir) {
     };
     
     for (const auto& subdir : possibleDirs) {
-        if (fs::exists(joinPath(dir, subdir))) {
+        if (ModuleIndex::getInstance().exists(joinPath(dir, subdir))) {
             return true;
         }
     }
@@ -318,7 +464,7 @@ std::string ImportResolver::getCMODSubdir(const std::string& dir) {
     
     for (const auto& subdir : possibleDirs) {
         std::string path = joinPath(dir, subdir);
-        if (fs::exists(path)) {
+        if (ModuleIndex::getInstance().exists(path)) {
             return path;
         }
     }
@@ -331,7 +477,7 @@ std::string ImportResolver::getCJMODSubdir(const std::string& dir) {
     
     for (const auto& subdir : possibleDirs) {
         std::string path = joinPath(dir, subdir);
-        if (fs::exists(path)) {
+        if (ModuleIndex::getInstance().exists(path)) {
             return path;
         }
     }
@@ -350,7 +496,7 @@ std::string ImportResolver::removeOfficialModulePrefix(const std::string& path)
     return path;
 }
 
-std::vector<std::string> ImportResolver::resolveWildcard(const std::string& pattern, FileType type) {
+std::vector<std::string> ImportResolver::resolveWildcard(const std::string& pattern, ImportFileType type) {
     std::vector<std::string> results;
     
     // 解析通配符模式
@@ -369,36 +515,37 @@ std::vector<std::string> ImportResolver::resolveWildcard(const std::string& patt
     std::string filePattern = getFilename(pattern);
     
     // 在目录中查找匹配的文件
-    if (fs::exists(dir) && fs::is_directory(dir)) {
-        for (const auto& entry : fs::directory_iterator(dir)) {
-            if (entry.is_regular_file()) {
-                std::string filename = entry.path().filename().string();
-                // 简单的通配符匹配（只支持*）
-                if (filePattern == "*" || filePattern == "*.*") {
-                    if (matchesFileType(entry.path().string(), type)) {
-                        results.push_back(normalizePath(entry.path().string()));
-                    }
-                } else if (filePattern.find("*.") == 0) {
-                    // 匹配特定扩展名
-                    std::string ext = filePattern.substr(1);
-                    if (filename.size() > ext.size() && 
-                        filename.substr(filename.size() - ext.size()) == ext) {
-                        results.push_back(normalizePath(entry.path().string()));
-                    }
-                }
+    // 模式为 前缀*后缀：前缀部分直接在索引的前缀树中定位，不再遍历整个目录
+    size_t starPos = filePattern.find('*');
+    if (starPos == std::string::npos) {
+        // 通配符只出现在目录部分（如 dir*/Box.chtl），不支持目录通配
+        return results;
+    }
+    std::string prefix = filePattern.substr(0, starPos);
+    std::string suffix = filePattern.substr(starPos + 1);
+    bool matchByType = suffix.empty() || suffix == ".*";
+    
+    for (const auto& file : ModuleIndex::getInstance().listFiles(dir, prefix)) {
+        std::string filename = getFilename(file);
+        if (matchByType) {
+            if (matchesFileType(file, type)) {
+                results.push_back(normalizePath(file));
             }
+        } else if (filename.size() > prefix.size() + suffix.size() &&
+                   filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            results.push_back(normalizePath(file));
         }
     }
     
     return results;
 }
 
-bool ImportResolver::matchesFileType(const std::string& path, FileType type) {
-    FileType actualType = detectFileType(path);
+bool ImportResolver::matchesFileType(const std::string& path, ImportFileType type) {
+    ImportFileType actualType = detectFileType(path);
     
     // 特殊处理：CHTL类型可以匹配CHTL和CMOD文件
-    if (type == FileType::CHTL) {
-        return actualType == FileType::CHTL || actualType == FileType::CMOD;
+    if (type == ImportFileType::CHTL) {
+        return actualType == ImportFileType::CHTL || actualType == ImportFileType::CMOD;
     }
     
     return actualType == type;
@@ -5,6 +5,7 @@
 #include <vector>
 #include <optional>
 #include <unordered_set>
+#include <unordered_map>
 #include <memory>
 #include "../CHTLNode/ImportNode.h"
 
@@ -18,8 +19,8 @@ struct ImportResolverConfig {
     bool checkCircularDependency = true; // 检查循环依赖
 };
 
-// 文件类型
-enum class FileType {
+// 导入文件类型（与CHTLFileSystem.h中的FileType区分）
+enum class ImportFileType {
     HTML,
     CSS,
     JAVASCRIPT,
@@ -32,7 +33,7 @@ enum class FileType {
 // 解析结果
 struct ResolvedImport {
     std::string filePath;           // 解析后的文件路径
-    FileType fileType;             // 文件类型
+    ImportFileType fileType;             // 文件类型
     ImportType importType;         // 导入类型
     std::string namespaceName;     // 命名空间名称（如果适用）
     bool isOfficialModule = false; // 是否为官方模块
@@ -48,7 +49,7 @@ public:
     std::optional<ResolvedImport> resolve(ImportNode* importNode);
     
     // 解析路径
-    std::optional<std::string> resolvePath(const std::string& path, FileType expectedType);
+    std::optional<std::string> resolvePath(const std::string& path, ImportFileType expectedType);
     
     // 检查循环依赖
     bool hasCircularDependency(const std::string& fromFile, const std::string& toFile);
@@ -58,27 +59,41 @@ public:
     
     // 获取文件的默认命名空间
     std::string getDefaultNamespace(const std::string& filePath);
+    
+    // 扫描文件及其（传递）导入的文件中的[Import]语句，重建导入图中对应的边
+    // 文件内容变化后再次调用即可刷新；图中的路径均为规范化的绝对路径
+    void scanImports(const std::string& filePath);
+    
+    // 获取文件直接导入的文件
+    std::vector<std::string> getImportedFiles(const std::string& filePath) const;
+    
+    // 获取传递地导入了changedFiles中任一文件的所有文件（包含changedFiles自身）
+    std::unordered_set<std::string> getDependents(const std::vector<std::string>& changedFiles) const;
 
 private:
     ImportResolverConfig config_;
     std::unordered_map<std::string, std::unordered_set<std::string>> importGraph_;
     
     // 路径解析辅助方法
-    std::optional<std::string> resolveInOfficialModules(const std::string& name, FileType type);
-    std::optional<std::string> resolveInCurrentModules(const std::string& name, FileType type);
-    std::optional<std::string> resolveInCurrentDir(const std::string& name, FileType type);
+    std::optional<std::string> resolveInOfficialModules(const std::string& name, ImportFileType type);
+    std::optional<std::string> resolveInCurrentModules(const std::string& name, ImportFileType type);
+    std::optional<std::string> resolveInCurrentDir(const std::string& name, ImportFileType type);
     std::optional<std::string> resolveAbsolutePath(const std::string& path);
     
     // 搜索文件
     std::optional<std::string> searchFile(const std::string& dir, const std::string& name, 
-                                          FileType type, bool checkSubdirs = false);
+                                          ImportFileType type, bool checkSubdirs = false);
     
     // 文件类型相关
-    FileType detectFileType(const std::string& path);
-    std::vector<std::string> getFileExtensions(FileType type);
-    bool matchesFileType(const std::string& path, FileType type);
+    ImportFileType detectFileType(const std::string& path);
+    std::vector<std::string> getFileExtensions(ImportFileType type);
+    bool matchesFileType(const std::string& path, ImportFileType type);
+    
+    // 导入图扫描
+    void scanImportsRecursive(const std::string& filePath, std::unordered_set<std::string>& visited);
     
     // 路径处理
+    static std::string graphKey(const std::string& path);
     std::string normalizePath(const std::string& path);
     std::string joinPath(const std::string& dir, const std::string& file);
     std::string getDirectory(const std::string& path);
@@ -91,8 +106,8 @@ private:
     std::string getCJMODSubdir(const std::string& dir);
     
     // 通配符和批量导入
-    std::vector<std::string> resolveWildcard(const std::string& pattern, FileType type);
-    std::vector<std::string> findFilesInDir(const std::string& dir, FileType type);
+    std::vector<std::string> resolveWildcard(const std::string& pattern, ImportFileType type);
+    std::vector<std::string> findFilesInDir(const std::string& dir, ImportFileType type);
     
     // 官方模块前缀处理
     bool hasOfficialModulePrefix(const std::string& path);
@@ -0,0 +1,285 @@
+#include "ModuleIndex.h"
+#include <filesystem>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace fs = std::filesystem;
+
+namespace CHTL {
+
+namespace {
+
+// 文件名前缀树
+// 子节点按字符排序，前缀枚举的结果即按名称排序
+class NameTrie {
+public:
+    NameTrie() : nodes_(1) {}
+
+    void insert(std::string_view name, int value) {
+        uint32_t node = 0;
+        for (char c : name) {
+            node = addChild(node, c);
+        }
+        nodes_[node].value = value;
+    }
+
+    int find(std::string_view name) const {
+        uint32_t node = 0;
+        for (char c : name) {
+            node = findChild(node, c);
+            if (node == NONE) {
+                return -1;
+            }
+        }
+        return nodes_[node].value;
+    }
+
+    void collect(std::string_view prefix, std::vector<int>& out) const {
+        uint32_t node = 0;
+        for (char c : prefix) {
+            node = findChild(node, c);
+            if (node == NONE) {
+                return;
+            }
+        }
+
+        std::vector<uint32_t> stack = {node};
+        while (!stack.empty()) {
+            uint32_t current = stack.back();
+            stack.pop_back();
+            if (nodes_[current].value >= 0) {
+                out.push_back(nodes_[current].value);
+            }
+            const auto& children = nodes_[current].children;
+            for (auto it = children.rbegin(); it != children.rend(); ++it) {
+                stack.push_back(it->second);
+            }
+        }
+    }
+
+private:
+    static constexpr uint32_t NONE = static_cast<uint32_t>(-1);
+
+    struct Node {
+        std::vector<std::pair<char, uint32_t>> children;
+        int value = -1;
+    };
+
+    uint32_t findChild(uint32_t node, char c) const {
+        for (const auto& [key, index] : nodes_[node].children) {
+            if (key == c) {
+                return index;
+            }
+        }
+        return NONE;
+    }
+
+    uint32_t addChild(uint32_t node, char c) {
+        uint32_t existing = findChild(node, c);
+        if (existing != NONE) {
+            return existing;
+        }
+        uint32_t index = static_cast<uint32_t>(nodes_.size());
+        nodes_.emplace_back();
+        auto& children = nodes_[node].children;
+        auto position = children.begin();
+        while (position != children.end() && position->first < c) {
+            ++position;
+        }
+        children.insert(position, {c, index});
+        return index;
+    }
+
+    std::vector<Node> nodes_;
+};
+
+// 索引的键：绝对、规范化、不带末尾分隔符的路径
+fs::path indexPath(const std::string& path) {
+    std::error_code ec;
+    fs::path result = fs::absolute(path, ec).lexically_normal();
+    if (result.has_relative_path() && !result.has_filename()) {
+        result = result.parent_path();
+    }
+    return result;
+}
+
+} // namespace
+
+struct ModuleIndex::DirectoryIndex {
+    struct Entry {
+        std::string name;
+        bool isDirectory;
+    };
+
+    bool exists = false;
+    fs::file_time_type mtime;
+    uint64_t generation = 0;
+    std::vector<Entry> entries;
+    NameTrie names;
+};
+
+ModuleIndex::ModuleIndex() = default;
+ModuleIndex::~ModuleIndex() = default;
+
+void ModuleIndex::beginSession() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++generation_;
+}
+
+ModuleIndex::DirectoryIndex& ModuleIndex::getDirectory(const std::string& dir) {
+    auto& slot = directories_[dir];
+    if (!slot) {
+        slot = std::make_unique<DirectoryIndex>();
+        stats_.directories = directories_.size();
+        rebuild(*slot, dir);
+        ++stats_.misses;
+        return *slot;
+    }
+
+    DirectoryIndex& index = *slot;
+    if (index.generation != generation_) {
+        // 新会话中第一次访问：只检查一次mtime
+        ++stats_.revalidations;
+        std::error_code ec;
+        auto mtime = fs::last_write_time(dir, ec);
+        bool exists = !ec && fs::is_directory(dir, ec);
+        if (exists != index.exists || (exists && mtime != index.mtime)) {
+            ++stats_.invalidations;
+            ++stats_.misses;
+            rebuild(index, dir);
+            return index;
+        }
+        index.generation = generation_;
+    }
+
+    ++stats_.hits;
+    return index;
+}
+
+void ModuleIndex::rebuild(DirectoryIndex& index, const std::string& dir) {
+    index.entries.clear();
+    index.names = NameTrie();
+    index.generation = generation_;
+
+    std::error_code ec;
+    index.mtime = fs::last_write_time(dir, ec);
+    index.exists = !ec && fs::is_directory(dir, ec);
+    if (!index.exists) {
+        return;
+    }
+
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code typeError;
+        bool isDirectory = it->is_directory(typeError);
+        std::string name = it->path().filename().string();
+        index.names.insert(name, static_cast<int>(index.entries.size()));
+        index.entries.push_back({std::move(name), isDirectory});
+    }
+}
+
+int ModuleIndex::findEntry(const std::string& path, DirectoryIndex*& parent) {
+    ++stats_.lookups;
+    fs::path key = indexPath(path);
+    if (!key.has_relative_path()) {
+        // 根目录
+        parent = nullptr;
+        return -1;
+    }
+
+    parent = &getDirectory(key.parent_path().string());
+    return parent->names.find(key.filename().string());
+}
+
+bool ModuleIndex::exists(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DirectoryIndex* parent = nullptr;
+    int entry = findEntry(path, parent);
+    if (!parent) {
+        std::error_code ec;
+        return fs::exists(path, ec);
+    }
+    return entry >= 0;
+}
+
+bool ModuleIndex::isDirectory(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DirectoryIndex* parent = nullptr;
+    int entry = findEntry(path, parent);
+    if (!parent) {
+        std::error_code ec;
+        return fs::is_directory(path, ec);
+    }
+    return entry >= 0 && parent->entries[entry].isDirectory;
+}
+
+bool ModuleIndex::isFile(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    DirectoryIndex* parent = nullptr;
+    int entry = findEntry(path, parent);
+    return parent && entry >= 0 && !parent->entries[entry].isDirectory;
+}
+
+std::vector<std::string> ModuleIndex::list(const std::string& dir, const std::string& prefix, bool directories) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++stats_.lookups;
+
+    fs::path key = indexPath(dir);
+    DirectoryIndex& index = getDirectory(key.string());
+
+    std::vector<int> matches;
+    index.names.collect(prefix, matches);
+
+    std::vector<std::string> result;
+    for (int entry : matches) {
+        const auto& item = index.entries[entry];
+        if (item.isDirectory == directories) {
+            result.push_back((fs::path(dir) / item.name).lexically_normal().string());
+        }
+    }
+    return result;
+}
+
+std::vector<std::string> ModuleIndex::listFiles(const std::string& dir, const std::string& prefix) {
+    return list(dir, prefix, false);
+}
+
+std::vector<std::string> ModuleIndex::listDirectories(const std::string& dir) {
+    return list(dir, "", true);
+}
+
+ModuleIndexStats ModuleIndex::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+std::string ModuleIndex::getStatsReport() const {
+    ModuleIndexStats stats = getStats();
+    double hitRate = stats.hits + stats.misses > 0
+        ? 100.0 * stats.hits / (stats.hits + stats.misses) : 0.0;
+
+    std::ostringstream ss;
+    ss << "\n=== Module Resolution Index ===\n";
+    ss << "Lookups:        " << stats.lookups << "\n";
+    ss << "Hits:           " << stats.hits << "\n";
+    ss << "Misses:         " << stats.misses << "\n";
+    ss << "Hit rate:       " << static_cast<int>(hitRate) << "%\n";
+    ss << "Revalidations:  " << stats.revalidations << "\n";
+    ss << "Invalidations:  " << stats.invalidations << "\n";
+    ss << "Directories:    " << stats.directories << "\n";
+    return ss.str();
+}
+
+void ModuleIndex::resetStats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = ModuleIndexStats();
+    stats_.directories = directories_.size();
+}
+
+void ModuleIndex::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    directories_.clear();
+    stats_.directories = 0;
+}
+
+} // namespace CHTL
@@ -0,0 +1,84 @@
+#ifndef CHTL_MODULE_INDEX_H
+#define CHTL_MODULE_INDEX_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+#include "../../Util/ScopedInstance.h"
+
+namespace CHTL {
+
+// 模块解析索引统计
+struct ModuleIndexStats {
+    size_t lookups = 0;          // 查询次数
+    size_t hits = 0;             // 由内存中的目录索引直接回答
+    size_t misses = 0;           // 需要扫描目录（首次访问或已失效）
+    size_t invalidations = 0;    // 因目录mtime变化而重建
+    size_t revalidations = 0;    // 新会话中检查目录mtime的次数
+    size_t directories = 0;      // 已建立索引的目录数
+};
+
+// 模块解析索引
+// ImportResolver和CMODLoader查找模块时不再逐个调用fs::exists/directory_iterator，
+// 而是按目录一次性读入条目，文件名存入前缀树，之后的存在性判断、分类结构
+// （CMOD/CJMOD子目录）检测和通配符匹配都在内存中完成。
+// 索引在整个构建会话内共享；beginSession()之后，各目录在下一次被访问时
+// 检查一次mtime，变化了才重新扫描（目录中增删文件会更新其mtime）。
+class ModuleIndex {
+public:
+    static ModuleIndex& getInstance() {
+        if (auto* scoped = ScopedInstance<ModuleIndex>::current()) {
+            return *scoped;
+        }
+        static ModuleIndex instance;
+        return instance;
+    }
+
+    ~ModuleIndex();
+
+    // 开始新的构建会话
+    void beginSession();
+
+    // 路径查询（相对路径基于当前工作目录）
+    bool exists(const std::string& path);
+    bool isDirectory(const std::string& path);
+    bool isFile(const std::string& path);
+
+    // 目录中以prefix开头的普通文件/子目录，返回完整路径，按名称排序
+    std::vector<std::string> listFiles(const std::string& dir, const std::string& prefix = "");
+    std::vector<std::string> listDirectories(const std::string& dir);
+
+    // 统计
+    ModuleIndexStats getStats() const;
+    std::string getStatsReport() const;
+    void resetStats();
+
+    // 丢弃所有索引
+    void clear();
+
+private:
+    friend class ScopedInstance<ModuleIndex>;
+    ModuleIndex();
+    ModuleIndex(const ModuleIndex&) = delete;
+    ModuleIndex& operator=(const ModuleIndex&) = delete;
+
+    struct DirectoryIndex;
+
+    // 调用者需持有mutex_
+    DirectoryIndex& getDirectory(const std::string& dir);
+    void rebuild(DirectoryIndex& index, const std::string& dir);
+    int findEntry(const std::string& path, DirectoryIndex*& parent);
+    std::vector<std::string> list(const std::string& dir, const std::string& prefix, bool directories);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<DirectoryIndex>> directories_;
+    uint64_t generation_ = 1;
+    ModuleIndexStats stats_;
+};
+
+} // namespace CHTL
+
+#endif // CHTL_MODULE_INDEX_H
@@ -7,6 +7,7 @@
 #include <unordered_set>
 #include <memory>
 #include <functional>
+#include "../../Util/ScopedInstance.h"
 
 namespace CHTL {
 
@@ -133,6 +134,9 @@ private:
 class ConstraintManager {
 public:
     static ConstraintManager& getInstance() {
+        if (auto* scoped = ScopedInstance<ConstraintManager>::current()) {
+            return *scoped;
+        }
         static ConstraintManager instance;
         return instance;
     }
@@ -159,6 +163,7 @@ public:
     void loadPredefinedConstraints();
 
 private:
+    friend class ScopedInstance<ConstraintManager>;
     ConstraintManager() = default;
     ConstraintManager(const ConstraintManager&) = delete;
     ConstraintManager& operator=(const ConstraintManager&) = delete;
@@ -10,23 +10,23 @@ namespace CHTL {
 // NamespaceInfo 实现
 
 void NamespaceInfo::addSymbol(const NamespaceSymbol& symbol) {
-    symbols_[symbol.name] = symbol;
+    symbols_.assign(SymbolInterner::getInstance().intern(symbol.name), symbol);
 }
 
 bool NamespaceInfo::hasSymbol(const std::string& name) const {
-    return symbols_.find(name) != symbols_.end();
+    return symbols_.contains(SymbolInterner::getInstance().find(name));
 }
 
 std::optional<NamespaceSymbol> NamespaceInfo::getSymbol(const std::string& name) const {
-    auto it = symbols_.find(name);
-    if (it != symbols_.end()) {
-        return it->second;
+    if (const NamespaceSymbol* symbol = findSymbol(SymbolInterner::getInstance().find(name))) {
+        return *symbol;
     }
     return std::nullopt;
 }
 
 std::vector<NamespaceSymbol> NamespaceInfo::getAllSymbols() const {
     std::vector<NamespaceSymbol> result;
+    result.reserve(symbols_.size());
     for (const auto& [_, symbol] : symbols_) {
         result.push_back(symbol);
     }
@@ -64,38 +64,39 @@ void NamespaceManager::registerNamespace(const std::string& name, NamespaceType
         throw std::invalid_argument("Invalid namespace name: " + name);
     }
     
-    auto it = namespaces_.find(name);
-    if (it != namespaces_.end()) {
+    auto& interner = SymbolInterner::getInstance();
+    SymbolPath path = interner.internPath(name);
+    
+    if (auto* existing = namespaces_.find(path.full)) {
         // 命名空间已存在，需要合并
-        it->second->addMergeSource(sourceFile);
+        (*existing)->addMergeSource(sourceFile);
         mergeNamespaces(name);
     } else {
         // 创建新命名空间
         auto nsInfo = std::make_shared<NamespaceInfo>(name, type, sourceFile);
-        namespaces_[name] = nsInfo;
+        namespaces_.assign(path.full, nsInfo);
         
         // 处理嵌套命名空间
-        size_t dotPos = name.find_last_of('.');
-        if (dotPos != std::string::npos) {
-            std::string parentName = name.substr(0, dotPos);
-            std::string childName = name.substr(dotPos + 1);
-            
+        if (path.scope != INVALID_SYMBOL_ID) {
             // 确保父命名空间存在
-            if (namespaces_.find(parentName) == namespaces_.end()) {
-                registerNamespace(parentName, NamespaceType::EXPLICIT, sourceFile);
+            if (!namespaces_.contains(path.scope)) {
+                registerNamespace(std::string(interner.name(path.scope)), NamespaceType::EXPLICIT, sourceFile);
             }
             
             // 添加子命名空间关系
-            auto parent = namespaces_[parentName];
-            parent->addChildNamespace(childName);
+            auto parent = *namespaces_.find(path.scope);
+            parent->addChildNamespace(std::string(interner.name(path.leaf)));
         }
     }
 }
 
 std::shared_ptr<NamespaceInfo> NamespaceManager::getNamespace(const std::string& name) const {
-    auto it = namespaces_.find(name);
-    if (it != namespaces_.end()) {
-        return it->second;
+    return getNamespace(SymbolInterner::getInstance().find(name));
+}
+
+std::shared_ptr<NamespaceInfo> NamespaceManager::getNamespace(SymbolId name) const {
+    if (const auto* ns = namespaces_.find(name)) {
+        return *ns;
     }
     return nullptr;
 }
@@ -125,7 +126,7 @@ void NamespaceManager::mergeNamespaces(const std::string& name) {
             mergedNs->addMergeSource(source);
         }
         
-        namespaces_[name] = mergedNs;
+        namespaces_.assign(SymbolInterner::getInstance().intern(name), mergedNs);
     }
 }
 
@@ -138,21 +139,30 @@ void NamespaceManager::addSymbolToNamespace(const std::string& namespaceName,
 }
 
 std::optional<NamespaceSymbol> NamespaceManager::resolveSymbol(const std::string& symbolPath) const {
-    auto [namespacePath, symbolName] = splitSymbolPath(symbolPath);
-    
-    if (namespacePath.empty()) {
+    // 只查找不登记：未登记过的名字不可能对应已注册的符号，长期运行的服务中驻留表不会随查询增长
+    SymbolPath path = SymbolInterner::getInstance().findPath(symbolPath);
+    if (path.leaf == INVALID_SYMBOL_ID ||
+        (path.full == INVALID_SYMBOL_ID && path.scope == INVALID_SYMBOL_ID)) {
+        // 名字或其命名空间部分从未登记
+        return std::nullopt;
+    }
+    return resolveSymbol(path);
+}
+
+std::optional<NamespaceSymbol> NamespaceManager::resolveSymbol(const SymbolPath& symbolPath) const {
+    if (symbolPath.scope == INVALID_SYMBOL_ID) {
         // 在所有命名空间中搜索
         for (const auto& [_, ns] : namespaces_) {
-            auto symbol = ns->getSymbol(symbolName);
-            if (symbol.has_value()) {
-                return symbol;
+            if (const NamespaceSymbol* symbol = ns->findSymbol(symbolPath.leaf)) {
+                return *symbol;
             }
         }
     } else {
         // 在指定命名空间中搜索
-        auto ns = getNamespace(namespacePath);
-        if (ns) {
-            return ns->getSymbol(symbolName);
+        if (const auto* ns = namespaces_.find(symbolPath.scope)) {
+            if (const NamespaceSymbol* symbol = (*ns)->findSymbol(symbolPath.leaf)) {
+                return *symbol;
+            }
         }
     }
     
@@ -163,7 +173,8 @@ std::vector<NamespaceManager::ConflictInfo> NamespaceManager::checkConflicts() c
     std::vector<ConflictInfo> conflicts;
     
     // 检查每个命名空间中的符号冲突
-    for (const auto& [nsName, ns] : namespaces_) {
+    for (const auto& [_, ns] : namespaces_) {
+        const std::string& nsName = ns->getName();
         std::unordered_map<std::string, std::vector<NamespaceSymbol>> symbolMap;
         
         // 收集所有符号
@@ -193,7 +204,7 @@ std::vector<NamespaceManager::ConflictInfo> NamespaceManager::checkConflicts() c
     }
     
     // 检查命名空间本身的冲突（同名命名空间在不同文件中的不兼容定义）
-    for (const auto& [nsName, ns] : namespaces_) {
+    for (const auto& [_, ns] : namespaces_) {
         if (ns->getType() == NamespaceType::MERGED && ns->getMergeSources().size() > 1) {
             // 这里可以添加更复杂的冲突检测逻辑
             // 例如检查合并的命名空间是否有不兼容的约束等
@@ -230,8 +241,9 @@ bool NamespaceManager::checkConstraintViolation(const std::string& namespaceName
 
 std::vector<std::string> NamespaceManager::getAllNamespaces() const {
     std::vector<std::string> result;
-    for (const auto& [name, _] : namespaces_) {
-        result.push_back(name);
+    result.reserve(namespaces_.size());
+    for (const auto& [_, ns] : namespaces_) {
+        result.push_back(ns->getName());
     }
     return result;
 }
@@ -241,14 +253,6 @@ void NamespaceManager::clear() {
     fileToNamespace_.clear();
 }
 
-std::pair<std::string, std::string> NamespaceManager::splitSymbolPath(const std::string& path) const {
-    size_t lastDot = path.find_last_of('.');
-    if (lastDot != std::string::npos) {
-        return {path.substr(0, lastDot), path.substr(lastDot + 1)};
-    }
-    return {"", path};
-}
-
 bool NamespaceManager::isValidNamespaceName(const std::string& name) const {
     if (name.empty()) return false;
     
@@ -309,20 +313,22 @@ std::optional<NamespaceSymbol> NamespaceResolver::resolveSymbol(const std::strin
         return manager_.resolveSymbol(symbol);
     }
     
-    // 先在指定命名空间中查找
-    auto ns = manager_.getNamespace(fromNamespace);
-    if (ns) {
-        auto result = ns->getSymbol(symbol);
-        if (result.has_value()) {
-            return result;
-        }
-    }
+    auto& interner = SymbolInterner::getInstance();
+    return resolveSymbol(interner.find(symbol), interner.find(fromNamespace));
+}
+
+std::optional<NamespaceSymbol> NamespaceResolver::resolveSymbol(SymbolId symbol, 
+                                                               SymbolId fromNamespace) const {
+    auto& interner = SymbolInterner::getInstance();
     
-    // 如果没找到，尝试在父命名空间中查找
-    size_t dotPos = fromNamespace.find_last_of('.');
-    if (dotPos != std::string::npos) {
-        std::string parentNamespace = fromNamespace.substr(0, dotPos);
-        return resolveSymbol(symbol, parentNamespace);
+    // 先在指定命名空间中查找，没找到再沿父命名空间向上
+    for (SymbolId current = fromNamespace; current != INVALID_SYMBOL_ID;
+         current = interner.path(current).scope) {
+        if (auto ns = manager_.getNamespace(current)) {
+            if (const NamespaceSymbol* result = ns->findSymbol(symbol)) {
+                return *result;
+            }
+        }
     }
     
     return std::nullopt;
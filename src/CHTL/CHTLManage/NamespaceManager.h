@@ -7,6 +7,8 @@
 #include <unordered_set>
 #include <vector>
 #include <optional>
+#include "../../Util/ScopedInstance.h"
+#include "../../Util/SymbolInterner/SymbolMap.h"
 
 namespace CHTL {
 
@@ -40,6 +42,7 @@ public:
     void addSymbol(const NamespaceSymbol& symbol);
     bool hasSymbol(const std::string& name) const;
     std::optional<NamespaceSymbol> getSymbol(const std::string& name) const;
+    const NamespaceSymbol* findSymbol(SymbolId name) const { return symbols_.find(name); }
     std::vector<NamespaceSymbol> getAllSymbols() const;
     
     // 子命名空间管理
@@ -59,7 +62,7 @@ private:
     std::string name_;
     NamespaceType type_;
     std::string primarySourceFile_;
-    std::unordered_map<std::string, NamespaceSymbol> symbols_;
+    SymbolMap<NamespaceSymbol> symbols_;
     std::unordered_set<std::string> childNamespaces_;
     std::unordered_set<std::string> constraints_;
     std::vector<std::string> mergeSources_;
@@ -69,6 +72,9 @@ private:
 class NamespaceManager {
 public:
     static NamespaceManager& getInstance() {
+        if (auto* scoped = ScopedInstance<NamespaceManager>::current()) {
+            return *scoped;
+        }
         static NamespaceManager instance;
         return instance;
     }
@@ -79,6 +85,7 @@ public:
     
     // 获取命名空间
     std::shared_ptr<NamespaceInfo> getNamespace(const std::string& name) const;
+    std::shared_ptr<NamespaceInfo> getNamespace(SymbolId name) const;
     
     // 合并同名命名空间
     void mergeNamespaces(const std::string& name);
@@ -90,6 +97,9 @@ public:
     // 解析符号（支持嵌套命名空间）
     std::optional<NamespaceSymbol> resolveSymbol(const std::string& symbolPath) const;
     
+    // 按预先拆分好的限定名解析，重复引用同一符号时只比较整数
+    std::optional<NamespaceSymbol> resolveSymbol(const SymbolPath& symbolPath) const;
+    
     // 检查命名空间冲突
     struct ConflictInfo {
         std::string namespaceName;
@@ -117,18 +127,18 @@ public:
     void clear();
 
 private:
+    friend class ScopedInstance<NamespaceManager>;
     NamespaceManager() = default;
     NamespaceManager(const NamespaceManager&) = delete;
     NamespaceManager& operator=(const NamespaceManager&) = delete;
     
-    // 命名空间映射
-    std::unordered_map<std::string, std::shared_ptr<NamespaceInfo>> namespaces_;
+    // 命名空间映射（键为命名空间全名的符号ID）
+    SymbolMap<std::shared_ptr<NamespaceInfo>> namespaces_;
     
     // 文件到默认命名空间的映射
     std::unordered_map<std::string, std::string> fileToNamespace_;
     
     // 辅助方法
-    std::pair<std::string, std::string> splitSymbolPath(const std::string& path) const;
     bool isValidNamespaceName(const std::string& name) const;
     std::string extractFilenameAsNamespace(const std::string& filePath) const;
 };
@@ -144,6 +154,7 @@ public:
     // 解析符号（支持from语法）
     std::optional<NamespaceSymbol> resolveSymbol(const std::string& symbol, 
                                                  const std::string& fromNamespace) const;
+    std::optional<NamespaceSymbol> resolveSymbol(SymbolId symbol, SymbolId fromNamespace) const;
     
     // 构建完整路径
     std::string buildFullPath(const std::string& namespacePath, 
@@ -1,11 +1,354 @@
 #include "SelectorAutomation.h"
-#include <regex>
 #include <sstream>
 #include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <cctype>
 
 namespace CHTL {
 
+namespace {
+
+// 与ECMAScript正则中的\w一致
+bool isWordChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// CSS名称字符（含非ASCII字符）
+bool isNameChar(char c) {
+    return isWordChar(c) || c == '-' || static_cast<unsigned char>(c) >= 0x80;
+}
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f';
+}
+
+// 行列号游标：选择器按出现顺序产生，游标只向前移动，总开销与文本长度成正比
+class PositionCursor {
+public:
+    explicit PositionCursor(std::string_view text) : text_(text) {}
+    
+    void advanceTo(size_t pos, size_t& line, size_t& column) {
+        for (; offset_ < pos; ++offset_) {
+            if (text_[offset_] == '\n') {
+                ++line_;
+                column_ = 1;
+            } else {
+                ++column_;
+            }
+        }
+        line = line_;
+        column = column_;
+    }
+    
+private:
+    std::string_view text_;
+    size_t offset_ = 0;
+    size_t line_ = 1;
+    size_t column_ = 1;
+};
+
+// 以下skip函数都返回被跳过部分之后的位置，不超过text.size()
+size_t skipString(std::string_view text, size_t pos) {
+    char quote = text[pos++];
+    while (pos < text.size()) {
+        char c = text[pos];
+        if (c == '\\') {
+            pos += 2;
+            continue;
+        }
+        ++pos;
+        if (c == quote || c == '\n') {
+            break;
+        }
+    }
+    return std::min(pos, text.size());
+}
+
+size_t skipComment(std::string_view text, size_t pos) {
+    size_t end = text.find("*/", pos + 2);
+    return end == std::string_view::npos ? text.size() : end + 2;
+}
+
+size_t skipName(std::string_view text, size_t pos) {
+    while (pos < text.size()) {
+        if (text[pos] == '\\' && pos + 1 < text.size()) {
+            pos += 2;
+            continue;
+        }
+        if (!isNameChar(text[pos])) {
+            break;
+        }
+        ++pos;
+    }
+    return std::min(pos, text.size());
+}
+
+size_t skipBalanced(std::string_view text, size_t pos, char open, char close) {
+    int depth = 0;
+    while (pos < text.size()) {
+        char c = text[pos];
+        if (c == '"' || c == '\'') {
+            pos = skipString(text, pos);
+            continue;
+        }
+        if (c == '\\') {
+            pos += 2;
+            continue;
+        }
+        ++pos;
+        if (c == open) {
+            ++depth;
+        } else if (c == close && --depth == 0) {
+            break;
+        }
+    }
+    return std::min(pos, text.size());
+}
+
+// 参数本身是选择器列表的伪类
+bool takesSelectorList(std::string_view name) {
+    return name == "not" || name == "is" || name == "where" || name == "has" || name == "matches";
+}
+
+// 识别规则前导[begin, end)中的选择器
+void scanPrelude(std::string_view css, size_t begin, size_t end,
+                 PositionCursor& cursor, std::vector<SelectorView>& out) {
+    std::string_view prelude = css.substr(0, end);
+    
+    auto emit = [&](SelectorType type, size_t start, size_t valueStart, size_t stop) {
+        SelectorView view;
+        view.type = type;
+        view.raw = css.substr(start, stop - start);
+        view.value = css.substr(valueStart, stop - valueStart);
+        cursor.advanceTo(start, view.line, view.column);
+        out.push_back(view);
+    };
+    
+    // 是否位于复合选择器开头（只有这里的名称是标签选择器）
+    bool compoundStart = true;
+    size_t i = begin;
+    while (i < end) {
+        char c = css[i];
+        
+        if (c == '"' || c == '\'') {
+            i = skipString(prelude, i);
+            compoundStart = false;
+            continue;
+        }
+        if (c == '/' && i + 1 < end && css[i + 1] == '*') {
+            i = skipComment(prelude, i);
+            continue;
+        }
+        
+        if (c == '.' || c == '#') {
+            size_t stop = skipName(prelude, i + 1);
+            if (stop > i + 1) {
+                emit(c == '.' ? SelectorType::Class : SelectorType::Id, i, i + 1, stop);
+            }
+            i = stop;
+            compoundStart = false;
+        } else if (c == '&') {
+            emit(SelectorType::Reference, i, i, i + 1);
+            ++i;
+            compoundStart = false;
+        } else if (c == '[') {
+            i = skipBalanced(prelude, i, '[', ']');
+            compoundStart = false;
+        } else if (c == ':') {
+            size_t nameStart = (i + 1 < end && css[i + 1] == ':') ? i + 2 : i + 1;
+            i = skipName(prelude, nameStart);
+            compoundStart = false;
+            if (i < end && css[i] == '(') {
+                if (takesSelectorList(css.substr(nameStart, i - nameStart))) {
+                    ++i;
+                    compoundStart = true;
+                } else {
+                    i = skipBalanced(prelude, i, '(', ')');
+                }
+            }
+        } else if (isSpace(c) || c == '>' || c == '+' || c == '~' || c == ',' || c == '(') {
+            ++i;
+            compoundStart = true;
+        } else if (isNameChar(c) || c == '\\') {
+            size_t stop = skipName(prelude, i);
+            if (stop == i) {
+                stop = i + 1;
+            }
+            if (compoundStart && std::isalpha(static_cast<unsigned char>(c))) {
+                emit(SelectorType::Tag, i, i, stop);
+            }
+            i = stop;
+            compoundStart = false;
+        } else {
+            ++i;
+            compoundStart = false;
+        }
+    }
+}
+
+// 跳过空白和注释后，前导是否以@开头；是则返回@规则名
+bool atRuleName(std::string_view css, size_t begin, size_t end, std::string_view& name) {
+    size_t i = begin;
+    while (i < end) {
+        if (isSpace(css[i])) {
+            ++i;
+        } else if (css[i] == '/' && i + 1 < end && css[i + 1] == '*') {
+            i = skipComment(css.substr(0, end), i);
+        } else {
+            break;
+        }
+    }
+    if (i >= end || css[i] != '@') {
+        return false;
+    }
+    size_t stop = skipName(css.substr(0, end), i + 1);
+    name = css.substr(i + 1, stop - i - 1);
+    return true;
+}
+
+} // namespace
+
+// SelectorScanner实现
+void SelectorScanner::scanStyle(std::string_view css, std::vector<SelectorView>& out) {
+    PositionCursor cursor(css);
+    
+    // 第d层块（从1开始）的前导不是选择器时（如@keyframes内的帧），第d-1位置1；
+    // 超过64层的块一律按普通规则块处理
+    uint64_t frameBlocks = 0;
+    size_t depth = 0;
+    size_t statementStart = 0;
+    
+    size_t i = 0;
+    while (i < css.size()) {
+        char c = css[i];
+        if (c == '"' || c == '\'') {
+            i = skipString(css, i);
+            continue;
+        }
+        if (c == '/' && i + 1 < css.size() && css[i + 1] == '*') {
+            i = skipComment(css, i);
+            continue;
+        }
+        
+        if (c == '{') {
+            bool frameBlock = false;
+            std::string_view atName;
+            if (atRuleName(css, statementStart, i, atName)) {
+                frameBlock = atName.size() >= 9 && atName.substr(atName.size() - 9) == "keyframes";
+            } else if (depth == 0 || depth > 64 || !((frameBlocks >> (depth - 1)) & 1)) {
+                scanPrelude(css, statementStart, i, cursor, out);
+            }
+            ++depth;
+            if (depth <= 64) {
+                uint64_t bit = uint64_t(1) << (depth - 1);
+                frameBlocks = frameBlock ? (frameBlocks | bit) : (frameBlocks & ~bit);
+            }
+            statementStart = i + 1;
+        } else if (c == '}') {
+            if (depth > 0) {
+                --depth;
+            }
+            statementStart = i + 1;
+        } else if (c == ';') {
+            statementStart = i + 1;
+        }
+        ++i;
+    }
+}
+
+void SelectorScanner::scanScript(std::string_view script, std::vector<SelectorView>& out) {
+    PositionCursor cursor(script);
+    
+    size_t start = script.find("{{");
+    while (start != std::string_view::npos) {
+        SelectorView view;
+        size_t i = start + 2;
+        size_t valueStart = i;
+        size_t valueEnd = i;
+        
+        if (i < script.size() && script[i] == '&') {
+            view.type = SelectorType::Reference;
+            valueEnd = ++i;
+        } else {
+            if (i < script.size() && (script[i] == '.' || script[i] == '#')) {
+                view.type = script[i] == '.' ? SelectorType::Class : SelectorType::Id;
+                valueStart = ++i;
+            }
+            while (i < script.size() && (isWordChar(script[i]) || script[i] == '-')) {
+                ++i;
+            }
+            valueEnd = i;
+            if (valueEnd == valueStart) {
+                start = script.find("{{", start + 1);
+                continue;
+            }
+            if (valueStart == start + 2) {
+                view.type = std::isalpha(static_cast<unsigned char>(script[valueStart]))
+                    ? SelectorType::Tag : SelectorType::Unknown;
+            }
+            
+            // 可选的 [index]
+            if (i < script.size() && script[i] == '[') {
+                size_t digits = i + 1;
+                int index = 0;
+                while (digits < script.size() && std::isdigit(static_cast<unsigned char>(script[digits]))) {
+                    int digit = script[digits] - '0';
+                    index = index > (INT_MAX - digit) / 10 ? INT_MAX : index * 10 + digit;
+                    ++digits;
+                }
+                if (digits == i + 1 || digits >= script.size() || script[digits] != ']') {
+                    start = script.find("{{", start + 1);
+                    continue;
+                }
+                view.index = index;
+                i = digits + 1;
+            }
+        }
+        
+        if (script.compare(i, 2, "}}") != 0) {
+            start = script.find("{{", start + 1);
+            continue;
+        }
+        i += 2;
+        
+        view.raw = script.substr(start, i - start);
+        view.value = script.substr(valueStart, valueEnd - valueStart);
+        cursor.advanceTo(start, view.line, view.column);
+        out.push_back(view);
+        start = script.find("{{", i);
+    }
+}
+
+bool SelectorScanner::isSimpleSelector(std::string_view selector) {
+    size_t i = 0;
+    if (!selector.empty() && (selector[0] == '.' || selector[0] == '#' || selector[0] == '*')) {
+        ++i;
+    }
+    
+    size_t nameStart = i;
+    while (i < selector.size() && (isWordChar(selector[i]) || selector[i] == '-')) {
+        ++i;
+    }
+    if (i == nameStart) {
+        return false;
+    }
+    
+    if (i < selector.size() && selector[i] == '[') {
+        size_t close = selector.find(']', i + 1);
+        if (close == std::string_view::npos || close == i + 1) {
+            return false;
+        }
+        i = close + 1;
+    }
+    
+    if (i < selector.size()) {
+        return selector[i] == ':' && i + 1 < selector.size() &&
+               selector.find('{', i + 1) == std::string_view::npos;
+    }
+    return true;
+}
+
 // AutomationConfig实现
 AutomationConfig AutomationConfig::fromConfigBlock(const std::unordered_map<std::string, std::string>& config) {
     AutomationConfig result;
@@ -32,91 +375,39 @@ AutomationConfig AutomationConfig::fromConfigBlock(const std::unordered_map<std:
 // SelectorAutomation实现
 SelectorAutomation::SelectorAutomation() {}
 
-std::vector<SelectorInfo> SelectorAutomation::parseSelectors(const std::string& css) {
+namespace {
+
+std::vector<SelectorInfo> toSelectorInfos(const std::vector<SelectorView>& views) {
     std::vector<SelectorInfo> selectors;
-    
-    // 简化的CSS选择器解析
-    // 实际实现需要更复杂的CSS解析器
-    std::regex selectorRegex(R"(([.#]?[\w-]+(?:\[[^\]]+\])?(?::[^{]+)?))");
-    
-    size_t pos = 0;
-    size_t line = 1;
-    size_t column = 1;
-    
-    auto begin = std::sregex_iterator(css.begin(), css.end(), selectorRegex);
-    auto end = std::sregex_iterator();
-    
-    for (auto it = begin; it != end; ++it) {
-        std::smatch match = *it;
-        std::string selector = match[0];
-        
+    selectors.reserve(views.size());
+    for (const auto& view : views) {
         SelectorInfo info;
-        info.raw = selector;
-        info.type = identifySelectorType(selector);
-        info.value = extractSelectorValue(selector, info.type);
-        info.line = line;
-        info.column = column;
-        
-        selectors.push_back(info);
-        
-        // 更新位置
-        for (size_t i = pos; i < static_cast<size_t>(match.position()); ++i) {
-            if (css[i] == '\n') {
-                line++;
-                column = 1;
-            } else {
-                column++;
-            }
-        }
-        pos = match.position() + match.length();
+        info.type = view.type;
+        info.value = std::string(view.value);
+        info.raw = std::string(view.raw);
+        info.line = view.line;
+        info.column = view.column;
+        selectors.push_back(std::move(info));
     }
-    
     return selectors;
 }
 
+} // namespace
+
+std::vector<SelectorInfo> SelectorAutomation::parseSelectors(const std::string& css) {
+    std::vector<SelectorView> views;
+    SelectorScanner::scanStyle(css, views);
+    return toSelectorInfos(views);
+}
+
 std::vector<SelectorInfo> SelectorAutomation::extractFromStyleBlock(const std::string& styleContent) {
     return parseSelectors(styleContent);
 }
 
 std::vector<SelectorInfo> SelectorAutomation::extractFromScriptBlock(const std::string& scriptContent) {
-    std::vector<SelectorInfo> selectors;
-    
-    // 匹配 {{.class}}, {{#id}}, {{tag}} 等CHTL JS选择器
-    std::regex chtljsRegex(R"(\{\{([.#]?[\w-]+(?:\[\d+\])?)\}\})");
-    
-    size_t line = 1;
-    size_t column = 1;
-    size_t pos = 0;
-    
-    auto begin = std::sregex_iterator(scriptContent.begin(), scriptContent.end(), chtljsRegex);
-    auto end = std::sregex_iterator();
-    
-    for (auto it = begin; it != end; ++it) {
-        std::smatch match = *it;
-        std::string selector = match[1];
-        
-        SelectorInfo info;
-        info.raw = "{{" + selector + "}}";
-        info.type = identifySelectorType(selector);
-        info.value = extractSelectorValue(selector, info.type);
-        info.line = line;
-        info.column = column;
-        
-        selectors.push_back(info);
-        
-        // 更新位置
-        for (size_t i = pos; i < static_cast<size_t>(match.position()); ++i) {
-            if (scriptContent[i] == '\n') {
-                line++;
-                column = 1;
-            } else {
-                column++;
-            }
-        }
-        pos = match.position() + match.length();
-    }
-    
-    return selectors;
+    std::vector<SelectorView> views;
+    SelectorScanner::scanScript(scriptContent, views);
+    return toSelectorInfos(views);
 }
 
 std::optional<std::string> SelectorAutomation::getFirstClassSelector(const std::vector<SelectorInfo>& selectors) {
@@ -244,11 +535,7 @@ std::string SelectorAutomation::extractSelectorValue(const std::string& selector
 }
 
 bool SelectorAutomation::isValidSelector(const std::string& selector) {
-    if (selector.empty()) return false;
-    
-    // 简单的验证规则
-    std::regex validRegex(R"(^[.#*]?[\w-]+(?:\[[^\]]+\])?(?::[^{]+)?$)");
-    return std::regex_match(selector, validRegex);
+    return SelectorScanner::isSimpleSelector(selector);
 }
 
 std::string SelectorAutomation::normalizeSelector(const std::string& selector) {
@@ -346,14 +633,13 @@ std::string CHTLJSSelectorProcessor::processSelector(const std::string& selector
 }
 
 std::vector<std::string> CHTLJSSelectorProcessor::extractSelectors(const std::string& code) {
-    std::vector<std::string> selectors;
+    std::vector<SelectorView> views;
+    SelectorScanner::scanScript(code, views);
     
-    std::regex selectorRegex(R"(\{\{([.#]?[\w-]+(?:\[\d+\])?)\}\})");
-    auto begin = std::sregex_iterator(code.begin(), code.end(), selectorRegex);
-    auto end = std::sregex_iterator();
-    
-    for (auto it = begin; it != end; ++it) {
-        selectors.push_back((*it)[0]);
+    std::vector<std::string> selectors;
+    selectors.reserve(views.size());
+    for (const auto& view : views) {
+        selectors.emplace_back(view.raw);
     }
     
     return selectors;
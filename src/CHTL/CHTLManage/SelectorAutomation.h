@@ -2,6 +2,7 @@
 #define CHTL_SELECTOR_AUTOMATION_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -31,6 +32,31 @@ struct SelectorInfo {
     size_t column;
 };
 
+// 扫描得到的选择器，raw和value都是被扫描文本的视图
+struct SelectorView {
+    SelectorType type = SelectorType::Unknown;
+    std::string_view raw;      // 原文，如 .box、&、{{button[0]}}
+    std::string_view value;    // 名称，不含 . # 前缀和索引
+    int index = -1;            // {{selector[index]}}中的索引，没有时为-1
+    size_t line = 1;
+    size_t column = 1;
+};
+
+// 选择器扫描器
+// 手写的单遍扫描，不使用正则，也不复制文本。
+// 局部样式块中只识别规则前导（'{'之前）里的类、ID、标签选择器和&引用，
+// 跳过声明、字符串、注释、属性选择器、伪类参数以及@keyframes中的帧选择器；
+// :not() :is() :where() :has() 的参数仍按选择器识别。
+// 局部脚本块中识别 {{.class}} {{#id}} {{tag}} {{tag[index]}} 和 {{&}}。
+class SelectorScanner {
+public:
+    static void scanStyle(std::string_view css, std::vector<SelectorView>& out);
+    static void scanScript(std::string_view script, std::vector<SelectorView>& out);
+    
+    // 形如 [.#*]?name 加可选的[...]和:...的单个选择器
+    static bool isSimpleSelector(std::string_view selector);
+};
+
 // 配置选项
 struct AutomationConfig {
     bool disableStyleAutoAddClass = false;
@@ -72,6 +72,9 @@ public:
     // 获取位置信息
     const TokenLocation& getLocation() const { return location_; }
     
+    // 增量解析在编辑点之后平移复用节点的位置
+    void setLocation(const TokenLocation& location) { location_ = location; }
+    
     // 访问者模式
     virtual void accept(Visitor* visitor) = 0;
     
@@ -123,6 +126,17 @@ public:
         return children_;
     }
     
+    // 把子节点oldChild替换为newChild，oldChild不是子节点时返回false
+    bool replaceChild(const ASTNode* oldChild, std::shared_ptr<ASTNode> newChild) {
+        for (auto& child : children_) {
+            if (child.get() == oldChild) {
+                child = std::move(newChild);
+                return true;
+            }
+        }
+        return false;
+    }
+    
     std::vector<std::shared_ptr<ASTNode>> getChildren() const override {
         return children_;
     }
@@ -210,6 +210,21 @@ std::string ExceptNode::toString() const {
     return "except " + std::to_string(constraints_.size()) + " constraints";
 }
 
+// DeleteNode implementation
+void DeleteNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<OperatorVisitor*>(visitor)) {
+        v->visitDeleteNode(this);
+    }
+}
+
+std::string DeleteNode::toString() const {
+    std::string result = "delete";
+    for (size_t i = 0; i < deleteItems_.size(); ++i) {
+        result += (i == 0 ? " " : ", ") + deleteItems_[i];
+    }
+    return result;
+}
+
 // PropertyNode implementation
 void PropertyNode::accept(Visitor* visitor) {
     // TODO: Add visitPropertyNode to Visitor interface
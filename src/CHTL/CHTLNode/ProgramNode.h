@@ -22,6 +22,17 @@ public:
         return topLevelNodes_;
     }
     
+    // 把顶层节点oldChild替换为newChild，oldChild不是顶层节点时返回false
+    bool replaceChild(const ASTNode* oldChild, std::shared_ptr<ASTNode> newChild) {
+        for (auto& node : topLevelNodes_) {
+            if (node.get() == oldChild) {
+                node = std::move(newChild);
+                return true;
+            }
+        }
+        return false;
+    }
+    
     std::vector<std::shared_ptr<ASTNode>> getChildren() const override {
         return topLevelNodes_;
     }
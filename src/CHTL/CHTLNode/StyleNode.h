@@ -2,6 +2,7 @@
 #define CHTL_STYLE_NODE_H
 
 #include "BaseNode.h"
+#include "ValueProgram.h"
 
 namespace CHTL {
 
@@ -89,11 +90,14 @@ class PropertyNode : public ASTNode {
 public:
     PropertyNode(const std::string& name, const std::string& value,
                  const TokenLocation& location)
-        : ASTNode(NodeType::PROPERTY, location), name_(name), value_(value) {}
+        : ASTNode(NodeType::PROPERTY, location), name_(name), value_(value), program_(value_) {}
     
     const std::string& getName() const { return name_; }
     const std::string& getValue() const { return value_; }
     
+    // 值中的变量引用，构造时编译一次
+    const ValueProgram& getValueProgram() const { return program_; }
+    
     // 是否使用了变量组
     void setVariableGroup(const std::string& groupName) {
         variableGroup_ = groupName;
@@ -109,6 +113,7 @@ public:
 private:
     std::string name_;
     std::string value_;
+    ValueProgram program_;
     std::optional<std::string> variableGroup_;
 };
 
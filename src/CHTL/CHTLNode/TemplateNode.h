@@ -2,6 +2,7 @@
 #define CHTL_TEMPLATE_NODE_H
 
 #include "BaseNode.h"
+#include "../../Util/SymbolInterner/SymbolInterner.h"
 #include <unordered_set>
 
 namespace CHTL {
@@ -19,10 +20,12 @@ public:
     TemplateNode(TemplateType templateType, const std::string& name, 
                  const TokenLocation& location)
         : ASTNode(NodeType::TEMPLATE, location), 
-          templateType_(templateType), name_(name) {}
+          templateType_(templateType), name_(name),
+          nameId_(SymbolInterner::getInstance().intern(name)) {}
     
     TemplateType getTemplateType() const { return templateType_; }
     const std::string& getName() const { return name_; }
+    SymbolId getNameId() const { return nameId_; }
     
     // 内容管理
     void setContent(std::shared_ptr<ASTNode> content) {
@@ -53,6 +56,7 @@ public:
 private:
     TemplateType templateType_;
     std::string name_;
+    SymbolId nameId_;
     std::shared_ptr<ASTNode> content_;
     std::unordered_set<std::string> inheritedTemplates_;
 };
@@ -63,12 +67,15 @@ public:
     TemplateUseNode(TemplateType templateType, const std::string& name,
                     const TokenLocation& location)
         : ASTNode(NodeType::FUNCTION_CALL, location),
-          templateType_(templateType), name_(name) {}
+          templateType_(templateType), name_(name),
+          nameId_(SymbolInterner::getInstance().intern(name)) {}
     
     TemplateType getTemplateType() const { return templateType_; }
     const std::string& getName() const { return name_; }
+    // 名字在解析时驻留，生成阶段按ID查找模板
+    SymbolId getNameId() const { return nameId_; }
     
-    // 特例化参数（用于自定义）
+    // 特例化参数（用于自定义），值为空表示delete该属性
     void addSpecialization(const std::string& key, const std::string& value) {
         specializations_[key] = value;
     }
@@ -83,6 +90,7 @@ public:
 private:
     TemplateType templateType_;
     std::string name_;
+    SymbolId nameId_;
     std::unordered_map<std::string, std::string> specializations_;
 };
 
@@ -0,0 +1,96 @@
+#include "ValueProgram.h"
+#include <cctype>
+
+namespace CHTL {
+
+namespace {
+
+bool isNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+bool isVariableName(std::string_view text) {
+    // 数值（translate(10px)）和CSS自定义属性（var(--gap)）不是变量名
+    if (text.empty() || !(std::isalpha(static_cast<unsigned char>(text.front())) || text.front() == '_')) {
+        return false;
+    }
+    for (char c : text) {
+        if (!isNameChar(c) && c != '-') {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+} // namespace
+
+void ValueProgram::compile(std::string_view value) {
+    references_.clear();
+    auto& interner = SymbolInterner::getInstance();
+
+    // nameStart为当前连续名字字符的起点，遇到'('时它之前的名字即变量组名
+    size_t nameStart = std::string_view::npos;
+    size_t i = 0;
+    while (i < value.size()) {
+        char c = value[i];
+        if (isNameChar(c)) {
+            if (nameStart == std::string_view::npos) {
+                nameStart = i;
+            }
+            ++i;
+            continue;
+        }
+
+        if (c == '@') {
+            size_t end = i + 1;
+            while (end < value.size() && isNameChar(value[end])) {
+                ++end;
+            }
+            if (end > i + 1) {
+                ValueReference reference;
+                reference.kind = ValueReference::Kind::VARIABLE;
+                reference.offset = static_cast<uint32_t>(i);
+                reference.length = static_cast<uint32_t>(end - i);
+                reference.variable = interner.intern(value.substr(i + 1, end - i - 1));
+                references_.push_back(reference);
+                i = end;
+                nameStart = std::string_view::npos;
+                continue;
+            }
+        } else if (c == '(' && nameStart != std::string_view::npos) {
+            // 组名(变量名)；参数里还有括号或不是名字的（rgb(1, 2, 3)等）按字面量处理
+            size_t close = value.find(')', i + 1);
+            if (close != std::string_view::npos) {
+                std::string_view argument = value.substr(i + 1, close - i - 1);
+                std::string_view variable = trim(argument);
+                if (argument.find('(') == std::string_view::npos && isVariableName(variable)) {
+                    ValueReference reference;
+                    reference.kind = ValueReference::Kind::GROUP_VARIABLE;
+                    reference.offset = static_cast<uint32_t>(nameStart);
+                    reference.length = static_cast<uint32_t>(close + 1 - nameStart);
+                    reference.group = interner.intern(value.substr(nameStart, i - nameStart));
+                    reference.variable = interner.intern(variable);
+                    references_.push_back(reference);
+                    i = close + 1;
+                    nameStart = std::string_view::npos;
+                    continue;
+                }
+            }
+        }
+
+        nameStart = std::string_view::npos;
+        ++i;
+    }
+}
+
+} // namespace CHTL
@@ -0,0 +1,60 @@
+#ifndef CHTL_VALUE_PROGRAM_H
+#define CHTL_VALUE_PROGRAM_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "../../Util/SymbolInterner/SymbolInterner.h"
+
+namespace CHTL {
+
+// 属性值中的变量引用
+struct ValueReference {
+    enum class Kind : uint8_t {
+        VARIABLE,           // @name
+        GROUP_VARIABLE      // ThemeColor(tableColor)
+    };
+
+    Kind kind = Kind::VARIABLE;
+    uint32_t offset = 0;    // 引用在值文本中的范围，未解析时原样输出
+    uint32_t length = 0;
+    SymbolId group = INVALID_SYMBOL_ID;
+    SymbolId variable = INVALID_SYMBOL_ID;
+};
+
+// 预编译的属性值替换程序
+// 值文本只在构造属性节点时扫描一次，切分为字面量段和变量引用段，
+// 名字驻留为SymbolId。生成时按段追加到输出缓冲区，不再查找、截取
+// 或原地替换字符串。只记录引用，引用之间的文本即字面量段；没有
+// 引用的值（绝大多数）不分配内存，直接原样输出。
+class ValueProgram {
+public:
+    ValueProgram() = default;
+    explicit ValueProgram(std::string_view value) { compile(value); }
+
+    void compile(std::string_view value);
+
+    bool empty() const { return references_.empty(); }
+    const std::vector<ValueReference>& getReferences() const { return references_; }
+
+    // 按段输出。resolve(reference, out)返回false时原样输出引用文本
+    template <typename Resolver, typename Output>
+    void render(std::string_view value, Output& out, Resolver&& resolve) const {
+        size_t position = 0;
+        for (const auto& reference : references_) {
+            out.append(value.data() + position, reference.offset - position);
+            if (!resolve(reference, out)) {
+                out.append(value.data() + reference.offset, reference.length);
+            }
+            position = reference.offset + reference.length;
+        }
+        out.append(value.data() + position, value.size() - position);
+    }
+
+private:
+    std::vector<ValueReference> references_;
+};
+
+} // namespace CHTL
+
+#endif // CHTL_VALUE_PROGRAM_H
@@ -0,0 +1,376 @@
+#include "IncrementalParser.h"
+#include "../CHTLLexer/TokenArena.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace CHTL {
+
+namespace {
+
+constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+// 从text中from处（行列为line/column）数到to处，计数方式与Lexer一致
+void advancePosition(const std::string& text, size_t from, size_t to, size_t& line, size_t& column) {
+    for (size_t i = from; i < to; ++i) {
+        if (text[i] == '\n') {
+            ++line;
+            column = 1;
+        } else {
+            ++column;
+        }
+    }
+}
+
+size_t addDelta(size_t value, ptrdiff_t delta) {
+    return static_cast<size_t>(static_cast<ptrdiff_t>(value) + delta);
+}
+
+// 编辑点之后的位置平移：旧偏移不小于from的位置整体平移，
+// 与编辑结束处同一行的位置还要平移列号
+struct LocationShift {
+    size_t from = 0;
+    ptrdiff_t offsetDelta = 0;
+    ptrdiff_t lineDelta = 0;
+    size_t endLine = 0;
+    ptrdiff_t columnDelta = 0;
+
+    bool applies(const TokenLocation& location) const { return location.offset >= from; }
+
+    TokenLocation apply(TokenLocation location) const {
+        if (location.line == endLine) {
+            location.column = addDelta(location.column, columnDelta);
+        }
+        location.line = addDelta(location.line, lineDelta);
+        location.offset = addDelta(location.offset, offsetDelta);
+        return location;
+    }
+};
+
+void shiftSubtree(ASTNode& node, const LocationShift& shift) {
+    if (shift.applies(node.getLocation())) {
+        node.setLocation(shift.apply(node.getLocation()));
+    }
+    if (node.getType() == NodeType::ELEMENT) {
+        for (const auto& child : static_cast<ElementNode&>(node).getChildNodes()) {
+            shiftSubtree(*child, shift);
+        }
+    } else {
+        for (const auto& child : node.getChildren()) {
+            if (child) {
+                shiftSubtree(*child, shift);
+            }
+        }
+    }
+}
+
+// 只进入可能含有编辑点之后节点的子树；skip为刚解析出的新子树（已是新位置）
+// 程序和元素的子节点按源码顺序排列，下一个兄弟在from之前开始的子树整体在from之前
+void shiftAfter(ASTNode& node, const LocationShift& shift, const ASTNode* skip) {
+    const std::vector<std::shared_ptr<ASTNode>>* children = nullptr;
+    if (node.getType() == NodeType::PROGRAM) {
+        children = &static_cast<ProgramNode&>(node).getTopLevelNodes();
+    } else if (node.getType() == NodeType::ELEMENT) {
+        children = &static_cast<ElementNode&>(node).getChildNodes();
+    } else {
+        shiftSubtree(node, shift);
+        return;
+    }
+
+    for (size_t i = 0; i < children->size(); ++i) {
+        ASTNode* child = (*children)[i].get();
+        if (!child || child == skip) {
+            continue;
+        }
+        if (i + 1 < children->size() && (*children)[i + 1] &&
+            (*children)[i + 1]->getLocation().offset < shift.from) {
+            continue;
+        }
+        if (shift.applies(child->getLocation())) {
+            shiftSubtree(*child, shift);
+        } else {
+            shiftAfter(*child, shift, skip);
+        }
+    }
+}
+
+} // namespace
+
+// 记录解析过程：Token流、块和错误位置
+class IncrementalParser::Recording : public ParseRecorder {
+public:
+    struct RecordedBlock {
+        const ASTNode* container;
+        std::shared_ptr<ASTNode> node;
+        size_t firstToken;
+        size_t lastToken;
+        size_t stateDepth;
+    };
+
+    std::vector<std::shared_ptr<Token>> tokens;
+    std::vector<RecordedBlock> blocks;
+    std::vector<size_t> errorOffsets;
+
+    void onToken(const std::shared_ptr<Token>& token) override {
+        tokens.push_back(token);
+    }
+
+    void onBlock(const ASTNode* container, const std::shared_ptr<ASTNode>& node,
+                 size_t firstToken, size_t lastToken, size_t stateDepth) override {
+        blocks.push_back({container, node, firstToken, lastToken, stateDepth});
+    }
+
+    void onError(const std::string&, size_t offset) override {
+        errorOffsets.push_back(offset);
+    }
+};
+
+IncrementalParser::IncrementalParser(std::shared_ptr<CompileContext> context, const ParserConfig& config)
+    : context_(std::move(context)), config_(config) {}
+
+std::shared_ptr<ProgramNode> IncrementalParser::parse(std::string source) {
+    source_ = std::move(source);
+    return parseFull();
+}
+
+std::shared_ptr<ProgramNode> IncrementalParser::applyEdit(const TextEdit& edit) {
+    if (edit.offset > source_.size() || edit.length > source_.size() - edit.offset) {
+        throw std::out_of_range("Text edit is outside the source");
+    }
+
+    size_t index = program_ ? findBlock(edit) : NOT_FOUND;
+    if (index == NOT_FOUND) {
+        source_.replace(edit.offset, edit.length, edit.text);
+        return parseFull();
+    }
+
+    // reparseBlock失败时源码已经更新，AST未改动
+    if (!reparseBlock(index, edit)) {
+        return parseFull();
+    }
+    return program_;
+}
+
+std::shared_ptr<ProgramNode> IncrementalParser::parseFull() {
+    // 解析出错时状态栈可能残留，每次解析都从全局状态开始
+    context_->getStateManager().reset();
+    TokenArena arena;
+    auto lexer = std::make_shared<Lexer>(std::string_view(source_), arena, context_);
+    Parser parser(lexer, context_, config_);
+    Recording recording;
+    parser.setRecorder(&recording);
+    program_ = parser.parse();
+
+    blocks_ = collectBlocks(recording, program_.get(), 0);
+    tokens_ = std::move(recording.tokens);
+    errors_ = parser.getErrors();
+    errorOffsets_ = std::move(recording.errorOffsets);
+
+    stats_ = Stats();
+    stats_.reparsedBytes = source_.size();
+    stats_.reparsedTokens = tokens_.size();
+    return program_;
+}
+
+size_t IncrementalParser::findBlock(const TextEdit& edit) const {
+    // 先序排列，包含编辑范围的块中最后一个最内层
+    size_t editEnd = edit.offset + edit.length;
+    size_t found = NOT_FOUND;
+    for (size_t i = 0; i < blocks_.size() && blocks_[i].begin < edit.offset; ++i) {
+        const Block& block = blocks_[i];
+        if (block.reparsable && block.openBrace < edit.offset && editEnd <= block.closeBrace) {
+            found = i;
+        }
+    }
+    if (found == NOT_FOUND) {
+        return NOT_FOUND;
+    }
+
+    // 块外的错误无法随局部重解析更新（消息中含行列）
+    const Block& block = blocks_[found];
+    for (size_t offset : errorOffsets_) {
+        if (offset < block.begin || offset > block.closeBrace) {
+            return NOT_FOUND;
+        }
+    }
+    return found;
+}
+
+size_t IncrementalParser::findToken(size_t offset) const {
+    auto it = std::lower_bound(tokens_.begin(), tokens_.end(), offset,
+        [](const std::shared_ptr<Token>& token, size_t value) {
+            return token->getLocation().offset < value;
+        });
+    if (it == tokens_.end() || (*it)->getLocation().offset != offset) {
+        return NOT_FOUND;
+    }
+    return static_cast<size_t>(it - tokens_.begin());
+}
+
+bool IncrementalParser::reparseBlock(size_t index, const TextEdit& edit) {
+    const Block block = blocks_[index];
+    size_t firstToken = findToken(block.begin);
+    size_t lastToken = findToken(block.closeBrace);
+    if (firstToken == NOT_FOUND || lastToken == NOT_FOUND || lastToken + 1 >= tokens_.size()) {
+        source_.replace(edit.offset, edit.length, edit.text);
+        return false;
+    }
+
+    // 编辑结束处在编辑前后的行列，用于平移块之后的位置
+    const TokenLocation beginLocation = tokens_[firstToken]->getLocation();
+    size_t oldEndLine = beginLocation.line;
+    size_t oldEndColumn = beginLocation.column;
+    advancePosition(source_, block.begin, edit.offset + edit.length, oldEndLine, oldEndColumn);
+
+    source_.replace(edit.offset, edit.length, edit.text);
+
+    size_t newEndLine = beginLocation.line;
+    size_t newEndColumn = beginLocation.column;
+    advancePosition(source_, block.begin, edit.offset + edit.text.size(), newEndLine, newEndColumn);
+    ptrdiff_t delta = static_cast<ptrdiff_t>(edit.text.size()) - static_cast<ptrdiff_t>(edit.length);
+
+    // 从块首重新扫描，在与完整解析相同的外层状态下解析该块
+    context_->getStateManager().reset();
+    TokenArena arena;
+    auto lexer = std::make_shared<Lexer>(std::string_view(source_), arena, context_);
+    lexer->seek(block.begin, beginLocation.line, beginLocation.column);
+    Parser parser(lexer, context_, config_);
+    Recording recording;
+    parser.setRecorder(&recording);
+    auto node = parser.parseBlock(block.depth);
+
+    // 新块必须恰好结束在平移后的右花括号，且其后的Token不变
+    if (!node || node->getType() != block.node->getType() || recording.tokens.size() < 2) {
+        return false;
+    }
+    const auto& closeToken = recording.tokens[recording.tokens.size() - 2];
+    if (closeToken->getType() != TokenType::RIGHT_BRACE ||
+        closeToken->getLocation().offset != addDelta(block.closeBrace, delta)) {
+        return false;
+    }
+    const auto& next = recording.tokens.back();
+    const auto& oldNext = tokens_[lastToken + 1];
+    if (next->getType() != oldNext->getType() || next->getLexeme() != oldNext->getLexeme() ||
+        next->getLocation().offset != addDelta(oldNext->getLocation().offset, delta)) {
+        return false;
+    }
+
+    bool replaced = block.container == program_.get()
+        ? program_->replaceChild(block.node.get(), node)
+        : static_cast<ElementNode*>(block.container)->replaceChild(block.node.get(), node);
+    if (!replaced) {
+        return false;
+    }
+
+    LocationShift shift;
+    shift.from = block.closeBrace + 1;
+    shift.offsetDelta = delta;
+    shift.lineDelta = static_cast<ptrdiff_t>(newEndLine) - static_cast<ptrdiff_t>(oldEndLine);
+    shift.endLine = oldEndLine;
+    shift.columnDelta = static_cast<ptrdiff_t>(newEndColumn) - static_cast<ptrdiff_t>(oldEndColumn);
+
+    // 复用的节点
+    shiftAfter(*program_, shift, node.get());
+
+    // Token流：块之后的Token平移，块内的换成新扫描的Token
+    for (size_t i = lastToken + 1; i < tokens_.size(); ++i) {
+        tokens_[i]->setLocation(shift.apply(tokens_[i]->getLocation()));
+    }
+    size_t reparsedTokens = recording.tokens.size() - 1;
+    tokens_.erase(tokens_.begin() + static_cast<ptrdiff_t>(firstToken),
+                  tokens_.begin() + static_cast<ptrdiff_t>(lastToken + 1));
+    tokens_.insert(tokens_.begin() + static_cast<ptrdiff_t>(firstToken),
+                   recording.tokens.begin(), recording.tokens.end() - 1);
+
+    // 块表：外层块的右花括号和之后的块平移，块及其子块换成新记录的块
+    recording.blocks.push_back({block.container, node, 0, reparsedTokens - 1, block.depth + 1});
+    auto newBlocks = collectBlocks(recording, block.container, block.depth);
+
+    size_t subtreeEnd = index + 1;
+    while (subtreeEnd < blocks_.size() && blocks_[subtreeEnd].begin < block.closeBrace) {
+        ++subtreeEnd;
+    }
+    for (size_t i = 0; i < index; ++i) {
+        if (blocks_[i].closeBrace > block.closeBrace) {
+            blocks_[i].closeBrace = addDelta(blocks_[i].closeBrace, delta);
+        }
+    }
+    for (size_t i = subtreeEnd; i < blocks_.size(); ++i) {
+        blocks_[i].begin = addDelta(blocks_[i].begin, delta);
+        blocks_[i].openBrace = addDelta(blocks_[i].openBrace, delta);
+        blocks_[i].closeBrace = addDelta(blocks_[i].closeBrace, delta);
+    }
+    blocks_.erase(blocks_.begin() + static_cast<ptrdiff_t>(index),
+                  blocks_.begin() + static_cast<ptrdiff_t>(subtreeEnd));
+    blocks_.insert(blocks_.begin() + static_cast<ptrdiff_t>(index),
+                   std::make_move_iterator(newBlocks.begin()), std::make_move_iterator(newBlocks.end()));
+
+    // 旧错误都在块内（见findBlock），整体换成重解析的错误
+    errors_ = parser.getErrors();
+    errorOffsets_ = std::move(recording.errorOffsets);
+
+    stats_ = Stats();
+    stats_.incremental = true;
+    stats_.reparsedBytes = closeToken->getLocation().offset + 1 - block.begin;
+    stats_.reparsedTokens = reparsedTokens;
+    stats_.shiftedTokens = tokens_.size() - firstToken - reparsedTokens;
+    return true;
+}
+
+std::vector<IncrementalParser::Block> IncrementalParser::collectBlocks(const Recording& recording,
+                                                                       const ASTNode* root, size_t rootDepth) {
+    struct Entry {
+        Block block;
+        size_t stateDepth;
+        bool wellFormed;
+    };
+
+    std::vector<Entry> entries;
+    entries.reserve(recording.blocks.size());
+    for (const auto& recorded : recording.blocks) {
+        Entry entry;
+        entry.block.node = recorded.node;
+        entry.block.container = const_cast<ASTNode*>(recorded.container);
+        entry.block.begin = recording.tokens[recorded.firstToken]->getLocation().offset;
+        entry.block.openBrace = NOT_FOUND;
+        for (size_t i = recorded.firstToken; i <= recorded.lastToken; ++i) {
+            if (recording.tokens[i]->getType() == TokenType::LEFT_BRACE) {
+                entry.block.openBrace = recording.tokens[i]->getLocation().offset;
+                break;
+            }
+        }
+        const auto& last = recording.tokens[recorded.lastToken];
+        entry.block.closeBrace = last->getLocation().offset;
+        entry.stateDepth = recorded.stateDepth;
+        entry.wellFormed = last->getType() == TokenType::RIGHT_BRACE && entry.block.openBrace != NOT_FOUND;
+        entries.push_back(std::move(entry));
+    }
+
+    // 记录顺序为后序（子块先完成），按起点排序得到先序
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.block.begin < b.block.begin;
+    });
+
+    std::vector<Block> blocks;
+    blocks.reserve(entries.size());
+    std::unordered_map<const ASTNode*, size_t> indexByNode;
+    for (auto& entry : entries) {
+        Block& block = entry.block;
+        bool anchored = false;
+        if (block.container == root) {
+            block.depth = rootDepth;
+            anchored = true;
+        } else if (auto it = indexByNode.find(block.container); it != indexByNode.end()) {
+            block.depth = blocks[it->second].depth + 1;
+            anchored = blocks[it->second].reparsable;
+        }
+        // 状态栈只含全局状态和外层元素的状态时，才能在重建的状态下单独解析
+        block.reparsable = anchored && entry.wellFormed && entry.stateDepth == block.depth + 1;
+        indexByNode[block.node.get()] = blocks.size();
+        blocks.push_back(std::move(block));
+    }
+    return blocks;
+}
+
+} // namespace CHTL
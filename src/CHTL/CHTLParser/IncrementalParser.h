@@ -0,0 +1,87 @@
+#ifndef CHTL_INCREMENTAL_PARSER_H
+#define CHTL_INCREMENTAL_PARSER_H
+
+#include "Parser.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace CHTL {
+
+// 文本编辑：把源码中[offset, offset + length)替换为text
+struct TextEdit {
+    size_t offset = 0;
+    size_t length = 0;
+    std::string text;
+};
+
+// 增量解析会话（编辑器逐次编辑时使用）
+// 保存上一次解析的源码、AST、Token流和块表。编辑后找出花括号内完整包含
+// 编辑范围的最小块（元素、style{}、script{}、[Template]、[Custom]），只从该块的
+// 起点重新扫描并解析到它的右花括号，用新子树替换旧子树；其余子树按引用复用，
+// 编辑点之后的复用节点和Token原地平移位置。结果与完整解析一致。
+// 以下情况退化为完整解析：编辑触及块头或花括号、块外还有旧的解析错误、
+// 重解析后块的边界或紧随其后的Token发生变化。
+// 与Parser::parse相同，语法错误记录在getErrors()中，状态转换等其他异常原样抛出。
+class IncrementalParser {
+public:
+    struct Stats {
+        bool incremental = false;       // 上一次解析是否为局部重解析
+        size_t reparsedBytes = 0;       // 重新扫描、解析的字节数
+        size_t reparsedTokens = 0;      // 重新扫描的Token数
+        size_t shiftedTokens = 0;       // 平移位置的Token数
+    };
+
+    explicit IncrementalParser(std::shared_ptr<CompileContext> context,
+                               const ParserConfig& config = ParserConfig());
+
+    // 完整解析
+    std::shared_ptr<ProgramNode> parse(std::string source);
+
+    // 应用编辑并更新AST，返回的根节点与上一次相同（原地更新）
+    std::shared_ptr<ProgramNode> applyEdit(const TextEdit& edit);
+
+    const std::string& getSource() const { return source_; }
+    const std::shared_ptr<ProgramNode>& getProgram() const { return program_; }
+    const std::vector<std::shared_ptr<Token>>& getTokens() const { return tokens_; }
+    const std::vector<std::string>& getErrors() const { return errors_; }
+    const Stats& getLastStats() const { return stats_; }
+
+private:
+    // 可重解析的块，按起点排序（先序），子块紧跟在父块之后
+    struct Block {
+        std::shared_ptr<ASTNode> node;
+        ASTNode* container = nullptr;   // ProgramNode或ElementNode
+        size_t begin = 0;               // 块首Token的偏移
+        size_t openBrace = 0;           // '{'的偏移
+        size_t closeBrace = 0;          // '}'的偏移
+        size_t depth = 0;               // 外层元素块的层数
+        bool reparsable = false;        // 外层都是已记录的块，状态栈只含这些块的状态
+    };
+
+    class Recording;
+
+    std::shared_ptr<CompileContext> context_;
+    ParserConfig config_;
+
+    std::string source_;
+    std::shared_ptr<ProgramNode> program_;
+    std::vector<std::shared_ptr<Token>> tokens_;
+    std::vector<Block> blocks_;
+    std::vector<std::string> errors_;
+    std::vector<size_t> errorOffsets_;
+    Stats stats_;
+
+    std::shared_ptr<ProgramNode> parseFull();
+    bool reparseBlock(size_t index, const TextEdit& edit);
+    size_t findBlock(const TextEdit& edit) const;
+    size_t findToken(size_t offset) const;
+
+    // 把记录的块转换为块表项（按起点排序）；容器为root的块深度为rootDepth
+    static std::vector<Block> collectBlocks(const Recording& recording, const ASTNode* root, size_t rootDepth);
+};
+
+} // namespace CHTL
+
+#endif // CHTL_INCREMENTAL_PARSER_H
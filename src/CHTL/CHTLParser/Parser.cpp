@@ -33,9 +33,12 @@ std::shared_ptr<ProgramNode> Parser::parse() {
     // 解析顶层节点
     while (!isAtEnd()) {
         try {
+            size_t firstToken = tokenCount_ - 1;
+            size_t stateDepth = context_->getStateManager().getStackDepth();
             auto node = parseTopLevel();
             if (node) {
                 program->addTopLevelNode(node);
+                recordBlock(program.get(), node, firstToken, stateDepth);
             }
         } catch (const ParseException& e) {
             error(e.what());
@@ -46,9 +49,62 @@ std::shared_ptr<ProgramNode> Parser::parse() {
     return program;
 }
 
+std::shared_ptr<ASTNode> Parser::parseBlock(size_t enclosingElements) {
+    auto& stateManager = context_->getStateManager();
+    size_t depth = stateManager.getStackDepth();
+    
+    std::shared_ptr<ASTNode> node;
+    try {
+        for (size_t i = 0; i < enclosingElements; ++i) {
+            enterState(StateType::IN_ELEMENT);
+        }
+        node = enclosingElements == 0 ? parseTopLevel() : parseElementContent();
+    } catch (const ParseException& e) {
+        error(e.what());
+        node = nullptr;
+    }
+    
+    // 异常时块内进入的状态也一并退出
+    while (stateManager.getStackDepth() > depth) {
+        exitState();
+    }
+    return node;
+}
+
+void Parser::setRecorder(ParseRecorder* recorder) {
+    recorder_ = recorder;
+    tokenCount_ = 1;
+    if (recorder_) {
+        recorder_->onToken(current_);
+    }
+}
+
+void Parser::recordBlock(const ASTNode* container, const std::shared_ptr<ASTNode>& node,
+                         size_t firstToken, size_t stateDepth) {
+    if (!recorder_) {
+        return;
+    }
+    switch (node->getType()) {
+        case NodeType::ELEMENT:
+        case NodeType::STYLE_BLOCK:
+        case NodeType::SCRIPT_BLOCK:
+        case NodeType::TEMPLATE:
+        case NodeType::CUSTOM:
+            // 最后一个Token是previous_
+            recorder_->onBlock(container, node, firstToken, tokenCount_ - 2, stateDepth);
+            break;
+        default:
+            break;
+    }
+}
+
 void Parser::advance() {
     previous_ = current_;
     current_ = lexer_->nextToken();
+    ++tokenCount_;
+    if (recorder_) {
+        recorder_->onToken(current_);
+    }
 }
 
 bool Parser::check(TokenType type) const {
@@ -91,6 +147,9 @@ bool Parser::isAtEnd() const {
 void Parser::error(const std::string& message) {
     errors_.push_back(message);
     context_->addError(message);
+    if (recorder_) {
+        recorder_->onError(message, current_->getLocation().offset);
+    }
 }
 
 void Parser::error(const Token& token, const std::string& message) {
@@ -270,6 +329,8 @@ std::shared_ptr<ElementNode> Parser::parseElement() {
     
     // 解析元素内容
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
+        size_t firstToken = tokenCount_ - 1;
+        size_t stateDepth = context_->getStateManager().getStackDepth();
         auto content = parseElementContent();
         if (content) {
             if (content->getType() == NodeType::ATTRIBUTE) {
@@ -277,6 +338,7 @@ std::shared_ptr<ElementNode> Parser::parseElement() {
                 element->addAttribute(attr->getName(), attr->getValue());
             } else {
                 element->addChild(content);
+                recordBlock(element.get(), content, firstToken, stateDepth);
             }
         }
     }
@@ -327,9 +389,8 @@ std::shared_ptr<ASTNode> Parser::parseElementContent() {
         }
     }
     
-    // 模板/自定义使用
-    if (match({TokenType::TYPE_STYLE, TokenType::TYPE_ELEMENT, TokenType::TYPE_VAR})) {
-        previous_->getType();  // 保存类型
+    // 模板/自定义使用（类型记号由parseTemplateUse消费）
+    if (check(TokenType::TYPE_STYLE) || check(TokenType::TYPE_ELEMENT) || check(TokenType::TYPE_VAR)) {
         return parseTemplateUse();
     }
     
@@ -907,11 +968,19 @@ std::shared_ptr<ASTNode> Parser::parseTemplateContent(TemplateType type) {
     switch (type) {
         case TemplateType::STYLE: {
             // Parse style template content (CSS properties)
+            // 属性，以及组合/继承的其他样式组（@Style Name; 或 inherit @Style Name;）
             auto styleNode = std::make_shared<StyleNode>(StyleBlockType::GLOBAL, current_->getLocation());
             while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-                // For now, skip style content
-                if (check(TokenType::SEMICOLON)) {
-                    advance();
+                if (match(TokenType::KEYWORD_INHERIT) || check(TokenType::TYPE_STYLE)) {
+                    auto use = parseTemplateUse();
+                    if (use) {
+                        styleNode->addRule(use);
+                    }
+                } else if (check(TokenType::IDENTIFIER) || check(TokenType::HTML_TAG)) {
+                    auto prop = parseCSSProperty();
+                    if (prop) {
+                        styleNode->addRule(prop);
+                    }
                 } else {
                     advance();
                 }
@@ -943,21 +1012,9 @@ std::shared_ptr<ASTNode> Parser::parseTemplateContent(TemplateType type) {
             break;
         }
         
-        case TemplateType::VAR: {
-            // Parse variable template content (key-value pairs)
-            while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-                if (check(TokenType::IDENTIFIER)) {
-                    std::string varName = parseIdentifier();
-                    if (match({TokenType::COLON, TokenType::EQUAL})) {
-                        parseAttributeValue();
-                        consume(TokenType::SEMICOLON, "Expected ';' after variable value");
-                    }
-                } else {
-                    advance();
-                }
-            }
-            break;
-        }
+        case TemplateType::VAR:
+            // 变量组：变量名: 值;
+            return parseVarGroupContent();
     }
     
     return nullptr;
@@ -969,6 +1026,11 @@ std::shared_ptr<ASTNode> Parser::parseStyleContent() {
         // Skip
     }
     
+    // 样式组使用 @Style Name;
+    if (check(TokenType::TYPE_STYLE)) {
+        return parseTemplateUse();
+    }
+    
     // 检查是选择器还是属性
     if (check(TokenType::DOT) || check(TokenType::HASH) || check(TokenType::AMPERSAND)) {
         // 这是一个选择器（.class, #id, &:hover）
@@ -1063,9 +1125,13 @@ std::shared_ptr<SelectorNode> Parser::parseCSSSelector() {
     auto styleContent = std::make_shared<StyleNode>(StyleBlockType::LOCAL, location);
     
     while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
+        size_t before = tokenCount_;
         auto prop = parseCSSProperty();
         if (prop) {
             styleContent->addRule(prop);
+        } else if (tokenCount_ == before) {
+            // 属性名无法识别且未消费任何Token时跳过，避免死循环
+            advance();
         }
     }
     
@@ -1166,6 +1232,61 @@ std::shared_ptr<ASTNode> Parser::parseTemplateUse() {
     // Create template use node
     auto useNode = std::make_shared<TemplateUseNode>(type, templateName, location);
     
+    // 特例化块：@Style Name { 属性: 值; delete 属性, @Style 样式组, ...; }
+    if (match(TokenType::LEFT_BRACE)) {
+        if (type != TemplateType::STYLE) {
+            // 元素/变量组的特例化（insert、delete、索引访问等）尚未实现：
+            // 报错后按括号配对跳过，保证外层结构仍能正确解析
+            error(*previous_, std::string("Unsupported specialization of ") +
+                  (type == TemplateType::ELEMENT ? "@Element " : "@Var ") + templateName);
+            size_t depth = 0;
+            while (!isAtEnd() && (depth > 0 || !check(TokenType::RIGHT_BRACE))) {
+                if (check(TokenType::LEFT_BRACE)) {
+                    ++depth;
+                } else if (check(TokenType::RIGHT_BRACE)) {
+                    --depth;
+                }
+                advance();
+            }
+        }
+        while (type == TemplateType::STYLE && !isAtEnd() && !check(TokenType::RIGHT_BRACE)) {
+            if (match(TokenType::KEYWORD_DELETE)) {
+                // 删除的属性以空值记录，删除的样式组以 "@Style 名称" 记录
+                do {
+                    if (match(TokenType::TYPE_STYLE)) {
+                        useNode->addSpecialization("@Style " + parseIdentifier(), "");
+                    } else {
+                        useNode->addSpecialization(parseIdentifier(), "");
+                    }
+                } while (match(TokenType::COMMA));
+                match(TokenType::SEMICOLON);
+            } else if (check(TokenType::IDENTIFIER) || check(TokenType::HTML_TAG)) {
+                auto prop = parseCSSProperty();
+                if (prop) {
+                    useNode->addSpecialization(prop->getName(), prop->getValue());
+                }
+            } else if (current_->isComment()) {
+                advance();
+            } else {
+                // 跳到本条语句结束，不越过特例化块的 '}'
+                error(*current_, "Unsupported content in @Style specialization of " + templateName);
+                size_t depth = 0;
+                while (!isAtEnd() && (depth > 0 || !check(TokenType::RIGHT_BRACE))) {
+                    if (check(TokenType::LEFT_BRACE)) {
+                        ++depth;
+                    } else if (check(TokenType::RIGHT_BRACE)) {
+                        --depth;
+                    } else if (depth == 0 && check(TokenType::SEMICOLON)) {
+                        advance();
+                        break;
+                    }
+                    advance();
+                }
+            }
+        }
+        consume(TokenType::RIGHT_BRACE, "Expected '}' after specialization block");
+    }
+    
     // Check for semicolon
     match(TokenType::SEMICOLON);
     
@@ -1179,27 +1300,31 @@ std::shared_ptr<ASTNode> Parser::parseCustomContent(CustomType type) {
             auto styleNode = std::make_shared<StyleNode>(StyleBlockType::LOCAL, current_->getLocation());
             
             while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-                if (match(TokenType::KEYWORD_DELETE)) {
-                    // TODO: Parse delete operation
-                    parseIdentifier();  // Get property to delete
-                    match(TokenType::SEMICOLON);
-                } else if (match(TokenType::KEYWORD_INHERIT)) {
-                    // TODO: Parse inherit operation
-                    parseIdentifier();  // Get custom name to inherit
-                    match(TokenType::SEMICOLON);
-                } else if (match(TokenType::TYPE_STYLE)) {
-                    // Parse style group usage
-                    parseIdentifier();  // Get style group name
-                    match(TokenType::SEMICOLON);
-                } else if (check(TokenType::IDENTIFIER)) {
-                    // Parse property
-                    std::string propName = parseIdentifier();
-                    consume(TokenType::COLON, "Expected ':' after property name");
-                    std::string propValue = parseAttributeValue();
+                if (check(TokenType::KEYWORD_DELETE)) {
+                    // delete 属性, ...; 或 delete @Style 样式组;
+                    auto deleteNode = std::make_shared<DeleteNode>(current_->getLocation());
+                    advance();
+                    do {
+                        if (match(TokenType::TYPE_STYLE)) {
+                            deleteNode->addDeleteItem("@Style " + parseIdentifier());
+                        } else {
+                            deleteNode->addDeleteItem(parseIdentifier());
+                        }
+                    } while (match(TokenType::COMMA));
                     match(TokenType::SEMICOLON);
-                    
-                    auto prop = std::make_shared<PropertyNode>(propName, propValue, current_->getLocation());
-                    styleNode->addRule(prop);
+                    styleNode->addRule(deleteNode);
+                } else if (match(TokenType::KEYWORD_INHERIT) || check(TokenType::TYPE_STYLE)) {
+                    // 继承/组合样式组
+                    auto use = parseTemplateUse();
+                    if (use) {
+                        styleNode->addRule(use);
+                    }
+                } else if (check(TokenType::IDENTIFIER) || check(TokenType::HTML_TAG)) {
+                    // 属性值与样式组模板一样按CSS值解析（20px、#fff等）
+                    auto prop = parseCSSProperty();
+                    if (prop) {
+                        styleNode->addRule(prop);
+                    }
                 } else {
                     advance();
                 }
@@ -1232,39 +1357,35 @@ std::shared_ptr<ASTNode> Parser::parseCustomContent(CustomType type) {
             return nullptr;  // Return null if no element found
         }
         
-        case CustomType::VAR: {
-            // Parse variable custom content
-            // For now, create a simple container node
-            auto varNode = std::make_shared<ElementNode>("var-container", current_->getLocation());
+        case CustomType::VAR:
+            // 自定义变量组允许只声明变量名（a, b;），使用时再特例化
+            return parseVarGroupContent();
+    }
+    
+    return nullptr;
+}
+
+std::shared_ptr<ElementNode> Parser::parseVarGroupContent() {
+    // 变量存为容器元素的属性，生成器按属性注册变量组
+    auto varNode = std::make_shared<ElementNode>("var-container", current_->getLocation());
+    
+    while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
+        if (check(TokenType::IDENTIFIER) || check(TokenType::HTML_TAG)) {
+            std::string varName = parseIdentifier();
+            std::string varValue;
             
-            while (!check(TokenType::RIGHT_BRACE) && !isAtEnd()) {
-                if (check(TokenType::IDENTIFIER)) {
-                    std::string varName = parseIdentifier();
-                    std::string varValue = "";
-                    
-                    if (match({TokenType::COLON, TokenType::EQUAL})) {
-                        varValue = parseAttributeValue();
-                        match(TokenType::SEMICOLON);
-                    } else if (match(TokenType::COMMA)) {
-                        // Variable without value
-                        continue;
-                    } else if (match(TokenType::SEMICOLON)) {
-                        // Variable without value
-                        continue;
-                    }
-                    
-                    // Store as attribute on the container
-                    varNode->addAttribute(varName, varValue);
-                } else {
-                    advance();
-                }
+            // 值按CSS值解析，rgb(...)、20px等保持完整
+            if (match({TokenType::COLON, TokenType::EQUAL})) {
+                varValue = parseCSSValue();
             }
-            
-            return varNode;
+            match({TokenType::SEMICOLON, TokenType::COMMA});
+            varNode->addAttribute(varName, varValue);
+        } else {
+            advance();
         }
     }
     
-    return nullptr;
+    return varNode;
 }
 
 std::shared_ptr<ASTNode> Parser::parseExceptConstraint() {
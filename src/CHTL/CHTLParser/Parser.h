@@ -26,6 +26,24 @@ struct ParserConfig {
     bool enableCEEquivalence = true;       // 启用CE对等式
 };
 
+// 解析记录器
+// 增量解析用它记录解析时读入的Token流、可独立重解析的块和错误位置
+class ParseRecorder {
+public:
+    virtual ~ParseRecorder() = default;
+    
+    // 解析器读入新的当前Token，序号从0开始连续递增
+    virtual void onToken(const std::shared_ptr<Token>& token) = 0;
+    
+    // 块（元素、style、script、[Template]、[Custom]）node是container的直接子节点，
+    // 由第firstToken到第lastToken个Token组成；stateDepth为开始解析时的状态栈深度
+    virtual void onBlock(const ASTNode* container, const std::shared_ptr<ASTNode>& node,
+                         size_t firstToken, size_t lastToken, size_t stateDepth) = 0;
+    
+    // 解析错误，offset为出错时当前Token的偏移
+    virtual void onError(const std::string& message, size_t offset) = 0;
+};
+
 // CHTL解析器
 class Parser {
 public:
@@ -36,6 +54,13 @@ public:
     // 解析整个程序
     std::shared_ptr<ProgramNode> parse();
     
+    // 解析当前位置的一个块，外层有enclosingElements层元素（0表示顶层）
+    // 供增量解析使用；解析失败时返回nullptr，错误已记录
+    std::shared_ptr<ASTNode> parseBlock(size_t enclosingElements);
+    
+    // 设置解析记录器，当前Token立即作为第0个Token记录
+    void setRecorder(ParseRecorder* recorder);
+    
     // 获取解析错误
     const std::vector<std::string>& getErrors() const { return errors_; }
     bool hasErrors() const { return !errors_.empty(); }
@@ -50,6 +75,12 @@ private:
     std::shared_ptr<Token> current_;
     std::shared_ptr<Token> previous_;
     
+    // 增量解析记录
+    ParseRecorder* recorder_ = nullptr;
+    size_t tokenCount_ = 0;     // 已读入的Token数，当前Token的序号为tokenCount_ - 1
+    void recordBlock(const ASTNode* container, const std::shared_ptr<ASTNode>& node,
+                     size_t firstToken, size_t stateDepth);
+    
     // Token操作
     void advance();
     bool check(TokenType type) const;
@@ -99,6 +130,7 @@ private:
     // 模板和自定义解析
     std::shared_ptr<ASTNode> parseTemplateContent(TemplateType type);
     std::shared_ptr<ASTNode> parseCustomContent(CustomType type);
+    std::shared_ptr<ElementNode> parseVarGroupContent();
     std::shared_ptr<ASTNode> parseTemplateUse();
     std::shared_ptr<ASTNode> parseCustomUse();
     
@@ -1,162 +1,57 @@
 #include "State.h"
 #include <sstream>
-#include <algorithm>
 
 namespace CHTL {
 
-// 初始化状态转换规则
-const std::unordered_map<StateType, std::vector<StateType>> StateManager::transitionRules_ = 
-    StateManager::initTransitionRules();
-
-std::unordered_map<StateType, std::vector<StateType>> StateManager::initTransitionRules() {
-    std::unordered_map<StateType, std::vector<StateType>> rules;
-    
-    // 全局状态可以转换到的状态
-    rules[StateType::GLOBAL] = {
-        StateType::IN_NAMESPACE,
-        StateType::IN_CONFIGURATION,
-        StateType::IN_TEMPLATE,
-        StateType::IN_CUSTOM,
-        StateType::IN_ORIGIN,
-        StateType::IN_ELEMENT,
-        StateType::IN_IMPORT,
-        StateType::IN_USE,
-        StateType::IN_COMMENT,
-        StateType::IN_STYLE_BLOCK,  // 全局style
-        StateType::IN_SCRIPT_BLOCK  // 全局script
-    };
-    
-    // 命名空间内可以包含的状态
-    rules[StateType::IN_NAMESPACE] = {
-        StateType::IN_NAMESPACE,     // 嵌套命名空间
-        StateType::IN_TEMPLATE,
-        StateType::IN_CUSTOM,
-        StateType::IN_ORIGIN,
-        StateType::IN_ELEMENT,
-        StateType::IN_EXCEPT_CONSTRAINT,
-        StateType::IN_COMMENT
-    };
-    
-    // 配置组内的状态
-    rules[StateType::IN_CONFIGURATION] = {
-        StateType::IN_ATTRIBUTE,
-        StateType::IN_COMMENT
-    };
-    
-    // 模板内的状态
-    rules[StateType::IN_TEMPLATE] = {
-        StateType::IN_ELEMENT,
-        StateType::IN_STYLE_BLOCK,
-        StateType::IN_ATTRIBUTE,
-        StateType::IN_INHERIT_OPERATION,
-        StateType::IN_COMMENT
-    };
-    
-    // 自定义内的状态
-    rules[StateType::IN_CUSTOM] = {
-        StateType::IN_ELEMENT,
-        StateType::IN_STYLE_BLOCK,
-        StateType::IN_ATTRIBUTE,
-        StateType::IN_INHERIT_OPERATION,
-        StateType::IN_DELETE_OPERATION,
-        StateType::IN_INSERT_OPERATION,
-        StateType::IN_COMMENT
-    };
-    
-    // 元素内的状态
-    rules[StateType::IN_ELEMENT] = {
-        StateType::IN_ELEMENT,       // 嵌套元素
-        StateType::IN_ATTRIBUTE,
-        StateType::IN_STYLE_BLOCK,   // 局部样式块
-        StateType::IN_SCRIPT_BLOCK,  // 局部脚本块
-        StateType::IN_TEXT_BLOCK,
-        StateType::IN_EXCEPT_CONSTRAINT,
-        StateType::IN_COMMENT
-    };
-    
-    // 样式块内的状态
-    rules[StateType::IN_STYLE_BLOCK] = {
-        StateType::IN_STYLE_BLOCK,  // Allow recursive style blocks for now
-        StateType::IN_CLASS_SELECTOR,
-        StateType::IN_ID_SELECTOR,
-        StateType::IN_PSEUDO_SELECTOR,
-        StateType::IN_STYLE_PROPERTY,
-        StateType::IN_INHERIT_OPERATION,
-        StateType::IN_DELETE_OPERATION,
-        StateType::IN_COMMENT
-    };
-    
-    // 类选择器内的状态
-    rules[StateType::IN_CLASS_SELECTOR] = {
-        StateType::IN_STYLE_PROPERTY,
-        StateType::IN_COMMENT
-    };
-    
-    // ID选择器内的状态
-    rules[StateType::IN_ID_SELECTOR] = {
-        StateType::IN_STYLE_PROPERTY,
-        StateType::IN_COMMENT
-    };
-    
-    // 属性定义状态
-    rules[StateType::IN_ATTRIBUTE] = {
-        StateType::IN_ATTRIBUTE_VALUE,
-        StateType::IN_STRING_LITERAL
-    };
-    
-    return rules;
-}
-
 StateManager::StateManager() {
     // 直接添加初始全局状态，不经过转换检查
-    stateStack_.emplace(StateType::GLOBAL, "global", 0, 0);
-}
-
-void StateManager::pushState(StateType type, const std::string& name, 
-                            size_t line, size_t col) {
-    // 验证状态转换是否合法
-    if (!canTransitionTo(type)) {
-        std::stringstream ss;
-        ss << "Invalid state transition from " << static_cast<int>(getCurrentState())
-           << " to " << static_cast<int>(type)
-           << " at line " << line << ", col " << col
-           << " (name: " << name << ")";
-        throw StateException(ss.str());
-    }
-    
-    stateStack_.emplace(type, name, line, col);
+    reset();
 }
 
-void StateManager::popState() {
-    if (stateStack_.size() <= 1) {  // 保留全局状态
-        throw StateException("Cannot pop global state");
-    }
-    stateStack_.pop();
+StateManager::StateManager(const StateManager& other) {
+    *this = other;
 }
 
-StateType StateManager::getCurrentState() const {
-    if (stateStack_.empty()) {
-        return StateType::GLOBAL;
+StateManager& StateManager::operator=(const StateManager& other) {
+    if (this == &other) {
+        return *this;
     }
-    return stateStack_.top().type;
-}
 
-const StateContext* StateManager::getCurrentContext() const {
-    if (stateStack_.empty()) {
-        return nullptr;
+    depth_ = other.depth_;
+    typeCounts_ = other.typeCounts_;
+    nameUsed_ = other.nameUsed_;
+    std::memcpy(names_, other.names_, nameUsed_);
+    for (size_t i = 0; i < depth_; ++i) {
+        stack_[i] = other.stack_[i];
+        size_t offset = static_cast<size_t>(other.stack_[i].name.data() - other.names_);
+        stack_[i].name = std::string_view(names_ + offset, other.stack_[i].name.size());
     }
-    return &stateStack_.top();
+
+    inlineProperties_ = other.inlineProperties_;
+    overflowProperties_ = other.overflowProperties_;
+    propertyCount_ = other.propertyCount_;
+    return *this;
 }
 
-bool StateManager::isInState(StateType type) const {
-    std::stack<StateContext> temp = stateStack_;
-    while (!temp.empty()) {
-        if (temp.top().type == type) {
-            return true;
-        }
-        temp.pop();
-    }
-    return false;
+void StateManager::throwInvalidTransition(StateType type, std::string_view name,
+                                          size_t line, size_t col) const {
+    std::stringstream ss;
+    ss << "Invalid state transition from " << static_cast<int>(getCurrentState())
+       << " to " << static_cast<int>(type)
+       << " at line " << line << ", col " << col
+       << " (name: " << name << ")";
+    throw StateException(ss.str());
+}
+
+void StateManager::throwStackOverflow(StateType type) const {
+    std::stringstream ss;
+    ss << "State stack overflow: cannot enter state " << static_cast<int>(type)
+       << " beyond depth " << MAX_STATE_DEPTH;
+    throw StateException(ss.str());
+}
+
+void StateManager::throwPopGlobal() {
+    throw StateException("Cannot pop global state");
 }
 
 bool StateManager::isInAnyState(std::initializer_list<StateType> types) const {
@@ -169,82 +64,116 @@ bool StateManager::isInAnyState(std::initializer_list<StateType> types) const {
 }
 
 const StateContext* StateManager::findNearestState(StateType type) const {
-    // Cannot return pointer to temporary stack, need to search the original stack
-    // This requires a different approach - we'll need to store states differently
-    // For now, return nullptr - this method needs redesign
-    (void)type; // Suppress unused parameter warning
+    if (!isInState(type)) {
+        return nullptr;
+    }
+    for (size_t i = depth_; i > 0; --i) {
+        if (stack_[i - 1].type == type) {
+            return &stack_[i - 1];
+        }
+    }
     return nullptr;
 }
 
 void StateManager::reset() {
-    // 清空栈
-    while (!stateStack_.empty()) {
-        stateStack_.pop();
-    }
+    depth_ = 0;
+    typeCounts_.fill(0);
+    nameUsed_ = 0;
+    propertyCount_ = 0;
+    overflowProperties_.clear();
+
     // 重新初始化为全局状态
-    pushState(StateType::GLOBAL, "global");
+    StateContext& global = stack_[depth_++];
+    global.type = StateType::GLOBAL;
+    global.name = storeName("global");
+    global.startLine = 0;
+    global.startColumn = 0;
+    ++typeCounts_[static_cast<size_t>(StateType::GLOBAL)];
 }
 
-bool StateManager::canTransitionTo(StateType newState) const {
-    StateType currentState = getCurrentState();
-    
-    auto it = transitionRules_.find(currentState);
-    if (it == transitionRules_.end()) {
-        return false;  // 没有定义转换规则
+std::vector<StateType> StateManager::getAllowedTransitions() const {
+    StateSet allowed = STATE_TRANSITIONS[static_cast<size_t>(getCurrentState())];
+
+    std::vector<StateType> result;
+    for (size_t i = 0; i < STATE_TYPE_COUNT; ++i) {
+        if (allowed.contains(static_cast<StateType>(i))) {
+            result.push_back(static_cast<StateType>(i));
+        }
     }
-    
-    const auto& allowedStates = it->second;
-    return std::find(allowedStates.begin(), allowedStates.end(), newState) != allowedStates.end();
+    return result;
 }
 
-std::vector<StateType> StateManager::getAllowedTransitions() const {
-    StateType currentState = getCurrentState();
-    
-    auto it = transitionRules_.find(currentState);
-    if (it == transitionRules_.end()) {
-        return {};
+StateManager::PropertySlot& StateManager::propertyAt(size_t index) {
+    return index < INLINE_PROPERTY_COUNT ? inlineProperties_[index]
+                                         : overflowProperties_[index - INLINE_PROPERTY_COUNT];
+}
+
+const StateManager::PropertySlot& StateManager::propertyAt(size_t index) const {
+    return index < INLINE_PROPERTY_COUNT ? inlineProperties_[index]
+                                         : overflowProperties_[index - INLINE_PROPERTY_COUNT];
+}
+
+void StateManager::dropProperties() {
+    // 属性按栈深递增排列，弹出的状态的属性都在末尾
+    while (propertyCount_ > 0 && propertyAt(propertyCount_ - 1).depth > depth_) {
+        --propertyCount_;
+    }
+    if (propertyCount_ <= INLINE_PROPERTY_COUNT) {
+        overflowProperties_.clear();
+    } else {
+        overflowProperties_.resize(propertyCount_ - INLINE_PROPERTY_COUNT);
     }
-    
-    return it->second;
 }
 
 void StateManager::setCurrentStateProperty(const std::string& key, const std::string& value) {
-    if (!stateStack_.empty()) {
-        stateStack_.top().setProperty(key, value);
+    // 当前状态的属性在末尾，从后往前找
+    for (size_t i = propertyCount_; i > 0; --i) {
+        PropertySlot& slot = propertyAt(i - 1);
+        if (slot.depth != depth_) {
+            break;
+        }
+        if (slot.key == key) {
+            slot.value = value;
+            return;
+        }
+    }
+
+    if (propertyCount_ >= INLINE_PROPERTY_COUNT) {
+        overflowProperties_.emplace_back();
     }
+    PropertySlot& slot = propertyAt(propertyCount_++);
+    slot.depth = depth_;
+    slot.key = key;
+    slot.value = value;
 }
 
 std::optional<std::string> StateManager::getCurrentStateProperty(const std::string& key) const {
-    if (!stateStack_.empty()) {
-        return stateStack_.top().getProperty(key);
+    for (size_t i = propertyCount_; i > 0; --i) {
+        const PropertySlot& slot = propertyAt(i - 1);
+        if (slot.depth != depth_) {
+            break;
+        }
+        if (slot.key == key) {
+            return slot.value;
+        }
     }
     return std::nullopt;
 }
 
 std::string StateManager::getStatePath() const {
     std::stringstream ss;
-    std::stack<StateContext> temp = stateStack_;
-    std::vector<std::string> path;
-    
-    while (!temp.empty()) {
-        const auto& ctx = temp.top();
-        std::string stateStr = std::to_string(static_cast<int>(ctx.type));
+
+    // 从根到当前
+    for (size_t i = 0; i < depth_; ++i) {
+        const auto& ctx = stack_[i];
+        if (i > 0) ss << " -> ";
+        ss << static_cast<int>(ctx.type);
         if (!ctx.name.empty()) {
-            stateStr += "(" + ctx.name + ")";
+            ss << "(" << ctx.name << ")";
         }
-        path.push_back(stateStr);
-        temp.pop();
     }
-    
-    // 反转路径以正确显示从根到当前的路径
-    std::reverse(path.begin(), path.end());
-    
-    for (size_t i = 0; i < path.size(); ++i) {
-        if (i > 0) ss << " -> ";
-        ss << path[i];
-    }
-    
+
     return ss.str();
 }
 
-} // namespace CHTL
\ No newline at end of file
+} // namespace CHTL
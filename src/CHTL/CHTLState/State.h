@@ -1,11 +1,14 @@
 #ifndef CHTL_STATE_H
 #define CHTL_STATE_H
 
-#include <string>
-#include <memory>
-#include <stack>
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace CHTL {
@@ -55,52 +58,199 @@ enum class StateType {
     IN_COMMENT              // 在注释内
 };
 
-// 状态上下文信息
-struct StateContext {
-    StateType type;
-    std::string name;           // 状态名称（如元素名、选择器名等）
-    size_t startLine;
-    size_t startColumn;
-    std::unordered_map<std::string, std::string> properties;  // 额外属性
-    
-    StateContext(StateType t, const std::string& n = "", 
-                 size_t line = 0, size_t col = 0)
-        : type(t), name(n), startLine(line), startColumn(col) {}
-    
-    void setProperty(const std::string& key, const std::string& value) {
-        properties[key] = value;
-    }
-    
-    std::optional<std::string> getProperty(const std::string& key) const {
-        auto it = properties.find(key);
-        if (it != properties.end()) {
-            return it->second;
+// StateType的数量
+constexpr size_t STATE_TYPE_COUNT = static_cast<size_t>(StateType::IN_COMMENT) + 1;
+
+// 状态集合：每个StateType占一位
+class StateSet {
+public:
+    constexpr StateSet() = default;
+    constexpr StateSet(std::initializer_list<StateType> types) {
+        for (StateType type : types) {
+            bits_ |= bit(type);
         }
-        return std::nullopt;
     }
+    
+    constexpr bool contains(StateType type) const { return (bits_ & bit(type)) != 0; }
+    constexpr bool empty() const { return bits_ == 0; }
+    constexpr uint32_t bits() const { return bits_; }
+    
+private:
+    static constexpr uint32_t bit(StateType type) { return uint32_t(1) << static_cast<uint32_t>(type); }
+    
+    uint32_t bits_ = 0;
 };
 
-// RAII状态管理器
+static_assert(STATE_TYPE_COUNT <= 32, "StateSet holds at most 32 state types");
+
+// 状态转换表：下标为当前状态，值为允许进入的子状态集合，编译期构造
+constexpr std::array<StateSet, STATE_TYPE_COUNT> makeStateTransitionTable() {
+    std::array<StateSet, STATE_TYPE_COUNT> table{};
+    auto rule = [&table](StateType from, StateSet to) { table[static_cast<size_t>(from)] = to; };
+    
+    // 全局状态可以转换到的状态
+    rule(StateType::GLOBAL, {
+        StateType::IN_NAMESPACE,
+        StateType::IN_CONFIGURATION,
+        StateType::IN_TEMPLATE,
+        StateType::IN_CUSTOM,
+        StateType::IN_ORIGIN,
+        StateType::IN_ELEMENT,
+        StateType::IN_IMPORT,
+        StateType::IN_USE,
+        StateType::IN_COMMENT,
+        StateType::IN_STYLE_BLOCK,  // 全局style
+        StateType::IN_SCRIPT_BLOCK  // 全局script
+    });
+    
+    // 命名空间内可以包含的状态
+    rule(StateType::IN_NAMESPACE, {
+        StateType::IN_NAMESPACE,     // 嵌套命名空间
+        StateType::IN_TEMPLATE,
+        StateType::IN_CUSTOM,
+        StateType::IN_ORIGIN,
+        StateType::IN_ELEMENT,
+        StateType::IN_EXCEPT_CONSTRAINT,
+        StateType::IN_COMMENT
+    });
+    
+    // 配置组内的状态
+    rule(StateType::IN_CONFIGURATION, {
+        StateType::IN_ATTRIBUTE,
+        StateType::IN_COMMENT
+    });
+    
+    // 模板内的状态
+    rule(StateType::IN_TEMPLATE, {
+        StateType::IN_ELEMENT,
+        StateType::IN_STYLE_BLOCK,
+        StateType::IN_ATTRIBUTE,
+        StateType::IN_INHERIT_OPERATION,
+        StateType::IN_COMMENT
+    });
+    
+    // 自定义内的状态
+    rule(StateType::IN_CUSTOM, {
+        StateType::IN_ELEMENT,
+        StateType::IN_STYLE_BLOCK,
+        StateType::IN_ATTRIBUTE,
+        StateType::IN_INHERIT_OPERATION,
+        StateType::IN_DELETE_OPERATION,
+        StateType::IN_INSERT_OPERATION,
+        StateType::IN_COMMENT
+    });
+    
+    // 元素内的状态
+    rule(StateType::IN_ELEMENT, {
+        StateType::IN_ELEMENT,       // 嵌套元素
+        StateType::IN_ATTRIBUTE,
+        StateType::IN_STYLE_BLOCK,   // 局部样式块
+        StateType::IN_SCRIPT_BLOCK,  // 局部脚本块
+        StateType::IN_TEXT_BLOCK,
+        StateType::IN_EXCEPT_CONSTRAINT,
+        StateType::IN_COMMENT
+    });
+    
+    // 样式块内的状态
+    rule(StateType::IN_STYLE_BLOCK, {
+        StateType::IN_STYLE_BLOCK,  // Allow recursive style blocks for now
+        StateType::IN_CLASS_SELECTOR,
+        StateType::IN_ID_SELECTOR,
+        StateType::IN_PSEUDO_SELECTOR,
+        StateType::IN_STYLE_PROPERTY,
+        StateType::IN_INHERIT_OPERATION,
+        StateType::IN_DELETE_OPERATION,
+        StateType::IN_COMMENT
+    });
+    
+    // 类选择器内的状态
+    rule(StateType::IN_CLASS_SELECTOR, {
+        StateType::IN_STYLE_PROPERTY,
+        StateType::IN_COMMENT
+    });
+    
+    // ID选择器内的状态
+    rule(StateType::IN_ID_SELECTOR, {
+        StateType::IN_STYLE_PROPERTY,
+        StateType::IN_COMMENT
+    });
+    
+    // 属性定义状态
+    rule(StateType::IN_ATTRIBUTE, {
+        StateType::IN_ATTRIBUTE_VALUE,
+        StateType::IN_STRING_LITERAL
+    });
+    
+    return table;
+}
+
+constexpr std::array<StateSet, STATE_TYPE_COUNT> STATE_TRANSITIONS = makeStateTransitionTable();
+
+// 状态上下文信息
+// name指向StateManager内部的名称缓冲区，在该状态弹出前有效
+struct StateContext {
+    StateType type = StateType::GLOBAL;
+    std::string_view name;      // 状态名称（如元素名、选择器名等）
+    size_t startLine = 0;
+    size_t startColumn = 0;
+};
+
+// 状态管理器
+// 状态栈是定长的内联数组，名称存放在按栈顺序分配的内联缓冲区中，
+// 转换检查查编译期的STATE_TRANSITIONS位集，每种状态在栈中的个数单独计数，
+// 因此pushState/popState/canTransitionTo/isInState都是常数时间且不分配内存。
+// 栈深超过MAX_STATE_DEPTH时抛出StateException；名称缓冲区用尽时截断名称。
 class StateManager {
 public:
+    static constexpr size_t MAX_STATE_DEPTH = 256;
+    static constexpr size_t NAME_BUFFER_SIZE = 4096;
+    static constexpr size_t INLINE_PROPERTY_COUNT = 8;
+    
     StateManager();
     ~StateManager() = default;
     
+    // 拷贝时名称视图改为指向副本自己的缓冲区
+    StateManager(const StateManager& other);
+    StateManager& operator=(const StateManager& other);
+    
     // 进入新状态
-    void pushState(StateType type, const std::string& name = "", 
-                   size_t line = 0, size_t col = 0);
+    void pushState(StateType type, std::string_view name = {},
+                   size_t line = 0, size_t col = 0) {
+        if (!canTransitionTo(type)) {
+            throwInvalidTransition(type, name, line, col);
+        }
+        if (depth_ == MAX_STATE_DEPTH) {
+            throwStackOverflow(type);
+        }
+        StateContext& context = stack_[depth_++];
+        context.type = type;
+        context.name = storeName(name);
+        context.startLine = line;
+        context.startColumn = col;
+        ++typeCounts_[static_cast<size_t>(type)];
+    }
     
     // 退出当前状态
-    void popState();
+    void popState() {
+        if (depth_ <= 1) {  // 保留全局状态
+            throwPopGlobal();
+        }
+        const StateContext& context = stack_[--depth_];
+        --typeCounts_[static_cast<size_t>(context.type)];
+        nameUsed_ = static_cast<size_t>(context.name.data() - names_);
+        if (propertyCount_ > 0) {
+            dropProperties();
+        }
+    }
     
     // 获取当前状态
-    StateType getCurrentState() const;
+    StateType getCurrentState() const { return stack_[depth_ - 1].type; }
     
     // 获取当前状态上下文
-    const StateContext* getCurrentContext() const;
+    const StateContext* getCurrentContext() const { return &stack_[depth_ - 1]; }
     
     // 检查是否在特定状态
-    bool isInState(StateType type) const;
+    bool isInState(StateType type) const { return typeCounts_[static_cast<size_t>(type)] != 0; }
     
     // 检查是否在任一指定状态
     bool isInAnyState(std::initializer_list<StateType> types) const;
@@ -109,18 +259,21 @@ public:
     const StateContext* findNearestState(StateType type) const;
     
     // 获取状态栈深度
-    size_t getStackDepth() const { return stateStack_.size(); }
+    size_t getStackDepth() const { return depth_; }
     
     // 清空状态栈
     void reset();
     
     // 验证状态转换是否合法
-    bool canTransitionTo(StateType newState) const;
+    bool canTransitionTo(StateType newState) const {
+        return STATE_TRANSITIONS[static_cast<size_t>(getCurrentState())].contains(newState);
+    }
     
     // 获取当前允许的操作
     std::vector<StateType> getAllowedTransitions() const;
     
     // 状态属性管理
+    // 前INLINE_PROPERTY_COUNT个属性存放在内联槽位中，槽位随状态弹出复用
     void setCurrentStateProperty(const std::string& key, const std::string& value);
     std::optional<std::string> getCurrentStateProperty(const std::string& key) const;
     
@@ -128,13 +281,42 @@ public:
     std::string getStatePath() const;
 
 private:
-    std::stack<StateContext> stateStack_;
+    // 属性所属的状态以栈深标识；后进入的状态的属性总在后面
+    struct PropertySlot {
+        size_t depth = 0;
+        std::string key;
+        std::string value;
+    };
+    
+    std::string_view storeName(std::string_view name) {
+        size_t length = std::min(name.size(), NAME_BUFFER_SIZE - nameUsed_);
+        char* begin = names_ + nameUsed_;
+        if (length > 0) {
+            std::memcpy(begin, name.data(), length);
+        }
+        nameUsed_ += length;
+        return std::string_view(begin, length);
+    }
+    
+    PropertySlot& propertyAt(size_t index);
+    const PropertySlot& propertyAt(size_t index) const;
+    void dropProperties();
+    
+    [[noreturn]] void throwInvalidTransition(StateType type, std::string_view name,
+                                             size_t line, size_t col) const;
+    [[noreturn]] void throwStackOverflow(StateType type) const;
+    [[noreturn]] static void throwPopGlobal();
+    
+    std::array<StateContext, MAX_STATE_DEPTH> stack_;
+    size_t depth_ = 0;
+    std::array<uint32_t, STATE_TYPE_COUNT> typeCounts_{};
     
-    // 状态转换规则
-    static const std::unordered_map<StateType, std::vector<StateType>> transitionRules_;
+    char names_[NAME_BUFFER_SIZE];
+    size_t nameUsed_ = 0;
     
-    // 初始化状态转换规则
-    static std::unordered_map<StateType, std::vector<StateType>> initTransitionRules();
+    std::array<PropertySlot, INLINE_PROPERTY_COUNT> inlineProperties_;
+    std::vector<PropertySlot> overflowProperties_;
+    size_t propertyCount_ = 0;
 };
 
 // RAII状态守卫
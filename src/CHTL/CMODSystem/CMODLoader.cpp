@@ -4,9 +4,12 @@
 #include "../CHTLParser/Parser.h"
 #include "../CHTLLexer/Lexer.h"
 #include "../../Error/ErrorReport.h"
+#include "../../Util/ZIPUtil/ZIPUtil.h"
+#include "../CHTLLoader/ModuleIndex.h"
 #include <filesystem>
 #include <fstream>
 #include <algorithm>
+#include <sstream>
 
 namespace CHTL {
 
@@ -19,7 +22,7 @@ CMODLoader::CMODLoader(std::shared_ptr<CompileContext> context)
         // 尝试从编译器路径推导官方模块路径
         auto execPath = fs::current_path();
         auto modulePath = execPath / "module";
-        if (fs::exists(modulePath)) {
+        if (ModuleIndex::getInstance().exists(modulePath.string())) {
             config_.officialModulePath = modulePath.string();
         }
     }
@@ -47,18 +50,24 @@ bool CMODLoader::loadModule(const std::string& modulePath) {
     // 判断是CMOD还是CHTL文件
     std::string pathStr = foundPath.value();
     if (pathStr.size() > 5 && pathStr.substr(pathStr.size() - 5) == ".cmod") {
-        // 提取CMOD到缓存
-        std::string extractPath;
-        if (!extractCMOD(foundPath.value(), extractPath)) {
-            currentLoadingChain_.pop_back();
-            return false;
-        }
-        
         // 获取模块名
         std::string moduleName = fs::path(modulePath).stem().string();
         
-        // 加载解压后的模块
-        result = loadExtractedModule(extractPath, moduleName);
+        // 优先直接读取映射的CMOD，无法映射时回退到解压
+        auto archive = config_.useMappedArchives ? std::make_shared<ZIPArchiveView>() : nullptr;
+        if (archive && archive->open(foundPath.value())) {
+            result = loadMappedModule(archive, foundPath.value(), moduleName);
+        } else {
+            // 提取CMOD到缓存
+            std::string extractPath;
+            if (!extractCMOD(foundPath.value(), extractPath)) {
+                currentLoadingChain_.pop_back();
+                return false;
+            }
+            
+            // 加载解压后的模块
+            result = loadExtractedModule(extractPath, moduleName);
+        }
     } else if (pathStr.size() > 5 && pathStr.substr(pathStr.size() - 5) == ".chtl") {
         // 直接加载CHTL文件
         result = loadCHTLFile(foundPath.value());
@@ -72,7 +81,7 @@ bool CMODLoader::loadModule(const std::string& modulePath) {
 
 bool CMODLoader::loadCHTLFile(const std::string& chtlPath) {
     // 检查文件是否存在
-    if (!fs::exists(chtlPath)) {
+    if (!ModuleIndex::getInstance().exists(chtlPath)) {
         lastError_ = "CHTL file not found: " + chtlPath;
         return false;
     }
@@ -102,7 +111,7 @@ bool CMODLoader::loadCHTLFile(const std::string& chtlPath) {
 }
 
 bool CMODLoader::loadFromDirectory(const std::string& dir) {
-    if (!fs::exists(dir) || !fs::is_directory(dir)) {
+    if (!ModuleIndex::getInstance().isDirectory(dir)) {
         lastError_ = "Invalid directory: " + dir;
         return false;
     }
@@ -156,7 +165,7 @@ std::optional<std::string> CMODLoader::findModule(const std::string& moduleName)
     auto searchPaths = getModuleSearchPaths(moduleName);
     
     for (const auto& path : searchPaths) {
-        if (fs::exists(path)) {
+        if (ModuleIndex::getInstance().exists(path)) {
             return path;
         }
     }
@@ -192,6 +201,40 @@ std::vector<std::string> CMODLoader::getLoadedModules() const {
     return modules;
 }
 
+std::optional<std::string_view> CMODLoader::getModuleSource(const std::string& moduleName,
+                                                            const std::string& entryPath) {
+    auto it = loadedModules_.find(moduleName);
+    if (it == loadedModules_.end()) {
+        lastError_ = "Module not loaded: " + moduleName;
+        return std::nullopt;
+    }
+    LoadedModule& module = it->second;
+    
+    // 映射的CMOD：按需解压
+    if (module.archive) {
+        auto content = module.archive->getEntry(entryPath);
+        if (!content) {
+            lastError_ = module.archive->getLastError();
+        }
+        return content;
+    }
+    
+    // 已解压或目录模块：读入后缓存
+    auto cached = module.sourceCache.find(entryPath);
+    if (cached != module.sourceCache.end()) {
+        return std::string_view(cached->second);
+    }
+    
+    fs::path basePath = fs::is_directory(module.sourcePath) ? fs::path(module.sourcePath) : fs::path(module.sourcePath).parent_path();
+    auto content = File::readToString((basePath / entryPath).string());
+    if (!content) {
+        lastError_ = "File not found in module " + moduleName + ": " + entryPath;
+        return std::nullopt;
+    }
+    auto inserted = module.sourceCache.emplace(entryPath, std::move(*content));
+    return std::string_view(inserted.first->second);
+}
+
 bool CMODLoader::extractCMOD(const std::string& cmodPath, std::string& extractPath) {
     // 创建缓存目录
     if (!fs::exists(config_.cacheDirectory)) {
@@ -224,19 +267,12 @@ bool CMODLoader::loadExtractedModule(const std::string& extractPath, const std::
     }
     
     // 获取模块信息
-    CMODPackager packager;
-    auto infoPath = fs::path(extractPath) / "info" / "module.info";
-    
-    CMODInfo info;
-    // 这里需要解析info文件
-    // 暂时创建基本信息
-    info.name = moduleName;
-    
-    // 处理依赖
-    if (config_.autoExtractDependencies && !info.dependencies.empty()) {
-        if (!processModuleDependencies(info)) {
-            return false;
-        }
+    LoadedModule module;
+    module.info.name = moduleName;
+    auto infoContent = File::readToString((fs::path(extractPath) / "info" / "module.info").string());
+    auto exportContent = File::readToString((fs::path(extractPath) / "info" / "export.info").string());
+    if (!readModuleMetadata(infoContent.value_or(""), exportContent.value_or(""), module)) {
+        return false;
     }
     
     // 加载源文件
@@ -252,27 +288,101 @@ bool CMODLoader::loadExtractedModule(const std::string& extractPath, const std::
     }
     
     // 记录已加载模块
-    LoadedModule module;
-    module.info = info;
     module.sourcePath = extractPath;
     module.isCMOD = true;
     
-    loadedModules_[moduleName] = module;
+    loadedModules_[moduleName] = std::move(module);
     
     return true;
 }
 
-bool CMODLoader::processCHTLFile(const std::string& chtlPath) {
-    try {
-        // 读取文件内容
-        auto contentOpt = File::readToString(chtlPath);
-        if (!contentOpt) {
-            lastError_ = "Failed to read CHTL file: " + chtlPath;
-            return false;
+bool CMODLoader::loadMappedModule(std::shared_ptr<ZIPArchiveView> archive, const std::string& cmodPath,
+                                  const std::string& moduleName) {
+    // 检查是否已加载
+    if (isModuleLoaded(moduleName)) {
+        return true;
+    }
+    
+    // 获取模块信息（只解压info条目）
+    LoadedModule module;
+    module.info.name = moduleName;
+    auto infoContent = archive->getEntry("info/module.info");
+    auto exportContent = archive->getEntry("info/export.info");
+    if (!readModuleMetadata(std::string(infoContent.value_or("")), std::string(exportContent.value_or("")), module)) {
+        return false;
+    }
+    
+    // 加载src下的主模块源文件（与解压路径一致，不含子目录）；其余条目在getModuleSource时才解压
+    for (const auto& file : archive->getFileList()) {
+        std::string_view name(file.filename);
+        if (file.isDirectory || name.compare(0, 4, "src/") != 0 ||
+            name.find('/', 4) != std::string_view::npos ||
+            fs::path(file.filename).extension() != ".chtl") {
+            continue;
         }
         
-        // 创建词法分析器
-        auto lexer = std::make_shared<Lexer>(contentOpt.value(), context_);
+        auto source = archive->getEntry(file.filename);
+        if (!source) {
+            lastError_ = archive->getLastError();
+            return false;
+        }
+        if (!processCHTLSource(*source, cmodPath + ":" + file.filename)) {
+            return false;
+        }
+    }
+    
+    // 记录已加载模块
+    module.sourcePath = cmodPath;
+    module.isCMOD = true;
+    module.archive = archive;
+    
+    loadedModules_[moduleName] = std::move(module);
+    
+    return true;
+}
+
+bool CMODLoader::readModuleMetadata(const std::string& infoContent, const std::string& exportContent,
+                                    LoadedModule& module) {
+    CMODPackager packager;
+    
+    // 解析info文件；格式不完整时保留基本信息
+    if (!infoContent.empty()) {
+        CMODInfo info;
+        if (packager.parseInfoContent(infoContent, info)) {
+            module.info = info;
+        }
+    }
+    
+    if (!exportContent.empty()) {
+        packager.parseExportInfo(exportContent, module.exports);
+    }
+    
+    // 处理依赖
+    if (config_.autoExtractDependencies && !module.info.dependencies.empty()) {
+        if (!processModuleDependencies(module.info)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool CMODLoader::processCHTLFile(const std::string& chtlPath) {
+    // 读取文件内容
+    auto contentOpt = File::readToString(chtlPath);
+    if (!contentOpt) {
+        lastError_ = "Failed to read CHTL file: " + chtlPath;
+        return false;
+    }
+    
+    return processCHTLSource(contentOpt.value(), chtlPath);
+}
+
+bool CMODLoader::processCHTLSource(std::string_view source, const std::string& sourceName) {
+    try {
+        // 创建词法分析器（借用源码缓冲区，不复制）
+        TokenArena arena;
+        auto lexer = std::make_shared<Lexer>(source, arena, context_);
         
         // 创建解析器
         Parser parser(lexer, context_);
@@ -280,7 +390,7 @@ bool CMODLoader::processCHTLFile(const std::string& chtlPath) {
         // 解析文件
         auto ast = parser.parse();
         if (!ast) {
-            lastError_ = "Failed to parse CHTL file: " + chtlPath;
+            lastError_ = "Failed to parse CHTL file: " + sourceName;
             return false;
         }
         
@@ -339,24 +449,26 @@ std::string CMODLoader::resolveModulePath(const std::string& moduleName, ModuleS
             return moduleName;  // 已经是绝对路径
     }
     
+    auto& index = ModuleIndex::getInstance();
+    
     // 根据module文件夹结构类型处理
     if (searchPath == ModuleSearchPath::OFFICIAL || searchPath == ModuleSearchPath::LOCAL) {
         // 检查是否有分类结构
         auto cmodDir = basePath / "CMOD";
         auto cjmodDir = basePath / "CJMOD";
         
-        if (fs::exists(cmodDir) || fs::exists(cjmodDir)) {
+        if (index.exists(cmodDir.string()) || index.exists(cjmodDir.string())) {
             // 分类结构
-            if (fs::exists(cmodDir)) {
+            if (index.exists(cmodDir.string())) {
                 // 先查找.cmod文件
                 auto cmodPath = cmodDir / (moduleName + ".cmod");
-                if (fs::exists(cmodPath)) {
+                if (index.exists(cmodPath.string())) {
                     return cmodPath.string();
                 }
                 
                 // 再查找.chtl文件
                 auto chtlPath = cmodDir / (moduleName + ".chtl");
-                if (fs::exists(chtlPath)) {
+                if (index.exists(chtlPath.string())) {
                     return chtlPath.string();
                 }
             }
@@ -364,25 +476,25 @@ std::string CMODLoader::resolveModulePath(const std::string& moduleName, ModuleS
             // 混杂结构
             // 优先.cmod
             auto cmodPath = basePath / (moduleName + ".cmod");
-            if (fs::exists(cmodPath)) {
+            if (index.exists(cmodPath.string())) {
                 return cmodPath.string();
             }
             
             // 其次.chtl
             auto chtlPath = basePath / (moduleName + ".chtl");
-            if (fs::exists(chtlPath)) {
+            if (index.exists(chtlPath.string())) {
                 return chtlPath.string();
             }
         }
     } else {
         // 当前目录只查找.cmod和.chtl
         auto cmodPath = basePath / (moduleName + ".cmod");
-        if (fs::exists(cmodPath)) {
+        if (index.exists(cmodPath.string())) {
             return cmodPath.string();
         }
         
         auto chtlPath = basePath / (moduleName + ".chtl");
-        if (fs::exists(chtlPath)) {
+        if (index.exists(chtlPath.string())) {
             return chtlPath.string();
         }
     }
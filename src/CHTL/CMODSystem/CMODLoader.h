@@ -6,6 +6,7 @@
 #include <vector>
 #include <unordered_map>
 #include <optional>
+#include <string_view>
 #include "CMODPackager.h"
 
 namespace CHTL {
@@ -13,11 +14,13 @@ namespace CHTL {
 // Forward declarations
 class CompileContext;
 class ASTNode;
+class ZIPArchiveView;
 
 // CMOD加载配置
 struct CMODLoadConfig {
     bool autoExtractDependencies = true;   // 自动解压依赖
     bool cacheExtractedModules = true;     // 缓存已解压的模块
+    bool useMappedArchives = true;         // 直接从映射的CMOD读取，失败时回退到解压
     std::string cacheDirectory = ".cmod_cache"; // 缓存目录
     std::string officialModulePath = "";   // 官方模块路径
 };
@@ -66,6 +69,10 @@ public:
     // 获取所有已加载的模块名
     std::vector<std::string> getLoadedModules() const;
     
+    // 读取模块中的文件（如"src/Sub.chtl"）
+    // 映射的CMOD只在此时解压该条目；返回的string_view在加载器销毁前有效
+    std::optional<std::string_view> getModuleSource(const std::string& moduleName, const std::string& entryPath);
+    
 private:
     std::shared_ptr<CompileContext> context_;
     CMODLoadConfig config_;
@@ -77,6 +84,8 @@ private:
         CMODExport exports;
         std::string sourcePath;
         bool isCMOD;  // true for CMOD, false for CHTL
+        std::shared_ptr<ZIPArchiveView> archive;  // 映射的CMOD（已解压的模块为空）
+        std::unordered_map<std::string, std::string> sourceCache;  // 已解压模块读入的文件
     };
     std::unordered_map<std::string, LoadedModule> loadedModules_;
     
@@ -86,7 +95,11 @@ private:
     // 内部方法
     bool extractCMOD(const std::string& cmodPath, std::string& extractPath);
     bool loadExtractedModule(const std::string& extractPath, const std::string& moduleName);
+    bool loadMappedModule(std::shared_ptr<ZIPArchiveView> archive, const std::string& cmodPath,
+                          const std::string& moduleName);
+    bool readModuleMetadata(const std::string& infoContent, const std::string& exportContent, LoadedModule& module);
     bool processCHTLFile(const std::string& chtlPath);
+    bool processCHTLSource(std::string_view source, const std::string& sourceName);
     bool processModuleDependencies(const CMODInfo& info);
     
     // 路径解析
@@ -71,61 +71,51 @@ bool CMODPackager::validateStructure(const std::string& sourceDir) {
 }
 
 std::optional<CMODInfo> CMODPackager::getInfo(const std::string& cmodFile) {
-    // 临时解压目录
-    std::string tempDir = fs::temp_directory_path() / "cmod_temp";
-    createDirectory(tempDir);
+    // 直接从映射的包中读取info文件
+    ZIPArchiveView archive;
+    if (!archive.open(cmodFile)) {
+        lastError_ = archive.getLastError();
+        return std::nullopt;
+    }
     
-    // 解压info文件
-    ZIPUtil zip;
-    if (!zip.extractFile(cmodFile, "info/module.info", tempDir + "/module.info")) {
+    auto content = archive.getEntry("info/module.info");
+    if (!content) {
         lastError_ = "Failed to extract module info";
-        fs::remove_all(tempDir);
         return std::nullopt;
     }
     
-    // 解析info文件
+    // 解析info内容
     CMODInfo info;
-    if (!parseInfoFile(tempDir + "/module.info", info)) {
-        fs::remove_all(tempDir);
+    if (!parseInfoContent(std::string(*content), info)) {
         return std::nullopt;
     }
     
-    // 清理临时文件
-    fs::remove_all(tempDir);
-    
     return info;
 }
 
 std::optional<CMODExport> CMODPackager::getExports(const std::string& cmodFile) {
-    // 临时解压目录
-    std::string tempDir = fs::temp_directory_path() / "cmod_temp";
-    createDirectory(tempDir);
+    // 直接从映射的包中读取export文件
+    ZIPArchiveView archive;
+    if (!archive.open(cmodFile)) {
+        lastError_ = archive.getLastError();
+        return std::nullopt;
+    }
     
-    // 解压export文件
-    ZIPUtil zip;
-    if (!zip.extractFile(cmodFile, "info/export.info", tempDir + "/export.info")) {
+    auto content = archive.getEntry("info/export.info");
+    if (!content) {
         lastError_ = "Failed to extract export info";
-        fs::remove_all(tempDir);
         return std::nullopt;
     }
-    
-    // 读取export文件内容
-    std::string content = readFile(tempDir + "/export.info");
-    if (content.empty()) {
-        fs::remove_all(tempDir);
+    if (content->empty()) {
         return std::nullopt;
     }
     
     // 解析export信息
     CMODExport exports;
-    if (!parseExportInfo(content, exports)) {
-        fs::remove_all(tempDir);
+    if (!parseExportInfo(std::string(*content), exports)) {
         return std::nullopt;
     }
     
-    // 清理临时文件
-    fs::remove_all(tempDir);
-    
     return exports;
 }
 
@@ -229,8 +219,15 @@ bool CMODPackager::parseInfoFile(const std::string& infoPath, CMODInfo& info) {
         return false;
     }
     
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parseInfoContent(buffer.str(), info);
+}
+
+bool CMODPackager::parseInfoContent(const std::string& content, CMODInfo& info) {
+    std::istringstream stream(content);
     std::string line;
-    while (std::getline(file, line)) {
+    while (std::getline(stream, line)) {
         // 移除前后空白
         line.erase(0, line.find_first_not_of(" \t"));
         line.erase(line.find_last_not_of(" \t") + 1);
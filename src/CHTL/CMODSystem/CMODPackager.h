@@ -93,6 +93,10 @@ public:
     // 分析目录（供CMODLoader使用）
     bool analyzeDirectory(const std::string& dir, CMODStructure& structure);
     
+    // 从内存解析info/export内容（供CMODLoader直接读取映射的包使用）
+    bool parseInfoContent(const std::string& content, CMODInfo& info);
+    bool parseExportInfo(const std::string& content, CMODExport& exports);
+    
 private:
     int compressionLevel_ = 6;
     std::string lastError_;
@@ -100,7 +104,6 @@ private:
     // 内部方法
     bool validateModuleStructure(const CMODStructure& structure);
     bool parseInfoFile(const std::string& infoPath, CMODInfo& info);
-    bool parseExportInfo(const std::string& content, CMODExport& exports);
     
     // 文件操作
     bool createZipArchive(const CMODStructure& structure, const std::string& outputFile);
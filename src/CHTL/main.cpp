@@ -4,14 +4,19 @@
 #include <cstring>
 #include <thread>
 #include <chrono>
+#include <unordered_set>
 #include "../CompilerDispatcher/CompilerDispatcher.h"
+#include "../CompilerDispatcher/CompileCache.h"
 #include "../CHTL/CHTLIOStream/CHTLFileSystem.h"
+#include "../CHTL/CHTLLoader/ImportResolver.h"
+#include "../CHTL/CHTLLoader/ModuleIndex.h"
 #include "../Error/ErrorReport.h"
+#include "../CompilerDispatcher/CompileServer.h"
 #include "../Test/CompilationMonitor/CompilationMonitor.h"
 
 void printUsage(const char* program) {
     std::cout << "CHTL Compiler v1.0.0\n";
-    std::cout << "Usage: " << program << " [options] <input-file>\n";
+    std::cout << "Usage: " << program << " [options] <input-file> [pages...]\n";
     std::cout << "Options:\n";
     std::cout << "  -o <file>          Output file (default: output.html)\n";
     std::cout << "  -d <dir>           Output directory (default: ./)\n";
@@ -20,7 +25,13 @@ void printUsage(const char* program) {
     std::cout << "  --source-map       Generate source map\n";
     std::cout << "  --target <version> JavaScript target version (ES5, ES6, etc.)\n";
     std::cout << "  --module <system>  Module system (ESM, CommonJS, AMD)\n";
-    std::cout << "  --watch            Watch for file changes\n";
+    std::cout << "  --watch            Watch for file changes, rebuild pages importing them\n";
+    std::cout << "  --debounce <ms>    Coalesce changes within window (default: 100)\n";
+    std::cout << "  --cache-dir <dir>  Reuse results of unchanged pages across runs\n";
+    std::cout << "  --module-dir <dir> Directory searched for official (chtl::) modules\n";
+    std::cout << "  --pipeline         Compile fragment types concurrently while scanning\n";
+    std::cout << "  --server           Serve compile/validate requests as JSON-RPC over stdio\n";
+    std::cout << "  --jobs <n>         Concurrent requests in server mode (default: CPU count)\n";
     std::cout << "  --strict           Enable strict mode\n";
     std::cout << "  --debug            Enable debug output\n";
     std::cout << "  -v, --version      Show version\n";
@@ -57,8 +68,12 @@ int main(int argc, char* argv[]) {
     // 解析命令行参数
     CompileOptions options;
     std::string inputFile;
+    std::vector<std::string> extraPages;  // 监视模式下的其他页面
     bool watch = false;
+    int debounceMs = 100;
     bool debug = false;
+    bool serverMode = false;
+    size_t serverJobs = 0;
     
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -89,6 +104,24 @@ int main(int argc, char* argv[]) {
         else if (arg == "--watch") {
             watch = true;
         }
+        else if (arg == "--debounce" && i + 1 < argc) {
+            debounceMs = std::stoi(argv[++i]);
+        }
+        else if (arg == "--cache-dir" && i + 1 < argc) {
+            options.cacheDir = argv[++i];
+        }
+        else if (arg == "--module-dir" && i + 1 < argc) {
+            options.officialModuleDir = argv[++i];
+        }
+        else if (arg == "--pipeline") {
+            options.pipelineFragments = true;
+        }
+        else if (arg == "--server") {
+            serverMode = true;
+        }
+        else if (arg == "--jobs" && i + 1 < argc) {
+            serverJobs = static_cast<size_t>(std::stoul(argv[++i]));
+        }
         else if (arg == "--strict") {
             options.customConfig["strict"] = "true";
         }
@@ -97,7 +130,7 @@ int main(int argc, char* argv[]) {
             options.enableDebugInfo = true;
         }
         else if (arg == "-v" || arg == "--version") {
-            std::cout << "CHTL Compiler v1.0.0\n";
+            std::cout << "CHTL Compiler v" CHTL_COMPILER_VERSION "\n";
             return 0;
         }
         else if (arg == "-h" || arg == "--help") {
@@ -105,7 +138,11 @@ int main(int argc, char* argv[]) {
             return 0;
         }
         else if (arg[0] != '-') {
-            inputFile = arg;
+            if (inputFile.empty()) {
+                inputFile = arg;
+            } else {
+                extraPages.push_back(arg);
+            }
         }
         else {
             ErrorBuilder(ErrorLevel::ERROR, ErrorType::SYNTAX_ERROR)
@@ -116,6 +153,17 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (serverMode) {
+        // 服务进程常驻，不受单次编译的超时限制
+        compilationMonitor.stop();
+        try {
+            return runCompileServer(std::cin, std::cout, options, serverJobs);
+        } catch (const std::exception& e) {
+            ErrorReport::getInstance().fatal(std::string("Compile server failed: ") + e.what());
+            return 1;
+        }
+    }
+    
     if (inputFile.empty()) {
         ErrorBuilder(ErrorLevel::ERROR, ErrorType::SYNTAX_ERROR)
             .withMessage("No input file specified")
@@ -178,32 +226,100 @@ int main(int argc, char* argv[]) {
             if (debug) {
                 std::cout << "Processed " << result.processedFragments << " fragments\n";
                 std::cout << "Compilation time: " << result.compilationTime << " ms\n";
+                if (auto cache = dispatcher->getCache()) {
+                    auto stats = cache->getStats();
+                    std::cout << "Cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+                              << stats.entries << " entries (" << stats.totalBytes << " bytes)\n";
+                }
+                std::cout << ModuleIndex::getInstance().getStatsReport();
             }
             
             // Watch模式
             if (watch) {
-                std::cout << "Watching for changes... (Press Ctrl+C to stop)\n";
+                // 每个页面单独的输出文件
+                auto compilePage = [&](const std::string& page) {
+                    CompileOptions pageOptions = options;
+                    if (page != inputFile) {
+                        pageOptions.outputFile = PathUtil::replaceExtension(PathUtil::filename(page), ".html");
+                        if (!options.outputDir.empty()) {
+                            pageOptions.outputFile = PathUtil::join(options.outputDir, pageOptions.outputFile);
+                        }
+                    }
+                    dispatcher->setOptions(pageOptions);
+                    
+                    std::cout << "Recompiling " << page << "...\n";
+                    auto watchResult = dispatcher->compile(page);
+                    if (watchResult.success) {
+                        std::cout << "Recompilation successful!\n";
+                    } else {
+                        ErrorReport::getInstance().error("Recompilation failed: " + page);
+                        for (const auto& error : watchResult.errors) {
+                            ErrorReport::getInstance().error(error);
+                        }
+                    }
+                };
+                
+                std::vector<std::string> pages;
+                pages.push_back(PathUtil::normalize(PathUtil::absolute(inputFile)));
+                for (const auto& page : extraPages) {
+                    pages.push_back(PathUtil::normalize(PathUtil::absolute(page)));
+                    compilePage(pages.back());
+                }
+                
+                // 导入图：文件变化时只重编译传递地导入了它的页面
+                ImportResolverConfig resolverConfig;
+                resolverConfig.officialModuleDir = options.officialModuleDir;
+                resolverConfig.currentDir = PathUtil::parent(pages.front());
+                ImportResolver resolver(resolverConfig);
                 
                 FileWatcher watcher;
-                watcher.addPath(inputFile);
-                watcher.setCallback([&](const std::string& path, FileType type) {
-                    if (type == FileType::Regular) {
+                watcher.setDebounceInterval(std::chrono::milliseconds(debounceMs));
+                
+                // 监视页面及其导入闭包中每个文件
+                auto watchImportClosure = [&](const std::string& page) {
+                    resolver.scanImports(page);
+                    std::vector<std::string> toVisit = {page};
+                    std::unordered_set<std::string> visited;
+                    while (!toVisit.empty()) {
+                        std::string file = toVisit.back();
+                        toVisit.pop_back();
+                        if (!visited.insert(file).second) {
+                            continue;
+                        }
+                        watcher.addPath(file);
+                        for (const auto& imported : resolver.getImportedFiles(file)) {
+                            toVisit.push_back(imported);
+                        }
+                    }
+                };
+                
+                for (const auto& page : pages) {
+                    watchImportClosure(page);
+                }
+                
+                watcher.setBatchCallback([&](const std::vector<std::string>& changed) {
+                    // 新的构建会话：模块索引中的目录在下次访问时重新检查mtime
+                    ModuleIndex::getInstance().beginSession();
+                    
+                    for (const auto& path : changed) {
                         std::cout << "File changed: " << path << "\n";
-                        std::cout << "Recompiling...\n";
-                        
-                        auto watchResult = dispatcher->compile(inputFile);
-                        if (watchResult.success) {
-                            std::cout << "Recompilation successful!\n";
-                        } else {
-                            ErrorReport::getInstance().error("Recompilation failed");
-                            for (const auto& error : watchResult.errors) {
-                                ErrorReport::getInstance().error(error);
-                            }
+                    }
+                    
+                    auto affected = resolver.getDependents(changed);
+                    for (const auto& page : pages) {
+                        if (affected.count(page)) {
+                            compilePage(page);
+                            // 导入语句可能已变化
+                            watchImportClosure(page);
                         }
                     }
                 });
                 
-                watcher.start();
+                if (!watcher.start()) {
+                    ErrorReport::getInstance().error("Failed to start file watcher");
+                    return 1;
+                }
+                std::cout << "Watching for changes... (Press Ctrl+C to stop)\n";
                 
                 // 保持程序运行
                 while (true) {
@@ -2,93 +2,326 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <unordered_set>
 #include "../CHTL/CHTLLexer/Lexer.h"
 #include "../CHTL/CHTLParser/Parser.h"
 #include "../CHTL/CHTLGenerator/Generator.h"
 #include "../CHTL/CHTLContext/Context.h"
 #include "../CHTL/CHTLIOStream/CHTLFileSystem.h"
+#include "../CHTL/CHTLLoader/ImportResolver.h"
+#include "../CHTL/CHTLLoader/ModuleIndex.h"
+#include "../CompilerDispatcher/CompileCache.h"
+#include "../CompilerDispatcher/CompileServer.h"
 #include "../Error/ErrorReport.h"
 
 void printUsage(const char* program) {
     std::cout << "CHTL Compiler v1.0.0\n";
-    std::cout << "Usage: " << program << " <input-file> [output-file]\n";
+    std::cout << "Usage: " << program << " [options] <input-file> [output-file]\n";
+    std::cout << "       " << program << " --server [--jobs <n>]\n";
     std::cout << "Options:\n";
+    std::cout << "  --cache-dir <dir>  Reuse results of unchanged pages across runs\n";
+    std::cout << "  --module-dir <dir> Directory searched for official (chtl::) modules\n";
+    std::cout << "  --watch            Watch for file changes, rebuild pages importing them\n";
+    std::cout << "  --debounce <ms>    Coalesce changes within window (default: 100)\n";
+    std::cout << "  --page <file>      Another page to compile and watch (output: <name>.html)\n";
+    std::cout << "  --debug            Print compile cache and module index statistics\n";
+    std::cout << "  --server           Serve compile/validate requests as JSON-RPC over stdio\n";
+    std::cout << "  --jobs <n>         Concurrent requests in server mode (default: CPU count)\n";
     std::cout << "  -h, --help         Show this help\n";
     std::cout << "  -v, --version      Show version\n";
 }
 
+// 编译一个页面并写出HTML；cache非空时未变化的页面直接取缓存结果
+bool compileFile(const std::string& inputFile, const std::string& outputFile,
+                 CHTL::CompileCache* cache, const CHTL::CompileOptions& options) {
+    // 读取输入文件
+    auto content = CHTL::File::readToString(inputFile);
+    if (!content) {
+        std::cerr << "Error: Cannot read file: " << inputFile << std::endl;
+        return false;
+    }
+
+    std::string cacheKey;
+    if (cache) {
+        cacheKey = cache->computeKey(inputFile, *content, options);
+        if (auto cached = cache->lookup(cacheKey)) {
+            if (!CHTL::File::writeString(outputFile, cached->htmlOutput)) {
+                std::cerr << "Error: Cannot write file: " << outputFile << std::endl;
+                return false;
+            }
+            std::cout << "Unchanged, reused cached output: " << outputFile << std::endl;
+            return true;
+        }
+    }
+
+    // 创建编译上下文
+    auto context = std::make_shared<CHTL::CompileContext>(inputFile);
+
+    // 词法分析
+    std::cout << "Lexing..." << std::endl;
+    CHTL::Lexer lexer(*content, context);
+    auto tokens = lexer.tokenizeAll();
+
+    // 语法分析
+    std::cout << "Parsing..." << std::endl;
+    size_t errorsBefore = CHTL::ErrorReport::getInstance().getTotalErrors();
+    auto lexerPtr = std::make_shared<CHTL::Lexer>(*content, context);
+    CHTL::Parser parser(lexerPtr, context);
+    auto ast = parser.parse();
+
+    if (!ast) {
+        std::cerr << "Error: Parsing failed\n";
+        return false;
+    }
+
+    // 代码生成
+    std::cout << "Generating..." << std::endl;
+    CHTL::Generator generator(context);
+
+    if (cache) {
+        // 需要保存一份输出，先生成到内存
+        CHTL::CompileResult result;
+        CHTL::StringOutputSink sink(result.htmlOutput);
+        generator.generate(ast, sink);
+        if (!CHTL::File::writeString(outputFile, result.htmlOutput)) {
+            std::cerr << "Error: Cannot write file: " << outputFile << std::endl;
+            return false;
+        }
+
+        // 出错的结果不能缓存，否则下次会被当作成功
+        bool failed = !parser.getErrors().empty() ||
+                      CHTL::ErrorReport::getInstance().getTotalErrors() != errorsBefore;
+        if (!failed) {
+            result.success = true;
+            result.outputPath = outputFile;
+            cache->store(cacheKey, result);
+        }
+    } else {
+        // 直接流式写入输出文件
+        std::ofstream output(outputFile, std::ios::binary | std::ios::trunc);
+        if (output) {
+            CHTL::StreamOutputSink sink(output);
+            generator.generate(ast, sink);
+        }
+        if (!output) {
+            std::cerr << "Error: Cannot write file: " << outputFile << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "Successfully compiled to: " << outputFile << std::endl;
+    return true;
+}
+
+// 编译缓存与模块索引的统计信息
+void printStats(const CHTL::CompileCache* cache) {
+    if (cache) {
+        auto stats = cache->getStats();
+        std::cout << "Cache: " << stats.hits << " hits, " << stats.misses << " misses, "
+                  << stats.entries << " entries (" << stats.totalBytes << " bytes)\n";
+    }
+    std::cout << CHTL::ModuleIndex::getInstance().getStatsReport();
+}
+
+// 监视页面及其导入闭包，文件变化时只重编译传递地导入了它的页面
+int watchPages(const std::vector<std::pair<std::string, std::string>>& pages,
+               CHTL::CompileCache* cache, const CHTL::CompileOptions& options, int debounceMs,
+               bool debug) {
+    using namespace CHTL;
+
+    ImportResolverConfig resolverConfig;
+    resolverConfig.officialModuleDir = options.officialModuleDir;
+    resolverConfig.currentDir = PathUtil::parent(pages.front().first);
+    ImportResolver resolver(resolverConfig);
+
+    FileWatcher watcher;
+    watcher.setDebounceInterval(std::chrono::milliseconds(debounceMs));
+
+    auto watchImportClosure = [&](const std::string& page) {
+        resolver.scanImports(page);
+        std::vector<std::string> toVisit = {page};
+        std::unordered_set<std::string> visited;
+        while (!toVisit.empty()) {
+            std::string file = toVisit.back();
+            toVisit.pop_back();
+            if (!visited.insert(file).second) {
+                continue;
+            }
+            watcher.addPath(file);
+            for (const auto& imported : resolver.getImportedFiles(file)) {
+                toVisit.push_back(imported);
+            }
+        }
+    };
+
+    for (const auto& page : pages) {
+        watchImportClosure(page.first);
+    }
+
+    watcher.setBatchCallback([&](const std::vector<std::string>& changed) {
+        // 新的构建会话：模块索引中的目录在下次访问时重新检查mtime
+        ModuleIndex::getInstance().beginSession();
+
+        for (const auto& path : changed) {
+            std::cout << "File changed: " << path << std::endl;
+        }
+
+        auto affected = resolver.getDependents(changed);
+        for (const auto& page : pages) {
+            if (affected.count(page.first)) {
+                std::cout << "Recompiling " << page.first << "..." << std::endl;
+                compileFile(page.first, page.second, cache, options);
+                // 导入语句可能已变化
+                watchImportClosure(page.first);
+            }
+        }
+
+        if (debug) {
+            printStats(cache);
+        }
+    });
+
+    if (!watcher.start()) {
+        std::cerr << "Error: Failed to start file watcher" << std::endl;
+        return 1;
+    }
+    std::cout << "Watching for changes... (Press Ctrl+C to stop)" << std::endl;
+
+    // 保持程序运行
+    while (true) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+}
+
 int main(int argc, char* argv[]) {
     if (argc < 2) {
         printUsage(argv[0]);
         return 1;
     }
-    
-    std::string inputFile = argv[1];
+
+    std::string inputFile;
     std::string outputFile = "output.html";
-    
-    if (argc >= 3) {
-        outputFile = argv[2];
+    bool hasOutputFile = false;
+    CHTL::CompileOptions options;
+    bool serverMode = false;
+    size_t serverJobs = 0;
+    bool watch = false;
+    int debounceMs = 100;
+    std::vector<std::string> extraPages;  // 监视模式下的其他页面
+    bool debug = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        // 检查帮助选项
+        if (arg == "-h" || arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        }
+
+        // 检查版本选项
+        if (arg == "-v" || arg == "--version") {
+            std::cout << "CHTL Compiler version 1.0.0\n";
+            return 0;
+        }
+
+        if (arg == "--server") {
+            serverMode = true;
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            try {
+                serverJobs = std::stoul(argv[++i]);
+            } catch (const std::exception&) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--cache-dir" && i + 1 < argc) {
+            options.cacheDir = argv[++i];
+        } else if (arg == "--module-dir" && i + 1 < argc) {
+            options.officialModuleDir = argv[++i];
+        } else if (arg == "--watch") {
+            watch = true;
+        } else if (arg == "--debounce" && i + 1 < argc) {
+            try {
+                debounceMs = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "--page" && i + 1 < argc) {
+            extraPages.push_back(argv[++i]);
+        } else if (arg == "--debug") {
+            debug = true;
+        } else if (arg[0] != '-' && inputFile.empty()) {
+            inputFile = arg;
+        } else if (arg[0] != '-' && !hasOutputFile) {
+            outputFile = arg;
+            hasOutputFile = true;
+        } else {
+            std::cerr << "Error: Unknown command line option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
     }
-    
-    // 检查帮助选项
-    if (inputFile == "-h" || inputFile == "--help") {
-        printUsage(argv[0]);
-        return 0;
+
+    // 常驻编译服务，stdout只用于协议消息
+    if (serverMode) {
+        if (!inputFile.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        try {
+            return CHTL::runCompileServer(std::cin, std::cout, options, serverJobs);
+        } catch (const std::exception& e) {
+            std::cerr << "Compile server failed: " << e.what() << std::endl;
+            return 1;
+        }
     }
-    
-    // 检查版本选项
-    if (inputFile == "-v" || inputFile == "--version") {
-        std::cout << "CHTL Compiler version 1.0.0\n";
-        return 0;
+
+    if (inputFile.empty()) {
+        printUsage(argv[0]);
+        return 1;
     }
-    
+
     try {
-        // 读取输入文件
-        auto content = CHTL::File::readToString(inputFile);
-        if (!content) {
-            std::cerr << "Error: Cannot read file: " << inputFile << std::endl;
-            return 1;
+        std::unique_ptr<CHTL::CompileCache> cache;
+        if (!options.cacheDir.empty()) {
+            cache = std::make_unique<CHTL::CompileCache>(options.cacheDir, options.cacheMaxBytes);
+            // 直接编译得到的输出与调度器不同，不与其共用缓存条目
+            options.customConfig["driver"] = "chtlc";
         }
-        
-        // 创建编译上下文
-        auto context = std::make_shared<CHTL::CompileContext>(inputFile);
-        
-        // 词法分析
-        std::cout << "Lexing..." << std::endl;
-        CHTL::Lexer lexer(*content, context);
-        auto tokens = lexer.tokenizeAll();
-        
-        // 语法分析
-        std::cout << "Parsing..." << std::endl;
-        auto lexerPtr = std::make_shared<CHTL::Lexer>(*content, context);
-        CHTL::Parser parser(lexerPtr, context);
-        auto ast = parser.parse();
-        
-        if (!ast) {
-            std::cerr << "Error: Parsing failed\n";
-            return 1;
+
+        bool compiled = compileFile(inputFile, outputFile, cache.get(), options);
+        if (debug) {
+            printStats(cache.get());
         }
-        
-        // 代码生成
-        std::cout << "Generating..." << std::endl;
-        CHTL::Generator generator(context);
-        auto result = generator.generate(ast);
-        
-        // 写入输出文件
-        if (!CHTL::File::writeString(outputFile, result)) {
-            std::cerr << "Error: Cannot write file: " << outputFile << std::endl;
+
+        if (watch) {
+            // 每个页面单独的输出文件，放在主输出文件旁边
+            std::vector<std::pair<std::string, std::string>> pages;
+            pages.emplace_back(CHTL::PathUtil::normalize(CHTL::PathUtil::absolute(inputFile)), outputFile);
+            for (const auto& page : extraPages) {
+                std::string pageOutput = CHTL::PathUtil::join(CHTL::PathUtil::parent(outputFile),
+                    CHTL::PathUtil::replaceExtension(CHTL::PathUtil::filename(page), ".html"));
+                pages.emplace_back(CHTL::PathUtil::normalize(CHTL::PathUtil::absolute(page)), pageOutput);
+                compileFile(pages.back().first, pageOutput, cache.get(), options);
+            }
+            return watchPages(pages, cache.get(), options, debounceMs, debug);
+        }
+
+        if (!compiled) {
             return 1;
         }
-        
-        std::cout << "Successfully compiled to: " << outputFile << std::endl;
-        
+
         // TODO: 实现错误统计和报告
         // 目前简单返回成功
-        
+
         return 0;
-        
+
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
         return 1;
     }
-}
\ No newline at end of file
+}
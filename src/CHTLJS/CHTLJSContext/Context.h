@@ -8,6 +8,7 @@
 #include <vector>
 #include "../CHTLJSState/State.h"
 #include "../CHTLJSLexer/GlobalMap.h"
+#include "../../Util/ScopedInstance.h"
 
 namespace CHTLJS {
 
@@ -152,6 +153,9 @@ private:
 class ContextManager {
 public:
     static ContextManager& getInstance() {
+        if (auto* scoped = CHTL::ScopedInstance<ContextManager>::current()) {
+            return *scoped;
+        }
         static ContextManager instance;
         return instance;
     }
@@ -175,6 +179,7 @@ public:
     void clearAll();
 
 private:
+    friend class CHTL::ScopedInstance<ContextManager>;
     ContextManager() = default;
     ContextManager(const ContextManager&) = delete;
     ContextManager& operator=(const ContextManager&) = delete;
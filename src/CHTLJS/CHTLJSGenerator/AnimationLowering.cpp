@@ -0,0 +1,183 @@
+#include "AnimationLowering.h"
+#include "../CHTLJSNode/OperatorNode.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace CHTLJS {
+
+namespace {
+
+struct Frame {
+    std::optional<double> offset;
+    const AnimateStateNode* state;
+};
+
+// 去掉首尾空白和包裹的引号
+std::string cleanValue(const std::string& value) {
+    size_t begin = value.find_first_not_of(" \t\r\n");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = value.find_last_not_of(" \t\r\n");
+    std::string result = value.substr(begin, end - begin + 1);
+    if (result.size() >= 2 && (result.front() == '\'' || result.front() == '"') && result.back() == result.front()) {
+        result = result.substr(1, result.size() - 2);
+    }
+    return result;
+}
+
+// 数值（允许px单位），无法解析时返回nullopt
+std::optional<double> parseNumber(const std::string& value) {
+    const char* begin = value.c_str();
+    char* end = nullptr;
+    double number = std::strtod(begin, &end);
+    if (end == begin) {
+        return std::nullopt;
+    }
+    std::string rest(end);
+    if (!rest.empty() && rest != "px") {
+        return std::nullopt;
+    }
+    return number;
+}
+
+} // namespace
+
+AnimationLowering::Result AnimationLowering::lower(const AnimateNode* node) {
+    std::vector<Frame> frames;
+    auto addFrame = [&frames](const std::shared_ptr<ASTNode>& state, std::optional<double> offset) {
+        if (!state || (state->getType() != NodeType::ANIMATE_BEGIN && state->getType() != NodeType::ANIMATE_WHEN &&
+                       state->getType() != NodeType::ANIMATE_END)) {
+            return;
+        }
+        frames.push_back({offset, static_cast<const AnimateStateNode*>(state.get())});
+    };
+
+    addFrame(node->getBegin(), 0.0);
+    for (const auto& when : node->getWhenStates()) {
+        std::optional<double> at;
+        if (when && when->getType() == NodeType::ANIMATE_WHEN) {
+            at = static_cast<const AnimateStateNode*>(when.get())->getAt();
+        }
+        addFrame(when, at ? std::optional<double>(std::clamp(*at, 0.0, 1.0)) : std::nullopt);
+    }
+    addFrame(node->getEnd(), 1.0);
+
+    Result result;
+    if (frames.empty()) {
+        return result;
+    }
+
+    // 与Web Animations相同：缺省偏移量在相邻的已知偏移量之间均匀分布
+    if (!frames.front().offset) {
+        frames.front().offset = frames.size() == 1 ? 1.0 : 0.0;
+    }
+    if (!frames.back().offset) {
+        frames.back().offset = 1.0;
+    }
+    for (size_t i = 1; i < frames.size(); ++i) {
+        if (frames[i].offset) {
+            continue;
+        }
+        size_t j = i;
+        while (!frames[j].offset) {
+            ++j;
+        }
+        double from = *frames[i - 1].offset;
+        double to = *frames[j].offset;
+        for (size_t k = i; k < j; ++k) {
+            frames[k].offset = from + (to - from) * static_cast<double>(k - i + 1) / static_cast<double>(j - i + 1);
+        }
+        i = j;
+    }
+    std::stable_sort(frames.begin(), frames.end(),
+                     [](const Frame& a, const Frame& b) { return *a.offset < *b.offset; });
+
+    for (const auto& frame : frames) {
+        std::vector<std::pair<std::string, std::string>> properties(frame.state->getProperties().begin(),
+                                                                    frame.state->getProperties().end());
+        std::sort(properties.begin(), properties.end());
+
+        Keyframe keyframe;
+        keyframe.offset = *frame.offset;
+        for (const auto& [name, rawValue] : properties) {
+            std::string value = cleanValue(rawValue);
+            if (!isElementProperty(name)) {
+                keyframe.properties.emplace_back(toKeyframeProperty(name), value);
+                continue;
+            }
+
+            auto number = parseNumber(value);
+            if (!number) {
+                continue;
+            }
+            auto track = std::find_if(result.tracks.begin(), result.tracks.end(),
+                                      [&name](const Track& t) { return t.property == name; });
+            if (track == result.tracks.end()) {
+                result.tracks.push_back({name, {}});
+                track = result.tracks.end() - 1;
+            }
+            track->points.emplace_back(*frame.offset, *number);
+        }
+
+        // 没有CSS属性的关键帧由浏览器隐式补全
+        if (!keyframe.properties.empty()) {
+            result.keyframes.push_back(std::move(keyframe));
+        }
+    }
+
+    return result;
+}
+
+std::string AnimationLowering::toKeyframeProperty(const std::string& name) {
+    // 自定义属性原样保留；float、offset在关键帧对象中有特殊含义
+    if (name.rfind("--", 0) == 0) {
+        return name;
+    }
+    if (name == "float") {
+        return "cssFloat";
+    }
+    if (name == "offset") {
+        return "cssOffset";
+    }
+
+    std::string result;
+    bool upper = false;
+    for (char c : name) {
+        if (c == '-') {
+            upper = !result.empty();
+            continue;
+        }
+        result += upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+        upper = false;
+    }
+    return result;
+}
+
+bool AnimationLowering::isElementProperty(const std::string& name) {
+    return name == "scrollTop" || name == "scrollLeft";
+}
+
+bool AnimationLowering::isInfiniteLoop(const ASTNode* loop) {
+    if (!loop) {
+        return false;
+    }
+    if (loop->getType() == NodeType::UNARY_EXPRESSION) {
+        auto* unary = static_cast<const UnaryExpressionNode*>(loop);
+        return unary->getOperator() == UnaryExpressionNode::Operator::MINUS && unary->getOperand() &&
+               unary->getOperand()->getType() == NodeType::LITERAL;
+    }
+    if (loop->getType() == NodeType::LITERAL) {
+        const auto& value = static_cast<const LiteralNode*>(loop)->getValue();
+        if (std::holds_alternative<int64_t>(value)) {
+            return std::get<int64_t>(value) < 0;
+        }
+        if (std::holds_alternative<double>(value)) {
+            return std::get<double>(value) < 0;
+        }
+    }
+    return false;
+}
+
+} // namespace CHTLJS
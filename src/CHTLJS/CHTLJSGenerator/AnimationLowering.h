@@ -0,0 +1,49 @@
+#ifndef CHTLJS_ANIMATION_LOWERING_H
+#define CHTLJS_ANIMATION_LOWERING_H
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../CHTLJSNode/AnimateNode.h"
+
+namespace CHTLJS {
+
+// animate块降级
+// 编译期把 begin / when / end 状态展开为带确定偏移量的关键帧数组，运行时交给
+// Element.animate() 播放，动画在合成线程上运行，不再逐帧执行JavaScript。
+// CSS无法表达的元素属性（scrollTop、scrollLeft）降级为数值轨道，只有这部分
+// 由requestAnimationFrame逐帧插值。
+class AnimationLowering {
+public:
+    struct Keyframe {
+        double offset = 0;
+        std::vector<std::pair<std::string, std::string>> properties;   // Web Animations属性名 → 值
+    };
+
+    // 逐帧插值的数值轨道
+    struct Track {
+        std::string property;
+        std::vector<std::pair<double, double>> points;                 // (偏移量, 值)
+    };
+
+    struct Result {
+        std::vector<Keyframe> keyframes;    // 只含CSS属性，偏移量非递减
+        std::vector<Track> tracks;
+    };
+
+    static Result lower(const AnimateNode* node);
+
+    // CSS属性名转换为关键帧对象的键（background-color → backgroundColor）
+    static std::string toKeyframeProperty(const std::string& name);
+
+    // 只能通过元素属性设置、需要逐帧插值的属性
+    static bool isElementProperty(const std::string& name);
+
+    // loop为负数（-1）表示无限循环
+    static bool isInfiniteLoop(const ASTNode* loop);
+};
+
+} // namespace CHTLJS
+
+#endif // CHTLJS_ANIMATION_LOWERING_H
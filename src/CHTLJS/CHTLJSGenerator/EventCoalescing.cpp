@@ -0,0 +1,314 @@
+#include "EventCoalescing.h"
+#include "../CHTLJSNode/ListenNode.h"
+#include "../CHTLJSNode/DelegateNode.h"
+#include "../CHTLJSNode/OperatorNode.h"
+#include "../CHTLJSNode/JavaScriptNode.h"
+#include <algorithm>
+#include <cctype>
+
+namespace CHTLJS {
+
+namespace {
+
+// 处理器是否可能调用preventDefault；param为事件参数名，只允许以成员访问的方式使用
+bool inspectHandler(const ASTNode* node, const std::string& param) {
+    if (!node) {
+        return true;
+    }
+
+    switch (node->getType()) {
+        case NodeType::IDENTIFIER: {
+            const auto& name = static_cast<const IdentifierNode*>(node)->getName();
+            // 事件对象通过arguments或window.event逃逸时也无法分析
+            return name == "preventDefault" || name == "returnValue" ||
+                   name == "arguments" || name == "event" ||
+                   (!param.empty() && name == param);
+        }
+        case NodeType::BINARY_EXPRESSION: {
+            auto* binary = static_cast<const BinaryExpressionNode*>(node);
+            if (binary->getOperator() == BinaryExpressionNode::Operator::DOT) {
+                auto left = binary->getLeft();
+                bool eventAccess = left && left->getType() == NodeType::IDENTIFIER && !param.empty() &&
+                                   static_cast<const IdentifierNode*>(left.get())->getName() == param;
+                return (!eventAccess && inspectHandler(left.get(), param)) ||
+                       inspectHandler(binary->getRight().get(), param);
+            }
+            break;
+        }
+        case NodeType::FUNCTION_DECLARATION: {
+            // 内层函数重新声明同名参数时，外层事件对象不可见
+            auto* function = static_cast<const FunctionDeclarationNode*>(node);
+            const auto& parameters = function->getParameters();
+            std::string inner = std::find(parameters.begin(), parameters.end(), param) != parameters.end()
+                ? "" : param;
+            return function->getBody() && inspectHandler(function->getBody().get(), inner);
+        }
+        default:
+            break;
+    }
+
+    for (const auto& child : node->getChildren()) {
+        if (inspectHandler(child.get(), param)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool isNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' ||
+           static_cast<unsigned char>(c) >= 0x80;
+}
+
+} // namespace
+
+void EventCoalescing::analyze(ASTNode* root, bool coalesce) {
+    coalesce_ = coalesce;
+    bindings_.clear();
+    tables_.clear();
+    slots_.clear();
+    coalescedSelectors_.clear();
+    evaluatedSelectors_.clear();
+
+    if (root) {
+        visit(root);
+    }
+    buildTables();
+
+    // 仍在生成代码中求值的选择器不能从提升中排除
+    for (const auto* node : evaluatedSelectors_) {
+        coalescedSelectors_.erase(node);
+    }
+}
+
+void EventCoalescing::visit(ASTNode* node) {
+    switch (node->getType()) {
+        case NodeType::ARROW_ACCESS: {
+            auto* access = static_cast<ArrowAccessNode*>(node);
+            auto property = access->getProperty();
+            if (property && property->getType() == NodeType::LISTEN_BLOCK) {
+                collectListen(property.get(), access->getObject().get(),
+                              static_cast<ListenNode*>(property.get())->getEventHandlers());
+            } else if (property && property->getType() == NodeType::DELEGATE_BLOCK) {
+                collectDelegate(access->getObject().get(), property.get());
+            }
+            break;
+        }
+        case NodeType::EVENT_BINDING: {
+            auto* binding = static_cast<EventBindingNode*>(node);
+            collectListen(node, binding->getSelector().get(), {{binding->getEvent(), binding->getHandler()}});
+            break;
+        }
+        default:
+            break;
+    }
+
+    // 处理器内部可能还有绑定
+    for (const auto& child : node->getChildren()) {
+        if (child) {
+            visit(child.get());
+        }
+    }
+}
+
+void EventCoalescing::collectListen(const ASTNode* binding, const ASTNode* target,
+                                    const std::unordered_map<std::string, std::shared_ptr<ASTNode>>& handlers) {
+    std::string css = selectorCSS(target);
+    coalescedSelectors_.insert(target);
+
+    for (const auto& [event, handler] : handlers) {
+        if (!coalesce_ || css.empty() || !bubbles(event)) {
+            evaluatedSelectors_.insert(target);
+            continue;
+        }
+        bindings_.push_back({binding, event, {css}, handler.get()});
+    }
+}
+
+void EventCoalescing::collectDelegate(const ASTNode* parent, const ASTNode* delegate) {
+    auto* node = static_cast<const DelegateNode*>(delegate);
+
+    std::vector<const ASTNode*> targets;
+    if (auto target = node->getTarget()) {
+        if (target->getType() == NodeType::ARRAY_LITERAL) {
+            for (const auto& element : static_cast<const ArrayLiteralNode*>(target.get())->getElements()) {
+                targets.push_back(element.get());
+            }
+        } else {
+            targets.push_back(target.get());
+        }
+    }
+
+    // 所有目标都是静态选择器时，父子选择器拼接为一个后代选择器
+    std::string parentCSS = selectorCSS(parent);
+    std::vector<std::string> targetCSS;
+    bool staticTargets = !targets.empty();
+    for (const auto* target : targets) {
+        targetCSS.push_back(selectorCSS(target));
+        staticTargets = staticTargets && !targetCSS.back().empty();
+    }
+    bool combinable = staticTargets && !parentCSS.empty() && parentCSS.find(',') == std::string::npos &&
+        std::none_of(targetCSS.begin(), targetCSS.end(),
+                     [](const std::string& css) { return css.find(',') != std::string::npos; });
+
+    coalescedSelectors_.insert(parent);
+    coalescedSelectors_.insert(targets.begin(), targets.end());
+
+    for (const auto& [event, handler] : node->getEventHandlers()) {
+        if (coalesce_ && combinable && bubbles(event)) {
+            std::vector<std::string> selectors;
+            for (const auto& css : targetCSS) {
+                selectors.push_back(parentCSS + " " + css);
+            }
+            bindings_.push_back({delegate, event, selectors, handler.get()});
+        } else if (staticTargets) {
+            // 在父元素上委托，目标以选择器字符串传入
+            evaluatedSelectors_.insert(parent);
+        } else {
+            // 直接监听各目标元素
+            evaluatedSelectors_.insert(targets.begin(), targets.end());
+        }
+    }
+}
+
+void EventCoalescing::buildTables() {
+    std::map<std::string, EventTable> tables;
+    for (const auto& binding : bindings_) {
+        auto& table = tables[binding.event];
+        table.event = binding.event;
+        for (const auto& selector : binding.selectors) {
+            bool known = std::any_of(table.slots.begin(), table.slots.end(),
+                                     [&](const Slot& slot) { return slot.selector == selector; });
+            if (!known) {
+                table.slots.push_back({selector, specificity(selector)});
+            }
+        }
+        if (mayPreventDefault(binding.handler)) {
+            table.passive = false;
+        }
+    }
+
+    // 同一元素上特异性高的选择器先分发，相同时保持源码顺序
+    for (auto& [_, table] : tables) {
+        std::stable_sort(table.slots.begin(), table.slots.end(),
+                         [](const Slot& a, const Slot& b) { return b.specificity < a.specificity; });
+        tables_.push_back(std::move(table));
+    }
+
+    for (const auto& binding : bindings_) {
+        const auto& table = *std::find_if(tables_.begin(), tables_.end(),
+                                          [&](const EventTable& t) { return t.event == binding.event; });
+        auto& slots = slots_[{binding.node, binding.event}];
+        for (const auto& selector : binding.selectors) {
+            size_t index = std::find_if(table.slots.begin(), table.slots.end(),
+                                        [&](const Slot& slot) { return slot.selector == selector; })
+                           - table.slots.begin();
+            if (std::find(slots.begin(), slots.end(), index) == slots.end()) {
+                slots.push_back(index);
+            }
+        }
+    }
+}
+
+const std::vector<size_t>* EventCoalescing::findSlots(const ASTNode* binding, const std::string& event) const {
+    auto it = slots_.find({binding, event});
+    return it == slots_.end() ? nullptr : &it->second;
+}
+
+std::string EventCoalescing::selectorCSS(const ASTNode* node) {
+    if (!node || node->getType() != NodeType::ENHANCED_SELECTOR) {
+        return "";
+    }
+    auto* selector = static_cast<const EnhancedSelectorNode*>(node);
+    if (selector->getSelectorType() == EnhancedSelectorNode::SelectorType::REFERENCE ||
+        selector->getIndex().has_value()) {
+        return "";
+    }
+    return selector->getSelector();
+}
+
+bool EventCoalescing::bubbles(const std::string& event) {
+    static const std::unordered_set<std::string> nonBubbling = {
+        "focus", "blur", "mouseenter", "mouseleave", "pointerenter", "pointerleave",
+        "load", "unload", "error", "abort", "scroll", "scrollend", "resize",
+        "toggle", "beforetoggle", "invalid", "cancel", "close",
+        // 媒体事件
+        "loadstart", "progress", "suspend", "emptied", "stalled", "loadedmetadata", "loadeddata",
+        "canplay", "canplaythrough", "playing", "waiting", "seeking", "seeked", "ended",
+        "durationchange", "timeupdate", "play", "pause", "ratechange", "volumechange"
+    };
+    return !event.empty() && nonBubbling.count(event) == 0;
+}
+
+EventCoalescing::Specificity EventCoalescing::specificity(const std::string& selector) {
+    Specificity best;
+    Specificity current;
+    size_t i = 0;
+    size_t n = selector.size();
+    auto skipName = [&]() {
+        while (i < n && isNameChar(selector[i])) {
+            ++i;
+        }
+    };
+
+    while (i < n) {
+        char c = selector[i];
+        if (c == ',') {
+            // 选择器列表取最高的特异性
+            best = std::max(best, current);
+            current = Specificity();
+            ++i;
+        } else if (c == '#') {
+            ++current.ids;
+            ++i;
+            skipName();
+        } else if (c == '.') {
+            ++current.classes;
+            ++i;
+            skipName();
+        } else if (c == '[') {
+            ++current.classes;
+            size_t end = selector.find(']', i);
+            i = end == std::string::npos ? n : end + 1;
+        } else if (c == ':') {
+            if (i + 1 < n && selector[i + 1] == ':') {
+                ++current.types;
+                i += 2;
+            } else {
+                ++current.classes;
+                ++i;
+            }
+            skipName();
+            if (i < n && selector[i] == '(') {
+                for (int depth = 0; i < n; ++i) {
+                    if (selector[i] == '(') ++depth;
+                    if (selector[i] == ')' && --depth == 0) {
+                        ++i;
+                        break;
+                    }
+                }
+            }
+        } else if (isNameChar(c)) {
+            ++current.types;
+            skipName();
+        } else {
+            // 空白、组合符、通配符
+            ++i;
+        }
+    }
+
+    return std::max(best, current);
+}
+
+bool EventCoalescing::mayPreventDefault(const ASTNode* handler) {
+    // 处理器不是函数字面量（如引用外部函数）时无法分析
+    if (!handler || handler->getType() != NodeType::FUNCTION_DECLARATION) {
+        return true;
+    }
+    auto* function = static_cast<const FunctionDeclarationNode*>(handler);
+    const auto& parameters = function->getParameters();
+    std::string param = parameters.empty() ? "" : parameters.front();
+    return function->getBody() && inspectHandler(function->getBody().get(), param);
+}
+
+} // namespace CHTLJS
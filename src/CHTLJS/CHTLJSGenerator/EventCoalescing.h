@@ -0,0 +1,94 @@
+#ifndef CHTLJS_EVENT_COALESCING_H
+#define CHTLJS_EVENT_COALESCING_H
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "../CHTLJSNode/BaseNode.h"
+#include "../CHTLJSNode/SelectorNode.h"
+
+namespace CHTLJS {
+
+// 页面级事件委托合并分析
+// 收集整个页面的 listen / delegate / &-> 绑定，按事件类型分组：每种事件只在document上
+// 注册一个根监听器，分发表（选择器 → 处理器槽位）在编译期按选择器特异性排好序。
+//   - 静态选择器（无索引、非 & 引用）上的冒泡事件参与合并；delegate 的选择器为“父 目标”
+//   - 不冒泡的事件（focus、mouseenter等）和动态选择器保留逐元素监听
+//   - 所有处理器都是不会调用preventDefault的函数字面量时，根监听器标记为passive
+// 处理器函数仍在绑定处求值（可能引用局部变量），运行时登记到对应槽位。
+class EventCoalescing {
+public:
+    // CSS选择器特异性（a, b, c）
+    struct Specificity {
+        int ids = 0;
+        int classes = 0;
+        int types = 0;
+
+        bool operator<(const Specificity& other) const {
+            if (ids != other.ids) return ids < other.ids;
+            if (classes != other.classes) return classes < other.classes;
+            return types < other.types;
+        }
+    };
+
+    struct Slot {
+        std::string selector;
+        Specificity specificity;
+    };
+
+    // 一种事件的分发表，槽位按特异性从高到低排列
+    struct EventTable {
+        std::string event;
+        std::vector<Slot> slots;
+        bool passive = true;
+    };
+
+    // 分析程序，重新建立分发表；coalesce为false时所有绑定都逐元素监听
+    void analyze(ASTNode* root, bool coalesce = true);
+
+    // 绑定（ListenNode、DelegateNode或EventBindingNode）在某事件上的槽位，未合并时返回nullptr
+    const std::vector<size_t>* findSlots(const ASTNode* binding, const std::string& event) const;
+
+    // 按事件名排序
+    const std::vector<EventTable>& getTables() const { return tables_; }
+
+    // 只用于已合并绑定、生成时不再求值的选择器节点
+    const std::unordered_set<const ASTNode*>& getCoalescedSelectors() const { return coalescedSelectors_; }
+
+    // 静态增强选择器的CSS文本，不能静态确定时返回空串
+    static std::string selectorCSS(const ASTNode* node);
+
+    static bool bubbles(const std::string& event);
+    static Specificity specificity(const std::string& selector);
+
+    // 处理器是否可能阻止默认行为（无法分析时返回true）
+    static bool mayPreventDefault(const ASTNode* handler);
+
+private:
+    struct Binding {
+        const ASTNode* node;
+        std::string event;
+        std::vector<std::string> selectors;
+        const ASTNode* handler;
+    };
+
+    bool coalesce_ = true;
+    std::vector<Binding> bindings_;
+    std::vector<EventTable> tables_;
+    std::map<std::pair<const ASTNode*, std::string>, std::vector<size_t>> slots_;
+    std::unordered_set<const ASTNode*> coalescedSelectors_;
+    std::unordered_set<const ASTNode*> evaluatedSelectors_;
+
+    void visit(ASTNode* node);
+    void collectListen(const ASTNode* binding, const ASTNode* target,
+                       const std::unordered_map<std::string, std::shared_ptr<ASTNode>>& handlers);
+    void collectDelegate(const ASTNode* parent, const ASTNode* delegate);
+    void buildTables();
+};
+
+} // namespace CHTLJS
+
+#endif // CHTLJS_EVENT_COALESCING_H
@@ -1,9 +1,52 @@
 #include "Generator.h"
 #include <algorithm>
+#include <cctype>
 #include <random>
 
 namespace CHTLJS {
 
+namespace {
+
+// 单引号JavaScript字符串
+std::string quote(const std::string& text) {
+    std::string result = "'";
+    for (char c : text) {
+        if (c == '\'' || c == '\\') {
+            result += '\\';
+        }
+        result += c;
+    }
+    return result + "'";
+}
+
+// 数值字面量（0.4而不是0.400000）
+std::string formatNumber(double value) {
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+
+// 对象字面量的键，非标识符时加引号（自定义属性）
+std::string propertyKey(const std::string& name) {
+    bool identifier = !name.empty() && !std::isdigit(static_cast<unsigned char>(name[0])) &&
+        std::all_of(name.begin(), name.end(), [](char c) {
+            return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+        });
+    return identifier ? name : quote(name);
+}
+
+// 事件名按字典序输出，保证生成结果稳定
+std::vector<std::string> sortedEvents(const std::unordered_map<std::string, std::shared_ptr<ASTNode>>& handlers) {
+    std::vector<std::string> events;
+    for (const auto& [event, _] : handlers) {
+        events.push_back(event);
+    }
+    std::sort(events.begin(), events.end());
+    return events;
+}
+
+} // namespace
+
 Generator::Generator(std::shared_ptr<CompileContext> context,
                      const GeneratorConfig& config)
     : context_(context), config_(config) {}
@@ -13,8 +56,19 @@ std::string Generator::generate(std::shared_ptr<ProgramNode> program) {
     moduleLoader_.str("");
     indentLevel_ = 0;
     
+    // 先分析整个程序，确定页面级事件分发表和选择器句柄
+    eventCoalescing_.analyze(program.get(), config_.coalesceEvents);
+    if (config_.hoistSelectors) {
+        selectorHoisting_.analyze(program.get(), eventCoalescing_.getCoalescedSelectors());
+    } else {
+        selectorHoisting_.analyze(nullptr);
+    }
+    
     // 生成辅助函数
     generateSelectorHelpers();
+    if (!selectorHoisting_.getHandles().empty()) {
+        generateSelectorHandles();
+    }
     generateEventDelegationSystem();
     generateAnimationHelpers();
     generateVirtualObjectSystem();
@@ -53,8 +107,12 @@ void Generator::visitProgramNode(ProgramNode* node) {
 
 void Generator::visitStatementNode(StatementNode* node) {
     if (node->getExpression()) {
+        write(getIndent());
         node->getExpression()->accept(this);
-        writeLine(";");
+        write(";");
+        if (!config_.minify) {
+            write(config_.lineEnding);
+        }
     }
 }
 
@@ -138,17 +196,17 @@ void Generator::visitEnhancedSelectorNode(EnhancedSelectorNode* node) {
 std::string Generator::generateSelectorCode(EnhancedSelectorNode* node) {
     std::string selector = node->getSelector();
     std::string funcName = getSelectorFunction(node->getSelectorType());
+    std::string code;
     
-    // 检查缓存
-    auto cacheKey = selector + (node->getIndex().has_value() ? 
-                                "[" + std::to_string(node->getIndex().value()) + "]" : "");
-    auto it = currentState_.selectorCache.find(cacheKey);
-    if (it != currentState_.selectorCache.end()) {
-        return it->second;
+    // 已提升的选择器引用页面级句柄
+    if (const auto* handle = selectorHoisting_.find(node)) {
+        code = "CHTLSelectorHandles." + handle->name + "()";
+        if (node->getIndex().has_value()) {
+            code += "[" + std::to_string(node->getIndex().value()) + "]";
+        }
+        return code;
     }
     
-    std::string code;
-    
     // 处理引用选择器
     if (node->getSelectorType() == EnhancedSelectorNode::SelectorType::REFERENCE) {
         // & 引用选择器需要特殊处理
@@ -182,9 +240,6 @@ std::string Generator::generateSelectorCode(EnhancedSelectorNode* node) {
         code += "[" + std::to_string(node->getIndex().value()) + "]";
     }
     
-    // 缓存结果
-    currentState_.selectorCache[cacheKey] = code;
-    
     return code;
 }
 
@@ -223,18 +278,90 @@ void Generator::visitListenNode(ListenNode* node) {
 }
 
 void Generator::visitArrowAccessNode(ArrowAccessNode* node) {
+    auto property = node->getProperty();
+    if (property->getType() == NodeType::LISTEN_BLOCK) {
+        generateListenCode(static_cast<ListenNode*>(property.get()), node->getObject().get());
+        return;
+    }
+    if (property->getType() == NodeType::DELEGATE_BLOCK) {
+        generateDelegateCode(static_cast<DelegateNode*>(property.get()), node->getObject().get());
+        return;
+    }
+    
     node->getObject()->accept(this);
     write(".");
-    node->getProperty()->accept(this);
+    property->accept(this);
 }
 
 void Generator::visitEventBindingNode(EventBindingNode* node) {
     // &-> 事件绑定
-    node->getSelector()->accept(this);
-    write(".addEventListener('");
-    write(node->getEvent());
-    write("', ");
-    node->getHandler()->accept(this);
+    write("CHTLEventDelegation");
+    generateEventBinding(node, node->getSelector().get(), node->getEvent(), node->getHandler().get());
+}
+
+void Generator::generateListenCode(ListenNode* node, ASTNode* target) {
+    write("CHTLEventDelegation");
+    const auto& handlers = node->getEventHandlers();
+    for (const auto& event : sortedEvents(handlers)) {
+        generateEventBinding(node, target, event, handlers.at(event).get());
+    }
+}
+
+void Generator::generateDelegateCode(DelegateNode* node, ASTNode* parent) {
+    std::vector<ASTNode*> targets;
+    if (auto target = node->getTarget()) {
+        if (target->getType() == NodeType::ARRAY_LITERAL) {
+            for (const auto& element : static_cast<ArrayLiteralNode*>(target.get())->getElements()) {
+                targets.push_back(element.get());
+            }
+        } else {
+            targets.push_back(target.get());
+        }
+    }
+    
+    std::string targetSelector;
+    bool staticTargets = !targets.empty();
+    for (auto* target : targets) {
+        std::string css = EventCoalescing::selectorCSS(target);
+        staticTargets = staticTargets && !css.empty();
+        targetSelector += (targetSelector.empty() ? "" : ", ") + css;
+    }
+    
+    write("CHTLEventDelegation");
+    const auto& handlers = node->getEventHandlers();
+    for (const auto& event : sortedEvents(handlers)) {
+        auto* handler = handlers.at(event).get();
+        if (eventCoalescing_.findSlots(node, event)) {
+            generateEventBinding(node, parent, event, handler);
+        } else if (staticTargets) {
+            write(".delegate(");
+            parent->accept(this);
+            write(", " + quote(targetSelector) + ", " + quote(event) + ", ");
+            handler->accept(this);
+            write(")");
+        } else {
+            for (auto* target : targets) {
+                generateEventBinding(node, target, event, handler);
+            }
+        }
+    }
+}
+
+void Generator::generateEventBinding(const ASTNode* binding, ASTNode* target,
+                                     const std::string& event, ASTNode* handler) {
+    if (const auto* slots = eventCoalescing_.findSlots(binding, event)) {
+        // 登记到分发表槽位
+        std::string list;
+        for (size_t slot : *slots) {
+            list += (list.empty() ? "" : ", ") + std::to_string(slot);
+        }
+        write(".bind(" + quote(event) + ", [" + list + "], ");
+    } else {
+        write(".listen(");
+        target->accept(this);
+        write(", " + quote(event) + ", ");
+    }
+    handler->accept(this);
     write(")");
 }
 
@@ -267,6 +394,79 @@ void Generator::generateBinaryOperator(BinaryExpressionNode::Operator op) {
     }
 }
 
+void Generator::visitUnaryExpressionNode(UnaryExpressionNode* node) {
+    generateUnaryOperator(node->getOperator());
+    node->getOperand()->accept(this);
+}
+
+void Generator::generateUnaryOperator(UnaryExpressionNode::Operator op) {
+    switch (op) {
+        case UnaryExpressionNode::Operator::NOT: write("!"); break;
+        case UnaryExpressionNode::Operator::MINUS: write("-"); break;
+        case UnaryExpressionNode::Operator::PLUS: write("+"); break;
+    }
+}
+
+void Generator::visitFunctionDeclarationNode(FunctionDeclarationNode* node) {
+    // 无名称时为函数表达式
+    write("function");
+    if (!node->getName().empty()) {
+        write(" " + node->getName());
+    }
+    write("(");
+    const auto& parameters = node->getParameters();
+    for (size_t i = 0; i < parameters.size(); ++i) {
+        write((i ? ", " : "") + parameters[i]);
+    }
+    write(") {");
+    if (!config_.minify) {
+        write(config_.lineEnding);
+    }
+    
+    indent();
+    if (auto body = node->getBody()) {
+        if (body->getType() == NodeType::PROGRAM || body->getType() == NodeType::STATEMENT) {
+            body->accept(this);
+        } else {
+            write(getIndent());
+            body->accept(this);
+            write(";");
+            if (!config_.minify) {
+                write(config_.lineEnding);
+            }
+        }
+    }
+    dedent();
+    write(getIndent() + "}");
+}
+
+void Generator::visitCallExpressionNode(CallExpressionNode* node) {
+    node->getCallee()->accept(this);
+    write("(");
+    bool first = true;
+    for (const auto& argument : node->getArguments()) {
+        if (!first) {
+            write(", ");
+        }
+        argument->accept(this);
+        first = false;
+    }
+    write(")");
+}
+
+void Generator::visitArrayLiteralNode(ArrayLiteralNode* node) {
+    write("[");
+    bool first = true;
+    for (const auto& element : node->getElements()) {
+        if (!first) {
+            write(", ");
+        }
+        element->accept(this);
+        first = false;
+    }
+    write("]");
+}
+
 void Generator::visitVariableDeclarationNode(VariableDeclarationNode* node) {
     switch (node->getDeclarationType()) {
         case VariableDeclarationNode::DeclarationType::CONST:
@@ -360,45 +560,254 @@ void Generator::generateSelectorHelpers() {
     writeLine();
 }
 
+void Generator::generateSelectorHandles() {
+    // 动态集合句柄首次访问后永久有效；快照句柄在页面代码会修改DOM时由MutationObserver
+    // 计数失效，访问时先用takeRecords()同步取走尚未派发的变更记录
+    bool tracked = selectorHoisting_.mutatesDOM() &&
+                   selectorHoisting_.hasHandles(SelectorHoisting::HandleKind::SNAPSHOT);
+    
+    writeLine("// CHTL JS Selector Handles");
+    writeLine("var CHTLSelectorHandles = (function() {");
+    indent();
+    
+    if (tracked) {
+        std::string options = "{childList: true, subtree: true, attributes: true";
+        if (!selectorHoisting_.observeAllAttributes()) {
+            options += ", attributeFilter: [";
+            const auto& attributes = selectorHoisting_.getObservedAttributes();
+            for (size_t i = 0; i < attributes.size(); ++i) {
+                options += (i ? ", '" : "'") + attributes[i] + "'";
+            }
+            options += "]";
+        }
+        options += "}";
+        
+        writeLine("var generation = 0;");
+        writeLine("var observer = new MutationObserver(function() {");
+        indent();
+        writeLine("generation++;");
+        dedent();
+        writeLine("});");
+        writeLine("observer.observe(document, " + options + ");");
+        writeLine();
+    }
+    
+    if (selectorHoisting_.hasHandles(SelectorHoisting::HandleKind::LIVE)) {
+        writeLine("function live(lookup) {");
+        indent();
+        writeLine("var value;");
+        writeLine("return function() {");
+        indent();
+        writeLine("return value || (value = lookup());");
+        dedent();
+        writeLine("};");
+        dedent();
+        writeLine("}");
+        writeLine();
+    }
+    
+    if (tracked) {
+        writeLine("function snapshot(lookup) {");
+        indent();
+        writeLine("var value;");
+        writeLine("var seen = -1;");
+        writeLine("return function() {");
+        indent();
+        writeLine("if (observer.takeRecords().length) generation++;");
+        writeLine("if (seen !== generation) {");
+        indent();
+        writeLine("value = lookup();");
+        writeLine("seen = generation;");
+        dedent();
+        writeLine("}");
+        writeLine("return value;");
+        dedent();
+        writeLine("};");
+        dedent();
+        writeLine("}");
+        writeLine();
+    } else if (selectorHoisting_.hasHandles(SelectorHoisting::HandleKind::SNAPSHOT)) {
+        // CHTL JS代码不修改DOM，文档解析完成后固定结果。页面中的纯JS片段和外部脚本
+        // 不在分析范围内，结果为空或含已脱离文档的元素时重新查询
+        writeLine("function stale(value) {");
+        indent();
+        writeLine("if (!value) return true;");
+        writeLine("if (value.nodeType) return !value.isConnected;");
+        writeLine("if (!value.length) return true;");
+        writeLine("for (var i = 0; i < value.length; i++) {");
+        indent();
+        writeLine("if (!value[i].isConnected) return true;");
+        dedent();
+        writeLine("}");
+        writeLine("return false;");
+        dedent();
+        writeLine("}");
+        writeLine();
+        writeLine("function snapshot(lookup) {");
+        indent();
+        writeLine("var value;");
+        writeLine("var cached = false;");
+        writeLine("return function() {");
+        indent();
+        writeLine("if (!cached || stale(value)) {");
+        indent();
+        writeLine("value = lookup();");
+        writeLine("cached = document.readyState !== 'loading';");
+        dedent();
+        writeLine("}");
+        writeLine("return value;");
+        dedent();
+        writeLine("};");
+        dedent();
+        writeLine("}");
+        writeLine();
+    }
+    
+    writeLine("return {");
+    indent();
+    const auto& handles = selectorHoisting_.getHandles();
+    for (size_t i = 0; i < handles.size(); ++i) {
+        const auto& handle = handles[i];
+        std::string lookup = handle.type == EnhancedSelectorNode::SelectorType::COMPOUND
+            ? "CHTLSelector.query('" + handle.selector + "')"
+            : getSelectorFunction(handle.type) + "('" + handle.selector + "')";
+        std::string wrapper = handle.kind == SelectorHoisting::HandleKind::LIVE ? "live" : "snapshot";
+        writeLine(handle.name + ": " + wrapper + "(function() { return " + lookup + "; })" +
+                  (i + 1 < handles.size() ? "," : ""));
+    }
+    dedent();
+    writeLine("};");
+    
+    dedent();
+    writeLine("})();");
+    writeLine();
+}
+
 void Generator::generateEventDelegationSystem() {
     writeLine("// CHTL JS Event Delegation System");
     writeLine("var CHTLEventDelegation = (function() {");
     indent();
     
-    writeLine("var delegations = new Map();");
+    // 编译期确定的分发表：每种事件一个根监听器，槽位按选择器特异性排序
+    const auto& tables = eventCoalescing_.getTables();
+    if (tables.empty()) {
+        writeLine("var table = {};");
+    } else {
+        writeLine("var table = {");
+        indent();
+        for (size_t i = 0; i < tables.size(); ++i) {
+            const auto& table = tables[i];
+            writeLine(quote(table.event) + ": {passive: " + (table.passive ? "true" : "false") + ", slots: [");
+            indent();
+            for (size_t j = 0; j < table.slots.size(); ++j) {
+                writeLine("{selector: " + quote(table.slots[j].selector) + ", handlers: []}" +
+                          (j + 1 < table.slots.size() ? "," : ""));
+            }
+            dedent();
+            writeLine(std::string("]}") + (i + 1 < tables.size() ? "," : ""));
+        }
+        dedent();
+        writeLine("};");
+    }
+    writeLine("var api = {};");
     writeLine();
     
-    writeLine("function delegate(parent, target, event, handler) {");
+    // 从事件目标向上冒泡，同一元素上按槽位顺序分发。所有处理器共用一个原生监听器，
+    // stopImmediatePropagation()要跳过的是表中其余的处理器，由包装后的方法记录
+    writeLine("function dispatch(e) {");
     indent();
-    writeLine("var key = parent + '_' + event;");
-    writeLine("if (!delegations.has(key)) {");
+    writeLine("var slots = table[e.type].slots;");
+    writeLine("var stopped = false;");
+    writeLine("var stopImmediate = e.stopImmediatePropagation;");
+    writeLine("e.stopImmediatePropagation = function() {");
+    indent();
+    writeLine("stopped = true;");
+    writeLine("stopImmediate.call(e);");
+    dedent();
+    writeLine("};");
+    writeLine("var el = e.target;");
+    writeLine("if (el && el.nodeType !== 1) el = el.parentElement;");
+    writeLine("for (; el; el = el.parentElement) {");
     indent();
-    writeLine("var parentEl = typeof parent === 'string' ? ");
-    writeLine("  document.querySelector(parent) : parent;");
-    writeLine("parentEl.addEventListener(event, function(e) {");
+    writeLine("for (var i = 0; i < slots.length; i++) {");
     indent();
-    writeLine("var targetEl = e.target.closest(target);");
-    writeLine("if (targetEl) {");
+    writeLine("var slot = slots[i];");
+    writeLine("if (slot.handlers.length && el.matches(slot.selector)) {");
     indent();
-    writeLine("var handlers = delegations.get(key);");
-    writeLine("handlers.forEach(function(h) {");
+    writeLine("for (var j = 0; j < slot.handlers.length; j++) {");
     indent();
-    writeLine("if (h.target === target) h.handler.call(targetEl, e);");
+    writeLine("if (stopped) return;");
+    writeLine("slot.handlers[j].call(el, e);");
     dedent();
-    writeLine("});");
+    writeLine("}");
     dedent();
     writeLine("}");
     dedent();
-    writeLine("});");
-    writeLine("delegations.set(key, []);");
+    writeLine("}");
+    writeLine("if (e.cancelBubble) break;");
+    dedent();
+    writeLine("}");
+    dedent();
+    writeLine("}");
+    writeLine();
+    
+    // 首次登记处理器时注册该事件的根监听器
+    writeLine("function bind(event, slots, handler) {");
+    indent();
+    writeLine("var entry = table[event];");
+    writeLine("if (!entry.attached) {");
+    indent();
+    writeLine("document.addEventListener(event, dispatch, entry.passive ? {passive: true} : false);");
+    writeLine("entry.attached = true;");
+    dedent();
+    writeLine("}");
+    writeLine("for (var i = 0; i < slots.length; i++) {");
+    indent();
+    writeLine("entry.slots[slots[i]].handlers.push(handler);");
+    dedent();
+    writeLine("}");
+    writeLine("return api;");
+    dedent();
+    writeLine("}");
+    writeLine();
+    
+    // 不冒泡的事件和动态选择器直接监听元素
+    writeLine("function listen(target, event, handler) {");
+    indent();
+    writeLine("if (target && target.addEventListener) {");
+    indent();
+    writeLine("target.addEventListener(event, handler);");
+    dedent();
+    writeLine("} else if (target) {");
+    indent();
+    writeLine("for (var i = 0; i < target.length; i++) {");
+    indent();
+    writeLine("target[i].addEventListener(event, handler);");
     dedent();
     writeLine("}");
-    writeLine("delegations.get(key).push({target: target, handler: handler});");
+    dedent();
+    writeLine("}");
+    writeLine("return api;");
     dedent();
     writeLine("}");
     writeLine();
     
-    writeLine("return { delegate: delegate };");
+    writeLine("function delegate(parent, target, event, handler) {");
+    indent();
+    writeLine("return listen(parent, event, function(e) {");
+    indent();
+    writeLine("var el = e.target.closest ? e.target.closest(target) : null;");
+    writeLine("if (el && this.contains(el)) handler.call(el, e);");
+    dedent();
+    writeLine("});");
+    dedent();
+    writeLine("}");
+    writeLine();
+    
+    writeLine("api.bind = bind;");
+    writeLine("api.listen = listen;");
+    writeLine("api.delegate = delegate;");
+    writeLine("return api;");
     dedent();
     writeLine("})();");
     writeLine();
@@ -409,20 +818,73 @@ void Generator::generateAnimationHelpers() {
     writeLine("var CHTLAnimation = (function() {");
     indent();
     
-    writeLine("function animate(options) {");
+    // 逐帧轨道使用的近似缓动曲线
+    writeLine("var easings = {");
+    indent();
+    writeLine("'linear': function(t) { return t; },");
+    writeLine("'ease': function(t) { return t < 0.5 ? 2 * t * t : -1 + (4 - 2 * t) * t; },");
+    writeLine("'ease-in': function(t) { return t * t; },");
+    writeLine("'ease-out': function(t) { return t * (2 - t); },");
+    writeLine("'ease-in-out': function(t) { return t < 0.5 ? 2 * t * t : -1 + (4 - 2 * t) * t; }");
+    dedent();
+    writeLine("};");
+    writeLine();
+    
+    // 元素、元素集合或它们的数组
+    writeLine("function elements(target, out) {");
     indent();
-    writeLine("// Animation implementation");
-    writeLine("var start = performance.now();");
-    writeLine("var duration = options.duration || 1000;");
-    writeLine("var target = options.target;");
-    writeLine("var easing = options.easing || 'linear';");
+    writeLine("if (target && target.nodeType === 1) {");
+    indent();
+    writeLine("out.push(target);");
+    dedent();
+    writeLine("} else if (target && typeof target.length === 'number') {");
+    indent();
+    writeLine("for (var i = 0; i < target.length; i++) elements(target[i], out);");
+    dedent();
+    writeLine("}");
+    writeLine("return out;");
+    dedent();
+    writeLine("}");
+    writeLine();
+    
+    writeLine("function sample(track, p) {");
+    indent();
+    writeLine("var i = 1;");
+    writeLine("while (i < track.length - 1 && track[i][0] < p) i++;");
+    writeLine("var a = track[i - 1], b = track[i] || a;");
+    writeLine("var span = b[0] - a[0];");
+    writeLine("return span > 0 ? a[1] + (b[1] - a[1]) * Math.min(Math.max((p - a[0]) / span, 0), 1) : b[1];");
+    dedent();
+    writeLine("}");
+    writeLine();
+    
+    // 只有CSS无法表达的元素属性才逐帧插值
+    writeLine("function tween(els, tracks, options, done) {");
+    indent();
+    writeLine("var duration = Math.max(options.duration, 1);");
+    writeLine("var total = duration * options.iterations;");
+    writeLine("var direction = options.direction || 'normal';");
+    writeLine("var ease = easings[options.easing] || easings.linear;");
+    writeLine("var start = null;");
     writeLine();
     writeLine("function step(timestamp) {");
     indent();
-    writeLine("var progress = (timestamp - start) / duration;");
-    writeLine("if (progress >= 1) progress = 1;");
-    writeLine("// Apply animation");
-    writeLine("if (progress < 1) requestAnimationFrame(step);");
+    writeLine("if (start === null) start = timestamp + (options.delay || 0);");
+    writeLine("var elapsed = Math.min(Math.max(timestamp - start, 0), total);");
+    writeLine("var iteration = elapsed < total ? Math.floor(elapsed / duration) : options.iterations - 1;");
+    writeLine("var progress = elapsed < total ? elapsed / duration - iteration : 1;");
+    writeLine("var reversed = direction === 'reverse' ||");
+    writeLine("  (direction === 'alternate' && iteration % 2 === 1) ||");
+    writeLine("  (direction === 'alternate-reverse' && iteration % 2 === 0);");
+    writeLine("var p = ease(reversed ? 1 - progress : progress);");
+    writeLine("for (var name in tracks) {");
+    indent();
+    writeLine("var value = sample(tracks[name], p);");
+    writeLine("for (var i = 0; i < els.length; i++) els[i][name] = value;");
+    dedent();
+    writeLine("}");
+    writeLine("if (elapsed < total) requestAnimationFrame(step);");
+    writeLine("else done();");
     dedent();
     writeLine("}");
     writeLine();
@@ -431,6 +893,44 @@ void Generator::generateAnimationHelpers() {
     writeLine("}");
     writeLine();
     
+    // 关键帧在编译期展开，由Element.animate()在合成线程上播放
+    writeLine("function animate(target, keyframes, tracks, options, callback) {");
+    indent();
+    writeLine("var els = elements(target, []);");
+    writeLine("var animations = [];");
+    writeLine("var pending = 1;");
+    writeLine("function done() {");
+    indent();
+    writeLine("if (--pending === 0 && callback) callback();");
+    dedent();
+    writeLine("}");
+    writeLine();
+    writeLine("if (options.iterations === undefined) options.iterations = 1;");
+    writeLine("if (options.iterations < 0) options.iterations = Infinity;");
+    writeLine("if (keyframes.length) {");
+    indent();
+    writeLine("for (var i = 0; i < els.length; i++) {");
+    indent();
+    writeLine("var animation = els[i].animate(keyframes, options);");
+    writeLine("animation.onfinish = done;");
+    writeLine("animations.push(animation);");
+    writeLine("pending++;");
+    dedent();
+    writeLine("}");
+    dedent();
+    writeLine("}");
+    writeLine("if (tracks && els.length) {");
+    indent();
+    writeLine("pending++;");
+    writeLine("tween(els, tracks, options, done);");
+    dedent();
+    writeLine("}");
+    writeLine("done();");
+    writeLine("return animations;");
+    dedent();
+    writeLine("}");
+    writeLine();
+    
     writeLine("return { animate: animate };");
     dedent();
     writeLine("})();");
@@ -501,15 +1001,104 @@ void Generator::popState() {
     }
 }
 
+void Generator::visitAnimateNode(AnimateNode* node) {
+    generateAnimateCode(node);
+}
+
+void Generator::generateAnimateCode(AnimateNode* node) {
+    // CHTLAnimation.animate(目标, 关键帧, 逐帧轨道, 选项[, 回调])
+    auto lowered = AnimationLowering::lower(node);
+    
+    write("CHTLAnimation.animate(");
+    auto target = node->getTarget();
+    if (!target && node->getProperties().count("target")) {
+        target = node->getProperties().at("target");
+    }
+    if (target) {
+        target->accept(this);
+    } else {
+        write("null");
+    }
+    
+    write(", [");
+    if (!lowered.keyframes.empty()) {
+        if (!config_.minify) {
+            write(config_.lineEnding);
+        }
+        indent();
+        for (size_t i = 0; i < lowered.keyframes.size(); ++i) {
+            const auto& keyframe = lowered.keyframes[i];
+            std::string frame = "{offset: " + formatNumber(keyframe.offset);
+            for (const auto& [name, value] : keyframe.properties) {
+                frame += ", " + propertyKey(name) + ": " + quote(value);
+            }
+            writeLine(frame + "}" + (i + 1 < lowered.keyframes.size() ? "," : ""));
+        }
+        dedent();
+        write(getIndent());
+    }
+    write("], ");
+    
+    if (lowered.tracks.empty()) {
+        write("null");
+    } else {
+        std::string tracks = "{";
+        for (size_t i = 0; i < lowered.tracks.size(); ++i) {
+            const auto& track = lowered.tracks[i];
+            tracks += (i ? ", " : "") + track.property + ": [";
+            for (size_t j = 0; j < track.points.size(); ++j) {
+                tracks += (j ? ", [" : "[") + formatNumber(track.points[j].first) + ", " +
+                          formatNumber(track.points[j].second) + "]";
+            }
+            tracks += "]";
+        }
+        write(tracks + "}");
+    }
+    write(", ");
+    
+    generateAnimationOptions(node);
+    
+    const auto& properties = node->getProperties();
+    if (properties.count("callback")) {
+        write(", ");
+        properties.at("callback")->accept(this);
+    }
+    write(")");
+}
+
+void Generator::generateAnimationOptions(AnimateNode* node) {
+    const auto& properties = node->getProperties();
+    auto option = [&](const std::string& key, const std::string& name) {
+        if (properties.count(key)) {
+            write(", " + name + ": ");
+            properties.at(key)->accept(this);
+        }
+    };
+    
+    // 与原运行时一致，默认时长1000ms
+    write("{duration: ");
+    if (properties.count("duration")) {
+        properties.at("duration")->accept(this);
+    } else {
+        write("1000");
+    }
+    option("easing", "easing");
+    if (properties.count("loop") && AnimationLowering::isInfiniteLoop(properties.at("loop").get())) {
+        write(", iterations: Infinity");
+    } else {
+        option("loop", "iterations");
+    }
+    option("direction", "direction");
+    option("delay", "delay");
+    // begin状态在延迟期间生效，end状态在结束后保留
+    write(", fill: 'both'}");
+}
+
 // 其他访问者方法的空实现
 void Generator::visitDelegateNode(DelegateNode* node) { (void)node; }
-void Generator::visitAnimateNode(AnimateNode* node) { (void)node; }
 void Generator::visitAnimateStateNode(AnimateStateNode* node) { (void)node; }
 void Generator::visitVirtualObjectNode(VirtualObjectNode* node) { (void)node; }
 void Generator::visitINeverAwayNode(INeverAwayNode* node) { (void)node; }
-void Generator::visitUnaryExpressionNode(UnaryExpressionNode* node) { (void)node; }
-void Generator::visitFunctionDeclarationNode(FunctionDeclarationNode* node) { (void)node; }
-void Generator::visitArrayLiteralNode(ArrayLiteralNode* node) { (void)node; }
-void Generator::visitCallExpressionNode(CallExpressionNode* node) { (void)node; }
+
 
 } // namespace CHTLJS
\ No newline at end of file
@@ -17,6 +17,9 @@
 #include "../CHTLJSNode/OperatorNode.h"
 #include "../CHTLJSNode/JavaScriptNode.h"
 #include "../CHTLJSContext/Context.h"
+#include "SelectorHoisting.h"
+#include "EventCoalescing.h"
+#include "AnimationLowering.h"
 
 namespace CHTLJS {
 
@@ -28,10 +31,20 @@ struct GeneratorConfig {
     bool minify = false;                // 压缩输出
     std::string lineEnding = "\n";      // 行结束符
     bool wrapInIIFE = true;            // 包装在立即执行函数中
+    bool hoistSelectors = true;         // 静态增强选择器提升为页面级惰性句柄
+    bool coalesceEvents = true;         // 事件绑定合并为每种事件一个根监听器
 };
 
 // JavaScript生成器
-class Generator : public CompleteVisitor {
+class Generator : public CompleteVisitor,
+                  public ModuleVisitor,
+                  public SelectorVisitor,
+                  public ListenVisitor,
+                  public DelegateVisitor,
+                  public AnimateVisitor,
+                  public VirtualObjectVisitor,
+                  public OperatorVisitor,
+                  public JavaScriptVisitor {
 public:
     Generator(std::shared_ptr<CompileContext> context,
               const GeneratorConfig& config = GeneratorConfig());
@@ -76,13 +89,18 @@ private:
         bool inSelector = false;
         bool inEventDelegation = false;
         std::string currentVirtualObject;
-        std::unordered_map<std::string, std::string> selectorCache;
         std::unordered_map<std::string, std::string> virtualObjectCache;
     };
     
     std::stack<GeneratorState> stateStack_;
     GeneratorState currentState_;
     
+    // 页面级选择器句柄
+    SelectorHoisting selectorHoisting_;
+    
+    // 页面级事件分发表
+    EventCoalescing eventCoalescing_;
+    
     // 输出辅助方法
     void write(const std::string& text);
     void writeLine(const std::string& text = "");
@@ -93,6 +111,7 @@ private:
     // JavaScript生成方法
     void generateModuleLoader();
     void generateSelectorHelpers();
+    void generateSelectorHandles();
     void generateEventDelegationSystem();
     void generateAnimationHelpers();
     void generateVirtualObjectSystem();
@@ -102,14 +121,18 @@ private:
     std::string getSelectorFunction(EnhancedSelectorNode::SelectorType type);
     
     // listen块生成
-    void generateListenCode(ListenNode* node, const std::string& target);
+    void generateListenCode(ListenNode* node, ASTNode* target);
     
     // delegate块生成
-    void generateDelegateCode(DelegateNode* node, const std::string& parent);
+    void generateDelegateCode(DelegateNode* node, ASTNode* parent);
+    
+    // 单个事件绑定（链式调用的一环）
+    void generateEventBinding(const ASTNode* binding, ASTNode* target,
+                              const std::string& event, ASTNode* handler);
     
     // animate块生成
     void generateAnimateCode(AnimateNode* node);
-    std::string generateAnimationOptions(AnimateNode* node);
+    void generateAnimationOptions(AnimateNode* node);
     
     // 虚对象生成
     void generateVirtualObjectCode(VirtualObjectNode* node);
@@ -0,0 +1,127 @@
+#include "SelectorHoisting.h"
+#include <algorithm>
+
+namespace CHTLJS {
+
+void SelectorHoisting::analyze(ASTNode* root, const std::unordered_set<const ASTNode*>& excluded) {
+    handles_.clear();
+    handleIndex_.clear();
+    mutatesDOM_ = false;
+    observedAttributes_.clear();
+    observeAllAttributes_ = false;
+
+    excluded_ = &excluded;
+    if (root) {
+        visit(root);
+    }
+    excluded_ = nullptr;
+
+    // 快照句柄关注的属性
+    for (const auto& handle : handles_) {
+        if (handle.kind != HandleKind::SNAPSHOT) {
+            continue;
+        }
+        observeAttribute("id");
+        if (handle.type == EnhancedSelectorNode::SelectorType::COMPOUND) {
+            observeAttribute("class");
+            // 属性选择器可能依赖任意属性
+            if (handle.selector.find('[') != std::string::npos) {
+                observeAllAttributes_ = true;
+            }
+        }
+    }
+}
+
+void SelectorHoisting::visit(ASTNode* node) {
+    switch (node->getType()) {
+        case NodeType::ENHANCED_SELECTOR: {
+            auto* selector = static_cast<EnhancedSelectorNode*>(node);
+            if (isHoistable(selector) && !excluded_->count(node)) {
+                addHandle(selector);
+            }
+            break;
+        }
+        case NodeType::IDENTIFIER:
+            if (isMutatingName(static_cast<IdentifierNode*>(node)->getName())) {
+                mutatesDOM_ = true;
+            }
+            break;
+        default:
+            break;
+    }
+
+    for (const auto& child : node->getChildren()) {
+        if (child) {
+            visit(child.get());
+        } else {
+            // 解析器未能还原的代码，保守地认为会修改DOM
+            mutatesDOM_ = true;
+        }
+    }
+}
+
+void SelectorHoisting::addHandle(const EnhancedSelectorNode* node) {
+    auto it = handleIndex_.find(node->getSelector());
+    if (it != handleIndex_.end()) {
+        handles_[it->second].uses++;
+        return;
+    }
+
+    Handle handle;
+    handle.name = "h" + std::to_string(handles_.size());
+    handle.selector = node->getSelector();
+    handle.type = node->getSelectorType();
+    handle.kind = handle.type == EnhancedSelectorNode::SelectorType::CLASS ||
+                  handle.type == EnhancedSelectorNode::SelectorType::TAG
+                  ? HandleKind::LIVE : HandleKind::SNAPSHOT;
+    handle.uses = 1;
+    handleIndex_[handle.selector] = handles_.size();
+    handles_.push_back(std::move(handle));
+}
+
+void SelectorHoisting::observeAttribute(const std::string& name) {
+    if (std::find(observedAttributes_.begin(), observedAttributes_.end(), name) == observedAttributes_.end()) {
+        observedAttributes_.push_back(name);
+    }
+}
+
+const SelectorHoisting::Handle* SelectorHoisting::find(const EnhancedSelectorNode* node) const {
+    if (!isHoistable(node)) {
+        return nullptr;
+    }
+    auto it = handleIndex_.find(node->getSelector());
+    return it == handleIndex_.end() ? nullptr : &handles_[it->second];
+}
+
+bool SelectorHoisting::hasHandles(HandleKind kind) const {
+    return std::any_of(handles_.begin(), handles_.end(),
+                       [kind](const Handle& handle) { return handle.kind == kind; });
+}
+
+bool SelectorHoisting::isHoistable(const EnhancedSelectorNode* node) {
+    switch (node->getSelectorType()) {
+        case EnhancedSelectorNode::SelectorType::REFERENCE:
+            return false;
+        case EnhancedSelectorNode::SelectorType::COMPOUND:
+            // :hover、:checked等状态变化不产生DOM变更记录
+            return node->getSelector().find(':') == std::string::npos;
+        default:
+            return !node->getSelector().empty();
+    }
+}
+
+bool SelectorHoisting::isMutatingName(const std::string& name) {
+    static const std::unordered_set<std::string> names = {
+        // 结构修改
+        "appendChild", "insertBefore", "removeChild", "replaceChild",
+        "append", "prepend", "before", "after", "remove", "replaceWith", "replaceChildren",
+        "insertAdjacentElement", "insertAdjacentHTML",
+        "innerHTML", "outerHTML", "textContent", "innerText", "outerText", "write",
+        // 选择器相关的属性修改
+        "setAttribute", "removeAttribute", "toggleAttribute", "setAttributeNS", "removeAttributeNS",
+        "id", "className", "classList"
+    };
+    return names.count(name) > 0;
+}
+
+} // namespace CHTLJS
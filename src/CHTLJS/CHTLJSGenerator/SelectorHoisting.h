@@ -0,0 +1,75 @@
+#ifndef CHTLJS_SELECTOR_HOISTING_H
+#define CHTLJS_SELECTOR_HOISTING_H
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../CHTLJSNode/BaseNode.h"
+#include "../CHTLJSNode/SelectorNode.h"
+
+namespace CHTLJS {
+
+// 增强选择器提升分析
+// 生成前遍历整个页面的CHTL JS程序（所有script块合并后的AST），为每个不同的静态选择器
+// 分配一个页面级的惰性句柄，所有引用处共享同一次查询结果。索引访问（{{.box[0]}}）
+// 与不带索引的引用共用句柄，在引用处取下标。
+//   - 类、标签选择器查询得到动态集合（HTMLCollection），DOM变化会自动反映，句柄永不失效
+//   - ID和复合选择器的结果是快照；CHTL JS代码可能修改DOM时在DOM变化后重新查询，
+//     并且只关注会影响这些选择器的属性。纯JS片段和外部脚本不在分析范围内，
+//     因此快照为空或含已脱离文档的元素时总是重新查询
+//   - & 引用选择器依赖当前元素，含伪类的复合选择器依赖交互状态，二者不提升
+class SelectorHoisting {
+public:
+    enum class HandleKind {
+        LIVE,       // 动态集合，首次查询后永久缓存
+        SNAPSHOT    // 快照，DOM变化后失效
+    };
+
+    struct Handle {
+        std::string name;           // 句柄名（h0, h1, ...）
+        std::string selector;
+        EnhancedSelectorNode::SelectorType type;
+        HandleKind kind;
+        size_t uses = 0;            // 引用次数
+    };
+
+    // 分析程序，重新建立句柄表；excluded中的选择器节点不会被求值（如已合并的事件绑定目标）
+    void analyze(ASTNode* root, const std::unordered_set<const ASTNode*>& excluded = {});
+
+    // 选择器对应的句柄，不提升时返回nullptr
+    const Handle* find(const EnhancedSelectorNode* node) const;
+
+    const std::vector<Handle>& getHandles() const { return handles_; }
+
+    // 页面代码是否可能修改DOM（含无法分析的代码）
+    bool mutatesDOM() const { return mutatesDOM_; }
+
+    // 快照句柄需要观察的属性；observeAllAttributes()为true时观察全部属性
+    const std::vector<std::string>& getObservedAttributes() const { return observedAttributes_; }
+    bool observeAllAttributes() const { return observeAllAttributes_; }
+
+    bool hasHandles(HandleKind kind) const;
+
+    // 选择器是否可以提升
+    static bool isHoistable(const EnhancedSelectorNode* node);
+
+private:
+    std::vector<Handle> handles_;
+    std::unordered_map<std::string, size_t> handleIndex_;
+    bool mutatesDOM_ = false;
+    std::vector<std::string> observedAttributes_;
+    bool observeAllAttributes_ = false;
+    const std::unordered_set<const ASTNode*>* excluded_ = nullptr;
+
+    void visit(ASTNode* node);
+    void addHandle(const EnhancedSelectorNode* node);
+    void observeAttribute(const std::string& name);
+
+    // 会修改DOM结构或id/class等属性的DOM API
+    static bool isMutatingName(const std::string& name);
+};
+
+} // namespace CHTLJS
+
+#endif // CHTLJS_SELECTOR_HOISTING_H
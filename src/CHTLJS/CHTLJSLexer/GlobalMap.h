@@ -7,6 +7,7 @@
 #include <memory>
 #include <vector>
 #include <optional>
+#include "../../Util/ScopedInstance.h"
 
 namespace CHTLJS {
 
@@ -119,6 +120,9 @@ private:
 class GlobalMap {
 public:
     static GlobalMap& getInstance() {
+        if (auto* scoped = CHTL::ScopedInstance<GlobalMap>::current()) {
+            return *scoped;
+        }
         static GlobalMap instance;
         return instance;
     }
@@ -163,6 +167,7 @@ public:
     void clear();
     
 private:
+    friend class CHTL::ScopedInstance<GlobalMap>;
     GlobalMap() = default;
     GlobalMap(const GlobalMap&) = delete;
     GlobalMap& operator=(const GlobalMap&) = delete;
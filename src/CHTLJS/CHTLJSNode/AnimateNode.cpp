@@ -0,0 +1,33 @@
+#include "AnimateNode.h"
+
+namespace CHTLJS {
+
+// AnimateNode实现
+void AnimateNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<AnimateVisitor*>(visitor)) {
+        v->visitAnimateNode(this);
+    }
+}
+
+std::string AnimateNode::toString() const {
+    return "AnimateNode(properties=" + std::to_string(properties_.size()) +
+           ", when=" + std::to_string(whenStates_.size()) + ")";
+}
+
+// AnimateStateNode实现
+void AnimateStateNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<AnimateVisitor*>(visitor)) {
+        v->visitAnimateStateNode(this);
+    }
+}
+
+std::string AnimateStateNode::toString() const {
+    static const char* names[] = {"begin", "when", "end"};
+    std::string result = std::string("AnimateStateNode(") + names[static_cast<int>(stateType_)];
+    if (at_.has_value()) {
+        result += ", at=" + std::to_string(at_.value());
+    }
+    return result + ", properties=" + std::to_string(properties_.size()) + ")";
+}
+
+} // namespace CHTLJS
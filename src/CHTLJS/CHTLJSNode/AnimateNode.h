@@ -115,7 +115,7 @@ private:
 };
 
 // 扩展访问者接口
-class AnimateVisitor : public Visitor {
+class AnimateVisitor : public virtual Visitor {
 public:
     virtual void visitAnimateNode(AnimateNode* node) = 0;
     virtual void visitAnimateStateNode(AnimateStateNode* node) = 0;
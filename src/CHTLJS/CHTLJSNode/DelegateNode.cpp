@@ -0,0 +1,16 @@
+#include "DelegateNode.h"
+
+namespace CHTLJS {
+
+// DelegateNode实现
+void DelegateNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<DelegateVisitor*>(visitor)) {
+        v->visitDelegateNode(this);
+    }
+}
+
+std::string DelegateNode::toString() const {
+    return "DelegateNode(events=" + std::to_string(eventHandlers_.size()) + ")";
+}
+
+} // namespace CHTLJS
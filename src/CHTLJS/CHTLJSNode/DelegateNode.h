@@ -49,7 +49,7 @@ private:
 };
 
 // 扩展访问者接口
-class DelegateVisitor : public Visitor {
+class DelegateVisitor : public virtual Visitor {
 public:
     virtual void visitDelegateNode(DelegateNode* node) = 0;
 };
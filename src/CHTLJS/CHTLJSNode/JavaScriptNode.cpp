@@ -0,0 +1,60 @@
+#include "JavaScriptNode.h"
+
+namespace CHTLJS {
+
+// FunctionDeclarationNode实现
+void FunctionDeclarationNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<JavaScriptVisitor*>(visitor)) {
+        v->visitFunctionDeclarationNode(this);
+    }
+}
+
+std::string FunctionDeclarationNode::toString() const {
+    return "FunctionDeclarationNode(" + name_ + ", params=" + std::to_string(parameters_.size()) + ")";
+}
+
+// VariableDeclarationNode实现
+void VariableDeclarationNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<JavaScriptVisitor*>(visitor)) {
+        v->visitVariableDeclarationNode(this);
+    }
+}
+
+std::string VariableDeclarationNode::toString() const {
+    return "VariableDeclarationNode(" + name_ + ")";
+}
+
+// ObjectLiteralNode实现
+void ObjectLiteralNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<JavaScriptVisitor*>(visitor)) {
+        v->visitObjectLiteralNode(this);
+    }
+}
+
+std::string ObjectLiteralNode::toString() const {
+    return "ObjectLiteralNode(properties=" + std::to_string(properties_.size()) + ")";
+}
+
+// ArrayLiteralNode实现
+void ArrayLiteralNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<JavaScriptVisitor*>(visitor)) {
+        v->visitArrayLiteralNode(this);
+    }
+}
+
+std::string ArrayLiteralNode::toString() const {
+    return "ArrayLiteralNode(elements=" + std::to_string(elements_.size()) + ")";
+}
+
+// CallExpressionNode实现
+void CallExpressionNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<JavaScriptVisitor*>(visitor)) {
+        v->visitCallExpressionNode(this);
+    }
+}
+
+std::string CallExpressionNode::toString() const {
+    return "CallExpressionNode(" + callee_->toString() + ", args=" + std::to_string(arguments_.size()) + ")";
+}
+
+} // namespace CHTLJS
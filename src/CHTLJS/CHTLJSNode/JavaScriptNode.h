@@ -174,7 +174,7 @@ private:
 };
 
 // 扩展访问者接口
-class JavaScriptVisitor : public Visitor {
+class JavaScriptVisitor : public virtual Visitor {
 public:
     virtual void visitFunctionDeclarationNode(FunctionDeclarationNode* node) = 0;
     virtual void visitVariableDeclarationNode(VariableDeclarationNode* node) = 0;
@@ -0,0 +1,16 @@
+#include "ListenNode.h"
+
+namespace CHTLJS {
+
+// ListenNode实现
+void ListenNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<ListenVisitor*>(visitor)) {
+        v->visitListenNode(this);
+    }
+}
+
+std::string ListenNode::toString() const {
+    return "ListenNode(events=" + std::to_string(eventHandlers_.size()) + ")";
+}
+
+} // namespace CHTLJS
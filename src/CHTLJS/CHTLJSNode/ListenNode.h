@@ -37,7 +37,7 @@ private:
 };
 
 // 扩展访问者接口
-class ListenVisitor : public Visitor {
+class ListenVisitor : public virtual Visitor {
 public:
     virtual void visitListenNode(ListenNode* node) = 0;
 };
@@ -57,7 +57,7 @@ private:
 };
 
 // 扩展访问者接口
-class ModuleVisitor : public Visitor {
+class ModuleVisitor : public virtual Visitor {
 public:
     virtual void visitModuleNode(ModuleNode* node) = 0;
 };
@@ -0,0 +1,51 @@
+#include "OperatorNode.h"
+
+namespace CHTLJS {
+
+// ArrowAccessNode实现
+void ArrowAccessNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<OperatorVisitor*>(visitor)) {
+        v->visitArrowAccessNode(this);
+    }
+}
+
+std::string ArrowAccessNode::toString() const {
+    return "ArrowAccessNode(" + object_->toString() + " -> " + property_->toString() + ")";
+}
+
+// EventBindingNode实现
+void EventBindingNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<OperatorVisitor*>(visitor)) {
+        v->visitEventBindingNode(this);
+    }
+}
+
+std::string EventBindingNode::toString() const {
+    return "EventBindingNode(" + selector_->toString() + " &-> " + event_ + ")";
+}
+
+// BinaryExpressionNode实现
+void BinaryExpressionNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<OperatorVisitor*>(visitor)) {
+        v->visitBinaryExpressionNode(this);
+    }
+}
+
+std::string BinaryExpressionNode::toString() const {
+    return "BinaryExpressionNode(" + std::to_string(static_cast<int>(operator_)) + ", " +
+           left_->toString() + ", " + right_->toString() + ")";
+}
+
+// UnaryExpressionNode实现
+void UnaryExpressionNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<OperatorVisitor*>(visitor)) {
+        v->visitUnaryExpressionNode(this);
+    }
+}
+
+std::string UnaryExpressionNode::toString() const {
+    return "UnaryExpressionNode(" + std::to_string(static_cast<int>(operator_)) + ", " +
+           operand_->toString() + ")";
+}
+
+} // namespace CHTLJS
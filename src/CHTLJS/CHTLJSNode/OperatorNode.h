@@ -125,7 +125,7 @@ private:
 };
 
 // 扩展访问者接口
-class OperatorVisitor : public Visitor {
+class OperatorVisitor : public virtual Visitor {
 public:
     virtual void visitArrowAccessNode(ArrowAccessNode* node) = 0;
     virtual void visitEventBindingNode(EventBindingNode* node) = 0;
@@ -0,0 +1,30 @@
+#include "ProgramNode.h"
+#include <sstream>
+
+namespace CHTLJS {
+
+// ProgramNode实现
+void ProgramNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<CompleteVisitor*>(visitor)) {
+        v->visitProgramNode(this);
+    }
+}
+
+std::string ProgramNode::toString() const {
+    std::stringstream ss;
+    ss << "ProgramNode(" << filename_ << ", statements=" << statements_.size() << ")";
+    return ss.str();
+}
+
+// StatementNode实现
+void StatementNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<CompleteVisitor*>(visitor)) {
+        v->visitStatementNode(this);
+    }
+}
+
+std::string StatementNode::toString() const {
+    return "StatementNode(" + (expression_ ? expression_->toString() : std::string()) + ")";
+}
+
+} // namespace CHTLJS
@@ -57,7 +57,7 @@ private:
 };
 
 // 完整的访问者接口 - 简化版本
-class CompleteVisitor : public Visitor {
+class CompleteVisitor : public virtual Visitor {
 public:
     virtual void visitProgramNode(ProgramNode* node) = 0;
     virtual void visitStatementNode(StatementNode* node) = 0;
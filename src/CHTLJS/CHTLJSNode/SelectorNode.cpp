@@ -0,0 +1,20 @@
+#include "SelectorNode.h"
+
+namespace CHTLJS {
+
+// EnhancedSelectorNode实现
+void EnhancedSelectorNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<SelectorVisitor*>(visitor)) {
+        v->visitEnhancedSelectorNode(this);
+    }
+}
+
+std::string EnhancedSelectorNode::toString() const {
+    std::string result = "EnhancedSelectorNode({{" + selector_;
+    if (index_.has_value()) {
+        result += "[" + std::to_string(index_.value()) + "]";
+    }
+    return result + "}})";
+}
+
+} // namespace CHTLJS
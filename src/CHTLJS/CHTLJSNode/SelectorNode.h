@@ -44,7 +44,7 @@ private:
 };
 
 // 扩展访问者接口
-class SelectorVisitor : public Visitor {
+class SelectorVisitor : public virtual Visitor {
 public:
     virtual void visitEnhancedSelectorNode(EnhancedSelectorNode* node) = 0;
 };
@@ -0,0 +1,27 @@
+#include "VirtualObjectNode.h"
+
+namespace CHTLJS {
+
+// VirtualObjectNode实现
+void VirtualObjectNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<VirtualObjectVisitor*>(visitor)) {
+        v->visitVirtualObjectNode(this);
+    }
+}
+
+std::string VirtualObjectNode::toString() const {
+    return "VirtualObjectNode(" + name_ + ")";
+}
+
+// INeverAwayNode实现
+void INeverAwayNode::accept(Visitor* visitor) {
+    if (auto* v = dynamic_cast<VirtualObjectVisitor*>(visitor)) {
+        v->visitINeverAwayNode(this);
+    }
+}
+
+std::string INeverAwayNode::toString() const {
+    return "INeverAwayNode(keys=" + std::to_string(keyDefinitions_.size()) + ")";
+}
+
+} // namespace CHTLJS
@@ -78,7 +78,7 @@ private:
 };
 
 // 扩展访问者接口
-class VirtualObjectVisitor : public Visitor {
+class VirtualObjectVisitor : public virtual Visitor {
 public:
     virtual void visitVirtualObjectNode(VirtualObjectNode* node) = 0;
     virtual void visitINeverAwayNode(INeverAwayNode* node) = 0;
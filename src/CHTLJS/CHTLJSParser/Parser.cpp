@@ -503,7 +503,10 @@ std::shared_ptr<ASTNode> Parser::parsePrimary() {
     
     // 标识符
     if (check(TokenType::IDENTIFIER)) {
-        return std::make_shared<IdentifierNode>(parseIdentifier(), previous_->getLocation());
+        // 位置要在消耗标识符之前取；参数求值顺序不确定，且首个记号之前previous_为空
+        auto location = current_->getLocation();
+        auto name = parseIdentifier();
+        return std::make_shared<IdentifierNode>(name, location);
     }
     
     // 括号表达式
@@ -143,8 +143,8 @@ std::unordered_map<StateType, std::vector<StateType>> StateManager::initTransiti
 }
 
 StateManager::StateManager() {
-    // 初始化为全局状态
-    pushState(StateType::GLOBAL, "global");
+    // 初始化为全局状态（初始状态不经过转换规则检查）
+    stateStack_.emplace(StateType::GLOBAL, "global", 0, 0);
 }
 
 void StateManager::pushState(StateType type, const std::string& name, 
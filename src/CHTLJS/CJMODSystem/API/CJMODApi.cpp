@@ -1,4 +1,5 @@
 #include "CJMODApi.h"
+#include "../Runtime/CJMODRuntime.h"
 #include <iostream>
 #include <sstream>
 #include <regex>
@@ -312,8 +313,13 @@ Arg CJMODScanner::scan(const Arg& /*pattern*/, const std::string& keyword) {
             // result = std::move(pattern); // TODO: Implement proper pattern matching
         }
     } else {
-        // 扫描整个模式
-        // result = std::move(pattern); // TODO: Implement proper pattern matching
+        // 未指定关键字：用已加载模块的关键字自动机找下一处CJMOD语法，
+        // 不必对每条语法分别find
+        SyntaxMatch match;
+        if (CJMODRuntime::getInstance().findFirstSyntaxMatch(scanContext, scanPosition, match)) {
+            result.push(scanContext.substr(match.position, match.length));
+            scanPosition = match.position + match.length;
+        }
     }
     
     return result;
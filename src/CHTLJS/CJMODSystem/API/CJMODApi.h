@@ -153,7 +153,7 @@ public:
 // 统一扫描器
 class CJMOD_API CJMODScanner {
 public:
-    // 扫描语法片段
+    // 扫描语法片段；未指定关键字时找下一处已加载模块的CJMOD语法
     static Arg scan(const Arg& pattern, const std::string& keyword = "");
     
     // 双指针扫描
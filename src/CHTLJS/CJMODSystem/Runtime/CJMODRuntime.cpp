@@ -1,8 +1,11 @@
 #include "CJMODRuntime.h"
 #include "../../../Error/ErrorReport.h"
+#include "../../../Util/ZIPUtil/ZIPUtil.h"
 #include <fstream>
 #include <regex>
 #include <filesystem>
+#include <cstring>
+#include <algorithm>
 // TODO: Replace with proper JSON library
 // #include <json/json.h>  // 假设使用jsoncpp
 
@@ -14,6 +17,57 @@
 
 namespace CHTL {
 
+namespace {
+
+// 正则开头的字面量部分，如 printMylove\s*\{ 得到 printMylove
+// 遇到第一个元字符或字符类转义即停止；若后面跟着 * ? {，最后一个字符可以不出现，也去掉
+std::string literalPrefix(const std::string& regex) {
+    static const char* meta = ".*+?()[]{}|^$";
+    
+    size_t i = 0;
+    if (!regex.empty() && regex[0] == '^') {
+        i = 1;
+    }
+    if (regex.compare(i, 2, "\\b") == 0) {
+        i += 2;
+    }
+    
+    std::string literal;
+    for (; i < regex.size(); ++i) {
+        char c = regex[i];
+        if (c == '\\') {
+            if (i + 1 < regex.size() && std::strchr(".*+?()[]{}|^$\\/-", regex[i + 1])) {
+                literal += regex[++i];
+                continue;
+            }
+            break;
+        }
+        if (std::strchr(meta, c)) {
+            if ((c == '*' || c == '?' || c == '{') && !literal.empty()) {
+                literal.pop_back();
+            }
+            break;
+        }
+        literal += c;
+    }
+    return literal;
+}
+
+// 语法定义中的字符串按JSON转义书写
+std::string unescapeJSON(const std::string& text) {
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\\' && i + 1 < text.size() && (text[i + 1] == '\\' || text[i + 1] == '"' || text[i + 1] == '/')) {
+            ++i;
+        }
+        result += text[i];
+    }
+    return result;
+}
+
+} // namespace
+
 // CJMODRuntimeContext implementation
 std::string CJMODRuntimeContext::getCompilerVersion() const {
     return "1.0.0";
@@ -95,18 +149,34 @@ bool CJMODRuntime::loadModule(const std::string& path) {
         return false;
     }
     
+    // 语法定义：包内的 syntax/<语法名>.json
+    ZIPArchiveView archive;
+    if (!archive.open(path)) {
+        ErrorBuilder(ErrorLevel::ERROR, ErrorType::IO_ERROR)
+            .withMessage("Cannot open CJMOD file")
+            .withDetail(archive.getLastError())
+            .atLocation(path, 0, 0)
+            .report();
+        return false;
+    }
+    for (const auto& entry : archive.getFileList()) {
+        const std::string& entryName = entry.filename;
+        if (entry.isDirectory || entryName.rfind("syntax/", 0) != 0 ||
+            std::filesystem::path(entryName).extension() != ".json") {
+            continue;
+        }
+        if (auto content = archive.getEntry(entryName)) {
+            info.syntaxDefinitions[std::filesystem::path(entryName).stem().string()] = std::string(*content);
+        }
+    }
+    
     // 如果有C++扩展，加载动态库
     if (info.hasExtension) {
         return loadModule(info, info.extensionPath);
     }
     
     // 只有语法定义，直接加载
-    LoadedModule module;
-    module.info = info;
-    module.syntaxPatterns = parseSyntaxDefinitions(info.syntaxDefinitions);
-    
-    modules_[info.name] = std::move(module);
-    return true;
+    return loadModule(info, std::unique_ptr<CJMODExtension>());
 }
 
 bool CJMODRuntime::loadModule(const CJMODInfo& info, const std::string& extensionPath) {
@@ -137,11 +207,34 @@ bool CJMODRuntime::loadModule(const CJMODInfo& info, const std::string& extensio
     module.syntaxPatterns = parseSyntaxDefinitions(info.syntaxDefinitions);
     
     modules_[info.name] = std::move(module);
+    rebuildKeywordIndex();
     
     context_->log("Loaded CJMOD: " + info.name + " v" + info.version);
     return true;
 }
 
+bool CJMODRuntime::loadModule(const CJMODInfo& info, std::unique_ptr<CJMODExtension> extension) {
+    if (modules_.find(info.name) != modules_.end()) {
+        ErrorBuilder(ErrorLevel::WARNING, ErrorType::REFERENCE_ERROR)
+            .withMessage("Module already loaded: " + info.name)
+            .report();
+        return false;
+    }
+    
+    if (extension && !extension->initialize(context_.get())) {
+        return false;
+    }
+    
+    LoadedModule module;
+    module.info = info;
+    module.extension = std::move(extension);
+    module.syntaxPatterns = parseSyntaxDefinitions(info.syntaxDefinitions);
+    
+    modules_[info.name] = std::move(module);
+    rebuildKeywordIndex();
+    return true;
+}
+
 std::vector<SyntaxPattern> CJMODRuntime::getAllSyntaxPatterns() const {
     std::vector<SyntaxPattern> allPatterns;
     
@@ -160,15 +253,115 @@ ProcessResult CJMODRuntime::processFragment(
     const std::string& fragment,
     const std::map<std::string, std::string>& captures
 ) {
-    ProcessResult result;
-    
     auto it = modules_.find(moduleName);
     if (it == modules_.end()) {
+        ProcessResult result;
         result.errorMessage = "Module not found: " + moduleName;
         return result;
     }
     
-    const auto& module = it->second;
+    return processWith(it->second, syntaxName, fragment, captures);
+}
+
+ProcessResult CJMODRuntime::expandSyntax(const std::string& code) {
+    ProcessResult result;
+    result.success = true;
+    std::string& output = result.generatedCode;
+    output.reserve(code.size());
+    
+    size_t copied = 0;
+    size_t from = 0;
+    SyntaxMatch match;
+    while (findFirstSyntaxMatch(code, from, match)) {
+        const auto& target = syntaxTargets_[match.target];
+        size_t end = match.position + match.length;
+        from = end;
+        
+        std::map<std::string, std::string> captures;
+        if (target.hasExtent) {
+            std::smatch extent;
+            if (!std::regex_search(code.begin() + match.position, code.end(), extent, target.extent,
+                                   std::regex_constants::match_continuous)) {
+                // 只是同名的标识符，不是这条语法
+                continue;
+            }
+            end = std::max(end, match.position + static_cast<size_t>(extent.length(0)));
+            from = end;
+            const auto& names = target.pattern->captureGroups;
+            for (size_t i = 1; i < extent.size(); ++i) {
+                captures[i <= names.size() ? names[i - 1] : std::to_string(i)] = extent[i].str();
+            }
+        }
+        
+        auto processed = processMatch(match, code.substr(match.position, end - match.position), captures);
+        if (!processed.success) {
+            // 处理失败的片段保留原文，继续展开其余的
+            result.success = false;
+            if (!result.errorMessage.empty()) {
+                result.errorMessage += "\n";
+            }
+            result.errorMessage += target.module->info.name + "." + target.pattern->name + ": " +
+                                   processed.errorMessage;
+            continue;
+        }
+        
+        output.append(code, copied, match.position - copied);
+        output += processed.generatedCode;
+        result.dependencies.insert(result.dependencies.end(),
+                                   processed.dependencies.begin(), processed.dependencies.end());
+        copied = end;
+    }
+    output.append(code, copied, std::string::npos);
+    return result;
+}
+
+std::vector<SyntaxMatch> CJMODRuntime::findSyntaxMatches(std::string_view fragment) const {
+    std::vector<SyntaxMatch> matches;
+    for (const auto& hit : keywordMatcher_.scan(fragment)) {
+        matches.push_back({hit.position, hit.length, hit.id});
+    }
+    return matches;
+}
+
+bool CJMODRuntime::findFirstSyntaxMatch(std::string_view fragment, size_t from, SyntaxMatch& match) const {
+    KeywordMatch hit;
+    if (!keywordMatcher_.findFirst(fragment, from, hit)) {
+        return false;
+    }
+    match = {hit.position, hit.length, hit.id};
+    return true;
+}
+
+const SyntaxPattern& CJMODRuntime::getMatchedSyntax(const SyntaxMatch& match) const {
+    return *syntaxTargets_[match.target].pattern;
+}
+
+const std::string& CJMODRuntime::getMatchedModule(const SyntaxMatch& match) const {
+    return syntaxTargets_[match.target].module->info.name;
+}
+
+ProcessResult CJMODRuntime::processMatch(
+    const SyntaxMatch& match,
+    const std::string& fragment,
+    const std::map<std::string, std::string>& captures
+) {
+    if (match.target >= syntaxTargets_.size()) {
+        ProcessResult result;
+        result.errorMessage = "Stale CJMOD syntax match";
+        return result;
+    }
+    
+    const auto& target = syntaxTargets_[match.target];
+    return processWith(*target.module, target.pattern->name, fragment, captures);
+}
+
+ProcessResult CJMODRuntime::processWith(
+    LoadedModule& module,
+    const std::string& syntaxName,
+    const std::string& fragment,
+    const std::map<std::string, std::string>& captures
+) {
+    ProcessResult result;
     
     // 如果有C++扩展，调用它
     if (module.extension) {
@@ -187,6 +380,51 @@ ProcessResult CJMODRuntime::processFragment(
     return result;
 }
 
+void CJMODRuntime::rebuildKeywordIndex() {
+    keywordMatcher_.clear();
+    syntaxTargets_.clear();
+    
+    for (auto& [name, module] : modules_) {
+        for (const auto& pattern : module.syntaxPatterns) {
+            if (pattern.keyword.empty()) {
+                ErrorBuilder(ErrorLevel::WARNING, ErrorType::SYNTAX_ERROR)
+                    .withMessage("CJMOD syntax has no literal keyword and will never be matched: " +
+                                 name + "." + pattern.name)
+                    .report();
+                continue;
+            }
+            
+            // 正则在加载时编译一次，展开时从关键字处直接匹配
+            SyntaxTarget target{&module, &pattern, std::regex(), false};
+            if (!pattern.regex.empty()) {
+                try {
+                    target.extent = std::regex(unescapeJSON(pattern.regex));
+                    target.hasExtent = true;
+                } catch (const std::regex_error& e) {
+                    ErrorBuilder(ErrorLevel::WARNING, ErrorType::SYNTAX_ERROR)
+                        .withMessage("Invalid CJMOD syntax pattern: " + name + "." + pattern.name)
+                        .withDetail(e.what())
+                        .report();
+                    continue;
+                }
+            }
+            
+            uint32_t id = keywordMatcher_.add(pattern.keyword);
+            if (id < syntaxTargets_.size()) {
+                // 先加载（按模块名排序）的模块优先
+                ErrorBuilder(ErrorLevel::WARNING, ErrorType::REFERENCE_ERROR)
+                    .withMessage("CJMOD keyword '" + pattern.keyword + "' of " + name + "." + pattern.name +
+                                 " is already provided by " + syntaxTargets_[id].module->info.name)
+                    .report();
+                continue;
+            }
+            syntaxTargets_.push_back(std::move(target));
+        }
+    }
+    
+    keywordMatcher_.build();
+}
+
 void CJMODRuntime::unloadModule(const std::string& moduleName) {
     auto it = modules_.find(moduleName);
     if (it == modules_.end()) {
@@ -204,7 +442,10 @@ void CJMODRuntime::unloadModule(const std::string& moduleName) {
     }
     
     modules_.erase(it);
-    context_->log("Unloaded CJMOD: " + moduleName);
+    rebuildKeywordIndex();
+    if (context_) {
+        context_->log("Unloaded CJMOD: " + moduleName);
+    }
 }
 
 void CJMODRuntime::unloadAll() {
@@ -219,6 +460,8 @@ void CJMODRuntime::unloadAll() {
     }
     
     modules_.clear();
+    keywordMatcher_.clear();
+    syntaxTargets_.clear();
 }
 
 void* CJMODRuntime::loadDynamicLibrary(const std::string& path) {
@@ -307,22 +550,44 @@ std::vector<SyntaxPattern> CJMODRuntime::parseSyntaxDefinitions(
             pattern.name = name;
             
             // Simple regex extraction (find pattern between quotes)
-            std::regex patternRegex(R"(\"pattern\"\s*:\s*\"([^\"]*)\"))");
+            std::regex patternRegex(R"(\"pattern\"\s*:\s*\"([^\"]*)\")");
             std::smatch match;
             if (std::regex_search(jsonStr, match, patternRegex)) {
                 pattern.regex = match[1];
             }
             
             // Simple processor extraction
-            std::regex processorRegex(R"(\"processor\"\s*:\s*\"([^\"]*)\"))");
+            std::regex processorRegex(R"(\"processor\"\s*:\s*\"([^\"]*)\")");
             if (std::regex_search(jsonStr, match, processorRegex)) {
                 pattern.processor = match[1];
             }
             
+            // 捕获组名称，按顺序对应正则中的分组
+            std::regex groupsRegex(R"(\"captureGroups\"\s*:\s*\[([^\]]*)\])");
+            if (std::regex_search(jsonStr, match, groupsRegex)) {
+                std::string groups = match[1];
+                std::regex nameRegex(R"(\"([^\"]*)\")");
+                for (auto it = std::sregex_iterator(groups.begin(), groups.end(), nameRegex);
+                     it != std::sregex_iterator(); ++it) {
+                    pattern.captureGroups.push_back((*it)[1]);
+                }
+            }
+            
+            // 触发关键字：显式给出的优先，否则取正则开头的字面量
+            std::regex keywordRegex(R"(\"keyword\"\s*:\s*\"([^\"]*)\")");
+            if (std::regex_search(jsonStr, match, keywordRegex)) {
+                pattern.keyword = unescapeJSON(match[1]);
+            } else {
+                pattern.keyword = literalPrefix(unescapeJSON(pattern.regex));
+            }
+            
             patterns.push_back(pattern);
             
         } catch (const std::exception& e) {
-            context_->logError("Error parsing syntax definition " + name + ": " + e.what());
+            ErrorBuilder(ErrorLevel::ERROR, ErrorType::SYNTAX_ERROR)
+                .withMessage("Error parsing syntax definition " + name)
+                .withDetail(e.what())
+                .report();
         }
     }
     
@@ -2,11 +2,14 @@
 #define CJMOD_RUNTIME_H
 
 #include <string>
+#include <string_view>
 #include <memory>
 #include <vector>
 #include <map>
 #include <functional>
+#include <regex>
 #include "../CJMODPackager.h"
+#include "../../../Util/KeywordMatcher/KeywordMatcher.h"
 
 namespace CHTL {
 
@@ -18,6 +21,7 @@ class CJMODRuntimeContext;
 struct SyntaxPattern {
     std::string name;                          // 语法名称
     std::string regex;                         // 正则表达式
+    std::string keyword;                       // 触发关键字（未给出时取正则开头的字面量）
     std::vector<std::string> captureGroups;    // 捕获组名称
     std::string processor;                     // 处理器函数名
     std::map<std::string, std::string> options;// 额外选项
@@ -32,6 +36,14 @@ struct ProcessResult {
     std::map<std::string, std::string> metadata;  // 元数据
 };
 
+// 片段中找到的CJMOD语法
+// target是运行时分派表的下标，在下一次加载或卸载模块之前有效
+struct SyntaxMatch {
+    size_t position = 0;   // 关键字在片段中的位置
+    size_t length = 0;     // 关键字长度
+    uint32_t target = 0;
+};
+
 // CJMOD扩展接口（C++扩展需要实现）
 class CJMODExtension {
 public:
@@ -99,6 +111,8 @@ public:
     // 加载CJMOD
     bool loadModule(const std::string& path);
     bool loadModule(const CJMODInfo& info, const std::string& extensionPath);
+    // 加载进程内的扩展（静态链接的扩展；extension为空时只有语法定义）
+    bool loadModule(const CJMODInfo& info, std::unique_ptr<CJMODExtension> extension);
     
     // 获取所有语法模式
     std::vector<SyntaxPattern> getAllSyntaxPatterns() const;
@@ -111,6 +125,28 @@ public:
         const std::map<std::string, std::string>& captures
     );
     
+    // 是否有可匹配的语法
+    bool hasSyntax() const { return !syntaxTargets_.empty(); }
+    
+    // 展开CHTL JS代码中的CJMOD语法：单遍扫描找出关键字，用语法的正则确定片段范围，
+    // 交给所属扩展处理并替换为生成的代码。generatedCode为展开后的完整代码
+    ProcessResult expandSyntax(const std::string& code);
+    
+    // 单遍扫描片段，找出所有已加载模块的语法关键字
+    std::vector<SyntaxMatch> findSyntaxMatches(std::string_view fragment) const;
+    bool findFirstSyntaxMatch(std::string_view fragment, size_t from, SyntaxMatch& match) const;
+    
+    // 匹配对应的语法和所属模块
+    const SyntaxPattern& getMatchedSyntax(const SyntaxMatch& match) const;
+    const std::string& getMatchedModule(const SyntaxMatch& match) const;
+    
+    // 直接交给匹配所属的扩展处理，不再按模块名查找
+    ProcessResult processMatch(
+        const SyntaxMatch& match,
+        const std::string& fragment,
+        const std::map<std::string, std::string>& captures
+    );
+    
     // 卸载模块
     void unloadModule(const std::string& moduleName);
     void unloadAll();
@@ -134,9 +170,29 @@ private:
         std::vector<SyntaxPattern> syntaxPatterns;
     };
     
+    // 分派表：关键字编号即下标
+    struct SyntaxTarget {
+        LoadedModule* module = nullptr;
+        const SyntaxPattern* pattern = nullptr;
+        std::regex extent;          // 从关键字处开始匹配，确定语法片段的范围
+        bool hasExtent = false;     // 没有正则时片段只有关键字本身
+    };
+    
     std::map<std::string, LoadedModule> modules_;
     std::shared_ptr<CJMODRuntimeContext> context_;
     
+    // 所有模块的语法关键字及其正则，模块加载或卸载后重建
+    KeywordMatcher keywordMatcher_;
+    std::vector<SyntaxTarget> syntaxTargets_;
+    
+    void rebuildKeywordIndex();
+    ProcessResult processWith(
+        LoadedModule& module,
+        const std::string& syntaxName,
+        const std::string& fragment,
+        const std::map<std::string, std::string>& captures
+    );
+    
     // 加载动态库
     void* loadDynamicLibrary(const std::string& path);
     void unloadDynamicLibrary(void* handle);
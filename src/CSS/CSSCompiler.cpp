@@ -3,6 +3,8 @@
 #include "generated/src/CSS/CSSSimpleParser.h"
 #include "generated/src/CSS/CSSSimpleBaseVisitor.h"
 #include "../Error/ErrorReport.h"
+#include "../Util/ANTLRUtil/TwoStageParse.h"
+#include "CSSMinifier.h"
 #include <antlr4-runtime.h>
 #include <sstream>
 
@@ -106,29 +108,16 @@ public:
     }
 };
 
-// 错误监听器
-class CSSErrorListener : public BaseErrorListener {
-private:
-    std::vector<std::string>& errors_;
-    
-public:
-    CSSErrorListener(std::vector<std::string>& errors) : errors_(errors) {}
-    
-    void syntaxError(Recognizer *recognizer, Token *offendingSymbol,
-                    size_t line, size_t charPositionInLine,
-                    const std::string &msg, std::exception_ptr e) override {
-        std::ostringstream ss;
-        ss << "CSS Syntax error at line " << line << ":" << charPositionInLine 
-           << " - " << msg;
-        errors_.push_back(ss.str());
-        
-        ErrorBuilder(ErrorLevel::ERROR, ErrorType::SYNTAX_ERROR)
-            .withMessage("CSS Syntax Error")
-            .withDetail(msg)
-            .withLocation(line, charPositionInLine)
-            .report();
-    }
-};
+namespace {
+
+using CSSParse = TwoStageParse<CSSSimpleLexer, CSSSimpleParser, CSSSimpleParser::StylesheetContext>;
+
+// 预热用的典型片段
+const char* const CSS_WARM_UP_SOURCE =
+    ".box, .main p { color: red; margin: 0 auto; width: calc(100%); }\n"
+    "@media screen { .box { width: 10px; } }\n";
+
+} // namespace
 
 // CSS编译器实现
 CSSCompilerImpl::CSSCompilerImpl() {
@@ -136,6 +125,8 @@ CSSCompilerImpl::CSSCompilerImpl() {
         .withMessage("CSS Compiler initialized")
         .withDetail("Using ANTLR4 parser")
         .report();
+    
+    CSSParse::warmUp(CSS_WARM_UP_SOURCE, &CSSSimpleParser::stylesheet);
 }
 
 CompileResult CSSCompilerImpl::compile(const std::string& code, const CompileOptions& options) {
@@ -146,30 +137,46 @@ CompileResult CSSCompilerImpl::compile(const std::string& code, const CompileOpt
         .withDetail("Code length: " + std::to_string(code.length()) + " characters")
         .report();
     
+    bool minify = options.minify || minification_;
+    
+    // 快速路径：不需要诊断信息时不经过ANTLR，原样输出或由原生压缩器处理
+    if (!options.enableDebugInfo) {
+        if (minify) {
+            CSSMinifier minifier;
+            result.cssOutput = minifier.minify(code);
+            if (minifier.errorCount() > 0) {
+                result.warnings.push_back("CSS contains " + std::to_string(minifier.errorCount()) +
+                                          " malformed tokens; compile with debug info for details");
+            }
+        } else {
+            result.cssOutput = code;
+        }
+        result.success = true;
+        return result;
+    }
+    
     try {
-        // 创建ANTLR输入流
-        ANTLRInputStream input(code);
-        
-        // 创建词法分析器
-        CSSSimpleLexer lexer(&input);
-        CommonTokenStream tokens(&lexer);
-        
-        // 创建语法分析器
-        CSSSimpleParser parser(&tokens);
-        
-        // 添加错误监听器
-        parser.removeErrorListeners();
-        CSSErrorListener errorListener(result.errors);
-        parser.addErrorListener(&errorListener);
-        
-        // 解析
-        auto tree = parser.stylesheet();
+        // 两阶段解析；若validate()刚解析过同一段代码则直接复用
+        auto parse = LastParseSlot<CSSParse>::acquire(code, &CSSSimpleParser::stylesheet);
+        
+        for (const auto& error : parse->errors()) {
+            std::ostringstream ss;
+            ss << "CSS Syntax error at line " << error.line << ":" << error.column 
+               << " - " << error.message;
+            result.errors.push_back(ss.str());
+            
+            ErrorBuilder(ErrorLevel::ERROR, ErrorType::SYNTAX_ERROR)
+                .withMessage("CSS Syntax Error")
+                .withDetail(error.message)
+                .withLocation(error.line, error.column)
+                .report();
+        }
         
         // 使用访问者生成代码
         CSSVisitorImpl visitor;
-        visitor.visit(tree);
+        visitor.visit(parse->tree());
         
-        result.cssOutput = visitor.getOutput();
+        result.cssOutput = minify ? CSSMinifier().minify(visitor.getOutput()) : visitor.getOutput();
         result.success = result.errors.empty();
         
         if (result.success) {
@@ -194,16 +201,11 @@ CompileResult CSSCompilerImpl::compile(const std::string& code, const CompileOpt
 
 bool CSSCompilerImpl::validate(const std::string& code) {
     try {
-        ANTLRInputStream input(code);
-        CSSSimpleLexer lexer(&input);
-        CommonTokenStream tokens(&lexer);
-        CSSSimpleParser parser(&tokens);
-        
-        // 静默模式
-        parser.removeErrorListeners();
-        parser.stylesheet();
-        
-        return true;
+        // 静默模式：错误留给随后的compile()报告
+        auto parse = std::make_shared<CSSParse>(code, &CSSSimpleParser::stylesheet);
+        bool valid = !parse->hasErrors();
+        LastParseSlot<CSSParse>::keep(std::move(parse));
+        return valid;
     } catch (...) {
         return false;
     }
@@ -0,0 +1,532 @@
+#include "CSSMinifier.h"
+#include "CSSTokenizer.h"
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace CHTL {
+
+namespace {
+
+char toLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool equalsIgnoreCase(std::string_view text, std::string_view lower) {
+    if (text.size() != lower.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (toLower(text[i]) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool endsWithIgnoreCase(std::string_view text, std::string_view lowerSuffix) {
+    return text.size() >= lowerSuffix.size() &&
+           equalsIgnoreCase(text.substr(text.size() - lowerSuffix.size()), lowerSuffix);
+}
+
+bool isHexDigit(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+// 内容为规则列表的@规则；其余（@font-face、@page等）的块内是声明
+bool isRuleListAtRule(std::string_view name) {
+    static const char* const names[] = {
+        "media", "supports", "document", "-moz-document", "layer",
+        "container", "scope", "starting-style"
+    };
+    for (const char* candidate : names) {
+        if (equalsIgnoreCase(name, candidate)) {
+            return true;
+        }
+    }
+    return endsWithIgnoreCase(name, "keyframes");
+}
+
+bool isLengthUnit(std::string_view unit) {
+    static const char* const units[] = {
+        "px", "em", "rem", "ex", "ch", "vw", "vh", "vmin", "vmax",
+        "cm", "mm", "q", "in", "pt", "pc", "vi", "vb"
+    };
+    for (const char* candidate : units) {
+        if (equalsIgnoreCase(unit, candidate)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 去掉数值中多余的零：0.50 -> .5，010 -> 10，-0.0 -> 0
+// 带指数的数值原样保留
+void appendNumber(std::string_view number, std::string& out) {
+    for (char c : number) {
+        if (c == 'e' || c == 'E') {
+            out.append(number);
+            return;
+        }
+    }
+
+    std::string_view sign;
+    if (!number.empty() && (number[0] == '+' || number[0] == '-')) {
+        sign = number.substr(0, 1);
+        number.remove_prefix(1);
+    }
+
+    std::string_view integer = number;
+    std::string_view fraction;
+    size_t dot = number.find('.');
+    if (dot != std::string_view::npos) {
+        integer = number.substr(0, dot);
+        fraction = number.substr(dot + 1);
+    }
+    while (!integer.empty() && integer.front() == '0') {
+        integer.remove_prefix(1);
+    }
+    while (!fraction.empty() && fraction.back() == '0') {
+        fraction.remove_suffix(1);
+    }
+
+    if (integer.empty() && fraction.empty()) {
+        out += '0';
+        return;
+    }
+    out.append(sign);
+    out.append(integer);
+    if (!fraction.empty()) {
+        out += '.';
+        out.append(fraction);
+    }
+}
+
+bool isZero(std::string_view number) {
+    bool digit = false;
+    for (char c : number) {
+        if (c >= '1' && c <= '9') {
+            return false;
+        }
+        if (c == 'e' || c == 'E') {
+            return false;
+        }
+        digit = digit || c == '0';
+    }
+    return digit;
+}
+
+// #aabbcc -> #abc，#aabbccdd -> #abcd，统一小写；不是颜色形式的原样输出
+void appendHash(std::string_view name, std::string& out) {
+    out += '#';
+    bool hex = name.size() == 3 || name.size() == 4 || name.size() == 6 || name.size() == 8;
+    for (size_t i = 0; hex && i < name.size(); ++i) {
+        hex = isHexDigit(name[i]);
+    }
+    if (!hex) {
+        out.append(name);
+        return;
+    }
+    bool pairs = name.size() == 6 || name.size() == 8;
+    for (size_t i = 0; pairs && i < name.size(); i += 2) {
+        pairs = toLower(name[i]) == toLower(name[i + 1]);
+    }
+    for (size_t i = 0; i < name.size(); i += pairs ? 2 : 1) {
+        out += toLower(name[i]);
+    }
+}
+
+class MinifyPass {
+public:
+    MinifyPass(const CSSMinifyOptions& options, std::string& out)
+        : options_(options), out_(out) {
+        frames_.push_back({BlockKind::RULES, out_.size(), 0, false});
+    }
+
+    void run(CSSTokenizer& tokenizer) {
+        while (true) {
+            CSSToken token = tokenizer.next();
+            if (token.is(CSSTokenType::END_OF_FILE)) {
+                break;
+            }
+            process(token);
+        }
+    }
+
+private:
+    enum class BlockKind { RULES, DECLARATIONS };
+    enum class Phase { NONE, SELECTOR, AT_PRELUDE, DECL_NAME, DECL_VALUE };
+
+    struct Frame {
+        BlockKind kind;
+        size_t contentStart;    // 块内容在输出中的起点
+        size_t firstDecl;       // 本块的声明在decls_中的起点
+        bool nested;            // 声明中夹有嵌套规则，不做去重
+    };
+
+    void process(const CSSToken& token) {
+        switch (token.type) {
+            case CSSTokenType::WHITESPACE:
+                pendingSpace_ = true;
+                return;
+            case CSSTokenType::COMMENT:
+                if (options_.keepImportantComments && !token.value.empty() && token.value[0] == '!') {
+                    out_.append(token.text);
+                    lastType_ = CSSTokenType::COMMENT;
+                    pendingSpace_ = false;
+                } else {
+                    // 去掉的注释起分隔作用，避免前后记号粘连
+                    pendingSpace_ = true;
+                }
+                return;
+            default:
+                break;
+        }
+
+        if (phase_ == Phase::NONE) {
+            if (token.is(CSSTokenType::SEMICOLON)) {
+                // 空语句
+                pendingSpace_ = false;
+                return;
+            }
+            if (!token.is(CSSTokenType::RIGHT_BRACE)) {
+                beginStatement(token);
+            }
+        }
+
+        if (pendingSpace_ && needsSpace(token)) {
+            out_ += ' ';
+        }
+        pendingSpace_ = false;
+
+        switch (token.type) {
+            case CSSTokenType::LEFT_BRACE:
+                out_ += '{';
+                openBlock();
+                break;
+            case CSSTokenType::RIGHT_BRACE:
+                closeBlock();
+                break;
+            case CSSTokenType::SEMICOLON:
+                endStatement();
+                break;
+            default:
+                emit(token);
+                break;
+        }
+    }
+
+    void beginStatement(const CSSToken& token) {
+        Frame& frame = frames_.back();
+        parenDepth_ = 0;
+        bracketDepth_ = 0;
+        functionDepth_ = 0;
+        pendingSpace_ = false;
+
+        if (frame.kind == BlockKind::DECLARATIONS) {
+            if (needSemicolon_) {
+                out_ += ';';
+                needSemicolon_ = false;
+            }
+            declStart_ = out_.size();
+        }
+
+        if (token.is(CSSTokenType::AT_KEYWORD)) {
+            phase_ = Phase::AT_PRELUDE;
+            atName_ = token.value;
+        } else if (frame.kind == BlockKind::RULES) {
+            phase_ = Phase::SELECTOR;
+        } else {
+            phase_ = Phase::DECL_NAME;
+            property_ = token.is(CSSTokenType::IDENT) ? token.value : std::string_view();
+            customProperty_ = property_.size() > 2 && property_[0] == '-' && property_[1] == '-';
+            keepZeroUnits_ = endsWithIgnoreCase(property_, "flex");
+        }
+    }
+
+    void endDeclaration() {
+        decls_.emplace_back(declStart_, out_.size());
+        needSemicolon_ = true;
+    }
+
+    void endStatement() {
+        if (phase_ == Phase::DECL_NAME || phase_ == Phase::DECL_VALUE) {
+            endDeclaration();
+        } else {
+            out_ += ';';
+        }
+        phase_ = Phase::NONE;
+        lastType_ = CSSTokenType::SEMICOLON;
+    }
+
+    void openBlock() {
+        BlockKind kind = BlockKind::DECLARATIONS;
+        if (phase_ == Phase::AT_PRELUDE && isRuleListAtRule(atName_)) {
+            kind = BlockKind::RULES;
+        }
+        if (frames_.back().kind == BlockKind::DECLARATIONS) {
+            frames_.back().nested = true;
+        }
+        frames_.push_back({kind, out_.size(), decls_.size(), false});
+        phase_ = Phase::NONE;
+        needSemicolon_ = false;
+        lastType_ = CSSTokenType::LEFT_BRACE;
+    }
+
+    void closeBlock() {
+        if (phase_ == Phase::DECL_NAME || phase_ == Phase::DECL_VALUE) {
+            endDeclaration();
+        }
+        if (frames_.size() > 1) {
+            Frame frame = frames_.back();
+            frames_.pop_back();
+            if (frame.kind == BlockKind::DECLARATIONS && !frame.nested && options_.mergeDuplicateDeclarations) {
+                mergeDuplicates(frame);
+            }
+            decls_.resize(frame.firstDecl);
+        }
+        out_ += '}';
+        phase_ = Phase::NONE;
+        needSemicolon_ = false;
+        lastType_ = CSSTokenType::RIGHT_BRACE;
+    }
+
+    // 完全相同的声明只保留最后一次出现
+    void mergeDuplicates(const Frame& frame) {
+        size_t count = decls_.size() - frame.firstDecl;
+        if (count < 2) {
+            return;
+        }
+
+        auto text = [&](size_t index) {
+            const auto& range = decls_[frame.firstDecl + index];
+            return std::string_view(out_).substr(range.first, range.second - range.first);
+        };
+
+        std::vector<bool> keep(count, true);
+        bool changed = false;
+        std::unordered_set<std::string_view> seen;
+        for (size_t i = count; i-- > 0;) {
+            if (!seen.insert(text(i)).second) {
+                keep[i] = false;
+                changed = true;
+            }
+        }
+        if (!changed) {
+            return;
+        }
+
+        std::string merged;
+        for (size_t i = 0; i < count; ++i) {
+            if (keep[i]) {
+                if (!merged.empty()) {
+                    merged += ';';
+                }
+                merged.append(text(i));
+            }
+        }
+        out_.resize(frame.contentStart);
+        out_ += merged;
+    }
+
+    bool isDelim(const char* chars) const {
+        if (lastType_ != CSSTokenType::DELIM) {
+            return false;
+        }
+        for (const char* c = chars; *c; ++c) {
+            if (lastDelim_ == *c) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool isDelimOf(const CSSToken& token, const char* chars) {
+        if (token.type != CSSTokenType::DELIM) {
+            return false;
+        }
+        for (const char* c = chars; *c; ++c) {
+            if (token.isDelim(*c)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool needsSpace(const CSSToken& token) const {
+        switch (lastType_) {
+            case CSSTokenType::LEFT_BRACE:
+            case CSSTokenType::RIGHT_BRACE:
+            case CSSTokenType::SEMICOLON:
+            case CSSTokenType::COMMA:
+            case CSSTokenType::LEFT_PAREN:
+            case CSSTokenType::FUNCTION:
+            case CSSTokenType::LEFT_BRACKET:
+            case CSSTokenType::COLON:
+                return false;
+            default:
+                break;
+        }
+        switch (token.type) {
+            case CSSTokenType::LEFT_BRACE:
+            case CSSTokenType::RIGHT_BRACE:
+            case CSSTokenType::SEMICOLON:
+            case CSSTokenType::COMMA:
+            case CSSTokenType::RIGHT_PAREN:
+            case CSSTokenType::RIGHT_BRACKET:
+                return false;
+            default:
+                break;
+        }
+
+        switch (phase_) {
+            case Phase::SELECTOR:
+                // 属性选择器内只有相邻的两个标识符需要分隔
+                if (bracketDepth_ > 0) {
+                    return lastType_ == CSSTokenType::IDENT && token.is(CSSTokenType::IDENT);
+                }
+                // 组合符两侧的空白可省；冒号前的空白是后代组合符，必须保留
+                return !isDelim(">~+") && !isDelimOf(token, ">~+");
+            case Phase::DECL_NAME:
+            case Phase::DECL_VALUE:
+                if (customProperty_ && phase_ == Phase::DECL_VALUE) {
+                    return true;
+                }
+                return !token.is(CSSTokenType::COLON) && !isDelim("!") && !isDelimOf(token, "!");
+            case Phase::AT_PRELUDE:
+                // (max-width : 100px) 中的冒号；and ( 的空白不能省，否则成为函数
+                return !(token.is(CSSTokenType::COLON) && parenDepth_ > 0);
+            default:
+                return true;
+        }
+    }
+
+    void emit(const CSSToken& token) {
+        bool inValue = phase_ == Phase::DECL_VALUE && !customProperty_;
+
+        switch (token.type) {
+            case CSSTokenType::COLON:
+                if (phase_ == Phase::DECL_NAME && parenDepth_ == 0) {
+                    phase_ = Phase::DECL_VALUE;
+                }
+                out_ += ':';
+                break;
+            case CSSTokenType::LEFT_PAREN:
+                ++parenDepth_;
+                out_ += '(';
+                break;
+            case CSSTokenType::FUNCTION:
+                ++parenDepth_;
+                if (inValue) {
+                    ++functionDepth_;
+                }
+                out_.append(token.text);
+                break;
+            case CSSTokenType::LEFT_BRACKET:
+                ++bracketDepth_;
+                out_ += '[';
+                break;
+            case CSSTokenType::RIGHT_BRACKET:
+                if (bracketDepth_ > 0) {
+                    --bracketDepth_;
+                }
+                out_ += ']';
+                break;
+            case CSSTokenType::RIGHT_PAREN:
+                if (parenDepth_ > 0) {
+                    --parenDepth_;
+                }
+                if (functionDepth_ > parenDepth_) {
+                    functionDepth_ = parenDepth_;
+                }
+                out_ += ')';
+                break;
+            case CSSTokenType::HASH:
+                if (inValue && options_.shortenColors) {
+                    appendHash(token.value, out_);
+                } else {
+                    out_.append(token.text);
+                }
+                break;
+            case CSSTokenType::NUMBER:
+            case CSSTokenType::PERCENTAGE:
+                if (inValue && options_.shortenNumbers) {
+                    appendNumber(token.value, out_);
+                    if (token.is(CSSTokenType::PERCENTAGE)) {
+                        out_ += '%';
+                    }
+                } else {
+                    out_.append(token.text);
+                }
+                break;
+            case CSSTokenType::DIMENSION:
+                if (inValue && options_.shortenNumbers) {
+                    if (isZero(token.value) && isLengthUnit(token.unit) &&
+                        functionDepth_ == 0 && !keepZeroUnits_) {
+                        out_ += '0';
+                    } else {
+                        appendNumber(token.value, out_);
+                        out_.append(token.unit);
+                    }
+                } else {
+                    out_.append(token.text);
+                }
+                break;
+            case CSSTokenType::BAD_STRING:
+                // 坏字符串止于换行，换行必须保留，否则会吞掉后面的内容
+                out_.append(token.text);
+                out_ += '\n';
+                break;
+            case CSSTokenType::URL:
+                out_.append("url(");
+                out_.append(token.value);
+                out_ += ')';
+                break;
+            default:
+                out_.append(token.text);
+                break;
+        }
+
+        lastType_ = token.type;
+        lastDelim_ = token.type == CSSTokenType::DELIM ? token.text[0] : '\0';
+    }
+
+    const CSSMinifyOptions& options_;
+    std::string& out_;
+
+    std::vector<Frame> frames_;
+    std::vector<std::pair<size_t, size_t>> decls_;
+
+    Phase phase_ = Phase::NONE;
+    CSSTokenType lastType_ = CSSTokenType::LEFT_BRACE;
+    char lastDelim_ = '\0';
+    bool pendingSpace_ = false;
+    bool needSemicolon_ = false;
+
+    size_t parenDepth_ = 0;
+    size_t bracketDepth_ = 0;
+    size_t functionDepth_ = 0;
+    size_t declStart_ = 0;
+    std::string_view atName_;
+    std::string_view property_;
+    bool customProperty_ = false;
+    bool keepZeroUnits_ = false;
+};
+
+} // namespace
+
+std::string CSSMinifier::minify(std::string_view css) {
+    std::string out;
+    minify(css, out);
+    return out;
+}
+
+void CSSMinifier::minify(std::string_view css, std::string& out) {
+    out.reserve(out.size() + css.size());
+    CSSTokenizer tokenizer(css);
+    MinifyPass pass(options_, out);
+    pass.run(tokenizer);
+    errors_ = tokenizer.errorCount();
+}
+
+} // namespace CHTL
@@ -0,0 +1,44 @@
+#ifndef CHTL_CSS_MINIFIER_H
+#define CHTL_CSS_MINIFIER_H
+
+#include <string>
+#include <string_view>
+
+namespace CHTL {
+
+// CSS压缩选项
+struct CSSMinifyOptions {
+    bool keepImportantComments = true;      // 保留 /*! ... */ 注释（许可证等）
+    bool shortenColors = true;              // #aabbcc -> #abc，统一小写
+    bool shortenNumbers = true;             // 0px -> 0，0.50 -> .5
+    bool mergeDuplicateDeclarations = true; // 同一块中完全相同的声明只保留最后一个
+};
+
+// CSS压缩器
+// 在CSSTokenizer产出的记号流上单遍工作，不建语法树：去掉注释和多余空白，
+// 声明块内省略最后一个分号，缩短颜色和数值。只根据块的种类（规则列表/
+// 声明列表）和当前所处位置（选择器、@规则前导、属性名、属性值）决定空白
+// 是否可以省略，因此不会改变选择器组合符或calc()等对空白敏感的写法。
+//
+// 属性值中的变换不作用于自定义属性（--*）；零值单位不在函数内部和flex
+// 简写中省略。不同取值的同名声明被视为回退写法而保留。
+class CSSMinifier {
+public:
+    explicit CSSMinifier(const CSSMinifyOptions& options = CSSMinifyOptions()) : options_(options) {}
+
+    std::string minify(std::string_view css);
+
+    // 追加到out末尾
+    void minify(std::string_view css, std::string& out);
+
+    // 最近一次压缩中词法层面的解析错误数
+    size_t errorCount() const { return errors_; }
+
+private:
+    CSSMinifyOptions options_;
+    size_t errors_ = 0;
+};
+
+} // namespace CHTL
+
+#endif // CHTL_CSS_MINIFIER_H
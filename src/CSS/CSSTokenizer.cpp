@@ -0,0 +1,438 @@
+#include "CSSTokenizer.h"
+
+namespace CHTL {
+
+namespace {
+
+bool isNewline(char c) {
+    return c == '\n' || c == '\r' || c == '\f';
+}
+
+bool isWhitespace(char c) {
+    return c == ' ' || c == '\t' || isNewline(c);
+}
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+bool isHexDigit(char c) {
+    return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+bool isNonAscii(char c) {
+    return static_cast<unsigned char>(c) >= 0x80;
+}
+
+bool isIdentStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || isNonAscii(c);
+}
+
+bool isIdentChar(char c) {
+    return isIdentStart(c) || isDigit(c) || c == '-';
+}
+
+bool isNonPrintable(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return u <= 0x08 || u == 0x0B || (u >= 0x0E && u <= 0x1F) || u == 0x7F;
+}
+
+bool equalsIgnoreCase(std::string_view text, std::string_view lower) {
+    if (text.size() != lower.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c >= 'A' && c <= 'Z') {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+        if (c != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+CSSToken CSSTokenizer::make(CSSTokenType type, size_t start) const {
+    CSSToken token;
+    token.type = type;
+    token.text = source_.substr(start, pos_ - start);
+    return token;
+}
+
+bool CSSTokenizer::isValidEscapeAt(size_t offset) const {
+    return peek(offset) == '\\' && hasAt(offset) && !isNewline(peek(offset + 1));
+}
+
+bool CSSTokenizer::wouldStartIdentAt(size_t offset) const {
+    if (!hasAt(offset)) {
+        return false;
+    }
+    char c = peek(offset);
+    if (c == '-') {
+        char next = peek(offset + 1);
+        return (hasAt(offset + 1) && (isIdentStart(next) || next == '-')) || isValidEscapeAt(offset + 1);
+    }
+    if (isIdentStart(c)) {
+        return true;
+    }
+    return c == '\\' && isValidEscapeAt(offset);
+}
+
+bool CSSTokenizer::wouldStartNumberAt(size_t offset) const {
+    char c = peek(offset);
+    if (c == '+' || c == '-') {
+        return isDigit(peek(offset + 1)) || (peek(offset + 1) == '.' && isDigit(peek(offset + 2)));
+    }
+    if (c == '.') {
+        return isDigit(peek(offset + 1));
+    }
+    return isDigit(c);
+}
+
+// 调用时反斜杠已被消费
+void CSSTokenizer::consumeEscape() {
+    if (atEnd()) {
+        return;
+    }
+    if (isHexDigit(peek())) {
+        for (int i = 0; i < 6 && isHexDigit(peek()) && !atEnd(); ++i) {
+            ++pos_;
+        }
+        if (peek() == '\r' && peek(1) == '\n') {
+            pos_ += 2;
+        } else if (isWhitespace(peek()) && !atEnd()) {
+            ++pos_;
+        }
+        return;
+    }
+    // 任意一个码点（UTF-8续字节一并消费）
+    ++pos_;
+    while (!atEnd() && (static_cast<unsigned char>(peek()) & 0xC0) == 0x80) {
+        ++pos_;
+    }
+}
+
+void CSSTokenizer::consumeIdentSequence() {
+    while (!atEnd()) {
+        if (isIdentChar(peek())) {
+            ++pos_;
+        } else if (isValidEscapeAt(0)) {
+            ++pos_;
+            consumeEscape();
+        } else {
+            break;
+        }
+    }
+}
+
+CSSToken CSSTokenizer::consumeNumeric(size_t start) {
+    bool isInteger = true;
+    if (peek() == '+' || peek() == '-') {
+        ++pos_;
+    }
+    while (isDigit(peek())) {
+        ++pos_;
+    }
+    if (peek() == '.' && isDigit(peek(1))) {
+        isInteger = false;
+        pos_ += 2;
+        while (isDigit(peek())) {
+            ++pos_;
+        }
+    }
+    if ((peek() == 'e' || peek() == 'E') &&
+        (isDigit(peek(1)) || ((peek(1) == '+' || peek(1) == '-') && isDigit(peek(2))))) {
+        isInteger = false;
+        pos_ += 2;
+        while (isDigit(peek())) {
+            ++pos_;
+        }
+    }
+    std::string_view number = source_.substr(start, pos_ - start);
+
+    CSSToken token;
+    if (wouldStartIdentAt(0)) {
+        size_t unitStart = pos_;
+        consumeIdentSequence();
+        token = make(CSSTokenType::DIMENSION, start);
+        token.unit = source_.substr(unitStart, pos_ - unitStart);
+    } else if (peek() == '%' && !atEnd()) {
+        ++pos_;
+        token = make(CSSTokenType::PERCENTAGE, start);
+    } else {
+        token = make(CSSTokenType::NUMBER, start);
+    }
+    token.value = number;
+    token.isInteger = isInteger;
+    return token;
+}
+
+CSSToken CSSTokenizer::consumeIdentLike(size_t start) {
+    consumeIdentSequence();
+    size_t nameEnd = pos_;
+    std::string_view name = source_.substr(start, nameEnd - start);
+
+    if (peek() == '(' && !atEnd()) {
+        ++pos_;
+        if (equalsIgnoreCase(name, "url")) {
+            // url( 后跟引号时按函数处理，空白留给后续的WHITESPACE记号
+            size_t lookahead = pos_;
+            while (lookahead < source_.size() && isWhitespace(source_[lookahead])) {
+                ++lookahead;
+            }
+            if (lookahead >= source_.size() || (source_[lookahead] != '"' && source_[lookahead] != '\'')) {
+                return consumeUrl(start);
+            }
+        }
+        CSSToken token = make(CSSTokenType::FUNCTION, start);
+        token.value = name;
+        return token;
+    }
+
+    CSSToken token = make(CSSTokenType::IDENT, start);
+    token.value = name;
+    return token;
+}
+
+CSSToken CSSTokenizer::consumeString(size_t start, char quote) {
+    ++pos_;
+    size_t valueStart = pos_;
+    while (true) {
+        if (atEnd()) {
+            ++errors_;
+            CSSToken token = make(CSSTokenType::STRING, start);
+            token.value = source_.substr(valueStart, pos_ - valueStart);
+            return token;
+        }
+        char c = peek();
+        if (c == quote) {
+            std::string_view value = source_.substr(valueStart, pos_ - valueStart);
+            ++pos_;
+            CSSToken token = make(CSSTokenType::STRING, start);
+            token.value = value;
+            return token;
+        }
+        if (isNewline(c)) {
+            // 换行不属于坏字符串
+            ++errors_;
+            CSSToken token = make(CSSTokenType::BAD_STRING, start);
+            token.value = source_.substr(valueStart, pos_ - valueStart);
+            return token;
+        }
+        if (c == '\\') {
+            if (!hasAt(1)) {
+                ++pos_;
+            } else if (peek(1) == '\r' && peek(2) == '\n') {
+                pos_ += 3;
+            } else if (isNewline(peek(1))) {
+                pos_ += 2;
+            } else {
+                ++pos_;
+                consumeEscape();
+            }
+            continue;
+        }
+        ++pos_;
+    }
+}
+
+// 调用时 url( 已被消费
+CSSToken CSSTokenizer::consumeUrl(size_t start) {
+    while (!atEnd() && isWhitespace(peek())) {
+        ++pos_;
+    }
+    size_t valueStart = pos_;
+
+    auto finish = [&](size_t valueEnd) {
+        CSSToken token = make(CSSTokenType::URL, start);
+        token.value = source_.substr(valueStart, valueEnd - valueStart);
+        return token;
+    };
+
+    while (true) {
+        if (atEnd()) {
+            ++errors_;
+            return finish(pos_);
+        }
+        char c = peek();
+        if (c == ')') {
+            size_t valueEnd = pos_;
+            ++pos_;
+            return finish(valueEnd);
+        }
+        if (isWhitespace(c)) {
+            size_t valueEnd = pos_;
+            while (!atEnd() && isWhitespace(peek())) {
+                ++pos_;
+            }
+            if (atEnd()) {
+                ++errors_;
+                return finish(valueEnd);
+            }
+            if (peek() == ')') {
+                ++pos_;
+                return finish(valueEnd);
+            }
+            ++errors_;
+            consumeBadUrlRemnants();
+            return make(CSSTokenType::BAD_URL, start);
+        }
+        if (c == '"' || c == '\'' || c == '(' || isNonPrintable(c)) {
+            ++errors_;
+            consumeBadUrlRemnants();
+            return make(CSSTokenType::BAD_URL, start);
+        }
+        if (c == '\\') {
+            if (isValidEscapeAt(0)) {
+                ++pos_;
+                consumeEscape();
+                continue;
+            }
+            ++errors_;
+            consumeBadUrlRemnants();
+            return make(CSSTokenType::BAD_URL, start);
+        }
+        ++pos_;
+    }
+}
+
+void CSSTokenizer::consumeBadUrlRemnants() {
+    while (!atEnd()) {
+        if (peek() == ')') {
+            ++pos_;
+            return;
+        }
+        if (isValidEscapeAt(0)) {
+            ++pos_;
+            consumeEscape();
+        } else {
+            ++pos_;
+        }
+    }
+}
+
+CSSToken CSSTokenizer::next() {
+    size_t start = pos_;
+    if (atEnd()) {
+        return make(CSSTokenType::END_OF_FILE, start);
+    }
+
+    char c = peek();
+
+    // 注释
+    if (c == '/' && peek(1) == '*') {
+        size_t end = source_.find("*/", pos_ + 2);
+        CSSToken token;
+        if (end == std::string_view::npos) {
+            ++errors_;
+            pos_ = source_.size();
+            token = make(CSSTokenType::COMMENT, start);
+            token.value = source_.substr(start + 2);
+        } else {
+            pos_ = end + 2;
+            token = make(CSSTokenType::COMMENT, start);
+            token.value = source_.substr(start + 2, end - start - 2);
+        }
+        return token;
+    }
+
+    if (isWhitespace(c)) {
+        while (!atEnd() && isWhitespace(peek())) {
+            ++pos_;
+        }
+        return make(CSSTokenType::WHITESPACE, start);
+    }
+
+    switch (c) {
+        case '"':
+        case '\'':
+            return consumeString(start, c);
+
+        case '#':
+            if (hasAt(1) && (isIdentChar(peek(1)) || isValidEscapeAt(1))) {
+                ++pos_;
+                bool isId = wouldStartIdentAt(0);
+                size_t nameStart = pos_;
+                consumeIdentSequence();
+                CSSToken token = make(CSSTokenType::HASH, start);
+                token.value = source_.substr(nameStart, pos_ - nameStart);
+                token.isIdHash = isId;
+                return token;
+            }
+            break;
+
+        case '(': ++pos_; return make(CSSTokenType::LEFT_PAREN, start);
+        case ')': ++pos_; return make(CSSTokenType::RIGHT_PAREN, start);
+        case '[': ++pos_; return make(CSSTokenType::LEFT_BRACKET, start);
+        case ']': ++pos_; return make(CSSTokenType::RIGHT_BRACKET, start);
+        case '{': ++pos_; return make(CSSTokenType::LEFT_BRACE, start);
+        case '}': ++pos_; return make(CSSTokenType::RIGHT_BRACE, start);
+        case ',': ++pos_; return make(CSSTokenType::COMMA, start);
+        case ':': ++pos_; return make(CSSTokenType::COLON, start);
+        case ';': ++pos_; return make(CSSTokenType::SEMICOLON, start);
+
+        case '+':
+        case '.':
+            if (wouldStartNumberAt(0)) {
+                return consumeNumeric(start);
+            }
+            break;
+
+        case '-':
+            if (wouldStartNumberAt(0)) {
+                return consumeNumeric(start);
+            }
+            if (peek(1) == '-' && peek(2) == '>') {
+                pos_ += 3;
+                return make(CSSTokenType::CDC, start);
+            }
+            if (wouldStartIdentAt(0)) {
+                return consumeIdentLike(start);
+            }
+            break;
+
+        case '<':
+            if (source_.compare(pos_, 4, "<!--") == 0) {
+                pos_ += 4;
+                return make(CSSTokenType::CDO, start);
+            }
+            break;
+
+        case '@':
+            if (wouldStartIdentAt(1)) {
+                ++pos_;
+                size_t nameStart = pos_;
+                consumeIdentSequence();
+                CSSToken token = make(CSSTokenType::AT_KEYWORD, start);
+                token.value = source_.substr(nameStart, pos_ - nameStart);
+                return token;
+            }
+            break;
+
+        case '\\':
+            if (isValidEscapeAt(0)) {
+                return consumeIdentLike(start);
+            }
+            ++errors_;
+            break;
+
+        default:
+            if (isDigit(c)) {
+                return consumeNumeric(start);
+            }
+            if (isIdentStart(c)) {
+                return consumeIdentLike(start);
+            }
+            break;
+    }
+
+    ++pos_;
+    CSSToken token = make(CSSTokenType::DELIM, start);
+    token.value = token.text;
+    return token;
+}
+
+} // namespace CHTL
@@ -0,0 +1,97 @@
+#ifndef CHTL_CSS_TOKENIZER_H
+#define CHTL_CSS_TOKENIZER_H
+
+#include <string_view>
+#include <cstddef>
+
+namespace CHTL {
+
+// CSS记号类型（CSS Syntax Level 3 §4）
+// 规范在词法阶段丢弃注释，这里保留为COMMENT以便压缩器决定去留
+enum class CSSTokenType {
+    IDENT,
+    FUNCTION,           // name(
+    AT_KEYWORD,         // @name
+    HASH,               // #name
+    STRING,
+    BAD_STRING,
+    URL,                // url(...)，不带引号
+    BAD_URL,
+    DELIM,
+    NUMBER,
+    PERCENTAGE,
+    DIMENSION,
+    WHITESPACE,
+    CDO,                // <!--
+    CDC,                // -->
+    COLON,
+    SEMICOLON,
+    COMMA,
+    LEFT_BRACKET,
+    RIGHT_BRACKET,
+    LEFT_PAREN,
+    RIGHT_PAREN,
+    LEFT_BRACE,
+    RIGHT_BRACE,
+    COMMENT,
+    END_OF_FILE
+};
+
+// CSS记号
+// 所有字段都是源文本的切片，不做转义解码，也不分配内存
+struct CSSToken {
+    CSSTokenType type = CSSTokenType::END_OF_FILE;
+    std::string_view text;      // 记号的完整原文
+    std::string_view value;     // 名称（IDENT/FUNCTION/AT_KEYWORD/HASH）、
+                                // 字符串或URL的内容、数值部分（NUMBER/PERCENTAGE/DIMENSION）
+    std::string_view unit;      // DIMENSION的单位
+    bool isIdHash = false;      // HASH的type flag为"id"
+    bool isInteger = false;     // 数值的type flag为"integer"
+
+    bool is(CSSTokenType t) const { return type == t; }
+    bool isDelim(char c) const { return type == CSSTokenType::DELIM && text.size() == 1 && text[0] == c; }
+};
+
+// CSS词法分析器
+// 按css-syntax-3的记号化算法逐个产出记号。输入不做预处理：CR、FF视为换行，
+// NUL按普通字符处理。记号引用输入，调用者须保证输入在使用记号期间有效。
+class CSSTokenizer {
+public:
+    explicit CSSTokenizer(std::string_view source) : source_(source) {}
+
+    CSSToken next();
+
+    bool atEnd() const { return pos_ >= source_.size(); }
+    size_t position() const { return pos_; }
+
+    // 不可恢复的解析错误数（坏字符串、坏URL、未闭合的注释等）
+    size_t errorCount() const { return errors_; }
+
+private:
+    char peek(size_t offset = 0) const {
+        return pos_ + offset < source_.size() ? source_[pos_ + offset] : '\0';
+    }
+    bool hasAt(size_t offset) const { return pos_ + offset < source_.size(); }
+
+    bool isValidEscapeAt(size_t offset) const;
+    bool wouldStartIdentAt(size_t offset) const;
+    bool wouldStartNumberAt(size_t offset) const;
+
+    void consumeEscape();
+    void consumeIdentSequence();
+    CSSToken consumeNumeric(size_t start);
+    CSSToken consumeIdentLike(size_t start);
+    CSSToken consumeString(size_t start, char quote);
+    CSSToken consumeUrl(size_t start);
+    void consumeBadUrlRemnants();
+
+    CSSToken make(CSSTokenType type, size_t start) const;
+
+    std::string_view source_;
+    size_t pos_ = 0;
+    size_t errors_ = 0;
+};
+
+} // namespace CHTL
+
+#endif // CHTL_CSS_TOKENIZER_H
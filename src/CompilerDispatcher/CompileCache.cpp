@@ -0,0 +1,376 @@
+#include "CompileCache.h"
+#include "../CHTL/CHTLLoader/ImportResolver.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace CHTL {
+
+namespace {
+
+// 缓存文件格式版本，格式变化时递增
+const char CACHE_MAGIC[] = "CHTLCACHE1";
+const char CACHE_EXTENSION[] = ".chtlcache";
+
+inline uint64_t readWord(const unsigned char* p) {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+void writeString(std::string& out, const std::string& value) {
+    uint64_t length = value.size();
+    out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.append(value);
+}
+
+void writeList(std::string& out, const std::vector<std::string>& values) {
+    uint64_t count = values.size();
+    out.append(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (const auto& value : values) {
+        writeString(out, value);
+    }
+}
+
+// 顺序读取序列化数据，越界时置失败标记
+class Reader {
+public:
+    explicit Reader(const std::string& data) : data_(data) {}
+
+    bool readU64(uint64_t& value) {
+        if (data_.size() - pos_ < sizeof(value)) {
+            failed_ = true;
+            return false;
+        }
+        std::memcpy(&value, data_.data() + pos_, sizeof(value));
+        pos_ += sizeof(value);
+        return true;
+    }
+
+    std::string readString() {
+        uint64_t length = 0;
+        if (!readU64(length) || data_.size() - pos_ < length) {
+            failed_ = true;
+            return {};
+        }
+        std::string value = data_.substr(pos_, length);
+        pos_ += length;
+        return value;
+    }
+
+    std::vector<std::string> readList() {
+        uint64_t count = 0;
+        std::vector<std::string> values;
+        if (!readU64(count) || count > data_.size()) {
+            failed_ = true;
+            return values;
+        }
+        for (uint64_t i = 0; i < count && !failed_; ++i) {
+            values.push_back(readString());
+        }
+        return values;
+    }
+
+    bool failed() const { return failed_; }
+    bool atEnd() const { return pos_ == data_.size(); }
+
+private:
+    const std::string& data_;
+    size_t pos_ = 0;
+    bool failed_ = false;
+};
+
+std::string toHex(uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+    for (int i = 15; i >= 0; --i) {
+        hex[i] = digits[value & 0xF];
+        value >>= 4;
+    }
+    return hex;
+}
+
+} // namespace
+
+CompileCache::CompileCache(const std::string& directory, size_t maxBytes)
+    : directory_(directory), maxBytes_(maxBytes) {
+    std::error_code ec;
+    fs::create_directories(directory_, ec);
+    loadIndex();
+}
+
+uint64_t CompileCache::hash(const void* data, size_t length, uint64_t seed) {
+    // MurmurHash64A
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+
+    uint64_t h = seed ^ (length * m);
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    const unsigned char* end = bytes + (length / 8) * 8;
+
+    for (; bytes != end; bytes += 8) {
+        uint64_t k = readWord(bytes);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    switch (length & 7) {
+        case 7: h ^= uint64_t(bytes[6]) << 48; [[fallthrough]];
+        case 6: h ^= uint64_t(bytes[5]) << 40; [[fallthrough]];
+        case 5: h ^= uint64_t(bytes[4]) << 32; [[fallthrough]];
+        case 4: h ^= uint64_t(bytes[3]) << 24; [[fallthrough]];
+        case 3: h ^= uint64_t(bytes[2]) << 16; [[fallthrough]];
+        case 2: h ^= uint64_t(bytes[1]) << 8; [[fallthrough]];
+        case 1: h ^= uint64_t(bytes[0]);
+                h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+std::string CompileCache::computeKey(const std::string& inputFile, const std::string& source,
+                                     const CompileOptions& options) const {
+    // 参与哈希的全部内容按固定顺序拼接成清单
+    std::string manifest;
+    writeString(manifest, CHTL_COMPILER_VERSION);
+    writeString(manifest, toHex(hash(source.data(), source.size())));
+
+    // 编译选项（parallelJobs、流水线和缓存设置不影响输出）
+    writeString(manifest, options.inputFile);
+    writeString(manifest, options.outputFile);
+    writeString(manifest, options.outputDir);
+    writeString(manifest, options.targetVersion);
+    writeString(manifest, options.encoding);
+    writeString(manifest, options.officialModuleDir);
+    manifest += options.generateSourceMap ? '1' : '0';
+    manifest += options.minify ? '1' : '0';
+    manifest += options.prettify ? '1' : '0';
+    manifest += options.enableDebugInfo ? '1' : '0';
+    std::map<std::string, std::string> customConfig(options.customConfig.begin(), options.customConfig.end());
+    for (const auto& entry : customConfig) {
+        writeString(manifest, entry.first);
+        writeString(manifest, entry.second);
+    }
+
+    // 传递导入闭包：按路径排序，路径与内容一起哈希
+    if (!inputFile.empty() && fs::exists(inputFile)) {
+        // 与编译时相同的解析配置，官方模块的导入才会进入闭包
+        ImportResolverConfig config;
+        config.officialModuleDir = options.officialModuleDir;
+        config.currentDir = fs::absolute(inputFile).parent_path().string();
+        ImportResolver resolver(config);
+        resolver.scanImports(inputFile);
+
+        std::string root = fs::absolute(inputFile).lexically_normal().string();
+        std::set<std::string> closure;
+        std::vector<std::string> toVisit = resolver.getImportedFiles(root);
+        while (!toVisit.empty()) {
+            std::string file = toVisit.back();
+            toVisit.pop_back();
+            if (file == root || !closure.insert(file).second) {
+                continue;
+            }
+            for (const auto& imported : resolver.getImportedFiles(file)) {
+                toVisit.push_back(imported);
+            }
+        }
+
+        for (const auto& file : closure) {
+            writeString(manifest, file);
+            std::ifstream stream(file, std::ios::binary);
+            std::stringstream buffer;
+            buffer << stream.rdbuf();
+            std::string content = buffer.str();
+            writeString(manifest, stream ? toHex(hash(content.data(), content.size())) : "missing");
+        }
+    }
+
+    // 两个不同种子的64位哈希组成128位键
+    return toHex(hash(manifest.data(), manifest.size(), 0x43485444)) +
+           toHex(hash(manifest.data(), manifest.size(), 0x4b455931));
+}
+
+std::optional<CompileResult> CompileCache::lookup(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string path = entryPath(key);
+
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        // 可能被其他进程淘汰
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            totalBytes_ -= std::min(totalBytes_, it->second.size);
+            index_.erase(it);
+        }
+        ++stats_.misses;
+        return std::nullopt;
+    }
+
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    auto result = deserialize(buffer.str());
+    if (!result) {
+        // 损坏的条目直接丢弃
+        std::error_code ec;
+        fs::remove(path, ec);
+        ++stats_.misses;
+        return std::nullopt;
+    }
+
+    std::error_code ec;
+    auto now = fs::file_time_type::clock::now();
+    fs::last_write_time(path, now, ec);
+    index_[key].lastAccess = now;
+
+    ++stats_.hits;
+    return result;
+}
+
+bool CompileCache::store(const std::string& key, const CompileResult& result) {
+    std::string data = serialize(result);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string path = entryPath(key);
+    // 临时文件名随机化，避免并发写入同一条目时互相覆盖
+    std::string tempPath = path + ".tmp" + std::to_string(std::random_device{}());
+
+    {
+        std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+        if (!stream.write(data.data(), data.size())) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+
+    auto& entry = index_[key];
+    totalBytes_ -= std::min(totalBytes_, entry.size);
+    entry.size = data.size();
+    entry.lastAccess = fs::file_time_type::clock::now();
+    totalBytes_ += entry.size;
+    ++stats_.stores;
+
+    evictIfNeeded();
+    return true;
+}
+
+void CompileCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::error_code ec;
+    for (const auto& entry : index_) {
+        fs::remove(entryPath(entry.first), ec);
+    }
+    index_.clear();
+    totalBytes_ = 0;
+}
+
+CompileCacheStats CompileCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CompileCacheStats stats = stats_;
+    stats.entries = index_.size();
+    stats.totalBytes = totalBytes_;
+    return stats;
+}
+
+void CompileCache::loadIndex() {
+    std::error_code ec;
+    for (fs::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_regular_file(ec) || it->path().extension() != CACHE_EXTENSION) {
+            continue;
+        }
+        Entry entry;
+        entry.size = static_cast<size_t>(it->file_size(ec));
+        entry.lastAccess = it->last_write_time(ec);
+        index_[it->path().stem().string()] = entry;
+        totalBytes_ += entry.size;
+    }
+    evictIfNeeded();
+}
+
+void CompileCache::evictIfNeeded() {
+    if (totalBytes_ <= maxBytes_) {
+        return;
+    }
+
+    // 按最近访问时间从旧到新淘汰
+    std::vector<std::pair<fs::file_time_type, std::string>> byAge;
+    byAge.reserve(index_.size());
+    for (const auto& entry : index_) {
+        byAge.emplace_back(entry.second.lastAccess, entry.first);
+    }
+    std::sort(byAge.begin(), byAge.end());
+
+    std::error_code ec;
+    for (const auto& victim : byAge) {
+        if (totalBytes_ <= maxBytes_) {
+            break;
+        }
+        auto it = index_.find(victim.second);
+        fs::remove(entryPath(victim.second), ec);
+        totalBytes_ -= std::min(totalBytes_, it->second.size);
+        index_.erase(it);
+        ++stats_.evictions;
+    }
+}
+
+std::string CompileCache::entryPath(const std::string& key) const {
+    return (fs::path(directory_) / (key + CACHE_EXTENSION)).string();
+}
+
+std::string CompileCache::serialize(const CompileResult& result) {
+    std::string out = CACHE_MAGIC;
+    writeString(out, result.htmlOutput);
+    writeString(out, result.cssOutput);
+    writeString(out, result.jsOutput);
+    writeString(out, result.sourceMap);
+    writeList(out, result.warnings);
+    writeList(out, result.includedFiles);
+    uint64_t fragments = result.processedFragments;
+    out.append(reinterpret_cast<const char*>(&fragments), sizeof(fragments));
+    return out;
+}
+
+std::optional<CompileResult> CompileCache::deserialize(const std::string& data) {
+    const size_t magicLength = sizeof(CACHE_MAGIC) - 1;
+    if (data.compare(0, magicLength, CACHE_MAGIC) != 0) {
+        return std::nullopt;
+    }
+
+    std::string body = data.substr(magicLength);
+    Reader reader(body);
+    CompileResult result;
+    result.htmlOutput = reader.readString();
+    result.cssOutput = reader.readString();
+    result.jsOutput = reader.readString();
+    result.sourceMap = reader.readString();
+    result.warnings = reader.readList();
+    result.includedFiles = reader.readList();
+    uint64_t fragments = 0;
+    reader.readU64(fragments);
+    if (reader.failed() || !reader.atEnd()) {
+        return std::nullopt;
+    }
+
+    result.processedFragments = static_cast<size_t>(fragments);
+    result.success = true;
+    return result;
+}
+
+} // namespace CHTL
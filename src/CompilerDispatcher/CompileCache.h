@@ -0,0 +1,83 @@
+#ifndef COMPILE_CACHE_H
+#define COMPILE_CACHE_H
+
+#include <string>
+#include <optional>
+#include <unordered_map>
+#include <mutex>
+#include <filesystem>
+#include <cstdint>
+#include "CompilerDispatcher.h"
+
+namespace CHTL {
+
+// 缓存统计
+struct CompileCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t stores = 0;
+    size_t evictions = 0;
+    size_t entries = 0;
+    size_t totalBytes = 0;
+};
+
+// 持久化编译缓存（按内容寻址）
+// 键由源码哈希、传递导入文件（含CMOD）的路径与内容哈希、编译选项和编译器版本组成，
+// 任一变化都会得到新的键，因此不需要显式失效。
+// 每个条目是缓存目录下的一个文件，以修改时间记录最近访问时间，
+// 总大小超过上限时按LRU淘汰。多个进程共享同一目录是安全的（写入先写临时文件再rename）。
+class CompileCache {
+public:
+    static constexpr size_t DEFAULT_MAX_BYTES = 256 * 1024 * 1024;
+
+    explicit CompileCache(const std::string& directory, size_t maxBytes = DEFAULT_MAX_BYTES);
+    ~CompileCache() = default;
+
+    // 计算缓存键（32位十六进制字符）
+    std::string computeKey(const std::string& inputFile, const std::string& source,
+                           const CompileOptions& options) const;
+
+    // 查找缓存条目，命中时刷新其访问时间
+    std::optional<CompileResult> lookup(const std::string& key);
+
+    // 保存编译结果（只应保存成功的结果）
+    bool store(const std::string& key, const CompileResult& result);
+
+    // 清空缓存目录中的所有条目
+    void clear();
+
+    CompileCacheStats getStats() const;
+    const std::string& getDirectory() const { return directory_; }
+    size_t getMaxBytes() const { return maxBytes_; }
+
+    // 64位内容哈希
+    static uint64_t hash(const void* data, size_t length, uint64_t seed = 0);
+
+    // 禁止拷贝
+    CompileCache(const CompileCache&) = delete;
+    CompileCache& operator=(const CompileCache&) = delete;
+
+private:
+    struct Entry {
+        size_t size = 0;
+        std::filesystem::file_time_type lastAccess;
+    };
+
+    std::string directory_;
+    size_t maxBytes_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> index_;
+    size_t totalBytes_ = 0;
+    CompileCacheStats stats_;
+
+    void loadIndex();
+    void evictIfNeeded();
+    std::string entryPath(const std::string& key) const;
+
+    static std::string serialize(const CompileResult& result);
+    static std::optional<CompileResult> deserialize(const std::string& data);
+};
+
+} // namespace CHTL
+
+#endif // COMPILE_CACHE_H
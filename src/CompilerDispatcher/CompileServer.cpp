@@ -0,0 +1,119 @@
+#include "CompileServer.h"
+#include "../CHTL/CHTLIOStream/CHTLFileSystem.h"
+#include "../CHTL/CHTLLoader/ModuleIndex.h"
+#include "../Util/JsonRpc/JsonRpcServer.h"
+#include <iostream>
+
+namespace CHTL {
+
+namespace {
+
+JsonValue toJsonArray(const std::vector<std::string>& items) {
+    JsonValue array = JsonValue::array();
+    for (const auto& item : items) {
+        array.push(item);
+    }
+    return array;
+}
+
+const std::string& requireString(const JsonValue& params, const char* name) {
+    const JsonValue* value = params.find(name);
+    if (!value || !value->isString() || value->asString().empty()) {
+        throw JsonRpcError(JsonRpcErrorCode::INVALID_PARAMS,
+                           std::string("Missing string parameter: ") + name);
+    }
+    return value->asString();
+}
+
+} // namespace
+
+int runCompileServer(std::istream& in, std::ostream& out, const CompileOptions& baseOptions, size_t jobs) {
+    JsonRpcServer server(in, out, jobs);
+    std::vector<std::shared_ptr<CompilerDispatcher>> dispatchers(server.getWorkerCount());
+    
+    auto dispatcherForWorker = [&dispatchers]() {
+        size_t index = WorkStealingThreadPool::currentWorkerIndex();
+        if (index >= dispatchers.size()) {
+            throw JsonRpcError(JsonRpcErrorCode::INTERNAL_ERROR, "Request not running on a server worker");
+        }
+        if (!dispatchers[index]) {
+            dispatchers[index] = CompilerFactory::createDispatcher();
+        }
+        return dispatchers[index];
+    };
+    
+    // 编译一个请求：file为源文件路径，text（可选）为未保存的内容
+    auto compileRequest = [&](const JsonRpcServer::Request& request, CompileOptions options) {
+        const std::string& file = requireString(request.params(), "file");
+        std::optional<std::string> text;
+        if (const JsonValue* value = request.params().find("text"); value && value->isString()) {
+            text = value->asString();
+        } else if (!FileSystem::exists(file)) {
+            throw JsonRpcError(JsonRpcErrorCode::INVALID_PARAMS, "Input file not found: " + file);
+        }
+        
+        // 新的构建会话：模块目录在下次访问时重新检查mtime，其余索引保持
+        ModuleIndex::getInstance().beginSession();
+        
+        auto dispatcher = dispatcherForWorker();
+        dispatcher->setOptions(options);
+        return dispatcher->compileIsolated(file, text);
+    };
+    
+    server.setHandler("initialize", [&server](const JsonRpcServer::Request&) {
+        JsonValue info = JsonValue::object();
+        info.set("name", "chtlc");
+        info.set("version", CHTL_COMPILER_VERSION);
+        
+        JsonValue result = JsonValue::object();
+        result.set("serverInfo", std::move(info));
+        result.set("workers", server.getWorkerCount());
+        return result;
+    });
+    
+    // compile {file, text?, output?, minify?} -> 写出HTML
+    server.setHandler("compile", [&](const JsonRpcServer::Request& request) {
+        const JsonValue& params = request.params();
+        CompileOptions options = baseOptions;
+        if (const JsonValue* output = params.find("output"); output && output->isString()) {
+            options.outputFile = output->asString();
+        } else {
+            options.outputFile = PathUtil::replaceExtension(requireString(params, "file"), ".html");
+        }
+        if (const JsonValue* minify = params.find("minify"); minify && minify->isBool()) {
+            options.minify = minify->asBool();
+            options.prettify = !options.minify;
+        }
+        
+        auto result = compileRequest(request, options);
+        
+        JsonValue response = JsonValue::object();
+        response.set("success", result.success && result.errors.empty());
+        response.set("outputPath", result.outputPath);
+        response.set("errors", toJsonArray(result.errors));
+        response.set("warnings", toJsonArray(result.warnings));
+        response.set("compilationTime", result.compilationTime);
+        response.set("fromCache", result.fromCache);
+        return response;
+    });
+    
+    // validate {file, text?} -> 只报告诊断，不写输出
+    server.setHandler("validate", [&](const JsonRpcServer::Request& request) {
+        CompileOptions options = baseOptions;
+        options.outputFile.clear();
+        options.cacheDir.clear();
+        
+        auto result = compileRequest(request, options);
+        
+        JsonValue response = JsonValue::object();
+        response.set("valid", result.success && result.errors.empty());
+        response.set("errors", toJsonArray(result.errors));
+        response.set("warnings", toJsonArray(result.warnings));
+        return response;
+    });
+    
+    std::cerr << "CHTL compile server ready (" << server.getWorkerCount() << " workers)\n";
+    return server.run();
+}
+
+} // namespace CHTL
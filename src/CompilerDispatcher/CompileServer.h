@@ -0,0 +1,17 @@
+#ifndef COMPILE_SERVER_H
+#define COMPILE_SERVER_H
+
+#include <iosfwd>
+#include "CompilerDispatcher.h"
+
+namespace CHTL {
+
+// 常驻编译服务：在in/out上以JSON-RPC（LSP分帧）提供 initialize / compile / validate。
+// 进程内的模块索引、编译缓存和各编译器的静态状态在请求之间保持，
+// 每个工作线程使用自己的调度器，请求在独立的单例作用域中编译。
+// out只用于协议消息，日志和诊断写到stderr。返回进程退出码。
+int runCompileServer(std::istream& in, std::ostream& out, const CompileOptions& baseOptions, size_t jobs);
+
+} // namespace CHTL
+
+#endif // COMPILE_SERVER_H
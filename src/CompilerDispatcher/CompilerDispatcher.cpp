@@ -1,45 +1,74 @@
 #include "CompilerDispatcher.h"
+#include "CompileCache.h"
 #include "../Scanner/CHTLUnifiedScanner.h"
 #include "../Scanner/FragmentCollector.h"
+#include "../Scanner/FragmentPipeline.h"
 #include "../CHTL/CHTLParser/Parser.h"
 #include "../CHTL/CHTLGenerator/Generator.h"
 #include "../CHTLJS/CHTLJSParser/Parser.h"
 #include "../CHTLJS/CHTLJSGenerator/Generator.h"
 #include "../CHTL/CHTLIOStream/CHTLFileSystem.h"
+#include "../CHTL/CHTLContext/Context.h"
+#include "../CHTL/CHTLManage/NamespaceManager.h"
+#include "../CHTL/CHTLManage/ConstraintSystem.h"
+#include "../CHTLJS/CHTLJSContext/Context.h"
+#include "../CHTLJS/CJMODSystem/Runtime/CJMODRuntime.h"
 #include "../Error/ErrorReport.h"
+#include "../Util/ScopedInstance.h"
+#include "../Util/ThreadPool/ThreadPool.h"
+#include "../CSS/CSSMinifier.h"
 #include <chrono>
 #include <sstream>
 #include <algorithm>
+#include <mutex>
 
 namespace CHTL {
 
+namespace {
+
+// 片段类型对应的路由规则名（与initialize中注册的默认规则一致）
+std::string fragmentRouteKey(FragmentType type) {
+    switch (type) {
+        case FragmentType::CHTL: return "chtl";
+        case FragmentType::CHTLJS: return "chtljs";
+        case FragmentType::CSS: return "css";
+        case FragmentType::JS: return "javascript";
+        default: return "unknown";
+    }
+}
+
+} // namespace
+
 // 内部实现类
 class CHTLCompilerImpl : public CHTLCompiler {
 public:
-    CHTLCompilerImpl() {
-        parser_ = std::make_shared<Parser>();
-        generator_ = std::make_shared<Generator>();
-    }
-    
     CompileResult compile(const std::string& code, const CompileOptions& options) override {
         CompileResult result;
         
         try {
-            // 词法分析
-            Lexer lexer;
-            auto tokens = lexer.tokenize(code);
+            auto context = std::make_shared<CompileContext>(options.inputFile);
             
-            // 语法分析
-            auto ast = parser_->parse(tokens);
+            // 词法分析 + 语法分析
+            auto lexer = std::make_shared<Lexer>(code, context);
+            Parser parser(lexer, context);
+            auto ast = parser.parse();
+            if (!ast || parser.hasErrors()) {
+                result.success = false;
+                result.errors = parser.getErrors();
+                if (result.errors.empty()) {
+                    result.errors.push_back("CHTL parsing failed");
+                }
+                return result;
+            }
             
             // 代码生成
-            generator_->setOptions(options);
-            auto output = generator_->generate(ast);
+            GeneratorConfig config;
+            config.prettyPrint = options.prettify && !options.minify;
+            config.minify = options.minify;
+            Generator generator(context, config);
             
             result.success = true;
-            result.htmlOutput = output.html;
-            result.cssOutput = output.css;
-            result.jsOutput = output.javascript;
+            result.htmlOutput = generator.generate(ast);
             
         } catch (const std::exception& e) {
             result.success = false;
@@ -51,10 +80,9 @@ public:
     
     bool validate(const std::string& code) override {
         try {
-            Lexer lexer;
-            auto tokens = lexer.tokenize(code);
-            parser_->parse(tokens);
-            return true;
+            auto context = std::make_shared<CompileContext>("");
+            Parser parser(std::make_shared<Lexer>(code, context), context);
+            return parser.parse() && !parser.hasErrors();
         } catch (...) {
             return false;
         }
@@ -76,8 +104,6 @@ public:
     }
     
 private:
-    std::shared_ptr<Parser> parser_;
-    std::shared_ptr<Generator> generator_;
     std::shared_ptr<void> namespaceManager_;
     std::shared_ptr<void> importResolver_;
     std::shared_ptr<void> selectorAutomation_;
@@ -86,25 +112,40 @@ private:
 // CHTL JS编译器实现
 class CHTLJSCompilerImpl : public CHTLJSCompiler {
 public:
-    CHTLJSCompilerImpl() {
-        parser_ = std::make_shared<CHTLJS::Parser>();
-        generator_ = std::make_shared<CHTLJS::Generator>();
-    }
-    
     CompileResult compile(const std::string& code, const CompileOptions& options) override {
         CompileResult result;
         
         try {
-            // 词法分析
-            CHTLJS::Lexer lexer;
-            auto tokens = lexer.tokenize(code);
+            auto context = std::make_shared<CHTLJS::CompileContext>(options.inputFile);
             
-            // 语法分析
-            auto ast = parser_->parse(tokens);
+            // 先展开已加载CJMOD模块提供的语法
+            std::string source;
+            const std::string& input = expandCJMODSyntax(code, source, result.errors) ? source : code;
+            if (!result.errors.empty()) {
+                result.success = false;
+                return result;
+            }
+            
+            // 词法分析 + 语法分析
+            auto lexer = std::make_shared<CHTLJS::Lexer>(input, context);
+            CHTLJS::Parser parser(lexer, context);
+            auto ast = parser.parse();
+            if (!ast || parser.hasErrors()) {
+                result.success = false;
+                result.errors = parser.getErrors();
+                if (result.errors.empty()) {
+                    result.errors.push_back("CHTL JS parsing failed");
+                }
+                return result;
+            }
             
             // 代码生成
-            generator_->setOptions(options);
-            result.jsOutput = generator_->generate(ast);
+            CHTLJS::GeneratorConfig config;
+            config.prettyPrint = options.prettify && !options.minify;
+            config.minify = options.minify;
+            CHTLJS::Generator generator(context, config);
+            
+            result.jsOutput = generator.generate(ast);
             result.success = true;
             
         } catch (const std::exception& e) {
@@ -117,10 +158,15 @@ public:
     
     bool validate(const std::string& code) override {
         try {
-            CHTLJS::Lexer lexer;
-            auto tokens = lexer.tokenize(code);
-            parser_->parse(tokens);
-            return true;
+            auto context = std::make_shared<CHTLJS::CompileContext>("");
+            std::string source;
+            std::vector<std::string> errors;
+            const std::string& input = expandCJMODSyntax(code, source, errors) ? source : code;
+            if (!errors.empty()) {
+                return false;
+            }
+            CHTLJS::Parser parser(std::make_shared<CHTLJS::Lexer>(input, context), context);
+            return parser.parse() && !parser.hasErrors();
         } catch (...) {
             return false;
         }
@@ -138,8 +184,21 @@ public:
     }
     
 private:
-    std::shared_ptr<CHTLJS::Parser> parser_;
-    std::shared_ptr<CHTLJS::Generator> generator_;
+    // 没有加载任何CJMOD语法时返回false，直接使用原代码
+    static bool expandCJMODSyntax(const std::string& code, std::string& expanded,
+                                  std::vector<std::string>& errors) {
+        auto& runtime = CJMODRuntime::getInstance();
+        if (!runtime.hasSyntax()) {
+            return false;
+        }
+        auto result = runtime.expandSyntax(code);
+        if (!result.success) {
+            errors.push_back("CJMOD: " + result.errorMessage);
+        }
+        expanded = std::move(result.generatedCode);
+        return true;
+    }
+    
     std::shared_ptr<void> cjmodLoader_;
     std::shared_ptr<void> virtualObjectManager_;
 };
@@ -153,12 +212,7 @@ public:
         result.success = true;
         
         if (options.minify) {
-            // 简单的压缩：移除多余空白
-            result.cssOutput.erase(
-                std::remove_if(result.cssOutput.begin(), result.cssOutput.end(),
-                              [](char c) { return c == '\n' || c == '\r'; }),
-                result.cssOutput.end()
-            );
+            result.cssOutput = CSSMinifier().minify(code);
         }
         
         return result;
@@ -199,7 +253,6 @@ public:
             // 实际实现需要更复杂的处理
             std::string minified;
             bool inString = false;
-            bool inComment = false;
             
             for (size_t i = 0; i < code.length(); ++i) {
                 if (!inString && i + 1 < code.length() && 
@@ -232,7 +285,7 @@ public:
         return result;
     }
     
-    bool validate(const std::string& code) override {
+    bool validate(const std::string& /*code*/) override {
         // 简单的JS验证
         return true;
     }
@@ -289,7 +342,31 @@ CompileResult CompilerDispatcher::compile(const std::string& inputFile) {
         return result;
     }
     
+    // 查询编译缓存：命中时只需重新写出输出文件
+    auto cache = ensureCache();
+    std::string cacheKey;
+    if (cache) {
+        cacheKey = cache->computeKey(inputFile, *contentOpt, options_);
+        if (auto cached = cache->lookup(cacheKey)) {
+            CompileResult result = std::move(*cached);
+            result.fromCache = true;
+            generateOutput(result);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            result.compilationTime = std::chrono::duration<double>(end - start).count();
+            return result;
+        }
+    }
+    
+    // 生成器等通过ErrorReport上报的错误不会进入result.errors，
+    // 以编译前后的错误计数判断本次编译是否出错，出错的结果不能缓存
+    size_t errorsBefore = ErrorReport::getInstance().getTotalErrors();
     CompileResult result = doCompile(*contentOpt, inputFile);
+    bool reportedErrors = ErrorReport::getInstance().getTotalErrors() != errorsBefore;
+    
+    if (cache && result.success && result.errors.empty() && !reportedErrors) {
+        cache->store(cacheKey, result);
+    }
     
     auto end = std::chrono::high_resolution_clock::now();
     result.compilationTime = std::chrono::duration<double>(end - start).count();
@@ -297,6 +374,17 @@ CompileResult CompilerDispatcher::compile(const std::string& inputFile) {
     return result;
 }
 
+std::shared_ptr<CompileCache> CompilerDispatcher::ensureCache() {
+    if (options_.cacheDir.empty()) {
+        return nullptr;
+    }
+    if (!cache_ || cache_->getDirectory() != options_.cacheDir ||
+        cache_->getMaxBytes() != options_.cacheMaxBytes) {
+        cache_ = std::make_shared<CompileCache>(options_.cacheDir, options_.cacheMaxBytes);
+    }
+    return cache_;
+}
+
 CompileResult CompilerDispatcher::compileString(const std::string& content, const std::string& filename) {
     auto start = std::chrono::high_resolution_clock::now();
     
@@ -309,6 +397,11 @@ CompileResult CompilerDispatcher::compileString(const std::string& content, cons
 }
 
 std::vector<CompileResult> CompilerDispatcher::compileBatch(const std::vector<std::string>& files) {
+    size_t jobs = std::min(WorkStealingThreadPool::resolveWorkerCount(options_.parallelJobs), files.size());
+    if (jobs > 1) {
+        return compileBatchParallel(files, jobs);
+    }
+    
     std::vector<CompileResult> results;
     size_t total = files.size();
     size_t current = 0;
@@ -328,6 +421,127 @@ std::vector<CompileResult> CompilerDispatcher::compileBatch(const std::vector<st
     return results;
 }
 
+std::vector<CompileResult> CompilerDispatcher::compileBatchParallel(const std::vector<std::string>& files, size_t jobs) {
+    size_t total = files.size();
+    std::vector<CompileResult> results(total);
+    
+    // 工作线程中通过处理器上报的错误/警告，按文件缓存后在调用线程中按输入顺序回放
+    std::vector<std::vector<std::string>> reportedErrors(total);
+    std::vector<std::vector<std::string>> reportedWarnings(total);
+    
+    // 进度按完成数单调递增上报，回调始终在持有锁时调用，不会并发进入
+    std::mutex progressMutex;
+    size_t completed = 0;
+    if (progressCallback_) {
+        progressCallback_(0, total);
+    }
+    
+    // 编译缓存在各工作线程间共享（内部加锁）
+    ensureCache();
+    
+    // 每个工作线程一个独立的调度器：扫描器、词法/语法分析器和生成器都不跨线程共享
+    std::vector<std::unique_ptr<CompilerDispatcher>> workers(jobs);
+    
+    {
+        WorkStealingThreadPool pool(jobs);
+        
+        for (size_t i = 0; i < total; ++i) {
+            pool.post([&, i]() {
+                auto& worker = workers[WorkStealingThreadPool::currentWorkerIndex()];
+                if (!worker) {
+                    worker = createWorker();
+                }
+                
+                worker->setErrorHandler([&reportedErrors, i](const std::string& error) {
+                    reportedErrors[i].push_back(error);
+                });
+                worker->setWarningHandler([&reportedWarnings, i](const std::string& warning) {
+                    reportedWarnings[i].push_back(warning);
+                });
+                
+                try {
+                    results[i] = worker->compileIsolated(files[i]);
+                } catch (const std::exception& e) {
+                    results[i].success = false;
+                    results[i].errors.push_back(e.what());
+                }
+                
+                std::lock_guard<std::mutex> lock(progressMutex);
+                ++completed;
+                if (progressCallback_ && completed < total) {
+                    progressCallback_(completed, total);
+                }
+            });
+        }
+        
+        pool.waitIdle();
+    }
+    
+    if (progressCallback_) {
+        progressCallback_(total, total);
+    }
+    
+    for (size_t i = 0; i < total; ++i) {
+        if (errorHandler_) {
+            for (const auto& error : reportedErrors[i]) {
+                errorHandler_(error);
+            }
+        }
+        if (warningHandler_) {
+            for (const auto& warning : reportedWarnings[i]) {
+                warningHandler_(warning);
+            }
+        }
+    }
+    
+    return results;
+}
+
+std::unique_ptr<CompilerDispatcher> CompilerDispatcher::createWorker() const {
+    auto worker = std::make_unique<CompilerDispatcher>();
+    worker->initialize();
+    worker->options_ = options_;
+    worker->options_.parallelJobs = 1;
+    // 批量编译已经按文件并行，单个文件内不再使用流水线
+    worker->options_.pipelineFragments = false;
+    worker->fragmentRoutes_ = fragmentRoutes_;
+    worker->cache_ = cache_;
+    return worker;
+}
+
+CompileResult CompilerDispatcher::compileIsolated(const std::string& inputFile,
+                                                  const std::optional<std::string>& content) {
+    // 编译期间替换当前线程的单例，使各编译任务的命名空间、符号表、约束、
+    // 上下文和错误状态完全独立
+    ScopedInstance<ErrorReport> errorReport;
+    ScopedInstance<NamespaceManager> namespaceManager;
+    ScopedInstance<ConstraintManager> constraintManager;
+    ScopedInstance<GlobalMap> globalMap;
+    ScopedInstance<ContextManager> contextManager;
+    ScopedInstance<CHTLJS::GlobalMap> chtljsGlobalMap;
+    ScopedInstance<CHTLJS::ContextManager> chtljsContextManager;
+    
+    auto collector = std::make_shared<ErrorCollector>();
+    errorReport.get().addReporter(collector);
+    constraintManager.get().loadPredefinedConstraints();
+    
+    auto context = contextManager.get().createContext(inputFile);
+    ContextGuard contextGuard(context);
+    
+    CompileResult result = content ? compileString(*content, inputFile) : compile(inputFile);
+    
+    // 原本输出到全局报告器的诊断信息并入本文件的编译结果
+    for (const auto& error : collector->getErrors()) {
+        if (error.level == ErrorLevel::ERROR || error.level == ErrorLevel::FATAL) {
+            result.errors.push_back(error.message);
+        } else if (error.level == ErrorLevel::WARNING) {
+            result.warnings.push_back(error.message);
+        }
+    }
+    
+    return result;
+}
+
 void CompilerDispatcher::registerCompiler(CompilerType type, std::shared_ptr<void> compiler) {
     compilers_[type] = compiler;
 }
@@ -340,38 +554,18 @@ CompileResult CompilerDispatcher::doCompile(const std::string& content, const st
     CompileResult result;
     
     try {
-        // 使用统一扫描器分析代码
-        auto fragments = scanner_->scan(content);
-        
-        // 使用FragmentCollector收集同类型片段
-        FragmentCollector collector;
-        collector.processFragments(fragments);
-        
-        // 记录处理的片段数
-        result.processedFragments = fragments.size();
-        
-        // 处理CHTL片段（如果有）
-        if (collector.hasContent(FragmentType::CHTL)) {
-            auto chtlResult = compileCHTL(collector.getCompleteCode(FragmentType::CHTL));
-            mergeResults(result, chtlResult);
-        }
-        
-        // 处理CHTL JS片段（如果有）
-        if (collector.hasContent(FragmentType::CHTLJS)) {
-            auto cjtlJsResult = compileCHTLJS(collector.getCompleteCode(FragmentType::CHTLJS));
-            mergeResults(result, cjtlJsResult);
-        }
-        
-        // 处理CSS片段（如果有）- 传递完整的CSS代码给CSS编译器
-        if (collector.hasContent(FragmentType::CSS)) {
-            auto cssResult = compileCSS(collector.getCompleteCSS());
-            mergeResults(result, cssResult);
+        StageResults stageResults;
+        if (options_.pipelineFragments) {
+            result.processedFragments = compilePipelined(content, stageResults);
+        } else {
+            result.processedFragments = compileSequential(content, stageResults);
         }
         
-        // 处理JavaScript片段（如果有）- 传递完整的JS代码给JS编译器
-        if (collector.hasContent(FragmentType::JavaScript)) {
-            auto jsResult = compileJavaScript(collector.getCompleteJavaScript());
-            mergeResults(result, jsResult);
+        // 按固定类型顺序合并，输出与编译完成的先后无关
+        for (const auto& stageResult : stageResults) {
+            if (stageResult) {
+                mergeResults(result, *stageResult);
+            }
         }
         
         // 生成最终输出
@@ -388,6 +582,105 @@ CompileResult CompilerDispatcher::doCompile(const std::string& content, const st
     return result;
 }
 
+size_t CompilerDispatcher::compileSequential(const std::string& content, StageResults& stageResults) {
+    // 使用统一扫描器分析代码
+    auto fragments = scanner_->scan(content);
+    
+    // 使用FragmentCollector收集同类型片段
+    FragmentCollector collector;
+    collector.processFragments(fragments);
+    
+    // 处理CHTL片段（如果有）
+    if (collector.hasContent(FragmentType::CHTL)) {
+        stageResults[0] = compileCHTL(collector.getCompleteCode(FragmentType::CHTL));
+    }
+    
+    // 处理CHTL JS片段（如果有）
+    if (collector.hasContent(FragmentType::CHTLJS)) {
+        stageResults[1] = compileCHTLJS(collector.getCompleteCode(FragmentType::CHTLJS));
+    }
+    
+    // 处理CSS片段（如果有）- 传递完整的CSS代码给CSS编译器
+    if (collector.hasContent(FragmentType::CSS)) {
+        stageResults[2] = compileCSS(collector.getCompleteCSS());
+    }
+    
+    // 处理JavaScript片段（如果有）- 传递完整的JS代码给JS编译器
+    if (collector.hasContent(FragmentType::JS)) {
+        stageResults[3] = compileJavaScript(collector.getCompleteJavaScript());
+    }
+    
+    return fragments.size();
+}
+
+size_t CompilerDispatcher::compilePipelined(const std::string& content, StageResults& stageResults) {
+    // 收集任务在扫描结束前一直占用工作线程：两次编译交错占满线程池时，
+    // 各自排队的收集任务都等不到线程，扫描在有界队列上互相阻塞
+    std::lock_guard<std::mutex> pipelineLock(pipelineMutex_);
+    
+    // CHTL和CHTL JS的单例各只被自己的阶段使用，工作线程直接沿用调用线程的
+    // 作用域实例（compileIsolated中设置，未设置时为nullptr，同样回落到全局实例）
+    auto* namespaceManager = ScopedInstance<NamespaceManager>::current();
+    auto* constraintManager = ScopedInstance<ConstraintManager>::current();
+    auto* globalMap = ScopedInstance<GlobalMap>::current();
+    auto* contextManager = ScopedInstance<ContextManager>::current();
+    auto* chtljsGlobalMap = ScopedInstance<CHTLJS::GlobalMap>::current();
+    auto* chtljsContextManager = ScopedInstance<CHTLJS::ContextManager>::current();
+    
+    // ErrorReport会被所有阶段写入：每个阶段使用独立实例，结束后按类型顺序回放
+    std::array<std::vector<ErrorInfo>, 4> diagnostics;
+    auto stage = [&](size_t index, std::function<CompileResult(const std::string&)> compileStage) {
+        return [&diagnostics, &stageResults, index, compileStage](const std::string& code) {
+            ScopedInstance<ErrorReport> errorReport;
+            auto collector = std::make_shared<ErrorCollector>();
+            errorReport.get().addReporter(collector);
+            stageResults[index] = compileStage(code);
+            diagnostics[index] = collector->getErrors();
+        };
+    };
+    
+    FragmentPipeline pipeline(ensurePipelinePool(), options_.fragmentQueueCapacity);
+    pipeline.setStage(FragmentType::CHTL, stage(0, [&](const std::string& code) {
+        ScopedInstanceBinding<NamespaceManager> boundNamespaces(namespaceManager);
+        ScopedInstanceBinding<ConstraintManager> boundConstraints(constraintManager);
+        ScopedInstanceBinding<GlobalMap> boundGlobalMap(globalMap);
+        ScopedInstanceBinding<ContextManager> boundContexts(contextManager);
+        return compileCHTL(code);
+    }));
+    pipeline.setStage(FragmentType::CHTLJS, stage(1, [&](const std::string& code) {
+        ScopedInstanceBinding<CHTLJS::GlobalMap> boundGlobalMap(chtljsGlobalMap);
+        ScopedInstanceBinding<CHTLJS::ContextManager> boundContexts(chtljsContextManager);
+        return compileCHTLJS(code);
+    }));
+    pipeline.setStage(FragmentType::CSS, stage(2, [this](const std::string& code) {
+        return compileCSS(code);
+    }));
+    pipeline.setStage(FragmentType::JS, stage(3, [this](const std::string& code) {
+        return compileJavaScript(code);
+    }));
+    
+    size_t fragmentCount = pipeline.run(*scanner_, content);
+    
+    // 与顺序编译时的报告顺序一致
+    auto& errorReport = ErrorReport::getInstance();
+    for (const auto& reported : diagnostics) {
+        for (const auto& error : reported) {
+            errorReport.report(error);
+        }
+    }
+    
+    return fragmentCount;
+}
+
+WorkStealingThreadPool& CompilerDispatcher::ensurePipelinePool() {
+    // 每种片段一个收集/编译任务，线程数够四种同时运行即可
+    if (!pipelinePool_) {
+        pipelinePool_ = std::make_unique<WorkStealingThreadPool>(
+            std::min<size_t>(WorkStealingThreadPool::resolveWorkerCount(0), 4));
+    }
+    return *pipelinePool_;
+}
+
 void CompilerDispatcher::dispatchFragments(const std::vector<CodeFragment>& fragments, CompileResult& result) {
     result.processedFragments = fragments.size();
     size_t current = 0;
@@ -401,19 +694,19 @@ void CompilerDispatcher::dispatchFragments(const std::vector<CodeFragment>& frag
         auto compiler = getCompiler<ICompiler>(compilerType);
         
         if (!compiler) {
-            reportError("No compiler found for fragment type: " + fragment.type, result);
+            reportError("No compiler found for fragment type: " + fragmentRouteKey(fragment.type), result);
             continue;
         }
         
         CompileOptions fragmentOptions = options_;
-        CompileResult fragmentResult = compiler->compile(fragment.code, fragmentOptions);
+        CompileResult fragmentResult = compiler->compile(fragment.content, fragmentOptions);
         
         mergeResults(result, fragmentResult);
     }
 }
 
 CompileResult CompilerDispatcher::compileCHTL(const std::string& code) {
-    auto compiler = std::static_pointer_cast<CHTLCompiler>(compilers_[CompilerType::CHTL]);
+    auto compiler = getCompiler<CHTLCompiler>(CompilerType::CHTL);
     if (!compiler) {
         CompileResult result;
         result.success = false;
@@ -424,7 +717,7 @@ CompileResult CompilerDispatcher::compileCHTL(const std::string& code) {
 }
 
 CompileResult CompilerDispatcher::compileCHTLJS(const std::string& code) {
-    auto compiler = std::static_pointer_cast<CHTLJSCompiler>(compilers_[CompilerType::CHTLJS]);
+    auto compiler = getCompiler<CHTLJSCompiler>(CompilerType::CHTLJS);
     if (!compiler) {
         CompileResult result;
         result.success = false;
@@ -435,7 +728,7 @@ CompileResult CompilerDispatcher::compileCHTLJS(const std::string& code) {
 }
 
 CompileResult CompilerDispatcher::compileCSS(const std::string& code) {
-    auto compiler = std::static_pointer_cast<CSSCompiler>(compilers_[CompilerType::CSS]);
+    auto compiler = getCompiler<CSSCompiler>(CompilerType::CSS);
     if (!compiler) {
         CompileResult result;
         result.success = false;
@@ -453,7 +746,7 @@ CompileResult CompilerDispatcher::compileCSS(const std::string& code) {
 }
 
 CompileResult CompilerDispatcher::compileJavaScript(const std::string& code) {
-    auto compiler = std::static_pointer_cast<JavaScriptCompiler>(compilers_[CompilerType::JAVASCRIPT]);
+    auto compiler = getCompiler<JavaScriptCompiler>(CompilerType::JAVASCRIPT);
     if (!compiler) {
         CompileResult result;
         result.success = false;
@@ -472,18 +765,18 @@ CompileResult CompilerDispatcher::compileJavaScript(const std::string& code) {
 
 CompilerType CompilerDispatcher::determineCompiler(const CodeFragment& fragment) {
     // 根据片段类型确定编译器
-    auto it = fragmentRoutes_.find(fragment.type);
+    auto it = fragmentRoutes_.find(fragmentRouteKey(fragment.type));
     if (it != fragmentRoutes_.end()) {
         return it->second.compiler;
     }
     
     // 默认路由规则
-    if (fragment.type == "chtl") return CompilerType::CHTL;
-    if (fragment.type == "chtljs" || fragment.type == "script") return CompilerType::CHTLJS;
-    if (fragment.type == "css" || fragment.type == "style") return CompilerType::CSS;
-    if (fragment.type == "javascript" || fragment.type == "js") return CompilerType::JAVASCRIPT;
-    
-    return CompilerType::CHTL; // 默认使用CHTL编译器
+    switch (fragment.type) {
+        case FragmentType::CHTLJS: return CompilerType::CHTLJS;
+        case FragmentType::CSS: return CompilerType::CSS;
+        case FragmentType::JS: return CompilerType::JAVASCRIPT;
+        default: return CompilerType::CHTL; // 默认使用CHTL编译器
+    }
 }
 
 void CompilerDispatcher::mergeResults(CompileResult& mainResult, const CompileResult& fragmentResult) {
@@ -1,12 +1,18 @@
 #ifndef COMPILER_DISPATCHER_H
 #define COMPILER_DISPATCHER_H
 
+#include <array>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <functional>
+#include <optional>
 #include <vector>
 
+// 编译器版本（参与编译缓存键的计算）
+#define CHTL_COMPILER_VERSION "1.0.0"
+
 namespace CHTL {
 
 // 前向声明
@@ -16,6 +22,8 @@ class CSSCompiler;
 class JavaScriptCompiler;
 class CHTLUnifiedScanner;
 struct CodeFragment;
+class CompileCache;
+class WorkStealingThreadPool;
 
 // 编译器类型
 enum class CompilerType {
@@ -37,6 +45,12 @@ struct CompileOptions {
     bool enableDebugInfo = false;
     std::string targetVersion = "ES6";
     std::string encoding = "UTF-8";
+    std::string officialModuleDir;     // 官方模块目录（解析 chtl:: 导入及缓存依赖时使用）
+    size_t parallelJobs = 1;           // 批量编译的工作线程数（0表示使用硬件并发数）
+    bool pipelineFragments = false;    // 扫描与各类型片段的编译流水线并发执行
+    size_t fragmentQueueCapacity = 64; // 流水线中每种片段队列的容量
+    std::string cacheDir;              // 编译缓存目录（为空时不使用缓存）
+    size_t cacheMaxBytes = 256 * 1024 * 1024;  // 编译缓存大小上限
     std::unordered_map<std::string, std::string> customConfig;
 };
 
@@ -53,6 +67,7 @@ struct CompileResult {
     std::vector<std::string> includedFiles;
     size_t processedFragments = 0;
     double compilationTime = 0.0;
+    bool fromCache = false;            // 结果是否来自编译缓存
 };
 
 // 片段路由信息
@@ -82,8 +97,18 @@ public:
     CompileResult compileString(const std::string& content, const std::string& filename = "inline");
     
     // 批量编译
+    // parallelJobs > 1 时使用工作窃取线程池并行编译，结果顺序与输入顺序一致
     std::vector<CompileResult> compileBatch(const std::vector<std::string>& files);
     
+    // 在独立的单例作用域中编译，诊断信息并入结果，不经过错误/警告处理器
+    // 给出content时编译该内容（如编辑器中未保存的文本），inputFile仅用作文件名
+    // 同一调度器不能被多个线程同时使用；并发编译时每个线程使用自己的调度器
+    CompileResult compileIsolated(const std::string& inputFile,
+                                  const std::optional<std::string>& content = std::nullopt);
+    
+    // 设置批量编译的工作线程数（0表示使用硬件并发数）
+    void setParallelJobs(size_t jobs) { options_.parallelJobs = jobs; }
+    
     // 注册编译器
     void registerCompiler(CompilerType type, std::shared_ptr<void> compiler);
     
@@ -114,12 +139,18 @@ public:
     void setProgressCallback(std::function<void(size_t current, size_t total)> callback) {
         progressCallback_ = callback;
     }
+    
+    // 获取编译缓存（未设置cacheDir时为空）
+    std::shared_ptr<CompileCache> getCache() { return ensureCache(); }
 
 private:
     CompileOptions options_;
     std::unordered_map<CompilerType, std::shared_ptr<void>> compilers_;
     std::unique_ptr<CHTLUnifiedScanner> scanner_;
     std::unordered_map<std::string, FragmentRoute> fragmentRoutes_;
+    std::shared_ptr<CompileCache> cache_;
+    std::unique_ptr<WorkStealingThreadPool> pipelinePool_;
+    std::mutex pipelineMutex_;  // 流水线线程池与扫描器同一时间只服务一次编译
     
     // 回调函数
     std::function<void(const std::string&)> errorHandler_;
@@ -127,7 +158,16 @@ private:
     std::function<void(size_t, size_t)> progressCallback_;
     
     // 内部方法
+    std::shared_ptr<CompileCache> ensureCache();
+    std::vector<CompileResult> compileBatchParallel(const std::vector<std::string>& files, size_t jobs);
+    std::unique_ptr<CompilerDispatcher> createWorker() const;
     CompileResult doCompile(const std::string& content, const std::string& filename);
+    
+    // 按CHTL、CHTL JS、CSS、JS顺序存放各类型的编译结果，合并顺序固定
+    using StageResults = std::array<std::optional<CompileResult>, 4>;
+    size_t compileSequential(const std::string& content, StageResults& stageResults);
+    size_t compilePipelined(const std::string& content, StageResults& stageResults);
+    WorkStealingThreadPool& ensurePipelinePool();
     void dispatchFragments(const std::vector<CodeFragment>& fragments, CompileResult& result);
     CompilerType determineCompiler(const CodeFragment& fragment);
     void mergeResults(CompileResult& mainResult, const CompileResult& fragmentResult);
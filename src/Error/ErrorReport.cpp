@@ -422,7 +422,8 @@ std::string ErrorReport::generateErrorCode(ErrorType type) {
         {ErrorType::INTERNAL_ERROR,   "E999"}
     };
     
-    static std::unordered_map<ErrorType, int> counters;
+    // 计数器按线程独立，并行编译时无需加锁
+    static thread_local std::unordered_map<ErrorType, int> counters;
     
     auto it = prefixes.find(type);
     if (it != prefixes.end()) {
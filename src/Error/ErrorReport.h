@@ -8,6 +8,7 @@
 #include <chrono>
 #include <sstream>
 #include <unordered_map>
+#include "../Util/ScopedInstance.h"
 
 namespace CHTL {
 
@@ -153,6 +154,9 @@ class ErrorReport {
     friend class ErrorBuilder;
 public:
     static ErrorReport& getInstance() {
+        if (auto* scoped = ScopedInstance<ErrorReport>::current()) {
+            return *scoped;
+        }
         static ErrorReport instance;
         return instance;
     }
@@ -200,6 +204,7 @@ public:
     void setThrowOnFatal(bool throwOnFatal) { throwOnFatal_ = throwOnFatal; }
     
 private:
+    friend class ScopedInstance<ErrorReport>;
     ErrorReport() = default;
     ErrorReport(const ErrorReport&) = delete;
     ErrorReport& operator=(const ErrorReport&) = delete;
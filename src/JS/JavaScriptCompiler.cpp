@@ -3,6 +3,7 @@
 #include "generated/Grammars/JavaScript/JavaScriptParser.h"
 #include "generated/Grammars/JavaScript/JavaScriptParserBaseVisitor.h"
 #include "../Error/ErrorReport.h"
+#include "../Util/ANTLRUtil/TwoStageParse.h"
 #include <antlr4-runtime.h>
 #include <sstream>
 
@@ -104,29 +105,17 @@ public:
     }
 };
 
-// 错误监听器
-class JavaScriptErrorListener : public BaseErrorListener {
-private:
-    std::vector<std::string>& errors_;
-    
-public:
-    JavaScriptErrorListener(std::vector<std::string>& errors) : errors_(errors) {}
-    
-    void syntaxError(Recognizer *recognizer, Token *offendingSymbol,
-                    size_t line, size_t charPositionInLine,
-                    const std::string &msg, std::exception_ptr e) override {
-        std::ostringstream ss;
-        ss << "JavaScript Syntax error at line " << line << ":" << charPositionInLine 
-           << " - " << msg;
-        errors_.push_back(ss.str());
-        
-        ErrorBuilder(ErrorLevel::ERROR, ErrorType::SYNTAX_ERROR)
-            .withMessage("JavaScript Syntax Error")
-            .withDetail(msg)
-            .withLocation(line, charPositionInLine)
-            .report();
-    }
-};
+namespace {
+
+using JavaScriptParse = TwoStageParse<JavaScriptLexer, JavaScriptParser, JavaScriptParser::ProgramContext>;
+
+// 预热用的典型片段
+const char* const JS_WARM_UP_SOURCE =
+    "const box = document.querySelector('.box');\n"
+    "box.addEventListener('click', (e) => { console.log(e.target, [1, 2].map(x => x * 2)); });\n"
+    "function update(el, value) { if (el) { el.textContent = `${value}`; } return value + 1; }\n";
+
+} // namespace
 
 // JavaScript编译器实现
 JavaScriptCompilerImpl::JavaScriptCompilerImpl() {
@@ -134,6 +123,8 @@ JavaScriptCompilerImpl::JavaScriptCompilerImpl() {
         .withMessage("JavaScript Compiler initialized")
         .withDetail("Using ANTLR4 parser")
         .report();
+    
+    JavaScriptParse::warmUp(JS_WARM_UP_SOURCE, &JavaScriptParser::program);
 }
 
 CompileResult JavaScriptCompilerImpl::compile(const std::string& code, const CompileOptions& options) {
@@ -145,39 +136,25 @@ CompileResult JavaScriptCompilerImpl::compile(const std::string& code, const Com
         .report();
     
     try {
-        // 创建ANTLR输入流
-        ANTLRInputStream input(code);
-        
-        // 创建词法分析器
-        JavaScriptLexer lexer(&input);
-        CommonTokenStream tokens(&lexer);
-        
-        // 创建语法分析器
-        JavaScriptParser parser(&tokens);
-        
-        // 添加错误监听器
-        parser.removeErrorListeners();
-        JavaScriptErrorListener errorListener(result.errors);
-        parser.addErrorListener(&errorListener);
-        
-        // 使用SLL预测模式以提高性能
-        parser.getInterpreter<atn::ParserATNSimulator>()->setPredictionMode(atn::PredictionMode::SLL);
-        
-        tree::ParseTree* tree = nullptr;
-        try {
-            // 尝试使用SLL模式解析
-            tree = parser.program();
-        } catch (std::exception &e) {
-            // 如果SLL失败，回退到LL模式
-            tokens.reset();
-            parser.reset();
-            parser.getInterpreter<atn::ParserATNSimulator>()->setPredictionMode(atn::PredictionMode::LL);
-            tree = parser.program();
+        // 两阶段解析（SLL失败后回退LL）；若validate()刚解析过同一段代码则直接复用
+        auto parse = LastParseSlot<JavaScriptParse>::acquire(code, &JavaScriptParser::program);
+        
+        for (const auto& error : parse->errors()) {
+            std::ostringstream ss;
+            ss << "JavaScript Syntax error at line " << error.line << ":" << error.column 
+               << " - " << error.message;
+            result.errors.push_back(ss.str());
+            
+            ErrorBuilder(ErrorLevel::ERROR, ErrorType::SYNTAX_ERROR)
+                .withMessage("JavaScript Syntax Error")
+                .withDetail(error.message)
+                .withLocation(error.line, error.column)
+                .report();
         }
         
         // 使用访问者生成代码
         JavaScriptVisitorImpl visitor(targetVersion_);
-        visitor.visit(tree);
+        visitor.visit(parse->tree());
         
         result.jsOutput = visitor.getOutput();
         result.success = result.errors.empty();
@@ -204,16 +181,11 @@ CompileResult JavaScriptCompilerImpl::compile(const std::string& code, const Com
 
 bool JavaScriptCompilerImpl::validate(const std::string& code) {
     try {
-        ANTLRInputStream input(code);
-        JavaScriptLexer lexer(&input);
-        CommonTokenStream tokens(&lexer);
-        JavaScriptParser parser(&tokens);
-        
-        // 静默模式
-        parser.removeErrorListeners();
-        parser.program();
-        
-        return true;
+        // 静默模式：错误留给随后的compile()报告
+        auto parse = std::make_shared<JavaScriptParse>(code, &JavaScriptParser::program);
+        bool valid = !parse->hasErrors();
+        LastParseSlot<JavaScriptParse>::keep(std::move(parse));
+        return valid;
     } catch (...) {
         return false;
     }
@@ -1,4 +1,5 @@
 #include "CHTLUnifiedScanner.h"
+#include "FragmentClassifier.h"
 #include <regex>
 #include <algorithm>
 #include <unordered_map>
@@ -16,14 +17,53 @@ public:
     size_t currentLine = 1;
     size_t currentColumn = 1;
     
-    // CHTL关键字模式
+    // 切割点判断的前缀状态（字符串与花括号嵌套），按位置递增复用，
+    // 避免每次判断都从源码开头重新扫描。
+    // 每次scan()开始时重置；同一次扫描内以数据指针和长度识别源码
+    struct PrefixState {
+        const char* data = nullptr;
+        size_t size = 0;
+        size_t position = 0;
+        bool inString = false;
+        char stringChar = 0;
+        size_t braceDepth = 0;
+    } prefix;
+    
+    const PrefixState& advancePrefix(const std::string& content, size_t position) {
+        if (prefix.data != content.data() || prefix.size != content.size() || prefix.position > position) {
+            prefix = PrefixState();
+            prefix.data = content.data();
+            prefix.size = content.size();
+        }
+        
+        for (size_t i = prefix.position; i < position; i++) {
+            char c = content[i];
+            if (!prefix.inString && (c == '"' || c == '\'')) {
+                prefix.inString = true;
+                prefix.stringChar = c;
+            } else if (prefix.inString && c == prefix.stringChar &&
+                       (i == 0 || content[i-1] != '\\')) {
+                prefix.inString = false;
+            }
+            
+            if (c == '{') prefix.braceDepth++;
+            else if (c == '}' && prefix.braceDepth > 0) prefix.braceDepth--;
+        }
+        prefix.position = position;
+        return prefix;
+    }
+    
+    // 正则参考实现（仅在useRegexClassifier时编译）
+    // 默认使用FragmentClassifier状态机，二者识别结果一致
     std::regex chtlKeywordPattern;
     std::regex chtljsPattern;
     std::regex cssPattern;
     std::regex jsPattern;
     
     Impl(const ScannerConfig& cfg) : config(cfg) {
-        initializePatterns();
+        if (config.useRegexClassifier) {
+            initializePatterns();
+        }
     }
     
     void initializePatterns() {
@@ -65,11 +105,20 @@ CHTLUnifiedScanner::~CHTLUnifiedScanner() = default;
 
 std::vector<CodeFragment> CHTLUnifiedScanner::scan(const std::string& sourceCode) {
     std::vector<CodeFragment> fragments;
+    scan(sourceCode, [&fragments](CodeFragment&& fragment) {
+        fragments.push_back(std::move(fragment));
+    });
+    return fragments;
+}
+
+void CHTLUnifiedScanner::scan(const std::string& sourceCode, const FragmentSink& sink) {
     size_t position = 0;
     size_t sliceSize = pImpl->config.initialSliceSize;
     
     pImpl->currentLine = 1;
     pImpl->currentColumn = 1;
+    // 扫描器可能被复用于原地修改过的同一字符串，缓存的前缀状态不再可信
+    pImpl->prefix = Impl::PrefixState();
     
     while (position < sourceCode.length()) {
         // 确定当前切片大小
@@ -105,34 +154,24 @@ std::vector<CodeFragment> CHTLUnifiedScanner::scan(const std::string& sourceCode
         // 如果启用最小单元切片，对CHTL和CHTL JS片段进行二次切割
         if (pImpl->config.enableMinimalUnitSlicing && 
             (type == FragmentType::CHTL || type == FragmentType::CHTLJS)) {
-            auto subFragments = performSecondarySlicing(fragment);
-            fragments.insert(fragments.end(), subFragments.begin(), subFragments.end());
+            for (auto& subFragment : performSecondarySlicing(fragment)) {
+                sink(std::move(subFragment));
+            }
         } else {
-            fragments.push_back(fragment);
+            sink(std::move(fragment));
         }
         
         position = currentSliceEnd;
     }
-    
-    return fragments;
 }
 
 bool CHTLUnifiedScanner::isValidCutPoint(const std::string& content, size_t position) {
     if (position >= content.length()) return true;
     
+    const auto& prefix = pImpl->advancePrefix(content, position);
+    
     // 检查是否在字符串字面量中
-    bool inString = false;
-    char stringChar = 0;
-    for (size_t i = 0; i < position; i++) {
-        if (!inString && (content[i] == '"' || content[i] == '\'')) {
-            inString = true;
-            stringChar = content[i];
-        } else if (inString && content[i] == stringChar && 
-                   (i == 0 || content[i-1] != '\\')) {
-            inString = false;
-        }
-    }
-    if (inString) return false;
+    if (prefix.inString) return false;
     
     // 检查是否在注释中
     if (position > 0) {
@@ -148,12 +187,7 @@ bool CHTLUnifiedScanner::isValidCutPoint(const std::string& content, size_t posi
     }
     
     // 检查是否在CHTL结构中
-    std::stack<char> brackets;
-    for (size_t i = 0; i < position; i++) {
-        if (content[i] == '{') brackets.push('{');
-        else if (content[i] == '}' && !brackets.empty()) brackets.pop();
-    }
-    if (!brackets.empty()) return false;
+    if (prefix.braceDepth > 0) return false;
     
     // 检查是否在CHTL JS增强选择器中
     size_t doubleBraceStart = content.rfind("{{", position);
@@ -175,8 +209,58 @@ FragmentType CHTLUnifiedScanner::detectFragmentType(const std::string& content,
         }
     }
     
-    // 使用正则表达式匹配检测类型
+    if (pImpl->config.useRegexClassifier) {
+        return detectFragmentTypeByRegex(content, position);
+    }
+    
+    // 单遍状态机一次得到全部特征
     // 优先级：CHTL JS > CHTL > CSS > JS
+    FragmentFeatures features = FragmentClassifier::classify(content);
+    
+    if (features.hasCHTLJSSyntax) {
+        return FragmentType::CHTLJS;
+    }
+    
+    if (features.hasCHTLKeyword) {
+        return FragmentType::CHTL;
+    }
+    
+    // 检测是否在style块中（CSS）
+    size_t styleStart = content.find("style");
+    if (styleStart != std::string::npos) {
+        size_t braceStart = content.find("{", styleStart);
+        if (braceStart != std::string::npos && position > braceStart) {
+            return FragmentType::CSS;
+        }
+    }
+    
+    // 检测是否在script块中（JS）
+    size_t scriptStart = content.find("script");
+    if (scriptStart != std::string::npos) {
+        size_t braceStart = content.find("{", scriptStart);
+        if (braceStart != std::string::npos && position > braceStart) {
+            // 再次检查是否包含CHTL JS语法
+            std::string_view scriptContent = std::string_view(content).substr(braceStart);
+            if (FragmentClassifier::classify(scriptContent).hasCHTLJSSyntax) {
+                return FragmentType::CHTLJS;
+            }
+            return FragmentType::JS;
+        }
+    }
+    
+    if (features.hasCSSSyntax) {
+        return FragmentType::CSS;
+    }
+    
+    if (features.hasJSKeyword) {
+        return FragmentType::JS;
+    }
+    
+    return FragmentType::UNKNOWN;
+}
+
+FragmentType CHTLUnifiedScanner::detectFragmentTypeByRegex(const std::string& content, size_t position) {
+    // 正则参考实现：优先级 CHTL JS > CHTL > CSS > JS
     
     // 检测CHTL JS特征
     if (std::regex_search(content, pImpl->chtljsPattern)) {
@@ -229,6 +313,10 @@ std::vector<CodeFragment> CHTLUnifiedScanner::performSecondarySlicing(const Code
     const std::string& content = fragment.content;
     size_t position = 0;
     
+    // 子片段起始行列随position递增推进
+    size_t subLine = fragment.startLine;
+    size_t subColumn = fragment.startColumn;
+    
     // 对CHTL和CHTL JS片段进行最小单元切割
     while (position < content.length()) {
         size_t unitEnd = position;
@@ -236,9 +324,8 @@ std::vector<CodeFragment> CHTLUnifiedScanner::performSecondarySlicing(const Code
         if (fragment.type == FragmentType::CHTLJS) {
             // 处理CHTL JS最小单元
             // 例如：{{box}}-> 应该被切割为 {{box}} 和 ->
-            size_t doubleBraceStart = content.find("{{", position);
-            if (doubleBraceStart != std::string::npos && doubleBraceStart == position) {
-                size_t doubleBraceEnd = content.find("}}", doubleBraceStart);
+            if (content.compare(position, 2, "{{") == 0) {
+                size_t doubleBraceEnd = content.find("}}", position);
                 if (doubleBraceEnd != std::string::npos) {
                     unitEnd = doubleBraceEnd + 2;
                 }
@@ -262,12 +349,18 @@ std::vector<CodeFragment> CHTLUnifiedScanner::performSecondarySlicing(const Code
             size_t nextKeyword = std::string::npos;
             
             // 查找下一个CHTL关键字
-            std::smatch match;
-            std::string searchStr = content.substr(position);
-            if (std::regex_search(searchStr, match, pImpl->chtlKeywordPattern)) {
-                if (match.position() > 0) {
-                    nextKeyword = position + match.position();
+            size_t keywordOffset = std::string::npos;
+            if (pImpl->config.useRegexClassifier) {
+                std::smatch match;
+                std::string searchStr = content.substr(position);
+                if (std::regex_search(searchStr, match, pImpl->chtlKeywordPattern)) {
+                    keywordOffset = match.position();
                 }
+            } else {
+                keywordOffset = FragmentClassifier::findCHTLKeyword(content, position);
+            }
+            if (keywordOffset != std::string::npos && keywordOffset > 0) {
+                nextKeyword = position + keywordOffset;
             }
             
             if (nextBrace != std::string::npos && nextKeyword != std::string::npos) {
@@ -289,20 +382,6 @@ std::vector<CodeFragment> CHTLUnifiedScanner::performSecondarySlicing(const Code
         // 创建子片段
         std::string unitContent = content.substr(position, unitEnd - position);
         if (!unitContent.empty()) {
-            // 计算子片段的行列位置
-            size_t subLine = fragment.startLine;
-            size_t subColumn = fragment.startColumn;
-            
-            // 更新到当前位置
-            for (size_t i = 0; i < position; i++) {
-                if (content[i] == '\n') {
-                    subLine++;
-                    subColumn = 1;
-                } else {
-                    subColumn++;
-                }
-            }
-            
             size_t endLine = subLine;
             size_t endColumn = subColumn;
             
@@ -318,6 +397,9 @@ std::vector<CodeFragment> CHTLUnifiedScanner::performSecondarySlicing(const Code
             
             subFragments.emplace_back(fragment.type, unitContent, 
                                     subLine, subColumn, endLine, endColumn);
+            
+            subLine = endLine;
+            subColumn = endColumn;
         }
         
         position = unitEnd;
@@ -363,6 +445,7 @@ void CHTLUnifiedScanner::setFragmentRecognizer(FragmentType type,
 void CHTLUnifiedScanner::reset() {
     pImpl->currentLine = 1;
     pImpl->currentColumn = 1;
+    pImpl->prefix = Impl::PrefixState();
     pImpl->recognizers.clear();
 }
 
@@ -376,13 +459,12 @@ bool CHTLUnifiedScanner::isCHTLMinimalUnit(const std::string& content, size_t st
     // 3. 单个括号
     // 4. 注释
     
-    std::smatch match;
-    if (std::regex_match(unit, match, pImpl->chtlKeywordPattern)) {
+    if (FragmentClassifier::isCHTLKeyword(unit)) {
         return true;
     }
     
     // 检查是否为属性定义
-    if (std::regex_match(unit, std::regex(R"(^\s*[\w-]+\s*:\s*[^;]+;\s*$)"))) {
+    if (FragmentClassifier::isPropertyDeclaration(unit)) {
         return true;
     }
     
@@ -405,7 +487,7 @@ bool CHTLUnifiedScanner::isCHTLJSMinimalUnit(const std::string& content, size_t
     // 4. CHTL JS关键字
     
     // 检查增强选择器
-    if (std::regex_match(unit, std::regex(R"(^\{\{[^}]+\}\}$)"))) {
+    if (FragmentClassifier::isEnhancedSelector(unit)) {
         return true;
     }
     
@@ -38,6 +38,7 @@ struct ScannerConfig {
     size_t maxSliceSize = 8192;         // 最大切片大小
     bool enableVariableLengthSlicing = true;  // 启用可变长度切片
     bool enableMinimalUnitSlicing = true;     // 启用最小单元切片
+    bool useRegexClassifier = false;          // 使用正则参考实现识别片段（仅用于差分测试）
 };
 
 // CHTLUnifiedScanner - 精准代码切割器
@@ -46,9 +47,15 @@ public:
     explicit CHTLUnifiedScanner(const ScannerConfig& config = ScannerConfig());
     ~CHTLUnifiedScanner();
     
+    // 片段按源码顺序逐个交给sink
+    using FragmentSink = std::function<void(CodeFragment&&)>;
+    
     // 扫描整个源代码，返回切割后的代码片段
     std::vector<CodeFragment> scan(const std::string& sourceCode);
     
+    // 扫描整个源代码，每切出一个片段立即交给sink（用于扫描与编译流水线）
+    void scan(const std::string& sourceCode, const FragmentSink& sink);
+    
     // 设置自定义的片段识别器
     void setFragmentRecognizer(FragmentType type, 
                                std::function<bool(const std::string&, size_t)> recognizer);
@@ -64,6 +71,7 @@ private:
     bool isValidCutPoint(const std::string& content, size_t position);
     std::vector<CodeFragment> performSecondarySlicing(const CodeFragment& fragment);
     FragmentType detectFragmentType(const std::string& content, size_t position);
+    FragmentType detectFragmentTypeByRegex(const std::string& content, size_t position);
     
     // CHTL和CHTL JS最小单元检测
     bool isCHTLMinimalUnit(const std::string& content, size_t start, size_t end);
@@ -0,0 +1,295 @@
+#include "FragmentClassifier.h"
+#include <cstring>
+
+namespace CHTL {
+
+namespace {
+
+// \w：[A-Za-z0-9_]
+inline bool isWordChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '_';
+}
+
+// \s：空格、\t、\n、\v、\f、\r
+inline bool isSpaceChar(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool isWordOrDash(char c) {
+    return isWordChar(c) || c == '-';
+}
+
+// start之前视为输入起点（非单词字符）
+inline bool isWordBoundary(std::string_view s, size_t pos, size_t start) {
+    bool prevWord = pos > start && isWordChar(s[pos - 1]);
+    bool currWord = pos < s.size() && isWordChar(s[pos]);
+    return prevWord != currWord;
+}
+
+inline bool startsWith(std::string_view s, size_t pos, std::string_view literal) {
+    return s.size() - pos >= literal.size() &&
+           std::memcmp(s.data() + pos, literal.data(), literal.size()) == 0;
+}
+
+// 跳过空白，返回第一个非空白位置
+inline size_t skipSpaces(std::string_view s, size_t pos) {
+    while (pos < s.size() && isSpaceChar(s[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+// 按原正则中的备选顺序排列
+const std::string_view CHTL_KEYWORDS[] = {
+    "text", "style", "script", "div", "span", "body", "html", "head",
+    "[Template]", "[Custom]", "[Origin]", "[Import]", "[Configuration]", "[Namespace]",
+    "@Style", "@Element", "@Var",
+    "inherit", "delete", "insert", "use"
+};
+
+const std::string_view JS_KEYWORDS[] = {
+    "function", "const", "let", "var", "if", "else", "for", "while",
+    "return", "class", "extends", "import", "export"
+};
+
+// 以 \s*\{ 结尾的CHTL JS块关键字
+const std::string_view CHTLJS_BLOCK_KEYWORDS[] = {
+    "module", "listen", "delegate", "animate", "iNeverAway"
+};
+
+// 关键字首字符表：快速排除不可能匹配的位置
+struct FirstCharTable {
+    bool chtl[256] = {};
+    bool js[256] = {};
+    bool chtljs[256] = {};
+
+    FirstCharTable() {
+        for (auto keyword : CHTL_KEYWORDS) chtl[static_cast<unsigned char>(keyword[0])] = true;
+        for (auto keyword : JS_KEYWORDS) js[static_cast<unsigned char>(keyword[0])] = true;
+        for (auto keyword : CHTLJS_BLOCK_KEYWORDS) chtljs[static_cast<unsigned char>(keyword[0])] = true;
+        chtljs[static_cast<unsigned char>('v')] = true;  // vir
+    }
+};
+
+const FirstCharTable& firstChars() {
+    static const FirstCharTable table;
+    return table;
+}
+
+// 选择器状态机：\.[\w-]+\s*\{ 与 #[\w-]+\s*\{
+enum class SelectorState {
+    IDLE,       // 等待 . 或 #
+    PREFIX,     // 已读到 . 或 #，需要至少一个[\w-]
+    NAME,       // 读取名称
+    SPACE       // 名称后的空白，等待 {
+};
+
+} // namespace
+
+size_t FragmentClassifier::matchCHTLKeywordAt(std::string_view content, size_t pos, size_t start) {
+    if (!firstChars().chtl[static_cast<unsigned char>(content[pos])]) {
+        return 0;
+    }
+    for (auto keyword : CHTL_KEYWORDS) {
+        if (startsWith(content, pos, keyword) &&
+            isWordBoundary(content, pos + keyword.size(), start)) {
+            return keyword.size();
+        }
+    }
+    return 0;
+}
+
+size_t FragmentClassifier::matchJSKeywordAt(std::string_view content, size_t pos, size_t start) {
+    if (!firstChars().js[static_cast<unsigned char>(content[pos])]) {
+        return 0;
+    }
+    for (auto keyword : JS_KEYWORDS) {
+        if (startsWith(content, pos, keyword) &&
+            isWordBoundary(content, pos + keyword.size(), start)) {
+            return keyword.size();
+        }
+    }
+    return 0;
+}
+
+bool FragmentClassifier::matchCHTLJSKeywordAt(std::string_view content, size_t pos) {
+    if (!firstChars().chtljs[static_cast<unsigned char>(content[pos])]) {
+        return false;
+    }
+
+    // module\s*\{ | listen\s*\{ | delegate\s*\{ | animate\s*\{ | iNeverAway\s*\{
+    for (auto keyword : CHTLJS_BLOCK_KEYWORDS) {
+        if (startsWith(content, pos, keyword)) {
+            size_t next = skipSpaces(content, pos + keyword.size());
+            if (next < content.size() && content[next] == '{') {
+                return true;
+            }
+        }
+    }
+
+    // vir\s+\w+
+    if (startsWith(content, pos, "vir")) {
+        size_t next = skipSpaces(content, pos + 3);
+        if (next > pos + 3 && next < content.size() && isWordChar(content[next])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+FragmentFeatures FragmentClassifier::classify(std::string_view content) {
+    FragmentFeatures features;
+    const size_t length = content.size();
+
+    // 属性声明 [\w-]+\s*:\s*[^;]+; 的状态：当前分号区间内第一个合格冒号的位置
+    size_t qualifiedColon = std::string_view::npos;
+    char lastNonSpace = '\0';
+
+    // 增强选择器 {{[^}]+}}：在此位置之前的 {{ 已确定无法匹配
+    size_t braceResume = 0;
+
+    SelectorState selector = SelectorState::IDLE;
+
+    for (size_t i = 0; i < length; ++i) {
+        char c = content[i];
+
+        // CHTL / JS 关键字（\b...\b）
+        if ((!features.hasCHTLKeyword || !features.hasJSKeyword) && isWordBoundary(content, i, 0)) {
+            if (!features.hasCHTLKeyword && matchCHTLKeywordAt(content, i, 0)) {
+                features.hasCHTLKeyword = true;
+            }
+            if (!features.hasJSKeyword && matchJSKeywordAt(content, i, 0)) {
+                features.hasJSKeyword = true;
+            }
+        }
+
+        if (!features.hasCHTLJSSyntax) {
+            if (c == '-' && i + 1 < length && content[i + 1] == '>') {
+                // -> 与 &->（后者包含前者）
+                features.hasCHTLJSSyntax = true;
+            } else if (c == '{' && i >= braceResume && i + 1 < length && content[i + 1] == '{') {
+                // 第一个 } 决定了从此处及之后到该 } 之间所有 {{ 的结果
+                const void* found = std::memchr(content.data() + i + 2, '}', length - i - 2);
+                if (!found) {
+                    braceResume = length;
+                } else {
+                    size_t close = static_cast<const char*>(found) - content.data();
+                    if (close > i + 2 && close + 1 < length && content[close + 1] == '}') {
+                        features.hasCHTLJSSyntax = true;
+                    } else {
+                        braceResume = close + 1;
+                    }
+                }
+            } else if (matchCHTLJSKeywordAt(content, i)) {
+                features.hasCHTLJSSyntax = true;
+            }
+        }
+
+        if (!features.hasCSSSyntax) {
+            // 属性声明
+            if (c == ':') {
+                if (qualifiedColon == std::string_view::npos && isWordOrDash(lastNonSpace)) {
+                    qualifiedColon = i;
+                }
+            } else if (c == ';') {
+                if (qualifiedColon != std::string_view::npos && i >= qualifiedColon + 2) {
+                    features.hasCSSSyntax = true;
+                }
+                qualifiedColon = std::string_view::npos;
+            }
+
+            // 类/ID选择器
+            switch (selector) {
+                case SelectorState::PREFIX:
+                    selector = isWordOrDash(c) ? SelectorState::NAME : SelectorState::IDLE;
+                    break;
+                case SelectorState::NAME:
+                    if (c == '{') {
+                        features.hasCSSSyntax = true;
+                    } else if (isSpaceChar(c)) {
+                        selector = SelectorState::SPACE;
+                    } else if (!isWordOrDash(c)) {
+                        selector = SelectorState::IDLE;
+                    }
+                    break;
+                case SelectorState::SPACE:
+                    if (c == '{') {
+                        features.hasCSSSyntax = true;
+                    } else if (!isSpaceChar(c)) {
+                        selector = SelectorState::IDLE;
+                    }
+                    break;
+                case SelectorState::IDLE:
+                    break;
+            }
+            if (selector == SelectorState::IDLE && (c == '.' || c == '#')) {
+                selector = SelectorState::PREFIX;
+            }
+
+            // @media / @keyframes
+            if (c == '@' && (startsWith(content, i, "@media") || startsWith(content, i, "@keyframes"))) {
+                features.hasCSSSyntax = true;
+            }
+        }
+
+        if (!isSpaceChar(c)) {
+            lastNonSpace = c;
+        }
+
+        if (features.hasCHTLKeyword && features.hasCHTLJSSyntax &&
+            features.hasCSSSyntax && features.hasJSKeyword) {
+            break;
+        }
+    }
+
+    return features;
+}
+
+size_t FragmentClassifier::findCHTLKeyword(std::string_view content, size_t from) {
+    for (size_t i = from; i < content.size(); ++i) {
+        if (isWordBoundary(content, i, from) && matchCHTLKeywordAt(content, i, from)) {
+            return i - from;
+        }
+    }
+    return std::string_view::npos;
+}
+
+bool FragmentClassifier::isCHTLKeyword(std::string_view unit) {
+    return !unit.empty() && isWordBoundary(unit, 0, 0) &&
+           matchCHTLKeywordAt(unit, 0, 0) == unit.size();
+}
+
+bool FragmentClassifier::isEnhancedSelector(std::string_view unit) {
+    // ^\{\{[^}]+\}\}$
+    if (unit.size() < 5 || !startsWith(unit, 0, "{{") || !startsWith(unit, unit.size() - 2, "}}")) {
+        return false;
+    }
+    return unit.substr(2, unit.size() - 4).find('}') == std::string_view::npos;
+}
+
+bool FragmentClassifier::isPropertyDeclaration(std::string_view unit) {
+    // ^\s*[\w-]+\s*:\s*[^;]+;\s*$
+    size_t pos = skipSpaces(unit, 0);
+    size_t nameStart = pos;
+    while (pos < unit.size() && isWordOrDash(unit[pos])) {
+        ++pos;
+    }
+    if (pos == nameStart) {
+        return false;
+    }
+
+    pos = skipSpaces(unit, pos);
+    if (pos >= unit.size() || unit[pos] != ':') {
+        return false;
+    }
+
+    size_t semicolon = unit.find(';', pos + 1);
+    if (semicolon == std::string_view::npos || semicolon < pos + 2) {
+        return false;
+    }
+    return skipSpaces(unit, semicolon + 1) == unit.size();
+}
+
+} // namespace CHTL
@@ -0,0 +1,50 @@
+#ifndef CHTL_FRAGMENT_CLASSIFIER_H
+#define CHTL_FRAGMENT_CLASSIFIER_H
+
+#include <string>
+#include <string_view>
+
+namespace CHTL {
+
+// 片段特征
+struct FragmentFeatures {
+    bool hasCHTLKeyword = false;   // CHTL块关键字（text、style、[Template]、@Style等）
+    bool hasCHTLJSSyntax = false;  // {{...}}、->、&->、module{、listen{、vir x 等
+    bool hasCSSSyntax = false;     // 属性声明、.class{、#id{、@media、@keyframes
+    bool hasJSKeyword = false;     // function、const、let、return 等
+};
+
+// 片段分类器 - 手写状态机
+// 一次线性扫描同时识别CHTL关键字、CHTL JS语法、CSS与JS特征，不回溯。
+// 识别结果与统一扫描器原先使用的四个正则表达式完全一致（含\b单词边界语义），
+// 参见 CHTLUnifiedScanner 中保留的正则参考实现。
+class FragmentClassifier {
+public:
+    // 扫描整个内容，得到全部特征
+    static FragmentFeatures classify(std::string_view content);
+
+    // 查找第一个CHTL关键字的位置（相对from）
+    // from视为输入起点：其前一个字符不参与单词边界判断，与对子串做regex_search一致
+    static size_t findCHTLKeyword(std::string_view content, size_t from = 0);
+
+    // 内容整体是否恰好为一个CHTL关键字（等价于regex_match）
+    static bool isCHTLKeyword(std::string_view unit);
+
+    // 内容整体是否为增强选择器 {{...}}
+    static bool isEnhancedSelector(std::string_view unit);
+
+    // 内容整体是否为CSS属性声明 key: value;
+    static bool isPropertyDeclaration(std::string_view unit);
+
+private:
+    // 在pos处（已满足起始边界）匹配的CHTL关键字长度，不匹配返回0
+    static size_t matchCHTLKeywordAt(std::string_view content, size_t pos, size_t start);
+    // 在pos处（已满足起始边界）匹配的JS关键字长度，不匹配返回0
+    static size_t matchJSKeywordAt(std::string_view content, size_t pos, size_t start);
+    // 在pos处是否匹配CHTL JS块关键字/虚对象语法
+    static bool matchCHTLJSKeywordAt(std::string_view content, size_t pos);
+};
+
+} // namespace CHTL
+
+#endif // CHTL_FRAGMENT_CLASSIFIER_H
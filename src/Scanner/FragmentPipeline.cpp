@@ -0,0 +1,118 @@
+#include "FragmentPipeline.h"
+#include "FragmentCollector.h"
+#include "../Util/ThreadPool/BoundedQueue.h"
+#include <atomic>
+#include <exception>
+#include <future>
+#include <memory>
+
+namespace CHTL {
+
+namespace {
+
+size_t laneIndex(FragmentType type) {
+    switch (type) {
+        case FragmentType::CHTL: return 0;
+        case FragmentType::CHTLJS: return 1;
+        case FragmentType::CSS: return 2;
+        case FragmentType::JS: return 3;
+        default: return static_cast<size_t>(-1);
+    }
+}
+
+constexpr FragmentType LANE_TYPES[] = {
+    FragmentType::CHTL, FragmentType::CHTLJS, FragmentType::CSS, FragmentType::JS
+};
+
+} // namespace
+
+FragmentPipeline::FragmentPipeline(WorkStealingThreadPool& pool, size_t queueCapacity)
+    : pool_(pool), queueCapacity_(queueCapacity) {}
+
+void FragmentPipeline::setStage(FragmentType type, Stage stage) {
+    size_t index = laneIndex(type);
+    if (index < LANE_COUNT) {
+        stages_[index] = std::move(stage);
+    }
+}
+
+size_t FragmentPipeline::run(CHTLUnifiedScanner& scanner, const std::string& source) {
+    size_t activeLanes = 0;
+    for (const auto& stage : stages_) {
+        activeLanes += stage ? 1 : 0;
+    }
+
+    // 收集任务在扫描期间一直占用工作线程。线程数不够让所有收集任务同时运行
+    // （或在工作线程中调用，自身占用了一个线程）时，排队的任务要等扫描结束才能
+    // 开始，有界队列会让扫描永远阻塞，此时退化为不限容量。
+    bool bounded = WorkStealingThreadPool::currentWorkerIndex() == WorkStealingThreadPool::NOT_A_WORKER &&
+                   pool_.getWorkerCount() >= activeLanes;
+    size_t capacity = bounded ? queueCapacity_ : 0;
+
+    std::array<std::unique_ptr<BoundedQueue<CodeFragment>>, LANE_COUNT> queues;
+    std::array<std::future<void>, LANE_COUNT> lanes;
+    std::atomic<bool> abandoned{false};
+
+    for (size_t i = 0; i < LANE_COUNT; ++i) {
+        if (!stages_[i]) {
+            continue;
+        }
+        queues[i] = std::make_unique<BoundedQueue<CodeFragment>>(capacity);
+        lanes[i] = pool_.submit([this, i, &queues, &abandoned]() {
+            FragmentCollector::FragmentStream stream(LANE_TYPES[i]);
+            while (auto fragment = queues[i]->pop()) {
+                stream.addFragment(*fragment);
+            }
+            if (stream.hasContent() && !abandoned.load()) {
+                stages_[i](stream.getCompleteContent());
+            }
+        });
+    }
+
+    size_t fragmentCount = 0;
+    std::exception_ptr scanError;
+    try {
+        scanner.scan(source, [&](CodeFragment&& fragment) {
+            ++fragmentCount;
+            size_t index = laneIndex(fragment.type);
+            if (index < LANE_COUNT && queues[index]) {
+                queues[index]->push(std::move(fragment));
+            }
+        });
+    } catch (...) {
+        // 扫描失败时不再编译不完整的代码
+        scanError = std::current_exception();
+        abandoned.store(true);
+    }
+
+    // 关闭队列即各类型的流已完整，收集任务随即进入编译阶段
+    for (auto& queue : queues) {
+        if (queue) {
+            queue->close();
+        }
+    }
+
+    std::exception_ptr stageError;
+    for (auto& lane : lanes) {
+        if (!lane.valid()) {
+            continue;
+        }
+        try {
+            lane.get();
+        } catch (...) {
+            if (!stageError) {
+                stageError = std::current_exception();
+            }
+        }
+    }
+
+    if (scanError) {
+        std::rethrow_exception(scanError);
+    }
+    if (stageError) {
+        std::rethrow_exception(stageError);
+    }
+    return fragmentCount;
+}
+
+} // namespace CHTL
@@ -0,0 +1,45 @@
+#ifndef FRAGMENT_PIPELINE_H
+#define FRAGMENT_PIPELINE_H
+
+#include "CHTLUnifiedScanner.h"
+#include "../Util/ThreadPool/ThreadPool.h"
+#include <array>
+#include <functional>
+#include <string>
+
+namespace CHTL {
+
+// 扫描→编译流水线
+// 扫描器每切出一个片段就放入该类型的有界队列，各类型的收集任务在线程池上
+// 同时拼接自己的片段流，扫描与收集重叠进行。扫描结束时各流同时完成，
+// 各类型的编译阶段立即并发执行；阶段之间不共享状态，结果由调用方按固定
+// 类型顺序合并，输出与顺序编译一致。
+class FragmentPipeline {
+public:
+    // 编译阶段：参数为该类型的完整代码（与FragmentCollector拼接规则一致）
+    using Stage = std::function<void(const std::string& completeCode)>;
+
+    // queueCapacity为每个类型队列的容量，0表示不限
+    explicit FragmentPipeline(WorkStealingThreadPool& pool, size_t queueCapacity = 64);
+
+    // 设置某类型的编译阶段；没有阶段的类型的片段被丢弃
+    void setStage(FragmentType type, Stage stage);
+
+    // 扫描source并执行各阶段，返回扫描出的片段数
+    // 没有内容的类型不调用阶段。扫描或阶段抛出的异常在所有任务结束后重新抛出，
+    // 扫描异常优先，其次按类型顺序取第一个阶段异常。
+    size_t run(CHTLUnifiedScanner& scanner, const std::string& source);
+
+    size_t getQueueCapacity() const { return queueCapacity_; }
+
+private:
+    static constexpr size_t LANE_COUNT = 4;     // CHTL、CHTLJS、CSS、JS
+
+    WorkStealingThreadPool& pool_;
+    size_t queueCapacity_;
+    std::array<Stage, LANE_COUNT> stages_;
+};
+
+} // namespace CHTL
+
+#endif // FRAGMENT_PIPELINE_H
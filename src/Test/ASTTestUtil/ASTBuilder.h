@@ -0,0 +1,63 @@
+#ifndef AST_BUILDER_H
+#define AST_BUILDER_H
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "../../CHTLJS/CHTLJSNode/BaseNode.h"
+#include "../../CHTLJS/CHTLJSNode/JavaScriptNode.h"
+#include "../../CHTLJS/CHTLJSNode/OperatorNode.h"
+#include "../../CHTLJS/CHTLJSNode/ProgramNode.h"
+#include "../../CHTLJS/CHTLJSNode/SelectorNode.h"
+
+namespace CHTL {
+namespace Test {
+
+// 手工构造CHTL JS AST的工厂函数
+// CHTL JS解析器尚不能产生选择器等节点，生成器测试直接用这些函数搭建输入
+
+// {{text}}，可带索引 {{text[index]}}
+inline std::shared_ptr<CHTLJS::ASTNode> selector(const std::string& text,
+                                                 CHTLJS::EnhancedSelectorNode::SelectorType type,
+                                                 std::optional<size_t> index = std::nullopt) {
+    auto node = std::make_shared<CHTLJS::EnhancedSelectorNode>(text, type, CHTLJS::TokenLocation());
+    if (index) {
+        node->setIndex(*index);
+    }
+    return node;
+}
+
+inline std::shared_ptr<CHTLJS::ASTNode> identifier(const std::string& name) {
+    return std::make_shared<CHTLJS::IdentifierNode>(name, CHTLJS::TokenLocation());
+}
+
+// object.property
+inline std::shared_ptr<CHTLJS::ASTNode> member(std::shared_ptr<CHTLJS::ASTNode> object, const std::string& property) {
+    return std::make_shared<CHTLJS::BinaryExpressionNode>(CHTLJS::BinaryExpressionNode::Operator::DOT, object,
+        identifier(property), CHTLJS::TokenLocation());
+}
+
+// callee(arguments...)
+inline std::shared_ptr<CHTLJS::ASTNode> call(std::shared_ptr<CHTLJS::ASTNode> callee,
+                                             std::vector<std::shared_ptr<CHTLJS::ASTNode>> arguments = {}) {
+    auto node = std::make_shared<CHTLJS::CallExpressionNode>(callee, CHTLJS::TokenLocation());
+    for (auto& argument : arguments) {
+        node->addArgument(argument);
+    }
+    return node;
+}
+
+// 每个表达式一条语句
+inline std::shared_ptr<CHTLJS::ProgramNode> program(std::vector<std::shared_ptr<CHTLJS::ASTNode>> expressions) {
+    auto node = std::make_shared<CHTLJS::ProgramNode>("test.cjjs", CHTLJS::TokenLocation());
+    for (auto& expression : expressions) {
+        node->addStatement(std::make_shared<CHTLJS::StatementNode>(expression, CHTLJS::TokenLocation()));
+    }
+    return node;
+}
+
+} // namespace Test
+} // namespace CHTL
+
+#endif // AST_BUILDER_H
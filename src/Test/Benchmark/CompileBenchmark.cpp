@@ -0,0 +1,498 @@
+// CHTL端到端编译基准测试
+// 用确定性生成的合成语料（或指定的文件）分别测量扫描、词法、语法、生成、CSS、JS
+// 各阶段的耗时、吞吐量和内存分配次数，以JSON输出；指定基线报告时标记超过阈值的回归。
+//
+// 用法: chtl_bench [选项] [input-file...]
+//   --depth N / --fanout N          元素嵌套深度 / 每层子元素数
+//   --templates N / --customs N     @Style模板 / @Element自定义的定义数量
+//   --template-density X            使用模板的元素比例（0-1），另有
+//   --custom-density X / --style-density X / --script-density X
+//   --imports N / --namespaces N    导入的模块数 / 每个模块的命名空间数
+//   --seed N                        随机种子
+//   --iterations N                  每个阶段的重复次数（默认5）
+//   --emit-corpus DIR               把生成的语料写入目录后退出
+//   --output FILE                   JSON报告写入文件（默认标准输出）
+//   --baseline FILE                 与之前的JSON报告比较，有回归时返回2
+//   --threshold PCT                 回归阈值，百分比（默认10）
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "CorpusGenerator.h"
+#include "../CompilationMonitor/CompilationMonitor.h"
+#include "../../Scanner/CHTLUnifiedScanner.h"
+#include "../../CHTL/CHTLLexer/Lexer.h"
+#include "../../CHTL/CHTLLexer/GlobalMap.h"
+#include "../../CHTL/CHTLParser/Parser.h"
+#include "../../CHTL/CHTLGenerator/Generator.h"
+#include "../../CHTL/CHTLContext/Context.h"
+#include "../../CHTL/CHTLIOStream/CHTLFileSystem.h"
+#include "../../CSS/CSSMinifier.h"
+#include "../../Error/ErrorReport.h"
+
+// 分配计数：替换全局operator new，只统计次数和字节数
+namespace {
+
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocatedBytes{0};
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+// GCC把operator new内联后会误报free()与new不匹配
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+
+void operator delete[](void* pointer) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+namespace {
+
+using namespace CHTL;
+
+struct BenchOptions {
+    Test::CorpusConfig corpus;
+    std::vector<std::string> inputFiles;
+    size_t iterations = 5;
+    std::string emitCorpus;
+    std::string output;
+    std::string baseline;
+    double threshold = 10.0;
+};
+
+struct PhaseResult {
+    std::string name;
+    bool available = true;
+    std::string note;
+    size_t inputBytes = 0;
+    size_t items = 0;               // 阶段产物数量（片段、Token、输出字节等）
+    std::string itemLabel;
+    size_t allocations = 0;         // 每次迭代
+    size_t allocatedBytes = 0;      // 每次迭代
+    double meanMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+};
+
+// 每次迭代对应一次完整编译，单例状态互不影响
+struct CompileScope {
+    ScopedInstance<GlobalMap> globalMap;
+    ScopedInstance<ErrorReport> errorReport;
+};
+
+// 运行一个阶段：先预热一次，再计时iterations次；分配次数取第一次计时迭代
+template<typename Func>
+void runPhase(PhaseResult& result, Test::PerformanceProfiler& profiler, size_t iterations, Func&& func) {
+    {
+        CompileScope scope;
+        func();
+    }
+
+    for (size_t i = 0; i < iterations; ++i) {
+        CompileScope scope;
+        size_t countBefore;
+        size_t bytesBefore;
+        size_t items;
+        {
+            Test::ScopedTimer timer(profiler, result.name);
+            countBefore = allocationCount.load(std::memory_order_relaxed);
+            bytesBefore = allocatedBytes.load(std::memory_order_relaxed);
+            items = func();
+            if (i == 0) {
+                result.allocations = allocationCount.load(std::memory_order_relaxed) - countBefore;
+                result.allocatedBytes = allocatedBytes.load(std::memory_order_relaxed) - bytesBefore;
+            }
+        }
+        result.items = items;
+    }
+
+    for (const auto& data : profiler.getProfileData()) {
+        if (data.name == result.name && data.callCount > 0) {
+            result.meanMs = data.totalTime.count() / 1000.0 / data.callCount;
+            result.minMs = data.minTime.count() / 1000.0;
+            result.maxMs = data.maxTime.count() / 1000.0;
+        }
+    }
+}
+
+size_t peakRssBytes() {
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return static_cast<size_t>(usage.ru_maxrss);
+#else
+    return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+// 取出生成结果中所有<style>块的内容
+void extractStylesheets(const std::string& html, std::vector<std::string>& out) {
+    size_t pos = 0;
+    while ((pos = html.find("<style>", pos)) != std::string::npos) {
+        pos += 7;
+        size_t end = html.find("</style>", pos);
+        if (end == std::string::npos) {
+            break;
+        }
+        out.push_back(html.substr(pos, end - pos));
+        pos = end + 8;
+    }
+}
+
+std::string jsonEscape(const std::string& text) {
+    std::string result;
+    for (char c : text) {
+        switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            default: result += c; break;
+        }
+    }
+    return result;
+}
+
+std::string writeReport(const BenchOptions& options, const Test::Corpus& corpus,
+                        const std::vector<PhaseResult>& phases, size_t parseErrors) {
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\n";
+    json << "  \"corpus\": {\n";
+    json << "    \"files\": " << corpus.files.size() << ",\n";
+    json << "    \"bytes\": " << corpus.totalBytes() << ",\n";
+    json << "    \"lines\": " << corpus.totalLines() << ",\n";
+    json << "    \"elements\": " << corpus.elementCount << ",\n";
+    json << "    \"seed\": " << options.corpus.seed << "\n";
+    json << "  },\n";
+    json << "  \"iterations\": " << options.iterations << ",\n";
+    json << "  \"parseErrors\": " << parseErrors << ",\n";
+    json << "  \"peakRssBytes\": " << peakRssBytes() << ",\n";
+    json << "  \"phases\": {\n";
+    for (size_t i = 0; i < phases.size(); ++i) {
+        const auto& phase = phases[i];
+        json << "    \"" << phase.name << "\": {\n";
+        json << "      \"available\": " << (phase.available ? "true" : "false");
+        if (phase.available) {
+            double mbps = phase.meanMs > 0
+                ? phase.inputBytes / (1024.0 * 1024.0) / (phase.meanMs / 1000.0) : 0.0;
+            json << ",\n";
+            json << "      \"meanMs\": " << phase.meanMs << ",\n";
+            json << "      \"minMs\": " << phase.minMs << ",\n";
+            json << "      \"maxMs\": " << phase.maxMs << ",\n";
+            json << "      \"inputBytes\": " << phase.inputBytes << ",\n";
+            json << "      \"throughputMBps\": " << mbps << ",\n";
+            json << "      \"" << phase.itemLabel << "\": " << phase.items << ",\n";
+            json << "      \"allocations\": " << phase.allocations << ",\n";
+            json << "      \"allocatedBytes\": " << phase.allocatedBytes << "\n";
+        } else {
+            json << ",\n      \"note\": \"" << jsonEscape(phase.note) << "\"\n";
+        }
+        json << "    }" << (i + 1 < phases.size() ? "," : "") << "\n";
+    }
+    json << "  }\n";
+    json << "}\n";
+    return json.str();
+}
+
+// 基线报告由chtl_bench自身生成，按固定格式读取 phases.<name>.<key> 的数值
+bool readBaselineValue(const std::string& report, const std::string& phase,
+                       const std::string& key, double& value) {
+    size_t phases = report.find("\"phases\"");
+    if (phases == std::string::npos) return false;
+    size_t begin = report.find("\"" + phase + "\"", phases);
+    if (begin == std::string::npos) return false;
+    size_t end = report.find('}', begin);
+    size_t field = report.find("\"" + key + "\":", begin);
+    if (field == std::string::npos || field > end) return false;
+    value = std::strtod(report.c_str() + field + key.size() + 3, nullptr);
+    return true;
+}
+
+// 返回是否存在回归
+bool compareWithBaseline(const std::string& baselinePath, double threshold,
+                         const std::vector<PhaseResult>& phases) {
+    auto baseline = File::readToString(baselinePath);
+    if (!baseline) {
+        std::cerr << "Error: Cannot read baseline: " << baselinePath << std::endl;
+        return true;
+    }
+
+    bool regressed = false;
+    std::cerr << std::left << std::setw(10) << "Phase"
+              << std::right << std::setw(14) << "Base ms" << std::setw(14) << "Current ms"
+              << std::setw(10) << "Delta" << std::setw(16) << "Base allocs"
+              << std::setw(16) << "Current allocs" << "\n";
+
+    for (const auto& phase : phases) {
+        double baseMs = 0.0;
+        double baseAllocations = 0.0;
+        if (!phase.available || !readBaselineValue(*baseline, phase.name, "meanMs", baseMs)) {
+            continue;
+        }
+        readBaselineValue(*baseline, phase.name, "allocations", baseAllocations);
+
+        double delta = baseMs > 0 ? (phase.meanMs - baseMs) / baseMs * 100.0 : 0.0;
+        bool slower = delta > threshold;
+        bool moreAllocations = baseAllocations > 0 &&
+            phase.allocations > baseAllocations * (1.0 + threshold / 100.0);
+
+        std::cerr << std::left << std::setw(10) << phase.name << std::right
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(14) << baseMs << std::setw(14) << phase.meanMs
+                  << std::setprecision(1) << std::setw(9) << delta << "%"
+                  << std::setw(16) << static_cast<size_t>(baseAllocations)
+                  << std::setw(16) << phase.allocations;
+        if (slower || moreAllocations) {
+            std::cerr << "  REGRESSION";
+            regressed = true;
+        }
+        std::cerr << "\n";
+    }
+    return regressed;
+}
+
+bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+    auto& corpus = options.corpus;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.rfind("--", 0) != 0) {
+            options.inputFiles.push_back(arg);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Error: Missing value for " << arg << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        if (arg == "--depth") corpus.depth = std::stoul(value);
+        else if (arg == "--fanout") corpus.fanOut = std::stoul(value);
+        else if (arg == "--templates") corpus.templates = std::stoul(value);
+        else if (arg == "--customs") corpus.customs = std::stoul(value);
+        else if (arg == "--template-density") corpus.templateDensity = std::stod(value);
+        else if (arg == "--custom-density") corpus.customDensity = std::stod(value);
+        else if (arg == "--style-density") corpus.styleDensity = std::stod(value);
+        else if (arg == "--script-density") corpus.scriptDensity = std::stod(value);
+        else if (arg == "--imports") corpus.imports = std::stoul(value);
+        else if (arg == "--namespaces") corpus.namespaces = std::stoul(value);
+        else if (arg == "--seed") corpus.seed = static_cast<unsigned>(std::stoul(value));
+        else if (arg == "--iterations") options.iterations = std::max<size_t>(1, std::stoul(value));
+        else if (arg == "--emit-corpus") options.emitCorpus = value;
+        else if (arg == "--output") options.output = value;
+        else if (arg == "--baseline") options.baseline = value;
+        else if (arg == "--threshold") options.threshold = std::stod(value);
+        else {
+            std::cerr << "Error: Unknown option: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    try {
+        if (!parseOptions(argc, argv, options)) {
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: Invalid option value: " << e.what() << std::endl;
+        return 1;
+    }
+
+    Test::Corpus corpus;
+    if (options.inputFiles.empty()) {
+        corpus = Test::generateCorpus(options.corpus);
+    } else {
+        for (const auto& path : options.inputFiles) {
+            auto content = File::readToString(path);
+            if (!content) {
+                std::cerr << "Error: Cannot read file: " << path << std::endl;
+                return 1;
+            }
+            corpus.files.push_back({path, *content});
+        }
+    }
+
+    if (!options.emitCorpus.empty()) {
+        if (!corpus.writeTo(options.emitCorpus)) {
+            std::cerr << "Error: Cannot write corpus to: " << options.emitCorpus << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    const size_t corpusBytes = corpus.totalBytes();
+
+    Test::PerformanceProfiler profiler;
+    std::vector<PhaseResult> phases(6);
+    phases[0].name = "scan";
+    phases[1].name = "lex";
+    phases[2].name = "parse";
+    phases[3].name = "generate";
+    phases[4].name = "css";
+    phases[5].name = "js";
+
+    // 扫描：切分CHTL/CHTL JS/CSS/JS片段
+    phases[0].inputBytes = corpusBytes;
+    phases[0].itemLabel = "fragments";
+    runPhase(phases[0], profiler, options.iterations, [&]() {
+        CHTLUnifiedScanner scanner;
+        size_t fragments = 0;
+        for (const auto& file : corpus.files) {
+            fragments += scanner.scan(file.content).size();
+        }
+        return fragments;
+    });
+
+    // 词法：零拷贝模式
+    phases[1].inputBytes = corpusBytes;
+    phases[1].itemLabel = "tokens";
+    runPhase(phases[1], profiler, options.iterations, [&]() {
+        TokenArena arena;
+        size_t tokens = 0;
+        for (const auto& file : corpus.files) {
+            arena.clear();
+            auto context = std::make_shared<CompileContext>(file.path);
+            Lexer lexer(std::string_view(file.content), arena, context);
+            tokens += lexer.tokenizeAllViews().size();
+        }
+        return tokens;
+    });
+
+    // 语法：包括词法分析，与chtlc的实际流程一致
+    size_t parseErrors = 0;
+    phases[2].inputBytes = corpusBytes;
+    phases[2].itemLabel = "files";
+    runPhase(phases[2], profiler, options.iterations, [&]() {
+        parseErrors = 0;
+        for (const auto& file : corpus.files) {
+            TokenArena arena;
+            auto context = std::make_shared<CompileContext>(file.path);
+            auto lexer = std::make_shared<Lexer>(std::string_view(file.content), arena, context);
+            Parser parser(lexer, context);
+            parser.parse();
+            parseErrors += parser.getErrors().size();
+        }
+        return corpus.files.size();
+    });
+
+    // 生成：AST在计时外准备好，每次迭代重新生成HTML
+    // 生成结果中<style>块的内容留给CSS阶段
+    std::vector<std::string> stylesheets;
+    phases[3].inputBytes = corpusBytes;
+    phases[3].itemLabel = "outputBytes";
+    {
+        std::vector<std::pair<std::shared_ptr<CompileContext>, std::shared_ptr<ProgramNode>>> programs;
+        std::vector<std::unique_ptr<TokenArena>> arenas;
+        CompileScope scope;
+        for (const auto& file : corpus.files) {
+            arenas.push_back(std::make_unique<TokenArena>());
+            auto context = std::make_shared<CompileContext>(file.path);
+            auto lexer = std::make_shared<Lexer>(std::string_view(file.content), *arenas.back(), context);
+            Parser parser(lexer, context);
+            programs.emplace_back(context, parser.parse());
+        }
+
+        runPhase(phases[3], profiler, options.iterations, [&]() {
+            size_t outputBytes = 0;
+            for (const auto& [context, program] : programs) {
+                if (program) {
+                    Generator generator(context);
+                    outputBytes += generator.generate(program).size();
+                }
+            }
+            return outputBytes;
+        });
+
+        for (const auto& [context, program] : programs) {
+            if (program) {
+                Generator generator(context);
+                extractStylesheets(generator.generate(program), stylesheets);
+            }
+        }
+    }
+
+    // CSS：原生记号化与压缩（chtlc --minify走的路径）
+    phases[4].itemLabel = "outputBytes";
+    for (const auto& css : stylesheets) {
+        phases[4].inputBytes += css.size();
+    }
+    runPhase(phases[4], profiler, options.iterations, [&]() {
+        CSSMinifier minifier;
+        std::string output;
+        size_t outputBytes = 0;
+        for (const auto& css : stylesheets) {
+            output.clear();
+            minifier.minify(css, output);
+            outputBytes += output.size();
+        }
+        return outputBytes;
+    });
+
+    // JS：ANTLR版JavaScript编译器和CHTL JS节点实现目前不在构建中，
+    // 报告中保留这一阶段，接入后直接在这里计时
+    phases[5].available = false;
+    phases[5].note = "no JavaScript/CHTL JS compiler in this build";
+
+    std::string report = writeReport(options, corpus, phases, parseErrors);
+    if (options.output.empty()) {
+        std::cout << report;
+    } else {
+        std::ofstream out(options.output, std::ios::binary | std::ios::trunc);
+        out << report;
+        if (!out) {
+            std::cerr << "Error: Cannot write report: " << options.output << std::endl;
+            return 1;
+        }
+    }
+
+    // 语料应当完全合法，否则语法阶段的计时中混入了错误恢复
+    if (parseErrors > 0) {
+        std::cerr << "Error: Corpus produced " << parseErrors << " parse errors" << std::endl;
+        return 1;
+    }
+
+    if (!options.baseline.empty() &&
+        compareWithBaseline(options.baseline, options.threshold, phases)) {
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include "CorpusGenerator.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace CHTL {
+namespace Test {
+
+namespace {
+
+// 不使用std::uniform_*_distribution：其结果随标准库实现而不同
+class CorpusRandom {
+public:
+    explicit CorpusRandom(unsigned seed) : engine_(seed) {}
+
+    size_t below(size_t bound) { return bound == 0 ? 0 : engine_() % bound; }
+    bool chance(double probability) { return engine_() % 10000 < probability * 10000; }
+
+    std::string color() {
+        static const char digits[] = "0123456789abcdef";
+        std::string result = "#";
+        for (int i = 0; i < 6; ++i) {
+            result += digits[engine_() % 16];
+        }
+        return result;
+    }
+
+private:
+    std::mt19937 engine_;
+};
+
+const char* const ELEMENT_TAGS[] = {"div", "section", "article", "ul", "li", "p", "span", "nav"};
+const char* const STYLE_PROPERTIES[] = {"width", "height", "margin", "padding", "border-width", "font-size"};
+
+class PageWriter {
+public:
+    PageWriter(const CorpusConfig& config, CorpusRandom& random)
+        : config_(config), random_(random) {}
+
+    std::string writeMainPage(size_t& elementCount) {
+        out_ << "// Synthetic CHTL page (seed " << config_.seed << ")\n";
+        for (size_t i = 0; i < config_.imports; ++i) {
+            out_ << "[Import] @Chtl from \"modules/module" << i << ".chtl\"\n";
+        }
+        out_ << "\n";
+
+        for (size_t i = 0; i < config_.templates; ++i) {
+            out_ << "[Template] @Style Card" << i << " {\n";
+            out_ << "    color: " << random_.color() << ";\n";
+            out_ << "    background: " << random_.color() << ";\n";
+            out_ << "    padding: " << random_.below(24) << "px;\n";
+            out_ << "}\n\n";
+        }
+
+        for (size_t i = 0; i < config_.customs; ++i) {
+            out_ << "[Custom] @Element Widget" << i << " {\n";
+            out_ << "    div {\n";
+            out_ << "        class: widget" << i << ";\n";
+            out_ << "        span { text { \"Widget " << i << "\" } }\n";
+            out_ << "    }\n";
+            out_ << "}\n\n";
+        }
+
+        out_ << "html {\n";
+        out_ << "    head {\n";
+        out_ << "        title { text { \"Synthetic page\" } }\n";
+        out_ << "    }\n";
+        out_ << "    body {\n";
+        for (size_t i = 0; i < config_.fanOut; ++i) {
+            writeElement(1, 2);
+        }
+        out_ << "    }\n";
+        out_ << "}\n";
+
+        elementCount = elementCount_;
+        return out_.str();
+    }
+
+private:
+    void indent(size_t level) {
+        out_ << std::string(level * 4, ' ');
+    }
+
+    void writeElement(size_t depth, size_t level) {
+        size_t id = elementCount_++;
+        const char* tag = ELEMENT_TAGS[random_.below(std::size(ELEMENT_TAGS))];
+
+        indent(level);
+        out_ << tag << " {\n";
+        indent(level + 1);
+        out_ << "id: e" << id << ";\n";
+        indent(level + 1);
+        out_ << "class: \"item c" << id % 13 << "\";\n";
+
+        bool useTemplate = config_.templates > 0 && random_.chance(config_.templateDensity);
+        if (useTemplate || random_.chance(config_.styleDensity)) {
+            indent(level + 1);
+            out_ << "style {\n";
+            if (useTemplate) {
+                indent(level + 2);
+                out_ << "@Style Card" << random_.below(config_.templates) << ";\n";
+            }
+            indent(level + 2);
+            out_ << STYLE_PROPERTIES[random_.below(std::size(STYLE_PROPERTIES))]
+                 << ": " << random_.below(400) << "px;\n";
+            if (random_.chance(0.5)) {
+                indent(level + 2);
+                out_ << ".c" << id % 13 << " {\n";
+                indent(level + 3);
+                out_ << "color: " << random_.color() << ";\n";
+                indent(level + 2);
+                out_ << "}\n";
+            }
+            if (random_.chance(0.3)) {
+                indent(level + 2);
+                out_ << "&:hover {\n";
+                indent(level + 3);
+                out_ << "opacity: 0." << random_.below(10) << ";\n";
+                indent(level + 2);
+                out_ << "}\n";
+            }
+            indent(level + 1);
+            out_ << "}\n";
+        }
+
+        if (random_.chance(config_.scriptDensity)) {
+            indent(level + 1);
+            out_ << "script {\n";
+            indent(level + 2);
+            out_ << "{{#e" << id << "}}->listen {\n";
+            indent(level + 3);
+            out_ << "click: () => { console.log(\"e" << id << "\"); }\n";
+            indent(level + 2);
+            out_ << "};\n";
+            indent(level + 1);
+            out_ << "}\n";
+        }
+
+        if (config_.customs > 0 && random_.chance(config_.customDensity)) {
+            indent(level + 1);
+            out_ << "@Element Widget" << random_.below(config_.customs) << ";\n";
+        }
+
+        indent(level + 1);
+        out_ << "text { \"Item " << id << "\" }\n";
+
+        if (depth < config_.depth) {
+            for (size_t i = 0; i < config_.fanOut; ++i) {
+                writeElement(depth + 1, level + 1);
+            }
+        }
+
+        indent(level);
+        out_ << "}\n";
+    }
+
+    const CorpusConfig& config_;
+    CorpusRandom& random_;
+    std::ostringstream out_;
+    size_t elementCount_ = 0;
+};
+
+std::string writeModule(size_t index, const CorpusConfig& config, CorpusRandom& random) {
+    std::ostringstream out;
+    out << "// Synthetic CHTL module " << index << "\n";
+    for (size_t n = 0; n < config.namespaces; ++n) {
+        out << "[Namespace] module" << index << "_space" << n << " {\n";
+        out << "    [Template] @Style Shared" << n << " {\n";
+        out << "        color: " << random.color() << ";\n";
+        out << "        margin: " << random.below(16) << "px;\n";
+        out << "    }\n\n";
+        out << "    [Custom] @Element Part" << n << " {\n";
+        out << "        div {\n";
+        out << "            style {\n";
+        out << "                @Style Shared" << n << ";\n";
+        out << "            }\n";
+        out << "            text { \"Part " << index << "." << n << "\" }\n";
+        out << "        }\n";
+        out << "    }\n";
+        out << "}\n\n";
+    }
+    return out.str();
+}
+
+} // namespace
+
+size_t Corpus::totalBytes() const {
+    size_t total = 0;
+    for (const auto& file : files) {
+        total += file.content.size();
+    }
+    return total;
+}
+
+size_t Corpus::totalLines() const {
+    size_t total = 0;
+    for (const auto& file : files) {
+        total += static_cast<size_t>(std::count(file.content.begin(), file.content.end(), '\n'));
+    }
+    return total;
+}
+
+bool Corpus::writeTo(const std::string& directory) const {
+    std::error_code ec;
+    for (const auto& file : files) {
+        fs::path path = fs::path(directory) / file.path;
+        fs::create_directories(path.parent_path(), ec);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << file.content;
+        if (!out) {
+            return false;
+        }
+    }
+    return true;
+}
+
+Corpus generateCorpus(const CorpusConfig& config) {
+    CorpusRandom random(config.seed);
+    Corpus corpus;
+
+    PageWriter writer(config, random);
+    corpus.files.push_back({"main.chtl", writer.writeMainPage(corpus.elementCount)});
+
+    for (size_t i = 0; i < config.imports; ++i) {
+        corpus.files.push_back({"modules/module" + std::to_string(i) + ".chtl",
+                                writeModule(i, config, random)});
+    }
+
+    return corpus;
+}
+
+} // namespace Test
+} // namespace CHTL
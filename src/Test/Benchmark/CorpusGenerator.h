@@ -0,0 +1,50 @@
+#ifndef CHTL_CORPUS_GENERATOR_H
+#define CHTL_CORPUS_GENERATOR_H
+
+#include <string>
+#include <vector>
+
+namespace CHTL {
+namespace Test {
+
+// 合成语料配置
+// 相同的配置（含seed）总是生成逐字节相同的语料，便于不同版本之间对比
+struct CorpusConfig {
+    unsigned seed = 42;
+    size_t depth = 4;               // 元素嵌套深度
+    size_t fanOut = 6;              // 每个元素的子元素数
+    size_t templates = 12;          // [Template] @Style 定义数量
+    size_t customs = 6;             // [Custom] @Element 定义数量
+    double templateDensity = 0.4;   // 使用@Style模板的元素比例
+    double customDensity = 0.1;     // 使用@Element自定义元素的比例
+    double styleDensity = 0.5;      // 带局部style块的元素比例
+    double scriptDensity = 0.15;    // 带局部script块的元素比例
+    size_t imports = 3;             // 被导入的模块文件数
+    size_t namespaces = 2;          // 每个模块文件中的命名空间数
+};
+
+// 语料中的一个文件
+struct CorpusFile {
+    std::string path;       // 相对于语料根目录的路径
+    std::string content;
+};
+
+// 生成的语料：files[0]为主页面，其余为被导入的模块
+struct Corpus {
+    std::vector<CorpusFile> files;
+    size_t elementCount = 0;
+
+    size_t totalBytes() const;
+    size_t totalLines() const;
+
+    // 写入目录（供chtlc等外部工具使用）
+    bool writeTo(const std::string& directory) const;
+};
+
+// 按配置生成语料
+Corpus generateCorpus(const CorpusConfig& config);
+
+} // namespace Test
+} // namespace CHTL
+
+#endif // CHTL_CORPUS_GENERATOR_H
@@ -0,0 +1,147 @@
+// 增量解析基准测试
+// 在约2万行的合成页面上模拟编辑器的逐次编辑，测量IncrementalParser::applyEdit
+// 每次编辑的延迟，并与完整解析对比。编辑分布在文件的开头、中部和末尾，
+// 每次编辑之后立即撤销，使每一轮都从相同的源码开始。
+//
+// 用法: chtl_incremental_bench [lines] [iterations]
+// 默认20000行、每个编辑位置重复50次
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "CorpusGenerator.h"
+#include "../../CHTL/CHTLParser/IncrementalParser.h"
+#include "../../CHTL/CHTLLexer/GlobalMap.h"
+#include "../../CHTL/CHTLContext/Context.h"
+#include "../../Error/ErrorReport.h"
+#include "../../Util/ScopedInstance.h"
+
+namespace {
+
+using namespace CHTL;
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// 取主页面行数不少于target的最小扇出（深度固定为4）
+Test::Corpus generatePage(size_t target) {
+    Test::CorpusConfig config;
+    config.depth = 4;
+    config.imports = 0;
+    Test::Corpus corpus;
+    for (config.fanOut = 2; ; ++config.fanOut) {
+        corpus = Test::generateCorpus(config);
+        const std::string& content = corpus.files[0].content;
+        if (static_cast<size_t>(std::count(content.begin(), content.end(), '\n')) >= target) {
+            return corpus;
+        }
+    }
+}
+
+// 一类编辑：在anchor之后插入text（再删除）
+struct EditKind {
+    const char* name;
+    const char* anchor;
+    const char* text;
+};
+
+const EditKind EDIT_KINDS[] = {
+    {"text content", "text { \"Item ", "edited "},
+    {"style property", "px;\n", " margin: 2px;"},
+    {"new child element", "text { \"Item ", "\" } span { text { \"x\" } } text { \""},
+};
+
+struct Result {
+    std::vector<double> latencies;
+    size_t reparsedBytes = 0;
+    size_t incremental = 0;
+};
+
+double percentile(std::vector<double> values, double fraction) {
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(values.size() - 1));
+    return values[index];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t lines = argc > 1 ? std::stoul(argv[1]) : 20000;
+    size_t iterations = argc > 2 ? std::stoul(argv[2]) : 50;
+    if (lines == 0 || iterations == 0) {
+        std::cerr << "Usage: chtl_incremental_bench [lines] [iterations]" << std::endl;
+        return 1;
+    }
+
+    Test::Corpus corpus = generatePage(lines);
+    const std::string source = corpus.files[0].content;
+
+    ScopedInstance<GlobalMap> globalMap;
+    ScopedInstance<ErrorReport> errorReport;
+    auto context = std::make_shared<CompileContext>("main.chtl");
+    IncrementalParser parser(context);
+
+    // 完整解析作为基线
+    parser.parse(source);
+    std::vector<double> fullLatencies;
+    for (size_t i = 0; i < std::min<size_t>(iterations, 10); ++i) {
+        auto start = Clock::now();
+        parser.parse(source);
+        fullLatencies.push_back(elapsedMs(start));
+    }
+    double fullMs = percentile(fullLatencies, 0.5);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Page: " << std::count(source.begin(), source.end(), '\n') << " lines, "
+              << source.size() / 1024 << " KiB, " << parser.getTokens().size() << " tokens\n";
+    std::cout << "Full parse:  " << fullMs << " ms (median)\n";
+
+    const double positions[] = {0.1, 0.5, 0.9};
+    for (const EditKind& kind : EDIT_KINDS) {
+        Result result;
+        for (double position : positions) {
+            size_t offset = source.find(kind.anchor, static_cast<size_t>(position * static_cast<double>(source.size())));
+            if (offset == std::string::npos) {
+                continue;
+            }
+            offset += std::char_traits<char>::length(kind.anchor);
+            size_t length = std::char_traits<char>::length(kind.text);
+            for (size_t i = 0; i < iterations; ++i) {
+                auto start = Clock::now();
+                parser.applyEdit({offset, 0, kind.text});
+                result.latencies.push_back(elapsedMs(start));
+                result.reparsedBytes += parser.getLastStats().reparsedBytes;
+                result.incremental += parser.getLastStats().incremental ? 1 : 0;
+
+                start = Clock::now();
+                parser.applyEdit({offset, length, ""});
+                result.latencies.push_back(elapsedMs(start));
+                result.reparsedBytes += parser.getLastStats().reparsedBytes;
+                result.incremental += parser.getLastStats().incremental ? 1 : 0;
+            }
+        }
+        if (result.latencies.empty()) {
+            continue;
+        }
+        double median = percentile(result.latencies, 0.5);
+        std::cout << kind.name << "\n";
+        std::cout << "  Per edit:    " << median << " ms median, "
+                  << percentile(result.latencies, 0.99) << " ms p99 ("
+                  << std::setprecision(1) << fullMs / median << "x faster than full parse)\n"
+                  << std::setprecision(3);
+        std::cout << "  Incremental: " << result.incremental << "/" << result.latencies.size()
+                  << " edits, " << result.reparsedBytes / result.latencies.size() << " bytes reparsed per edit\n";
+    }
+
+    if (parser.getSource() != source) {
+        std::cerr << "Warning: source differs after undoing all edits\n";
+        return 1;
+    }
+    return 0;
+}
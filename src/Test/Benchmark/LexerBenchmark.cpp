@@ -0,0 +1,93 @@
+// CHTL词法分析器基准测试
+// 比较传统模式（shared_ptr<Token> + 复制词素）与零拷贝模式（arena + string_view）的吞吐量
+//
+// 用法: chtl_lexer_bench [input-file] [iterations]
+// 未指定输入文件时使用内置生成的页面
+
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "../../CHTL/CHTLLexer/Lexer.h"
+#include "../../CHTL/CHTLContext/Context.h"
+#include "../../CHTL/CHTLIOStream/CHTLFileSystem.h"
+
+namespace {
+
+std::string generatePage(size_t elements) {
+    std::stringstream ss;
+    ss << "[Template] @Style Card {\n    color: \"#333\";\n    padding: 8px;\n}\n\n";
+    ss << "html {\n    body {\n";
+    for (size_t i = 0; i < elements; ++i) {
+        ss << "        div {\n";
+        ss << "            id: item" << i << ";\n";
+        ss << "            class: \"card card-" << i % 7 << "\";\n";
+        ss << "            style {\n";
+        ss << "                @Style Card;\n";
+        ss << "                width: " << (i % 100) << "px;\n";
+        ss << "            }\n";
+        ss << "            text { \"Item \\\"" << i << "\\\" of the list\" }\n";
+        ss << "            // comment " << i << "\n";
+        ss << "        }\n";
+    }
+    ss << "    }\n}\n";
+    return ss.str();
+}
+
+template<typename Func>
+double measure(size_t iterations, Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    using namespace CHTL;
+
+    std::string source;
+    if (argc >= 2) {
+        auto content = File::readToString(argv[1]);
+        if (!content) {
+            std::cerr << "Error: Cannot read file: " << argv[1] << std::endl;
+            return 1;
+        }
+        source = *content;
+    } else {
+        source = generatePage(5000);
+    }
+
+    size_t iterations = argc >= 3 ? std::stoul(argv[2]) : 10;
+    auto context = std::make_shared<CompileContext>("bench.chtl");
+
+    size_t sharedTokens = 0;
+    double sharedTime = measure(iterations, [&]() {
+        Lexer lexer(source, context);
+        sharedTokens = lexer.tokenizeAll().size();
+    });
+
+    size_t viewTokens = 0;
+    TokenArena arena;
+    double viewTime = measure(iterations, [&]() {
+        arena.clear();
+        Lexer lexer(std::string_view(source), arena, context);
+        viewTokens = lexer.tokenizeAllViews().size();
+    });
+
+    double sharedRate = static_cast<double>(sharedTokens) * iterations / sharedTime;
+    double viewRate = static_cast<double>(viewTokens) * iterations / viewTime;
+
+    std::cout << "Source size:      " << source.size() << " bytes\n";
+    std::cout << "Iterations:       " << iterations << "\n";
+    std::cout << "shared_ptr Token: " << sharedTokens << " tokens, "
+              << static_cast<size_t>(sharedRate) << " tokens/sec\n";
+    std::cout << "TokenView arena:  " << viewTokens << " tokens, "
+              << static_cast<size_t>(viewRate) << " tokens/sec\n";
+    std::cout << "Speedup:          " << viewRate / sharedRate << "x\n";
+
+    return sharedTokens == viewTokens ? 0 : 1;
+}
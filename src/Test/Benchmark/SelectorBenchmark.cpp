@@ -0,0 +1,127 @@
+// 选择器自动化基准测试
+// 比较按块编译正则的旧实现与手写选择器扫描器，报告每1000个局部块的耗时
+//
+// 用法: chtl_selector_bench [blocks] [rounds]
+// 默认生成1000个局部样式块和1000个局部脚本块，重复20轮取平均
+
+#include <chrono>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../../CHTL/CHTLManage/SelectorAutomation.h"
+
+namespace {
+
+std::vector<std::string> generateStyleBlocks(size_t count) {
+    std::vector<std::string> blocks;
+    for (size_t i = 0; i < count; ++i) {
+        std::stringstream ss;
+        ss << "width: " << (i % 100) << "px;\n";
+        ss << "@Style Card;\n";
+        ss << ".card" << i % 7 << " {\n    color: #333;\n    padding: 8px 16px;\n}\n";
+        ss << "&:hover {\n    opacity: 0.8;\n}\n";
+        ss << "#item" << i << " > li.entry:not(.off) {\n    margin: 0 auto;\n}\n";
+        blocks.push_back(ss.str());
+    }
+    return blocks;
+}
+
+std::vector<std::string> generateScriptBlocks(size_t count) {
+    std::vector<std::string> blocks;
+    for (size_t i = 0; i < count; ++i) {
+        std::stringstream ss;
+        ss << "{{.card" << i % 7 << "}}->listen {\n";
+        ss << "    click: () => { {{#item" << i << "}}.textContent = \"" << i << "\"; }\n";
+        ss << "};\n";
+        ss << "{{button[" << i % 3 << "]}}->addEventListener('click', () => {});\n";
+        ss << "{{&}}->listen { mouseenter: () => {} };\n";
+        blocks.push_back(ss.str());
+    }
+    return blocks;
+}
+
+// 旧实现：每次调用构造正则并在整个块上迭代
+size_t regexStyle(const std::string& css) {
+    std::regex selectorRegex(R"(([.#]?[\w-]+(?:\[[^\]]+\])?(?::[^{]+)?))");
+    size_t count = 0;
+    for (auto it = std::sregex_iterator(css.begin(), css.end(), selectorRegex); it != std::sregex_iterator(); ++it) {
+        std::string selector = (*it)[0];
+        count += !selector.empty();
+    }
+    return count;
+}
+
+size_t regexScript(const std::string& script) {
+    std::regex chtljsRegex(R"(\{\{([.#]?[\w-]+(?:\[\d+\])?)\}\})");
+    size_t count = 0;
+    for (auto it = std::sregex_iterator(script.begin(), script.end(), chtljsRegex); it != std::sregex_iterator(); ++it) {
+        std::string selector = (*it)[1];
+        count += !selector.empty();
+    }
+    return count;
+}
+
+template <typename Fn>
+double measureUsPer1k(const std::vector<std::string>& blocks, size_t rounds, size_t& selectors, Fn&& scan) {
+    selectors = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t round = 0; round < rounds; ++round) {
+        size_t found = 0;
+        for (const auto& block : blocks) {
+            found += scan(block);
+        }
+        selectors = found;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double us = std::chrono::duration<double, std::micro>(end - start).count();
+    return us / static_cast<double>(rounds) / (static_cast<double>(blocks.size()) / 1000.0);
+}
+
+void report(const char* label, double regexUs, size_t regexCount, double scannerUs, size_t scannerCount) {
+    std::cout << label << "\n";
+    std::cout << "  Regex:   " << regexUs << " us / 1k blocks (" << regexCount << " matches)\n";
+    std::cout << "  Scanner: " << scannerUs << " us / 1k blocks (" << scannerCount << " selectors)\n";
+    std::cout << "  Speedup: " << regexUs / scannerUs << "x\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    size_t blocks = argc > 1 ? std::stoul(argv[1]) : 1000;
+    size_t rounds = argc > 2 ? std::stoul(argv[2]) : 20;
+    if (blocks == 0 || rounds == 0) {
+        std::cerr << "Usage: chtl_selector_bench [blocks] [rounds]" << std::endl;
+        return 1;
+    }
+
+    auto styles = generateStyleBlocks(blocks);
+    auto scripts = generateScriptBlocks(blocks);
+
+    std::vector<CHTL::SelectorView> views;
+    auto scanStyle = [&](const std::string& css) {
+        views.clear();
+        CHTL::SelectorScanner::scanStyle(css, views);
+        return views.size();
+    };
+    auto scanScript = [&](const std::string& script) {
+        views.clear();
+        CHTL::SelectorScanner::scanScript(script, views);
+        return views.size();
+    };
+
+    size_t regexCount = 0;
+    size_t scannerCount = 0;
+
+    double regexUs = measureUsPer1k(styles, rounds, regexCount, regexStyle);
+    double scannerUs = measureUsPer1k(styles, rounds, scannerCount, scanStyle);
+    report("Local style blocks", regexUs, regexCount, scannerUs, scannerCount);
+
+    regexUs = measureUsPer1k(scripts, rounds, regexCount, regexScript);
+    scannerUs = measureUsPer1k(scripts, rounds, scannerCount, scanScript);
+    report("Local script blocks", regexUs, regexCount, scannerUs, scannerCount);
+
+    return 0;
+}
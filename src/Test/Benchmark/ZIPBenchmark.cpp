@@ -0,0 +1,157 @@
+// CMOD打包基准测试
+// 比较不压缩（原先的输出方式）与DEFLATE各级别的打包/解包吞吐量和包大小，
+// 以及CRC32逐字节查表与slice-by-8的吞吐量
+//
+// 用法: chtl_zip_bench [module-dir] [iterations]
+// 未指定目录时使用内置生成的模块
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "../../Util/ZIPUtil/ZIPUtil.h"
+#include "../../Util/ZIPUtil/CRC32.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 生成一个包含若干CHTL源文件的模块目录
+void generateModule(const fs::path& dir, size_t files, size_t elementsPerFile) {
+    fs::create_directories(dir / "src");
+    fs::create_directories(dir / "info");
+    std::ofstream(dir / "info" / "module.info") << "[Info] {\n    name = \"Bench\";\n    version = \"1.0.0\";\n}\n";
+
+    for (size_t f = 0; f < files; ++f) {
+        std::ofstream out(dir / "src" / ("Component" + std::to_string(f) + ".chtl"));
+        out << "[Template] @Style Card" << f << " {\n    color: #333;\n    padding: 8px;\n}\n\n";
+        out << "[Custom] @Element Panel" << f << " {\n";
+        for (size_t i = 0; i < elementsPerFile; ++i) {
+            out << "    div {\n";
+            out << "        id: panel" << f << "-" << i << ";\n";
+            out << "        class: \"card card-" << i % 7 << "\";\n";
+            out << "        style {\n";
+            out << "            @Style Card" << f << ";\n";
+            out << "            width: " << (i * 37 % 100) << "px;\n";
+            out << "        }\n";
+            out << "        text { \"Item " << i << " of panel " << f << "\" }\n";
+            out << "    }\n";
+        }
+        out << "}\n";
+    }
+}
+
+size_t directorySize(const fs::path& dir) {
+    size_t total = 0;
+    for (const auto& entry : fs::recursive_directory_iterator(dir)) {
+        if (entry.is_regular_file()) {
+            total += entry.file_size();
+        }
+    }
+    return total;
+}
+
+template<typename Func>
+double measure(size_t iterations, Func&& func) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        func();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+double megabytesPerSecond(size_t bytes, size_t iterations, double seconds) {
+    return static_cast<double>(bytes) * iterations / seconds / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    using namespace CHTL;
+
+    fs::path workDir = fs::temp_directory_path() / "chtl_zip_bench";
+    fs::remove_all(workDir);
+    fs::create_directories(workDir);
+
+    fs::path moduleDir;
+    if (argc >= 2) {
+        moduleDir = argv[1];
+        if (!fs::is_directory(moduleDir)) {
+            std::cerr << "Error: Not a directory: " << argv[1] << std::endl;
+            return 1;
+        }
+    } else {
+        moduleDir = workDir / "module";
+        generateModule(moduleDir, 40, 400);
+    }
+
+    size_t iterations = argc >= 3 ? std::stoul(argv[2]) : 5;
+    size_t rawSize = directorySize(moduleDir);
+
+    std::cout << "Input size:  " << rawSize << " bytes\n";
+    std::cout << "Iterations:  " << iterations << "\n\n";
+    std::cout << std::left << std::setw(12) << "Level"
+              << std::right << std::setw(12) << "Size"
+              << std::setw(10) << "Ratio"
+              << std::setw(14) << "Pack MB/s"
+              << std::setw(14) << "Unpack MB/s" << "\n";
+
+    bool ok = true;
+    const int levels[] = {0, 1, 6, 9};
+    for (int level : levels) {
+        fs::path archive = workDir / ("bench" + std::to_string(level) + ".cmod");
+        fs::path extractDir = workDir / ("extract" + std::to_string(level));
+
+        double packTime = measure(iterations, [&]() {
+            ZIPUtil zip;
+            zip.setCompressionLevel(level);
+            ok = zip.createArchive(archive.string()) && ok;
+            ok = zip.addDirectory(moduleDir.string()) && ok;
+            ok = zip.finalize() && ok;
+        });
+
+        double unpackTime = measure(iterations, [&]() {
+            fs::remove_all(extractDir);
+            ZIPUtil zip;
+            ok = zip.extractArchive(archive.string(), extractDir.string()) && ok;
+        });
+
+        size_t archiveSize = fs::file_size(archive);
+        std::cout << std::left << std::setw(12) << (level == 0 ? "stored" : "deflate-" + std::to_string(level))
+                  << std::right << std::setw(12) << archiveSize
+                  << std::setw(9) << std::fixed << std::setprecision(1)
+                  << 100.0 * archiveSize / rawSize << "%"
+                  << std::setw(14) << megabytesPerSecond(rawSize, iterations, packTime)
+                  << std::setw(14) << megabytesPerSecond(rawSize, iterations, unpackTime) << "\n";
+
+        if (directorySize(extractDir) != rawSize) {
+            std::cerr << "Error: extracted size mismatch at level " << level << std::endl;
+            ok = false;
+        }
+    }
+
+    // CRC32
+    std::string data(16 * 1024 * 1024, '\0');
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>((i * 2654435761u) >> 13);
+    }
+    size_t crcIterations = iterations * 4;
+    uint32_t bytewiseCrc = 0;
+    double bytewiseTime = measure(crcIterations, [&]() {
+        bytewiseCrc = CRC32::updateBytewise(0, data.data(), data.size());
+    });
+    uint32_t slicedCrc = 0;
+    double slicedTime = measure(crcIterations, [&]() {
+        slicedCrc = CRC32::update(0, data.data(), data.size());
+    });
+
+    std::cout << "\nCRC32 bytewise:     " << megabytesPerSecond(data.size(), crcIterations, bytewiseTime) << " MB/s\n";
+    std::cout << "CRC32 slice-by-8:   " << megabytesPerSecond(data.size(), crcIterations, slicedTime) << " MB/s\n";
+
+    fs::remove_all(workDir);
+    return ok && bytewiseCrc == slicedCrc ? 0 : 1;
+}
@@ -322,7 +322,7 @@ bool compileAndCompare(const std::string& chtlCode,
     return true;
 }
 
-bool validateSyntax(const std::string& code, const std::string& type) {
+bool validateSyntax(const std::string& code, const std::string& /*type*/) {
     auto dispatcher = CompilerFactory::createDispatcher();
     
     CompileOptions options;
@@ -0,0 +1,45 @@
+#ifndef COMPILE_SOURCE_H
+#define COMPILE_SOURCE_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../../CHTL/CHTLContext/Context.h"
+#include "../../CHTL/CHTLGenerator/Generator.h"
+#include "../../CHTL/CHTLLexer/Lexer.h"
+#include "../../CHTL/CHTLLexer/TokenArena.h"
+#include "../../CHTL/CHTLParser/Parser.h"
+
+namespace CHTL {
+namespace Test {
+
+// 一段CHTL源码的编译结果
+struct CompiledSource {
+    std::string html;
+    std::vector<std::string> parseErrors;
+    size_t cacheHits = 0;       // 模板展开缓存命中次数
+    size_t cacheMisses = 0;
+};
+
+// 依次词法分析、语法分析和生成，编译一段CHTL源码
+inline CompiledSource compileSource(const std::string& source, const std::string& filename = "test.chtl") {
+    TokenArena tokens;
+    auto context = std::make_shared<CompileContext>(filename);
+    auto lexer = std::make_shared<Lexer>(std::string_view(source), tokens, context);
+    Parser parser(lexer, context);
+    auto program = parser.parse();
+
+    CompiledSource result;
+    result.parseErrors = parser.getErrors();
+    Generator generator(context);
+    result.html = generator.generate(program);
+    result.cacheHits = generator.getExpansionCache().hits();
+    result.cacheMisses = generator.getExpansionCache().misses();
+    return result;
+}
+
+} // namespace Test
+} // namespace CHTL
+
+#endif // COMPILE_SOURCE_H
@@ -0,0 +1,155 @@
+#include "../CHTLTestSuite.h"
+#include "../../CHTLJS/CJMODSystem/Runtime/CJMODRuntime.h"
+#include "../../CHTLJS/CJMODSystem/API/CJMODApi.h"
+#include "../../CompilerDispatcher/CompilerDispatcher.h"
+#include "../../Util/ZIPUtil/ZIPUtil.h"
+#include <filesystem>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+// 把匹配到的语法改写为 语法名(body)，并记录被调用的次数
+class RecordingExtension : public CJMODExtension {
+public:
+    explicit RecordingExtension(int* calls) : calls_(calls) {}
+
+    std::string getName() const override { return "recording"; }
+    std::string getVersion() const override { return "1.0.0"; }
+    std::string getDescription() const override { return "test extension"; }
+    bool initialize(CJMODRuntimeContext*) override { return true; }
+
+    ProcessResult process(const std::string& syntaxName, const std::string& matchedText,
+                          const std::map<std::string, std::string>& captures) override {
+        ++*calls_;
+        ProcessResult result;
+        if (matchedText.find("fail") != std::string::npos) {
+            result.errorMessage = "cannot process";
+            return result;
+        }
+        auto body = captures.find("body");
+        result.success = true;
+        result.generatedCode = syntaxName + "(" + (body != captures.end() ? body->second : "") + ")";
+        return result;
+    }
+
+private:
+    int* calls_;
+};
+
+CJMODInfo moduleInfo(const std::string& name, const std::map<std::string, std::string>& syntax) {
+    CJMODInfo info;
+    info.name = name;
+    info.version = "1.0.0";
+    info.syntaxDefinitions = syntax;
+    return info;
+}
+
+// 运行时是单例，测试结束时卸载本测试加载的模块
+struct RuntimeGuard {
+    ~RuntimeGuard() { CJMODRuntime::getInstance().unloadAll(); }
+};
+
+const char* PRINT_MYLOVE = R"({"pattern": "printMylove\\s*\\{([^}]*)\\}", "captureGroups": ["body"]})";
+const char* NEVER_AWAY = R"({"pattern": "iNeverAway\\s*\\{([^}]*)\\}", "captureGroups": ["body"]})";
+
+} // namespace
+
+CHTL_TEST(CJMODDispatch, ExpandsEveryModuleInOnePass) {
+    RuntimeGuard guard;
+    auto& runtime = CJMODRuntime::getInstance();
+    int callsA = 0;
+    int callsB = 0;
+    assertTrue(runtime.loadModule(moduleInfo("Chtholly", {{"printMylove", PRINT_MYLOVE}}),
+                                  std::make_unique<RecordingExtension>(&callsA)));
+    assertTrue(runtime.loadModule(moduleInfo("Yuigahama", {{"iNeverAway", NEVER_AWAY}}),
+                                  std::make_unique<RecordingExtension>(&callsB)));
+    assertTrue(runtime.hasSyntax());
+
+    auto result = runtime.expandSyntax(
+        "let a = 1; printMylove { x } iNeverAway {y} reprintMylove(); printMylove = 2; printMylove{z}");
+    assertTrue(result.success);
+    // 词边界外的同名标识符、不符合正则的用法保持原样
+    assertEqual(result.generatedCode,
+                "let a = 1; printMylove( x ) iNeverAway(y) reprintMylove(); printMylove = 2; printMylove(z)");
+    assertTrue(callsA == 2);
+    assertTrue(callsB == 1);
+}
+
+CHTL_TEST(CJMODDispatch, FailedMatchKeepsSourceAndReportsModule) {
+    RuntimeGuard guard;
+    auto& runtime = CJMODRuntime::getInstance();
+    int calls = 0;
+    assertTrue(runtime.loadModule(moduleInfo("Chtholly", {{"printMylove", PRINT_MYLOVE}}),
+                                  std::make_unique<RecordingExtension>(&calls)));
+
+    auto result = runtime.expandSyntax("printMylove { fail } printMylove { ok }");
+    assertFalse(result.success);
+    assertContains(result.errorMessage, "Chtholly.printMylove: cannot process");
+    assertEqual(result.generatedCode, "printMylove { fail } printMylove( ok )");
+}
+
+CHTL_TEST(CJMODDispatch, LoadsSyntaxFromArchive) {
+    RuntimeGuard guard;
+    const std::string archivePath =
+        (std::filesystem::temp_directory_path() / "chtl_cjmod_dispatch_Chtholly.cjmod").string();
+    ZIPWriter writer;
+    assertTrue(writer.create(archivePath));
+    assertTrue(writer.beginFile("info/Chtholly.chtl", 0));
+    assertTrue(writer.write("[Info] { }", 10));
+    std::string syntax = PRINT_MYLOVE;
+    assertTrue(writer.beginFile("syntax/printMylove.json", 6));
+    assertTrue(writer.write(syntax.data(), syntax.size()));
+    assertTrue(writer.close());
+
+    auto& runtime = CJMODRuntime::getInstance();
+    assertTrue(runtime.loadModule(archivePath));
+    std::filesystem::remove(archivePath);
+    assertTrue(runtime.hasSyntax());
+
+    auto matches = runtime.findSyntaxMatches("a(); printMylove { 1 }");
+    assertTrue(matches.size() == 1);
+    if (matches.size() != 1) {
+        return;
+    }
+    assertEqual(runtime.getMatchedModule(matches[0]), "chtl_cjmod_dispatch_Chtholly");
+    assertEqual(runtime.getMatchedSyntax(matches[0]).name, "printMylove");
+
+    // 未指定关键字的扫描也经过同一个自动机
+    CJMOD::CJMODScanner::setContext("a(); printMylove { 1 }");
+    auto found = CJMOD::CJMODScanner::scan(CJMOD::Arg());
+    assertTrue(found.size() == 1);
+    if (found.size() == 1) {
+        assertEqual(found[0].getValue(), "printMylove");
+    }
+    CJMOD::CJMODScanner::reset();
+}
+
+CHTL_TEST(CJMODDispatch, CHTLJSCompilerExpandsLoadedSyntax) {
+    RuntimeGuard guard;
+    int calls = 0;
+    assertTrue(CJMODRuntime::getInstance().loadModule(
+        moduleInfo("Chtholly", {{"printMylove", PRINT_MYLOVE}}),
+        std::make_unique<RecordingExtension>(&calls)));
+
+    auto compiler = CompilerFactory::createCHTLJSCompiler();
+    CompileOptions options;
+    auto result = compiler->compile("printMylove { 42 };", options);
+    assertTrue(result.success);
+    assertContains(result.jsOutput, "printMylove(42)");
+    assertNotContains(result.jsOutput, "printMylove {");
+    assertTrue(calls == 1);
+
+    auto failed = compiler->compile("printMylove { fail };", options);
+    assertFalse(failed.success);
+    assertTrue(!failed.errors.empty());
+    assertContains(failed.errors.front(), "cannot process");
+}
+
+CHTL_TEST_SUITE(CJMODDispatch) {
+    CHTL_ADD_TEST(CJMODDispatch, ExpandsEveryModuleInOnePass);
+    CHTL_ADD_TEST(CJMODDispatch, FailedMatchKeepsSourceAndReportsModule);
+    CHTL_ADD_TEST(CJMODDispatch, LoadsSyntaxFromArchive);
+    CHTL_ADD_TEST(CJMODDispatch, CHTLJSCompilerExpandsLoadedSyntax);
+}
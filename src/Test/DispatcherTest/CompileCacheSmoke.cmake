@@ -0,0 +1,53 @@
+# chtlc --cache-dir 端到端测试：未变化的页面第二次编译直接取缓存，修改后重新编译
+# 用法：cmake -DCHTLC=<chtlc路径> -DWORK_DIR=<临时目录> -P CompileCacheSmoke.cmake
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+file(WRITE "${WORK_DIR}/page.chtl" "div { text { \"first\" } }\n")
+
+function(compile_page expect_cached)
+    execute_process(
+        COMMAND "${CHTLC}" --cache-dir "${WORK_DIR}/cache" "${WORK_DIR}/page.chtl" "${WORK_DIR}/page.html"
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+        TIMEOUT 60
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "chtlc --cache-dir exited with ${result}:\n${output}")
+    endif()
+    if(expect_cached AND NOT output MATCHES "reused cached output")
+        message(FATAL_ERROR "Expected a cache hit:\n${output}")
+    endif()
+    if(NOT expect_cached AND output MATCHES "reused cached output")
+        message(FATAL_ERROR "Expected a cache miss:\n${output}")
+    endif()
+endfunction()
+
+compile_page(FALSE)
+compile_page(TRUE)
+
+file(WRITE "${WORK_DIR}/page.chtl" "div { text { \"second\" } }\n")
+compile_page(FALSE)
+
+file(READ "${WORK_DIR}/page.html" html)
+if(NOT html MATCHES "second")
+    message(FATAL_ERROR "Compiled output is stale:\n${html}")
+endif()
+
+# 出错的页面不进入缓存
+file(WRITE "${WORK_DIR}/page.chtl" "div { style { @Style Missing; } }\n")
+compile_page(FALSE)
+compile_page(FALSE)
+
+# --debug 输出缓存和模块索引的统计
+execute_process(
+    COMMAND "${CHTLC}" --debug --cache-dir "${WORK_DIR}/cache" "${WORK_DIR}/page.chtl" "${WORK_DIR}/page.html"
+    OUTPUT_VARIABLE output
+    RESULT_VARIABLE result
+    TIMEOUT 60
+)
+if(NOT result EQUAL 0 OR NOT output MATCHES "Cache: [0-9]+ hits" OR NOT output MATCHES "Module Resolution Index")
+    message(FATAL_ERROR "chtlc --debug did not print statistics:\n${output}")
+endif()
+
+file(REMOVE_RECURSE "${WORK_DIR}")
@@ -0,0 +1,111 @@
+#include "../CHTLTestSuite.h"
+#include "../../CompilerDispatcher/CompilerDispatcher.h"
+#include "../../Error/ErrorReport.h"
+#include "../../Util/ScopedInstance.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 页面、本地依赖、官方模块目录与缓存目录
+class CacheTree {
+public:
+    explicit CacheTree(const std::string& name)
+        : root_(fs::temp_directory_path() / ("chtl_compile_cache_" + name)) {
+        fs::remove_all(root_);
+        fs::create_directories(root_ / "project");
+        fs::create_directories(root_ / "official");
+        write("project/dep.chtl", "[Template] @Style Dep { color: red; }\n");
+        write("official/Theme.chtl", "[Template] @Style Theme { color: blue; }\n");
+        write("project/page.chtl",
+              "[Import] @Chtl from \"dep\"\n"
+              "[Import] @Chtl from \"chtl::Theme\"\n"
+              "div { id: box; text { \"cached\" } }\n");
+    }
+
+    ~CacheTree() {
+        std::error_code ec;
+        fs::remove_all(root_, ec);
+    }
+
+    void write(const std::string& relative, const std::string& content) {
+        std::ofstream(root_ / relative, std::ios::trunc) << content;
+    }
+
+    std::string path(const std::string& relative) const {
+        return (root_ / relative).string();
+    }
+
+    CompileResult compile() const {
+        auto dispatcher = CompilerFactory::createDispatcher();
+        CompileOptions options;
+        options.cacheDir = path("cache");
+        options.officialModuleDir = path("official");
+        dispatcher->setOptions(options);
+        return dispatcher->compile(path("project/page.chtl"));
+    }
+
+private:
+    fs::path root_;
+};
+
+} // namespace
+
+CHTL_TEST(CompileCache, HitWhenNothingChanged) {
+    CacheTree tree("hit");
+    auto first = tree.compile();
+    assertTrue(first.success);
+    assertFalse(first.fromCache);
+
+    auto second = tree.compile();
+    assertTrue(second.success);
+    assertTrue(second.fromCache);
+    assertEqual(second.htmlOutput, first.htmlOutput);
+}
+
+CHTL_TEST(CompileCache, MissAfterDependencyEdit) {
+    CacheTree tree("dependency");
+    assertFalse(tree.compile().fromCache);
+
+    tree.write("project/dep.chtl", "[Template] @Style Dep { color: green; }\n");
+    assertFalse(tree.compile().fromCache);
+    assertTrue(tree.compile().fromCache);
+}
+
+CHTL_TEST(CompileCache, MissAfterOfficialModuleEdit) {
+    CacheTree tree("official");
+    assertFalse(tree.compile().fromCache);
+
+    // chtl:: 导入只在官方模块目录中解析，修改后缓存必须失效
+    tree.write("official/Theme.chtl", "[Template] @Style Theme { color: navy; }\n");
+    assertFalse(tree.compile().fromCache);
+    assertTrue(tree.compile().fromCache);
+}
+
+CHTL_TEST(CompileCache, ReportedErrorsAreNotCached) {
+    CacheTree tree("errors");
+    tree.write("project/page.chtl", "div { style { @Style Missing; } }\n");
+
+    // 未定义模板的错误经ErrorReport上报，不在CompileResult.errors中
+    for (int run = 0; run < 2; ++run) {
+        ScopedInstance<ErrorReport> errorReport;
+        auto collector = std::make_shared<ErrorCollector>();
+        errorReport.get().addReporter(collector);
+
+        auto result = tree.compile();
+        assertFalse(result.fromCache);
+        assertTrue(collector->hasErrors());
+    }
+}
+
+CHTL_TEST_SUITE(CompileCache) {
+    CHTL_ADD_TEST(CompileCache, HitWhenNothingChanged);
+    CHTL_ADD_TEST(CompileCache, MissAfterDependencyEdit);
+    CHTL_ADD_TEST(CompileCache, MissAfterOfficialModuleEdit);
+    CHTL_ADD_TEST(CompileCache, ReportedErrorsAreNotCached);
+}
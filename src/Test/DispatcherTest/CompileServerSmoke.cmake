@@ -0,0 +1,45 @@
+# chtlc --server 端到端测试：stdin写入JSON-RPC请求，检查stdout上的回复
+# 用法：cmake -DCHTLC=<chtlc路径> -DWORK_DIR=<临时目录> -P CompileServerSmoke.cmake
+
+function(frame body out)
+    string(LENGTH "${body}" length)
+    set(${out} "${${out}}Content-Length: ${length}\r\n\r\n${body}" PARENT_SCOPE)
+endfunction()
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+set(requests "")
+frame([[{"jsonrpc":"2.0","id":1,"method":"initialize","params":{}}]] requests)
+frame("{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"compile\",\"params\":{\"file\":\"${WORK_DIR}/page.chtl\",\"text\":\"div { text { \\\"served\\\" } }\",\"output\":\"${WORK_DIR}/page.html\"}}" requests)
+frame([[{"jsonrpc":"2.0","id":3,"method":"shutdown"}]] requests)
+frame([[{"jsonrpc":"2.0","method":"exit"}]] requests)
+file(WRITE "${WORK_DIR}/requests.bin" "${requests}")
+
+execute_process(
+    COMMAND "${CHTLC}" --server --jobs 1
+    INPUT_FILE "${WORK_DIR}/requests.bin"
+    OUTPUT_VARIABLE output
+    RESULT_VARIABLE result
+    TIMEOUT 60
+)
+
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "chtlc --server exited with ${result}:\n${output}")
+endif()
+if(NOT output MATCHES "\"id\":1,\"result\":{\"serverInfo\":{\"name\":\"chtlc\"")
+    message(FATAL_ERROR "Missing initialize reply:\n${output}")
+endif()
+if(NOT output MATCHES "\"id\":2,\"result\":{\"success\":true")
+    message(FATAL_ERROR "Missing successful compile reply:\n${output}")
+endif()
+if(NOT output MATCHES "\"id\":3,\"result\":null")
+    message(FATAL_ERROR "Missing shutdown reply:\n${output}")
+endif()
+
+file(READ "${WORK_DIR}/page.html" html)
+if(NOT html MATCHES "served")
+    message(FATAL_ERROR "Compiled output missing text:\n${html}")
+endif()
+
+file(REMOVE_RECURSE "${WORK_DIR}")
@@ -0,0 +1,91 @@
+#include "../CHTLTestSuite.h"
+#include "../../CompilerDispatcher/CompileServer.h"
+#include "../../Util/JsonRpc/JsonRpcServer.h"
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+std::string frame(const std::string& body) {
+    std::stringstream ss;
+    JsonRpcServer::writeMessage(ss, body);
+    return ss.str();
+}
+
+// 读出全部回复，按id索引
+std::map<std::string, JsonValue> readResponses(const std::string& output) {
+    std::map<std::string, JsonValue> responses;
+    std::stringstream in(output);
+    std::string body;
+    while (JsonRpcServer::readMessage(in, body)) {
+        auto message = JsonValue::parse(body);
+        if (message) {
+            const JsonValue* id = message->find("id");
+            responses[id ? id->serialize() : "null"] = *message;
+        }
+    }
+    return responses;
+}
+
+const JsonValue* resultField(const JsonValue& response, const char* name) {
+    const JsonValue* result = response.find("result");
+    return result ? result->find(name) : nullptr;
+}
+
+} // namespace
+
+CHTL_TEST(CompileServer, CompileAndValidateRequests) {
+    fs::path dir = fs::temp_directory_path() / "chtl_compile_server";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    std::string page = (dir / "page.chtl").string();
+    std::string output = (dir / "page.html").string();
+    std::ofstream(page) << "div { id: saved; text { \"on disk\" } }\n";
+
+    std::string compileOnDisk = "{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"compile\",\"params\":{\"file\":\"" +
+                                page + "\",\"output\":\"" + output + "\"}}";
+    std::string validateText = "{\"jsonrpc\":\"2.0\",\"id\":3,\"method\":\"validate\",\"params\":{\"file\":\"" +
+                               page + "\",\"text\":\"span { text { \\\"unsaved\\\" } }\"}}";
+    std::stringstream in(frame(R"({"jsonrpc":"2.0","id":1,"method":"initialize","params":{}})") +
+                         frame(compileOnDisk) +
+                         frame(validateText) +
+                         frame(R"({"jsonrpc":"2.0","id":4,"method":"compile","params":{}})") +
+                         frame(R"({"jsonrpc":"2.0","id":5,"method":"shutdown"})") +
+                         frame(R"({"jsonrpc":"2.0","method":"exit"})"));
+    std::stringstream out;
+
+    int exitCode = runCompileServer(in, out, CompileOptions(), 2);
+    assertTrue(exitCode == 0);
+
+    auto responses = readResponses(out.str());
+    assertTrue(responses.size() == 5);
+
+    const JsonValue* workers = resultField(responses["1"], "workers");
+    assertTrue(workers && workers->asNumber() == 2);
+
+    const JsonValue* success = resultField(responses["2"], "success");
+    assertTrue(success && success->asBool());
+    std::ifstream written(output);
+    std::string html((std::istreambuf_iterator<char>(written)), std::istreambuf_iterator<char>());
+    assertContains(html, "on disk");
+
+    const JsonValue* valid = resultField(responses["3"], "valid");
+    assertTrue(valid && valid->asBool());
+
+    const JsonValue* error = responses["4"].find("error");
+    assertTrue(error && error->find("code")->asNumber() == JsonRpcErrorCode::INVALID_PARAMS);
+
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+}
+
+CHTL_TEST_SUITE(CompileServer) {
+    CHTL_ADD_TEST(CompileServer, CompileAndValidateRequests);
+}
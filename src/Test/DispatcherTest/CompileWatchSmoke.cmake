@@ -0,0 +1,38 @@
+# chtlc --watch 端到端测试：修改被导入的文件后，只重编译导入了它的页面
+# 用法：cmake -DCHTLC=<chtlc路径> -DWORK_DIR=<临时目录> -P CompileWatchSmoke.cmake
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}/out")
+file(WRITE "${WORK_DIR}/dep.chtl" "[Template] @Style Dep { color: red; }\n")
+file(WRITE "${WORK_DIR}/page.chtl" "[Import] @Chtl from \"dep\"\ndiv { text { \"page\" } }\n")
+file(WRITE "${WORK_DIR}/other.chtl" "span { text { \"other\" } }\n")
+
+# 后台启动监视，连续两次修改依赖（落在同一个去抖窗口内），然后结束进程
+set(script "
+cd '${WORK_DIR}' || exit 1
+'${CHTLC}' --watch --debounce 200 --page other.chtl page.chtl out/page.html > watch.log 2>&1 &
+pid=$!
+sleep 1
+echo '[Template] @Style Dep { color: green; }' > dep.chtl
+echo '[Template] @Style Dep { color: blue; }' > dep.chtl
+sleep 2
+kill $pid
+wait $pid 2>/dev/null
+exit 0
+")
+execute_process(COMMAND sh -c "${script}" RESULT_VARIABLE result TIMEOUT 60)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "watch script failed with ${result}")
+endif()
+
+file(READ "${WORK_DIR}/watch.log" log)
+if(NOT log MATCHES "Watching for changes")
+    message(FATAL_ERROR "chtlc --watch did not start:\n${log}")
+endif()
+string(REGEX MATCHALL "Recompiling [^\n]*" rebuilds "${log}")
+list(LENGTH rebuilds count)
+if(NOT count EQUAL 1 OR NOT rebuilds MATCHES "page\\.chtl")
+    message(FATAL_ERROR "Expected exactly one rebuild of page.chtl:\n${log}")
+endif()
+
+file(REMOVE_RECURSE "${WORK_DIR}")
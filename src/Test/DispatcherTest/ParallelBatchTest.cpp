@@ -0,0 +1,129 @@
+#include "../CHTLTestSuite.h"
+#include "../../CompilerDispatcher/CompilerDispatcher.h"
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 测试用的临时源文件目录
+class SourceTree {
+public:
+    explicit SourceTree(const std::string& name)
+        : root_(fs::temp_directory_path() / ("chtl_parallel_batch_" + name)) {
+        fs::remove_all(root_);
+        fs::create_directories(root_);
+    }
+
+    ~SourceTree() {
+        std::error_code ec;
+        fs::remove_all(root_, ec);
+    }
+
+    std::string write(const std::string& relative, const std::string& content) {
+        fs::path path = root_ / relative;
+        std::ofstream(path) << content;
+        return path.string();
+    }
+
+    std::string path(const std::string& relative) const {
+        return (root_ / relative).string();
+    }
+
+private:
+    fs::path root_;
+};
+
+// 各文件定义同名模板，编译状态在文件之间泄漏时输出会互相污染
+std::string buildSource(size_t index) {
+    std::string n = std::to_string(index);
+    return "[Template] @Style Theme { color: c" + n + "; }\n"
+           "html { body { div {\n"
+           "    id: box" + n + ";\n"
+           "    style { @Style Theme; .item" + n + " { width: " + n + "px; } }\n"
+           "    text { \"entry " + n + "\" }\n"
+           "} } }\n"
+           "style { body { margin: " + n + "px; } }\n"
+           "script { console.log(" + n + "); }\n";
+}
+
+std::vector<CompileResult> compileBatch(const std::vector<std::string>& files, size_t jobs) {
+    auto dispatcher = CompilerFactory::createDispatcher();
+    CompileOptions options;
+    options.parallelJobs = jobs;
+    dispatcher->setOptions(options);
+    return dispatcher->compileBatch(files);
+}
+
+} // namespace
+
+CHTL_TEST(ParallelBatch, MatchesSequentialCompilation) {
+    SourceTree tree("matches");
+    std::vector<std::string> files;
+    for (size_t i = 0; i < 24; ++i) {
+        files.push_back(tree.write("page" + std::to_string(i) + ".chtl", buildSource(i)));
+    }
+
+    auto sequential = compileBatch(files, 1);
+    auto parallel = compileBatch(files, 4);
+
+    assertTrue(sequential.size() == files.size());
+    assertTrue(parallel.size() == files.size());
+    for (size_t i = 0; i < files.size(); ++i) {
+        assertTrue(sequential[i].success);
+        assertTrue(parallel[i].success);
+        assertContains(parallel[i].htmlOutput, "box" + std::to_string(i));
+        assertContains(parallel[i].htmlOutput, "color: c" + std::to_string(i));
+        // 结果按输入顺序排列，内容与顺序编译完全一致
+        assertEqual(parallel[i].htmlOutput, sequential[i].htmlOutput);
+        assertEqual(parallel[i].cssOutput, sequential[i].cssOutput);
+        assertEqual(parallel[i].jsOutput, sequential[i].jsOutput);
+        assertTrue(parallel[i].errors == sequential[i].errors);
+    }
+}
+
+CHTL_TEST(ParallelBatch, ProgressAndMissingFiles) {
+    SourceTree tree("progress");
+    std::vector<std::string> files;
+    for (size_t i = 0; i < 8; ++i) {
+        files.push_back(tree.write("page" + std::to_string(i) + ".chtl", buildSource(i)));
+    }
+    files.push_back(tree.path("missing.chtl"));
+
+    auto dispatcher = CompilerFactory::createDispatcher();
+    CompileOptions options;
+    options.parallelJobs = 3;
+    dispatcher->setOptions(options);
+
+    std::mutex mutex;
+    std::vector<size_t> progress;
+    dispatcher->setProgressCallback([&](size_t current, size_t total) {
+        std::lock_guard<std::mutex> lock(mutex);
+        assertTrue(total == 9);
+        progress.push_back(current);
+    });
+
+    auto results = dispatcher->compileBatch(files);
+    assertTrue(results.size() == 9);
+    assertFalse(results.back().success);
+    for (size_t i = 0; i + 1 < results.size(); ++i) {
+        assertTrue(results[i].success);
+    }
+
+    // 进度单调递增，以 (total, total) 结束
+    assertFalse(progress.empty());
+    for (size_t i = 1; i < progress.size(); ++i) {
+        assertTrue(progress[i - 1] <= progress[i]);
+    }
+    assertTrue(progress.back() == 9);
+}
+
+CHTL_TEST_SUITE(ParallelBatch) {
+    CHTL_ADD_TEST(ParallelBatch, MatchesSequentialCompilation);
+    CHTL_ADD_TEST(ParallelBatch, ProgressAndMissingFiles);
+}
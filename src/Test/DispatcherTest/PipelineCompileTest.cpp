@@ -0,0 +1,93 @@
+#include "../CHTLTestSuite.h"
+#include "../../CompilerDispatcher/CompilerDispatcher.h"
+#include <sstream>
+#include <thread>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+// 同时包含CHTL、局部/全局样式和脚本的页面
+std::string buildPage(size_t count) {
+    std::stringstream ss;
+    ss << "html {\n    body {\n";
+    for (size_t i = 0; i < count; ++i) {
+        ss << "        div {\n"
+           << "            id: item" << i << ";\n"
+           << "            style { .item" << i << " { color: red; width: " << i << "px; } }\n"
+           << "            script { console.log(" << i << "); }\n"
+           << "            text { \"entry " << i << "\" }\n"
+           << "        }\n";
+    }
+    ss << "    }\n}\n"
+       << "style { body { margin: 0; } }\n"
+       << "script { console.log(\"ready\"); }\n";
+    return ss.str();
+}
+
+std::shared_ptr<CompilerDispatcher> createDispatcher(bool pipeline, size_t capacity = 64) {
+    auto dispatcher = CompilerFactory::createDispatcher();
+    CompileOptions options;
+    options.pipelineFragments = pipeline;
+    options.fragmentQueueCapacity = capacity;
+    dispatcher->setOptions(options);
+    return dispatcher;
+}
+
+bool sameResult(const CompileResult& actual, const CompileResult& expected) {
+    return actual.success == expected.success &&
+           actual.htmlOutput == expected.htmlOutput &&
+           actual.cssOutput == expected.cssOutput &&
+           actual.jsOutput == expected.jsOutput &&
+           actual.errors == expected.errors &&
+           actual.processedFragments == expected.processedFragments;
+}
+
+} // namespace
+
+CHTL_TEST(PipelineCompile, MatchesSequentialCompilation) {
+    std::string source = buildPage(40);
+    auto expected = createDispatcher(false)->compileString(source, "page.chtl");
+    assertTrue(expected.success);
+    assertFalse(expected.htmlOutput.empty());
+    assertTrue(expected.errors.empty());
+
+    // 容量为1时扫描几乎每个片段都要等收集任务取走
+    for (size_t capacity : {static_cast<size_t>(1), static_cast<size_t>(64), static_cast<size_t>(0)}) {
+        auto actual = createDispatcher(true, capacity)->compileString(source, "page.chtl");
+        assertTrue(sameResult(actual, expected));
+    }
+}
+
+CHTL_TEST(PipelineCompile, ConcurrentCallsOnOneDispatcher) {
+    std::string source = buildPage(20);
+    auto expected = createDispatcher(false)->compileString(source, "page.chtl");
+
+    // 两个线程共用一个调度器的流水线线程池和扫描器
+    auto dispatcher = createDispatcher(true, 1);
+    std::vector<CompileResult> results[2];
+    std::thread threads[2];
+    for (size_t t = 0; t < 2; ++t) {
+        threads[t] = std::thread([&, t]() {
+            for (int i = 0; i < 10; ++i) {
+                results[t].push_back(dispatcher->compileString(source, "page.chtl"));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& perThread : results) {
+        assertTrue(perThread.size() == 10);
+        for (const auto& result : perThread) {
+            assertTrue(sameResult(result, expected));
+        }
+    }
+}
+
+CHTL_TEST_SUITE(PipelineCompile) {
+    CHTL_ADD_TEST(PipelineCompile, MatchesSequentialCompilation);
+    CHTL_ADD_TEST(PipelineCompile, ConcurrentCallsOnOneDispatcher);
+}
@@ -0,0 +1,131 @@
+#include "../CHTLTestSuite.h"
+#include "../ASTTestUtil/ASTBuilder.h"
+#include "../../CHTLJS/CHTLJSGenerator/Generator.h"
+
+using namespace CHTLJS;
+using namespace CHTL::Test;
+
+namespace {
+
+using Type = EnhancedSelectorNode::SelectorType;
+using Properties = std::vector<std::pair<std::string, std::string>>;
+
+std::shared_ptr<ASTNode> number(int64_t value) {
+    return std::make_shared<LiteralNode>(LiteralNode::LiteralType::NUMBER, TokenValue(value), TokenLocation());
+}
+
+std::shared_ptr<ASTNode> unquoted(const std::string& value) {
+    return std::make_shared<LiteralNode>(LiteralNode::LiteralType::UNQUOTED, TokenValue(value), TokenLocation());
+}
+
+std::shared_ptr<AnimateStateNode> state(AnimateStateNode::StateType type, const Properties& properties,
+                                        std::optional<double> at = std::nullopt) {
+    auto node = std::make_shared<AnimateStateNode>(type, TokenLocation());
+    if (at) {
+        node->setAt(*at);
+    }
+    for (const auto& [name, value] : properties) {
+        node->addProperty(name, value);
+    }
+    return node;
+}
+
+std::shared_ptr<AnimateStateNode> when(double at, const Properties& properties) {
+    return state(AnimateStateNode::StateType::WHEN, properties, at);
+}
+
+std::string generate(const std::shared_ptr<ProgramNode>& root) {
+    GeneratorConfig config;
+    config.wrapInIIFE = false;
+    config.hoistSelectors = false;
+    Generator generator(std::make_shared<CompileContext>("test.cjjs"), config);
+    return generator.generate(root);
+}
+
+// 程序体（辅助代码之后）
+std::string body(const std::string& output) {
+    size_t begin = output.find("var CHTLVirtualObjects = {};\n\n");
+    return output.substr(begin + 30);
+}
+
+} // namespace
+
+CHTL_TEST(AnimationLowering, KeyframesForWebAnimations) {
+    // 文档示例：begin / when / end 展开为关键帧数组，交给Element.animate()
+    auto animate = std::make_shared<AnimateNode>(TokenLocation());
+    animate->setTarget(selector(".card", Type::CLASS));
+    animate->setProperty("duration", number(100));
+    animate->setProperty("easing", unquoted("ease-in-out"));
+    animate->setProperty("loop", std::make_shared<UnaryExpressionNode>(UnaryExpressionNode::Operator::MINUS,
+        number(1), TokenLocation()));
+    animate->setProperty("callback", std::make_shared<IdentifierNode>("onDone", TokenLocation()));
+    animate->setBegin(state(AnimateStateNode::StateType::BEGIN, {{"opacity", "0"}, {"background-color", "#fff"}}));
+    animate->addWhen(when(0.8, {{"opacity", "0.9"}}));
+    animate->addWhen(when(0.4, {{"opacity", "0.5"}, {"transform", "'scale(1.1)'"}}));
+    animate->setEnd(state(AnimateStateNode::StateType::END, {{"opacity", "1"}, {"background-color", "#000"}}));
+
+    auto output = generate(program({animate}));
+    assertEqual(
+        "CHTLAnimation.animate(CHTLSelector.byClass('.card'), [\n"
+        "  {offset: 0, backgroundColor: '#fff', opacity: '0'},\n"
+        "  {offset: 0.4, opacity: '0.5', transform: 'scale(1.1)'},\n"
+        "  {offset: 0.8, opacity: '0.9'},\n"
+        "  {offset: 1, backgroundColor: '#000', opacity: '1'}\n"
+        "], null, {duration: 100, easing: \"ease-in-out\", iterations: Infinity, fill: 'both'}, onDone);\n",
+        body(output));
+
+    // 只有逐帧轨道存在时才需要requestAnimationFrame
+    assertTrue(output.find("els[i].animate(keyframes, options)") != std::string::npos);
+    assertTrue(output.find("if (tracks && els.length) {") != std::string::npos);
+}
+
+CHTL_TEST(AnimationLowering, ElementPropertiesUseFrameTracks) {
+    // scrollTop无法由CSS表达，降级为数值轨道；缺省at在相邻关键帧之间均分
+    auto animate = std::make_shared<AnimateNode>(TokenLocation());
+    animate->setTarget(selector("#log", Type::ID));
+    animate->setProperty("direction", unquoted("alternate"));
+    animate->setProperty("loop", number(3));
+    animate->setBegin(state(AnimateStateNode::StateType::BEGIN, {{"scrollTop", "0"}}));
+    animate->addWhen(state(AnimateStateNode::StateType::WHEN, {{"scrollTop", "120px"}, {"--glow", "1"}}));
+    animate->addWhen(state(AnimateStateNode::StateType::WHEN, {{"float", "left"}}));
+    animate->setEnd(state(AnimateStateNode::StateType::END, {{"scrollTop", "480"}}));
+
+    assertEqual(
+        "CHTLAnimation.animate(CHTLSelector.byId('#log'), [\n"
+        "  {offset: 0.333333, '--glow': '1'},\n"
+        "  {offset: 0.666667, cssFloat: 'left'}\n"
+        "], {scrollTop: [[0, 0], [0.333333, 120], [1, 480]]}, "
+        "{duration: 1000, iterations: 3, direction: \"alternate\", fill: 'both'});\n",
+        body(generate(program({animate}))));
+}
+
+CHTL_TEST(AnimationLowering, KeyframeOffsets) {
+    // 单个关键帧偏移量为1，when超出范围时截断
+    auto animate = std::make_shared<AnimateNode>(TokenLocation());
+    animate->addWhen(state(AnimateStateNode::StateType::WHEN, {{"opacity", "0"}}));
+    auto lowered = AnimationLowering::lower(animate.get());
+    assertTrue(lowered.keyframes.size() == 1 && lowered.keyframes[0].offset == 1.0);
+
+    animate = std::make_shared<AnimateNode>(TokenLocation());
+    animate->addWhen(when(1.5, {{"opacity", "1"}}));
+    animate->addWhen(when(-0.5, {{"opacity", "0"}}));
+    lowered = AnimationLowering::lower(animate.get());
+    assertTrue(lowered.keyframes.size() == 2);
+    assertTrue(lowered.keyframes[0].offset == 0.0 && lowered.keyframes[1].offset == 1.0);
+    assertEqual("0", lowered.keyframes[0].properties[0].second);
+
+    // 空状态块不产生关键帧，也不产生空的animate调用参数
+    animate = std::make_shared<AnimateNode>(TokenLocation());
+    animate->setBegin(state(AnimateStateNode::StateType::BEGIN, {}));
+    assertEqual("CHTLAnimation.animate(null, [], null, {duration: 1000, fill: 'both'});\n",
+                body(generate(program({animate}))));
+
+    assertEqual("borderTopLeftRadius", AnimationLowering::toKeyframeProperty("border-top-left-radius"));
+    assertEqual("webkitTransform", AnimationLowering::toKeyframeProperty("-webkit-transform"));
+}
+
+CHTL_TEST_SUITE(AnimationLowering) {
+    CHTL_ADD_TEST(AnimationLowering, KeyframesForWebAnimations);
+    CHTL_ADD_TEST(AnimationLowering, ElementPropertiesUseFrameTracks);
+    CHTL_ADD_TEST(AnimationLowering, KeyframeOffsets);
+}
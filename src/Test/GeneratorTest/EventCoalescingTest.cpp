@@ -0,0 +1,230 @@
+#include "../CHTLTestSuite.h"
+#include "../ASTTestUtil/ASTBuilder.h"
+#include "../../CHTLJS/CHTLJSGenerator/Generator.h"
+
+using namespace CHTLJS;
+using namespace CHTL::Test;
+
+namespace {
+
+using Type = EnhancedSelectorNode::SelectorType;
+using Handlers = std::vector<std::pair<std::string, std::shared_ptr<ASTNode>>>;
+
+// function(param) { body; }
+std::shared_ptr<ASTNode> handler(const std::string& param, std::shared_ptr<ASTNode> body) {
+    auto node = std::make_shared<FunctionDeclarationNode>("", TokenLocation());
+    if (!param.empty()) {
+        node->addParameter(param);
+    }
+    node->setBody(program({body}));
+    return node;
+}
+
+// {{target}}->listen { ... }
+std::shared_ptr<ASTNode> listen(std::shared_ptr<ASTNode> target, const Handlers& handlers) {
+    auto node = std::make_shared<ListenNode>(TokenLocation());
+    for (const auto& [event, function] : handlers) {
+        node->addEventHandler(event, function);
+    }
+    return std::make_shared<ArrowAccessNode>(target, node, TokenLocation());
+}
+
+// {{parent}}->delegate { target: ..., ... }
+std::shared_ptr<ASTNode> delegate(std::shared_ptr<ASTNode> parent, std::shared_ptr<ASTNode> target,
+                                  const Handlers& handlers) {
+    auto node = std::make_shared<DelegateNode>(TokenLocation());
+    node->setTarget(target);
+    for (const auto& [event, function] : handlers) {
+        node->addEventHandler(event, function);
+    }
+    return std::make_shared<ArrowAccessNode>(parent, node, TokenLocation());
+}
+
+// {{target}} &-> event { handler }
+std::shared_ptr<ASTNode> bindEvent(std::shared_ptr<ASTNode> target, const std::string& event,
+                                   std::shared_ptr<ASTNode> function) {
+    return std::make_shared<EventBindingNode>(target, event, function, TokenLocation());
+}
+
+std::string generate(const std::shared_ptr<ProgramNode>& root, bool coalesce = true) {
+    GeneratorConfig config;
+    config.wrapInIIFE = false;
+    config.coalesceEvents = coalesce;
+    Generator generator(std::make_shared<CompileContext>("test.cjjs"), config);
+    return generator.generate(root);
+}
+
+// 截取分发表
+std::string dispatchTable(const std::string& output) {
+    size_t begin = output.find("  var table = ");
+    size_t end = output.find("  var api = {};\n", begin);
+    return output.substr(begin, end - begin);
+}
+
+// 程序体（辅助代码之后）
+std::string body(const std::string& output) {
+    size_t begin = output.find("var CHTLVirtualObjects = {};\n\n");
+    return output.substr(begin + 30);
+}
+
+} // namespace
+
+CHTL_TEST(EventCoalescing, OneRootListenerPerEvent) {
+    // listen、delegate、&-> 绑定合并进同一张分发表，槽位按特异性排序
+    auto output = generate(program({
+        listen(selector(".row", Type::CLASS), {
+            {"click", handler("e", call(member(identifier("console"), "log"), {member(identifier("e"), "target")}))},
+            {"keydown", handler("e", call(member(identifier("e"), "preventDefault")))},
+        }),
+        delegate(selector("#list", Type::ID), selector(".row", Type::CLASS), {{"click", handler("e", identifier("open"))}}),
+        bindEvent(selector("button", Type::TAG), "click", handler("e", identifier("submit"))),
+        bindEvent(selector(".row", Type::CLASS), "click", handler("e", identifier("select"))),
+    }));
+
+    assertEqual(
+        "  var table = {\n"
+        "    'click': {passive: true, slots: [\n"
+        "      {selector: '#list .row', handlers: []},\n"
+        "      {selector: '.row', handlers: []},\n"
+        "      {selector: 'button', handlers: []}\n"
+        "    ]},\n"
+        "    'keydown': {passive: false, slots: [\n"
+        "      {selector: '.row', handlers: []}\n"
+        "    ]}\n"
+        "  };\n",
+        dispatchTable(output));
+    assertEqual(
+        "CHTLEventDelegation.bind('click', [1], function(e) {\n"
+        "  console.log(e.target);\n"
+        "}).bind('keydown', [0], function(e) {\n"
+        "  e.preventDefault();\n"
+        "});\n"
+        "CHTLEventDelegation.bind('click', [0], function(e) {\n"
+        "  open;\n"
+        "});\n"
+        "CHTLEventDelegation.bind('click', [2], function(e) {\n"
+        "  submit;\n"
+        "});\n"
+        "CHTLEventDelegation.bind('click', [1], function(e) {\n"
+        "  select;\n"
+        "});\n",
+        body(output));
+    assertTrue(output.find("document.addEventListener(event, dispatch, entry.passive ? {passive: true} : false);")
+               != std::string::npos);
+
+    // 已合并的绑定不再查询选择器
+    assertTrue(output.find("CHTLSelectorHandles") == std::string::npos);
+}
+
+CHTL_TEST(EventCoalescing, PassiveRequiresProvablyNoPreventDefault) {
+    auto passive = [](std::shared_ptr<ASTNode> function) {
+        return !EventCoalescing::mayPreventDefault(function.get());
+    };
+
+    assertTrue(passive(handler("e", member(member(identifier("e"), "target"), "value"))));
+    assertTrue(passive(handler("", call(identifier("refresh")))));
+    assertFalse(passive(handler("e", call(member(identifier("e"), "preventDefault")))));
+    // 事件对象逃逸到其他函数
+    assertFalse(passive(handler("e", call(identifier("track"), {identifier("e")}))));
+    assertFalse(passive(handler("", member(identifier("event"), "type"))));
+    assertFalse(passive(handler("e", std::make_shared<BinaryExpressionNode>(BinaryExpressionNode::Operator::DOT,
+        identifier("e"), identifier("returnValue"), TokenLocation()))));
+    // 外部函数无法分析
+    assertFalse(passive(identifier("onScroll")));
+
+    // 内层函数参数遮蔽事件对象
+    assertTrue(passive(handler("e", call(identifier("items.forEach"), {handler("e", call(identifier("draw"), {identifier("e")}))}))));
+}
+
+CHTL_TEST(EventCoalescing, FallbackBindings) {
+    auto output = generate(program({
+        // 不冒泡的事件
+        listen(selector(".field", Type::CLASS), {{"focus", handler("e", identifier("highlight"))}}),
+        // 带索引的选择器
+        bindEvent(selector(".tab", Type::CLASS, 1), "click", handler("e", identifier("show"))),
+        // & 引用的父元素
+        delegate(selector("&", Type::REFERENCE), selector(".item", Type::CLASS), {{"click", handler("e", identifier("pick"))}}),
+    }));
+
+    assertEqual("  var table = {};\n", dispatchTable(output));
+    assertEqual(
+        "CHTLEventDelegation.listen(CHTLSelectorHandles.h0(), 'focus', function(e) {\n"
+        "  highlight;\n"
+        "});\n"
+        "CHTLEventDelegation.listen(CHTLSelectorHandles.h1()[1], 'click', function(e) {\n"
+        "  show;\n"
+        "});\n"
+        "CHTLEventDelegation.delegate(CHTLSelector.current(), '.item', 'click', function(e) {\n"
+        "  pick;\n"
+        "});\n",
+        body(output));
+
+    // 关闭合并时逐元素监听
+    output = generate(program({
+        delegate(selector("#list", Type::ID), selector(".row", Type::CLASS), {{"click", handler("e", identifier("open"))}}),
+        bindEvent(selector("button", Type::TAG), "click", handler("e", identifier("submit"))),
+    }), false);
+    assertEqual("  var table = {};\n", dispatchTable(output));
+    assertTrue(body(output).find("CHTLEventDelegation.delegate(CHTLSelectorHandles.h0(), '.row', 'click', ") == 0);
+    assertTrue(body(output).find("CHTLEventDelegation.listen(CHTLSelectorHandles.h1(), 'click', ") != std::string::npos);
+}
+
+CHTL_TEST(EventCoalescing, StopImmediatePropagationSkipsTableHandlers) {
+    // 同一元素上的其余处理器都挂在同一个原生监听器后面，只能由分发循环跳过
+    auto output = generate(program({
+        bindEvent(selector(".row", Type::CLASS), "click", handler("e", call(member(identifier("e"), "stopImmediatePropagation")))),
+        bindEvent(selector(".row", Type::CLASS), "click", handler("e", identifier("select"))),
+    }));
+
+    size_t begin = output.find("  function dispatch(e) {\n");
+    size_t end = output.find("  function bind(", begin);
+    assertTrue(begin != std::string::npos && end != std::string::npos);
+    assertEqual(
+        "  function dispatch(e) {\n"
+        "    var slots = table[e.type].slots;\n"
+        "    var stopped = false;\n"
+        "    var stopImmediate = e.stopImmediatePropagation;\n"
+        "    e.stopImmediatePropagation = function() {\n"
+        "      stopped = true;\n"
+        "      stopImmediate.call(e);\n"
+        "    };\n"
+        "    var el = e.target;\n"
+        "    if (el && el.nodeType !== 1) el = el.parentElement;\n"
+        "    for (; el; el = el.parentElement) {\n"
+        "      for (var i = 0; i < slots.length; i++) {\n"
+        "        var slot = slots[i];\n"
+        "        if (slot.handlers.length && el.matches(slot.selector)) {\n"
+        "          for (var j = 0; j < slot.handlers.length; j++) {\n"
+        "            if (stopped) return;\n"
+        "            slot.handlers[j].call(el, e);\n"
+        "          }\n"
+        "        }\n"
+        "      }\n"
+        "      if (e.cancelBubble) break;\n"
+        "    }\n"
+        "  }\n"
+        "  \n",
+        output.substr(begin, end - begin));
+}
+
+CHTL_TEST(EventCoalescing, SelectorSpecificity) {
+    auto specificity = [](const std::string& selector) {
+        auto s = EventCoalescing::specificity(selector);
+        return std::to_string(s.ids) + "," + std::to_string(s.classes) + "," + std::to_string(s.types);
+    };
+
+    assertEqual("0,0,1", specificity("button"));
+    assertEqual("1,1,0", specificity("#list .row"));
+    assertEqual("0,2,2", specificity("ul li.row[data-id]"));
+    assertEqual("0,1,1", specificity("a:hover"));
+    assertEqual("0,0,2", specificity("p::before"));
+    assertEqual("1,0,0", specificity(".a, #b"));
+}
+
+CHTL_TEST_SUITE(EventCoalescing) {
+    CHTL_ADD_TEST(EventCoalescing, OneRootListenerPerEvent);
+    CHTL_ADD_TEST(EventCoalescing, PassiveRequiresProvablyNoPreventDefault);
+    CHTL_ADD_TEST(EventCoalescing, FallbackBindings);
+    CHTL_ADD_TEST(EventCoalescing, StopImmediatePropagationSkipsTableHandlers);
+    CHTL_ADD_TEST(EventCoalescing, SelectorSpecificity);
+}
@@ -0,0 +1,91 @@
+#include "../CHTLTestSuite.h"
+#include "../CompileTestUtil/CompileSource.h"
+#include "../../CHTL/CHTLGenerator/ExpansionCache.h"
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+size_t countOccurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+CHTL_TEST(ExpansionCache, FingerprintIgnoresOrder) {
+    std::unordered_map<std::string, std::string> first{{"color", "red"}, {"width", "10px"}};
+    std::unordered_map<std::string, std::string> second;
+    second["width"] = "10px";
+    second["color"] = "red";
+    std::unordered_map<std::string, std::string> other{{"color", "blue"}, {"width", "10px"}};
+
+    assertTrue(ExpansionCache::fingerprint({}) == 0);
+    assertTrue(ExpansionCache::fingerprint(first) == ExpansionCache::fingerprint(second));
+    assertTrue(ExpansionCache::fingerprint(first) != ExpansionCache::fingerprint(other));
+    assertTrue(ExpansionCache::fingerprint(first) != 0);
+}
+
+CHTL_TEST(ExpansionCache, StyleInheritAndDelete) {
+    auto result = compileSource(
+        "[Template] @Style Base { color: red; width: 10px; }\n"
+        "[Custom] @Style Card { @Style Base; delete width; height: 20px; }\n"
+        "div { style { @Style Card; } }\n"
+        "span { style { @Style Card; } }\n");
+
+    assertTrue(result.parseErrors.empty());
+    assertTrue(countOccurrences(result.html, "color: red; height: 20px;") == 2);
+    assertNotContains(result.html, "width");
+    // 第二次使用命中缓存
+    assertTrue(result.cacheHits >= 1);
+}
+
+CHTL_TEST(ExpansionCache, ElementReuseMatchesFirstExpansion) {
+    auto result = compileSource(
+        "[Template] @Element Item { li { text { \"entry\" } } }\n"
+        "ul {\n"
+        "    @Element Item;\n"
+        "    @Element Item;\n"
+        "    @Element Item;\n"
+        "}\n");
+
+    assertTrue(result.parseErrors.empty());
+    assertTrue(countOccurrences(result.html, "<li>") == 3);
+    assertTrue(countOccurrences(result.html, "entry") == 3);
+    assertTrue(result.cacheMisses == 1);
+    assertTrue(result.cacheHits == 2);
+
+    // 缓存的输出与逐个展开的结果一致
+    auto single = compileSource(
+        "[Template] @Element Item { li { text { \"entry\" } } }\n"
+        "ul { @Element Item; }\n");
+    size_t start = single.html.find("<li>");
+    size_t end = single.html.find("</li>");
+    assertTrue(start != std::string::npos && end != std::string::npos);
+    std::string item = single.html.substr(start, end - start);
+    assertTrue(countOccurrences(result.html, item) == 3);
+}
+
+CHTL_TEST(ExpansionCache, RedefinitionInvalidates) {
+    auto result = compileSource(
+        "[Template] @Style Theme { color: red; }\n"
+        "div { style { @Style Theme; } }\n"
+        "[Template] @Style Theme { color: blue; }\n"
+        "p { style { @Style Theme; } }\n");
+
+    assertTrue(result.parseErrors.empty());
+    assertContains(result.html, "color: red;");
+    assertContains(result.html, "color: blue;");
+    assertTrue(result.cacheHits == 0);
+}
+
+CHTL_TEST_SUITE(ExpansionCache) {
+    CHTL_ADD_TEST(ExpansionCache, FingerprintIgnoresOrder);
+    CHTL_ADD_TEST(ExpansionCache, StyleInheritAndDelete);
+    CHTL_ADD_TEST(ExpansionCache, ElementReuseMatchesFirstExpansion);
+    CHTL_ADD_TEST(ExpansionCache, RedefinitionInvalidates);
+}
@@ -0,0 +1,145 @@
+#include "../CHTLTestSuite.h"
+#include "../../CHTL/CHTLGenerator/OutputRope.h"
+#include <random>
+#include <sstream>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+std::string flatten(const OutputRope& rope) {
+    std::string result;
+    StringOutputSink sink(result);
+    rope.writeTo(sink);
+    return result;
+}
+
+// 随机长度的片段，部分长于块大小
+std::vector<std::string> makePieces(size_t count, size_t maxLength, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::string> pieces;
+    for (size_t i = 0; i < count; ++i) {
+        size_t length = rng() % (maxLength + 1);
+        std::string piece;
+        for (size_t j = 0; j < length; ++j) {
+            piece += static_cast<char>('a' + rng() % 26);
+        }
+        pieces.push_back(piece);
+    }
+    return pieces;
+}
+
+} // namespace
+
+CHTL_TEST(OutputRope, AppendMatchesString) {
+    for (size_t chunkSize : {1, 3, 16, 100, 64 * 1024}) {
+        OutputRope rope(chunkSize);
+        std::string expected;
+        for (const auto& piece : makePieces(200, 40, static_cast<unsigned>(chunkSize))) {
+            rope.append(piece);
+            expected += piece;
+        }
+        rope.append("");
+
+        assertTrue(rope.size() == expected.size());
+        assertTrue(rope.totalSize() == expected.size());
+        assertEqual(flatten(rope), expected);
+    }
+}
+
+CHTL_TEST(OutputRope, ConcatenationAcrossChunks) {
+    // 单次追加跨越多个块，块边界落在片段中间
+    OutputRope rope(8);
+    std::string expected;
+    std::string large(1000, 'x');
+    for (size_t i = 0; i < large.size(); ++i) {
+        large[i] = static_cast<char>('0' + i % 10);
+    }
+    for (const std::string& piece : {std::string("<html>"), large, std::string("</html>"), std::string("!")}) {
+        rope.append(piece);
+        expected += piece;
+    }
+    assertEqual(flatten(rope), expected);
+
+    // 写入流与写入字符串结果相同
+    std::ostringstream stream;
+    StreamOutputSink sink(stream);
+    rope.writeTo(sink);
+    assertEqual(stream.str(), expected);
+
+    rope.clear();
+    assertTrue(rope.size() == 0);
+    assertEqual(flatten(rope), "");
+    rope.append("again");
+    assertEqual(flatten(rope), "again");
+}
+
+CHTL_TEST(OutputRope, SlotsFlattenInPlace) {
+    for (size_t chunkSize : {1, 4, 5, 64 * 1024}) {
+        OutputRope rope(chunkSize);
+        size_t head = rope.addSlot();
+        size_t unused = rope.addSlot();
+        rope.placeSlot(head);
+        rope.append("<head>");
+        size_t style = rope.addSlot();
+        rope.placeSlot(style);
+        rope.append("</head><body>");
+        size_t middle = rope.addSlot();
+        size_t sameOffset = rope.addSlot();
+        rope.placeSlotAt(middle, 3);
+        rope.placeSlotAt(sameOffset, 3);
+        rope.append("</body>");
+        size_t tail = rope.addSlot();
+        rope.placeSlot(tail);
+
+        // 插槽在正文写完之后才填充
+        rope.slotContent(head) = "H";
+        rope.slotContent(unused) = "never";
+        rope.slotContent(style) = "<style>a{}</style>";
+        rope.slotContent(middle) = "[1]";
+        rope.slotContent(sameOffset) = "[2]";
+        rope.slotContent(tail) = "T";
+
+        // 按偏移从后往前插入，位置相同时先注册的在前
+        std::string expected = "<head></head><body></body>";
+        expected.insert(expected.size(), "T");
+        expected.insert(6, "<style>a{}</style>");
+        expected.insert(3, "[1][2]");
+        expected.insert(0, "H");
+
+        assertTrue(rope.slotOffset(unused) == OutputRope::npos);
+        assertEqual(flatten(rope), expected);
+        assertTrue(rope.totalSize() == expected.size());
+    }
+}
+
+CHTL_TEST(OutputRope, SlotBeforeMarker) {
+    // marker被拆在多次append之间，且只匹配注册之后写入的文本
+    OutputRope rope(4);
+    rope.append("<body></body>");
+    size_t scripts = rope.addSlot();
+    rope.placeSlotBefore(scripts, "</body>");
+    rope.append("<div></div></bo");
+    rope.append("d");
+    rope.append("y></html>");
+    rope.slotContent(scripts) = "<script></script>";
+
+    assertTrue(rope.slotOffset(scripts) == std::string("<body></body><div></div>").size());
+    assertEqual(flatten(rope), "<body></body><div></div><script></script></body></html>");
+
+    // 没有出现marker的插槽不写出
+    OutputRope missing;
+    size_t slot = missing.addSlot();
+    missing.placeSlotBefore(slot, "</body>");
+    missing.append("<div></div>");
+    missing.slotContent(slot) = "lost";
+    assertEqual(flatten(missing), "<div></div>");
+}
+
+CHTL_TEST_SUITE(OutputRope) {
+    CHTL_ADD_TEST(OutputRope, AppendMatchesString);
+    CHTL_ADD_TEST(OutputRope, ConcatenationAcrossChunks);
+    CHTL_ADD_TEST(OutputRope, SlotsFlattenInPlace);
+    CHTL_ADD_TEST(OutputRope, SlotBeforeMarker);
+}
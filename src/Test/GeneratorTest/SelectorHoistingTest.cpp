@@ -0,0 +1,156 @@
+#include "../CHTLTestSuite.h"
+#include "../ASTTestUtil/ASTBuilder.h"
+#include "../../CHTLJS/CHTLJSGenerator/Generator.h"
+
+using namespace CHTLJS;
+using namespace CHTL::Test;
+
+namespace {
+
+using Type = EnhancedSelectorNode::SelectorType;
+
+std::string generate(const std::shared_ptr<ProgramNode>& root, bool hoist = true) {
+    GeneratorConfig config;
+    config.wrapInIIFE = false;
+    config.hoistSelectors = hoist;
+    Generator generator(std::make_shared<CompileContext>("test.cjjs"), config);
+    return generator.generate(root);
+}
+
+// 截取句柄对象的定义
+std::string handleBlock(const std::string& output) {
+    size_t begin = output.find("// CHTL JS Selector Handles");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    size_t end = output.find("})();\n", begin);
+    return output.substr(begin, end + 6 - begin);
+}
+
+// 程序体（辅助代码之后）
+std::string body(const std::string& output) {
+    size_t begin = output.find("var CHTLVirtualObjects = {};\n\n");
+    return output.substr(begin + 30);
+}
+
+size_t countOccurrences(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t pos = text.find(needle); pos != std::string::npos; pos = text.find(needle, pos + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+CHTL_TEST(SelectorHoisting, SharedHandlesWithoutMutation) {
+    // 同一选择器在多处引用只查询一次；带索引的引用共用动态集合句柄
+    auto output = generate(program({
+        member(selector(".box", Type::CLASS), "length"),
+        call(member(selector(".box", Type::CLASS, 0), "focus")),
+        member(selector("#main", Type::ID), "scrollTop"),
+        member(selector("#main", Type::ID), "clientHeight"),
+    }));
+
+    assertEqual(
+        "// CHTL JS Selector Handles\n"
+        "var CHTLSelectorHandles = (function() {\n"
+        "  function live(lookup) {\n"
+        "    var value;\n"
+        "    return function() {\n"
+        "      return value || (value = lookup());\n"
+        "    };\n"
+        "  }\n"
+        "  \n"
+        "  function stale(value) {\n"
+        "    if (!value) return true;\n"
+        "    if (value.nodeType) return !value.isConnected;\n"
+        "    if (!value.length) return true;\n"
+        "    for (var i = 0; i < value.length; i++) {\n"
+        "      if (!value[i].isConnected) return true;\n"
+        "    }\n"
+        "    return false;\n"
+        "  }\n"
+        "  \n"
+        "  function snapshot(lookup) {\n"
+        "    var value;\n"
+        "    var cached = false;\n"
+        "    return function() {\n"
+        "      if (!cached || stale(value)) {\n"
+        "        value = lookup();\n"
+        "        cached = document.readyState !== 'loading';\n"
+        "      }\n"
+        "      return value;\n"
+        "    };\n"
+        "  }\n"
+        "  \n"
+        "  return {\n"
+        "    h0: live(function() { return CHTLSelector.byClass('.box'); }),\n"
+        "    h1: snapshot(function() { return CHTLSelector.byId('#main'); })\n"
+        "  };\n"
+        "})();\n",
+        handleBlock(output));
+    assertEqual(
+        "CHTLSelectorHandles.h0().length;\n"
+        "CHTLSelectorHandles.h0()[0].focus();\n"
+        "CHTLSelectorHandles.h1().scrollTop;\n"
+        "CHTLSelectorHandles.h1().clientHeight;\n",
+        body(output));
+    assertFalse(output.find("MutationObserver") != std::string::npos);
+}
+
+CHTL_TEST(SelectorHoisting, MutatingPageTracksSnapshots) {
+    // 页面代码修改DOM：快照句柄由MutationObserver失效，只观察相关属性
+    auto output = generate(program({
+        call(member(selector("#list", Type::ID), "appendChild"), {std::make_shared<IdentifierNode>("row", TokenLocation())}),
+        member(selector(".row", Type::CLASS), "length"),
+        member(selector("ul li", Type::COMPOUND), "length"),
+    }));
+
+    std::string handles = handleBlock(output);
+    assertTrue(handles.find("observer.observe(document, {childList: true, subtree: true, attributes: true, "
+                            "attributeFilter: ['id', 'class']});") != std::string::npos);
+    assertTrue(handles.find("if (observer.takeRecords().length) generation++;") != std::string::npos);
+    assertTrue(handles.find("h0: snapshot(function() { return CHTLSelector.byId('#list'); }),") != std::string::npos);
+    assertTrue(handles.find("h1: live(function() { return CHTLSelector.byClass('.row'); }),") != std::string::npos);
+    assertTrue(handles.find("h2: snapshot(function() { return CHTLSelector.query('ul li'); })\n") != std::string::npos);
+    assertEqual(
+        "CHTLSelectorHandles.h0().appendChild(row);\n"
+        "CHTLSelectorHandles.h1().length;\n"
+        "CHTLSelectorHandles.h2().length;\n",
+        body(output));
+
+    // 属性选择器可能依赖任意属性
+    output = generate(program({
+        call(member(selector("input[name]", Type::COMPOUND), "item"), {}),
+        call(member(std::make_shared<IdentifierNode>("form", TokenLocation()), "setAttribute"), {}),
+    }));
+    assertTrue(handleBlock(output).find("observer.observe(document, {childList: true, subtree: true, attributes: true});")
+               != std::string::npos);
+}
+
+CHTL_TEST(SelectorHoisting, DynamicSelectorsAreNotHoisted) {
+    // & 引用和含伪类的复合选择器每次求值
+    auto output = generate(program({
+        member(selector("&", Type::REFERENCE), "value"),
+        member(selector("input:checked", Type::COMPOUND), "length"),
+        member(selector("input:checked", Type::COMPOUND), "length"),
+    }));
+    assertEqual("", handleBlock(output));
+    assertTrue(countOccurrences(output, "CHTLSelector.query('input:checked')") == 2);
+    assertTrue(body(output).find("CHTLSelector.current().value;") != std::string::npos);
+
+    // 关闭提升时保持逐次查询
+    output = generate(program({
+        member(selector(".box", Type::CLASS), "length"),
+        member(selector(".box", Type::CLASS), "length"),
+    }), false);
+    assertEqual("", handleBlock(output));
+    assertTrue(countOccurrences(body(output), "CHTLSelector.byClass('.box').length;") == 2);
+}
+
+CHTL_TEST_SUITE(SelectorHoisting) {
+    CHTL_ADD_TEST(SelectorHoisting, SharedHandlesWithoutMutation);
+    CHTL_ADD_TEST(SelectorHoisting, MutatingPageTracksSnapshots);
+    CHTL_ADD_TEST(SelectorHoisting, DynamicSelectorsAreNotHoisted);
+}
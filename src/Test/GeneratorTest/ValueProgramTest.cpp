@@ -0,0 +1,73 @@
+#include "../CHTLTestSuite.h"
+#include "../CompileTestUtil/CompileSource.h"
+#include "../../CHTL/CHTLNode/ValueProgram.h"
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+CHTL_TEST(ValueProgram, CompilesReferences) {
+    std::string value = "1px solid ThemeColor(tableColor) @accent";
+    ValueProgram program(value);
+    const auto& references = program.getReferences();
+    assertTrue(references.size() == 2);
+
+    auto& interner = SymbolInterner::getInstance();
+    assertTrue(references[0].kind == ValueReference::Kind::GROUP_VARIABLE);
+    assertEqual("ThemeColor(tableColor)", value.substr(references[0].offset, references[0].length));
+    assertEqual("ThemeColor", std::string(interner.name(references[0].group)));
+    assertEqual("tableColor", std::string(interner.name(references[0].variable)));
+    assertTrue(references[1].kind == ValueReference::Kind::VARIABLE);
+    assertEqual("accent", std::string(interner.name(references[1].variable)));
+
+    // 普通CSS函数和数值参数不是引用
+    assertTrue(ValueProgram("rgb(255, 0, 0)").empty());
+    assertTrue(ValueProgram("calc(100% - var(--gap))").empty());
+    assertTrue(ValueProgram("translate(10px)").empty());
+    assertTrue(ValueProgram("10px 20px").empty());
+}
+
+CHTL_TEST(ValueProgram, RendersSegments) {
+    std::string value = "a Group(x) b Group(missing) c";
+    ValueProgram program(value);
+    std::string out;
+    program.render(value, out, [](const ValueReference& reference, std::string& target) {
+        if (SymbolInterner::getInstance().name(reference.variable) != "x") {
+            return false;
+        }
+        target += "red";
+        return true;
+    });
+    // 未解析的引用原样输出
+    assertEqual("a red b Group(missing) c", out);
+}
+
+CHTL_TEST(ValueProgram, VarGroupSubstitution) {
+    auto result = compileSource(
+        "[Template] @Var ThemeColor {\n"
+        "    tableColor: rgb(255, 192, 203);\n"
+        "    textColor: black;\n"
+        "}\n"
+        "[Custom] @Var Spacing { small: 4px; }\n"
+        "[Template] @Style Card { color: ThemeColor(textColor); }\n"
+        "div {\n"
+        "    style {\n"
+        "        background-color: ThemeColor(tableColor);\n"
+        "        padding: Spacing(small);\n"
+        "        border-color: ThemeColor(missing);\n"
+        "        @Style Card;\n"
+        "    }\n"
+        "}\n");
+    const std::string& html = result.html;
+
+    assertTrue(result.parseErrors.empty());
+    assertContains(html, "background-color: rgb(255,192,203);");
+    assertContains(html, "padding: 4px;");
+    assertContains(html, "color: black;");
+    assertContains(html, "border-color: ThemeColor(missing);");
+}
+
+CHTL_TEST_SUITE(ValueProgram) {
+    CHTL_ADD_TEST(ValueProgram, CompilesReferences);
+    CHTL_ADD_TEST(ValueProgram, RendersSegments);
+    CHTL_ADD_TEST(ValueProgram, VarGroupSubstitution);
+}
@@ -0,0 +1,88 @@
+#include "../CHTLTestSuite.h"
+#include "../../CHTL/CHTLLexer/Lexer.h"
+#include "../../CHTL/CHTLLexer/TokenArena.h"
+#include "../../CHTL/CHTLContext/Context.h"
+#include <type_traits>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+// 源码可能位于ownedSource_的内联缓冲区，移动会让source_和已交出的TokenView悬空
+static_assert(!std::is_copy_constructible<Lexer>::value, "Lexer must not be copyable");
+static_assert(!std::is_move_constructible<Lexer>::value, "Lexer must not be movable");
+static_assert(!std::is_move_assignable<Lexer>::value, "Lexer must not be move-assignable");
+
+namespace {
+
+std::vector<std::string> lexemes(const std::vector<const TokenView*>& tokens) {
+    std::vector<std::string> result;
+    for (const TokenView* token : tokens) {
+        if (token->type != TokenType::EOF_TOKEN) {
+            result.push_back(std::string(token->lexeme));
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+CHTL_TEST(TokenView, BorrowedSourceIsSliced) {
+    std::string source = "div { text { \"a\\\"b\" } }";
+    TokenArena arena;
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    Lexer lexer(std::string_view(source), arena, context);
+
+    auto tokens = lexer.tokenizeAllViews();
+    assertTrue(tokens.back()->type == TokenType::EOF_TOKEN);
+    assertTrue(tokens[0]->type == TokenType::HTML_TAG);
+
+    // 普通词素直接切片借用的缓冲区，不复制
+    const char* begin = source.data();
+    const char* end = source.data() + source.size();
+    assertTrue(tokens[0]->lexeme.data() >= begin && tokens[0]->lexeme.data() < end);
+    assertEqual(std::string(tokens[0]->lexeme), "div");
+
+    // 转义后的字符串保存在arena中
+    const TokenView* literal = nullptr;
+    for (const TokenView* token : tokens) {
+        if (token->type == TokenType::STRING_LITERAL) {
+            literal = token;
+        }
+    }
+    assertTrue(literal != nullptr);
+    assertEqual(std::string(literal->lexeme), "a\"b");
+    assertTrue(literal->lexeme.data() < begin || literal->lexeme.data() >= end);
+}
+
+CHTL_TEST(TokenView, OwnedShortSourceStaysValid) {
+    // 短源码落在std::string的内联缓冲区里，Lexer通过智能指针共享而不是移动
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    auto lexer = std::make_unique<Lexer>(std::string("p { }"), context);
+    auto tokens = lexer->tokenizeAllViews();
+
+    assertTrue(lexemes(tokens) == (std::vector<std::string>{"p", "{", "}"}));
+    assertTrue(tokens.back()->type == TokenType::EOF_TOKEN);
+}
+
+CHTL_TEST(TokenView, PeekDoesNotConsume) {
+    std::string source = "span { }";
+    TokenArena arena;
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    Lexer lexer(std::string_view(source), arena, context);
+
+    const TokenView* second = lexer.peekTokenView(1);
+    assertEqual(std::string(second->lexeme), "{");
+    assertTrue(lexer.peekTokenViews(3).size() == 3);
+
+    const TokenView* first = lexer.nextTokenView();
+    assertEqual(std::string(first->lexeme), "span");
+    assertTrue(lexer.nextTokenView() == second);
+    assertEqual(std::string(lexer.nextTokenView()->lexeme), "}");
+    assertTrue(lexer.nextTokenView()->type == TokenType::EOF_TOKEN);
+}
+
+CHTL_TEST_SUITE(TokenView) {
+    CHTL_ADD_TEST(TokenView, BorrowedSourceIsSliced);
+    CHTL_ADD_TEST(TokenView, OwnedShortSourceStaysValid);
+    CHTL_ADD_TEST(TokenView, PeekDoesNotConsume);
+}
@@ -0,0 +1,287 @@
+#include "../CHTLTestSuite.h"
+#include "../../CHTL/CHTLParser/IncrementalParser.h"
+#include "../../CHTL/CHTLGenerator/Generator.h"
+#include "../../CHTL/CHTLLexer/Lexer.h"
+#include "../../CHTL/CHTLLexer/TokenArena.h"
+#include "../../CHTL/CHTLContext/Context.h"
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+const char* PAGE =
+    "[Template] @Style Card {\n"
+    "    padding: 8px;\n"
+    "    color: black;\n"
+    "}\n"
+    "\n"
+    "html {\n"
+    "    head { title { text { \"Demo\" } } }\n"
+    "    body {\n"
+    "        div {\n"
+    "            id: \"header\";\n"
+    "            class: \"top\";\n"
+    "            style { .top { margin: 0; } }\n"
+    "            span { text { \"Hello\" } }\n"
+    "        }\n"
+    "        div {\n"
+    "            id: \"content\";\n"
+    "            p { text { \"first\" } }\n"
+    "            p { text { \"second\" } }\n"
+    "            script { console.log(\"ready\"); }\n"
+    "        }\n"
+    "        div { id: \"footer\"; text { \"end\" } }\n"
+    "    }\n"
+    "}\n"
+    "\n"
+    "style { body { margin: 0; } }\n";
+
+// 节点类型、内容、位置和子树的完整转储
+void dump(const ASTNode& node, std::ostringstream& out, size_t depth) {
+    const auto& location = node.getLocation();
+    out << std::string(depth * 2, ' ') << node.toString() << " @" << location.line << ":"
+        << location.column << "+" << location.offset << "\n";
+    for (const auto& child : node.getChildren()) {
+        if (child) {
+            dump(*child, out, depth + 1);
+        }
+    }
+}
+
+std::string dumpTokens(const std::vector<std::shared_ptr<Token>>& tokens) {
+    std::ostringstream out;
+    for (const auto& token : tokens) {
+        const auto& location = token->getLocation();
+        out << static_cast<int>(token->getType()) << " '" << token->getLexeme() << "' "
+            << location.line << ":" << location.column << "+" << location.offset << "\n";
+    }
+    return out.str();
+}
+
+std::string describe(const std::shared_ptr<ProgramNode>& program, const std::vector<std::string>& errors,
+                     const std::shared_ptr<CompileContext>& context) {
+    std::ostringstream out;
+    dump(*program, out, 0);
+    for (const auto& error : errors) {
+        out << "error: " << error << "\n";
+    }
+    Generator generator(context);
+    out << generator.generate(program);
+    return out.str();
+}
+
+// 完整解析的参考结果
+struct Reference {
+    std::string description;
+    std::string tokens;
+};
+
+Reference parseFully(const std::string& source) {
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    IncrementalParser parser(context);
+    auto program = parser.parse(source);
+    return {describe(program, parser.getErrors(), context), dumpTokens(parser.getTokens())};
+}
+
+// Parser对部分畸形输入直接抛出状态异常（不作为语法错误记录）
+bool parserAccepts(const std::string& source) {
+    try {
+        parseFully(source);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// 以全量解析为准检查增量结果
+bool matchesFullParse(IncrementalParser& parser, const std::shared_ptr<CompileContext>& context) {
+    Reference expected = parseFully(parser.getSource());
+    return describe(parser.getProgram(), parser.getErrors(), context) == expected.description &&
+           dumpTokens(parser.getTokens()) == expected.tokens;
+}
+
+// 在第一次出现anchor的位置之后插入text
+TextEdit insertAfter(const std::string& source, const std::string& anchor, const std::string& text) {
+    size_t position = source.find(anchor);
+    return {position + anchor.size(), 0, text};
+}
+
+TextEdit replaceFirst(const std::string& source, const std::string& target, const std::string& text) {
+    return {source.find(target), target.size(), text};
+}
+
+} // namespace
+
+CHTL_TEST(IncrementalParser, FullParseMatchesParser) {
+    std::string source = PAGE;
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    TokenArena arena;
+    auto lexer = std::make_shared<Lexer>(std::string_view(source), arena, context);
+    Parser parser(lexer, context);
+    auto program = parser.parse();
+
+    auto sessionContext = std::make_shared<CompileContext>("test.chtl");
+    IncrementalParser session(sessionContext);
+    auto sessionProgram = session.parse(source);
+    assertEqual(describe(program, parser.getErrors(), context),
+                describe(sessionProgram, session.getErrors(), sessionContext));
+    assertTrue(session.getErrors().empty());
+}
+
+CHTL_TEST(IncrementalParser, EditsMatchFullReparse) {
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    IncrementalParser parser(context);
+    parser.parse(PAGE);
+
+    // 每次编辑都局限在一个块内
+    std::vector<std::pair<std::string, std::string>> edits = {
+        {"text { \"first\" }", "text { \"first paragraph\" }"},
+        {"class: \"top\";", "class: \"top wide\";\n            name: \"main\";"},
+        {"margin: 0; } }\n            span", "margin: 0; padding: 4px; } }\n            span"},
+        {"console.log(\"ready\");", "console.log(\"ready\");\n            console.log(\"again\");"},
+        {"color: black;", "color: red;\n    border: 1px;"},
+        {"p { text { \"second\" } }", "p { text { \"second\" } }\n            em { text { \"third\" } }"},
+        {"id: \"footer\";", "id: \"bottom\";"},
+    };
+    for (const auto& [target, replacement] : edits) {
+        parser.applyEdit(replaceFirst(parser.getSource(), target, replacement));
+        assertTrue(parser.getLastStats().incremental);
+        assertTrue(parser.getLastStats().reparsedBytes < parser.getSource().size() / 2);
+        assertTrue(matchesFullParse(parser, context));
+    }
+
+    // 删除内容
+    parser.applyEdit(replaceFirst(parser.getSource(), "\n            em { text { \"third\" } }", ""));
+    assertTrue(parser.getLastStats().incremental);
+    assertTrue(matchesFullParse(parser, context));
+}
+
+CHTL_TEST(IncrementalParser, ReusesUnchangedSubtrees) {
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    IncrementalParser parser(context);
+    auto program = parser.parse(PAGE);
+
+    auto html = std::static_pointer_cast<ElementNode>(program->getTopLevelNodes()[1]);
+    auto head = html->getChildNodes()[0];
+    auto body = std::static_pointer_cast<ElementNode>(html->getChildNodes()[1]);
+    auto header = body->getChildNodes()[0];
+    auto content = body->getChildNodes()[1];
+    auto footer = body->getChildNodes()[2];
+    auto templateNode = program->getTopLevelNodes()[0];
+    auto globalStyle = program->getTopLevelNodes()[2];
+
+    // 只重解析content中的第一个p
+    auto updated = parser.applyEdit(insertAfter(parser.getSource(), "\"first", " and only"));
+    assertTrue(updated == program);
+    assertTrue(parser.getLastStats().incremental);
+    assertTrue(program->getTopLevelNodes()[0] == templateNode);
+    assertTrue(program->getTopLevelNodes()[1] == html);
+    assertTrue(program->getTopLevelNodes()[2] == globalStyle);
+    assertTrue(html->getChildNodes()[0] == head);
+    assertTrue(body->getChildNodes()[0] == header);
+    assertTrue(body->getChildNodes()[1] == content);
+    assertTrue(body->getChildNodes()[2] == footer);
+
+    auto contentElement = std::static_pointer_cast<ElementNode>(content);
+    auto secondParagraph = contentElement->getChildNodes()[1];
+    assertTrue(contentElement->getChildNodes()[0] != nullptr);
+    assertEqual("p", std::static_pointer_cast<ElementNode>(contentElement->getChildNodes()[0])->getTagName());
+
+    // 编辑点之后复用的节点位置已平移，换行使行号加一
+    size_t lineBefore = footer->getLocation().line;
+    parser.applyEdit(insertAfter(parser.getSource(), "and only\"", "\n"));
+    assertTrue(parser.getLastStats().incremental);
+    assertTrue(contentElement->getChildNodes()[1] == secondParagraph);
+    assertTrue(footer->getLocation().line == lineBefore + 1);
+    assertTrue(matchesFullParse(parser, context));
+}
+
+CHTL_TEST(IncrementalParser, StructuralEditsFallBack) {
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    IncrementalParser parser(context);
+    parser.parse(PAGE);
+
+    // 编辑触及块头：标签名所在的块无法局部重解析，由外层块处理
+    parser.applyEdit(replaceFirst(parser.getSource(), "span {", "strong {"));
+    assertTrue(parser.getLastStats().incremental);
+    assertTrue(matchesFullParse(parser, context));
+
+    // 插入右花括号改变块边界，退化为完整解析
+    parser.applyEdit(insertAfter(parser.getSource(), "id: \"content\";", " }"));
+    assertFalse(parser.getLastStats().incremental);
+    assertTrue(matchesFullParse(parser, context));
+
+    // 顶层之间的编辑
+    parser.applyEdit(insertAfter(parser.getSource(), "}\n\nstyle", "\n"));
+    assertTrue(matchesFullParse(parser, context));
+}
+
+CHTL_TEST(IncrementalParser, ErrorsInsideBlockAreReplaced) {
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    IncrementalParser parser(context);
+    parser.parse(PAGE);
+
+    // 块内引入错误，再在同一块内修复
+    parser.applyEdit(replaceFirst(parser.getSource(), "id: \"footer\";", "id: \"footer\"; ;"));
+    assertTrue(parser.getLastStats().incremental);
+    assertFalse(parser.getErrors().empty());
+    assertTrue(matchesFullParse(parser, context));
+
+    parser.applyEdit(replaceFirst(parser.getSource(), "id: \"footer\"; ;", "id: \"footer\";"));
+    assertTrue(parser.getLastStats().incremental);
+    assertTrue(parser.getErrors().empty());
+    assertTrue(matchesFullParse(parser, context));
+}
+
+CHTL_TEST(IncrementalParser, RandomEditsMatchFullReparse) {
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    IncrementalParser parser(context);
+    parser.parse(PAGE);
+
+    // 固定种子的随机编辑，每次编辑后再撤销；无论走增量还是退化路径，
+    // 结果都要与完整解析一致
+    const char* fragments[] = {" ", "\n", "x", "1", ";", "\"", "{", "}", ": a;", "p { }"};
+    unsigned seed = 12345;
+    auto next = [&seed](size_t bound) {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<size_t>((seed >> 16) % bound);
+    };
+    size_t incremental = 0;
+    for (int i = 0; i < 200; ++i) {
+        const std::string source = parser.getSource();
+        TextEdit edit{next(source.size()), 0, fragments[next(std::size(fragments))]};
+        if (next(3) == 0) {
+            edit.length = std::min(next(4) + 1, source.size() - edit.offset);
+            edit.text.clear();
+        }
+        std::string edited = source;
+        edited.replace(edit.offset, edit.length, edit.text);
+        if (!parserAccepts(edited)) {
+            continue;
+        }
+        std::string removed = source.substr(edit.offset, edit.length);
+
+        parser.applyEdit(edit);
+        incremental += parser.getLastStats().incremental ? 1 : 0;
+        assertTrue(matchesFullParse(parser, context));
+
+        parser.applyEdit({edit.offset, edit.text.size(), removed});
+        incremental += parser.getLastStats().incremental ? 1 : 0;
+        assertTrue(matchesFullParse(parser, context));
+        assertEqual(source, parser.getSource());
+    }
+    assertTrue(incremental > 100);
+}
+
+CHTL_TEST_SUITE(IncrementalParser) {
+    CHTL_ADD_TEST(IncrementalParser, FullParseMatchesParser);
+    CHTL_ADD_TEST(IncrementalParser, EditsMatchFullReparse);
+    CHTL_ADD_TEST(IncrementalParser, ReusesUnchangedSubtrees);
+    CHTL_ADD_TEST(IncrementalParser, StructuralEditsFallBack);
+    CHTL_ADD_TEST(IncrementalParser, ErrorsInsideBlockAreReplaced);
+    CHTL_ADD_TEST(IncrementalParser, RandomEditsMatchFullReparse);
+}
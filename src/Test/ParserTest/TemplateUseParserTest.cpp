@@ -0,0 +1,173 @@
+#include "../CHTLTestSuite.h"
+#include "../../CHTL/CHTLGenerator/Generator.h"
+#include "../../CHTL/CHTLLexer/Lexer.h"
+#include "../../CHTL/CHTLLexer/TokenArena.h"
+#include "../../CHTL/CHTLNode/TemplateNode.h"
+#include "../../CHTL/CHTLParser/Parser.h"
+#include "../../CHTL/CHTLContext/Context.h"
+#include <functional>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+const char* PAGE =
+    "[Template] @Style Card {\n"
+    "    padding: 8px;\n"
+    "    color: black;\n"
+    "    margin: 4px;\n"
+    "}\n"
+    "\n"
+    "html {\n"
+    "    body {\n"
+    "        div {\n"
+    "            style {\n"
+    "                @Style Card {\n"
+    "                    color: red;\n"
+    "                    delete margin;\n"
+    "                }\n"
+    "            }\n"
+    "            span { text { \"inside\" } }\n"
+    "        }\n"
+    "        p { text { \"after\" } }\n"
+    "    }\n"
+    "}\n";
+
+// 深度优先查找第一个满足条件的节点
+std::shared_ptr<ASTNode> findNode(const std::shared_ptr<ASTNode>& node,
+                                  const std::function<bool(const ASTNode&)>& predicate) {
+    if (!node) {
+        return nullptr;
+    }
+    if (predicate(*node)) {
+        return node;
+    }
+    for (const auto& child : node->getChildren()) {
+        if (auto found = findNode(child, predicate)) {
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<ASTNode> findElement(const std::shared_ptr<ASTNode>& root, const std::string& tag) {
+    return findNode(root, [&tag](const ASTNode& node) {
+        auto* element = dynamic_cast<const ElementNode*>(&node);
+        return element && element->getTagName() == tag;
+    });
+}
+
+std::vector<std::string> childTags(const std::shared_ptr<ASTNode>& element) {
+    std::vector<std::string> tags;
+    for (const auto& child : element->getChildren()) {
+        if (auto* node = dynamic_cast<const ElementNode*>(child.get())) {
+            tags.push_back(node->getTagName());
+        }
+    }
+    return tags;
+}
+
+} // namespace
+
+CHTL_TEST(TemplateUseParser, SpecializationBlockKeepsNesting) {
+    std::string source = PAGE;
+    TokenArena tokens;
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    auto lexer = std::make_shared<Lexer>(std::string_view(source), tokens, context);
+    Parser parser(lexer, context);
+    auto program = parser.parse();
+
+    assertTrue(program != nullptr);
+    assertTrue(parser.getErrors().empty());
+
+    // 特例化块的 } 不能提前关闭div：span仍是div的子元素，p是body的子元素
+    auto div = findElement(program, "div");
+    auto body = findElement(program, "body");
+    assertTrue(div != nullptr);
+    assertTrue(body != nullptr);
+    assertTrue(childTags(div) == std::vector<std::string>{"span"});
+    assertTrue(childTags(body) == (std::vector<std::string>{"div", "p"}));
+
+    auto use = std::dynamic_pointer_cast<TemplateUseNode>(findNode(div, [](const ASTNode& node) {
+        return dynamic_cast<const TemplateUseNode*>(&node) != nullptr;
+    }));
+    assertTrue(use != nullptr);
+    assertEqual(use->getName(), "Card");
+    const auto& specializations = use->getSpecializations();
+    assertTrue(specializations.size() == 2);
+    assertTrue(specializations.count("color") && specializations.at("color") == "red");
+    assertTrue(specializations.count("margin") && specializations.at("margin").empty());
+
+    Generator generator(context);
+    std::string html = generator.generate(program);
+    assertContains(html, "padding: 8px; color: red;");
+    assertNotContains(html, "margin: 4px");
+    assertNotContains(html, "color: black");
+}
+
+CHTL_TEST(TemplateUseParser, DeleteStyleGroupInSpecialization) {
+    std::string source =
+        "[Template] @Style Base { border: 1px; outline: none; }\n"
+        "[Template] @Style Card { @Style Base; padding: 8px; }\n"
+        "div { style { @Style Card { delete @Style Base; } } }\n";
+    TokenArena tokens;
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    auto lexer = std::make_shared<Lexer>(std::string_view(source), tokens, context);
+    Parser parser(lexer, context);
+    auto program = parser.parse();
+
+    assertTrue(parser.getErrors().empty());
+    Generator generator(context);
+    std::string html = generator.generate(program);
+    assertContains(html, "padding: 8px;");
+    assertNotContains(html, "border");
+    assertNotContains(html, "outline");
+}
+
+CHTL_TEST(TemplateUseParser, ElementSpecializationIsReported) {
+    std::string source =
+        "[Template] @Element Box { div { text { \"box\" } } }\n"
+        "body {\n"
+        "    @Element Box {\n"
+        "        div { style { color: red; } }\n"
+        "    }\n"
+        "    footer { text { \"end\" } }\n"
+        "}\n";
+    TokenArena tokens;
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    auto lexer = std::make_shared<Lexer>(std::string_view(source), tokens, context);
+    Parser parser(lexer, context);
+    auto program = parser.parse();
+
+    // 元素模板的特例化尚未实现，必须报错而不是静默丢弃；外层结构仍正常解析
+    assertTrue(parser.getErrors().size() == 1);
+    assertContains(parser.getErrors().front(), "Unsupported specialization of @Element Box");
+    auto body = findElement(program, "body");
+    assertTrue(body != nullptr);
+    assertTrue(childTags(body) == std::vector<std::string>{"footer"});
+}
+
+CHTL_TEST(TemplateUseParser, UnsupportedStyleContentIsReported) {
+    std::string source =
+        "[Template] @Style Card { color: black; }\n"
+        "div { style { @Style Card { insert after color { margin: 0; } color: red; } } p { } }\n";
+    TokenArena tokens;
+    auto context = std::make_shared<CompileContext>("test.chtl");
+    auto lexer = std::make_shared<Lexer>(std::string_view(source), tokens, context);
+    Parser parser(lexer, context);
+    auto program = parser.parse();
+
+    assertFalse(parser.getErrors().empty());
+    assertContains(parser.getErrors().front(), "Unsupported content in @Style specialization of Card");
+    auto div = findElement(program, "div");
+    assertTrue(div != nullptr);
+    assertTrue(childTags(div) == std::vector<std::string>{"p"});
+}
+
+CHTL_TEST_SUITE(TemplateUseParser) {
+    CHTL_ADD_TEST(TemplateUseParser, SpecializationBlockKeepsNesting);
+    CHTL_ADD_TEST(TemplateUseParser, DeleteStyleGroupInSpecialization);
+    CHTL_ADD_TEST(TemplateUseParser, ElementSpecializationIsReported);
+    CHTL_ADD_TEST(TemplateUseParser, UnsupportedStyleContentIsReported);
+}
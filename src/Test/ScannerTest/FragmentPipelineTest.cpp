@@ -0,0 +1,147 @@
+#include "../CHTLTestSuite.h"
+#include "../../Scanner/FragmentPipeline.h"
+#include "../../Scanner/FragmentCollector.h"
+#include "../../Util/ThreadPool/BoundedQueue.h"
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+// 混合CHTL、局部样式、脚本和全局样式的页面，重复count次
+std::string buildPage(size_t count) {
+    std::stringstream ss;
+    ss << "html {\n    body {\n";
+    for (size_t i = 0; i < count; ++i) {
+        ss << "        div {\n"
+           << "            id: item" << i << ";\n"
+           << "            style { .item" << i << " { color: red; width: " << i << "px; } }\n"
+           << "            script { {{.item" << i << "}}->listen { click: () => { console.log(" << i << "); } }; }\n"
+           << "            text { \"entry " << i << "\" }\n"
+           << "        }\n";
+    }
+    ss << "    }\n}\n"
+       << "style { body { margin: 0; } }\n"
+       << "script { console.log(\"ready\"); }\n";
+    return ss.str();
+}
+
+// 顺序扫描后用FragmentCollector拼接的参考结果
+std::map<FragmentType, std::string> collectSequential(const std::string& source) {
+    CHTLUnifiedScanner scanner;
+    FragmentCollector collector;
+    collector.processFragments(scanner.scan(source));
+    std::map<FragmentType, std::string> result;
+    for (auto type : {FragmentType::CHTL, FragmentType::CHTLJS, FragmentType::CSS, FragmentType::JS}) {
+        if (collector.hasContent(type)) {
+            result[type] = collector.getCompleteCode(type);
+        }
+    }
+    return result;
+}
+
+std::map<FragmentType, std::string> collectPipelined(const std::string& source, WorkStealingThreadPool& pool,
+                                                     size_t capacity, size_t* fragmentCount = nullptr) {
+    std::mutex mutex;
+    std::map<FragmentType, std::string> result;
+    FragmentPipeline pipeline(pool, capacity);
+    for (auto type : {FragmentType::CHTL, FragmentType::CHTLJS, FragmentType::CSS, FragmentType::JS}) {
+        pipeline.setStage(type, [&, type](const std::string& code) {
+            std::lock_guard<std::mutex> lock(mutex);
+            result[type] = code;
+        });
+    }
+    CHTLUnifiedScanner scanner;
+    size_t count = pipeline.run(scanner, source);
+    if (fragmentCount) {
+        *fragmentCount = count;
+    }
+    return result;
+}
+
+} // namespace
+
+CHTL_TEST(FragmentPipeline, MatchesSequentialCollection) {
+    std::string source = buildPage(200);
+    auto expected = collectSequential(source);
+    assertTrue(expected.size() >= 2);
+
+    CHTLUnifiedScanner scanner;
+    size_t expectedFragments = scanner.scan(source).size();
+
+    // 容量为1时扫描几乎每个片段都要等收集任务取走
+    WorkStealingThreadPool pool(4);
+    for (size_t capacity : {static_cast<size_t>(1), static_cast<size_t>(64), static_cast<size_t>(0)}) {
+        size_t fragments = 0;
+        auto actual = collectPipelined(source, pool, capacity, &fragments);
+        assertTrue(actual == expected);
+        assertTrue(fragments == expectedFragments);
+    }
+}
+
+CHTL_TEST(FragmentPipeline, FewWorkersDoNotDeadlock) {
+    // 线程数少于阶段数时退化为不限容量
+    std::string source = buildPage(50);
+    WorkStealingThreadPool pool(1);
+    auto actual = collectPipelined(source, pool, 1);
+    assertTrue(actual == collectSequential(source));
+}
+
+CHTL_TEST(FragmentPipeline, StageErrorsPropagate) {
+    std::string source = buildPage(10);
+    WorkStealingThreadPool pool(4);
+    FragmentPipeline pipeline(pool, 4);
+    bool scriptCompiled = false;
+    pipeline.setStage(FragmentType::CHTL, [](const std::string&) {
+        throw std::runtime_error("chtl stage failed");
+    });
+    pipeline.setStage(FragmentType::CHTLJS, [&scriptCompiled](const std::string&) { scriptCompiled = true; });
+
+    CHTLUnifiedScanner scanner;
+    std::string message;
+    try {
+        pipeline.run(scanner, source);
+    } catch (const std::runtime_error& e) {
+        message = e.what();
+    }
+    assertEqual("chtl stage failed", message);
+    // 其他阶段照常完成
+    assertTrue(scriptCompiled);
+}
+
+CHTL_TEST(FragmentPipeline, BoundedQueueBlocksAndCloses) {
+    BoundedQueue<int> queue(2);
+    assertTrue(queue.push(1));
+    assertTrue(queue.push(2));
+    assertTrue(queue.size() == 2);
+
+    // 队列满时生产者等待消费者
+    std::thread producer([&queue]() {
+        for (int i = 3; i <= 100; ++i) {
+            queue.push(i);
+        }
+        queue.close();
+    });
+    int expected = 1;
+    while (auto value = queue.pop()) {
+        assertTrue(*value == expected);
+        assertTrue(queue.size() <= 2);
+        ++expected;
+    }
+    producer.join();
+    assertTrue(expected == 101);
+    assertTrue(queue.isClosed());
+    assertFalse(queue.push(101));
+}
+
+CHTL_TEST_SUITE(FragmentPipeline) {
+    CHTL_ADD_TEST(FragmentPipeline, MatchesSequentialCollection);
+    CHTL_ADD_TEST(FragmentPipeline, FewWorkersDoNotDeadlock);
+    CHTL_ADD_TEST(FragmentPipeline, StageErrorsPropagate);
+    CHTL_ADD_TEST(FragmentPipeline, BoundedQueueBlocksAndCloses);
+}
@@ -0,0 +1,171 @@
+#include "../CHTLTestSuite.h"
+#include "../../Scanner/CHTLUnifiedScanner.h"
+#include "../../CHTL/CHTLIOStream/CHTLFileSystem.h"
+#include <filesystem>
+#include <random>
+#include <sstream>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+#ifndef CHTL_CORPUS_DIR
+#define CHTL_CORPUS_DIR "."
+#endif
+
+namespace {
+
+// 将片段序列序列化为可比较的文本
+std::string describeFragments(const std::vector<CodeFragment>& fragments) {
+    std::stringstream ss;
+    for (const auto& fragment : fragments) {
+        ss << static_cast<int>(fragment.type) << "@"
+           << fragment.startLine << ":" << fragment.startColumn << "-"
+           << fragment.endLine << ":" << fragment.endColumn << "["
+           << fragment.content << "]\n";
+    }
+    return ss.str();
+}
+
+// 分别用状态机和正则参考实现扫描，返回二者的描述
+std::pair<std::string, std::string> scanBothWays(const std::string& source, size_t sliceSize) {
+    ScannerConfig dfaConfig;
+    dfaConfig.initialSliceSize = sliceSize;
+    ScannerConfig regexConfig = dfaConfig;
+    regexConfig.useRegexClassifier = true;
+    
+    CHTLUnifiedScanner dfaScanner(dfaConfig);
+    CHTLUnifiedScanner regexScanner(regexConfig);
+    
+    return {describeFragments(dfaScanner.scan(source)),
+            describeFragments(regexScanner.scan(source))};
+}
+
+std::vector<std::string> collectCorpus() {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+    for (const char* dir : {CHTL_CORPUS_DIR, CHTL_CORPUS_DIR "/tests", CHTL_CORPUS_DIR "/examples"}) {
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+            // 语料根目录只取顶层文件，避免遍历构建目录
+            if (std::string(dir) == CHTL_CORPUS_DIR && it.depth() > 0) {
+                it.disable_recursion_pending();
+                continue;
+            }
+            auto ext = it->path().extension();
+            if (it->is_regular_file() && (ext == ".chtl" || ext == ".cjjs")) {
+                files.push_back(it->path().string());
+            }
+        }
+    }
+    return files;
+}
+
+} // namespace
+
+CHTL_TEST(ScannerDifferential, Corpus) {
+    auto files = collectCorpus();
+    assertTrue(!files.empty(), "No .chtl corpus found under " CHTL_CORPUS_DIR);
+    
+    for (const auto& file : files) {
+        auto content = File::readToString(file);
+        assertTrue(content.has_value(), "Cannot read " + file);
+        if (!content) continue;
+        
+        auto [dfa, regex] = scanBothWays(*content, ScannerConfig().initialSliceSize);
+        assertEqual(dfa, regex);
+    }
+}
+
+CHTL_TEST(ScannerDifferential, CorpusSmallSlices) {
+    // 小切片让切割点落在块内部，覆盖更多片段边界
+    for (const auto& file : collectCorpus()) {
+        auto content = File::readToString(file);
+        if (!content) continue;
+        
+        for (size_t sliceSize : {16, 64, 200}) {
+            auto [dfa, regex] = scanBothWays(*content, sliceSize);
+            assertEqual(dfa, regex);
+        }
+    }
+}
+
+CHTL_TEST(ScannerDifferential, BoundaryCases) {
+    // 单词边界、方括号/at关键字与CSS/JS特征的边界情况
+    const char* cases[] = {
+        "text", "texts", "_text", "a[Template]b", " [Template] ", "x@Style", "@Style ",
+        "{{.box}}", "{{}}", "{{ a }", "{{a}b}}", "{{{a}}", "a->b", "&->", "module  {", "module(",
+        "vir test", "virtest", "vir ", "iNeverAway{", "color: red;", "color:;", "a :  ;",
+        ":x;", ".box {", ".{", "# {", "#id{", "@media screen", "@keyframes x",
+        "function f() {}", "functional", "if(x)", "return;", "div{span{}}",
+        "style { color: red; }", "script { let a = 1; }", "use html5;", "\tinsert\n",
+    };
+    
+    for (const char* text : cases) {
+        for (size_t sliceSize : {1, 3, 1024}) {
+            auto [dfa, regex] = scanBothWays(text, sliceSize);
+            assertEqual(dfa, regex);
+        }
+    }
+}
+
+CHTL_TEST(ScannerDifferential, RandomInput) {
+    // 在关键字与标点构成的字母表上生成随机输入
+    const std::vector<std::string> alphabet = {
+        "text", "style", "[Template]", "@Style", "@Var", "use", "vir", "module", "listen",
+        "function", "let", "if", "{", "}", "{{", "}}", "-", ">", "&", ":", ";", ".", "#",
+        "@media", "a", "_", "-x", " ", "\n", "\t", "\"", "'", "/", "*", "[", "]", "(", ")"
+    };
+    
+    std::mt19937 rng(20240601);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::uniform_int_distribution<size_t> length(1, 60);
+    
+    for (int iteration = 0; iteration < 2000; ++iteration) {
+        std::string text;
+        size_t parts = length(rng);
+        for (size_t i = 0; i < parts; ++i) {
+            text += alphabet[pick(rng)];
+        }
+        
+        auto [dfa, regex] = scanBothWays(text, 1 + iteration % 32);
+        assertEqual(dfa, regex);
+    }
+}
+
+CHTL_TEST(ScannerDifferential, ScannerReuse) {
+    // 同一扫描器先后扫描修改过的同一字符串，结果必须与新扫描器一致
+    ScannerConfig config;
+    config.initialSliceSize = 4;
+    CHTLUnifiedScanner reused(config);
+    
+    // 第一次扫描只在位置4判断过切割点，此时不在字符串和块中
+    std::string source = "abcdxy";
+    reused.scan(source);
+    
+    // 改写后同样从位置4开始判断，沿用旧的前缀状态会把字符串内部当作切割点
+    const char* rewrites[] = {
+        "\"bcd\" efgh { ijkl } mnop",
+        "{ab} cd { ef } gh",
+        "\"bcd\" efgh { ijkl } mnop",
+    };
+    for (const char* rewrite : rewrites) {
+        source = rewrite;
+        CHTLUnifiedScanner fresh(config);
+        assertEqual(describeFragments(reused.scan(source)), describeFragments(fresh.scan(source)));
+    }
+    
+    // 长度不变的原地修改
+    for (char& c : source) {
+        if (c == '"') c = ' ';
+    }
+    CHTLUnifiedScanner fresh(config);
+    assertEqual(describeFragments(reused.scan(source)), describeFragments(fresh.scan(source)));
+}
+
+CHTL_TEST_SUITE(ScannerDifferential) {
+    CHTL_ADD_TEST(ScannerDifferential, Corpus);
+    CHTL_ADD_TEST(ScannerDifferential, CorpusSmallSlices);
+    CHTL_ADD_TEST(ScannerDifferential, BoundaryCases);
+    CHTL_ADD_TEST(ScannerDifferential, RandomInput);
+    CHTL_ADD_TEST(ScannerDifferential, ScannerReuse);
+}
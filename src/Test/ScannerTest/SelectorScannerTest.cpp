@@ -0,0 +1,103 @@
+#include "../CHTLTestSuite.h"
+#include "../../CHTL/CHTLManage/SelectorAutomation.h"
+#include <sstream>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+// 序列化为 类型:值@行:列 的列表，便于整体比较
+std::string describe(const std::vector<SelectorView>& views) {
+    std::stringstream ss;
+    for (const auto& view : views) {
+        switch (view.type) {
+            case SelectorType::Class: ss << "class"; break;
+            case SelectorType::Id: ss << "id"; break;
+            case SelectorType::Tag: ss << "tag"; break;
+            case SelectorType::Reference: ss << "ref"; break;
+            default: ss << "other"; break;
+        }
+        ss << ":" << view.value;
+        if (view.index >= 0) {
+            ss << "[" << view.index << "]";
+        }
+        ss << "@" << view.line << ":" << view.column << " ";
+    }
+    return ss.str();
+}
+
+std::string scanStyle(const std::string& css) {
+    std::vector<SelectorView> views;
+    SelectorScanner::scanStyle(css, views);
+    return describe(views);
+}
+
+std::string scanScript(const std::string& script) {
+    std::vector<SelectorView> views;
+    SelectorScanner::scanScript(script, views);
+    return describe(views);
+}
+
+} // namespace
+
+CHTL_TEST(SelectorScanner, StylePreludesOnly) {
+    assertEqual("class:box@2:1 ",
+                scanStyle("color: red;\n.box { width: 10px; }"));
+    assertEqual("tag:div@1:1 class:card@1:4 id:main@1:11 tag:li@1:19 ",
+                scanStyle("div.card, #main > li[data-x=\"{.no}\"] { margin: 0; }"));
+    assertEqual("ref:&@1:1 ref:&@2:1 class:active@2:2 ",
+                scanStyle("&:hover { opacity: .8; }\n&.active::after { content: \"#x\"; }"));
+    // :not()等的参数是选择器，其他伪类参数不是
+    assertEqual("tag:a@1:1 class:off@1:7 tag:li@1:14 ",
+                scanStyle("a:not(.off), li:nth-child(2n+1) { }"));
+}
+
+CHTL_TEST(SelectorScanner, StyleSkipsAtRulesAndComments) {
+    assertEqual("class:wide@1:27 ",
+                scanStyle("@media (min-width: 1px) { .wide { } }"));
+    assertEqual("class:after@1:53 ",
+                scanStyle("@keyframes spin { from { top: 0 } to { top: 1px } } .after { }"));
+    assertEqual("class:real@1:22 ",
+                scanStyle("/* .commented { } */ .real { }"));
+    assertEqual("",
+                scanStyle("@Style Card;\nbackground: url(\"a{b}.png\");"));
+}
+
+CHTL_TEST(SelectorScanner, ScriptSelectors) {
+    assertEqual("class:box@1:1 id:main@1:22 tag:button[2]@2:1 ref:&@2:18 ",
+                scanScript("{{.box}}->listen({}) {{#main}};\n{{button[2]}}.x; {{&}}"));
+    assertEqual("class:a@1:2 ",
+                scanScript("{{{.a}}} {{ .b }} {{.c[x]}} {{#}}"));
+}
+
+CHTL_TEST(SelectorScanner, AutomationUsesScanner) {
+    SelectorAutomation automation;
+    auto selectors = automation.extractFromStyleBlock("width: 1px;\n#hero .title { }");
+    assertTrue(selectors.size() == 2);
+    assertEqual("hero", *automation.getFirstIdSelector(selectors));
+    assertEqual("title", *automation.getFirstClassSelector(selectors));
+
+    auto scripts = automation.extractFromScriptBlock("{{.box[1]}}.textContent = 1;");
+    assertTrue(scripts.size() == 1);
+    assertEqual("{{.box[1]}}", scripts[0].raw);
+    assertEqual("box", scripts[0].value);
+
+    CHTLJSSelectorProcessor processor;
+    auto raw = processor.extractSelectors("{{#a}} + {{div}}");
+    assertTrue(raw.size() == 2);
+    assertEqual("{{div}}", raw[1]);
+
+    assertTrue(SelectorScanner::isSimpleSelector(".box"));
+    assertTrue(SelectorScanner::isSimpleSelector("a[href]:hover"));
+    assertFalse(SelectorScanner::isSimpleSelector("a b"));
+    assertFalse(SelectorScanner::isSimpleSelector("a[]"));
+    assertFalse(SelectorScanner::isSimpleSelector(".x:{"));
+}
+
+CHTL_TEST_SUITE(SelectorScanner) {
+    CHTL_ADD_TEST(SelectorScanner, StylePreludesOnly);
+    CHTL_ADD_TEST(SelectorScanner, StyleSkipsAtRulesAndComments);
+    CHTL_ADD_TEST(SelectorScanner, ScriptSelectors);
+    CHTL_ADD_TEST(SelectorScanner, AutomationUsesScanner);
+}
@@ -0,0 +1,115 @@
+#include "../CHTLTestSuite.h"
+#include "../../CHTL/CHTLState/State.h"
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+// 转换表在编译期可用
+static_assert(STATE_TRANSITIONS[static_cast<size_t>(StateType::GLOBAL)].contains(StateType::IN_ELEMENT),
+              "GLOBAL -> IN_ELEMENT");
+static_assert(!STATE_TRANSITIONS[static_cast<size_t>(StateType::IN_TEXT_BLOCK)].contains(StateType::IN_ELEMENT),
+              "text blocks have no children");
+
+CHTL_TEST(StateManager, TransitionsAndGuards) {
+    StateManager manager;
+    assertTrue(manager.getStackDepth() == 1);
+    assertTrue(manager.getCurrentState() == StateType::GLOBAL);
+    assertFalse(manager.canTransitionTo(StateType::IN_TEXT_BLOCK));
+
+    {
+        StateGuard element(manager, StateType::IN_ELEMENT, "div", 3, 1);
+        {
+            StateGuard style(manager, StateType::IN_STYLE_BLOCK);
+            assertTrue(manager.isInState(StateType::IN_ELEMENT));
+            assertTrue(manager.isInAnyState({StateType::IN_SCRIPT_BLOCK, StateType::IN_STYLE_BLOCK}));
+            assertTrue(manager.getStackDepth() == 3);
+        }
+        assertFalse(manager.isInState(StateType::IN_STYLE_BLOCK));
+        assertTrue(manager.getCurrentContext()->name == "div");
+        assertTrue(manager.getCurrentContext()->startLine == 3);
+    }
+    assertTrue(manager.getStackDepth() == 1);
+
+    bool threw = false;
+    try {
+        manager.pushState(StateType::IN_ATTRIBUTE_VALUE);
+    } catch (const StateException&) {
+        threw = true;
+    }
+    assertTrue(threw);
+
+    threw = false;
+    try {
+        manager.popState();
+    } catch (const StateException&) {
+        threw = true;
+    }
+    assertTrue(threw);
+}
+
+CHTL_TEST(StateManager, NearestStateAndPath) {
+    StateManager manager;
+    manager.pushState(StateType::IN_ELEMENT, "html");
+    manager.pushState(StateType::IN_ELEMENT, "body");
+    manager.pushState(StateType::IN_SCRIPT_BLOCK);
+
+    const StateContext* nearest = manager.findNearestState(StateType::IN_ELEMENT);
+    assertTrue(nearest != nullptr);
+    assertEqual("body", std::string(nearest->name));
+    assertTrue(manager.findNearestState(StateType::IN_TEMPLATE) == nullptr);
+    assertEqual("0(global) -> 8(html) -> 8(body) -> 10", manager.getStatePath());
+
+    manager.popState();
+    manager.popState();
+    manager.pushState(StateType::IN_ELEMENT, "main");
+    assertEqual("0(global) -> 8(html) -> 8(main)", manager.getStatePath());
+
+    StateManager copy = manager;
+    manager.reset();
+    assertTrue(manager.getStackDepth() == 1);
+    assertFalse(manager.isInState(StateType::IN_ELEMENT));
+    assertEqual("0(global) -> 8(html) -> 8(main)", copy.getStatePath());
+}
+
+CHTL_TEST(StateManager, PropertiesFollowStates) {
+    StateManager manager;
+    manager.pushState(StateType::IN_ELEMENT, "div");
+    manager.setCurrentStateProperty("class", "box");
+
+    manager.pushState(StateType::IN_ELEMENT, "span");
+    assertFalse(manager.getCurrentStateProperty("class").has_value());
+    for (int i = 0; i < 20; ++i) {
+        manager.setCurrentStateProperty("key" + std::to_string(i), std::to_string(i));
+    }
+    manager.setCurrentStateProperty("key3", "three");
+    assertEqual("three", *manager.getCurrentStateProperty("key3"));
+    assertEqual("19", *manager.getCurrentStateProperty("key19"));
+
+    manager.popState();
+    assertEqual("box", *manager.getCurrentStateProperty("class"));
+    assertFalse(manager.getCurrentStateProperty("key19").has_value());
+}
+
+CHTL_TEST(StateManager, DepthLimit) {
+    StateManager manager;
+    for (size_t i = 1; i < StateManager::MAX_STATE_DEPTH; ++i) {
+        manager.pushState(StateType::IN_ELEMENT, "div");
+    }
+    assertTrue(manager.getStackDepth() == StateManager::MAX_STATE_DEPTH);
+
+    bool threw = false;
+    try {
+        manager.pushState(StateType::IN_ELEMENT);
+    } catch (const StateException&) {
+        threw = true;
+    }
+    assertTrue(threw);
+    assertTrue(manager.getStackDepth() == StateManager::MAX_STATE_DEPTH);
+}
+
+CHTL_TEST_SUITE(StateManager) {
+    CHTL_ADD_TEST(StateManager, TransitionsAndGuards);
+    CHTL_ADD_TEST(StateManager, NearestStateAndPath);
+    CHTL_ADD_TEST(StateManager, PropertiesFollowStates);
+    CHTL_ADD_TEST(StateManager, DepthLimit);
+}
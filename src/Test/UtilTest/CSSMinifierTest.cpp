@@ -0,0 +1,123 @@
+#include "../CHTLTestSuite.h"
+#include "../../CSS/CSSTokenizer.h"
+#include "../../CSS/CSSMinifier.h"
+#include <vector>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+std::vector<CSSToken> tokenize(std::string_view css) {
+    std::vector<CSSToken> tokens;
+    CSSTokenizer tokenizer(css);
+    for (CSSToken token = tokenizer.next(); !token.is(CSSTokenType::END_OF_FILE); token = tokenizer.next()) {
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+} // namespace
+
+CHTL_TEST(CSSMinifier, TokenizerBasics) {
+    auto tokens = tokenize("#main .box:hover{width:10.5px;color:#0af}");
+    assertTrue(tokens.size() == 15);
+    assertTrue(tokens[0].is(CSSTokenType::HASH));
+    assertTrue(tokens[0].isIdHash);
+    assertEqual("main", std::string(tokens[0].value));
+    assertTrue(tokens[2].isDelim('.'));
+    assertTrue(tokens[4].is(CSSTokenType::COLON));
+    assertTrue(tokens[6].is(CSSTokenType::LEFT_BRACE));
+    assertTrue(tokens[9].is(CSSTokenType::DIMENSION));
+    assertEqual("10.5", std::string(tokens[9].value));
+    assertEqual("px", std::string(tokens[9].unit));
+    assertFalse(tokens[9].isInteger);
+    assertTrue(tokens[13].is(CSSTokenType::HASH));
+    assertFalse(tokens[13].isIdHash);   // 0开头不能构成标识符
+    assertTrue(tokenize("#fff")[0].isIdHash);
+
+    auto url = tokenize("url( a.png )");
+    assertTrue(url.size() == 1);
+    assertTrue(url[0].is(CSSTokenType::URL));
+    assertEqual("a.png", std::string(url[0].value));
+
+    auto fn = tokenize("url(\"a.png\") 50%");
+    assertTrue(fn[0].is(CSSTokenType::FUNCTION));
+    assertTrue(fn[1].is(CSSTokenType::STRING));
+    assertTrue(fn.back().is(CSSTokenType::PERCENTAGE));
+}
+
+CHTL_TEST(CSSMinifier, TokenizerErrors) {
+    CSSTokenizer tokenizer("a{content:\"open\n}");
+    size_t badStrings = 0;
+    for (CSSToken token = tokenizer.next(); !token.is(CSSTokenType::END_OF_FILE); token = tokenizer.next()) {
+        if (token.is(CSSTokenType::BAD_STRING)) {
+            ++badStrings;
+        }
+    }
+    assertTrue(badStrings == 1);
+    assertTrue(tokenizer.errorCount() == 1);
+}
+
+CHTL_TEST(CSSMinifier, WhitespaceAndSelectors) {
+    CSSMinifier minifier;
+    assertEqual(".a>.b,.c .d{color:red}",
+                minifier.minify("  .a > .b ,\n .c   .d {\n  color : red ;\n}\n"));
+    assertEqual("a[href=\"x\"] :not(.b)::after{content:\"a  b\"}",
+                minifier.minify("a[ href = \"x\" ] :not( .b )::after { content: \"a  b\"; }"));
+    assertEqual("@media screen and (max-width:600px){.a{margin:0 auto}}",
+                minifier.minify("@media screen and (max-width: 600px) { .a { margin: 0 auto; } }"));
+    assertTrue(minifier.errorCount() == 0);
+}
+
+CHTL_TEST(CSSMinifier, ValueShortening) {
+    CSSMinifier minifier;
+    assertEqual(".a{color:#abc;margin:0;opacity:.5}",
+                minifier.minify(".a { color: #AABBCC; margin: 0px; opacity: 0.50; }"));
+    // 函数内部、flex简写和自定义属性保持原样
+    assertEqual(".a{width:calc(100% - 0px);flex:1 1 0px;--gap:0px}",
+                minifier.minify(".a { width: calc( 100% - 0px ); flex: 1 1 0px; --gap: 0px ; }"));
+    assertEqual(".a{color:red!important}",
+                minifier.minify(".a { color: red !important; }"));
+}
+
+CHTL_TEST(CSSMinifier, CommentsAndDuplicates) {
+    CSSMinifier minifier;
+    assertEqual("/*! license */.a{color:red}",
+                minifier.minify("/*! license */\n/* note */ .a { color: red; }"));
+    // 完全相同的声明只保留最后一个，不同取值的回退写法保留
+    assertEqual(".a{display:-webkit-box;color:red;display:flex}",
+                minifier.minify(".a { color: red; display: -webkit-box; color: red; display: flex; }"));
+
+    CSSMinifyOptions options;
+    options.mergeDuplicateDeclarations = false;
+    options.keepImportantComments = false;
+    assertEqual(".a{color:red;color:red}",
+                CSSMinifier(options).minify("/*! x */ .a { color: red; color: red; }"));
+}
+
+CHTL_TEST(CSSMinifier, BadStringAndIdempotence) {
+    CSSMinifier minifier;
+    std::string out = minifier.minify(".a { content: \"open\n}\n.b { color: red; }");
+    assertTrue(minifier.errorCount() == 1);
+    assertTrue(out.find(".b{color:red}") != std::string::npos);
+
+    std::string css = "@keyframes k { from { opacity: 0 } to { opacity: 1 } }\n"
+                      "@font-face { font-family: \"X\"; src: url(x.woff2) format(\"woff2\"); }\n"
+                      ".a:hover > li + li ~ p { transform: translate( -50% , 0 ); }\n";
+    std::string once = minifier.minify(css);
+    assertEqual(once, minifier.minify(once));
+
+    std::string appended = "/*prefix*/";
+    minifier.minify(".a { color: red; }", appended);
+    assertEqual("/*prefix*/.a{color:red}", appended);
+}
+
+CHTL_TEST_SUITE(CSSMinifier) {
+    CHTL_ADD_TEST(CSSMinifier, TokenizerBasics);
+    CHTL_ADD_TEST(CSSMinifier, TokenizerErrors);
+    CHTL_ADD_TEST(CSSMinifier, WhitespaceAndSelectors);
+    CHTL_ADD_TEST(CSSMinifier, ValueShortening);
+    CHTL_ADD_TEST(CSSMinifier, CommentsAndDuplicates);
+    CHTL_ADD_TEST(CSSMinifier, BadStringAndIdempotence);
+}
@@ -0,0 +1,129 @@
+#include "../CHTLTestSuite.h"
+#include "../../CHTL/CHTLIOStream/CHTLFileSystem.h"
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class WatchDir {
+public:
+    explicit WatchDir(const std::string& name)
+        : root_(fs::temp_directory_path() / ("chtl_file_watcher_" + name)) {
+        fs::remove_all(root_);
+        fs::create_directories(root_);
+    }
+
+    ~WatchDir() {
+        std::error_code ec;
+        fs::remove_all(root_, ec);
+    }
+
+    std::string write(const std::string& relative, const std::string& content) {
+        fs::path path = root_ / relative;
+        std::ofstream(path, std::ios::trunc) << content;
+        return path.string();
+    }
+
+private:
+    fs::path root_;
+};
+
+// 当前进程打开的文件描述符数量（无/proc的平台返回0）
+size_t openDescriptors() {
+    size_t count = 0;
+    std::error_code ec;
+    for (fs::directory_iterator it("/proc/self/fd", ec), end; !ec && it != end; it.increment(ec)) {
+        ++count;
+    }
+    return count;
+}
+
+// 在超时前轮询条件
+template <typename Predicate>
+bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::milliseconds(3000)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+} // namespace
+
+CHTL_TEST(FileWatcher, ModifyEventIsReported) {
+    WatchDir dir("modify");
+    std::string file = dir.write("page.chtl", "div {}\n");
+
+    std::mutex mutex;
+    std::vector<std::string> changed;
+    FileWatcher watcher;
+    watcher.setDebounceInterval(std::chrono::milliseconds(10));
+    watcher.setBatchCallback([&](const std::vector<std::string>& paths) {
+        std::lock_guard<std::mutex> lock(mutex);
+        changed.insert(changed.end(), paths.begin(), paths.end());
+    });
+    assertTrue(watcher.addPath(file));
+    assertTrue(watcher.start());
+
+    dir.write("page.chtl", "span {}\n");
+    assertTrue(waitFor([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !changed.empty();
+    }));
+
+    watcher.stop();
+    assertFalse(watcher.isWatching());
+    assertTrue(changed.front() == PathUtil::normalize(PathUtil::absolute(file)));
+}
+
+CHTL_TEST(FileWatcher, StopFromCallbackReleasesResources) {
+    WatchDir dir("stop_in_callback");
+    std::string file = dir.write("page.chtl", "div {}\n");
+    size_t baseline = openDescriptors();
+
+    {
+        FileWatcher watcher;
+        std::atomic<int> calls{0};
+        watcher.setDebounceInterval(std::chrono::milliseconds(10));
+        watcher.setCallback([&](const std::string&, FileType) {
+            ++calls;
+            watcher.stop();
+        });
+        assertTrue(watcher.addPath(file));
+        assertTrue(watcher.start());
+#ifdef __linux__
+        assertTrue(openDescriptors() > baseline);
+#endif
+
+        dir.write("page.chtl", "span {}\n");
+        assertTrue(waitFor([&]() { return calls > 0; }));
+        assertFalse(watcher.isWatching());
+
+        // 监视线程退出后inotify和唤醒描述符都已关闭
+        assertTrue(waitFor([&]() { return openDescriptors() == baseline; }));
+
+        // 回调中停止后可以再次启动
+        assertTrue(watcher.start());
+        dir.write("page.chtl", "p {}\n");
+        assertTrue(waitFor([&]() { return calls > 1; }));
+        assertTrue(waitFor([&]() { return openDescriptors() == baseline; }));
+    }
+    assertTrue(openDescriptors() == baseline);
+}
+
+CHTL_TEST_SUITE(FileWatcher) {
+    CHTL_ADD_TEST(FileWatcher, ModifyEventIsReported);
+    CHTL_ADD_TEST(FileWatcher, StopFromCallbackReleasesResources);
+}
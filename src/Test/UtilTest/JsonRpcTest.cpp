@@ -0,0 +1,139 @@
+#include "../CHTLTestSuite.h"
+#include "../../Util/JsonRpc/JsonRpcServer.h"
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <thread>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+std::string frame(const std::string& body) {
+    std::stringstream ss;
+    JsonRpcServer::writeMessage(ss, body);
+    return ss.str();
+}
+
+// 读出全部回复，按id索引
+std::map<std::string, JsonValue> readResponses(const std::string& output) {
+    std::map<std::string, JsonValue> responses;
+    std::stringstream in(output);
+    std::string body;
+    while (JsonRpcServer::readMessage(in, body)) {
+        auto message = JsonValue::parse(body);
+        if (message) {
+            const JsonValue* id = message->find("id");
+            responses[id ? id->serialize() : "null"] = *message;
+        }
+    }
+    return responses;
+}
+
+int errorCode(const JsonValue& response) {
+    const JsonValue* error = response.find("error");
+    return error ? static_cast<int>(error->find("code")->asNumber()) : 0;
+}
+
+} // namespace
+
+CHTL_TEST(JsonRpc, JsonRoundTrip) {
+    std::string text = R"({"a":1,"b":[true,false,null],"c":"x\"y\\z\n","d":-2.5,"e":{}})";
+    std::string error;
+    auto value = JsonValue::parse(text, &error);
+    assertTrue(value.has_value());
+    assertEqual(text, value->serialize());
+    assertTrue(value->find("d")->asNumber() == -2.5);
+    assertTrue(value->find("b")->asArray().size() == 3);
+
+    // \u转义解码为UTF-8，代理对合并
+    auto unicode = JsonValue::parse(R"("中😀")");
+    assertTrue(unicode.has_value());
+    assertEqual("\xe4\xb8\xad\xf0\x9f\x98\x80", unicode->asString());
+
+    assertFalse(JsonValue::parse("{\"a\":}", &error).has_value());
+    assertFalse(JsonValue::parse("[1,2", &error).has_value());
+    assertFalse(JsonValue::parse("1 2", &error).has_value());
+    assertFalse(JsonValue::parse(std::string(1000, '['), &error).has_value());
+}
+
+CHTL_TEST(JsonRpc, RequestsAndErrors) {
+    std::stringstream in;
+    in << frame(R"({"jsonrpc":"2.0","id":1,"method":"echo","params":{"text":"hi"}})")
+       << frame(R"({"jsonrpc":"2.0","id":"two","method":"missing"})")
+       << frame(R"({"jsonrpc":"2.0","id":3,"method":"fail"})")
+       << frame(R"({"jsonrpc":"2.0","id":4,"method":"echo",)")
+       << frame(R"([{"jsonrpc":"2.0","id":5,"method":"echo"}])")
+       << frame(R"({"jsonrpc":"2.0","method":"echo"})")
+       << frame(R"({"jsonrpc":"2.0","id":6,"method":"shutdown"})")
+       << frame(R"({"jsonrpc":"2.0","id":7,"method":"echo"})")
+       << frame(R"({"jsonrpc":"2.0","method":"exit"})");
+    std::stringstream out;
+
+    JsonRpcServer server(in, out, 2);
+    int echoCalls = 0;
+    server.setHandler("echo", [&echoCalls](const JsonRpcServer::Request& request) {
+        ++echoCalls;
+        return request.params();
+    });
+    server.setHandler("fail", [](const JsonRpcServer::Request&) -> JsonValue {
+        throw JsonRpcError(JsonRpcErrorCode::INVALID_PARAMS, "bad params");
+    });
+    assertTrue(server.run() == 0);
+
+    auto responses = readResponses(out.str());
+    assertEqual("hi", responses["1"].find("result")->find("text")->asString());
+    assertTrue(errorCode(responses["\"two\""]) == JsonRpcErrorCode::METHOD_NOT_FOUND);
+    assertTrue(errorCode(responses["3"]) == JsonRpcErrorCode::INVALID_PARAMS);
+    assertTrue(responses["6"].find("result")->isNull());
+    assertTrue(errorCode(responses["7"]) == JsonRpcErrorCode::INVALID_REQUEST);
+    // 解析错误和批量请求以null id回复，通知不回复
+    assertTrue(errorCode(responses["null"]) != 0);
+    assertTrue(echoCalls == 1);
+}
+
+CHTL_TEST(JsonRpc, CancelPendingRequest) {
+    // 第一个请求阻塞直到收到取消（取消也可能在它开始前到达），
+    // 第二个请求在另一个工作线程上照常完成
+    std::stringstream in;
+    in << frame(R"({"jsonrpc":"2.0","id":1,"method":"block"})")
+       << frame(R"({"jsonrpc":"2.0","id":2,"method":"quick"})")
+       << frame(R"({"jsonrpc":"2.0","method":"$/cancelRequest","params":{"id":1}})")
+       << frame(R"({"jsonrpc":"2.0","method":"exit"})");
+    std::stringstream out;
+
+    JsonRpcServer server(in, out, 2);
+    server.setHandler("block", [](const JsonRpcServer::Request& request) {
+        while (!request.isCancelled()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return JsonValue("finished");
+    });
+    server.setHandler("quick", [](const JsonRpcServer::Request&) {
+        return JsonValue("done");
+    });
+    // 没有shutdown就退出
+    assertTrue(server.run() == 1);
+
+    auto responses = readResponses(out.str());
+    assertTrue(errorCode(responses["1"]) == JsonRpcErrorCode::REQUEST_CANCELLED);
+    assertEqual("done", responses["2"].find("result")->asString());
+}
+
+CHTL_TEST(JsonRpc, FramingHeaders) {
+    std::stringstream in("Content-Type: application/json\r\ncontent-length: 2\r\n\r\n{}"
+                         "Content-Length: 10\r\n\r\n{}");
+    std::string body;
+    assertTrue(JsonRpcServer::readMessage(in, body));
+    assertEqual("{}", body);
+    // 内容不足
+    assertFalse(JsonRpcServer::readMessage(in, body));
+}
+
+CHTL_TEST_SUITE(JsonRpc) {
+    CHTL_ADD_TEST(JsonRpc, JsonRoundTrip);
+    CHTL_ADD_TEST(JsonRpc, RequestsAndErrors);
+    CHTL_ADD_TEST(JsonRpc, CancelPendingRequest);
+    CHTL_ADD_TEST(JsonRpc, FramingHeaders);
+}
@@ -0,0 +1,123 @@
+#include "../CHTLTestSuite.h"
+#include "../../Util/KeywordMatcher/KeywordMatcher.h"
+#include <cctype>
+#include <random>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+bool isIdent(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+// 逐个关键字用find查找的参照实现
+std::vector<KeywordMatch> naiveScan(const std::vector<std::string>& keywords, const std::string& text) {
+    std::vector<KeywordMatch> matches;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        KeywordMatch best;
+        bool found = false;
+        for (uint32_t id = 0; id < keywords.size(); ++id) {
+            const std::string& keyword = keywords[id];
+            for (size_t at = text.find(keyword, pos); at != std::string::npos; at = text.find(keyword, at + 1)) {
+                size_t end = at + keyword.size();
+                bool left = !isIdent(keyword.front()) || at == 0 || !isIdent(text[at - 1]);
+                bool right = !isIdent(keyword.back()) || end == text.size() || !isIdent(text[end]);
+                if (!left || !right) {
+                    continue;
+                }
+                if (!found || at < best.position || (at == best.position && keyword.size() > best.length)) {
+                    best = {at, keyword.size(), id};
+                    found = true;
+                }
+                break;
+            }
+        }
+        if (!found) {
+            break;
+        }
+        matches.push_back(best);
+        pos = best.position + best.length;
+    }
+    return matches;
+}
+
+} // namespace
+
+CHTL_TEST(KeywordMatcher, LongestAndWordBoundary) {
+    KeywordMatcher matcher;
+    uint32_t print = matcher.add("printMylove");
+    uint32_t never = matcher.add("iNeverAway");
+    uint32_t arrow = matcher.add("->");
+    uint32_t arrowListen = matcher.add("->Listen");
+    assertTrue(matcher.add("printMylove") == print);
+    matcher.build();
+
+    std::string code = "xprintMylove {} printMylove { url: a } box->Listen {} box->textContent; iNeverAway";
+    auto matches = matcher.scan(code);
+    assertTrue(matches.size() == 4);
+    assertTrue(matches[0].id == print);
+    assertTrue(matches[0].position == code.find(" printMylove") + 1);
+    assertTrue(matches[1].id == arrowListen);
+    assertTrue(matches[2].id == arrow);
+    assertTrue(matches[3].id == never);
+    assertTrue(matches[3].position + matches[3].length == code.size());
+
+    KeywordMatch first;
+    assertTrue(matcher.findFirst(code, matches[0].position + 1, first));
+    assertTrue(first.id == arrowListen);
+    assertFalse(matcher.findFirst(code, code.size() - 3, first));
+}
+
+CHTL_TEST(KeywordMatcher, EmptyAndRebuild) {
+    KeywordMatcher matcher;
+    matcher.build();
+    assertTrue(matcher.scan("anything").empty());
+
+    matcher.add("");
+    assertTrue(matcher.empty());
+    matcher.add("vir");
+    matcher.build();
+    assertTrue(matcher.scan("vir test = listen {}").size() == 1);
+
+    matcher.clear();
+    matcher.add("listen");
+    matcher.build();
+    auto matches = matcher.scan("vir test = listen {}");
+    assertTrue(matches.size() == 1);
+    assertEqual("listen", matcher.keyword(matches[0].id));
+}
+
+CHTL_TEST(KeywordMatcher, MatchesNaiveSearch) {
+    std::vector<std::string> keywords = {"ab", "abc", "bca", "c", "a-b", "cab", "$a", "b$"};
+    KeywordMatcher matcher;
+    for (const auto& keyword : keywords) {
+        matcher.add(keyword);
+    }
+    matcher.build();
+
+    std::mt19937 rng(2024);
+    const char alphabet[] = "abc- $x";
+    for (int round = 0; round < 500; ++round) {
+        std::string text;
+        size_t length = rng() % 40;
+        for (size_t i = 0; i < length; ++i) {
+            text += alphabet[rng() % (sizeof(alphabet) - 1)];
+        }
+        auto expected = naiveScan(keywords, text);
+        auto actual = matcher.scan(text);
+        assertTrue(expected.size() == actual.size());
+        for (size_t i = 0; i < expected.size() && i < actual.size(); ++i) {
+            assertTrue(expected[i].position == actual[i].position);
+            assertTrue(expected[i].id == actual[i].id);
+        }
+    }
+}
+
+CHTL_TEST_SUITE(KeywordMatcher) {
+    CHTL_ADD_TEST(KeywordMatcher, LongestAndWordBoundary);
+    CHTL_ADD_TEST(KeywordMatcher, EmptyAndRebuild);
+    CHTL_ADD_TEST(KeywordMatcher, MatchesNaiveSearch);
+}
@@ -0,0 +1,177 @@
+#include "../CHTLTestSuite.h"
+#include "../../CHTL/CHTLLoader/ModuleIndex.h"
+#include "../../CHTL/CHTLLoader/ImportResolver.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// 测试用的临时模块目录
+class ModuleTree {
+public:
+    explicit ModuleTree(const std::string& name)
+        : root_(fs::temp_directory_path() / ("chtl_module_index_" + name)) {
+        fs::remove_all(root_);
+        fs::create_directories(root_);
+    }
+
+    ~ModuleTree() {
+        std::error_code ec;
+        fs::remove_all(root_, ec);
+    }
+
+    void write(const std::string& relative) {
+        fs::path path = root_ / relative;
+        fs::create_directories(path.parent_path());
+        std::ofstream(path) << "// " << relative << "\n";
+    }
+
+    std::string path(const std::string& relative = "") const {
+        return relative.empty() ? root_.string() : (root_ / relative).string();
+    }
+
+private:
+    fs::path root_;
+};
+
+} // namespace
+
+CHTL_TEST(ModuleIndex, ExistenceAndPrefixListing) {
+    ScopedInstance<ModuleIndex> scope;
+    auto& index = ModuleIndex::getInstance();
+
+    ModuleTree tree("listing");
+    tree.write("Chtholly.cmod");
+    tree.write("Chtholly.chtl");
+    tree.write("Yuigahama.chtl");
+    tree.write("CMOD/Box.chtl");
+
+    assertTrue(index.exists(tree.path("Chtholly.cmod")));
+    assertTrue(index.isFile(tree.path("Yuigahama.chtl")));
+    assertTrue(index.isDirectory(tree.path("CMOD")));
+    assertFalse(index.isFile(tree.path("CMOD")));
+    assertFalse(index.exists(tree.path("Missing.chtl")));
+    assertTrue(index.exists(tree.path("CMOD/Box.chtl")));
+
+    // 前缀查询按名称排序，只返回普通文件
+    auto chtholly = index.listFiles(tree.path(), "Chtholly");
+    assertTrue(chtholly.size() == 2);
+    assertEqual(fs::path(chtholly[0]).filename().string(), "Chtholly.chtl");
+    assertEqual(fs::path(chtholly[1]).filename().string(), "Chtholly.cmod");
+    assertTrue(index.listFiles(tree.path()).size() == 3);
+    assertTrue(index.listFiles(tree.path(), "Z").empty());
+
+    auto directories = index.listDirectories(tree.path());
+    assertTrue(directories.size() == 1);
+    assertEqual(fs::path(directories[0]).filename().string(), "CMOD");
+}
+
+CHTL_TEST(ModuleIndex, HitsAndInvalidation) {
+    ScopedInstance<ModuleIndex> scope;
+    auto& index = ModuleIndex::getInstance();
+
+    ModuleTree tree("invalidation");
+    tree.write("First.chtl");
+
+    // 第一次访问扫描目录，之后的查询都由内存回答
+    assertTrue(index.exists(tree.path("First.chtl")));
+    assertFalse(index.exists(tree.path("Second.chtl")));
+    assertTrue(index.exists(tree.path("First.chtl")));
+    auto stats = index.getStats();
+    assertTrue(stats.lookups == 3);
+    assertTrue(stats.misses == 1);
+    assertTrue(stats.hits == 2);
+
+    // 同一会话中不会察觉新文件
+    tree.write("Second.chtl");
+    assertFalse(index.exists(tree.path("Second.chtl")));
+
+    // 新会话：目录mtime已变化，重新扫描
+    index.beginSession();
+    assertTrue(index.exists(tree.path("Second.chtl")));
+    stats = index.getStats();
+    assertTrue(stats.invalidations == 1);
+    assertTrue(stats.revalidations == 1);
+
+    // 目录未变化时只做一次mtime检查
+    index.beginSession();
+    assertTrue(index.exists(tree.path("First.chtl")));
+    assertTrue(index.exists(tree.path("Second.chtl")));
+    stats = index.getStats();
+    assertTrue(stats.invalidations == 1);
+    assertTrue(stats.revalidations == 2);
+}
+
+CHTL_TEST(ModuleIndex, ImportResolution) {
+    ScopedInstance<ModuleIndex> scope;
+
+    // 当前目录的module文件夹使用分类结构，官方模块目录使用混杂结构
+    ModuleTree current("resolution_current");
+    current.write("module/CMOD/Box.chtl");
+    current.write("module/CJMOD/Box.cjjs");
+    current.write("Page.chtl");
+
+    ModuleTree official("resolution_official");
+    official.write("Chtholly.cmod");
+
+    ImportResolverConfig config;
+    config.currentDir = current.path();
+    config.officialModuleDir = official.path();
+    ImportResolver resolver(config);
+
+    auto box = resolver.resolvePath("Box", ImportFileType::CHTL);
+    assertTrue(box.has_value());
+    assertEqual(fs::path(*box).lexically_relative(current.path()).generic_string(), "module/CMOD/Box.chtl");
+
+    auto chtholly = resolver.resolvePath("chtl::Chtholly", ImportFileType::CMOD);
+    assertTrue(chtholly.has_value());
+    assertEqual(fs::path(*chtholly).filename().string(), "Chtholly.cmod");
+
+    auto page = resolver.resolvePath("Page", ImportFileType::CHTL);
+    assertTrue(page.has_value());
+    assertFalse(resolver.resolvePath("Nothing", ImportFileType::CHTL).has_value());
+
+    // 重复解析由索引回答
+    auto before = ModuleIndex::getInstance().getStats();
+    resolver.resolvePath("Box", ImportFileType::CHTL);
+    auto after = ModuleIndex::getInstance().getStats();
+    assertTrue(after.misses == before.misses);
+    assertTrue(after.hits > before.hits);
+}
+
+CHTL_TEST(ModuleIndex, WildcardImports) {
+    ScopedInstance<ModuleIndex> scope;
+
+    ModuleTree tree("wildcard");
+    tree.write("parts/Box.chtl");
+    tree.write("parts/Card.chtl");
+    tree.write("parts/Card.css");
+    std::ofstream(tree.path("page.chtl")) << "[Import] @Chtl from \"parts/*.chtl\"\n"
+                                             "[Import] @Chtl from \"par*/Box.chtl\"\n";
+
+    ImportResolverConfig config;
+    config.currentDir = tree.path();
+    ImportResolver resolver(config);
+    resolver.scanImports(tree.path("page.chtl"));
+
+    // 目录部分的通配符不展开，只有文件名部分的通配符匹配
+    std::vector<std::string> names;
+    for (const auto& file : resolver.getImportedFiles(tree.path("page.chtl"))) {
+        names.push_back(fs::path(file).lexically_relative(tree.path()).generic_string());
+    }
+    std::sort(names.begin(), names.end());
+    assertTrue(names == (std::vector<std::string>{"parts/Box.chtl", "parts/Card.chtl"}));
+}
+
+CHTL_TEST_SUITE(ModuleIndex) {
+    CHTL_ADD_TEST(ModuleIndex, ExistenceAndPrefixListing);
+    CHTL_ADD_TEST(ModuleIndex, HitsAndInvalidation);
+    CHTL_ADD_TEST(ModuleIndex, ImportResolution);
+    CHTL_ADD_TEST(ModuleIndex, WildcardImports);
+}
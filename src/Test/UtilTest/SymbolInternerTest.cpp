@@ -0,0 +1,122 @@
+#include "../CHTLTestSuite.h"
+#include "../../Util/SymbolInterner/SymbolInterner.h"
+#include "../../Util/SymbolInterner/SymbolMap.h"
+#include "../../CHTL/CHTLManage/NamespaceManager.h"
+#include <thread>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+CHTL_TEST(SymbolInterner, StableIds) {
+    auto& interner = SymbolInterner::getInstance();
+
+    SymbolId box = interner.intern("InternerTestBox");
+    assertTrue(box != INVALID_SYMBOL_ID);
+    assertTrue(interner.intern(std::string("InternerTestBox")) == box);
+    assertTrue(interner.find("InternerTestBox") == box);
+    assertEqual(std::string(interner.name(box)), "InternerTestBox");
+
+    assertTrue(interner.find("InternerTestNeverSeen") == INVALID_SYMBOL_ID);
+    assertTrue(interner.intern("") == INVALID_SYMBOL_ID);
+
+    // 多线程同时登记同一批名字得到相同的ID
+    std::vector<std::vector<SymbolId>> results(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                results[t].push_back(interner.intern("InternerThread" + std::to_string(i)));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 1; t < results.size(); ++t) {
+        assertTrue(results[t] == results[0]);
+    }
+}
+
+CHTL_TEST(SymbolInterner, QualifiedPaths) {
+    auto& interner = SymbolInterner::getInstance();
+
+    SymbolPath path = interner.internPath("space.room.Box");
+    assertEqual(std::string(interner.name(path.scope)), "space.room");
+    assertEqual(std::string(interner.name(path.leaf)), "Box");
+    assertTrue(interner.path(path.scope).scope == interner.find("space"));
+
+    // 拼接结果与直接驻留的限定名是同一个ID
+    assertTrue(interner.qualify(path.scope, path.leaf) == path.full);
+    assertTrue(interner.qualify(INVALID_SYMBOL_ID, path.leaf) == path.leaf);
+
+    SymbolPath plain = interner.internPath("Box");
+    assertTrue(plain.scope == INVALID_SYMBOL_ID);
+    assertTrue(plain.leaf == plain.full);
+}
+
+CHTL_TEST(SymbolInterner, SymbolMapBasics) {
+    SymbolMap<int> map;
+    assertTrue(map.find(1) == nullptr);
+
+    for (SymbolId id = 1; id <= 1000; ++id) {
+        map.assign(id, static_cast<int>(id) * 2);
+    }
+    assertTrue(map.size() == 1000);
+    for (SymbolId id = 1; id <= 1000; ++id) {
+        assertTrue(map.find(id) && *map.find(id) == static_cast<int>(id) * 2);
+    }
+    assertFalse(map.contains(1001));
+
+    // 覆盖不改变插入顺序
+    map.assign(5, -1);
+    assertTrue(map.size() == 1000);
+    assertTrue(map.begin()->first == 1);
+    assertTrue((map.begin() + 4)->second == -1);
+
+    map[2000] += 3;
+    assertTrue(*map.find(2000) == 3);
+
+    map.clear();
+    assertTrue(map.empty());
+    assertFalse(map.contains(5));
+}
+
+CHTL_TEST(SymbolInterner, NamespaceResolution) {
+    ScopedInstance<NamespaceManager> scoped;
+    auto& manager = NamespaceManager::getInstance();
+
+    manager.registerNamespace("space.room", NamespaceType::EXPLICIT, "a.chtl");
+    manager.addSymbolToNamespace("space", {"Wall", "template", "a.chtl", 1, 1});
+    manager.addSymbolToNamespace("space.room", {"Box", "custom", "a.chtl", 2, 1});
+
+    auto box = manager.resolveSymbol("space.room.Box");
+    assertTrue(box.has_value());
+    assertEqual(box->type, "custom");
+    assertTrue(manager.resolveSymbol("Wall").has_value());
+    assertFalse(manager.resolveSymbol("space.Box").has_value());
+
+    // 查找未登记的名字不会让驻留表增长
+    auto& interner = SymbolInterner::getInstance();
+    size_t before = interner.size();
+    assertFalse(manager.resolveSymbol("NeverRegisteredSymbol").has_value());
+    assertFalse(manager.resolveSymbol("space.NeverRegistered").has_value());
+    assertFalse(manager.resolveSymbol("nowhere.Box").has_value());
+    assertTrue(interner.size() == before);
+    assertTrue(interner.find("space.NeverRegistered") == INVALID_SYMBOL_ID);
+
+    // 整串未登记但两部分都已登记的限定名仍能解析
+    assertTrue(interner.find("space.Wall") == INVALID_SYMBOL_ID);
+    assertTrue(manager.resolveSymbol("space.Wall").has_value());
+
+    // 从子命名空间向上查找父命名空间中的符号
+    NamespaceResolver resolver(manager);
+    assertTrue(resolver.resolveSymbol("Wall", "space.room").has_value());
+    assertFalse(resolver.resolveSymbol("Missing", "space.room").has_value());
+}
+
+CHTL_TEST_SUITE(SymbolInterner) {
+    CHTL_ADD_TEST(SymbolInterner, StableIds);
+    CHTL_ADD_TEST(SymbolInterner, QualifiedPaths);
+    CHTL_ADD_TEST(SymbolInterner, SymbolMapBasics);
+    CHTL_ADD_TEST(SymbolInterner, NamespaceResolution);
+}
@@ -0,0 +1,86 @@
+#include "../CHTLTestSuite.h"
+#include "../../Util/ThreadPool/ThreadPool.h"
+#include <atomic>
+#include <set>
+#include <stdexcept>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+CHTL_TEST(ThreadPool, WaitIdleWaitsForAllTasks) {
+    // 任务极短时也不能在入队和计数之间被取走而让waitIdle提前返回
+    WorkStealingThreadPool pool(4);
+    for (int round = 0; round < 200; ++round) {
+        std::atomic<int> done{0};
+        for (int i = 0; i < 50; ++i) {
+            pool.post([&done]() { ++done; });
+        }
+        pool.waitIdle();
+        assertTrue(done == 50);
+    }
+}
+
+CHTL_TEST(ThreadPool, NestedPostsAreAwaited) {
+    // 工作线程内提交的任务放入自己的队列，由其他线程窃取
+    WorkStealingThreadPool pool(4);
+    std::atomic<int> done{0};
+    for (int i = 0; i < 16; ++i) {
+        pool.post([&pool, &done]() {
+            for (int j = 0; j < 16; ++j) {
+                pool.post([&done]() { ++done; });
+            }
+            ++done;
+        });
+    }
+    pool.waitIdle();
+    assertTrue(done == 16 * 17);
+}
+
+CHTL_TEST(ThreadPool, SubmitReturnsValuesAndExceptions) {
+    WorkStealingThreadPool pool(2);
+    std::vector<std::future<int>> futures;
+    for (int i = 0; i < 100; ++i) {
+        futures.push_back(pool.submit([i]() { return i * i; }));
+    }
+    int sum = 0;
+    for (auto& future : futures) {
+        sum += future.get();
+    }
+    assertTrue(sum == 328350);
+
+    auto failing = pool.submit([]() -> int { throw std::runtime_error("task failed"); });
+    assertThrows([&failing]() { failing.get(); });
+
+    // 抛出异常的任务不会终止工作线程
+    assertTrue(pool.submit([]() { return 7; }).get() == 7);
+}
+
+CHTL_TEST(ThreadPool, WorkerIndices) {
+    WorkStealingThreadPool pool(3);
+    assertTrue(pool.getWorkerCount() == 3);
+    assertTrue(WorkStealingThreadPool::currentWorkerIndex() == WorkStealingThreadPool::NOT_A_WORKER);
+
+    std::mutex mutex;
+    std::set<size_t> indices;
+    for (int i = 0; i < 64; ++i) {
+        pool.post([&mutex, &indices]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            indices.insert(WorkStealingThreadPool::currentWorkerIndex());
+        });
+    }
+    pool.waitIdle();
+    assertFalse(indices.empty());
+    for (size_t index : indices) {
+        assertTrue(index < 3);
+    }
+
+    assertTrue(WorkStealingThreadPool::resolveWorkerCount(5) == 5);
+    assertTrue(WorkStealingThreadPool::resolveWorkerCount(0) >= 1);
+}
+
+CHTL_TEST_SUITE(ThreadPool) {
+    CHTL_ADD_TEST(ThreadPool, WaitIdleWaitsForAllTasks);
+    CHTL_ADD_TEST(ThreadPool, NestedPostsAreAwaited);
+    CHTL_ADD_TEST(ThreadPool, SubmitReturnsValuesAndExceptions);
+    CHTL_ADD_TEST(ThreadPool, WorkerIndices);
+}
@@ -0,0 +1,66 @@
+#include "../CHTLTestSuite.h"
+#include "../../Util/ANTLRUtil/TwoStageParse.h"
+#include "../../CSS/generated/src/CSS/CSSSimpleLexer.h"
+#include "../../CSS/generated/src/CSS/CSSSimpleParser.h"
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+using CSSParse = TwoStageParse<CSSSimpleLexer, CSSSimpleParser, CSSSimpleParser::StylesheetContext>;
+
+bool hasErrorAt(const CSSParse& parse, size_t line, const std::string& fragment) {
+    for (const auto& error : parse.errors()) {
+        if (error.line == line && error.message.find(fragment) != std::string::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+CHTL_TEST(TwoStageParse, ValidInputStaysOnSLL) {
+    CSSParse parse(".box { color: red; }\n@media screen { p { margin: 0; } }\n", &CSSSimpleParser::stylesheet);
+    assertTrue(parse.tree() != nullptr);
+    assertFalse(parse.hasErrors());
+    assertFalse(parse.usedLLFallback());
+}
+
+CHTL_TEST(TwoStageParse, LexerErrorsSurviveLLFallback) {
+    // 第1行的 ` 是词法错误，在SLL阶段取记号时报告；第3行的语法错误触发LL重新解析
+    CSSParse parse(".box { color: red; } `\n"
+                   ".ok { margin: 0; }\n"
+                   ".bad { : 1 }\n",
+                   &CSSSimpleParser::stylesheet);
+    assertTrue(parse.usedLLFallback());
+    assertTrue(hasErrorAt(parse, 1, "token recognition error"));
+    assertTrue(parse.errors().size() >= 2);
+    bool syntaxErrorOnLine3 = false;
+    for (const auto& error : parse.errors()) {
+        syntaxErrorOnLine3 = syntaxErrorOnLine3 || error.line == 3;
+    }
+    assertTrue(syntaxErrorOnLine3);
+}
+
+CHTL_TEST(TwoStageParse, LexerErrorsAfterBailPointAreReportedOnce) {
+    // SLL在第1行放弃，第2行的词法错误只在LL阶段取记号时报告一次
+    CSSParse parse(".bad { : 1 }\n"
+                   ".box { color: red; } `\n",
+                   &CSSSimpleParser::stylesheet);
+    assertTrue(parse.usedLLFallback());
+    size_t lexerErrors = 0;
+    for (const auto& error : parse.errors()) {
+        if (error.message.find("token recognition error") != std::string::npos) {
+            ++lexerErrors;
+        }
+    }
+    assertTrue(lexerErrors == 1);
+}
+
+CHTL_TEST_SUITE(TwoStageParse) {
+    CHTL_ADD_TEST(TwoStageParse, ValidInputStaysOnSLL);
+    CHTL_ADD_TEST(TwoStageParse, LexerErrorsSurviveLLFallback);
+    CHTL_ADD_TEST(TwoStageParse, LexerErrorsAfterBailPointAreReportedOnce);
+}
@@ -0,0 +1,238 @@
+#include "../CHTLTestSuite.h"
+#include "../../Util/ZIPUtil/ZIPUtil.h"
+#include "../../Util/ZIPUtil/Deflate.h"
+#include "../../Util/ZIPUtil/CRC32.h"
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+using namespace CHTL;
+using namespace CHTL::Test;
+
+namespace {
+
+std::string makeSample(size_t size, unsigned seed) {
+    std::mt19937 rng(seed);
+    const char* words[] = {"div", "style", "text", "{", "}", ";", "color: red", "\n", "    ", "@Element Box"};
+    std::string sample;
+    while (sample.size() < size) {
+        sample += words[rng() % 10];
+        if (rng() % 16 == 0) {
+            sample += static_cast<char>(rng() & 0xFF);
+        }
+    }
+    sample.resize(size);
+    return sample;
+}
+
+std::string makeRandom(size_t size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::string data(size, '\0');
+    for (char& c : data) {
+        c = static_cast<char>(rng() & 0xFF);
+    }
+    return data;
+}
+
+} // namespace
+
+CHTL_TEST(ZIPUtil, CRC32KnownValues) {
+    assertTrue(CRC32::compute("", 0) == 0u);
+    assertTrue(CRC32::compute("123456789", 9) == 0xCBF43926u);
+
+    std::string sample = makeSample(100000, 1);
+    assertTrue(CRC32::compute(sample.data(), sample.size()) ==
+               CRC32::updateBytewise(0, sample.data(), sample.size()));
+
+    // 分段计算与一次计算一致
+    uint32_t crc = CRC32::update(0, sample.data(), 12345);
+    crc = CRC32::update(crc, sample.data() + 12345, sample.size() - 12345);
+    assertTrue(crc == CRC32::compute(sample.data(), sample.size()));
+}
+
+CHTL_TEST(ZIPUtil, DeflateRoundTrip) {
+    std::vector<std::string> samples = {
+        "", "a", "abcabcabcabcabcabc", std::string(300000, 'x'), makeSample(200000, 2)
+    };
+
+    for (const auto& sample : samples) {
+        for (int level : {0, 1, 6, 9}) {
+            std::string compressed = Deflater::compress(sample, level);
+            auto restored = Inflater::decompress(compressed, sample.size());
+            assertTrue(restored.has_value());
+            assertEqual(*restored, sample);
+        }
+    }
+
+    // 分块输入与一次性输入解压结果相同
+    std::string sample = makeSample(150000, 3);
+    Deflater deflater(6);
+    std::string compressed;
+    for (size_t i = 0; i < sample.size(); i += 777) {
+        deflater.deflate(sample.data() + i, std::min<size_t>(777, sample.size() - i), false, compressed);
+    }
+    deflater.deflate(nullptr, 0, true, compressed);
+    assertEqual(*Inflater::decompress(compressed), sample);
+    assertTrue(compressed.size() < sample.size() / 2);
+
+    // 截断的数据流应报错
+    assertFalse(Inflater::decompress(compressed.substr(0, compressed.size() / 2)).has_value());
+}
+
+CHTL_TEST(ZIPUtil, ArchiveRoundTrip) {
+    const std::string archivePath = "zip_test.cmod";
+    std::string large = makeSample(500000, 4);
+
+    ZIPUtil zip;
+    zip.setCompressionLevel(6);
+    assertTrue(zip.createArchive(archivePath));
+    assertTrue(zip.addFromMemory("info/module.info", "name: Box\nversion: 1.0\n"));
+    assertTrue(zip.addFromMemory("src/Box.chtl", large));
+    assertTrue(zip.addFromMemory("empty.txt", ""));
+    assertTrue(zip.finalize());
+
+    // 压缩后明显小于原始数据
+    assertTrue(std::filesystem::file_size(archivePath) < large.size() / 2);
+
+    auto files = zip.listFiles(archivePath);
+    assertTrue(files.size() == 3);
+    assertEqual(files[1].filename, "src/Box.chtl");
+    assertTrue(files[1].uncompressedSize == large.size());
+    assertTrue(files[1].compressionMethod == 8);
+
+    assertEqual(zip.readFileToString(archivePath, "src/Box.chtl"), large);
+    assertEqual(zip.readFileToString(archivePath, "empty.txt"), "");
+
+    // 流式读取
+    ZIPReader reader;
+    assertTrue(reader.open(archivePath));
+    assertTrue(reader.locateFile("src/Box.chtl"));
+    std::string streamed;
+    char buffer[4096];
+    size_t count;
+    while ((count = reader.read(buffer, sizeof(buffer))) > 0) {
+        streamed.append(buffer, count);
+    }
+    assertTrue(reader.getLastError().empty());
+    assertEqual(streamed, large);
+    reader.close();
+
+    std::filesystem::remove(archivePath);
+}
+
+CHTL_TEST(ZIPUtil, MappedArchiveView) {
+    const std::string archivePath = "zip_view_test.cmod";
+
+    ZIPWriter writer;
+    assertTrue(writer.create(archivePath));
+    assertTrue(writer.beginFile("info/module.info", 0));
+    assertTrue(writer.write("name: Box\n", 10));
+    assertTrue(writer.beginFile("src/A.chtl", 6));
+    assertTrue(writer.write("div { text { \"A\" } }", 20));
+    std::string b;
+    for (int i = 0; i < 64; ++i) {
+        b += "span { }\n";
+    }
+    assertTrue(writer.beginFile("src/B.chtl", 6));
+    assertTrue(writer.write(b.data(), b.size()));
+    assertTrue(writer.close());
+
+    ZIPArchiveView view;
+    assertTrue(view.open(archivePath));
+    assertTrue(view.contains("src/A.chtl"));
+    assertFalse(view.contains("src/C.chtl"));
+
+    // 不压缩的条目直接返回映射中的切片，不需要解压
+    assertEqual(std::string(*view.getEntry("info/module.info")), "name: Box\n");
+    assertTrue(view.getInflatedCount() == 0);
+
+    // 只解压被访问的条目，且只解压一次
+    assertEqual(std::string(*view.getEntry("src/B.chtl")), b);
+    assertEqual(std::string(*view.getEntry("src/B.chtl")), b);
+    assertTrue(view.getInflatedCount() == 1);
+    assertFalse(view.getEntry("src/C.chtl").has_value());
+
+    view.close();
+    std::filesystem::remove(archivePath);
+}
+
+CHTL_TEST(ZIPUtil, IncompressibleEntriesAreStored) {
+    const std::string archivePath = "zip_store_test.cmod";
+    std::string compressible = makeSample(20000, 6);
+    std::string random = makeRandom(1000, 7);
+    std::string largeRandom = makeRandom(300000, 8);
+
+    ZIPUtil zip;
+    zip.setCompressionLevel(6);
+    assertTrue(zip.createArchive(archivePath));
+    assertTrue(zip.addFromMemory("tiny.txt", "a"));
+    assertTrue(zip.addFromMemory("random.bin", random));
+    assertTrue(zip.addFromMemory("large.bin", largeRandom));
+    assertTrue(zip.addFromMemory("empty.txt", ""));
+    assertTrue(zip.addFromMemory("text.chtl", compressible));
+    assertTrue(zip.finalize());
+
+    // 压缩后不比原始数据小的条目改为不压缩存储
+    auto files = zip.listFiles(archivePath);
+    assertTrue(files.size() == 5);
+    for (size_t i = 0; i < 4; ++i) {
+        assertTrue(files[i].compressionMethod == 0);
+        assertTrue(files[i].compressedSize == files[i].uncompressedSize);
+    }
+    assertTrue(files[4].compressionMethod == 8);
+    assertTrue(files[4].compressedSize < files[4].uncompressedSize);
+
+    assertEqual(zip.readFileToString(archivePath, "tiny.txt"), "a");
+    assertEqual(zip.readFileToString(archivePath, "random.bin"), random);
+    assertEqual(zip.readFileToString(archivePath, "large.bin"), largeRandom);
+    assertEqual(zip.readFileToString(archivePath, "empty.txt"), "");
+    assertEqual(zip.readFileToString(archivePath, "text.chtl"), compressible);
+
+    ZIPArchiveView view;
+    assertTrue(view.open(archivePath));
+    assertEqual(std::string(*view.getEntry("large.bin")), largeRandom);
+    assertTrue(view.getInflatedCount() == 0);
+    view.close();
+
+    std::filesystem::remove(archivePath);
+}
+
+CHTL_TEST(ZIPUtil, CorruptedEntryDetected) {
+    const std::string archivePath = "zip_corrupt_test.cmod";
+    std::string content = makeSample(20000, 5);
+
+    ZIPWriter writer;
+    assertTrue(writer.create(archivePath));
+    assertTrue(writer.beginFile("data.txt", 0));
+    assertTrue(writer.write(content.data(), content.size()));
+    assertTrue(writer.close());
+
+    // 修改条目数据中的一个字节
+    {
+        std::fstream file(archivePath, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(1000);
+        char byte = static_cast<char>(file.get());
+        file.seekp(1000);
+        file.put(static_cast<char>(byte ^ 0x55));
+    }
+
+    ZIPArchiveView view;
+    assertTrue(view.open(archivePath));
+    assertFalse(view.getEntry("data.txt").has_value());
+
+    ZIPUtil zip;
+    assertEqual(zip.readFileToString(archivePath, "data.txt"), "");
+    assertFalse(zip.getLastError().empty());
+
+    view.close();
+    std::filesystem::remove(archivePath);
+}
+
+CHTL_TEST_SUITE(ZIPUtil) {
+    CHTL_ADD_TEST(ZIPUtil, CRC32KnownValues);
+    CHTL_ADD_TEST(ZIPUtil, DeflateRoundTrip);
+    CHTL_ADD_TEST(ZIPUtil, ArchiveRoundTrip);
+    CHTL_ADD_TEST(ZIPUtil, MappedArchiveView);
+    CHTL_ADD_TEST(ZIPUtil, IncompressibleEntriesAreStored);
+    CHTL_ADD_TEST(ZIPUtil, CorruptedEntryDetected);
+}
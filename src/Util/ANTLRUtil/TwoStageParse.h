@@ -0,0 +1,167 @@
+#ifndef CHTL_TWO_STAGE_PARSE_H
+#define CHTL_TWO_STAGE_PARSE_H
+
+#include <antlr4-runtime.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace CHTL {
+
+// 语法错误（由调用者决定是否上报）
+struct ANTLRSyntaxError {
+    size_t line;
+    size_t column;
+    std::string message;
+};
+
+// 两阶段解析统计（进程内所有语法共用）
+struct TwoStageParseStats {
+    std::atomic<size_t> parses{0};          // 实际执行的解析次数
+    std::atomic<size_t> sllSuccesses{0};    // SLL阶段即成功
+    std::atomic<size_t> llFallbacks{0};     // SLL放弃后以LL重新解析
+    std::atomic<size_t> reusedParses{0};    // validate与compile共用的解析
+
+    static TwoStageParseStats& getInstance() {
+        static TwoStageParseStats instance;
+        return instance;
+    }
+};
+
+// 收集语法错误的监听器
+class SyntaxErrorCollector : public antlr4::BaseErrorListener {
+public:
+    explicit SyntaxErrorCollector(std::vector<ANTLRSyntaxError>& errors) : errors_(errors) {}
+
+    void syntaxError(antlr4::Recognizer*, antlr4::Token*, size_t line, size_t charPositionInLine,
+                     const std::string& msg, std::exception_ptr) override {
+        errors_.push_back({line, charPositionInLine, msg});
+    }
+
+private:
+    std::vector<ANTLRSyntaxError>& errors_;
+};
+
+// 两阶段解析
+// 先以SLL预测配合BailErrorStrategy解析：绝大多数正确的片段在这一阶段完成，
+// 且不需要LL完整上下文预测的开销；一旦出错立即放弃，重置记号流后以LL预测和
+// 默认的错误恢复策略重新解析，这时报告的错误与纯LL解析完全一致。
+//
+// 生成的语法分析器（ANTLR 4.13）把ATN、DFA和PredictionContext缓存放在
+// 进程级的静态数据中，由运行时加锁保护，因此每次新建的解析器都复用此前
+// 所有解析（包括其他线程）积累的DFA状态。这里不调用clearDFA()，并在首次
+// 使用时以warmUpSource预热一次。
+//
+// 对象持有输入流、词法分析器、记号流和语法分析器，语法树随对象一同释放。
+template <typename LexerT, typename ParserT, typename RootT>
+class TwoStageParse {
+public:
+    using StartRule = RootT* (ParserT::*)();
+
+    TwoStageParse(std::string code, StartRule startRule)
+        : code_(std::move(code)),
+          input_(code_),
+          lexer_(&input_),
+          tokens_(&lexer_),
+          parser_(&tokens_),
+          collector_(errors_) {
+        lexer_.removeErrorListeners();
+        lexer_.addErrorListener(&collector_);
+        parser_.removeErrorListeners();
+        run(startRule);
+    }
+
+    TwoStageParse(const TwoStageParse&) = delete;
+    TwoStageParse& operator=(const TwoStageParse&) = delete;
+
+    const std::string& code() const { return code_; }
+    RootT* tree() const { return tree_; }
+    ParserT& parser() { return parser_; }
+    antlr4::CommonTokenStream& tokens() { return tokens_; }
+
+    bool hasErrors() const { return !errors_.empty(); }
+    const std::vector<ANTLRSyntaxError>& errors() const { return errors_; }
+    bool usedLLFallback() const { return usedLL_; }
+
+    // 进程内只执行一次，用一小段典型代码建立常用的DFA状态
+    static void warmUp(const std::string& warmUpSource, StartRule startRule) {
+        static std::once_flag once;
+        std::call_once(once, [&]() {
+            TwoStageParse warm(warmUpSource, startRule);
+        });
+    }
+
+private:
+    void run(StartRule startRule) {
+        auto& stats = TwoStageParseStats::getInstance();
+        ++stats.parses;
+
+        auto* interpreter = parser_.template getInterpreter<antlr4::atn::ParserATNSimulator>();
+
+        // 第一阶段：SLL + 遇错即停（语法分析器不挂监听器，收集到的都是词法错误）
+        interpreter->setPredictionMode(antlr4::atn::PredictionMode::SLL);
+        parser_.setErrorHandler(std::make_shared<antlr4::BailErrorStrategy>());
+        try {
+            tree_ = (parser_.*startRule)();
+            ++stats.sllSuccesses;
+            return;
+        } catch (const antlr4::ParseCancellationException&) {
+            // 转入第二阶段
+        }
+
+        // 第二阶段：LL + 默认错误恢复，报告全部语法错误
+        // 第一阶段取记号时收集的词法错误全部保留；记号流被缓冲，已取的记号不会重新
+        // 词法分析，放弃点之后的词法错误在这一阶段取记号时收集，不会重复
+        ++stats.llFallbacks;
+        usedLL_ = true;
+        tokens_.seek(0);
+        parser_.reset();
+        parser_.setErrorHandler(std::make_shared<antlr4::DefaultErrorStrategy>());
+        parser_.addErrorListener(&collector_);
+        interpreter->setPredictionMode(antlr4::atn::PredictionMode::LL);
+        tree_ = (parser_.*startRule)();
+    }
+
+    std::string code_;
+    std::vector<ANTLRSyntaxError> errors_;
+    antlr4::ANTLRInputStream input_;
+    LexerT lexer_;
+    antlr4::CommonTokenStream tokens_;
+    ParserT parser_;
+    SyntaxErrorCollector collector_;
+    RootT* tree_ = nullptr;
+    bool usedLL_ = false;
+};
+
+// 同一线程中最近一次解析的结果
+// validate()把解析结果留在这里，随后对同一段代码的compile()直接取走，
+// 调度器先验证后编译的片段因此只解析一次。
+template <typename ParseT>
+class LastParseSlot {
+public:
+    template <typename... Args>
+    static std::shared_ptr<ParseT> acquire(const std::string& code, Args&&... args) {
+        auto& slot = current();
+        if (slot && slot->code() == code) {
+            ++TwoStageParseStats::getInstance().reusedParses;
+            return std::move(slot);
+        }
+        return std::make_shared<ParseT>(code, std::forward<Args>(args)...);
+    }
+
+    static void keep(std::shared_ptr<ParseT> parse) {
+        current() = std::move(parse);
+    }
+
+private:
+    static std::shared_ptr<ParseT>& current() {
+        thread_local std::shared_ptr<ParseT> slot;
+        return slot;
+    }
+};
+
+} // namespace CHTL
+
+#endif // CHTL_TWO_STAGE_PARSE_H
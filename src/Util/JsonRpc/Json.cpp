@@ -0,0 +1,428 @@
+#include "Json.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace CHTL {
+
+namespace {
+
+constexpr size_t MAX_DEPTH = 256;     // 嵌套深度上限，防止恶意输入耗尽栈
+
+void appendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+void appendEscaped(std::string& out, const std::string& text) {
+    out += '"';
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned>(c));
+                    out += buffer;
+                } else {
+                    out += c;
+                }
+                break;
+        }
+    }
+    out += '"';
+}
+
+void appendNumber(std::string& out, double value) {
+    if (!std::isfinite(value)) {
+        // JSON没有NaN/Infinity
+        out += "null";
+        return;
+    }
+    char buffer[32];
+    if (value == std::floor(value) && std::fabs(value) < 1e15) {
+        std::snprintf(buffer, sizeof(buffer), "%.0f", value);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    }
+    out += buffer;
+}
+
+// 递归下降解析器
+class Parser {
+public:
+    explicit Parser(std::string_view text) : text_(text) {}
+
+    std::optional<JsonValue> parseDocument(std::string* error) {
+        JsonValue value;
+        if (!parseValue(value, 0)) {
+            if (error) {
+                *error = error_ + " at offset " + std::to_string(position_);
+            }
+            return std::nullopt;
+        }
+        skipWhitespace();
+        if (position_ != text_.size()) {
+            if (error) {
+                *error = "Unexpected trailing characters at offset " + std::to_string(position_);
+            }
+            return std::nullopt;
+        }
+        return value;
+    }
+
+private:
+    std::string_view text_;
+    size_t position_ = 0;
+    std::string error_;
+
+    bool fail(const char* message) {
+        error_ = message;
+        return false;
+    }
+
+    void skipWhitespace() {
+        while (position_ < text_.size()) {
+            char c = text_[position_];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                break;
+            }
+            ++position_;
+        }
+    }
+
+    bool consumeLiteral(std::string_view literal) {
+        if (text_.substr(position_, literal.size()) != literal) {
+            return fail("Invalid literal");
+        }
+        position_ += literal.size();
+        return true;
+    }
+
+    bool parseValue(JsonValue& out, size_t depth) {
+        if (depth > MAX_DEPTH) {
+            return fail("Nesting too deep");
+        }
+        skipWhitespace();
+        if (position_ >= text_.size()) {
+            return fail("Unexpected end of input");
+        }
+        switch (text_[position_]) {
+            case 'n': out = JsonValue(); return consumeLiteral("null");
+            case 't': out = JsonValue(true); return consumeLiteral("true");
+            case 'f': out = JsonValue(false); return consumeLiteral("false");
+            case '"': {
+                std::string text;
+                if (!parseString(text)) {
+                    return false;
+                }
+                out = JsonValue(std::move(text));
+                return true;
+            }
+            case '[': return parseArray(out, depth);
+            case '{': return parseObject(out, depth);
+            default: return parseNumber(out);
+        }
+    }
+
+    bool parseNumber(JsonValue& out) {
+        size_t start = position_;
+        if (position_ < text_.size() && text_[position_] == '-') {
+            ++position_;
+        }
+        size_t digits = position_;
+        while (position_ < text_.size() &&
+               (std::isdigit(static_cast<unsigned char>(text_[position_])) ||
+                text_[position_] == '.' || text_[position_] == 'e' || text_[position_] == 'E' ||
+                text_[position_] == '+' || text_[position_] == '-')) {
+            ++position_;
+        }
+        if (position_ == digits) {
+            return fail("Unexpected character");
+        }
+        std::string number(text_.substr(start, position_ - start));
+        char* end = nullptr;
+        double value = std::strtod(number.c_str(), &end);
+        if (end != number.c_str() + number.size()) {
+            position_ = start;
+            return fail("Invalid number");
+        }
+        out = JsonValue(value);
+        return true;
+    }
+
+    bool parseHex4(uint32_t& value) {
+        if (position_ + 4 > text_.size()) {
+            return fail("Truncated unicode escape");
+        }
+        value = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            char c = text_[position_++];
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') value |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') value |= static_cast<uint32_t>(c - 'A' + 10);
+            else return fail("Invalid unicode escape");
+        }
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        ++position_;    // "
+        while (position_ < text_.size()) {
+            char c = text_[position_++];
+            if (c == '"') {
+                return true;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (position_ >= text_.size()) {
+                break;
+            }
+            char escape = text_[position_++];
+            switch (escape) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t codePoint;
+                    if (!parseHex4(codePoint)) {
+                        return false;
+                    }
+                    // 代理对
+                    if (codePoint >= 0xD800 && codePoint <= 0xDBFF &&
+                        text_.substr(position_, 2) == "\\u") {
+                        position_ += 2;
+                        uint32_t low;
+                        if (!parseHex4(low)) {
+                            return false;
+                        }
+                        if (low >= 0xDC00 && low <= 0xDFFF) {
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        } else {
+                            appendUtf8(out, codePoint);
+                            codePoint = low;
+                        }
+                    }
+                    appendUtf8(out, codePoint);
+                    break;
+                }
+                default:
+                    return fail("Invalid escape");
+            }
+        }
+        return fail("Unterminated string");
+    }
+
+    bool parseArray(JsonValue& out, size_t depth) {
+        ++position_;    // [
+        out = JsonValue::array();
+        skipWhitespace();
+        if (position_ < text_.size() && text_[position_] == ']') {
+            ++position_;
+            return true;
+        }
+        while (true) {
+            JsonValue element;
+            if (!parseValue(element, depth + 1)) {
+                return false;
+            }
+            out.push(std::move(element));
+            skipWhitespace();
+            if (position_ >= text_.size()) {
+                return fail("Unterminated array");
+            }
+            char c = text_[position_++];
+            if (c == ']') {
+                return true;
+            }
+            if (c != ',') {
+                return fail("Expected ',' or ']'");
+            }
+        }
+    }
+
+    bool parseObject(JsonValue& out, size_t depth) {
+        ++position_;    // {
+        out = JsonValue::object();
+        skipWhitespace();
+        if (position_ < text_.size() && text_[position_] == '}') {
+            ++position_;
+            return true;
+        }
+        while (true) {
+            skipWhitespace();
+            if (position_ >= text_.size() || text_[position_] != '"') {
+                return fail("Expected member name");
+            }
+            std::string key;
+            if (!parseString(key)) {
+                return false;
+            }
+            skipWhitespace();
+            if (position_ >= text_.size() || text_[position_] != ':') {
+                return fail("Expected ':'");
+            }
+            ++position_;
+            JsonValue member;
+            if (!parseValue(member, depth + 1)) {
+                return false;
+            }
+            out.set(std::move(key), std::move(member));
+            skipWhitespace();
+            if (position_ >= text_.size()) {
+                return fail("Unterminated object");
+            }
+            char c = text_[position_++];
+            if (c == '}') {
+                return true;
+            }
+            if (c != ',') {
+                return fail("Expected ',' or '}'");
+            }
+        }
+    }
+};
+
+} // namespace
+
+const std::string& JsonValue::asString() const {
+    static const std::string empty;
+    return isString() ? string_ : empty;
+}
+
+const JsonValue::Array& JsonValue::asArray() const {
+    static const Array empty;
+    return isArray() ? array_ : empty;
+}
+
+const JsonValue::Object& JsonValue::asObject() const {
+    static const Object empty;
+    return isObject() ? object_ : empty;
+}
+
+const JsonValue* JsonValue::find(std::string_view key) const {
+    if (!isObject()) {
+        return nullptr;
+    }
+    for (const auto& [name, value] : object_) {
+        if (name == key) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+JsonValue& JsonValue::set(std::string key, JsonValue value) {
+    if (!isObject()) {
+        *this = object();
+    }
+    for (auto& [name, existing] : object_) {
+        if (name == key) {
+            existing = std::move(value);
+            return existing;
+        }
+    }
+    object_.emplace_back(std::move(key), std::move(value));
+    return object_.back().second;
+}
+
+JsonValue& JsonValue::push(JsonValue value) {
+    if (!isArray()) {
+        *this = array();
+    }
+    array_.push_back(std::move(value));
+    return array_.back();
+}
+
+std::string JsonValue::serialize() const {
+    std::string out;
+    serializeTo(out);
+    return out;
+}
+
+void JsonValue::serializeTo(std::string& out) const {
+    switch (type_) {
+        case Type::NUL:
+            out += "null";
+            break;
+        case Type::BOOLEAN:
+            out += bool_ ? "true" : "false";
+            break;
+        case Type::NUMBER:
+            appendNumber(out, number_);
+            break;
+        case Type::STRING:
+            appendEscaped(out, string_);
+            break;
+        case Type::ARRAY:
+            out += '[';
+            for (size_t i = 0; i < array_.size(); ++i) {
+                if (i > 0) {
+                    out += ',';
+                }
+                array_[i].serializeTo(out);
+            }
+            out += ']';
+            break;
+        case Type::OBJECT:
+            out += '{';
+            for (size_t i = 0; i < object_.size(); ++i) {
+                if (i > 0) {
+                    out += ',';
+                }
+                appendEscaped(out, object_[i].first);
+                out += ':';
+                object_[i].second.serializeTo(out);
+            }
+            out += '}';
+            break;
+    }
+}
+
+std::optional<JsonValue> JsonValue::parse(std::string_view text, std::string* error) {
+    return Parser(text).parseDocument(error);
+}
+
+bool JsonValue::operator==(const JsonValue& other) const {
+    if (type_ != other.type_) {
+        return false;
+    }
+    switch (type_) {
+        case Type::NUL: return true;
+        case Type::BOOLEAN: return bool_ == other.bool_;
+        case Type::NUMBER: return number_ == other.number_;
+        case Type::STRING: return string_ == other.string_;
+        case Type::ARRAY: return array_ == other.array_;
+        case Type::OBJECT: return object_ == other.object_;
+    }
+    return false;
+}
+
+} // namespace CHTL
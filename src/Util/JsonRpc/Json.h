@@ -0,0 +1,89 @@
+#ifndef UTIL_JSON_H
+#define UTIL_JSON_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace CHTL {
+
+// JSON值
+// 只用于编译服务的消息和诊断输出，不追求通用JSON库的性能。
+// 对象按插入顺序保存成员，序列化结果稳定，便于比较和测试。
+class JsonValue {
+public:
+    enum class Type : uint8_t {
+        NUL,
+        BOOLEAN,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT
+    };
+
+    using Array = std::vector<JsonValue>;
+    using Object = std::vector<std::pair<std::string, JsonValue>>;
+
+    JsonValue() = default;
+    JsonValue(std::nullptr_t) {}
+    JsonValue(bool value) : type_(Type::BOOLEAN), bool_(value) {}
+    JsonValue(double value) : type_(Type::NUMBER), number_(value) {}
+    template<typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    JsonValue(T value) : type_(Type::NUMBER), number_(static_cast<double>(value)) {}
+    JsonValue(const char* value) : type_(Type::STRING), string_(value) {}
+    JsonValue(std::string value) : type_(Type::STRING), string_(std::move(value)) {}
+    JsonValue(std::string_view value) : type_(Type::STRING), string_(value) {}
+
+    static JsonValue array() { JsonValue value; value.type_ = Type::ARRAY; return value; }
+    static JsonValue object() { JsonValue value; value.type_ = Type::OBJECT; return value; }
+
+    Type getType() const { return type_; }
+    bool isNull() const { return type_ == Type::NUL; }
+    bool isBool() const { return type_ == Type::BOOLEAN; }
+    bool isNumber() const { return type_ == Type::NUMBER; }
+    bool isString() const { return type_ == Type::STRING; }
+    bool isArray() const { return type_ == Type::ARRAY; }
+    bool isObject() const { return type_ == Type::OBJECT; }
+
+    // 类型不符时返回fallback或空值
+    bool asBool(bool fallback = false) const { return isBool() ? bool_ : fallback; }
+    double asNumber(double fallback = 0) const { return isNumber() ? number_ : fallback; }
+    const std::string& asString() const;
+    const Array& asArray() const;
+    const Object& asObject() const;
+
+    // 对象成员查找，不存在或不是对象时返回nullptr
+    const JsonValue* find(std::string_view key) const;
+
+    // 设置对象成员（非对象时先变为空对象），同名成员被替换
+    JsonValue& set(std::string key, JsonValue value);
+
+    // 追加数组元素（非数组时先变为空数组）
+    JsonValue& push(JsonValue value);
+
+    // 紧凑格式序列化
+    std::string serialize() const;
+    void serializeTo(std::string& out) const;
+
+    // 解析，失败时返回std::nullopt并写入error
+    static std::optional<JsonValue> parse(std::string_view text, std::string* error = nullptr);
+
+    bool operator==(const JsonValue& other) const;
+    bool operator!=(const JsonValue& other) const { return !(*this == other); }
+
+private:
+    Type type_ = Type::NUL;
+    bool bool_ = false;
+    double number_ = 0;
+    std::string string_;
+    Array array_;
+    Object object_;
+};
+
+} // namespace CHTL
+
+#endif // UTIL_JSON_H
@@ -0,0 +1,220 @@
+#include "JsonRpcServer.h"
+#include <cctype>
+#include <istream>
+#include <ostream>
+
+namespace CHTL {
+
+namespace {
+
+constexpr size_t MAX_MESSAGE_SIZE = 64 * 1024 * 1024;
+
+bool startsWithIgnoreCase(const std::string& text, const char* prefix) {
+    size_t i = 0;
+    for (; prefix[i]; ++i) {
+        if (i >= text.size() ||
+            std::tolower(static_cast<unsigned char>(text[i])) != std::tolower(static_cast<unsigned char>(prefix[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+JsonRpcServer::JsonRpcServer(std::istream& in, std::ostream& out, size_t workerCount)
+    : in_(in), out_(out), pool_(workerCount) {}
+
+JsonRpcServer::~JsonRpcServer() {
+    pool_.waitIdle();
+}
+
+void JsonRpcServer::setHandler(const std::string& method, Handler handler) {
+    handlers_[method] = std::move(handler);
+}
+
+bool JsonRpcServer::readMessage(std::istream& in, std::string& body) {
+    const char* lengthHeader = "Content-Length:";
+    size_t length = 0;
+    bool hasLength = false;
+    std::string line;
+
+    // 头部以空行结束，未知头部（如Content-Type）忽略
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty()) {
+            if (!hasLength) {
+                continue;   // 消息之间多余的空行
+            }
+            break;
+        }
+        if (startsWithIgnoreCase(line, lengthHeader)) {
+            try {
+                length = std::stoul(line.substr(std::char_traits<char>::length(lengthHeader)));
+            } catch (const std::exception&) {
+                return false;
+            }
+            hasLength = true;
+        }
+    }
+    if (!hasLength || !in || length > MAX_MESSAGE_SIZE) {
+        return false;
+    }
+
+    body.resize(length);
+    in.read(&body[0], static_cast<std::streamsize>(length));
+    return static_cast<size_t>(in.gcount()) == length;
+}
+
+void JsonRpcServer::writeMessage(std::ostream& out, const std::string& body) {
+    out << "Content-Length: " << body.size() << "\r\n\r\n" << body;
+    out.flush();
+}
+
+int JsonRpcServer::run() {
+    bool exitRequested = false;
+    std::string body;
+    while (!exitRequested && readMessage(in_, body)) {
+        exitRequested = !dispatch(body);
+    }
+
+    // 输入结束或收到exit后仍把已接收的请求处理完
+    pool_.waitIdle();
+    return exitRequested && shutdownRequested_ ? 0 : 1;
+}
+
+bool JsonRpcServer::dispatch(const std::string& body) {
+    std::string error;
+    auto message = JsonValue::parse(body, &error);
+    if (!message) {
+        sendError(JsonValue(), JsonRpcErrorCode::PARSE_ERROR, error);
+        return true;
+    }
+    if (!message->isObject()) {
+        // 不支持批量请求
+        sendError(JsonValue(), JsonRpcErrorCode::INVALID_REQUEST, "Expected a request object");
+        return true;
+    }
+
+    const JsonValue* id = message->find("id");
+    const JsonValue* method = message->find("method");
+    if (!method || !method->isString() ||
+        (id && !id->isString() && !id->isNumber() && !id->isNull())) {
+        sendError(id ? *id : JsonValue(), JsonRpcErrorCode::INVALID_REQUEST, "Invalid request");
+        return true;
+    }
+
+    const JsonValue* params = message->find("params");
+    JsonValue paramsValue = params ? *params : JsonValue::object();
+
+    if (!id) {
+        // 通知不回复
+        if (method->asString() == "exit") {
+            return false;
+        }
+        if (method->asString() == "$/cancelRequest") {
+            if (const JsonValue* target = paramsValue.find("id")) {
+                cancel(*target);
+            }
+        }
+        return true;
+    }
+
+    if (shutdownRequested_) {
+        sendError(*id, JsonRpcErrorCode::INVALID_REQUEST, "Server is shutting down");
+        return true;
+    }
+
+    if (method->asString() == "shutdown") {
+        // 回复前先处理完所有已接收的请求
+        shutdownRequested_ = true;
+        pool_.waitIdle();
+        sendResult(*id, JsonValue());
+        return true;
+    }
+
+    handleRequest(method->asString(), std::move(paramsValue), *id);
+    return true;
+}
+
+void JsonRpcServer::handleRequest(std::string method, JsonValue params, JsonValue id) {
+    auto handler = handlers_.find(method);
+    if (handler == handlers_.end()) {
+        sendError(id, JsonRpcErrorCode::METHOD_NOT_FOUND, "Method not found: " + method);
+        return;
+    }
+
+    auto request = std::make_shared<Request>();
+    request->method_ = std::move(method);
+    request->params_ = std::move(params);
+    request->id_ = std::move(id);
+    request->cancelled_ = std::make_shared<std::atomic<bool>>(false);
+
+    std::string key = request->id_.serialize();
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_[key] = request->cancelled_;
+    }
+
+    const Handler* function = &handler->second;
+    pool_.post([this, request, key, function]() {
+        if (request->isCancelled()) {
+            sendError(request->id_, JsonRpcErrorCode::REQUEST_CANCELLED, "Request cancelled");
+        } else {
+            try {
+                JsonValue result = (*function)(*request);
+                // 处理期间被取消的请求丢弃结果
+                if (request->isCancelled()) {
+                    sendError(request->id_, JsonRpcErrorCode::REQUEST_CANCELLED, "Request cancelled");
+                } else {
+                    sendResult(request->id_, std::move(result));
+                }
+            } catch (const JsonRpcError& e) {
+                sendError(request->id_, e.code, e.what());
+            } catch (const std::exception& e) {
+                sendError(request->id_, JsonRpcErrorCode::INTERNAL_ERROR, e.what());
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pending_.erase(key);
+    });
+}
+
+void JsonRpcServer::cancel(const JsonValue& id) {
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    auto it = pending_.find(id.serialize());
+    if (it != pending_.end()) {
+        it->second->store(true);
+    }
+}
+
+void JsonRpcServer::sendResult(const JsonValue& id, JsonValue result) {
+    JsonValue message = JsonValue::object();
+    message.set("jsonrpc", "2.0");
+    message.set("id", id);
+    message.set("result", std::move(result));
+    send(message);
+}
+
+void JsonRpcServer::sendError(const JsonValue& id, int code, const std::string& text) {
+    JsonValue error = JsonValue::object();
+    error.set("code", code);
+    error.set("message", text);
+
+    JsonValue message = JsonValue::object();
+    message.set("jsonrpc", "2.0");
+    message.set("id", id);
+    message.set("error", std::move(error));
+    send(message);
+}
+
+void JsonRpcServer::send(const JsonValue& message) {
+    std::string body = message.serialize();
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    writeMessage(out_, body);
+}
+
+} // namespace CHTL
@@ -0,0 +1,106 @@
+#ifndef UTIL_JSON_RPC_SERVER_H
+#define UTIL_JSON_RPC_SERVER_H
+
+#include "Json.h"
+#include "../ThreadPool/ThreadPool.h"
+#include <atomic>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+namespace CHTL {
+
+// JSON-RPC错误码
+namespace JsonRpcErrorCode {
+    constexpr int PARSE_ERROR = -32700;
+    constexpr int INVALID_REQUEST = -32600;
+    constexpr int METHOD_NOT_FOUND = -32601;
+    constexpr int INVALID_PARAMS = -32602;
+    constexpr int INTERNAL_ERROR = -32603;
+    constexpr int REQUEST_CANCELLED = -32800;
+}
+
+// 处理器抛出此异常时以指定错误码回复；其他异常按INTERNAL_ERROR回复
+struct JsonRpcError : std::runtime_error {
+    int code;
+
+    JsonRpcError(int code, const std::string& message) : std::runtime_error(message), code(code) {}
+};
+
+// JSON-RPC 2.0服务器
+// 消息按LSP的方式分帧：`Content-Length: N\r\n\r\n` 后跟N字节JSON。
+// 读取在调用run()的线程进行，请求在线程池上并发处理，回复按完成顺序写出。
+// 内置方法：
+//   $/cancelRequest {id}  通知：取消尚未回复的请求
+//   shutdown              之后的新请求以INVALID_REQUEST回复
+//   exit                  通知：结束run()
+class JsonRpcServer {
+public:
+    class Request {
+    public:
+        const std::string& method() const { return method_; }
+        const JsonValue& params() const { return params_; }
+        const JsonValue& id() const { return id_; }
+
+        // 处理器可在耗时步骤之间查询，发现取消后尽早返回
+        bool isCancelled() const { return cancelled_->load(); }
+
+    private:
+        friend class JsonRpcServer;
+
+        std::string method_;
+        JsonValue params_;
+        JsonValue id_;
+        std::shared_ptr<std::atomic<bool>> cancelled_;
+    };
+
+    using Handler = std::function<JsonValue(const Request&)>;
+
+    // workerCount为0时使用硬件并发数
+    JsonRpcServer(std::istream& in, std::ostream& out, size_t workerCount = 0);
+    ~JsonRpcServer();
+
+    void setHandler(const std::string& method, Handler handler);
+
+    // 处理消息直到收到exit或输入结束，返回进程退出码：
+    // 先收到shutdown再退出时为0，否则为1
+    int run();
+
+    size_t getWorkerCount() const { return pool_.getWorkerCount(); }
+
+    // 分帧读写，读取失败（输入结束或头部无效）返回false
+    static bool readMessage(std::istream& in, std::string& body);
+    static void writeMessage(std::ostream& out, const std::string& body);
+
+private:
+    std::istream& in_;
+    std::ostream& out_;
+    std::mutex outputMutex_;
+
+    std::unordered_map<std::string, Handler> handlers_;
+
+    // 未回复的请求，键为序列化后的id
+    std::mutex pendingMutex_;
+    std::unordered_map<std::string, std::shared_ptr<std::atomic<bool>>> pending_;
+
+    bool shutdownRequested_ = false;
+
+    WorkStealingThreadPool pool_;
+
+    // 处理一条消息，收到exit时返回false
+    bool dispatch(const std::string& body);
+    void handleRequest(std::string method, JsonValue params, JsonValue id);
+    void cancel(const JsonValue& id);
+
+    void sendResult(const JsonValue& id, JsonValue result);
+    void sendError(const JsonValue& id, int code, const std::string& message);
+    void send(const JsonValue& message);
+};
+
+} // namespace CHTL
+
+#endif // UTIL_JSON_RPC_SERVER_H
@@ -0,0 +1,183 @@
+#include "KeywordMatcher.h"
+#include <algorithm>
+#include <deque>
+
+namespace CHTL {
+
+namespace {
+
+bool isIdentChar(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '_' || c == '$' || c >= 0x80;
+}
+
+} // namespace
+
+uint32_t KeywordMatcher::add(std::string_view keyword) {
+    for (uint32_t id = 0; id < keywords_.size(); ++id) {
+        if (keywords_[id] == keyword) {
+            return id;
+        }
+    }
+    if (keyword.empty()) {
+        return static_cast<uint32_t>(keywords_.size());
+    }
+    keywords_.emplace_back(keyword);
+    built_ = false;
+    return static_cast<uint32_t>(keywords_.size() - 1);
+}
+
+void KeywordMatcher::clear() {
+    keywords_.clear();
+    std::fill(std::begin(classOf_), std::end(classOf_), 0);
+    classCount_ = 1;
+    maxLength_ = 0;
+    delta_.clear();
+    output_.clear();
+    outputLink_.clear();
+    built_ = false;
+}
+
+void KeywordMatcher::build() {
+    // 字母表压缩：类别0留给关键字中没有出现的字节
+    std::fill(std::begin(classOf_), std::end(classOf_), 0);
+    classCount_ = 1;
+    maxLength_ = 0;
+    for (const auto& keyword : keywords_) {
+        for (unsigned char c : keyword) {
+            if (classOf_[c] == 0) {
+                classOf_[c] = static_cast<uint16_t>(classCount_++);
+            }
+        }
+        maxLength_ = std::max(maxLength_, keyword.size());
+    }
+
+    // 字典树，未定义的转移先记为-1
+    delta_.assign(classCount_, -1);
+    output_.assign(1, NO_OUTPUT);
+    for (uint32_t id = 0; id < keywords_.size(); ++id) {
+        size_t state = 0;
+        for (unsigned char c : keywords_[id]) {
+            int32_t& next = delta_[state * classCount_ + classOf_[c]];
+            if (next < 0) {
+                next = static_cast<int32_t>(output_.size());
+                output_.push_back(NO_OUTPUT);
+                delta_.resize(delta_.size() + classCount_, -1);
+            }
+            state = static_cast<size_t>(delta_[state * classCount_ + classOf_[c]]);
+        }
+        output_[state] = static_cast<int32_t>(id);
+    }
+
+    // 按层计算失败链接，同时把缺失的转移补全为确定自动机
+    size_t stateCount = output_.size();
+    std::vector<int32_t> fail(stateCount, 0);
+    outputLink_.assign(stateCount, -1);
+    std::deque<int32_t> queue;
+    for (size_t c = 0; c < classCount_; ++c) {
+        int32_t& next = delta_[c];
+        if (next < 0) {
+            next = 0;
+        } else {
+            queue.push_back(next);
+        }
+    }
+    while (!queue.empty()) {
+        int32_t state = queue.front();
+        queue.pop_front();
+        size_t row = static_cast<size_t>(state) * classCount_;
+        size_t failRow = static_cast<size_t>(fail[state]) * classCount_;
+        for (size_t c = 0; c < classCount_; ++c) {
+            int32_t next = delta_[row + c];
+            if (next < 0) {
+                delta_[row + c] = delta_[failRow + c];
+                continue;
+            }
+            int32_t nextFail = delta_[failRow + c];
+            fail[next] = nextFail;
+            outputLink_[next] = output_[nextFail] != NO_OUTPUT ? nextFail : outputLink_[nextFail];
+            queue.push_back(next);
+        }
+    }
+
+    built_ = true;
+}
+
+bool KeywordMatcher::atWordBoundary(std::string_view text, size_t start, size_t end, uint32_t id) const {
+    const std::string& keyword = keywords_[id];
+    if (isIdentChar(static_cast<unsigned char>(keyword.front())) && start > 0 &&
+        isIdentChar(static_cast<unsigned char>(text[start - 1]))) {
+        return false;
+    }
+    if (isIdentChar(static_cast<unsigned char>(keyword.back())) && end < text.size() &&
+        isIdentChar(static_cast<unsigned char>(text[end]))) {
+        return false;
+    }
+    return true;
+}
+
+template <typename Callback>
+void KeywordMatcher::forEachMatch(std::string_view text, size_t from, size_t& limit, Callback&& onMatch) const {
+    if (!built_ || keywords_.empty()) {
+        return;
+    }
+    size_t state = 0;
+    for (size_t i = from; i < limit && i < text.size(); ++i) {
+        state = static_cast<size_t>(delta_[state * classCount_ + classOf_[static_cast<unsigned char>(text[i])]]);
+        int32_t hit = output_[state] != NO_OUTPUT ? static_cast<int32_t>(state) : outputLink_[state];
+        // 沿输出链由长到短报告所有在i处结束的关键字
+        for (; hit >= 0; hit = outputLink_[hit]) {
+            uint32_t id = static_cast<uint32_t>(output_[hit]);
+            size_t end = i + 1;
+            size_t start = end - keywords_[id].size();
+            if (atWordBoundary(text, start, end, id)) {
+                onMatch(start, id);
+            }
+        }
+    }
+}
+
+void KeywordMatcher::scan(std::string_view text, std::vector<KeywordMatch>& out) const {
+    size_t base = out.size();
+    size_t limit = text.size();
+    forEachMatch(text, 0, limit, [&](size_t start, uint32_t id) {
+        out.push_back({start, keywords_[id].size(), id});
+    });
+
+    // 自动机按结束位置报告；改为起点优先、同起点取最长，再去掉重叠的匹配
+    std::sort(out.begin() + base, out.end(), [](const KeywordMatch& a, const KeywordMatch& b) {
+        return a.position != b.position ? a.position < b.position : a.length > b.length;
+    });
+    size_t kept = base;
+    size_t cursor = 0;
+    for (size_t i = base; i < out.size(); ++i) {
+        if (out[i].position >= cursor) {
+            cursor = out[i].position + out[i].length;
+            out[kept++] = out[i];
+        }
+    }
+    out.resize(kept);
+}
+
+std::vector<KeywordMatch> KeywordMatcher::scan(std::string_view text) const {
+    std::vector<KeywordMatch> matches;
+    scan(text, matches);
+    return matches;
+}
+
+bool KeywordMatcher::findFirst(std::string_view text, size_t from, KeywordMatch& match) const {
+    bool found = false;
+    size_t limit = text.size();
+    forEachMatch(text, from, limit, [&](size_t start, uint32_t id) {
+        size_t length = keywords_[id].size();
+        if (!found || start < match.position || (start == match.position && length > match.length)) {
+            match = {start, length, id};
+            found = true;
+            // 起点更靠前的匹配最晚在这里结束，之后不必再扫描
+            limit = std::min(limit, match.position + maxLength_);
+        }
+    });
+    return found;
+}
+
+} // namespace CHTL
@@ -0,0 +1,70 @@
+#ifndef UTIL_KEYWORD_MATCHER_H
+#define UTIL_KEYWORD_MATCHER_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CHTL {
+
+// 一次关键字匹配
+struct KeywordMatch {
+    size_t position = 0;    // 在文本中的起始位置
+    size_t length = 0;
+    uint32_t id = 0;        // 关键字编号（登记顺序）
+};
+
+// 多关键字匹配器（Aho-Corasick）
+// 所有关键字编译成一个确定自动机，文本只扫描一遍，耗时与关键字数量无关。
+// 只在关键字中出现过的字节各占一个字母表类别，其余字节共用类别0，
+// 状态转移表因此只有 状态数 × 类别数 个表项。
+//
+// 匹配从左到右报告，互不重叠；同一位置有多个关键字时取最长的。
+// 以标识符字符（字母、数字、_、$）开头或结尾的关键字要求在对应一侧
+// 处于词边界，避免在 xprintMylove 中找到 printMylove。
+class KeywordMatcher {
+public:
+    // 登记关键字并返回编号；重复登记返回已有编号，空串不登记
+    uint32_t add(std::string_view keyword);
+
+    // 登记完成后构建自动机，之后才能扫描；再次add需要重新build
+    void build();
+
+    bool empty() const { return keywords_.empty(); }
+    size_t size() const { return keywords_.size(); }
+    const std::string& keyword(uint32_t id) const { return keywords_[id]; }
+
+    // 扫描整段文本，匹配追加到out
+    void scan(std::string_view text, std::vector<KeywordMatch>& out) const;
+    std::vector<KeywordMatch> scan(std::string_view text) const;
+
+    // 从from开始的第一个匹配
+    bool findFirst(std::string_view text, size_t from, KeywordMatch& match) const;
+
+    void clear();
+
+private:
+    static constexpr int32_t NO_OUTPUT = -1;
+
+    // 对[from, limit)中结束的每个（满足词边界的）匹配调用onMatch(start, id)，
+    // 回调可以缩小limit提前结束扫描
+    template <typename Callback>
+    void forEachMatch(std::string_view text, size_t from, size_t& limit, Callback&& onMatch) const;
+
+    bool atWordBoundary(std::string_view text, size_t start, size_t end, uint32_t id) const;
+
+    std::vector<std::string> keywords_;
+    uint16_t classOf_[256] = {};
+    size_t classCount_ = 1;
+    size_t maxLength_ = 0;
+    bool built_ = false;
+
+    std::vector<int32_t> delta_;        // 状态 × 类别 -> 状态
+    std::vector<int32_t> output_;       // 在该状态结束的关键字，NO_OUTPUT表示无
+    std::vector<int32_t> outputLink_;   // 沿失败链下一个有输出的状态，-1表示无
+};
+
+} // namespace CHTL
+
+#endif // UTIL_KEYWORD_MATCHER_H
@@ -0,0 +1,75 @@
+#ifndef UTIL_RING_BUFFER_H
+#define UTIL_RING_BUFFER_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace CHTL {
+
+// 环形缓冲区（FIFO）
+// 容量为2的幂，按需倍增；支持按下标随机访问队列中的元素，
+// 用于词法分析器的Token预读，避免复制整个队列。
+template<typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t initialCapacity = 8) {
+        size_t capacity = 1;
+        while (capacity < initialCapacity) {
+            capacity <<= 1;
+        }
+        slots_.resize(capacity);
+    }
+
+    bool empty() const { return size_ == 0; }
+    size_t size() const { return size_; }
+
+    void push(T value) {
+        if (size_ == slots_.size()) {
+            grow();
+        }
+        slots_[(head_ + size_) & (slots_.size() - 1)] = std::move(value);
+        ++size_;
+    }
+
+    // 队首元素
+    T& front() { return slots_[head_]; }
+    const T& front() const { return slots_[head_]; }
+
+    // 第index个元素（0为队首）
+    T& operator[](size_t index) { return slots_[(head_ + index) & (slots_.size() - 1)]; }
+    const T& operator[](size_t index) const { return slots_[(head_ + index) & (slots_.size() - 1)]; }
+
+    T pop() {
+        T value = std::move(slots_[head_]);
+        slots_[head_] = T();
+        head_ = (head_ + 1) & (slots_.size() - 1);
+        --size_;
+        return value;
+    }
+
+    void clear() {
+        while (!empty()) {
+            pop();
+        }
+        head_ = 0;
+    }
+
+private:
+    std::vector<T> slots_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+
+    void grow() {
+        std::vector<T> larger(slots_.size() * 2);
+        for (size_t i = 0; i < size_; ++i) {
+            larger[i] = std::move((*this)[i]);
+        }
+        slots_ = std::move(larger);
+        head_ = 0;
+    }
+};
+
+} // namespace CHTL
+
+#endif // UTIL_RING_BUFFER_H
@@ -0,0 +1,64 @@
+#ifndef UTIL_SCOPED_INSTANCE_H
+#define UTIL_SCOPED_INSTANCE_H
+
+#include <memory>
+
+namespace CHTL {
+
+// 线程作用域实例
+// 在当前线程内以一个全新的实例替换单例的 getInstance() 返回值，
+// 作用域结束时恢复之前的实例。并行编译时每个编译任务持有一组，
+// 使 NamespaceManager / GlobalMap / ErrorReport 等单例互不干扰。
+// 单例类需声明 friend class ScopedInstance<T>，并在 getInstance() 中优先返回 current()。
+template<typename T>
+class ScopedInstance {
+public:
+    ScopedInstance() : instance_(new T()), previous_(current()) {
+        current() = instance_.get();
+    }
+
+    ~ScopedInstance() {
+        current() = previous_;
+    }
+
+    T& get() { return *instance_; }
+
+    // 当前线程的作用域实例（未设置时为nullptr）
+    static T*& current() {
+        static thread_local T* instance = nullptr;
+        return instance;
+    }
+
+    // 禁止拷贝
+    ScopedInstance(const ScopedInstance&) = delete;
+    ScopedInstance& operator=(const ScopedInstance&) = delete;
+
+private:
+    std::unique_ptr<T> instance_;
+    T* previous_;
+};
+
+// 在当前线程沿用一个已有的实例（不拥有它），作用域结束时恢复
+// 编译任务的一部分交给线程池执行时，让工作线程看到发起线程的单例。
+template<typename T>
+class ScopedInstanceBinding {
+public:
+    explicit ScopedInstanceBinding(T* instance) : previous_(ScopedInstance<T>::current()) {
+        ScopedInstance<T>::current() = instance;
+    }
+
+    ~ScopedInstanceBinding() {
+        ScopedInstance<T>::current() = previous_;
+    }
+
+    // 禁止拷贝
+    ScopedInstanceBinding(const ScopedInstanceBinding&) = delete;
+    ScopedInstanceBinding& operator=(const ScopedInstanceBinding&) = delete;
+
+private:
+    T* previous_;
+};
+
+} // namespace CHTL
+
+#endif // UTIL_SCOPED_INSTANCE_H
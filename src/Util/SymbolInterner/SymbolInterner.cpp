@@ -0,0 +1,151 @@
+#include "SymbolInterner.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+namespace CHTL {
+
+namespace {
+
+constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+} // namespace
+
+SymbolInterner::SymbolInterner() {
+    entries_.push_back({std::string_view(), INVALID_SYMBOL_ID, INVALID_SYMBOL_ID});
+    ids_.emplace(std::string_view(), INVALID_SYMBOL_ID);
+}
+
+SymbolId SymbolInterner::intern(std::string_view text) {
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = ids_.find(text);
+        if (it != ids_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    return internLocked(text);
+}
+
+SymbolId SymbolInterner::find(std::string_view text) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(text);
+    return it != ids_.end() ? it->second : INVALID_SYMBOL_ID;
+}
+
+std::string_view SymbolInterner::name(SymbolId id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return id < entries_.size() ? entries_[id].text : std::string_view();
+}
+
+SymbolPath SymbolInterner::path(SymbolId id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (id >= entries_.size()) {
+        return {};
+    }
+    const Entry& entry = entries_[id];
+    return {id, entry.scope, entry.leaf};
+}
+
+SymbolPath SymbolInterner::findPath(std::string_view qualified) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = ids_.find(qualified);
+    if (it != ids_.end()) {
+        const Entry& entry = entries_[it->second];
+        return {it->second, entry.scope, entry.leaf};
+    }
+
+    // 拆分规则与internLocked一致
+    size_t dot = qualified.rfind('.');
+    if (dot == std::string_view::npos || dot == 0 || dot + 1 >= qualified.size()) {
+        return {};
+    }
+    auto lookup = [this](std::string_view text) {
+        auto found = ids_.find(text);
+        return found != ids_.end() ? found->second : INVALID_SYMBOL_ID;
+    };
+    return {INVALID_SYMBOL_ID, lookup(qualified.substr(0, dot)), lookup(qualified.substr(dot + 1))};
+}
+
+SymbolId SymbolInterner::qualify(SymbolId scope, SymbolId leaf) {
+    if (scope == INVALID_SYMBOL_ID) {
+        return leaf;
+    }
+
+    uint64_t key = (static_cast<uint64_t>(scope) << 32) | leaf;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = qualified_.find(key);
+        if (it != qualified_.end()) {
+            return it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = qualified_.find(key);
+    if (it != qualified_.end()) {
+        return it->second;
+    }
+
+    std::string_view scopeText = entries_[scope].text;
+    std::string_view leafText = entries_[leaf].text;
+    std::string joined;
+    joined.reserve(scopeText.size() + 1 + leafText.size());
+    joined.append(scopeText).append(1, '.').append(leafText);
+
+    SymbolId id = internLocked(joined);
+    qualified_.emplace(key, id);
+    return id;
+}
+
+size_t SymbolInterner::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return entries_.size();
+}
+
+SymbolId SymbolInterner::internLocked(std::string_view text) {
+    // 获取写锁期间可能已被其他线程登记
+    auto it = ids_.find(text);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+
+    // 先登记拆分出的两部分，限定名的ID总是大于其组成部分
+    SymbolId scope = INVALID_SYMBOL_ID;
+    SymbolId leaf = INVALID_SYMBOL_ID;
+    size_t dot = text.rfind('.');
+    if (dot != std::string_view::npos && dot > 0 && dot + 1 < text.size()) {
+        scope = internLocked(text.substr(0, dot));
+        leaf = internLocked(text.substr(dot + 1));
+    }
+
+    std::string_view stored = store(text);
+    SymbolId id = static_cast<SymbolId>(entries_.size());
+    if (leaf == INVALID_SYMBOL_ID) {
+        leaf = id;
+    }
+    entries_.push_back({stored, scope, leaf});
+    ids_.emplace(stored, id);
+    return id;
+}
+
+std::string_view SymbolInterner::store(std::string_view text) {
+    if (text.empty()) {
+        return std::string_view();
+    }
+    if (blockUsed_ + text.size() > blockSize_) {
+        size_t size = std::max(BLOCK_SIZE, text.size());
+        blocks_.emplace_back(new char[size]);
+        blockUsed_ = 0;
+        blockSize_ = size;
+    }
+
+    char* destination = blocks_.back().get() + blockUsed_;
+    std::memcpy(destination, text.data(), text.size());
+    blockUsed_ += text.size();
+    return std::string_view(destination, text.size());
+}
+
+} // namespace CHTL
@@ -0,0 +1,92 @@
+#ifndef UTIL_SYMBOL_INTERNER_H
+#define UTIL_SYMBOL_INTERNER_H
+
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace CHTL {
+
+// 符号ID：进程内稳定的32位整数，相同字符串总是得到相同的ID
+using SymbolId = uint32_t;
+
+// 空字符串固定为0，也用来表示“没有该符号”
+constexpr SymbolId INVALID_SYMBOL_ID = 0;
+
+// 预先拆分好的限定名，如 space.room.Box
+// scope为 space.room 的ID，leaf为 Box 的ID；不带命名空间时scope为INVALID_SYMBOL_ID
+struct SymbolPath {
+    SymbolId full = INVALID_SYMBOL_ID;
+    SymbolId scope = INVALID_SYMBOL_ID;
+    SymbolId leaf = INVALID_SYMBOL_ID;
+};
+
+// 全局字符串驻留表
+// 模板、自定义、变量组和命名空间的名字在这里换成SymbolId，之后的符号表
+// 查找只比较整数。限定名在驻留时就拆分好，查找时不再截取子串、重新求哈希。
+// 所有编译任务共用一个实例（不参与ScopedInstance替换），以保证ID跨线程稳定；
+// 字符串存放在只追加的内存块中，返回的string_view在进程结束前一直有效。
+class SymbolInterner {
+public:
+    static SymbolInterner& getInstance() {
+        static SymbolInterner instance;
+        return instance;
+    }
+
+    // 取得字符串的ID，不存在时登记
+    SymbolId intern(std::string_view text);
+
+    // 只查找不登记，不存在时返回INVALID_SYMBOL_ID
+    SymbolId find(std::string_view text) const;
+
+    // ID对应的字符串
+    std::string_view name(SymbolId id) const;
+
+    // 限定名的拆分结果（按最后一个'.'拆分）
+    SymbolPath path(SymbolId id) const;
+    SymbolPath internPath(std::string_view qualified) { return path(intern(qualified)); }
+
+    // 只查找不登记的拆分结果；整串未登记时分别查找两部分，查不到的部分为INVALID_SYMBOL_ID
+    SymbolPath findPath(std::string_view qualified) const;
+
+    // scope + "." + leaf 的ID，结果会被缓存，重复拼接不再分配字符串
+    SymbolId qualify(SymbolId scope, SymbolId leaf);
+
+    // 已登记的字符串数量（含空字符串）
+    size_t size() const;
+
+    // 禁止拷贝
+    SymbolInterner(const SymbolInterner&) = delete;
+    SymbolInterner& operator=(const SymbolInterner&) = delete;
+
+private:
+    SymbolInterner();
+
+    // 调用者需持有写锁
+    SymbolId internLocked(std::string_view text);
+    std::string_view store(std::string_view text);
+
+    struct Entry {
+        std::string_view text;
+        SymbolId scope;
+        SymbolId leaf;
+    };
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<std::string_view, SymbolId> ids_;
+    std::vector<Entry> entries_;
+    std::unordered_map<uint64_t, SymbolId> qualified_;
+
+    // 字符串存储
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    size_t blockUsed_ = 0;
+    size_t blockSize_ = 0;
+};
+
+} // namespace CHTL
+
+#endif // UTIL_SYMBOL_INTERNER_H
@@ -0,0 +1,138 @@
+#ifndef UTIL_SYMBOL_MAP_H
+#define UTIL_SYMBOL_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "SymbolInterner.h"
+
+namespace CHTL {
+
+// 以符号ID为键的扁平哈希表
+// 值按插入顺序连续存放在entries_中，索引表为开放寻址（线性探测）的
+// uint32_t数组，容量为2的幂；哈希只是一次乘法，不再对字符串求哈希。
+// 遍历顺序即插入顺序，结果与运行环境无关。不支持删除单个元素。
+template<typename T>
+class SymbolMap {
+public:
+    using value_type = std::pair<SymbolId, T>;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    SymbolMap() = default;
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    iterator begin() { return entries_.begin(); }
+    iterator end() { return entries_.end(); }
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+
+    T* find(SymbolId id) {
+        size_t slot = findSlot(id);
+        return slot == NOT_FOUND ? nullptr : &entries_[index_[slot] - 1].second;
+    }
+
+    const T* find(SymbolId id) const {
+        size_t slot = findSlot(id);
+        return slot == NOT_FOUND ? nullptr : &entries_[index_[slot] - 1].second;
+    }
+
+    bool contains(SymbolId id) const { return findSlot(id) != NOT_FOUND; }
+
+    // 不存在时插入默认值
+    T& operator[](SymbolId id) {
+        if (T* existing = find(id)) {
+            return *existing;
+        }
+        return insertNew(id, T());
+    }
+
+    // 插入或覆盖
+    T& assign(SymbolId id, T value) {
+        if (T* existing = find(id)) {
+            *existing = std::move(value);
+            return *existing;
+        }
+        return insertNew(id, std::move(value));
+    }
+
+    void reserve(size_t count) {
+        entries_.reserve(count);
+        size_t capacity = 8;
+        while (capacity * 3 < count * 4) {
+            capacity <<= 1;
+        }
+        if (capacity > index_.size()) {
+            rehash(capacity);
+        }
+    }
+
+    void clear() {
+        entries_.clear();
+        index_.clear();
+        shift_ = 64;
+    }
+
+private:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    // Fibonacci哈希：连续分配的ID被均匀打散到各个槽位
+    size_t slotFor(SymbolId id) const {
+        return static_cast<size_t>((static_cast<uint64_t>(id) * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+
+    size_t findSlot(SymbolId id) const {
+        if (index_.empty()) {
+            return NOT_FOUND;
+        }
+        for (size_t slot = slotFor(id);; slot = (slot + 1) & (index_.size() - 1)) {
+            uint32_t entry = index_[slot];
+            if (entry == 0) {
+                return NOT_FOUND;
+            }
+            if (entries_[entry - 1].first == id) {
+                return slot;
+            }
+        }
+    }
+
+    T& insertNew(SymbolId id, T value) {
+        // 负载因子不超过3/4
+        if ((entries_.size() + 1) * 4 > index_.size() * 3) {
+            rehash(index_.empty() ? 8 : index_.size() * 2);
+        }
+        entries_.emplace_back(id, std::move(value));
+        place(id, static_cast<uint32_t>(entries_.size()));
+        return entries_.back().second;
+    }
+
+    void place(SymbolId id, uint32_t entry) {
+        size_t slot = slotFor(id);
+        while (index_[slot] != 0) {
+            slot = (slot + 1) & (index_.size() - 1);
+        }
+        index_[slot] = entry;
+    }
+
+    void rehash(size_t capacity) {
+        index_.assign(capacity, 0);
+        shift_ = 64;
+        for (size_t c = capacity; c > 1; c >>= 1) {
+            --shift_;
+        }
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            place(entries_[i].first, static_cast<uint32_t>(i + 1));
+        }
+    }
+
+    std::vector<value_type> entries_;
+    std::vector<uint32_t> index_;  // 0表示空槽，否则为entries_下标+1
+    unsigned shift_ = 64;          // 64 - log2(index_.size())
+};
+
+} // namespace CHTL
+
+#endif // UTIL_SYMBOL_MAP_H
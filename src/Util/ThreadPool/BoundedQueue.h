@@ -0,0 +1,85 @@
+#ifndef UTIL_BOUNDED_QUEUE_H
+#define UTIL_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+namespace CHTL {
+
+// 有界阻塞队列（多生产者/多消费者）
+// 队列满时push阻塞，生产者不会比消费者领先太多，内存占用有上限；
+// close()之后push失败，pop取完剩余元素后返回空。
+// capacity为0表示不限容量。
+template<typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity = 0) : capacity_(capacity) {}
+
+    // 放入元素，队列已关闭时返回false
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [this]() { return closed_ || capacity_ == 0 || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(value));
+        lock.unlock();
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    // 取出元素，队列已关闭且为空时返回std::nullopt
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [this]() { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(items_.front()));
+        items_.pop_front();
+        lock.unlock();
+        notFull_.notify_one();
+        return value;
+    }
+
+    // 关闭队列，唤醒所有等待的生产者和消费者
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+    bool isClosed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_;
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+
+    size_t getCapacity() const { return capacity_; }
+
+    // 禁止拷贝
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+private:
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<T> items_;
+    bool closed_ = false;
+};
+
+} // namespace CHTL
+
+#endif // UTIL_BOUNDED_QUEUE_H
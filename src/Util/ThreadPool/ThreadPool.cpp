@@ -0,0 +1,142 @@
+#include "ThreadPool.h"
+
+namespace CHTL {
+
+namespace {
+    // 当前线程所属的线程池及其工作线程索引
+    thread_local const WorkStealingThreadPool* tlsPool = nullptr;
+    thread_local size_t tlsWorkerIndex = WorkStealingThreadPool::NOT_A_WORKER;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool(size_t workerCount) {
+    size_t count = resolveWorkerCount(workerCount);
+
+    queues_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    threads_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        threads_.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopping_ = true;
+    }
+    workAvailable_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+size_t WorkStealingThreadPool::resolveWorkerCount(size_t requested) {
+    if (requested == 0) {
+        requested = std::thread::hardware_concurrency();
+    }
+    return requested == 0 ? 1 : requested;
+}
+
+size_t WorkStealingThreadPool::currentWorkerIndex() {
+    return tlsWorkerIndex;
+}
+
+void WorkStealingThreadPool::post(Task task) {
+    size_t target;
+    if (tlsPool == this) {
+        target = tlsWorkerIndex;
+    } else {
+        target = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+
+    // 计数必须先于入队：任务一入队就可能被其他工作线程取走并递减计数
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        ++queuedTasks_;
+        ++pendingTasks_;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    workAvailable_.notify_one();
+}
+
+void WorkStealingThreadPool::waitIdle() {
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    allIdle_.wait(lock, [this]() { return pendingTasks_ == 0; });
+}
+
+bool WorkStealingThreadPool::popLocal(size_t index, Task& task) {
+    auto& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingThreadPool::steal(size_t thief, Task& task) {
+    size_t count = queues_.size();
+    for (size_t offset = 1; offset < count; ++offset) {
+        auto& victim = *queues_[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingThreadPool::workerLoop(size_t index) {
+    tlsPool = this;
+    tlsWorkerIndex = index;
+
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            {
+                std::lock_guard<std::mutex> lock(stateMutex_);
+                --queuedTasks_;
+            }
+
+            try {
+                task();
+            } catch (...) {
+                // post()提交的任务自行处理异常；这里只保证工作线程不退出
+            }
+
+            bool idle;
+            {
+                std::lock_guard<std::mutex> lock(stateMutex_);
+                idle = --pendingTasks_ == 0;
+            }
+            if (idle) {
+                allIdle_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        workAvailable_.wait(lock, [this]() { return stopping_ || queuedTasks_ > 0; });
+        if (stopping_ && queuedTasks_ == 0) {
+            break;
+        }
+    }
+
+    tlsPool = nullptr;
+    tlsWorkerIndex = NOT_A_WORKER;
+}
+
+} // namespace CHTL
@@ -0,0 +1,84 @@
+#ifndef UTIL_THREADPOOL_H
+#define UTIL_THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace CHTL {
+
+// 工作窃取线程池
+// 每个工作线程拥有自己的任务双端队列：从队尾取自己的任务（LIFO，缓存友好），
+// 空闲时从其他线程队首窃取（FIFO），适合耗时差异很大的批量编译任务。
+class WorkStealingThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    static constexpr size_t NOT_A_WORKER = static_cast<size_t>(-1);
+
+    // workerCount为0时使用硬件并发数
+    explicit WorkStealingThreadPool(size_t workerCount = 0);
+    ~WorkStealingThreadPool();
+
+    // 提交任务
+    // 在工作线程内提交时放入该线程自己的队列，否则轮流分配到各队列
+    void post(Task task);
+
+    // 提交任务并返回future（任务中的异常通过future传递）
+    template<typename F>
+    auto submit(F&& func) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+        using R = std::invoke_result_t<std::decay_t<F>>;
+        auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(func));
+        auto future = task->get_future();
+        post([task]() { (*task)(); });
+        return future;
+    }
+
+    // 等待所有已提交任务完成
+    void waitIdle();
+
+    size_t getWorkerCount() const { return threads_.size(); }
+
+    // 当前线程在所属线程池中的工作线程索引（非工作线程返回NOT_A_WORKER）
+    static size_t currentWorkerIndex();
+
+    // 解析工作线程数：0表示硬件并发数，且至少为1
+    static size_t resolveWorkerCount(size_t requested);
+
+    // 禁止拷贝
+    WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+    WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex stateMutex_;
+    std::condition_variable workAvailable_;
+    std::condition_variable allIdle_;
+    size_t queuedTasks_ = 0;     // 队列中等待执行的任务数
+    size_t pendingTasks_ = 0;    // 已提交但未完成的任务数
+    bool stopping_ = false;
+
+    std::atomic<size_t> nextQueue_{0};
+
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t thief, Task& task);
+};
+
+} // namespace CHTL
+
+#endif // UTIL_THREADPOOL_H
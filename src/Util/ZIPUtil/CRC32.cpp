@@ -0,0 +1,73 @@
+#include "CRC32.h"
+
+namespace CHTL {
+
+namespace {
+
+struct CRC32Tables {
+    uint32_t table[8][256];
+
+    CRC32Tables() {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            }
+            table[0][i] = crc;
+        }
+        // table[k][i]：字节i之后再跟k个零字节的crc
+        for (uint32_t i = 0; i < 256; ++i) {
+            for (int k = 1; k < 8; ++k) {
+                uint32_t prev = table[k - 1][i];
+                table[k][i] = (prev >> 8) ^ table[0][prev & 0xFF];
+            }
+        }
+    }
+};
+
+const CRC32Tables& tables() {
+    static const CRC32Tables instance;
+    return instance;
+}
+
+inline uint32_t load32(const unsigned char* p) {
+    // 按小端组合，与主机字节序无关
+    return uint32_t(p[0]) | (uint32_t(p[1]) << 8) | (uint32_t(p[2]) << 16) | (uint32_t(p[3]) << 24);
+}
+
+} // namespace
+
+uint32_t CRC32::update(uint32_t crc, const void* data, size_t size) {
+    const auto& t = tables().table;
+    const auto* p = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+
+    while (size >= 8) {
+        uint32_t one = load32(p) ^ crc;
+        uint32_t two = load32(p + 4);
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF] ^
+              t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24] ^
+              t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF] ^
+              t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+        p += 8;
+        size -= 8;
+    }
+
+    while (size-- > 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+
+    return ~crc;
+}
+
+uint32_t CRC32::updateBytewise(uint32_t crc, const void* data, size_t size) {
+    const auto& t = tables().table;
+    const auto* p = static_cast<const unsigned char*>(data);
+    crc = ~crc;
+    while (size-- > 0) {
+        crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+    }
+    return ~crc;
+}
+
+} // namespace CHTL
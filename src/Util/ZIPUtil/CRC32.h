@@ -0,0 +1,25 @@
+#ifndef UTIL_CRC32_H
+#define UTIL_CRC32_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace CHTL {
+
+// CRC-32（IEEE 802.3，ZIP/gzip使用的多项式0xEDB88320）
+// 查表实现，每次处理8字节（slice-by-8）
+class CRC32 {
+public:
+    // 在已有的crc上继续计算（初始值为0）
+    static uint32_t update(uint32_t crc, const void* data, size_t size);
+
+    // 计算一段数据的crc
+    static uint32_t compute(const void* data, size_t size) { return update(0, data, size); }
+
+    // 逐字节查表的参考实现（用于测试和基准对比）
+    static uint32_t updateBytewise(uint32_t crc, const void* data, size_t size);
+};
+
+} // namespace CHTL
+
+#endif // UTIL_CRC32_H
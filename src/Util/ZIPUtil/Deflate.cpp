@@ -0,0 +1,1136 @@
+#include "Deflate.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <queue>
+#include <vector>
+
+namespace CHTL {
+
+namespace {
+
+constexpr size_t WINDOW_SIZE = 32768;           // 最大回溯距离
+constexpr size_t WINDOW_MASK = WINDOW_SIZE - 1;
+constexpr size_t MIN_MATCH = 3;
+constexpr size_t MAX_MATCH = 258;
+constexpr size_t MIN_LOOKAHEAD = MAX_MATCH + MIN_MATCH + 1;
+constexpr size_t TOO_FAR = 4096;                // 距离过远的3字节匹配不如直接输出字面量
+
+constexpr int HASH_BITS = 15;
+constexpr size_t HASH_SIZE = size_t(1) << HASH_BITS;
+
+constexpr int LITLEN_CODES = 286;
+constexpr int DIST_CODES = 30;
+constexpr int CODELEN_CODES = 19;
+constexpr int MAX_BITS = 15;
+constexpr int MAX_CODELEN_BITS = 7;
+constexpr int END_OF_BLOCK = 256;
+
+// 每块最多的符号数和原始字节数
+constexpr size_t BLOCK_SYMBOLS = 16383;
+constexpr size_t BLOCK_BYTES = 256 * 1024;
+constexpr size_t MAX_STORED = 65535;
+
+const uint16_t LENGTH_BASE[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+const uint8_t LENGTH_EXTRA[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+const uint16_t DIST_BASE[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+const uint8_t DIST_EXTRA[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+const uint8_t CODELEN_ORDER[CODELEN_CODES] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+// 长度/距离到编码的查找表
+struct CodeTables {
+    uint8_t lengthCode[MAX_MATCH + 1];  // 匹配长度 -> 长度码下标(0-28)
+    uint8_t distCode[512];              // 距离-1 -> 距离码（小于256直接查，否则查256+((d-1)>>7)）
+    uint8_t fixedLitLen[288];
+    uint8_t fixedDist[32];
+
+    CodeTables() {
+        for (int code = 0; code < 29; ++code) {
+            int count = 1 << LENGTH_EXTRA[code];
+            for (int i = 0; i < count && LENGTH_BASE[code] + i <= int(MAX_MATCH); ++i) {
+                lengthCode[LENGTH_BASE[code] + i] = static_cast<uint8_t>(code);
+            }
+        }
+        lengthCode[MAX_MATCH] = 28;
+
+        for (int code = 0; code < DIST_CODES; ++code) {
+            int count = 1 << DIST_EXTRA[code];
+            for (int i = 0; i < count; ++i) {
+                int dist = DIST_BASE[code] + i - 1;
+                if (dist < 256) {
+                    distCode[dist] = static_cast<uint8_t>(code);
+                } else {
+                    distCode[256 + (dist >> 7)] = static_cast<uint8_t>(code);
+                }
+            }
+        }
+
+        for (int i = 0; i < 288; ++i) {
+            fixedLitLen[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+        }
+        for (int i = 0; i < 32; ++i) {
+            fixedDist[i] = 5;
+        }
+    }
+
+    int distanceCode(size_t dist) const {
+        return dist <= 256 ? distCode[dist - 1] : distCode[256 + ((dist - 1) >> 7)];
+    }
+};
+
+const CodeTables& codeTables() {
+    static const CodeTables tables;
+    return tables;
+}
+
+inline uint32_t reverseBits(uint32_t code, int length) {
+    uint32_t result = 0;
+    for (int i = 0; i < length; ++i) {
+        result = (result << 1) | (code & 1);
+        code >>= 1;
+    }
+    return result;
+}
+
+// 由码长生成规范Huffman编码（已按DEFLATE的位序反转）
+void buildCodes(const uint8_t* lengths, int count, uint16_t* codes) {
+    uint16_t lengthCount[MAX_BITS + 1] = {};
+    for (int i = 0; i < count; ++i) {
+        lengthCount[lengths[i]]++;
+    }
+    lengthCount[0] = 0;
+
+    uint16_t nextCode[MAX_BITS + 1] = {};
+    uint16_t code = 0;
+    for (int bits = 1; bits <= MAX_BITS; ++bits) {
+        code = static_cast<uint16_t>((code + lengthCount[bits - 1]) << 1);
+        nextCode[bits] = code;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        if (lengths[i] != 0) {
+            codes[i] = static_cast<uint16_t>(reverseBits(nextCode[lengths[i]]++, lengths[i]));
+        } else {
+            codes[i] = 0;
+        }
+    }
+}
+
+// 由频率计算不超过maxBits的码长
+// 先构造普通Huffman树，超长时按zlib的方法把溢出的叶子挪到较浅的层，
+// 再按频率从低到高重新分配码长。至少保证两个符号有码长，使编码完整。
+void buildLengths(const uint32_t* freqs, int count, int maxBits, uint8_t* lengths) {
+    std::fill(lengths, lengths + count, 0);
+
+    std::vector<int> used;
+    for (int i = 0; i < count; ++i) {
+        if (freqs[i] > 0) {
+            used.push_back(i);
+        }
+    }
+    while (used.size() < 2) {
+        int fill = 0;
+        while (std::find(used.begin(), used.end(), fill) != used.end()) {
+            ++fill;
+        }
+        used.push_back(fill);
+    }
+
+    // 节点：前n个为叶子，之后为内部节点
+    struct Node {
+        uint64_t weight;
+        int parent;
+    };
+    std::vector<Node> nodes;
+    nodes.reserve(used.size() * 2);
+    using Item = std::pair<uint64_t, int>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> heap;
+    for (int symbol : used) {
+        nodes.push_back({std::max<uint64_t>(freqs[symbol], 1), -1});
+        heap.push({nodes.back().weight, static_cast<int>(nodes.size() - 1)});
+    }
+    while (heap.size() > 1) {
+        Item a = heap.top();
+        heap.pop();
+        Item b = heap.top();
+        heap.pop();
+        nodes.push_back({a.first + b.first, -1});
+        int parent = static_cast<int>(nodes.size() - 1);
+        nodes[a.second].parent = parent;
+        nodes[b.second].parent = parent;
+        heap.push({a.first + b.first, parent});
+    }
+
+    // 叶子深度
+    std::vector<int> depthCount(std::max<size_t>(used.size(), size_t(maxBits)) + 2, 0);
+    int overflow = 0;
+    for (size_t i = 0; i < used.size(); ++i) {
+        int depth = 0;
+        for (int n = static_cast<int>(i); nodes[n].parent >= 0; n = nodes[n].parent) {
+            ++depth;
+        }
+        if (depth > maxBits) {
+            depth = maxBits;
+            ++overflow;
+        }
+        depthCount[depth]++;
+    }
+
+    while (overflow > 0) {
+        int bits = maxBits - 1;
+        while (depthCount[bits] == 0) {
+            --bits;
+        }
+        depthCount[bits]--;
+        depthCount[bits + 1] += 2;
+        depthCount[maxBits]--;
+        overflow -= 2;
+    }
+
+    // 频率低的符号分配较长的码
+    std::vector<int> byFreq(used);
+    std::stable_sort(byFreq.begin(), byFreq.end(), [&](int a, int b) { return freqs[a] < freqs[b]; });
+    size_t next = 0;
+    for (int bits = maxBits; bits >= 1; --bits) {
+        for (int i = 0; i < depthCount[bits]; ++i) {
+            lengths[byFreq[next++]] = static_cast<uint8_t>(bits);
+        }
+    }
+}
+
+// 按字节追加的位输出（低位先出）
+class BitWriter {
+public:
+    void attach(std::string* out) { out_ = out; }
+
+    void putBits(uint32_t value, int count) {
+        bits_ |= uint64_t(value) << count_;
+        count_ += count;
+        while (count_ >= 8) {
+            out_->push_back(static_cast<char>(bits_ & 0xFF));
+            bits_ >>= 8;
+            count_ -= 8;
+        }
+    }
+
+    // 补齐到字节边界
+    void alignToByte() {
+        if (count_ > 0) {
+            out_->push_back(static_cast<char>(bits_ & 0xFF));
+            bits_ = 0;
+            count_ = 0;
+        }
+    }
+
+    void reset() {
+        bits_ = 0;
+        count_ = 0;
+    }
+
+private:
+    std::string* out_ = nullptr;
+    uint64_t bits_ = 0;
+    int count_ = 0;
+};
+
+// 压缩级别参数（与zlib的配置表一致）
+struct LevelConfig {
+    uint16_t goodLength;    // 已有匹配达到该长度时缩短搜索
+    uint16_t lazyLength;    // 已有匹配达到该长度时不再惰性搜索（贪心模式下为插入哈希的上限）
+    uint16_t niceLength;    // 匹配达到该长度时停止搜索
+    uint16_t chainLength;   // 最大哈希链搜索次数
+    bool lazy;
+};
+
+const LevelConfig LEVEL_CONFIGS[10] = {
+    {0, 0, 0, 0, false},
+    {4, 4, 8, 4, false},
+    {4, 5, 16, 8, false},
+    {4, 6, 32, 32, false},
+    {4, 4, 16, 16, true},
+    {8, 16, 32, 32, true},
+    {8, 16, 128, 128, true},
+    {8, 32, 128, 256, true},
+    {32, 128, 258, 1024, true},
+    {32, 258, 258, 4096, true}
+};
+
+} // namespace
+
+// Deflater::Impl
+
+class Deflater::Impl {
+public:
+    struct Symbol {
+        uint16_t litLen;    // 字面量字节或匹配长度
+        uint16_t dist;      // 0表示字面量
+    };
+
+    int level;
+    LevelConfig config;
+
+    // 滑动窗口：window[0]对应数据流中的windowStart
+    std::vector<uint8_t> window;
+    uint64_t windowStart = 0;
+    uint64_t pos = 0;               // 下一个待处理的位置
+    uint64_t emitted = 0;           // 已转成符号的位置
+    uint64_t blockStart = 0;        // 当前块的起始位置
+
+    std::vector<int64_t> head;
+    std::vector<int64_t> prev;
+
+    // 惰性匹配状态
+    bool matchAvailable = false;
+    size_t prevLength = 0;
+    size_t prevDist = 0;
+
+    std::vector<Symbol> symbols;
+    BitWriter writer;
+    bool finished = false;
+
+    explicit Impl(int lvl) : level(std::clamp(lvl, 0, 9)), config(LEVEL_CONFIGS[level]) {
+        reset();
+    }
+
+    void reset() {
+        window.clear();
+        windowStart = pos = emitted = blockStart = 0;
+        head.assign(HASH_SIZE, -1);
+        prev.assign(WINDOW_SIZE, -1);
+        matchAvailable = false;
+        prevLength = prevDist = 0;
+        symbols.clear();
+        writer.reset();
+        finished = false;
+    }
+
+    uint64_t end() const { return windowStart + window.size(); }
+    uint8_t at(uint64_t p) const { return window[p - windowStart]; }
+
+    uint32_t hashAt(uint64_t p) const {
+        const uint8_t* d = &window[p - windowStart];
+        uint32_t v = uint32_t(d[0]) | (uint32_t(d[1]) << 8) | (uint32_t(d[2]) << 16);
+        return (v * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    void insertHash(uint64_t p) {
+        if (p + MIN_MATCH > end()) {
+            return;
+        }
+        uint32_t h = hashAt(p);
+        prev[p & WINDOW_MASK] = head[h];
+        head[h] = static_cast<int64_t>(p);
+    }
+
+    // 在p处查找最长匹配（p已插入哈希表）
+    size_t findMatch(uint64_t p, size_t currentBest, size_t& bestDist) const {
+        size_t maxLength = std::min<uint64_t>(MAX_MATCH, end() - p);
+        if (maxLength < MIN_MATCH || currentBest >= maxLength) {
+            return 0;
+        }
+
+        size_t chain = config.chainLength;
+        if (currentBest >= config.goodLength) {
+            chain >>= 2;
+        }
+
+        const uint8_t* scan = &window[p - windowStart];
+        size_t bestLength = std::max<size_t>(currentBest, MIN_MATCH - 1);
+        size_t found = 0;
+        int64_t candidate = prev[p & WINDOW_MASK];
+        int64_t limit = std::max<int64_t>(static_cast<int64_t>(windowStart),
+                                          static_cast<int64_t>(p) - static_cast<int64_t>(WINDOW_SIZE));
+
+        while (candidate >= limit && chain-- > 0) {
+            const uint8_t* match = &window[static_cast<uint64_t>(candidate) - windowStart];
+            if (match[bestLength] == scan[bestLength] && match[0] == scan[0] && match[1] == scan[1]) {
+                size_t length = 2;
+                while (length < maxLength && match[length] == scan[length]) {
+                    ++length;
+                }
+                if (length > bestLength) {
+                    bestLength = length;
+                    found = length;
+                    bestDist = p - static_cast<uint64_t>(candidate);
+                    if (length >= config.niceLength || length >= maxLength) {
+                        break;
+                    }
+                }
+            }
+
+            int64_t next = prev[static_cast<uint64_t>(candidate) & WINDOW_MASK];
+            if (next >= candidate) {
+                break;  // 槽位已被更新的位置覆盖
+            }
+            candidate = next;
+        }
+
+        if (found == MIN_MATCH && bestDist > TOO_FAR) {
+            return 0;
+        }
+        return found;
+    }
+
+    void emitLiteral(uint8_t byte) {
+        symbols.push_back({byte, 0});
+        ++emitted;
+    }
+
+    void emitMatch(size_t length, size_t dist) {
+        symbols.push_back({static_cast<uint16_t>(length), static_cast<uint16_t>(dist)});
+        emitted += length;
+    }
+
+    bool blockFull() const {
+        return symbols.size() >= BLOCK_SYMBOLS || emitted - blockStart >= BLOCK_BYTES;
+    }
+
+    void process(bool finish, std::string& out) {
+        uint64_t limit = finish ? end() : (end() > MIN_LOOKAHEAD ? end() - MIN_LOOKAHEAD : 0);
+
+        if (level == 0) {
+            // 不压缩：直接按不压缩块的最大长度切分
+            while (pos < limit) {
+                uint64_t count = std::min<uint64_t>(limit - pos, MAX_STORED - (emitted - blockStart));
+                pos += count;
+                emitted += count;
+                if (emitted - blockStart == MAX_STORED) {
+                    flushBlock(false, out);
+                }
+            }
+        } else if (!config.lazy) {
+            processGreedy(limit, out);
+        } else {
+            processLazy(limit, out);
+        }
+
+        if (finish) {
+            if (matchAvailable) {
+                if (prevLength >= MIN_MATCH) {
+                    emitMatch(prevLength, prevDist);
+                    pos = pos - 1 + prevLength;
+                } else {
+                    emitLiteral(at(pos - 1));
+                }
+                matchAvailable = false;
+            }
+            flushBlock(true, out);
+            writer.alignToByte();
+            finished = true;
+        }
+
+        slideWindow();
+    }
+
+    void processGreedy(uint64_t limit, std::string& out) {
+        while (pos < limit) {
+            insertHash(pos);
+            size_t dist = 0;
+            size_t length = findMatch(pos, 0, dist);
+            if (length >= MIN_MATCH) {
+                emitMatch(length, dist);
+                uint64_t stop = pos + length;
+                if (length <= config.lazyLength) {
+                    for (uint64_t p = pos + 1; p < stop; ++p) {
+                        insertHash(p);
+                    }
+                }
+                pos = stop;
+            } else {
+                emitLiteral(at(pos++));
+            }
+            if (blockFull()) {
+                flushBlock(false, out);
+            }
+        }
+    }
+
+    void processLazy(uint64_t limit, std::string& out) {
+        while (pos < limit) {
+            insertHash(pos);
+            size_t dist = 0;
+            size_t length = 0;
+            if (!matchAvailable || prevLength < config.lazyLength) {
+                length = findMatch(pos, matchAvailable ? prevLength : 0, dist);
+            }
+
+            if (matchAvailable && prevLength >= MIN_MATCH && length <= prevLength) {
+                // 上一位置的匹配更好
+                emitMatch(prevLength, prevDist);
+                uint64_t stop = pos - 1 + prevLength;
+                for (uint64_t p = pos + 1; p < stop; ++p) {
+                    insertHash(p);
+                }
+                pos = stop;
+                matchAvailable = false;
+                prevLength = 0;
+            } else {
+                if (matchAvailable) {
+                    emitLiteral(at(pos - 1));
+                }
+                matchAvailable = true;
+                prevLength = length;
+                prevDist = dist;
+                ++pos;
+            }
+
+            if (blockFull()) {
+                flushBlock(false, out);
+            }
+        }
+    }
+
+    void slideWindow() {
+        // 保留32KB历史和尚未写出的当前块数据
+        uint64_t keepFrom = std::min<uint64_t>(blockStart, pos > WINDOW_SIZE + 1 ? pos - WINDOW_SIZE - 1 : 0);
+        if (keepFrom > windowStart && keepFrom - windowStart >= 2 * WINDOW_SIZE) {
+            window.erase(window.begin(), window.begin() + static_cast<std::ptrdiff_t>(keepFrom - windowStart));
+            windowStart = keepFrom;
+        }
+    }
+
+    // 输出当前块
+    void flushBlock(bool final, std::string& out) {
+        writer.attach(&out);
+        const auto& tables = codeTables();
+
+        uint32_t litFreq[LITLEN_CODES] = {};
+        uint32_t distFreq[DIST_CODES] = {};
+        for (const auto& symbol : symbols) {
+            if (symbol.dist == 0) {
+                litFreq[symbol.litLen]++;
+            } else {
+                litFreq[257 + tables.lengthCode[symbol.litLen]]++;
+                distFreq[tables.distanceCode(symbol.dist)]++;
+            }
+        }
+        litFreq[END_OF_BLOCK] = 1;
+
+        // 动态Huffman
+        uint8_t litLengths[LITLEN_CODES];
+        uint8_t distLengths[DIST_CODES];
+        buildLengths(litFreq, LITLEN_CODES, MAX_BITS, litLengths);
+        buildLengths(distFreq, DIST_CODES, MAX_BITS, distLengths);
+
+        int hlit = LITLEN_CODES;
+        while (hlit > 257 && litLengths[hlit - 1] == 0) {
+            --hlit;
+        }
+        int hdist = DIST_CODES;
+        while (hdist > 1 && distLengths[hdist - 1] == 0) {
+            --hdist;
+        }
+
+        // 码长序列的游程编码：(符号, 附加值)
+        std::vector<std::pair<uint8_t, uint8_t>> codeLengthRuns;
+        std::vector<uint8_t> allLengths(litLengths, litLengths + hlit);
+        allLengths.insert(allLengths.end(), distLengths, distLengths + hdist);
+        encodeRuns(allLengths, codeLengthRuns);
+
+        uint32_t clFreq[CODELEN_CODES] = {};
+        for (const auto& run : codeLengthRuns) {
+            clFreq[run.first]++;
+        }
+        uint8_t clLengths[CODELEN_CODES];
+        buildLengths(clFreq, CODELEN_CODES, MAX_CODELEN_BITS, clLengths);
+        int hclen = CODELEN_CODES;
+        while (hclen > 4 && clLengths[CODELEN_ORDER[hclen - 1]] == 0) {
+            --hclen;
+        }
+
+        // 各编码方式的位数
+        uint64_t dataBitsDynamic = 0;
+        uint64_t dataBitsFixed = 0;
+        for (int i = 0; i < LITLEN_CODES; ++i) {
+            uint64_t extra = i >= 257 ? LENGTH_EXTRA[i - 257] : 0;
+            dataBitsDynamic += litFreq[i] * (litLengths[i] + extra);
+            dataBitsFixed += litFreq[i] * (tables.fixedLitLen[i] + extra);
+        }
+        for (int i = 0; i < DIST_CODES; ++i) {
+            dataBitsDynamic += distFreq[i] * (distLengths[i] + DIST_EXTRA[i]);
+            dataBitsFixed += distFreq[i] * (5 + DIST_EXTRA[i]);
+        }
+        uint64_t headerBits = 3 + 5 + 5 + 4 + 3 * uint64_t(hclen);
+        for (const auto& run : codeLengthRuns) {
+            headerBits += clLengths[run.first];
+            headerBits += run.first == 16 ? 2 : run.first == 17 ? 3 : run.first == 18 ? 7 : 0;
+        }
+        uint64_t dynamicBits = headerBits + dataBitsDynamic;
+        uint64_t fixedBits = 3 + dataBitsFixed;
+
+        size_t rawLength = static_cast<size_t>(emitted - blockStart);
+        size_t storedBlocks = std::max<size_t>(1, (rawLength + MAX_STORED - 1) / MAX_STORED);
+        uint64_t storedBits = storedBlocks * (3 + 7 + 32) + uint64_t(rawLength) * 8;
+
+        if (level == 0 || (storedBits <= dynamicBits && storedBits <= fixedBits)) {
+            writeStored(final, rawLength);
+        } else if (fixedBits <= dynamicBits) {
+            uint16_t litCodes[288];
+            uint16_t distCodes[32];
+            buildCodes(tables.fixedLitLen, 288, litCodes);
+            buildCodes(tables.fixedDist, 32, distCodes);
+            writer.putBits(final ? 1 : 0, 1);
+            writer.putBits(1, 2);
+            writeSymbols(tables.fixedLitLen, litCodes, tables.fixedDist, distCodes);
+        } else {
+            uint16_t litCodes[LITLEN_CODES];
+            uint16_t distCodes[DIST_CODES];
+            uint16_t clCodes[CODELEN_CODES];
+            buildCodes(litLengths, LITLEN_CODES, litCodes);
+            buildCodes(distLengths, DIST_CODES, distCodes);
+            buildCodes(clLengths, CODELEN_CODES, clCodes);
+
+            writer.putBits(final ? 1 : 0, 1);
+            writer.putBits(2, 2);
+            writer.putBits(static_cast<uint32_t>(hlit - 257), 5);
+            writer.putBits(static_cast<uint32_t>(hdist - 1), 5);
+            writer.putBits(static_cast<uint32_t>(hclen - 4), 4);
+            for (int i = 0; i < hclen; ++i) {
+                writer.putBits(clLengths[CODELEN_ORDER[i]], 3);
+            }
+            for (const auto& run : codeLengthRuns) {
+                writer.putBits(clCodes[run.first], clLengths[run.first]);
+                if (run.first == 16) {
+                    writer.putBits(run.second, 2);
+                } else if (run.first == 17) {
+                    writer.putBits(run.second, 3);
+                } else if (run.first == 18) {
+                    writer.putBits(run.second, 7);
+                }
+            }
+            writeSymbols(litLengths, litCodes, distLengths, distCodes);
+        }
+
+        symbols.clear();
+        blockStart = emitted;
+    }
+
+    static void encodeRuns(const std::vector<uint8_t>& lengths,
+                           std::vector<std::pair<uint8_t, uint8_t>>& runs) {
+        size_t i = 0;
+        while (i < lengths.size()) {
+            uint8_t value = lengths[i];
+            size_t run = 1;
+            while (i + run < lengths.size() && lengths[i + run] == value) {
+                ++run;
+            }
+            i += run;
+
+            if (value == 0) {
+                while (run >= 11) {
+                    size_t count = std::min<size_t>(run, 138);
+                    runs.push_back({18, static_cast<uint8_t>(count - 11)});
+                    run -= count;
+                }
+                if (run >= 3) {
+                    runs.push_back({17, static_cast<uint8_t>(run - 3)});
+                    run = 0;
+                }
+            } else {
+                runs.push_back({value, 0});
+                --run;
+                while (run >= 3) {
+                    size_t count = std::min<size_t>(run, 6);
+                    runs.push_back({16, static_cast<uint8_t>(count - 3)});
+                    run -= count;
+                }
+            }
+            while (run-- > 0) {
+                runs.push_back({value, 0});
+            }
+        }
+    }
+
+    void writeSymbols(const uint8_t* litLengths, const uint16_t* litCodes,
+                      const uint8_t* distLengths, const uint16_t* distCodes) {
+        const auto& tables = codeTables();
+        for (const auto& symbol : symbols) {
+            if (symbol.dist == 0) {
+                writer.putBits(litCodes[symbol.litLen], litLengths[symbol.litLen]);
+            } else {
+                int lengthCode = tables.lengthCode[symbol.litLen];
+                writer.putBits(litCodes[257 + lengthCode], litLengths[257 + lengthCode]);
+                writer.putBits(symbol.litLen - LENGTH_BASE[lengthCode], LENGTH_EXTRA[lengthCode]);
+                int distCode = tables.distanceCode(symbol.dist);
+                writer.putBits(distCodes[distCode], distLengths[distCode]);
+                writer.putBits(symbol.dist - DIST_BASE[distCode], DIST_EXTRA[distCode]);
+            }
+        }
+        writer.putBits(litCodes[END_OF_BLOCK], litLengths[END_OF_BLOCK]);
+    }
+
+    void writeStored(bool final, size_t rawLength) {
+        uint64_t p = blockStart;
+        do {
+            size_t length = std::min(rawLength, MAX_STORED);
+            rawLength -= length;
+            writer.putBits(final && rawLength == 0 ? 1 : 0, 1);
+            writer.putBits(0, 2);
+            writer.alignToByte();
+            writer.putBits(static_cast<uint32_t>(length), 16);
+            writer.putBits(static_cast<uint32_t>(~length & 0xFFFF), 16);
+            for (size_t i = 0; i < length; ++i) {
+                writer.putBits(at(p + i), 8);
+            }
+            p += length;
+        } while (rawLength > 0);
+    }
+};
+
+Deflater::Deflater(int level) : pImpl(std::make_unique<Impl>(level)) {}
+
+Deflater::~Deflater() = default;
+
+void Deflater::deflate(const void* data, size_t size, bool finish, std::string& out) {
+    if (pImpl->finished) {
+        return;
+    }
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    pImpl->window.insert(pImpl->window.end(), bytes, bytes + size);
+    pImpl->writer.attach(&out);
+    pImpl->process(finish, out);
+}
+
+void Deflater::reset() {
+    pImpl->reset();
+}
+
+int Deflater::getLevel() const {
+    return pImpl->level;
+}
+
+std::string Deflater::compress(std::string_view data, int level) {
+    Deflater deflater(level);
+    std::string out;
+    out.reserve(data.size() / 2 + 64);
+    deflater.deflate(data.data(), data.size(), true, out);
+    return out;
+}
+
+// Inflater::Impl
+
+namespace {
+
+constexpr int FAST_BITS = 10;
+
+// Huffman解码表：短码一次查表，长码逐位按规范编码解码
+struct HuffmanTable {
+    uint16_t count[MAX_BITS + 1] = {};
+    uint16_t symbols[288] = {};
+    uint16_t fast[1 << FAST_BITS] = {};     // (符号 << 4) | 码长，0表示需逐位解码
+
+    // 码长超额（无法构成前缀码）时返回false
+    bool build(const uint8_t* lengths, int n) {
+        std::fill(std::begin(count), std::end(count), 0);
+        std::fill(std::begin(fast), std::end(fast), 0);
+        for (int i = 0; i < n; ++i) {
+            count[lengths[i]]++;
+        }
+        count[0] = 0;
+
+        int left = 1;
+        for (int bits = 1; bits <= MAX_BITS; ++bits) {
+            left <<= 1;
+            left -= count[bits];
+            if (left < 0) {
+                return false;
+            }
+        }
+
+        uint16_t offsets[MAX_BITS + 2] = {};
+        for (int bits = 1; bits <= MAX_BITS; ++bits) {
+            offsets[bits + 1] = static_cast<uint16_t>(offsets[bits] + count[bits]);
+        }
+        for (int i = 0; i < n; ++i) {
+            if (lengths[i] != 0) {
+                symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+            }
+        }
+
+        uint16_t codes[288];
+        buildCodes(lengths, n, codes);
+        for (int i = 0; i < n; ++i) {
+            int length = lengths[i];
+            if (length == 0 || length > FAST_BITS) {
+                continue;
+            }
+            for (uint32_t fill = codes[i]; fill < (1u << FAST_BITS); fill += 1u << length) {
+                fast[fill] = static_cast<uint16_t>((i << 4) | length);
+            }
+        }
+        return true;
+    }
+};
+
+const HuffmanTable& fixedLitLenTable() {
+    static const HuffmanTable table = []() {
+        HuffmanTable t;
+        t.build(codeTables().fixedLitLen, 288);
+        return t;
+    }();
+    return table;
+}
+
+const HuffmanTable& fixedDistTable() {
+    static const HuffmanTable table = []() {
+        HuffmanTable t;
+        t.build(codeTables().fixedDist, 30);
+        return t;
+    }();
+    return table;
+}
+
+} // namespace
+
+class Inflater::Impl {
+public:
+    enum class State { HEADER, STORED, HUFFMAN, DONE, ERROR };
+
+    Source source;
+    std::vector<uint8_t> input = std::vector<uint8_t>(16 * 1024);
+    size_t inputPos = 0;
+    size_t inputLength = 0;
+
+    uint64_t bits = 0;
+    int bitCount = 0;
+    int paddingBits = 0;            // 输入结束后补的零位（位于bits的高位）
+
+    std::vector<uint8_t> window = std::vector<uint8_t>(WINDOW_SIZE);
+    uint64_t totalOut = 0;
+
+    State state = State::HEADER;
+    bool finalBlock = false;
+    size_t storedRemaining = 0;
+    size_t copyLength = 0;
+    size_t copyDistance = 0;
+
+    HuffmanTable dynamicLitLen;
+    HuffmanTable dynamicDist;
+    const HuffmanTable* litLenTable = nullptr;
+    const HuffmanTable* distTable = nullptr;
+
+    std::string error;
+
+    explicit Impl(Source src) : source(std::move(src)) {}
+
+    void fail(const std::string& message) {
+        if (state != State::ERROR) {
+            error = message;
+            state = State::ERROR;
+        }
+    }
+
+    bool refill() {
+        inputPos = 0;
+        inputLength = source ? source(input.data(), input.size()) : 0;
+        return inputLength > 0;
+    }
+
+    // 保证缓冲中至少有n位（n <= 56），输入结束时补零
+    void need(int n) {
+        while (bitCount < n) {
+            if (inputPos == inputLength && !refill()) {
+                bitCount += 8;
+                paddingBits += 8;
+                continue;
+            }
+            bits |= uint64_t(input[inputPos++]) << bitCount;
+            bitCount += 8;
+        }
+    }
+
+    void consume(int n) {
+        bits >>= n;
+        bitCount -= n;
+        if (bitCount < paddingBits) {
+            fail("Unexpected end of compressed data");
+        }
+    }
+
+    uint32_t getBits(int n) {
+        if (n == 0) {
+            return 0;
+        }
+        need(n);
+        uint32_t value = static_cast<uint32_t>(bits & ((uint64_t(1) << n) - 1));
+        consume(n);
+        return value;
+    }
+
+    int decode(const HuffmanTable& table) {
+        need(MAX_BITS);
+        uint16_t entry = table.fast[bits & ((1u << FAST_BITS) - 1)];
+        if (entry != 0) {
+            consume(entry & 0xF);
+            return entry >> 4;
+        }
+
+        // 逐位解码（规范Huffman编码）
+        int code = 0;
+        int first = 0;
+        int index = 0;
+        for (int length = 1; length <= MAX_BITS; ++length) {
+            code |= static_cast<int>((bits >> (length - 1)) & 1);
+            int count = table.count[length];
+            if (code - first < count) {
+                consume(length);
+                return table.symbols[index + (code - first)];
+            }
+            index += count;
+            first += count;
+            first <<= 1;
+            code <<= 1;
+        }
+        fail("Invalid Huffman code");
+        return -1;
+    }
+
+    void readBlockHeader() {
+        if (finalBlock) {
+            state = State::DONE;
+            return;
+        }
+        finalBlock = getBits(1) != 0;
+        uint32_t type = getBits(2);
+
+        if (type == 0) {
+            // 丢弃到字节边界
+            consume(bitCount % 8);
+            uint32_t length = getBits(16);
+            uint32_t complement = getBits(16);
+            if ((length ^ 0xFFFF) != complement) {
+                fail("Invalid stored block length");
+                return;
+            }
+            storedRemaining = length;
+            state = State::STORED;
+        } else if (type == 1) {
+            litLenTable = &fixedLitLenTable();
+            distTable = &fixedDistTable();
+            state = State::HUFFMAN;
+        } else if (type == 2) {
+            if (readDynamicTables()) {
+                litLenTable = &dynamicLitLen;
+                distTable = &dynamicDist;
+                state = State::HUFFMAN;
+            }
+        } else {
+            fail("Invalid block type");
+        }
+    }
+
+    bool readDynamicTables() {
+        int hlit = static_cast<int>(getBits(5)) + 257;
+        int hdist = static_cast<int>(getBits(5)) + 1;
+        int hclen = static_cast<int>(getBits(4)) + 4;
+        if (hlit > LITLEN_CODES || hdist > DIST_CODES) {
+            fail("Invalid dynamic block header");
+            return false;
+        }
+
+        uint8_t clLengths[CODELEN_CODES] = {};
+        for (int i = 0; i < hclen; ++i) {
+            clLengths[CODELEN_ORDER[i]] = static_cast<uint8_t>(getBits(3));
+        }
+        HuffmanTable clTable;
+        if (!clTable.build(clLengths, CODELEN_CODES)) {
+            fail("Invalid code length code");
+            return false;
+        }
+
+        uint8_t lengths[LITLEN_CODES + DIST_CODES] = {};
+        int index = 0;
+        while (index < hlit + hdist && state != State::ERROR) {
+            int symbol = decode(clTable);
+            if (symbol < 0) {
+                return false;
+            }
+            if (symbol < 16) {
+                lengths[index++] = static_cast<uint8_t>(symbol);
+                continue;
+            }
+
+            uint8_t value = 0;
+            int repeat = 0;
+            if (symbol == 16) {
+                if (index == 0) {
+                    fail("Repeat with no previous length");
+                    return false;
+                }
+                value = lengths[index - 1];
+                repeat = 3 + static_cast<int>(getBits(2));
+            } else if (symbol == 17) {
+                repeat = 3 + static_cast<int>(getBits(3));
+            } else {
+                repeat = 11 + static_cast<int>(getBits(7));
+            }
+            if (index + repeat > hlit + hdist) {
+                fail("Too many code lengths");
+                return false;
+            }
+            while (repeat-- > 0) {
+                lengths[index++] = value;
+            }
+        }
+
+        if (state == State::ERROR) {
+            return false;
+        }
+        if (lengths[END_OF_BLOCK] == 0) {
+            fail("Missing end-of-block code");
+            return false;
+        }
+        if (!dynamicLitLen.build(lengths, hlit) || !dynamicDist.build(lengths + hlit, hdist)) {
+            fail("Invalid Huffman code lengths");
+            return false;
+        }
+        return true;
+    }
+
+    inline void put(uint8_t* out, size_t& produced, uint8_t byte) {
+        out[produced++] = byte;
+        window[totalOut & WINDOW_MASK] = byte;
+        ++totalOut;
+    }
+
+    size_t read(uint8_t* out, size_t size) {
+        size_t produced = 0;
+
+        while (produced < size) {
+            if (copyLength > 0) {
+                size_t count = std::min(copyLength, size - produced);
+                for (size_t i = 0; i < count; ++i) {
+                    put(out, produced, window[(totalOut - copyDistance) & WINDOW_MASK]);
+                }
+                copyLength -= count;
+                continue;
+            }
+
+            switch (state) {
+                case State::HEADER:
+                    readBlockHeader();
+                    break;
+
+                case State::STORED: {
+                    if (storedRemaining == 0) {
+                        state = finalBlock ? State::DONE : State::HEADER;
+                        break;
+                    }
+                    // 先取位缓冲中剩余的整字节，再直接读输入
+                    if (bitCount - paddingBits >= 8) {
+                        put(out, produced, static_cast<uint8_t>(getBits(8)));
+                        --storedRemaining;
+                        break;
+                    }
+                    if (inputPos == inputLength && !refill()) {
+                        fail("Unexpected end of stored block");
+                        break;
+                    }
+                    size_t count = std::min({storedRemaining, size - produced, inputLength - inputPos});
+                    for (size_t i = 0; i < count; ++i) {
+                        put(out, produced, input[inputPos++]);
+                    }
+                    storedRemaining -= count;
+                    break;
+                }
+
+                case State::HUFFMAN: {
+                    int symbol = decode(*litLenTable);
+                    if (state == State::ERROR) {
+                        break;
+                    }
+                    if (symbol < 256) {
+                        put(out, produced, static_cast<uint8_t>(symbol));
+                    } else if (symbol == END_OF_BLOCK) {
+                        state = finalBlock ? State::DONE : State::HEADER;
+                    } else {
+                        int lengthCode = symbol - 257;
+                        if (lengthCode >= 29) {
+                            fail("Invalid length code");
+                            break;
+                        }
+                        size_t length = LENGTH_BASE[lengthCode] + getBits(LENGTH_EXTRA[lengthCode]);
+                        int distCode = decode(*distTable);
+                        if (distCode < 0 || distCode >= DIST_CODES) {
+                            fail("Invalid distance code");
+                            break;
+                        }
+                        size_t distance = DIST_BASE[distCode] + getBits(DIST_EXTRA[distCode]);
+                        if (distance > totalOut) {
+                            fail("Distance too far back");
+                            break;
+                        }
+                        copyLength = length;
+                        copyDistance = distance;
+                    }
+                    break;
+                }
+
+                case State::DONE:
+                case State::ERROR:
+                    return produced;
+            }
+        }
+
+        return produced;
+    }
+};
+
+Inflater::Inflater(Source source) : pImpl(std::make_unique<Impl>(std::move(source))) {}
+
+Inflater::~Inflater() = default;
+
+size_t Inflater::read(void* buffer, size_t size) {
+    return pImpl->read(static_cast<uint8_t*>(buffer), size);
+}
+
+bool Inflater::finished() const {
+    return pImpl->state == Impl::State::DONE;
+}
+
+bool Inflater::failed() const {
+    return pImpl->state == Impl::State::ERROR;
+}
+
+const std::string& Inflater::getError() const {
+    return pImpl->error;
+}
+
+std::optional<std::string> Inflater::decompress(std::string_view data, size_t expectedSize) {
+    size_t offset = 0;
+    Inflater inflater([&](uint8_t* buffer, size_t size) {
+        size_t count = std::min(size, data.size() - offset);
+        std::memcpy(buffer, data.data() + offset, count);
+        offset += count;
+        return count;
+    });
+
+    std::string result;
+    result.reserve(expectedSize);
+    char chunk[64 * 1024];
+    size_t count;
+    while ((count = inflater.read(chunk, sizeof(chunk))) > 0) {
+        result.append(chunk, count);
+    }
+
+    if (!inflater.finished()) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+} // namespace CHTL
@@ -0,0 +1,77 @@
+#ifndef UTIL_DEFLATE_H
+#define UTIL_DEFLATE_H
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <memory>
+#include <functional>
+#include <cstdint>
+
+namespace CHTL {
+
+// DEFLATE压缩器（RFC 1951，原始数据流，不带zlib/gzip头）
+// 支持分段输入：每次deflate()追加压缩结果，finish为true时写出最后一个块。
+// 级别1-3使用贪心匹配，4-9使用惰性匹配，级别越高哈希链搜索越深；
+// 每个块在动态Huffman、固定Huffman和不压缩三种编码中选择最短的一种。
+class Deflater {
+public:
+    explicit Deflater(int level = 6);
+    ~Deflater();
+
+    // 压缩一段输入，结果追加到out
+    void deflate(const void* data, size_t size, bool finish, std::string& out);
+
+    // 重置为新的数据流
+    void reset();
+
+    int getLevel() const;
+
+    // 一次性压缩
+    static std::string compress(std::string_view data, int level = 6);
+
+    // 禁止拷贝
+    Deflater(const Deflater&) = delete;
+    Deflater& operator=(const Deflater&) = delete;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+// DEFLATE解压器（拉取式）
+// 需要输入时调用source读取压缩数据，read()每次最多产出size字节，
+// 只保留32KB的历史窗口，内存占用与条目大小无关。
+class Inflater {
+public:
+    // 读取最多size字节的压缩数据，返回0表示输入结束
+    using Source = std::function<size_t(uint8_t* buffer, size_t size)>;
+
+    explicit Inflater(Source source);
+    ~Inflater();
+
+    // 解压最多size字节，返回实际字节数；返回0表示数据流结束或出错
+    size_t read(void* buffer, size_t size);
+
+    // 数据流是否已完整结束
+    bool finished() const;
+
+    // 是否出错
+    bool failed() const;
+    const std::string& getError() const;
+
+    // 一次性解压（expectedSize仅用于预留空间）
+    static std::optional<std::string> decompress(std::string_view data, size_t expectedSize = 0);
+
+    // 禁止拷贝
+    Inflater(const Inflater&) = delete;
+    Inflater& operator=(const Inflater&) = delete;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+} // namespace CHTL
+
+#endif // UTIL_DEFLATE_H
@@ -1,45 +1,205 @@
 #include "ZIPUtil.h"
+#include "CRC32.h"
+#include "Deflate.h"
 #include <fstream>
 #include <filesystem>
 #include <cstring>
 #include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef _WIN32
 #include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
-// 简化版ZIP实现（实际项目中应使用libzip或minizip）
-// 这里实现一个基本的ZIP功能模拟
+// PKZIP格式实现（APPNOTE 6.3）
+// 支持不压缩(0)与DEFLATE(8)两种方法，不支持ZIP64与加密。
+// 读取时兼容旧版的CMODZIP1简单容器格式。
 
 namespace CHTL {
 
 namespace fs = std::filesystem;
 
+namespace {
+
 // ZIP文件头魔数
-// constexpr uint32_t ZIP_LOCAL_FILE_HEADER_SIGNATURE = 0x04034b50;
-// constexpr uint32_t ZIP_CENTRAL_DIR_SIGNATURE = 0x02014b50;
-// constexpr uint32_t ZIP_END_OF_CENTRAL_DIR_SIGNATURE = 0x06054b50;
-
-// 简单的ZIP结构（用于演示）
-struct LocalFileHeader {
-    uint32_t signature;
-    uint16_t version;
-    uint16_t flags;
-    uint16_t compression;
-    uint16_t modTime;
-    uint16_t modDate;
-    uint32_t crc32;
-    uint32_t compressedSize;
-    uint32_t uncompressedSize;
-    uint16_t filenameLen;
-    uint16_t extraLen;
+constexpr uint32_t ZIP_LOCAL_FILE_HEADER_SIGNATURE = 0x04034b50;
+constexpr uint32_t ZIP_CENTRAL_DIR_SIGNATURE = 0x02014b50;
+constexpr uint32_t ZIP_END_OF_CENTRAL_DIR_SIGNATURE = 0x06054b50;
+constexpr uint32_t ZIP_DATA_DESCRIPTOR_SIGNATURE = 0x08074b50;
+
+constexpr size_t LOCAL_HEADER_SIZE = 30;
+constexpr size_t CENTRAL_HEADER_SIZE = 46;
+constexpr size_t END_OF_CENTRAL_DIR_SIZE = 22;
+
+constexpr uint16_t METHOD_STORE = 0;
+constexpr uint16_t METHOD_DEFLATE = 8;
+
+constexpr uint16_t FLAG_DATA_DESCRIPTOR = 0x0008;   // 大小与CRC在数据之后
+constexpr uint16_t FLAG_UTF8 = 0x0800;              // 文件名为UTF-8
+
+constexpr uint16_t VERSION_NEEDED = 20;
+constexpr uint16_t VERSION_MADE_BY = (3 << 8) | 20; // Unix, 2.0
+
+constexpr uint64_t ZIP32_LIMIT = 0xFFFFFFFFu;
+
+// 流式读写的分块大小
+constexpr size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
+const char LEGACY_MAGIC[8] = {'C', 'M', 'O', 'D', 'Z', 'I', 'P', '1'};
+
+void put16(std::string& out, uint16_t value) {
+    out.push_back(static_cast<char>(value & 0xFF));
+    out.push_back(static_cast<char>(value >> 8));
+}
+
+void put32(std::string& out, uint32_t value) {
+    put16(out, static_cast<uint16_t>(value & 0xFFFF));
+    put16(out, static_cast<uint16_t>(value >> 16));
+}
+
+uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t get32(const uint8_t* p) {
+    return uint32_t(get16(p)) | (uint32_t(get16(p + 2)) << 16);
+}
+
+// time_t 与 MS-DOS 日期时间的转换（本地时间，2秒精度）
+void toDosDateTime(time_t value, uint16_t& dosTime, uint16_t& dosDate) {
+    std::tm* local = std::localtime(&value);
+    if (!local || local->tm_year < 80) {
+        dosTime = 0;
+        dosDate = (1 << 5) | 1;  // 1980-01-01
+        return;
+    }
+    dosTime = static_cast<uint16_t>((local->tm_hour << 11) | (local->tm_min << 5) | (local->tm_sec / 2));
+    dosDate = static_cast<uint16_t>(((local->tm_year - 80) << 9) | ((local->tm_mon + 1) << 5) | local->tm_mday);
+}
+
+time_t fromDosDateTime(uint16_t dosTime, uint16_t dosDate) {
+    std::tm local{};
+    local.tm_sec = (dosTime & 0x1F) * 2;
+    local.tm_min = (dosTime >> 5) & 0x3F;
+    local.tm_hour = dosTime >> 11;
+    local.tm_mday = dosDate & 0x1F;
+    local.tm_mon = ((dosDate >> 5) & 0x0F) - 1;
+    local.tm_year = (dosDate >> 9) + 80;
+    local.tm_isdst = -1;
+    return std::mktime(&local);
+}
+
+time_t lastWriteTime(const std::string& path) {
+    std::error_code ec;
+    auto ftime = fs::last_write_time(path, ec);
+    if (ec) {
+        return std::time(nullptr);
+    }
+    auto sctp = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+        ftime - fs::file_time_type::clock::now() + std::chrono::system_clock::now());
+    return std::chrono::system_clock::to_time_t(sctp);
+}
+
+// 条目名是否可以安全地解压到目标目录下（不含绝对路径和..）
+bool isSafeEntryName(const std::string& name) {
+    fs::path path(name);
+    if (path.is_absolute() || path.has_root_name() || path.has_root_directory()) {
+        return false;
+    }
+    for (const auto& part : path) {
+        if (part == "..") {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 中央目录中的条目
+struct ZIPEntry {
+    ZIPFileInfo info;
+    uint32_t crc32 = 0;
+    uint16_t flags = 0;
+    uint16_t dosTime = 0;
+    uint16_t dosDate = 0;
+    uint64_t localHeaderOffset = 0;
+    uint64_t dataOffset = 0;        // 0表示尚未从本地头计算
 };
 
+// 在归档末尾的tailSize字节中查找中央目录结束记录（其后只能跟注释）
+const uint8_t* findEndOfCentralDirectory(const uint8_t* tail, size_t tailSize) {
+    if (tailSize < END_OF_CENTRAL_DIR_SIZE) {
+        return nullptr;
+    }
+    for (size_t i = tailSize - END_OF_CENTRAL_DIR_SIZE + 1; i-- > 0;) {
+        if (get32(tail + i) == ZIP_END_OF_CENTRAL_DIR_SIGNATURE &&
+            i + END_OF_CENTRAL_DIR_SIZE + get16(tail + i + 20) == tailSize) {
+            return tail + i;
+        }
+    }
+    return nullptr;
+}
+
+// 解析中央目录中的entryCount个条目
+bool parseCentralDirectory(const uint8_t* directory, size_t size, size_t entryCount,
+                           std::vector<ZIPEntry>& entries) {
+    entries.clear();
+    entries.reserve(entryCount);
+    size_t pos = 0;
+    for (size_t i = 0; i < entryCount; ++i) {
+        if (pos + CENTRAL_HEADER_SIZE > size || get32(directory + pos) != ZIP_CENTRAL_DIR_SIGNATURE) {
+            return false;
+        }
+        const uint8_t* header = directory + pos;
+        size_t nameLength = get16(header + 28);
+        size_t extraLength = get16(header + 30);
+        size_t commentLength = get16(header + 32);
+        if (pos + CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength > size) {
+            return false;
+        }
+
+        ZIPEntry entry;
+        entry.flags = get16(header + 8);
+        entry.info.compressionMethod = get16(header + 10);
+        entry.dosTime = get16(header + 12);
+        entry.dosDate = get16(header + 14);
+        entry.crc32 = get32(header + 16);
+        entry.info.compressedSize = get32(header + 20);
+        entry.info.uncompressedSize = get32(header + 24);
+        entry.localHeaderOffset = get32(header + 42);
+        entry.info.filename.assign(reinterpret_cast<const char*>(header + CENTRAL_HEADER_SIZE), nameLength);
+        entry.info.isDirectory = !entry.info.filename.empty() && entry.info.filename.back() == '/';
+        entry.info.modificationTime = fromDosDateTime(entry.dosTime, entry.dosDate);
+        entries.push_back(std::move(entry));
+
+        pos += CENTRAL_HEADER_SIZE + nameLength + extraLength + commentLength;
+    }
+    return true;
+}
+
+} // namespace
+
 // ZIPUtil::Impl 实现
 class ZIPUtil::Impl {
 public:
+    // 待写入的条目：来自磁盘文件或内存数据
+    struct PendingFile {
+        std::string entryName;
+        std::string sourcePath;
+        std::string data;
+        bool fromMemory = false;
+    };
+
     int compressionLevel = 6;
     std::string currentArchive;
-    std::vector<std::pair<std::string, std::string>> pendingFiles;
+    std::vector<PendingFile> pendingFiles;
     std::function<void(size_t, size_t)> progressCallback;
-    
+
     bool isCreating = false;
 };
 
@@ -55,13 +215,13 @@ bool ZIPUtil::createArchive(const std::string& zipPath) {
     pImpl->currentArchive = zipPath;
     pImpl->pendingFiles.clear();
     pImpl->isCreating = true;
-    
+
     // 确保目录存在
     fs::path zipFilePath(zipPath);
     if (zipFilePath.has_parent_path()) {
         fs::create_directories(zipFilePath.parent_path());
     }
-    
+
     return true;
 }
 
@@ -70,25 +230,19 @@ bool ZIPUtil::addFile(const std::string& filePath, const std::string& entryName)
         lastError_ = "No archive is being created";
         return false;
     }
-    
+
     if (!fs::exists(filePath)) {
         lastError_ = "File not found: " + filePath;
         return false;
     }
-    
-    // 读取文件内容
-    std::ifstream file(filePath, std::ios::binary);
-    if (!file.is_open()) {
-        lastError_ = "Failed to open file: " + filePath;
-        return false;
-    }
-    
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    
+
+    // 内容在finalize时分块读取，这里只记录路径
     std::string name = entryName.empty() ? fs::path(filePath).filename().string() : entryName;
-    pImpl->pendingFiles.push_back({normalizeEntryName(name), buffer.str()});
-    
+    Impl::PendingFile pending;
+    pending.entryName = normalizeEntryName(name);
+    pending.sourcePath = filePath;
+    pImpl->pendingFiles.push_back(std::move(pending));
+
     return true;
 }
 
@@ -97,8 +251,12 @@ bool ZIPUtil::addFromMemory(const std::string& entryName, const std::string& dat
         lastError_ = "No archive is being created";
         return false;
     }
-    
-    pImpl->pendingFiles.push_back({normalizeEntryName(entryName), data});
+
+    Impl::PendingFile pending;
+    pending.entryName = normalizeEntryName(entryName);
+    pending.data = data;
+    pending.fromMemory = true;
+    pImpl->pendingFiles.push_back(std::move(pending));
     return true;
 }
 
@@ -107,25 +265,25 @@ bool ZIPUtil::addDirectory(const std::string& dirPath, const std::string& entryP
         lastError_ = "No archive is being created";
         return false;
     }
-    
+
     if (!fs::exists(dirPath) || !fs::is_directory(dirPath)) {
         lastError_ = "Invalid directory: " + dirPath;
         return false;
     }
-    
+
     for (const auto& entry : fs::recursive_directory_iterator(dirPath)) {
         if (entry.is_regular_file()) {
             fs::path relativePath = fs::relative(entry.path(), dirPath);
-            std::string entryName = entryPrefix.empty() ? 
-                relativePath.string() : 
+            std::string entryName = entryPrefix.empty() ?
+                relativePath.string() :
                 entryPrefix + "/" + relativePath.string();
-            
+
             if (!addFile(entry.path().string(), entryName)) {
                 return false;
             }
         }
     }
-    
+
     return true;
 }
 
@@ -134,50 +292,61 @@ bool ZIPUtil::finalize() {
         lastError_ = "No archive is being created";
         return false;
     }
-    
-    // 简化实现：将文件写入为TAR格式（演示用途）
-    std::ofstream archive(pImpl->currentArchive, std::ios::binary);
-    if (!archive.is_open()) {
+
+    ZIPWriter writer;
+    if (!writer.create(pImpl->currentArchive)) {
         lastError_ = "Failed to create archive: " + pImpl->currentArchive;
         return false;
     }
-    
-    // 写入简单的头部
-    const char* magic = "CMODZIP1";
-    archive.write(magic, 8);
-    
-    // 写入文件数量
-    uint32_t fileCount = static_cast<uint32_t>(pImpl->pendingFiles.size());
-    archive.write(reinterpret_cast<const char*>(&fileCount), sizeof(fileCount));
-    
-    // 写入每个文件
+
+    size_t fileCount = pImpl->pendingFiles.size();
     size_t current = 0;
-    for (const auto& [name, content] : pImpl->pendingFiles) {
-        // 文件名长度
-        uint32_t nameLen = static_cast<uint32_t>(name.length());
-        archive.write(reinterpret_cast<const char*>(&nameLen), sizeof(nameLen));
-        
-        // 文件名
-        archive.write(name.c_str(), nameLen);
-        
-        // 文件内容长度
-        uint32_t contentLen = static_cast<uint32_t>(content.length());
-        archive.write(reinterpret_cast<const char*>(&contentLen), sizeof(contentLen));
-        
-        // 文件内容
-        archive.write(content.c_str(), contentLen);
-        
+    std::vector<char> buffer(STREAM_CHUNK_SIZE);
+
+    for (const auto& pending : pImpl->pendingFiles) {
+        time_t modified = pending.fromMemory ? 0 : lastWriteTime(pending.sourcePath);
+        if (!writer.beginFile(pending.entryName, pImpl->compressionLevel, modified)) {
+            lastError_ = writer.getLastError();
+            return false;
+        }
+
+        bool written = true;
+        if (pending.fromMemory) {
+            written = writer.write(pending.data.data(), pending.data.size());
+        } else {
+            std::ifstream file(pending.sourcePath, std::ios::binary);
+            if (!file.is_open()) {
+                lastError_ = "Failed to open file: " + pending.sourcePath;
+                return false;
+            }
+            while (written && file) {
+                file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                std::streamsize count = file.gcount();
+                if (count > 0) {
+                    written = writer.write(buffer.data(), static_cast<size_t>(count));
+                }
+            }
+        }
+
+        if (!written || !writer.endFile()) {
+            lastError_ = writer.getLastError();
+            return false;
+        }
+
         // 进度回调
         if (pImpl->progressCallback) {
             pImpl->progressCallback(++current, fileCount);
         }
     }
-    
-    archive.close();
+
+    bool success = writer.close();
+    if (!success) {
+        lastError_ = writer.getLastError();
+    }
     pImpl->isCreating = false;
     pImpl->pendingFiles.clear();
-    
-    return archive.good();
+
+    return success;
 }
 
 bool ZIPUtil::extractArchive(const std::string& zipPath, const std::string& destDir) {
@@ -185,64 +354,60 @@ bool ZIPUtil::extractArchive(const std::string& zipPath, const std::string& dest
         lastError_ = "Archive not found: " + zipPath;
         return false;
     }
-    
-    std::ifstream archive(zipPath, std::ios::binary);
-    if (!archive.is_open()) {
-        lastError_ = "Failed to open archive: " + zipPath;
-        return false;
-    }
-    
-    // 读取头部
-    char magic[8];
-    archive.read(magic, 8);
-    if (std::strncmp(magic, "CMODZIP1", 8) != 0) {
-        lastError_ = "Invalid archive format";
+
+    ZIPReader reader;
+    if (!reader.open(zipPath)) {
+        lastError_ = reader.getLastError().empty() ? "Failed to open archive: " + zipPath : reader.getLastError();
         return false;
     }
-    
-    // 读取文件数量
-    uint32_t fileCount;
-    archive.read(reinterpret_cast<char*>(&fileCount), sizeof(fileCount));
-    
+
     // 创建目标目录
     fs::create_directories(destDir);
-    
+
+    auto files = reader.getFileList();
+    size_t fileCount = files.size();
+    std::vector<char> buffer(STREAM_CHUNK_SIZE);
+
     // 解压每个文件
-    for (uint32_t i = 0; i < fileCount; ++i) {
-        // 读取文件名长度
-        uint32_t nameLen;
-        archive.read(reinterpret_cast<char*>(&nameLen), sizeof(nameLen));
-        
-        // 读取文件名
-        std::string name(nameLen, '\0');
-        archive.read(&name[0], nameLen);
-        
-        // 读取内容长度
-        uint32_t contentLen;
-        archive.read(reinterpret_cast<char*>(&contentLen), sizeof(contentLen));
-        
-        // 读取内容
-        std::string content(contentLen, '\0');
-        archive.read(&content[0], contentLen);
-        
-        // 写入文件
-        fs::path filePath = fs::path(destDir) / name;
-        fs::create_directories(filePath.parent_path());
-        
-        std::ofstream outFile(filePath, std::ios::binary);
-        outFile.write(content.c_str(), content.length());
-        
-        if (!outFile.good()) {
-            lastError_ = "Failed to extract file: " + name;
+    for (size_t i = 0; i < fileCount; ++i) {
+        const auto& info = files[i];
+        if (!isSafeEntryName(info.filename)) {
+            lastError_ = "Unsafe entry name in archive: " + info.filename;
             return false;
         }
-        
+
+        fs::path filePath = fs::path(destDir) / info.filename;
+        if (info.isDirectory) {
+            fs::create_directories(filePath);
+        } else {
+            if (!reader.locateFile(info.filename)) {
+                lastError_ = reader.getLastError();
+                return false;
+            }
+
+            fs::create_directories(filePath.parent_path());
+            std::ofstream outFile(filePath, std::ios::binary);
+            size_t count;
+            while ((count = reader.read(buffer.data(), buffer.size())) > 0) {
+                outFile.write(buffer.data(), static_cast<std::streamsize>(count));
+            }
+
+            if (!reader.getLastError().empty()) {
+                lastError_ = "Failed to extract file: " + info.filename + ": " + reader.getLastError();
+                return false;
+            }
+            if (!outFile.good()) {
+                lastError_ = "Failed to extract file: " + info.filename;
+                return false;
+            }
+        }
+
         // 进度回调
         if (pImpl->progressCallback) {
             pImpl->progressCallback(i + 1, fileCount);
         }
     }
-    
+
     return true;
 }
 
@@ -251,169 +416,71 @@ bool ZIPUtil::extractFile(const std::string& zipPath, const std::string& entryNa
         lastError_ = "Archive not found: " + zipPath;
         return false;
     }
-    
-    std::ifstream archive(zipPath, std::ios::binary);
-    if (!archive.is_open()) {
-        lastError_ = "Failed to open archive: " + zipPath;
+
+    ZIPReader reader;
+    if (!reader.open(zipPath)) {
+        lastError_ = reader.getLastError().empty() ? "Failed to open archive: " + zipPath : reader.getLastError();
         return false;
     }
-    
-    // 读取头部
-    char magic[8];
-    archive.read(magic, 8);
-    if (std::strncmp(magic, "CMODZIP1", 8) != 0) {
-        lastError_ = "Invalid archive format";
+
+    if (!reader.locateFile(entryName)) {
+        lastError_ = "File not found in archive: " + entryName;
         return false;
     }
-    
-    // 读取文件数量
-    uint32_t fileCount;
-    archive.read(reinterpret_cast<char*>(&fileCount), sizeof(fileCount));
-    
-    // 查找文件
-    for (uint32_t i = 0; i < fileCount; ++i) {
-        // 读取文件名长度
-        uint32_t nameLen;
-        archive.read(reinterpret_cast<char*>(&nameLen), sizeof(nameLen));
-        
-        // 读取文件名
-        std::string name(nameLen, '\0');
-        archive.read(&name[0], nameLen);
-        
-        // 读取内容长度
-        uint32_t contentLen;
-        archive.read(reinterpret_cast<char*>(&contentLen), sizeof(contentLen));
-        
-        if (name == entryName) {
-            // 找到目标文件，读取内容
-            std::string content(contentLen, '\0');
-            archive.read(&content[0], contentLen);
-            
-            // 写入文件
-            fs::path filePath(destPath);
-            fs::create_directories(filePath.parent_path());
-            
-            std::ofstream outFile(filePath, std::ios::binary);
-            outFile.write(content.c_str(), content.length());
-            
-            return outFile.good();
-        } else {
-            // 跳过内容
-            archive.seekg(contentLen, std::ios::cur);
-        }
+
+    // 写入文件
+    fs::path filePath(destPath);
+    if (filePath.has_parent_path()) {
+        fs::create_directories(filePath.parent_path());
     }
-    
-    lastError_ = "File not found in archive: " + entryName;
-    return false;
+
+    std::ofstream outFile(filePath, std::ios::binary);
+    std::vector<char> buffer(STREAM_CHUNK_SIZE);
+    size_t count;
+    while ((count = reader.read(buffer.data(), buffer.size())) > 0) {
+        outFile.write(buffer.data(), static_cast<std::streamsize>(count));
+    }
+
+    if (!reader.getLastError().empty()) {
+        lastError_ = reader.getLastError();
+        return false;
+    }
+    return outFile.good();
 }
 
 std::vector<ZIPFileInfo> ZIPUtil::listFiles(const std::string& zipPath) {
-    std::vector<ZIPFileInfo> files;
-    
-    if (!fs::exists(zipPath)) {
-        return files;
-    }
-    
-    std::ifstream archive(zipPath, std::ios::binary);
-    if (!archive.is_open()) {
-        return files;
-    }
-    
-    // 读取头部
-    char magic[8];
-    archive.read(magic, 8);
-    if (std::strncmp(magic, "CMODZIP1", 8) != 0) {
-        return files;
-    }
-    
-    // 读取文件数量
-    uint32_t fileCount;
-    archive.read(reinterpret_cast<char*>(&fileCount), sizeof(fileCount));
-    
-    // 读取文件信息
-    for (uint32_t i = 0; i < fileCount; ++i) {
-        ZIPFileInfo info;
-        
-        // 读取文件名长度
-        uint32_t nameLen;
-        archive.read(reinterpret_cast<char*>(&nameLen), sizeof(nameLen));
-        
-        // 读取文件名
-        info.filename.resize(nameLen);
-        archive.read(&info.filename[0], nameLen);
-        
-        // 读取内容长度
-        uint32_t contentLen;
-        archive.read(reinterpret_cast<char*>(&contentLen), sizeof(contentLen));
-        
-        info.uncompressedSize = contentLen;
-        info.compressedSize = contentLen; // 简化实现，无压缩
-        info.isDirectory = false;
-        info.compressionMethod = 0;
-        info.modificationTime = std::time(nullptr);
-        
-        files.push_back(info);
-        
-        // 跳过内容
-        archive.seekg(contentLen, std::ios::cur);
-    }
-    
-    return files;
+    ZIPReader reader;
+    if (!reader.open(zipPath)) {
+        return {};
+    }
+    return reader.getFileList();
 }
 
 bool ZIPUtil::fileExists(const std::string& zipPath, const std::string& entryName) {
     auto files = listFiles(zipPath);
-    return std::any_of(files.begin(), files.end(), 
+    return std::any_of(files.begin(), files.end(),
         [&](const ZIPFileInfo& info) { return info.filename == entryName; });
 }
 
 std::string ZIPUtil::readFileToString(const std::string& zipPath, const std::string& entryName) {
-    if (!fs::exists(zipPath)) {
+    ZIPReader reader;
+    if (!reader.open(zipPath) || !reader.locateFile(entryName)) {
         return "";
     }
-    
-    std::ifstream archive(zipPath, std::ios::binary);
-    if (!archive.is_open()) {
-        return "";
+
+    std::string content;
+    content.reserve(reader.getCurrentFileInfo().uncompressedSize);
+    std::vector<char> buffer(STREAM_CHUNK_SIZE);
+    size_t count;
+    while ((count = reader.read(buffer.data(), buffer.size())) > 0) {
+        content.append(buffer.data(), count);
     }
-    
-    // 读取头部
-    char magic[8];
-    archive.read(magic, 8);
-    if (std::strncmp(magic, "CMODZIP1", 8) != 0) {
+
+    if (!reader.getLastError().empty()) {
+        lastError_ = reader.getLastError();
         return "";
     }
-    
-    // 读取文件数量
-    uint32_t fileCount;
-    archive.read(reinterpret_cast<char*>(&fileCount), sizeof(fileCount));
-    
-    // 查找文件
-    for (uint32_t i = 0; i < fileCount; ++i) {
-        // 读取文件名长度
-        uint32_t nameLen;
-        archive.read(reinterpret_cast<char*>(&nameLen), sizeof(nameLen));
-        
-        // 读取文件名
-        std::string name(nameLen, '\0');
-        archive.read(&name[0], nameLen);
-        
-        // 读取内容长度
-        uint32_t contentLen;
-        archive.read(reinterpret_cast<char*>(&contentLen), sizeof(contentLen));
-        
-        if (name == entryName) {
-            // 找到目标文件，读取内容
-            std::string content(contentLen, '\0');
-            archive.read(&content[0], contentLen);
-            return content;
-        } else {
-            // 跳过内容
-            archive.seekg(contentLen, std::ios::cur);
-        }
-    }
-    
-    return "";
+    return content;
 }
 
 void ZIPUtil::setProgressCallback(std::function<void(size_t, size_t)> callback) {
@@ -432,12 +499,12 @@ bool ZIPUtil::ensureDirectoryExists(const std::string& path) {
 std::string ZIPUtil::normalizeEntryName(const std::string& name) {
     std::string normalized = name;
     std::replace(normalized.begin(), normalized.end(), '\\', '/');
-    
+
     // 移除开头的斜杠
     if (!normalized.empty() && normalized[0] == '/') {
         normalized = normalized.substr(1);
     }
-    
+
     return normalized;
 }
 
@@ -445,9 +512,191 @@ std::string ZIPUtil::normalizeEntryName(const std::string& name) {
 class ZIPReader::Impl {
 public:
     std::ifstream archive;
-    std::string currentFile;
-    std::vector<ZIPFileInfo> fileList;
+    uint64_t archiveSize = 0;
+    std::vector<ZIPEntry> entries;
     size_t currentPos = 0;
+    bool legacy = false;            // 旧版CMODZIP1格式（无CRC）
+    std::string lastError;
+
+    // 当前条目的读取状态
+    bool reading = false;
+    uint64_t compressedRemaining = 0;
+    uint64_t produced = 0;
+    uint32_t crc = 0;
+    std::unique_ptr<Inflater> inflater;
+
+    bool fail(const std::string& message) {
+        lastError = message;
+        reading = false;
+        return false;
+    }
+
+    bool readAt(uint64_t offset, void* buffer, size_t size) {
+        archive.clear();
+        archive.seekg(static_cast<std::streamoff>(offset));
+        archive.read(static_cast<char*>(buffer), static_cast<std::streamsize>(size));
+        return static_cast<size_t>(archive.gcount()) == size;
+    }
+
+    // 从文件末尾查找中央目录结束记录并解析中央目录
+    bool readCentralDirectory() {
+        size_t tailSize = static_cast<size_t>(std::min<uint64_t>(archiveSize, END_OF_CENTRAL_DIR_SIZE + 0xFFFF));
+        if (tailSize < END_OF_CENTRAL_DIR_SIZE) {
+            return fail("Invalid archive format");
+        }
+        std::vector<uint8_t> tail(tailSize);
+        if (!readAt(archiveSize - tailSize, tail.data(), tailSize)) {
+            return fail("Failed to read archive");
+        }
+
+        const uint8_t* eocd = findEndOfCentralDirectory(tail.data(), tailSize);
+        if (!eocd) {
+            return fail("Invalid archive format");
+        }
+
+        size_t entryCount = get16(eocd + 10);
+        uint64_t directorySize = get32(eocd + 12);
+        uint64_t directoryOffset = get32(eocd + 16);
+        if (directoryOffset + directorySize > archiveSize) {
+            return fail("Corrupted central directory");
+        }
+
+        std::vector<uint8_t> directory(static_cast<size_t>(directorySize));
+        if (!readAt(directoryOffset, directory.data(), directory.size())) {
+            return fail("Failed to read central directory");
+        }
+
+        if (!parseCentralDirectory(directory.data(), directory.size(), entryCount, entries)) {
+            return fail("Corrupted central directory");
+        }
+
+        legacy = false;
+        return true;
+    }
+
+    // 旧版CMODZIP1：魔数、条目数，然后依次为名称长度、名称、内容长度、内容
+    bool readLegacyDirectory() {
+        uint8_t header[12];
+        if (!readAt(0, header, sizeof(header)) || std::memcmp(header, LEGACY_MAGIC, 8) != 0) {
+            return false;
+        }
+
+        uint32_t fileCount = get32(header + 8);
+        uint64_t offset = sizeof(header);
+        entries.clear();
+        for (uint32_t i = 0; i < fileCount; ++i) {
+            uint8_t length[4];
+            if (!readAt(offset, length, 4)) {
+                return fail("Corrupted archive");
+            }
+            uint32_t nameLength = get32(length);
+            ZIPEntry entry;
+            entry.info.filename.resize(nameLength);
+            if (!readAt(offset + 4, &entry.info.filename[0], nameLength) ||
+                !readAt(offset + 4 + nameLength, length, 4)) {
+                return fail("Corrupted archive");
+            }
+            uint32_t contentLength = get32(length);
+            entry.info.uncompressedSize = contentLength;
+            entry.info.compressedSize = contentLength;
+            entry.info.isDirectory = false;
+            entry.info.compressionMethod = METHOD_STORE;
+            entry.info.modificationTime = std::time(nullptr);
+            entry.dataOffset = offset + 8 + nameLength;
+            if (entry.dataOffset + contentLength > archiveSize) {
+                return fail("Corrupted archive");
+            }
+            offset = entry.dataOffset + contentLength;
+            entries.push_back(std::move(entry));
+        }
+
+        legacy = true;
+        return true;
+    }
+
+    // 读取压缩数据（不超过当前条目的剩余压缩大小）
+    size_t readCompressed(uint8_t* buffer, size_t size) {
+        size_t count = static_cast<size_t>(std::min<uint64_t>(size, compressedRemaining));
+        if (count == 0) {
+            return 0;
+        }
+        archive.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(count));
+        count = static_cast<size_t>(archive.gcount());
+        compressedRemaining -= count;
+        return count;
+    }
+
+    bool beginEntry(ZIPEntry& entry) {
+        reading = false;
+        lastError.clear();
+
+        if (entry.dataOffset == 0) {
+            uint8_t header[LOCAL_HEADER_SIZE];
+            if (!readAt(entry.localHeaderOffset, header, sizeof(header)) ||
+                get32(header) != ZIP_LOCAL_FILE_HEADER_SIGNATURE) {
+                return fail("Invalid local file header: " + entry.info.filename);
+            }
+            entry.dataOffset = entry.localHeaderOffset + LOCAL_HEADER_SIZE + get16(header + 26) + get16(header + 28);
+        }
+        if (entry.dataOffset + entry.info.compressedSize > archiveSize) {
+            return fail("Truncated entry: " + entry.info.filename);
+        }
+
+        if (entry.info.compressionMethod != METHOD_STORE && entry.info.compressionMethod != METHOD_DEFLATE) {
+            return fail("Unsupported compression method " + std::to_string(entry.info.compressionMethod) +
+                        ": " + entry.info.filename);
+        }
+        if (entry.flags & 0x0001) {
+            return fail("Encrypted entries are not supported: " + entry.info.filename);
+        }
+
+        archive.clear();
+        archive.seekg(static_cast<std::streamoff>(entry.dataOffset));
+        compressedRemaining = entry.info.compressedSize;
+        produced = 0;
+        crc = 0;
+        inflater.reset();
+        if (entry.info.compressionMethod == METHOD_DEFLATE) {
+            inflater = std::make_unique<Inflater>([this](uint8_t* buffer, size_t size) {
+                return readCompressed(buffer, size);
+            });
+        }
+        reading = true;
+        return true;
+    }
+
+    size_t read(void* buffer, size_t size) {
+        if (!reading || currentPos >= entries.size()) {
+            return 0;
+        }
+        const ZIPEntry& entry = entries[currentPos];
+
+        size_t count = 0;
+        if (inflater) {
+            count = inflater->read(buffer, size);
+            if (inflater->failed()) {
+                fail("Corrupted entry " + entry.info.filename + ": " + inflater->getError());
+                return 0;
+            }
+        } else {
+            count = readCompressed(static_cast<uint8_t*>(buffer), size);
+        }
+
+        if (count > 0) {
+            crc = CRC32::update(crc, buffer, count);
+            produced += count;
+            return count;
+        }
+
+        // 数据流结束：校验大小与CRC
+        reading = false;
+        if (produced != entry.info.uncompressedSize) {
+            fail("Size mismatch in entry: " + entry.info.filename);
+        } else if (!legacy && crc != entry.crc32) {
+            fail("CRC mismatch in entry: " + entry.info.filename);
+        }
+        return count;
+    }
 };
 
 ZIPReader::ZIPReader() : pImpl(std::make_unique<Impl>()) {}
@@ -458,51 +707,84 @@ ZIPReader::~ZIPReader() {
 
 bool ZIPReader::open(const std::string& zipPath) {
     close();
-    
+
     pImpl->archive.open(zipPath, std::ios::binary);
     if (!pImpl->archive.is_open()) {
+        pImpl->lastError = "Failed to open archive: " + zipPath;
         return false;
     }
-    
+
+    pImpl->archive.seekg(0, std::ios::end);
+    pImpl->archiveSize = static_cast<uint64_t>(pImpl->archive.tellg());
+
     // 读取文件列表
-    ZIPUtil util;
-    pImpl->fileList = util.listFiles(zipPath);
-    
-    return !pImpl->fileList.empty();
+    if (!pImpl->readLegacyDirectory() && pImpl->lastError.empty()) {
+        pImpl->readCentralDirectory();
+    }
+
+    if (!pImpl->lastError.empty()) {
+        pImpl->archive.close();
+        pImpl->entries.clear();
+        return false;
+    }
+
+    return true;
 }
 
 void ZIPReader::close() {
     if (pImpl->archive.is_open()) {
         pImpl->archive.close();
     }
-    pImpl->fileList.clear();
+    pImpl->entries.clear();
     pImpl->currentPos = 0;
+    pImpl->reading = false;
+    pImpl->inflater.reset();
+    pImpl->lastError.clear();
 }
 
 std::vector<ZIPFileInfo> ZIPReader::getFileList() {
-    return pImpl->fileList;
+    std::vector<ZIPFileInfo> files;
+    files.reserve(pImpl->entries.size());
+    for (const auto& entry : pImpl->entries) {
+        files.push_back(entry.info);
+    }
+    return files;
 }
 
 bool ZIPReader::locateFile(const std::string& entryName) {
-    auto it = std::find_if(pImpl->fileList.begin(), pImpl->fileList.end(),
-        [&](const ZIPFileInfo& info) { return info.filename == entryName; });
-    
-    if (it != pImpl->fileList.end()) {
-        pImpl->currentPos = std::distance(pImpl->fileList.begin(), it);
-        return true;
+    auto it = std::find_if(pImpl->entries.begin(), pImpl->entries.end(),
+        [&](const ZIPEntry& entry) { return entry.info.filename == entryName; });
+
+    if (it != pImpl->entries.end()) {
+        pImpl->currentPos = std::distance(pImpl->entries.begin(), it);
+        return pImpl->beginEntry(*it);
     }
-    
+
+    pImpl->lastError = "File not found in archive: " + entryName;
     return false;
 }
 
 std::vector<uint8_t> ZIPReader::readCurrentFile() {
-    // 简化实现
-    return std::vector<uint8_t>();
+    std::vector<uint8_t> data;
+    if (!pImpl->reading) {
+        return data;
+    }
+
+    data.reserve(pImpl->entries[pImpl->currentPos].info.uncompressedSize);
+    std::vector<uint8_t> buffer(STREAM_CHUNK_SIZE);
+    size_t count;
+    while ((count = read(buffer.data(), buffer.size())) > 0) {
+        data.insert(data.end(), buffer.begin(), buffer.begin() + count);
+    }
+
+    if (!pImpl->lastError.empty()) {
+        data.clear();
+    }
+    return data;
 }
 
-size_t ZIPReader::read(void* /*buffer*/, size_t /*size*/) {
-    // 简化实现
-    return 0;
+size_t ZIPReader::read(void* buffer, size_t size) {
+    return pImpl->read(buffer, size);
 }
 
 bool ZIPReader::isOpen() const {
@@ -510,21 +792,100 @@ bool ZIPReader::isOpen() const {
 }
 
 ZIPFileInfo ZIPReader::getCurrentFileInfo() {
-    if (pImpl->currentPos < pImpl->fileList.size()) {
-        return pImpl->fileList[pImpl->currentPos];
+    if (pImpl->currentPos < pImpl->entries.size()) {
+        return pImpl->entries[pImpl->currentPos].info;
     }
     return ZIPFileInfo();
 }
 
+const std::string& ZIPReader::getLastError() const {
+    return pImpl->lastError;
+}
+
 // ZIPWriter::Impl
 class ZIPWriter::Impl {
 public:
     std::ofstream archive;
-    std::vector<std::pair<std::string, std::string>> files;
-    std::string currentFileName;
-    std::stringstream currentFileData;
-    int compressionLevel = 6;
+    std::vector<ZIPEntry> entries;
+    uint64_t offset = 0;
     std::string comment;
+    std::string lastError;
+
+    // 当前条目
+    bool inFile = false;
+    ZIPEntry current;
+    std::unique_ptr<Deflater> deflater;
+    int level = 0;
+    std::string output;             // 压缩输出缓冲，每块写出后清空
+
+    // DEFLATE条目先缓存第一块原始数据，确定压缩方法后才写出本地文件头
+    bool headerWritten = false;
+    std::string pendingInput;
+
+    bool fail(const std::string& message) {
+        lastError = message;
+        return false;
+    }
+
+    bool emit(const std::string& data) {
+        archive.write(data.data(), static_cast<std::streamsize>(data.size()));
+        offset += data.size();
+        if (!archive.good()) {
+            return fail("Failed to write archive");
+        }
+        return true;
+    }
+
+    // 写出当前的压缩输出
+    bool flushOutput() {
+        current.info.compressedSize += output.size();
+        bool ok = emit(output);
+        output.clear();
+        return ok;
+    }
+
+    // 本地文件头：CRC与大小在数据描述符中给出
+    bool writeLocalHeader() {
+        std::string header;
+        put32(header, ZIP_LOCAL_FILE_HEADER_SIGNATURE);
+        put16(header, VERSION_NEEDED);
+        put16(header, current.flags);
+        put16(header, static_cast<uint16_t>(current.info.compressionMethod));
+        put16(header, current.dosTime);
+        put16(header, current.dosDate);
+        put32(header, 0);
+        put32(header, 0);
+        put32(header, 0);
+        put16(header, static_cast<uint16_t>(current.info.filename.size()));
+        put16(header, 0);
+        header += current.info.filename;
+        headerWritten = true;
+        return emit(header);
+    }
+
+    // 压缩后不比原始数据小时改为不压缩存储（小文件和已压缩的数据常见）
+    // 条目在第一块内结束时按整个条目判断；更大的条目按第一块的压缩效果决定
+    bool chooseMethod(bool finish) {
+        if (finish) {
+            deflater->deflate(pendingInput.data(), pendingInput.size(), true, output);
+            if (output.size() >= pendingInput.size()) {
+                current.info.compressionMethod = METHOD_STORE;
+                output.swap(pendingInput);
+            }
+        } else if (Deflater::compress(pendingInput, level).size() >= pendingInput.size()) {
+            current.info.compressionMethod = METHOD_STORE;
+            output.swap(pendingInput);
+        } else {
+            deflater->deflate(pendingInput.data(), pendingInput.size(), false, output);
+        }
+        pendingInput.clear();
+
+        if (!writeLocalHeader()) {
+            output.clear();
+            return false;
+        }
+        return flushOutput();
+    }
 };
 
 ZIPWriter::ZIPWriter() : pImpl(std::make_unique<Impl>()) {}
@@ -535,53 +896,137 @@ ZIPWriter::~ZIPWriter() {
 
 bool ZIPWriter::create(const std::string& zipPath) {
     close();
-    
-    pImpl->archive.open(zipPath, std::ios::binary);
+
+    pImpl->archive.open(zipPath, std::ios::binary | std::ios::trunc);
     if (!pImpl->archive.is_open()) {
-        return false;
+        return pImpl->fail("Failed to create archive: " + zipPath);
     }
-    
-    // 写入头部
-    const char* magic = "CMODZIP1";
-    pImpl->archive.write(magic, 8);
-    
-    // 预留文件数量位置
-    uint32_t fileCount = 0;
-    pImpl->archive.write(reinterpret_cast<const char*>(&fileCount), sizeof(fileCount));
-    
+
+    pImpl->entries.clear();
+    pImpl->offset = 0;
+    pImpl->lastError.clear();
     return true;
 }
 
-bool ZIPWriter::beginFile(const std::string& entryName, int compressionLevel) {
-    if (!pImpl->currentFileName.empty()) {
-        endFile();
+bool ZIPWriter::beginFile(const std::string& entryName, int compressionLevel, time_t modificationTime) {
+    if (!pImpl->archive.is_open()) {
+        return pImpl->fail("Archive is not open");
+    }
+    if (pImpl->inFile && !endFile()) {
+        return false;
+    }
+    if (entryName.size() > 0xFFFF) {
+        return pImpl->fail("Entry name too long: " + entryName);
     }
-    
-    pImpl->currentFileName = entryName;
-    pImpl->compressionLevel = compressionLevel;
-    pImpl->currentFileData.str("");
-    pImpl->currentFileData.clear();
-    
+
+    int level = std::clamp(compressionLevel, 0, 9);
+    ZIPEntry& entry = pImpl->current;
+    entry = ZIPEntry();
+    entry.info.filename = entryName;
+    entry.info.isDirectory = !entryName.empty() && entryName.back() == '/';
+    entry.info.compressionMethod = level > 0 && !entry.info.isDirectory ? METHOD_DEFLATE : METHOD_STORE;
+    entry.info.compressedSize = 0;
+    entry.info.uncompressedSize = 0;
+    entry.info.modificationTime = modificationTime ? modificationTime : std::time(nullptr);
+    entry.flags = FLAG_DATA_DESCRIPTOR | FLAG_UTF8;
+    entry.localHeaderOffset = pImpl->offset;
+    toDosDateTime(entry.info.modificationTime, entry.dosTime, entry.dosDate);
+
+    if (entry.localHeaderOffset > ZIP32_LIMIT) {
+        return pImpl->fail("Archive exceeds 4GB (ZIP64 is not supported)");
+    }
+
+    pImpl->headerWritten = false;
+    pImpl->pendingInput.clear();
+    if (entry.info.compressionMethod == METHOD_DEFLATE) {
+        // 本地文件头推迟到确定压缩方法之后
+        if (pImpl->deflater && pImpl->deflater->getLevel() == level) {
+            pImpl->deflater->reset();
+        } else {
+            pImpl->deflater = std::make_unique<Deflater>(level);
+        }
+        pImpl->level = level;
+    } else if (!pImpl->writeLocalHeader()) {
+        return false;
+    }
+
+    pImpl->inFile = true;
     return true;
 }
 
 bool ZIPWriter::write(const void* data, size_t size) {
-    if (pImpl->currentFileName.empty()) {
+    if (!pImpl->inFile) {
         return false;
     }
-    
-    pImpl->currentFileData.write(static_cast<const char*>(data), size);
-    return pImpl->currentFileData.good();
+
+    ZIPEntry& entry = pImpl->current;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+
+    // 按固定大小分块：压缩器的窗口和输出缓冲都不随条目大小增长
+    while (size > 0) {
+        size_t count = std::min(size, STREAM_CHUNK_SIZE);
+        if (!pImpl->headerWritten) {
+            count = std::min(size, STREAM_CHUNK_SIZE - pImpl->pendingInput.size());
+        }
+        entry.crc32 = CRC32::update(entry.crc32, bytes, count);
+        entry.info.uncompressedSize += count;
+
+        if (!pImpl->headerWritten) {
+            pImpl->pendingInput.append(reinterpret_cast<const char*>(bytes), count);
+            if (pImpl->pendingInput.size() == STREAM_CHUNK_SIZE && !pImpl->chooseMethod(false)) {
+                return false;
+            }
+        } else {
+            if (entry.info.compressionMethod == METHOD_DEFLATE) {
+                pImpl->deflater->deflate(bytes, count, false, pImpl->output);
+            } else {
+                pImpl->output.append(reinterpret_cast<const char*>(bytes), count);
+            }
+            if (!pImpl->flushOutput()) {
+                return false;
+            }
+        }
+
+        bytes += count;
+        size -= count;
+    }
+
+    return true;
 }
 
 bool ZIPWriter::endFile() {
-    if (pImpl->currentFileName.empty()) {
+    if (!pImpl->inFile) {
         return false;
     }
-    
-    pImpl->files.push_back({pImpl->currentFileName, pImpl->currentFileData.str()});
-    pImpl->currentFileName.clear();
-    
+    pImpl->inFile = false;
+
+    ZIPEntry& entry = pImpl->current;
+    if (!pImpl->headerWritten) {
+        if (!pImpl->chooseMethod(true)) {
+            return false;
+        }
+    } else if (entry.info.compressionMethod == METHOD_DEFLATE) {
+        pImpl->deflater->deflate(nullptr, 0, true, pImpl->output);
+        if (!pImpl->flushOutput()) {
+            return false;
+        }
+    }
+
+    if (entry.info.uncompressedSize > ZIP32_LIMIT || entry.info.compressedSize > ZIP32_LIMIT) {
+        return pImpl->fail("Entry exceeds 4GB (ZIP64 is not supported): " + entry.info.filename);
+    }
+
+    // 数据描述符
+    std::string descriptor;
+    put32(descriptor, ZIP_DATA_DESCRIPTOR_SIGNATURE);
+    put32(descriptor, entry.crc32);
+    put32(descriptor, static_cast<uint32_t>(entry.info.compressedSize));
+    put32(descriptor, static_cast<uint32_t>(entry.info.uncompressedSize));
+    if (!pImpl->emit(descriptor)) {
+        return false;
+    }
+
+    pImpl->entries.push_back(std::move(entry));
     return true;
 }
 
@@ -589,38 +1034,61 @@ bool ZIPWriter::close() {
     if (!pImpl->archive.is_open()) {
         return false;
     }
-    
+
     // 结束当前文件
-    if (!pImpl->currentFileName.empty()) {
-        endFile();
-    }
-    
-    // 写入所有文件
-    for (const auto& [name, content] : pImpl->files) {
-        // 文件名长度
-        uint32_t nameLen = static_cast<uint32_t>(name.length());
-        pImpl->archive.write(reinterpret_cast<const char*>(&nameLen), sizeof(nameLen));
-        
-        // 文件名
-        pImpl->archive.write(name.c_str(), nameLen);
-        
-        // 文件内容长度
-        uint32_t contentLen = static_cast<uint32_t>(content.length());
-        pImpl->archive.write(reinterpret_cast<const char*>(&contentLen), sizeof(contentLen));
-        
-        // 文件内容
-        pImpl->archive.write(content.c_str(), contentLen);
-    }
-    
-    // 更新文件数量
-    pImpl->archive.seekp(8);
-    uint32_t fileCount = static_cast<uint32_t>(pImpl->files.size());
-    pImpl->archive.write(reinterpret_cast<const char*>(&fileCount), sizeof(fileCount));
-    
+    bool success = true;
+    if (pImpl->inFile) {
+        success = endFile();
+    }
+
+    // 中央目录
+    uint64_t directoryOffset = pImpl->offset;
+    std::string directory;
+    for (const auto& entry : pImpl->entries) {
+        put32(directory, ZIP_CENTRAL_DIR_SIGNATURE);
+        put16(directory, VERSION_MADE_BY);
+        put16(directory, VERSION_NEEDED);
+        put16(directory, entry.flags);
+        put16(directory, static_cast<uint16_t>(entry.info.compressionMethod));
+        put16(directory, entry.dosTime);
+        put16(directory, entry.dosDate);
+        put32(directory, entry.crc32);
+        put32(directory, static_cast<uint32_t>(entry.info.compressedSize));
+        put32(directory, static_cast<uint32_t>(entry.info.uncompressedSize));
+        put16(directory, static_cast<uint16_t>(entry.info.filename.size()));
+        put16(directory, 0);    // 扩展字段长度
+        put16(directory, 0);    // 注释长度
+        put16(directory, 0);    // 起始磁盘号
+        put16(directory, 0);    // 内部属性
+        put32(directory, entry.info.isDirectory ? (040755u << 16) | 0x10 : 0100644u << 16);
+        put32(directory, static_cast<uint32_t>(entry.localHeaderOffset));
+        directory += entry.info.filename;
+    }
+
+    uint64_t directorySize = directory.size();
+    if (pImpl->entries.size() > 0xFFFF || directoryOffset > ZIP32_LIMIT) {
+        success = pImpl->fail("Archive exceeds ZIP32 limits (ZIP64 is not supported)");
+    }
+
+    // 中央目录结束记录
+    std::string comment = pImpl->comment.substr(0, 0xFFFF);
+    put32(directory, ZIP_END_OF_CENTRAL_DIR_SIGNATURE);
+    put16(directory, 0);
+    put16(directory, 0);
+    put16(directory, static_cast<uint16_t>(pImpl->entries.size()));
+    put16(directory, static_cast<uint16_t>(pImpl->entries.size()));
+    put32(directory, static_cast<uint32_t>(directorySize));
+    put32(directory, static_cast<uint32_t>(directoryOffset));
+    put16(directory, static_cast<uint16_t>(comment.size()));
+    directory += comment;
+
+    success = pImpl->emit(directory) && success;
+
     pImpl->archive.close();
-    pImpl->files.clear();
-    
-    return true;
+    pImpl->entries.clear();
+    pImpl->deflater.reset();
+
+    return success;
 }
 
 bool ZIPWriter::isOpen() const {
@@ -631,4 +1099,296 @@ void ZIPWriter::setComment(const std::string& comment) {
     pImpl->comment = comment;
 }
 
-} // namespace CHTL
\ No newline at end of file
+const std::string& ZIPWriter::getLastError() const {
+    return pImpl->lastError;
+}
+
+// ZIPArchiveView::Impl
+class ZIPArchiveView::Impl {
+public:
+    // 条目的校验/解压状态
+    enum class EntryState : uint8_t { UNCHECKED, VALID, CORRUPTED };
+
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    std::string buffer;             // 无mmap时读入内存
+#else
+    void* mapping = nullptr;
+#endif
+
+    std::vector<ZIPEntry> entries;
+    std::unordered_map<std::string_view, size_t> index;     // 键为entries中文件名的切片
+    std::vector<EntryState> states;
+    std::vector<std::string> inflated;                      // DEFLATE条目的解压结果
+    size_t inflatedCount = 0;
+    bool legacy = false;
+    std::string lastError;
+    mutable std::mutex mutex;
+
+    bool fail(const std::string& message) {
+        lastError = message;
+        return false;
+    }
+
+    bool map(const std::string& path) {
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return fail("Failed to open archive: " + path);
+        }
+        std::stringstream ss;
+        ss << file.rdbuf();
+        buffer = ss.str();
+        data = reinterpret_cast<const uint8_t*>(buffer.data());
+        size = buffer.size();
+        return true;
+#else
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return fail("Failed to open archive: " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            return fail("Invalid archive format");
+        }
+        void* address = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) {
+            return fail("Failed to map archive: " + path);
+        }
+        mapping = address;
+        data = static_cast<const uint8_t*>(address);
+        size = static_cast<size_t>(st.st_size);
+        return true;
+#endif
+    }
+
+    void unmap() {
+#ifdef _WIN32
+        buffer.clear();
+        buffer.shrink_to_fit();
+#else
+        if (mapping) {
+            ::munmap(mapping, size);
+            mapping = nullptr;
+        }
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    bool readCentralDirectory() {
+        size_t tailSize = std::min<size_t>(size, END_OF_CENTRAL_DIR_SIZE + 0xFFFF);
+        const uint8_t* eocd = findEndOfCentralDirectory(data + size - tailSize, tailSize);
+        if (!eocd) {
+            return fail("Invalid archive format");
+        }
+
+        size_t entryCount = get16(eocd + 10);
+        uint64_t directorySize = get32(eocd + 12);
+        uint64_t directoryOffset = get32(eocd + 16);
+        if (directoryOffset + directorySize > size ||
+            !parseCentralDirectory(data + directoryOffset, static_cast<size_t>(directorySize), entryCount, entries)) {
+            return fail("Corrupted central directory");
+        }
+
+        // 由本地文件头计算数据位置
+        for (auto& entry : entries) {
+            if (entry.localHeaderOffset + LOCAL_HEADER_SIZE > size ||
+                get32(data + entry.localHeaderOffset) != ZIP_LOCAL_FILE_HEADER_SIGNATURE) {
+                return fail("Invalid local file header: " + entry.info.filename);
+            }
+            const uint8_t* header = data + entry.localHeaderOffset;
+            entry.dataOffset = entry.localHeaderOffset + LOCAL_HEADER_SIZE + get16(header + 26) + get16(header + 28);
+            if (entry.dataOffset + entry.info.compressedSize > size) {
+                return fail("Truncated entry: " + entry.info.filename);
+            }
+        }
+
+        legacy = false;
+        return true;
+    }
+
+    // 旧版CMODZIP1：魔数、条目数，然后依次为名称长度、名称、内容长度、内容
+    bool readLegacyDirectory() {
+        if (size < 12 || std::memcmp(data, LEGACY_MAGIC, 8) != 0) {
+            return false;
+        }
+
+        uint32_t fileCount = get32(data + 8);
+        uint64_t offset = 12;
+        entries.clear();
+        for (uint32_t i = 0; i < fileCount; ++i) {
+            if (offset + 4 > size) {
+                return fail("Corrupted archive");
+            }
+            uint32_t nameLength = get32(data + offset);
+            if (offset + 8 + nameLength > size) {
+                return fail("Corrupted archive");
+            }
+            uint32_t contentLength = get32(data + offset + 4 + nameLength);
+
+            ZIPEntry entry;
+            entry.info.filename.assign(reinterpret_cast<const char*>(data + offset + 4), nameLength);
+            entry.info.uncompressedSize = contentLength;
+            entry.info.compressedSize = contentLength;
+            entry.info.isDirectory = false;
+            entry.info.compressionMethod = METHOD_STORE;
+            entry.info.modificationTime = std::time(nullptr);
+            entry.dataOffset = offset + 8 + nameLength;
+            if (entry.dataOffset + contentLength > size) {
+                return fail("Corrupted archive");
+            }
+            offset = entry.dataOffset + contentLength;
+            entries.push_back(std::move(entry));
+        }
+
+        legacy = true;
+        return true;
+    }
+
+    const ZIPEntry* find(std::string_view name) const {
+        auto it = index.find(name);
+        return it != index.end() ? &entries[it->second] : nullptr;
+    }
+};
+
+ZIPArchiveView::ZIPArchiveView() : pImpl(std::make_unique<Impl>()) {}
+
+ZIPArchiveView::~ZIPArchiveView() {
+    close();
+}
+
+bool ZIPArchiveView::open(const std::string& zipPath) {
+    close();
+
+    if (!pImpl->map(zipPath)) {
+        return false;
+    }
+
+    if (!pImpl->readLegacyDirectory() && pImpl->lastError.empty()) {
+        pImpl->readCentralDirectory();
+    }
+    if (!pImpl->lastError.empty()) {
+        std::string error = pImpl->lastError;
+        close();
+        pImpl->lastError = error;
+        return false;
+    }
+
+    // 文件名存放在entries中，此后entries不再改变，可以用切片作为键
+    pImpl->index.reserve(pImpl->entries.size());
+    for (size_t i = 0; i < pImpl->entries.size(); ++i) {
+        pImpl->index.emplace(pImpl->entries[i].info.filename, i);
+    }
+    pImpl->states.assign(pImpl->entries.size(), Impl::EntryState::UNCHECKED);
+    pImpl->inflated.resize(pImpl->entries.size());
+
+    return true;
+}
+
+void ZIPArchiveView::close() {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    pImpl->unmap();
+    pImpl->index.clear();
+    pImpl->entries.clear();
+    pImpl->states.clear();
+    pImpl->inflated.clear();
+    pImpl->inflatedCount = 0;
+    pImpl->lastError.clear();
+}
+
+bool ZIPArchiveView::isOpen() const {
+    return pImpl->data != nullptr;
+}
+
+std::vector<ZIPFileInfo> ZIPArchiveView::getFileList() const {
+    std::vector<ZIPFileInfo> files;
+    files.reserve(pImpl->entries.size());
+    for (const auto& entry : pImpl->entries) {
+        files.push_back(entry.info);
+    }
+    return files;
+}
+
+bool ZIPArchiveView::contains(std::string_view entryName) const {
+    return pImpl->find(entryName) != nullptr;
+}
+
+std::optional<ZIPFileInfo> ZIPArchiveView::getFileInfo(std::string_view entryName) const {
+    const ZIPEntry* entry = pImpl->find(entryName);
+    if (!entry) {
+        return std::nullopt;
+    }
+    return entry->info;
+}
+
+std::optional<std::string_view> ZIPArchiveView::getEntry(std::string_view entryName) {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+
+    auto it = pImpl->index.find(entryName);
+    if (it == pImpl->index.end()) {
+        pImpl->lastError = "File not found in archive: " + std::string(entryName);
+        return std::nullopt;
+    }
+    size_t i = it->second;
+    const ZIPEntry& entry = pImpl->entries[i];
+    auto& state = pImpl->states[i];
+
+    if (state == Impl::EntryState::CORRUPTED) {
+        pImpl->lastError = "Corrupted entry: " + entry.info.filename;
+        return std::nullopt;
+    }
+
+    std::string_view raw(reinterpret_cast<const char*>(pImpl->data + entry.dataOffset),
+                         static_cast<size_t>(entry.info.compressedSize));
+    std::string_view content;
+
+    if (entry.info.compressionMethod == METHOD_STORE) {
+        content = raw;
+    } else if (entry.info.compressionMethod == METHOD_DEFLATE) {
+        if (state == Impl::EntryState::VALID) {
+            return std::string_view(pImpl->inflated[i]);
+        }
+        auto result = Inflater::decompress(raw, entry.info.uncompressedSize);
+        if (!result) {
+            state = Impl::EntryState::CORRUPTED;
+            pImpl->lastError = "Corrupted entry: " + entry.info.filename;
+            return std::nullopt;
+        }
+        pImpl->inflated[i] = std::move(*result);
+        pImpl->inflatedCount++;
+        content = pImpl->inflated[i];
+    } else {
+        pImpl->lastError = "Unsupported compression method " + std::to_string(entry.info.compressionMethod) +
+                           ": " + entry.info.filename;
+        return std::nullopt;
+    }
+
+    // 第一次访问时校验
+    if (state == Impl::EntryState::UNCHECKED) {
+        if (content.size() != entry.info.uncompressedSize ||
+            (!pImpl->legacy && CRC32::compute(content.data(), content.size()) != entry.crc32)) {
+            state = Impl::EntryState::CORRUPTED;
+            pImpl->inflated[i].clear();
+            pImpl->lastError = "CRC mismatch in entry: " + entry.info.filename;
+            return std::nullopt;
+        }
+        state = Impl::EntryState::VALID;
+    }
+
+    return content;
+}
+
+size_t ZIPArchiveView::getInflatedCount() const {
+    std::lock_guard<std::mutex> lock(pImpl->mutex);
+    return pImpl->inflatedCount;
+}
+
+const std::string& ZIPArchiveView::getLastError() const {
+    return pImpl->lastError;
+}
+
+} // namespace CHTL
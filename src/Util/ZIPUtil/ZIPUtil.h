@@ -5,6 +5,10 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <optional>
+#include <string_view>
+#include <cstdint>
+#include <ctime>
 
 namespace CHTL {
 
@@ -84,6 +88,8 @@ private:
 };
 
 // ZIP读取器（用于流式读取）
+// 打开时只解析中央目录，条目数据在read()时按固定大小分块解压并校验CRC32。
+// 兼容旧版CMODZIP1格式的包。
 class ZIPReader {
 public:
     ZIPReader();
@@ -112,6 +118,9 @@ public:
     
     // 获取当前文件信息
     ZIPFileInfo getCurrentFileInfo();
+    
+    // 获取错误信息（CRC不符、数据损坏等）
+    const std::string& getLastError() const;
 
 private:
     class Impl;
@@ -119,6 +128,7 @@ private:
 };
 
 // ZIP写入器（用于流式写入）
+// 条目数据边压缩边写出，不缓存整个条目；大小和CRC32写在数据描述符中。
 class ZIPWriter {
 public:
     ZIPWriter();
@@ -127,8 +137,8 @@ public:
     // 创建ZIP文件
     bool create(const std::string& zipPath);
     
-    // 开始新文件
-    bool beginFile(const std::string& entryName, int compressionLevel = 6);
+    // 开始新文件（级别0为不压缩；modificationTime为0时使用当前时间）
+    bool beginFile(const std::string& entryName, int compressionLevel = 6, time_t modificationTime = 0);
     
     // 写入数据
     bool write(const void* data, size_t size);
@@ -144,6 +154,54 @@ public:
     
     // 设置注释
     void setComment(const std::string& comment);
+    
+    // 获取错误信息
+    const std::string& getLastError() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> pImpl;
+};
+
+// 内存映射的ZIP归档（随机访问）
+// 打开时映射整个文件并一次性解析中央目录建立索引；不压缩的条目直接返回映射中的切片，
+// DEFLATE条目在第一次访问时才解压并缓存。返回的string_view在close()之前有效。
+// 兼容旧版CMODZIP1格式的包。
+class ZIPArchiveView {
+public:
+    ZIPArchiveView();
+    ~ZIPArchiveView();
+    
+    // 映射ZIP文件并建立索引
+    bool open(const std::string& zipPath);
+    
+    // 解除映射并释放已解压的内容
+    void close();
+    
+    // 是否已打开
+    bool isOpen() const;
+    
+    // 获取文件列表
+    std::vector<ZIPFileInfo> getFileList() const;
+    
+    // 检查条目是否存在
+    bool contains(std::string_view entryName) const;
+    
+    // 获取条目信息
+    std::optional<ZIPFileInfo> getFileInfo(std::string_view entryName) const;
+    
+    // 获取条目内容（按需解压并校验CRC32）
+    std::optional<std::string_view> getEntry(std::string_view entryName);
+    
+    // 已解压的条目数
+    size_t getInflatedCount() const;
+    
+    // 获取错误信息
+    const std::string& getLastError() const;
+    
+    // 禁止拷贝
+    ZIPArchiveView(const ZIPArchiveView&) = delete;
+    ZIPArchiveView& operator=(const ZIPArchiveView&) = delete;
 
 private:
     class Impl;